@@ -101,6 +101,7 @@
 #include "nusimdata/SimulationBase/MCFlux.h"
 #include "lardataobj/Simulation/SimChannel.h"
 #include "lardataobj/Simulation/AuxDetSimChannel.h"
+#include "icaruscode/Analysis/SimChannelTruthIndex.h"
 #include "lardataobj/AnalysisBase/Calorimetry.h"
 #include "lardataobj/AnalysisBase/ParticleID.h"
 #include "lardataobj/RawData/RawDigit.h"
@@ -1895,6 +1896,7 @@ void icarus::AnalysisTree::analyze(const art::Event& evt)
   if (isMC && fSaveGeantInfo){
     evt.getView(fLArG4ModuleLabel, fSimChannels);
   }
+  icarus::SimChannelTruthIndex const simChannelIndex{ fSimChannels };
 
   fData->run = evt.run();
   fData->subrun = evt.subRun();
@@ -1946,22 +1948,11 @@ void icarus::AnalysisTree::analyze(const art::Event& evt)
       */
 
       if (!evt.isRealData()){
-         fData -> hit_nelec[i] = 0;
-         fData -> hit_energy[i] = 0;
-         const sim::SimChannel* chan = 0;
-         for(size_t sc = 0; sc < fSimChannels.size(); ++sc){
-           if(fSimChannels[sc]->Channel() == hitlist[i]->Channel()) chan = fSimChannels[sc];
-         }
-         if (chan){
-           for (auto const& tdcide: chan->TDCIDEMap()) {
-             // loop over the vector of IDE objects.
-             std::vector<sim::IDE> const& idevec = tdcide.second;
-             for(auto const& ide: idevec) {
-                fData -> hit_nelec[i] += ide.numElectrons;
-                fData -> hit_energy[i] += ide.energy;
-             } // all IDEs in the TDC tick
-           } // all TDC ticks
-         }
+         // all the ionization on the channel of the hit
+         icarus::SimChannelTruthIndex::Deposit_t const dep
+           = simChannelIndex.channelDeposit(hitlist[i]->Channel());
+         fData -> hit_nelec[i] = dep.numElectrons;
+         fData -> hit_energy[i] = dep.energy;
        }
     }
 
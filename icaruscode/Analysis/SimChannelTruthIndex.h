@@ -0,0 +1,265 @@
+/**
+ * @file   icaruscode/Analysis/SimChannelTruthIndex.h
+ * @brief  Per-event index of the ionization deposited on each TPC channel.
+ * @date   October 19, 2026
+ *
+ * This library is header only.
+ */
+
+#ifndef ICARUSCODE_ANALYSIS_SIMCHANNELTRUTHINDEX_H
+#define ICARUSCODE_ANALYSIS_SIMCHANNELTRUTHINDEX_H
+
+
+// LArSoft libraries
+#include "lardataobj/Simulation/SimChannel.h"
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+
+// C/C++ standard libraries
+#include <algorithm> // std::lower_bound()
+#include <cstddef> // std::size_t
+#include <limits>
+#include <type_traits> // std::is_pointer_v
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+namespace icarus { class SimChannelTruthIndex; }
+/**
+ * @brief Index of the simulated ionization on each channel, by TDC tick.
+ *
+ * The index is filled once per event from the `sim::SimChannel` collection,
+ * and it then answers queries on the truth deposited on a channel without
+ * further scans of the collection:
+ *  * `simChannel()` returns the `sim::SimChannel` of a channel, in constant
+ *    time (the index is a table densely indexed by channel number);
+ *  * `channelDeposit()` returns the total number of ionization electrons and
+ *    energy on a channel, in constant time;
+ *  * `deposit()` returns the same totals restricted to a range of TDC ticks,
+ *    in logarithmic time of the number of ticks with deposits on the channel.
+ *
+ * Internally, the ticks with deposits of all channels are stored in a single
+ * sequence, sorted by channel and then by tick, together with the cumulative
+ * sums of electrons and energy; the deposit in any range is the difference of
+ * two of these sums.
+ *
+ * Ionization deposits (`sim::IDE`) with energy lower than a threshold can be
+ * ignored by the index (by default, all are included).
+ *
+ * The index does not own the `sim::SimChannel` objects, which must stay valid
+ * (e.g. in the _art_ event) for as long as `simChannel()` is used.
+ *
+ * Example:
+ * @code
+ * auto const& simChannels
+ *   = event.getProduct<std::vector<sim::SimChannel>>(simChannelTag);
+ * icarus::SimChannelTruthIndex const truthIndex{ simChannels };
+ *
+ * for (recob::Hit const& hit: hits) {
+ *   icarus::SimChannelTruthIndex::Deposit_t const dep
+ *     = truthIndex.channelDeposit(hit.Channel());
+ *   // ...
+ * }
+ * @endcode
+ */
+class icarus::SimChannelTruthIndex {
+
+    public:
+
+  /// Type of TDC tick used in the queries.
+  using TDC_t = unsigned int;
+
+  /// Deposited ionization.
+  struct Deposit_t {
+    double numElectrons = 0.0; ///< Number of ionization electrons.
+    double energy = 0.0; ///< Deposited energy [MeV]
+
+    bool empty() const { return (numElectrons == 0.0) && (energy == 0.0); }
+  }; // Deposit_t
+
+
+  /// Constructor: an empty index.
+  SimChannelTruthIndex() = default;
+
+  /**
+   * @brief Constructor: indexes the specified channels.
+   * @tparam SimChannels collection of `sim::SimChannel` or pointers to them
+   * @param simChannels the collection of channels to index
+   * @param minEnergy IDE with energy lower than this are ignored [MeV]
+   * @see `fill()`
+   */
+  template <typename SimChannels>
+  explicit SimChannelTruthIndex(
+    SimChannels const& simChannels,
+    double minEnergy = std::numeric_limits<double>::lowest()
+    )
+    { fill(simChannels, minEnergy); }
+
+
+  // --- BEGIN -- Filling ------------------------------------------------------
+  /**
+   * @brief Replaces the content of the index with the specified channels.
+   * @tparam SimChannels collection of `sim::SimChannel` or pointers to them
+   * @param simChannels the collection of channels to index
+   * @param minEnergy IDE with energy lower than this are ignored [MeV]
+   *
+   * If a channel appears more than once in the collection, only the last
+   * appearance is indexed. Null pointers in the collection are skipped.
+   */
+  template <typename SimChannels>
+  void fill(
+    SimChannels const& simChannels,
+    double minEnergy = std::numeric_limits<double>::lowest()
+    );
+
+  /// Removes all the content of the index (memory is kept for reuse).
+  void clear();
+  // --- END ---- Filling ------------------------------------------------------
+
+
+  // --- BEGIN -- Queries ------------------------------------------------------
+  /// Returns whether the index has no channel.
+  bool empty() const { return fChannels.empty(); }
+
+  /// Returns whether `channel` has a `sim::SimChannel` in the index.
+  bool hasChannel(raw::ChannelID_t channel) const
+    { return simChannel(channel) != nullptr; }
+
+  /// Returns the `sim::SimChannel` of `channel`, `nullptr` if not present.
+  sim::SimChannel const* simChannel(raw::ChannelID_t channel) const
+    { return (channel < fChannels.size())? fChannels[channel].simChannel: nullptr; }
+
+  /// Returns the total deposit on `channel` (empty if channel is not present).
+  Deposit_t channelDeposit(raw::ChannelID_t channel) const;
+
+  /**
+   * @brief Returns the deposit on `channel` in the specified TDC range.
+   * @param channel the channel to query
+   * @param firstTDC the first TDC tick included in the range
+   * @param endTDC the first TDC tick after the range
+   * @return the deposit on ticks `[ firstTDC, endTDC [`
+   */
+  Deposit_t deposit
+    (raw::ChannelID_t channel, TDC_t firstTDC, TDC_t endTDC) const;
+  // --- END ---- Queries ------------------------------------------------------
+
+
+    private:
+
+  /// Information about a single channel.
+  struct ChannelInfo_t {
+    sim::SimChannel const* simChannel = nullptr; ///< Indexed channel.
+    std::size_t begin = 0; ///< Index of the first tick of the channel.
+    std::size_t end = 0; ///< Index after the last tick of the channel.
+  }; // ChannelInfo_t
+
+  std::vector<ChannelInfo_t> fChannels; ///< Channel information by channel.
+
+  /// TDC ticks with deposits, sorted by channel and then by tick.
+  std::vector<TDC_t> fTDCs;
+
+  /// Sums of deposits in all the ticks in `fTDCs` before the index.
+  std::vector<Deposit_t> fCumulative { Deposit_t{} };
+
+
+  /// Returns the deposit between two entries of `fTDCs`.
+  Deposit_t depositBetween(std::size_t begin, std::size_t end) const
+    {
+      return {
+        fCumulative[end].numElectrons - fCumulative[begin].numElectrons,
+        fCumulative[end].energy - fCumulative[begin].energy
+        };
+    }
+
+  /// Adds the ticks of `simChannel` to the index.
+  void addChannel(sim::SimChannel const& simChannel, double minEnergy);
+
+}; // class icarus::SimChannelTruthIndex
+
+
+// -----------------------------------------------------------------------------
+// --- template implementation
+// -----------------------------------------------------------------------------
+template <typename SimChannels>
+void icarus::SimChannelTruthIndex::fill
+  (SimChannels const& simChannels, double minEnergy)
+{
+  clear();
+  for (auto const& simChannel: simChannels) {
+    if constexpr (std::is_pointer_v<std::decay_t<decltype(simChannel)>>) {
+      if (simChannel) addChannel(*simChannel, minEnergy);
+    }
+    else addChannel(simChannel, minEnergy);
+  } // for
+} // icarus::SimChannelTruthIndex::fill()
+
+
+// -----------------------------------------------------------------------------
+// --- inline implementation
+// -----------------------------------------------------------------------------
+inline void icarus::SimChannelTruthIndex::clear() {
+  fChannels.clear();
+  fTDCs.clear();
+  fCumulative.resize(1);
+} // icarus::SimChannelTruthIndex::clear()
+
+
+// -----------------------------------------------------------------------------
+inline auto icarus::SimChannelTruthIndex::channelDeposit
+  (raw::ChannelID_t channel) const -> Deposit_t
+{
+  if (channel >= fChannels.size()) return {};
+  ChannelInfo_t const& info = fChannels[channel];
+  return depositBetween(info.begin, info.end);
+} // icarus::SimChannelTruthIndex::channelDeposit()
+
+
+// -----------------------------------------------------------------------------
+inline auto icarus::SimChannelTruthIndex::deposit
+  (raw::ChannelID_t channel, TDC_t firstTDC, TDC_t endTDC) const
+  -> Deposit_t
+{
+  if ((channel >= fChannels.size()) || (endTDC <= firstTDC)) return {};
+  ChannelInfo_t const& info = fChannels[channel];
+
+  auto const tdcBegin = fTDCs.cbegin() + info.begin;
+  auto const tdcEnd = fTDCs.cbegin() + info.end;
+  auto const first = std::lower_bound(tdcBegin, tdcEnd, firstTDC);
+  auto const last = std::lower_bound(first, tdcEnd, endTDC);
+
+  return depositBetween(first - fTDCs.cbegin(), last - fTDCs.cbegin());
+} // icarus::SimChannelTruthIndex::deposit()
+
+
+// -----------------------------------------------------------------------------
+inline void icarus::SimChannelTruthIndex::addChannel
+  (sim::SimChannel const& simChannel, double minEnergy)
+{
+  raw::ChannelID_t const channel = simChannel.Channel();
+  if (channel >= fChannels.size()) fChannels.resize(channel + 1);
+
+  // the deposits of a channel must be contiguous: a repeated channel is
+  // indexed anew at the end, and its previous ticks are left unreferenced
+  ChannelInfo_t& info = fChannels[channel];
+  info.simChannel = &simChannel;
+  info.begin = fTDCs.size();
+
+  // `TDCIDEMap()` is sorted by tick
+  for (auto const& [ tdc, ides ]: simChannel.TDCIDEMap()) {
+    Deposit_t sum = fCumulative.back();
+    for (sim::IDE const& ide: ides) {
+      if (ide.energy < minEnergy) continue;
+      sum.numElectrons += ide.numElectrons;
+      sum.energy += ide.energy;
+    } // for IDE
+    fTDCs.push_back(tdc);
+    fCumulative.push_back(sum);
+  } // for ticks
+
+  info.end = fTDCs.size();
+
+} // icarus::SimChannelTruthIndex::addChannel()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSCODE_ANALYSIS_SIMCHANNELTRUTHINDEX_H
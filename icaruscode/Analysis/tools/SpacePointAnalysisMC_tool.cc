@@ -23,6 +23,7 @@
 #include "lardataobj/Simulation/SimChannel.h"
 #include "lardataobj/Simulation/SimEnergyDeposit.h"
 #include "nusimdata/SimulationBase/MCParticle.h"
+#include "icaruscode/Analysis/SimChannelTruthIndex.h"
 
 #include "larsim/Simulation/LArVoxelID.h"
 
@@ -368,8 +369,6 @@ private:
     using SimIDESet                = std::set<const sim::IDE*,ideCompare>;
     using IDEToVoxelIDMap          = std::unordered_map<const sim::IDE*, sim::LArVoxelID>;
     using VoxelIDToIDESetMap       = std::map<sim::LArVoxelID, SimIDESet>;
-    using TDCToIDEMap              = std::map<unsigned short, SimIDESet>; // We need this one in order
-    using ChanToTDCToIDEMap        = std::map<raw::ChannelID_t, TDCToIDEMap>;
     using VoxelIDSet               = std::set<sim::LArVoxelID>;
 
     // And, of course, what we need is to be able to track a voxel back to the IDEs in each tick on each plane
@@ -396,10 +395,10 @@ private:
     using HitPointerVec        = std::vector<const recob::Hit*>;
     using RecobHitToVoxelIDMap = std::unordered_map<const recob::Hit*, VoxelIDSet>;
 
-    void compareHitsToSim(const art::Event&, const ChanToTDCToIDEMap&, const ChanToChargeMap&, const ChanToTDCIDEMap&, const IDEToVoxelIDMap&, RecobHitToVoxelIDMap&) const;
+    void compareHitsToSim(const art::Event&, const icarus::SimChannelTruthIndex&, const ChanToChargeMap&, const ChanToTDCIDEMap&, const IDEToVoxelIDMap&, RecobHitToVoxelIDMap&) const;
 
     void matchHitSim(const detinfo::DetectorClocksData& clockData,
-                     const HitPointerVec&, const ChanToTDCToIDEMap&, const ChargeDepositVec&, const ChanToTDCIDEMap&, const IDEToVoxelIDMap&, RecobHitToVoxelIDMap&) const;
+                     const HitPointerVec&, const icarus::SimChannelTruthIndex&, const ChargeDepositVec&, const ChanToTDCIDEMap&, const IDEToVoxelIDMap&, RecobHitToVoxelIDMap&) const;
 
     void compareSpacePointsToSim(const art::Event&,
                                  const detinfo::DetectorClocksData& clockData,
@@ -557,15 +556,16 @@ void SpacePointAnalysisMC::fillHistograms(const art::Event& event) const
 
     // First task is to build a map between ides and voxel ids (that we calcualate based on position)
     // and also get the reverse since it will be useful in the end.
-    // At the same time should also build a mapping of ides per channel so we can do quick hit lookup
+    // The total deposits per channel, for quick hit lookup, are collected in a separate index
     IDEToVoxelIDMap         ideToVoxelIDMap;
     VoxelIDToIDESetMap      voxelIDToIDEMap;
-    ChanToTDCToIDEMap       chanToTDCToIDEMap;
     VoxelIDSet              simChannelVoxelIDSet;
     VoxelIDToPlaneTDCIDEMap voxelIDToPlaneTDCIDEMap;
 
     TrackIDChanToTDCIDEMap trackIDChanToTDCIDEMap;
 
+    const icarus::SimChannelTruthIndex simChannelIndex(*simChannelHandle, fSimChannelMinEnergy);
+
     // Fill the above maps/structures
     for(const auto& simChannel : *simChannelHandle)
     {
@@ -575,7 +575,7 @@ void SpacePointAnalysisMC::fillHistograms(const art::Event& event) const
 
         for(const auto& tdcide : simChannel.TDCIDEMap())
         {
-            for(const auto& ide : tdcide.second) //chanToTDCToIDEMap[simChannel.Channel()][tdcide.first] = ide;
+            for(const auto& ide : tdcide.second)
             {
                 if (ide.energy < fSimChannelMinEnergy) continue;
 
@@ -583,7 +583,6 @@ void SpacePointAnalysisMC::fillHistograms(const art::Event& event) const
 
                 ideToVoxelIDMap[&ide]    = voxelID;
                 voxelIDToIDEMap[voxelID].insert(&ide);
-                chanToTDCToIDEMap[simChannel.Channel()][tdcide.first].insert(&ide);
                 simChannelVoxelIDSet.insert(voxelID);
 
                 trackIDChanToTDCIDEMap[ide.trackID][simChannel.Channel()].emplace_back(tdcide.first,&ide);
@@ -618,7 +617,7 @@ void SpacePointAnalysisMC::fillHistograms(const art::Event& event) const
     TrackToChanChargeMap::const_iterator chanToChargeMapItr = trackToChanChargeMap.find(bestTrackID);
 
     // Process the hit/simulation
-    compareHitsToSim(event, chanToTDCToIDEMap, chanToChargeMapItr->second, chanToTDCIDEMap, ideToVoxelIDMap, recobHitToVoxelIDMap);
+    compareHitsToSim(event, simChannelIndex, chanToChargeMapItr->second, chanToTDCIDEMap, ideToVoxelIDMap, recobHitToVoxelIDMap);
 
     // Now do the space points
     auto const clockData = art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(event);
@@ -699,7 +698,7 @@ void SpacePointAnalysisMC::makeTrackToChanChargeMap(const TrackIDChanToTDCIDEMap
 }
 
 void SpacePointAnalysisMC::compareHitsToSim(const art::Event&        event,                          // For recovering data from event store
-                                          const ChanToTDCToIDEMap& chanToTDCToIDEMap,              // This gives us ability to retrieve total charge deposits
+                                          const icarus::SimChannelTruthIndex& simChannelIndex,     // This gives us ability to retrieve total charge deposits
                                           const ChanToChargeMap&   chanToChargeMap,                // Charge deposit for specific track
                                           const ChanToTDCIDEMap&   chanToTDCIDEMap,                // Charge deposit for specific track
                                           const IDEToVoxelIDMap&   ideToVoxelIDMap,                // Mapping of ide info to voxels
@@ -777,7 +776,7 @@ void SpacePointAnalysisMC::compareHitsToSim(const art::Event&        event,
             }
 
             // Process the current list of hits (which will be on the same snippet)
-            matchHitSim(clockData, hitVec, chanToTDCToIDEMap, chargeDepositVec, chanToTDCIDEMap, ideToVoxelIDMap, recobHitToVoxelIDMap);
+            matchHitSim(clockData, hitVec, simChannelIndex, chargeDepositVec, chanToTDCIDEMap, ideToVoxelIDMap, recobHitToVoxelIDMap);
 
             hitVec.clear();
             hitVec.emplace_back(hitPtr);
@@ -785,7 +784,7 @@ void SpacePointAnalysisMC::compareHitsToSim(const art::Event&        event,
         }
 
         // Make sure to catch the last set of hits in the group
-        if (!hitVec.empty()) matchHitSim(clockData, hitVec, chanToTDCToIDEMap, chargeDepositVec, chanToTDCIDEMap, ideToVoxelIDMap, recobHitToVoxelIDMap);
+        if (!hitVec.empty()) matchHitSim(clockData, hitVec, simChannelIndex, chargeDepositVec, chanToTDCIDEMap, ideToVoxelIDMap, recobHitToVoxelIDMap);
     }
 
     return;
@@ -793,7 +792,7 @@ void SpacePointAnalysisMC::compareHitsToSim(const art::Event&        event,
 
 void SpacePointAnalysisMC::matchHitSim(const detinfo::DetectorClocksData& clockData,
                                      const HitPointerVec&               hitPointerVec,                  // Hits to match to simulation
-                                     const ChanToTDCToIDEMap&           chanToTDCToIDEMap,              // This gives us ability to retrieve total charge deposits
+                                     const icarus::SimChannelTruthIndex& simChannelIndex,               // This gives us ability to retrieve total charge deposits
                                      const ChargeDepositVec&            chargeDepositVec,               // Charge deposit for specific track
                                      const ChanToTDCIDEMap&             chanToTDCIDEMap,                // Charge deposit for specific track
                                      const IDEToVoxelIDMap&             ideToVoxelIDMap,                // Mapping of ide info to voxels
@@ -880,20 +879,12 @@ void SpacePointAnalysisMC::matchHitSim(const detinfo::DetectorClocksData& clockD
             float maxDepEneTick(std::get<1>(chargeDeposit).second->energy);
             float bestNumElectrons(std::get<4>(chargeDeposit));
             float bestDepEne(std::get<3>(chargeDeposit));
-            float totDepEne(0.);
-            float totNumElectrons(0.);
             int   bestTicks(lastSimTick - firstSimTick + 1);
 
             // We want to get the total energy deposit from all particles in the ticks for this hit
-            const TDCToIDEMap& tdcToIDEMap = chanToTDCToIDEMap.find(hit->Channel())->second;
-            for(const auto& tdcToIDEPair : tdcToIDEMap)
-            {
-                for(const auto& ide : tdcToIDEPair.second)
-                {
-                    totDepEne       += ide->energy;
-                    totNumElectrons += ide->numElectrons;
-                }
-            }
+            const icarus::SimChannelTruthIndex::Deposit_t channelDeposit = simChannelIndex.channelDeposit(hit->Channel());
+            float totDepEne(channelDeposit.energy);
+            float totNumElectrons(channelDeposit.numElectrons);
 
             // One final time through to find sim ticks that "matter"
             // We define this as the collection of IDE's that make up to 90% of the total deposit
@@ -24,6 +24,9 @@
 #include "TH1F.h"
 #include "TNtuple.h"
 
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
 #include <algorithm>
 #include <cassert>
 #include <cmath>
@@ -31,6 +34,8 @@
 #include <iomanip>
 #include <vector>
 #include <map>
+#include <memory>
+#include <utility>
 #include <iostream>
 
 #include "icaruscode/CRT/CRTDecoder/CrtCal.h"
@@ -71,6 +76,11 @@ public:
          Name("calibrate"),
          Comment("calibrate the data (true) or read from cal file (false)")
          };
+       fhicl::Atom<bool> SaveFitPlots {
+         Name("saveFitPlots"),
+         Comment("save images of the calibration fits in the working directory"),
+         true
+         };
 
        fhicl::Atom<uint8_t> Region {
          Name("region"),
@@ -113,6 +123,7 @@ public:
 private:
    string  pFile;
    bool    pCalibrate;
+   bool    pSaveFitPlots;
    vector<uint8_t> pMacs;
    float   pPeThresh;
 
@@ -196,6 +207,7 @@ icarus::crt::AnaProducer::AnaProducer(Parameters const& config)
   : EDAnalyzer(config), 
     pFile(config().CalFile()), 
     pCalibrate(config().Calibrate()), 
+    pSaveFitPlots(config().SaveFitPlots()),
     //pMacs(config().Macs()), 
     pPeThresh(config().PeThresh()),
     fRegion(config().Region()),
@@ -442,18 +454,28 @@ void icarus::crt::AnaProducer::endJob(){
         }
 
 
+	//the calibrations of the FEBs are independent and run concurrently;
+	//plots (ROOT graphics) and the tree are filled afterwards, one FEB at a time
+	vector<std::pair<uint8_t,std::unique_ptr<CrtCal>>> cals;
 	if(pCalibrate)
         for(auto const& macHist : fMacToHistos){
+                std::cout << "construct instance of CrtCal for mac5 " << (short)macHist.first << std::endl;
+                cals.emplace_back(macHist.first, std::make_unique<CrtCal>(macHist.second, false));
+        }
 
-                uint8_t mac = macHist.first;
-                vector<TH1F*>* hvec = macHist.second;
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, cals.size(), 1),
+                [&cals](tbb::blocked_range<size_t> const& range){
+                        for(size_t i=range.begin(); i<range.end(); i++) cals[i].second->Cal();
+                });
 
-                std::cout << "construct instance of CrtCal for mac5 " << (short)mac << std::endl;
-                CrtCal* cal = new CrtCal(hvec);
-                cal->Cal();
+        for(auto const& [ mac, cal ] : cals){
+
+                std::cout << "calibration of mac5 " << (short)mac << ":" << std::endl;
+                cal->PrintLog();
+                if(pSaveFitPlots) cal->SavePlots();
 
                 std::cout << "retreiving cal data..." << std::endl;
-                fMac5         = macHist.first;
+                fMac5         = mac;
                 bool*    ptrActive       = cal->GetActive();
                 float*   ptrGain         = cal->GetGain();
                 float*   ptrGainErr      = cal->GetGainErr();
@@ -519,8 +541,6 @@ void icarus::crt::AnaProducer::endJob(){
                 std::cout << "fill tree event" << std::endl;
                 fCalTree->Fill();
 
-                delete cal;
-
         }//end for mac5s if(pCalibrate)
 
 	icarus::crt::CrtCalTree* ccl;
@@ -0,0 +1,470 @@
+/**
+ * @file   icaruscode/CRT/CRTDecoder/BernCRTDataConverter.cc
+ * @brief  Conversion of decoded BernCRT hits into `icarus::crt::CRTData`.
+ * @date   October 19, 2026
+ * @see    icaruscode/CRT/CRTDecoder/BernCRTDataConverter.h
+ */
+
+// library header
+#include "icaruscode/CRT/CRTDecoder/BernCRTDataConverter.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#include "tbb/enumerable_thread_specific.h"
+
+// C/C++ standard library
+#include <algorithm> // std::sort()
+#include <array>
+#include <cstring> // std::memcpy()
+#include <iterator> // std::make_move_iterator()
+#include <stdexcept> // std::out_of_range
+#include <tuple> // std::tie()
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+/// Maximum number of data from a single hit (blocks of a side CRT board).
+constexpr std::size_t MaxDataPerHit = 3U;
+
+struct Recipe_t {
+
+  unsigned int destMac5;
+  unsigned int firstSourceChannel;
+  unsigned int lastSourceChannel;
+  unsigned int firstDestChannel;
+  unsigned int lastDestChannel;
+
+  int direction; // +1 or -1
+
+};
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+icarus::crt::BernCRTDataConverter::BernCRTDataConverter(
+  MacMap_t sideSimMac, MacMap_t topSimMac,
+  Delays_t sideDelays, Delays_t topDelays
+)
+  : fSideSimMac{ std::move(sideSimMac) }
+  , fTopSimMac{ std::move(topSimMac) }
+  , fSideDelays{ std::move(sideDelays) }
+  , fTopDelays{ std::move(topDelays) }
+{}
+
+
+// -----------------------------------------------------------------------------
+auto icarus::crt::BernCRTDataConverter::convert
+  (std::vector<Hit_t> const& hits) const -> std::vector<Data_t>
+{
+  std::vector<KeyedData_t> data;
+  data.reserve(hits.size());
+  for (std::size_t iHit = 0; iHit < hits.size(); ++iHit)
+    convertHit(hits[iHit], iHit, data);
+  return sortedData(std::move(data));
+} // icarus::crt::BernCRTDataConverter::convert()
+
+
+// -----------------------------------------------------------------------------
+auto icarus::crt::BernCRTDataConverter::convertParallel
+  (std::vector<Hit_t> const& hits) const -> std::vector<Data_t>
+{
+  tbb::enumerable_thread_specific<std::vector<KeyedData_t>> threadData;
+
+  tbb::parallel_for(tbb::blocked_range<std::size_t>(0, hits.size()),
+    [this, &hits, &threadData](tbb::blocked_range<std::size_t> const& range)
+      {
+        std::vector<KeyedData_t>& data = threadData.local();
+        for (std::size_t iHit = range.begin(); iHit < range.end(); ++iHit)
+          convertHit(hits[iHit], iHit, data);
+      }
+    );
+
+  // the order of the buffers depends on the scheduling: sorting fixes it
+  std::vector<KeyedData_t> data;
+  for (std::vector<KeyedData_t>& buffer: threadData) {
+    data.insert(data.end(),
+      std::make_move_iterator(buffer.begin()),
+      std::make_move_iterator(buffer.end())
+      );
+  }
+  return sortedData(std::move(data));
+} // icarus::crt::BernCRTDataConverter::convertParallel()
+
+
+// -----------------------------------------------------------------------------
+bool icarus::crt::BernCRTDataConverter::IsSideCRT(Hit_t const& hit) {
+  /**
+   * Fragment ID described in SBN doc 16111
+   */
+  return (hit.fragment_ID & 0x3100) == 0x3100;
+} // icarus::crt::BernCRTDataConverter::IsSideCRT()
+
+
+// -----------------------------------------------------------------------------
+std::uint64_t icarus::crt::BernCRTDataConverter::CalculateTimestamp
+  (Hit_t const& hit)
+{
+  /**
+   * Calculate timestamp based on nanosecond from FEB and poll times measured by server
+   * see: https://sbn-docdb.fnal.gov/cgi-bin/private/DisplayMeeting?sessionid=7783
+   */
+  int32_t ts0  = hit.ts0; //must be signed int
+
+  uint64_t mean_poll_time = hit.last_poll_start/2 + hit.this_poll_end/2;
+  int mean_poll_time_ns = mean_poll_time % (1000'000'000); 
+  
+  return mean_poll_time - mean_poll_time_ns + ts0
+    + (ts0 - mean_poll_time_ns < -500'000'000) * 1000'000'000
+    - (ts0 - mean_poll_time_ns >  500'000'000) * 1000'000'000;
+} // icarus::crt::BernCRTDataConverter::CalculateTimestamp()
+
+
+// -----------------------------------------------------------------------------
+void icarus::crt::BernCRTDataConverter::CorrectForCableDelay(Hit_t& hit) const
+{
+  if(!hit.IsReference_TS0() && !hit.IsReference_TS1()) { //don't correct reference T0 and T1 hits for cable length
+    try {
+      int32_t delay;
+      if(IsSideCRT(hit)) {
+        delay = fSideDelays.at(hit.mac5);
+      }
+      else {
+        delay = fTopDelays.at(hit.mac5);
+      }
+      hit.ts0 += delay;
+      hit.ts0 %= 1'000'000'000;
+      if(hit.ts0 < 0) hit.ts0 += 1000'000'000; //just in case the cable offset is negative (should be positive normally)
+      hit.ts1 += delay;
+    } catch(const std::out_of_range & e) {
+      throw cet::exception("DecoderICARUSCRT")
+        << "CRT MAC "<<(int)(hit.mac5)<<" not found in the FEB_delay array!!! Please update FEB_delay FHiCL file\n";
+    }
+  }
+} // icarus::crt::BernCRTDataConverter::CorrectForCableDelay()
+
+
+// -----------------------------------------------------------------------------
+void icarus::crt::BernCRTDataConverter::convertHit
+  (Hit_t hit, std::size_t hitIndex, std::vector<KeyedData_t>& output) const
+{
+  CorrectForCableDelay(hit);  //add PPS cable length
+
+  if(IsSideCRT(hit)) {
+    std::array<Recipe_t, MaxDataPerHit> allRecipes;
+
+    //
+    // fill the recipe
+    //
+    if (!((hit.mac5 >= 88 && hit.mac5 <= 91)
+          || hit.mac5 == 96 || hit.mac5 == 97
+          || hit.mac5 ==  1 || hit.mac5 ==  3
+          || hit.mac5 ==  6 || hit.mac5 ==  7)) { // look for FEB those are not between 88 to 91
+
+      int const destMac5 = fSideSimMac(hit.mac5);
+
+      Recipe_t recipe;
+
+      //
+      // first block of 10 channels from source
+      //
+      recipe.destMac5 = destMac5;
+
+      recipe.firstSourceChannel =  2;
+      recipe.lastSourceChannel  = 11;
+
+      recipe.firstDestChannel   =  0;
+      recipe.lastDestChannel    =  9;
+      recipe.direction          = +1;
+      allRecipes[0] = recipe;
+
+      //
+      // second block of 10 channels from source
+      //
+      recipe.destMac5 = destMac5;
+      recipe.firstSourceChannel = 12;
+      recipe.lastSourceChannel  = 21;
+
+      recipe.firstDestChannel   = 10;
+      recipe.lastDestChannel    = 19;
+      recipe.direction          = +1;
+      allRecipes[1] = recipe;
+
+      //
+      // third block of 10 channels from source
+      //
+      recipe.destMac5 = destMac5;
+      recipe.firstSourceChannel  = 22;
+      recipe.lastSourceChannel   = 31;
+
+      recipe.firstDestChannel    = 20;
+      recipe.lastDestChannel     = 29;
+      recipe.direction           = +1;
+      allRecipes[2] = recipe;
+
+
+    } // "normal assignment"
+    else if (hit.mac5 ==  97) { // south wall - east side top horizontal module channels are reversed
+
+      int const destMac5 = fSideSimMac(hit.mac5);
+
+      Recipe_t recipe;
+
+      //
+      // first block of 10 channels from source
+      //
+      recipe.destMac5 = destMac5;
+
+      recipe.firstSourceChannel =  2;
+      recipe.lastSourceChannel  = 11;
+
+      recipe.firstDestChannel   =  0;
+      recipe.lastDestChannel    =  9;
+      recipe.direction          = +1;
+      allRecipes[0] = recipe;
+
+      //
+      // second block of 10 channels from source
+      //
+      recipe.destMac5 = destMac5;
+      recipe.firstSourceChannel = 12;
+      recipe.lastSourceChannel  = 21;
+
+      recipe.firstDestChannel   = 10;
+      recipe.lastDestChannel    = 19;
+      recipe.direction          = +1;
+      allRecipes[1] = recipe;
+
+      //
+      // third block of 10 channels from source
+      //
+      recipe.destMac5 = destMac5;
+      recipe.firstSourceChannel  = 22;
+      recipe.lastSourceChannel   = 31;
+
+      recipe.firstDestChannel    = 29;
+      recipe.lastDestChannel     = 20;
+      recipe.direction           = -1;
+      allRecipes[2] = recipe;
+
+
+    }
+    else if (hit.mac5 == 1 || hit.mac5 == 3 ||
+        hit.mac5 == 6 || hit.mac5 == 7 ||
+        hit.mac5 == 96) { // north wall inner layer and south wall west side top three horizontal layer orientation is reversed
+
+      int const destMac5 = fSideSimMac(hit.mac5);
+
+      Recipe_t recipe;
+
+      //
+      // first block of 10 channels from source
+      //
+      recipe.destMac5 = destMac5;
+
+      recipe.firstSourceChannel  =  2;
+      recipe.lastSourceChannel   = 11;
+
+      recipe.firstDestChannel    =  9;
+      recipe.lastDestChannel     =  0;
+      recipe.direction           = -1;
+      allRecipes[0] = recipe;
+
+      //
+      // second block of 10 channels from source
+      //
+      recipe.destMac5 = destMac5;
+      recipe.firstSourceChannel = 12;
+      recipe.lastSourceChannel  = 21;
+
+      recipe.firstDestChannel   = 19;
+      recipe.lastDestChannel    = 10;
+      recipe.direction          = -1;
+      allRecipes[1] = recipe;
+
+      //
+      // third block of 10 channels from source: special mapping
+      //
+      recipe.destMac5 = destMac5;
+      recipe.firstSourceChannel = 22;
+      recipe.lastSourceChannel  = 31;
+
+      recipe.firstDestChannel   = 29;
+      recipe.lastDestChannel    = 20;
+      recipe.direction          = -1;
+      allRecipes[2] = recipe;
+
+    }
+    else if (hit.mac5 == 88) {
+
+      int const destMac5 = fSideSimMac(hit.mac5);
+
+      Recipe_t recipe;
+
+      //
+      // first block of 10 channels from source
+      //
+      recipe.destMac5 = 79;
+
+      recipe.firstSourceChannel  =  2;
+      recipe.lastSourceChannel   = 11;
+
+      recipe.firstDestChannel    =  29;
+      recipe.lastDestChannel     =  20;
+      recipe.direction           =  -1;
+      allRecipes[0] = recipe;
+
+      //
+      // second block of 10 channels from source
+      //
+      recipe.destMac5 = destMac5;
+      recipe.firstSourceChannel = 12;
+      recipe.lastSourceChannel  = 21;
+
+      recipe.firstDestChannel   = 10;
+      recipe.lastDestChannel    = 19;
+      recipe.direction          = +1;
+      allRecipes[1] = recipe;
+
+      //
+      // third block of 10 channels from source: special mapping
+      //
+      recipe.destMac5 = destMac5;
+      recipe.firstSourceChannel = 22;
+      recipe.lastSourceChannel  = 31;
+
+      recipe.firstDestChannel   =  0;
+      recipe.lastDestChannel    =  9;
+      recipe.direction          = +1;
+      allRecipes[2] = recipe;
+
+    }
+    else if ((hit.mac5 >= 89) && (hit.mac5 <= 91)) {
+
+      int const destMac5 = fSideSimMac(hit.mac5);
+
+      Recipe_t recipe;
+
+      //
+      // first block of 10 channels from source
+      //
+      recipe.destMac5 = destMac5;
+
+      recipe.firstSourceChannel  =  2;
+      recipe.lastSourceChannel   = 11;
+
+      recipe.firstDestChannel    = 19;
+      recipe.lastDestChannel     = 10;
+      recipe.direction           = -1;
+      allRecipes[0] = recipe;
+
+      //
+      // second block of 10 channels from source
+      //
+
+      recipe.destMac5 = destMac5;
+      recipe.firstSourceChannel = 12;
+      recipe.lastSourceChannel  = 21;
+
+      recipe.firstDestChannel   =  9;
+      recipe.lastDestChannel    =  0;
+      recipe.direction          = -1;
+      allRecipes[1] = recipe;
+
+      //
+      // third block of 10 channels from source: special mapping
+      //
+      recipe.destMac5 = destMac5 - 1;
+      recipe.firstSourceChannel  = 22;
+      recipe.lastSourceChannel   = 31;
+
+      recipe.firstDestChannel    = 29;
+      recipe.lastDestChannel     = 20;
+      recipe.direction           = -1;
+
+      allRecipes[2] = recipe;
+
+    } // if not 88
+
+    //
+    // cook the crtdata
+    //
+    std::size_t key = MaxDataPerHit * hitIndex;
+    for (Recipe_t const& recipe: allRecipes) {
+      if (recipe.firstSourceChannel == recipe.lastSourceChannel) continue;
+
+      icarus::crt::CRTData data;
+      data.fMac5  = recipe.destMac5;
+      data.fTs0   = CalculateTimestamp(hit);
+      data.fTs1   = hit.ts1;
+      data.fFlags                   = hit.flags;
+      data.fThisPollStart           = hit.this_poll_start;
+      data.fLastPollStart           = hit.last_poll_start;
+      data.fHitsInPoll              = hit.hits_in_poll;
+      data.fCoinc                   = hit.coinc;
+      data.fLastAcceptedTimestamp   = hit.last_accepted_timestamp;
+      data.fLostHits                = hit.lost_hits;
+
+      unsigned destCh = recipe.firstDestChannel;
+      for (unsigned srcCh = recipe.firstSourceChannel; srcCh <= recipe.lastSourceChannel; ++srcCh) {
+
+        data.fAdc[destCh] = hit.adc[srcCh];
+        destCh += recipe.direction; // increase or decrease the source
+
+      }
+      output.emplace_back(key++, data);
+    } // for all recipes
+  }
+  else { //not side CRT, therefore top CRT
+    //this code needs review by the TOP CRT group!!!
+      icarus::crt::CRTData data;
+      data.fMac5  = fTopSimMac(hit.mac5); 
+      data.fTs0   = CalculateTimestamp(hit);
+      data.fTs1   = hit.ts1;
+      data.fFlags                   = hit.flags;
+      data.fThisPollStart           = hit.this_poll_start;
+      data.fLastPollStart           = hit.last_poll_start;
+      data.fHitsInPoll              = hit.hits_in_poll;
+      data.fCoinc                   = hit.coinc;
+      data.fLastAcceptedTimestamp   = hit.last_accepted_timestamp;
+      data.fLostHits                = hit.lost_hits;
+
+      memcpy(data.fAdc, hit.adc, 32*sizeof(hit.adc[0]));
+      
+      output.emplace_back(MaxDataPerHit * hitIndex, data);
+  }
+
+
+} // icarus::crt::BernCRTDataConverter::convertHit()
+
+
+// -----------------------------------------------------------------------------
+auto icarus::crt::BernCRTDataConverter::sortedData
+  (std::vector<KeyedData_t>&& data) -> std::vector<Data_t>
+{
+  // drop the data which is not assigned a valid Mac5
+  data.erase(
+    std::remove_if(data.begin(), data.end(),
+      [](KeyedData_t const& elem){ return elem.second.fMac5 == 0; }),
+    data.end()
+    );
+
+  std::sort(data.begin(), data.end(),
+    [](KeyedData_t const& a, KeyedData_t const& b)
+      {
+        return std::tie(a.second.fMac5, a.second.fTs0, a.first)
+          < std::tie(b.second.fMac5, b.second.fTs0, b.first);
+      }
+    );
+
+  std::vector<Data_t> sorted;
+  sorted.reserve(data.size());
+  for (KeyedData_t& elem: data) sorted.push_back(std::move(elem.second));
+  return sorted;
+} // icarus::crt::BernCRTDataConverter::sortedData()
+
+
+// -----------------------------------------------------------------------------
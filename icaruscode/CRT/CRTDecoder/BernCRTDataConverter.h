@@ -0,0 +1,102 @@
+/**
+ * @file   icaruscode/CRT/CRTDecoder/BernCRTDataConverter.h
+ * @brief  Conversion of decoded BernCRT hits into `icarus::crt::CRTData`.
+ * @date   October 19, 2026
+ * @see    icaruscode/CRT/CRTDecoder/BernCRTDataConverter.cc
+ */
+
+#ifndef ICARUSCODE_CRT_CRTDECODER_BERNCRTDATACONVERTER_H
+#define ICARUSCODE_CRT_CRTDECODER_BERNCRTDATACONVERTER_H
+
+// SBN libraries
+#include "sbndaq-artdaq-core/Overlays/Common/BernCRTTranslator.hh"
+#include "sbnobj/ICARUS/CRT/CRTData.hh"
+
+// C/C++ standard library
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint8_t, std::int32_t, std::uint64_t
+#include <functional>
+#include <map>
+#include <utility> // std::pair
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::crt { class BernCRTDataConverter; }
+/**
+ * @brief Converts BernCRT hits into CRT data with simulation channel mapping.
+ *
+ * Each hit from a BernCRT front-end board is corrected for the cable delay of
+ * its board and turned into one `icarus::crt::CRTData` for top CRT boards, or
+ * into up to three (one per block of 10 channels) for side CRT boards, with
+ * MAC addresses and channels remapped to the simulation convention.
+ * Data which is not assigned a valid MAC address (`0`) is dropped.
+ *
+ * The output is sorted by MAC address and timestamp (`fMac5`, `fTs0`), and
+ * then by the position of the hit in the input (and of the channel block).
+ * `convertParallel()` processes the hits in parallel, each thread into its own
+ * buffer, and its result is identical to the one of `convert()`.
+ *
+ * The mapping of the hardware MAC addresses to the simulation ones is provided
+ * as callable objects, typically wrapping
+ * `icarusDB::IICARUSChannelMapProvider::getSimMacAddress()` and
+ * `gettopSimMacAddress()`; they must be safe to call concurrently.
+ */
+class icarus::crt::BernCRTDataConverter {
+
+    public:
+
+  using Hit_t = icarus::crt::BernCRTTranslator; ///< Type of input hit.
+  using Data_t = icarus::crt::CRTData; ///< Type of output data.
+
+  /// Maps a hardware MAC address into the simulation one.
+  using MacMap_t = std::function<unsigned int(unsigned int)>;
+
+  /// Cable delay [ns] of each board, by MAC address.
+  using Delays_t = std::map<std::uint8_t, std::int32_t>;
+
+
+  BernCRTDataConverter(
+    MacMap_t sideSimMac, MacMap_t topSimMac,
+    Delays_t sideDelays, Delays_t topDelays
+    );
+
+  /// Returns the data from all `hits`, processed sequentially.
+  std::vector<Data_t> convert(std::vector<Hit_t> const& hits) const;
+
+  /// Returns the data from all `hits`, processed in parallel.
+  std::vector<Data_t> convertParallel(std::vector<Hit_t> const& hits) const;
+
+  /// Returns whether the `hit` comes from a side CRT board.
+  static bool IsSideCRT(Hit_t const& hit);
+
+  /// Returns the timestamp of the `hit` from board and server times.
+  static std::uint64_t CalculateTimestamp(Hit_t const& hit);
+
+
+    private:
+
+  /// Data with the sorting key for ties (position of hit and block in input).
+  using KeyedData_t = std::pair<std::size_t, Data_t>;
+
+  MacMap_t fSideSimMac; ///< Side CRT MAC address mapping.
+  MacMap_t fTopSimMac; ///< Top CRT MAC address mapping.
+  Delays_t fSideDelays; ///< Side CRT cable delays.
+  Delays_t fTopDelays; ///< Top CRT cable delays.
+
+  /// Adds to `hit` the cable delay of its board.
+  void CorrectForCableDelay(Hit_t& hit) const;
+
+  /// Appends to `output` the data from `hit` (at `hitIndex` in the input).
+  void convertHit
+    (Hit_t hit, std::size_t hitIndex, std::vector<KeyedData_t>& output) const;
+
+  /// Returns the valid data, sorted.
+  static std::vector<Data_t> sortedData(std::vector<KeyedData_t>&& data);
+
+}; // icarus::crt::BernCRTDataConverter
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSCODE_CRT_CRTDECODER_BERNCRTDATACONVERTER_H
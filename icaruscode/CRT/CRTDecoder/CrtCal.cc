@@ -2,14 +2,35 @@
 #define CRT_CAL_CC
 
 #include "icaruscode/CRT/CRTDecoder/CrtCal.h"
+#include "icaruscode/Utilities/LeastSquaresFitter.h"
+
+#include <TMath.h>
+#include <TPolyMarker.h>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
 
 using namespace icarus::crt;
 
-CrtCal::CrtCal(const vector<TH1F*>* histos) : fHistos(histos) {
+CrtCal::CrtCal(const vector<TH1F*>* histos, bool savePlots)
+  : fHistos(histos), fSavePlots(savePlots) {
 
 	fMac5 = 0;
         this->IndexToMacChan();
 
+	//the calibration works on a copy of the content of the histograms
+	for(const TH1F* h : *fHistos){
+		HistData_t data;
+		data.name = h->GetName();
+		data.low = h->GetXaxis()->GetXmin();
+		data.width = (h->GetXaxis()->GetXmax()-data.low)/h->GetNbinsX();
+		data.entries = h->GetEntries();
+		data.content.resize(h->GetNbinsX()+2);
+		for(int bin=0; bin<=h->GetNbinsX()+1; bin++) data.content[bin] = h->GetBinContent(bin);
+		fHistData.push_back(std::move(data));
+	}
+
 	fHasActive = false;
 	fHasThresh = false;
 	fHasPedCal = false;
@@ -204,44 +225,276 @@ void CrtCal::IndexToMacChan(){
         return;
 }
 
+//helpers on histogram content held in plain arrays
+int CrtCal::HistData_t::FindBin(double x) const {
+	if(x<low) return 0;
+	const double bin = 1 + std::floor((x-low)/width);
+	return (bin>NBins()) ? NBins()+1 : (int)bin;
+}
+
+double CrtCal::HistData_t::Integral(int first, int last) const {
+	first = std::max(first,0);
+	last = std::min(last,NBins()+1);
+	double sum = 0.;
+	for(int bin=first; bin<=last; bin++) sum += content[bin];
+	return sum;
+}
+
+//same as TH1::Rebin(): the bins left over at the end go into the overflow
+CrtCal::HistData_t CrtCal::HistData_t::Rebinned(int ngroup) const {
+	HistData_t h;
+	h.name = name;
+	h.low = low;
+	h.width = width*ngroup;
+	h.entries = entries;
+	const int nbins = NBins()/ngroup;
+	h.content.assign(nbins+2,0.);
+	h.content[0] = content[0];
+	for(int bin=1; bin<=NBins(); bin++)
+		h.content[std::min((bin-1)/ngroup+1,nbins+1)] += content[bin];
+	h.content[nbins+1] += content[NBins()+1];
+	return h;
+}
+
+namespace {
+
+	using icarus::crt::CrtCal;
+	using util::LeastSquaresFitter;
+
+	//bin range selected by TAxis::SetRangeUser(low,high)
+	std::pair<int,int> AxisRange(const CrtCal::HistData_t& h, double low, double high){
+		int first = h.FindBin(low);
+		int last = h.FindBin(high);
+		if(h.BinLowEdge(first+1)<=low) first++;
+		if(h.BinLowEdge(last)>=high) last--;
+		return { std::max(first,1), std::min(last,h.NBins()) };
+	}
+
+	//first bin with the largest (or smallest) content in the range
+	int ExtremeBin(const CrtCal::HistData_t& h, std::pair<int,int> range, bool maximum){
+		int best = range.first;
+		for(int bin=range.first+1; bin<=range.second; bin++){
+			if(maximum ? (h.content[bin]>h.content[best]) : (h.content[bin]<h.content[best]))
+				best = bin;
+		}
+		return best;
+	}
+
+	//points for a chi-square fit of the bins in `range` with center in [low,high];
+	//empty bins are skipped and the errors are the square root of the content
+	struct FitData_t { vector<double> x, y, ey; };
+
+	FitData_t FitData(const CrtCal::HistData_t& h, std::pair<int,int> range, double low, double high){
+		FitData_t data;
+		for(int bin=range.first; bin<=range.second; bin++){
+			const double x = h.BinCenter(bin);
+			if(x<low || x>high || h.content[bin]<=0.) continue;
+			data.x.push_back(x);
+			data.y.push_back(h.content[bin]);
+			data.ey.push_back(std::sqrt(h.content[bin]));
+		}
+		return data;
+	}
+
+	//[0]*exp(-0.5*((x-[1])/[2])^2)
+	double Gauss(double x, const double* par, double* grad){
+		const double u = (x-par[1])/par[2];
+		const double g = std::exp(-0.5*u*u);
+		grad[0] = g;
+		grad[1] = par[0]*g*u/par[2];
+		grad[2] = par[0]*g*u*u/par[2];
+		return par[0]*g;
+	}
+
+	//[0] + [1]*x
+	double Line(double x, const double* par, double* grad){
+		grad[0] = 1.;
+		grad[1] = x;
+		return par[0] + par[1]*x;
+	}
+
+	double langaufun(double x, const double* par) {
+
+	    //Fit parameters:
+	    //par[0]=Width (scale) parameter of Landau density
+	    //par[1]=Most Probable (MP, location) parameter of Landau density
+	    //par[2]=Total area (integral -inf to inf, normalization constant)
+	    //par[3]=Width (sigma) of convoluted Gaussian function
+	    //
+	    //In the Landau distribution (represented by the CERNLIB approximation),
+	    //the maximum is located at x=-0.22278298 with the location parameter=0.
+	    //This shift is corrected within this function, so that the actual
+	    //maximum is identical to the MP parameter.
+
+	    // Numeric constants
+	    const double invsq2pi = 0.3989422804014;   // (2 pi)^(-1/2)
+	    const double mpshift  = -0.22278298;       // Landau maximum location
+
+	    // Control constants
+	    const double np = 100.0;      // number of convolution steps
+	    const double sc =   5.0;      // convolution extends to +-sc Gaussian sigmas
+
+	    // MP shift correction
+	    const double mpc = par[1] - mpshift * par[0];
+
+	    // Range of convolution integral
+	    const double xlow = x - sc * par[3];
+	    const double xupp = x + sc * par[3];
+
+	    const double step = (xupp-xlow) / np;
+
+	    // Convolution integral of Landau and Gaussian by sum
+	    double sum = 0.0;
+	    for(double i=1.0; i<=np/2; i++) {
+	       double xx = xlow + (i-.5) * step;
+	       double fland = TMath::Landau(xx,mpc,par[0]) / par[0];
+	       sum += fland * TMath::Gaus(x,xx,par[3]);
+
+	       xx = xupp - (i-.5) * step;
+	       fland = TMath::Landau(xx,mpc,par[0]) / par[0];
+	       sum += fland * TMath::Gaus(x,xx,par[3]);
+	    }
+
+	    return (par[2] * step * sum * invsq2pi / par[3]);
+	}
+
+	//langaufun with derivatives from central differences (the area is a scale)
+	double Langaus(double x, const double* par, double* grad){
+		const double value = langaufun(x,par);
+		double p[4] = { par[0], par[1], par[2], par[3] };
+		for(size_t i: { 0, 1, 3 }){
+			const double h = 1e-5*std::max(std::abs(par[i]),1.);
+			p[i] = par[i]+h;
+			const double up = langaufun(x,p);
+			p[i] = par[i]-h;
+			const double down = langaufun(x,p);
+			p[i] = par[i];
+			grad[i] = (up-down)/(2*h);
+		}
+		grad[2] = value/par[2];
+		return value;
+	}
+
+	//candidate peak positions in the bin range, replacing TSpectrum::Search():
+	//the spectrum is smoothed with a gaussian of `sigma` bins and peaks are the
+	//maxima of its negative second derivative (insensitive to a slowly varying
+	//background) higher than `threshold` times the highest one
+	vector<double> FindPeaks(const CrtCal::HistData_t& h, std::pair<int,int> range,
+	                         double sigma, double threshold){
+
+		const int n = range.second-range.first+1;
+		if(n<5) return {};
+
+		const int r = (int)std::ceil(3*sigma);
+		vector<double> kernel(2*r+1);
+		double norm = 0.;
+		for(int k=-r; k<=r; k++) norm += kernel[k+r] = std::exp(-0.5*k*k/(sigma*sigma));
+		for(double& k : kernel) k /= norm;
+
+		vector<double> smooth(n,0.);
+		for(int i=0; i<n; i++){
+			for(int k=-r; k<=r; k++){
+				const int bin = std::clamp(range.first+i+k,range.first,range.second);
+				smooth[i] += kernel[k+r]*h.content[bin];
+			}
+		}
+
+		vector<double> d2(n,0.);
+		for(int i=1; i<n-1; i++) d2[i] = 2*smooth[i]-smooth[i-1]-smooth[i+1];
+		const double maxd2 = *std::max_element(d2.begin(),d2.end());
+		if(maxd2<=0.) return {};
+
+		vector<double> peaks;
+		for(int i=2; i<n-2; i++){
+			if(d2[i]<=d2[i-1] || d2[i]<d2[i+1] || d2[i]<threshold*maxd2) continue;
+			const double curv = d2[i-1]-2*d2[i]+d2[i+1];
+			const double shift = (curv<0.) ? 0.5*(d2[i-1]-d2[i+1])/curv : 0.;
+			peaks.push_back(h.BinCenter(range.first+i)+shift*h.width);
+		}
+		return peaks;
+	}
+
+	CrtCal::FitSummary_t Summary(const LeastSquaresFitter::Result_t& fit, double low, double high){
+		CrtCal::FitSummary_t summary;
+		summary.low = low;
+		summary.high = high;
+		summary.par = fit.parameters;
+		summary.err = fit.errors;
+		summary.chi2 = fit.chi2;
+		summary.ndf = std::max(fit.ndf,0);
+		return summary;
+	}
+
+	//name of a plot file not yet existing: <base>_<counter>.png
+	TString PlotFileName(TString fname){
+		int ctr = 1;
+		const string suff = ".png";
+		fname+="_"+to_string(ctr)+suff;
+		while (!gSystem->AccessPathName(fname))
+		{
+			fname.Remove(fname.Length()-suff.size()-to_string(ctr).size(),fname.Length());
+			ctr++;
+			fname+=to_string(ctr)+suff;
+		}
+		return fname;
+	}
+
+	TF1* MakeFunction(const char* name, const char* formula, const CrtCal::FitSummary_t& fit){
+		TF1* f = new TF1(name,formula,fit.low,fit.high);
+		for(size_t i=0; i<fit.par.size(); i++){
+			f->SetParameter(i,fit.par[i]);
+			f->SetParError(i,fit.err[i]);
+		}
+		f->SetChisquare(fit.chi2);
+		f->SetNDF(fit.ndf);
+		return f;
+	}
+
+} // local namespace
+
 void CrtCal::Cal(){
 
 	size_t nactive = 0;
-	std::cout << "ActiveChannel scan..." << std::endl;
-        for(size_t i=0; i<fHistos->size(); i++){
-                TH1F* h1 = (TH1F*)fHistos->at(i)->Clone();
-		TH1F* h2 = (TH1F*)fHistos->at(i)->Clone();
-		TH1F* h3 = (TH1F*)fHistos->at(i)->Clone();
+	fLog << "ActiveChannel scan..." << std::endl;
+        for(size_t i=0; i<fHistData.size(); i++){
+		const HistData_t& h = fHistData[i];
 		const size_t chan = fChanMap[i];
-		fActive[chan] = IsActive(h1);
-		delete h1;
+		fActive[chan] = IsActive(h);
 		if(fActive[chan]) {
 			nactive++;
-			fThreshADC[chan] = FindThreshADC(h2);
-			delete h2;
-			std::cout << "ch. " << chan << " ADC thresh: " << fThreshADC[chan] << std::endl;
-			fNabove[chan] = FindNabove(h3,fThreshADC[chan]);
-			delete h3;
+			fThreshADC[chan] = FindThreshADC(h);
+			fLog << "ch. " << chan << " ADC thresh: " << fThreshADC[chan] << std::endl;
+			fNabove[chan] = FindNabove(h,fThreshADC[chan]);
 		} 
 	}
-	std::cout << "found " << nactive << " active channels" << std::endl;
+	fLog << "found " << nactive << " active channels" << std::endl;
 
-	std::cout << "PedCal..." << std::endl;
+	fLog << "PedCal..." << std::endl;
 	PedCal();
-	std::cout << "GainCal..." << std::endl;
+	fLog << "GainCal..." << std::endl;
 	GainCal();
 
 	for(size_t ch=0; ch<32; ch++){
 		if(!fActive[ch]) continue;
 		fThreshPE[ch] = 1.0*(fThreshADC[ch]-fPed[ch])/fGain[ch];
 	}	
+
+	if(fSavePlots) {
+		PrintLog();
+		SavePlots();
+	}
 }
 
-bool CrtCal::IsActive(TH1F* h){
+void CrtCal::PrintLog(std::ostream& out){
+	out << fLog.str() << std::flush;
+	fLog.str("");
+}
+
+bool CrtCal::IsActive(const HistData_t& h){
 
 	const size_t cutoff = 600;
 
-	if(h->Integral(h->FindBin(cutoff),h->GetNbinsX())==0) {
+	if(h.Integral(h.FindBin(cutoff),h.NBins())==0) {
 		return false;
 	}
 
@@ -250,20 +503,19 @@ bool CrtCal::IsActive(TH1F* h){
 	return true;
 }
 
-int CrtCal::FindThreshADC(TH1F* h){
+int CrtCal::FindThreshADC(const HistData_t& h){
 	const size_t low = 300;
 	const size_t high = 1000;
 	int thresh=0;
 	
-	h->GetXaxis()->SetRangeUser(low,high);
-	thresh = (int)h->GetBinLowEdge(h->GetMinimumBin());
+	thresh = (int)h.BinLowEdge(ExtremeBin(h,AxisRange(h,low,high),false));
 	fHasThresh = true;
 
 	return thresh;
 }
 
-int CrtCal::FindNabove(TH1F* h, int thresh){
-	return h->Integral(h->FindBin(thresh),h->GetNbinsX()+1);
+int CrtCal::FindNabove(const HistData_t& h, int thresh){
+	return h.Integral(h.FindBin(thresh),h.NBins()+1);
 }
 
 void CrtCal::PedCal(){
@@ -275,13 +527,11 @@ void CrtCal::PedCal(){
         	statarr[i] = FLT_MAX;
         }
 
-	for(size_t i=0; i<fHistos->size(); i++){
+	for(size_t i=0; i<fHistData.size(); i++){
 		const size_t chan = fChanMap[i];
-		TH1F* h = (TH1F*)fHistos->at(i)->Clone();
-		PedFit(h,chan,statarr,true);
+		PedFit(fHistData[i],chan,statarr);
 		ParsePedStats(statarr, fPed[chan], fPedErr[chan], fPedNorm[chan], fPedNormErr[chan],
                                fPedSigma[chan], fPedSigmaErr[chan], fPedXsqr[chan], fPedNdf[chan] );
-		delete h;
 	}
 
 	delete[] statarr;
@@ -293,7 +543,7 @@ void CrtCal::PedCal(){
 void CrtCal::GainCal(){
 
 	if(!fHasPedCal) {
-		std::cout << "need ped cal before gain cal!" << std::endl;
+		fLog << "need ped cal before gain cal!" << std::endl;
 		return;
 	}
 	if(fHasGainCal) return;
@@ -306,235 +556,131 @@ void CrtCal::GainCal(){
                 }
         }
 
-	for(size_t i=0; i<fHistos->size(); i++){
+	for(size_t i=0; i<fHistData.size(); i++){
 		const size_t chan = fChanMap[i];
 		if(!fActive[chan]) continue;
-		//std::cout << "channel " << chan << std::endl;
-		TH1F* h = (TH1F*)fHistos->at(i)->Clone();
-		fChanStats[chan]=h->GetEntries();
-		//std::cout << "call to GainFit()" << std::endl;
-        	GainFit(h,chan,statarr,true);
-		//std::cout << "ParseGainStats()..." << std::endl;
+		const HistData_t h = fHistData[i].Rebinned(4);
+		fChanStats[chan]=h.entries;
+        	GainFit(h,chan,statarr);
 		ParseGainStats(statarr, fGainXsqr[chan], fGainNdf[chan], fGain[chan], fGainErr[chan],
                             fGainPed[chan], fGainPedErr[chan], fNpeak[chan], fPeakXsqr[chan],
                             fPeakMean[chan], fPeakMeanErr[chan], fPeakNorm[chan], fPeakNormErr[chan],
                             fPeakSigma[chan], fPeakSigmaErr[chan], fPeakNdf[chan]);
-		langaus_fit(h,fLangausWidth[chan],fLangausWidthErr[chan],
-			    fLangausLandauMP[chan],fLangausLandauMPErr[chan],
-			    fLangausArea[chan],fLangausAreaErr[chan],
-			    fLangausGaussSigma[chan],fLangausGaussSigmaErr[chan],
-			    fLangausXsqr[chan],fLangausNdf[chan]);
-
-		delete h;
+		langaus_fit(h,chan);
 	}
 
+	for(size_t i=0; i<15; i++) delete[] statarr[i];
 	delete[] statarr;
 	fHasGainCal = true;
 	return;
 }
 
-void CrtCal::PedFit(TH1F* h, size_t chan, float* statsarr, bool save=false){
+void CrtCal::PedFit(const HistData_t& h, size_t chan, float* statsarr){
 
 	const int low = 1, high = 300;
 
-	h->GetXaxis()->SetRangeUser(low,high);
-
-        const int max_bin = h->GetMaximumBin();
-        const int max_val = h->GetMaximum();
-        const int max_adc = h->GetBinLowEdge(max_bin);
-
-        //Define fitting function:
-        TF1 *gausfit = new TF1("gausfit","[0]*exp(-0.5*((x-[1])/[2])^2)",max_adc-12,max_adc+12);
-
-        //Set parameter names:
-        gausfit->SetParName(0,"Constant");
-        gausfit->SetParName(1,"Peak value");
-        gausfit->SetParName(2,"sigma");
-
-        //Initial guesses for the parameters:
-        gausfit->SetParameter(0,max_val);
-        gausfit->SetParLimits(0,0.5*max_val,1000*max_val);
-        gausfit->SetParameter(1,max_adc);
-        gausfit->SetParLimits(1,max_adc-20,max_adc+20);
-        gausfit->SetParameter(2,50.0);//h->GetStdDev());
-        gausfit->SetParLimits(2,1,50);
-
-        TCanvas *c = new TCanvas();
-        c->SetGrid();
-
-        gStyle->Reset("Modern");
-        if(h->GetMean()>(high-low)/2)
-                gStyle->SetStatX(0.4);
-        else
-                gStyle->SetStatX(0.9);
-
-        gStyle->SetStatY(0.89);
-        gStyle->SetStatH(0.45);
-        gStyle->SetStatW(0.28);
-        h->Draw("e0samehist");
-        //h->Draw("E0same");//hist");
-        h->Fit(gausfit,"RMQ");
-
-        float csq = gausfit->GetChisquare(); //chi-squared
-        float ndf = gausfit->GetNDF(); //NDF
+	const std::pair<int,int> range = AxisRange(h,low,high);
+
+        const int max_bin = ExtremeBin(h,range,true);
+        const int max_val = h.content[max_bin];
+        const int max_adc = h.BinLowEdge(max_bin);
+
+        //fit function: [0]*exp(-0.5*((x-[1])/[2])^2) ("Constant", "Peak value", "sigma")
+        LeastSquaresFitter fitter(3);
+        fitter.setParLimits(0,0.5*max_val,1000*max_val);
+        fitter.setParLimits(1,max_adc-20,max_adc+20);
+        fitter.setParLimits(2,1,50);
+
+        double fitlow = max_adc-12, fithigh = max_adc+12;
+        FitData_t data = FitData(h,range,fitlow,fithigh);
+        LeastSquaresFitter::Result_t fit = fitter.fit(Gauss,data.x,data.y,data.ey,
+                                                      { (double)max_val, (double)max_adc, 50.0 });
+
+        float csq = fit.chi2; //chi-squared
+        float ndf = fit.ndf; //NDF
         float rcsq = csq/ndf; //reduced chi-squared
 
      if(rcsq>10.0)
         {
                 //cout << "X^2/NDF > 10...recursive refit..." << endl;
-                gausfit->SetRange(gausfit->GetParameter(1)-10,gausfit->GetParameter(1)+10);
-                gausfit->SetParameter(0,gausfit->GetParameter(0));
-                gausfit->SetParLimits(0,gausfit->GetParameter(0)-50,gausfit->GetParameter(0)+50);
-                gausfit->SetParameter(1,gausfit->GetParameter(1));
-                gausfit->SetParLimits(1,gausfit->GetParameter(1)-10,gausfit->GetParameter(1)+10);
-                gausfit->SetParameter(2,gausfit->GetParameter(2));
-                gausfit->SetParLimits(2,gausfit->GetParameter(2)-10,gausfit->GetParameter(2)+10);
-                h->Fit(gausfit,"RMQ");
+                const vector<double> par = fit.parameters;
+                fitlow = par[1]-10;
+                fithigh = par[1]+10;
+                fitter.setParLimits(0,par[0]-50,par[0]+50);
+                fitter.setParLimits(1,par[1]-10,par[1]+10);
+                fitter.setParLimits(2,par[2]-10,par[2]+10);
+                data = FitData(h,range,fitlow,fithigh);
+                fit = fitter.fit(Gauss,data.x,data.y,data.ey,par);
         }
 
-        gausfit->Draw("same");
-
-	//float* statsarr = new float[8];
-        statsarr[0]=gausfit->GetParameter(0); //const
-        statsarr[1]=gausfit->GetParError(0);  //const err
-        statsarr[2]=gausfit->GetParameter(1); //mean
-        statsarr[3]=gausfit->GetParError(1);  //mean err
-        statsarr[4]=gausfit->GetParameter(2); //sigma
-        statsarr[5]=gausfit->GetParError(2);  //sigma err
-	statsarr[6]=gausfit->GetChisquare();
-	statsarr[7]=gausfit->GetNDF(); 
+        statsarr[0]=fit.parameters[0]; //const
+        statsarr[1]=fit.errors[0];     //const err
+        statsarr[2]=fit.parameters[1]; //mean
+        statsarr[3]=fit.errors[1];     //mean err
+        statsarr[4]=fit.parameters[2]; //sigma
+        statsarr[5]=fit.errors[2];     //sigma err
+	statsarr[6]=fit.chi2;
+	statsarr[7]=std::max(fit.ndf,0);
 
-	//std::cout << "   ped value = " << statarr[2] << std::endl;
+	fFits[chan].ped = Summary(fit,fitlow,fithigh);
 
-        //Adding chi^2/ndf and fit parameters to stat box:
-        gStyle->SetOptStat(1111);
-        gStyle->SetOptFit(111);
-        c->Update();
-
-        csq = gausfit->GetChisquare();
-        ndf = gausfit->GetNDF();
+        csq = fit.chi2;
+        ndf = fit.ndf;
         rcsq = csq/ndf;
-        if (rcsq>200.0) std::cout << "warning: possibly bad ped fit mac5 " << fMac5 << ", ch. "
+        if (rcsq>200.0) fLog << "warning: possibly bad ped fit mac5 " << fMac5 << ", ch. "
                         << chan << " X^2/NDF=" << rcsq << " ADC" << std::endl;
-        //save plot to file if desired
-        if ( save )
-        {
-                int ctr = 1;
-                TString suff=".png";
-                TString fname = "./";//calPlotDir+"/";
-                fname+=fMac5;
-		fname+="_";
-		fname+="chan"; //FormatMacString(mac)+ "_ch";
-                if(chan<10) fname+="0";
-                fname+=to_string(chan)+"_pedfit_"+to_string(ctr)+suff;
-
-                while (!gSystem->AccessPathName(fname))
-                {
-                        fname.Remove(fname.Length()-suff.Length(),fname.Length());
-                        fname.Remove(fname.Length()-1,fname.Length());
-                        ctr++;
-                        fname+=to_string(ctr)+suff;
-                }
-
-                //write image to file
-                TImage *img = TImage::Create();
-                img->FromPad(c);
-                img->WriteImage(fname);
-
-                delete img;
-                delete gausfit;
-                delete c;
-        }//end save opt
 
         return;// statarr;
 
 }
 
-void CrtCal::GainFit(TH1F* h, size_t chan, float** statsarr, bool save){
+void CrtCal::GainFit(const HistData_t& h, size_t chan, float** statsarr){
 
 	const float gainSeed = 55.0;
-	const Double_t tSpectrumSigma = 1.75;
-        const Double_t tSpectrumThreshold = 0.18;
+	const double peakSearchSigma = 1.75; //bins
+        const double peakThreshold = 0.18;
 	const size_t nPeakMax = 5;
 	
-	h->Rebin(4);
-	h->GetXaxis()->SetRangeUser(350,700);
-	h->SetStats(kFALSE);
+	ChannelFits_t& plots = fFits[chan];
+	plots.peaks.clear();
 
-	TCanvas* cspec = new TCanvas();
-	h->Draw("e0hist");
+	const std::pair<int,int> range = AxisRange(h,350,700);
 
-        TSpectrum *s = new TSpectrum();
-        //args=source histo, sigma of searched peaks, options, threshold
-        int nPeak = s->Search(h,tSpectrumSigma,"",tSpectrumThreshold);
+        //candidate photopeaks ADC position
+        vector<double> peaks = FindPeaks(h,range,peakSearchSigma,peakThreshold);
+        std::sort(peaks.begin(),peaks.end());
+        int nPeak = peaks.size();
+        plots.peakPos = peaks;
 	//std::cout << "found " << nPeak << " peaks to fit" << std::endl;
 
-        //int ctr = 2;
-
-	//std::cout << "declaring in function arrays" << std::endl;
-        float* peakXsqr     = new float[5];
-        float* peakNdf      = new float[5];
-        float* peakSigma    = new float[5];
-        float* peakSigmaErr = new float[5];
-	float* peakNorm     = new float[5];
-	float* peakNormErr  = new float[5];
-	float* peakMean     = new float[5];
-	float* peakMeanErr  = new float[5];
-        /*float ** statarr    = new float*[15];
-	for(size_t i=0; i<15; i++){
-		statarr[i] = new float[5];*/
-		for(size_t j=0; j<5; j++){
-			//statarr[i][j] = FLT_MAX;
-			peakXsqr[j] = FLT_MAX;
-			peakNdf[j] = FLT_MAX;
-			peakSigma[j] = FLT_MAX;
-			peakSigmaErr[j] = FLT_MAX;
-			peakNorm[j] = FLT_MAX;
-			peakNormErr[j] = FLT_MAX;
-			peakMean[j] = FLT_MAX;
-			peakMeanErr[j] = FLT_MAX;
-		}
-	//}
-
-	//std::cout << "done." << std::endl;
+        float peakXsqr[5], peakNdf[5], peakSigma[5], peakSigmaErr[5];
+        float peakNorm[5], peakNormErr[5], peakMean[5], peakMeanErr[5];
+	for(size_t j=0; j<5; j++){
+		peakXsqr[j] = FLT_MAX;
+		peakNdf[j] = FLT_MAX;
+		peakSigma[j] = FLT_MAX;
+		peakSigmaErr[j] = FLT_MAX;
+		peakNorm[j] = FLT_MAX;
+		peakNormErr[j] = FLT_MAX;
+		peakMean[j] = FLT_MAX;
+		peakMeanErr[j] = FLT_MAX;
+	}
 
         float *peds    = GetPed();
         float *pwidths = GetPedSigma();
-	//std::cout << "retreived ped info" << std::endl;
 
-        Double_t *peaks = s->GetPositionX(); //candidate photopeaks ADC position
-
-	//std::cout << "sorting peaks" << std::endl;
-        //Sort peaks
-        double temp = 0.;
-        int nchanges = 0;
-        do
-        {
-		nchanges=0;
-                for(int p=0;p<nPeak-1;p++)
-                        if(peaks[p]>peaks[p+1])
-                        {
-                                temp=peaks[p];
-                                peaks[p]=peaks[p+1];
-                                peaks[p+1]=temp;
-                                nchanges++;
-                        }
-        } while( nchanges != 0 );
-
-	//std::cout << "done." << std::endl;
-
-        //ascending list of peak number(x) vs. ADC value(y) from TSpectrum
-        float x[10];
-        float y[10];//, ey[10];
+        //ascending list of peak number(x) vs. ADC value(y) from the peak search
+        vector<float> x(nPeak);
+        vector<float> y(nPeak);
 
         //same list with "bad" peaks excluded (what eventually goes into the gain fit)
         float gx[11];
         float gy[11], gey[11];
-        int peak_offset = round((peaks[0]-peds[chan])/gainSeed); //estimate peak number
+        int peak_offset = nPeak ? round((peaks[0]-peds[chan])/gainSeed) : 0; //estimate peak number
 
-       for (int j=0; j<nPeak&&j<10; j++)
+       for (int j=0; j<nPeak; j++)
         {
-		if(peaks[j]<0) std::cout << "bad peak value: " << peaks[j] << std::endl;
+		if(peaks[j]<0) fLog << "bad peak value: " << peaks[j] << std::endl;
                 x[j] = j+peak_offset;
                 y[j] = peaks[j];
         }
@@ -550,38 +696,32 @@ void CrtCal::GainFit(TH1F* h, size_t chan, float** statsarr, bool save){
 
         //first and refit chi-squareds
         double chisqr = 0.;//, chisqr0;
-       // int rnum = 0; //refit number
 
-        //fit peaks about TSpectrum values
+        LeastSquaresFitter peakFitter(3);
+
+        //fit peaks about the candidate values
         for (int g=0 ; g<nPeak&&g<(int)nPeakMax; g++)
         {
-                //initial gaus fit to peak from TSpectrum
-                TF1 *gfit = new TF1("gfit","gaus",y[g]-20,y[g]+20);
-                gfit->SetParameter(0,h->GetBinContent(h->FindBin(y[g])));//200);
-                gfit->SetParameter(1,y[g]);
-                gfit->SetParameter(2,12);
-                gfit->SetParLimits(0,0,20000);
-                gfit->SetParLimits(1,y[g]-15,y[g]+15);
-                gfit->SetParLimits(2,8,40);
-                //std::cout << "fitting gaussian to peak detected at " << y[g] << " ADC..." << std::endl;
-
-                h->Fit(gfit,"MQLR"); //fit peak
-                gfit->Draw("same");
-		//std::cout << "done" << std::endl;
-                //chisqr0 = gfit->GetChisquare()/gfit->GetNDF(); //get reduced chi-square from fit
+                //initial gaus fit to peak from the peak search
+                peakFitter.setParLimits(0,0,20000);
+                peakFitter.setParLimits(1,y[g]-15,y[g]+15);
+                peakFitter.setParLimits(2,8,40);
+                const FitData_t data = FitData(h,range,y[g]-20,y[g]+20);
+                const LeastSquaresFitter::Result_t gfit = peakFitter.fit(Gauss,data.x,data.y,data.ey,
+                	{ h.content[h.FindBin(y[g])], y[g], 12 });
+                plots.peaks.push_back(Summary(gfit,y[g]-20,y[g]+20));
 
                 //check for peaks near the edges of the histogam
-                if( y[g]<h->GetBinLowEdge(1)+15) nplow++;
-                if( y[g]>h->GetBinLowEdge(h->GetNbinsX())-15) nphigh++;
+                if( y[g]<h.BinLowEdge(1)+15) nplow++;
+                if( y[g]>h.BinLowEdge(h.NBins())-15) nphigh++;
 
                 //ignore edge peaks and peaks with fit mean > 15 from peak
-                if( y[g]>h->GetBinLowEdge(1)+15 && y[g]<h->GetBinLowEdge(h->GetNbinsX())-15&&abs(y[g] - gfit->GetParameter(1)) < 15)
+                if( y[g]>h.BinLowEdge(1)+15 && y[g]<h.BinLowEdge(h.NBins())-15&&std::abs(y[g] - gfit.parameters[1]) < 15)
                 {
                         //skip false peaks (may need improvement - currently relies on init values)
                         if(g!=0 && g!=nPeak-1 //check it's not first or last peaks
                          && (y[g+1]-y[g]<gainSeed*0.7 || y[g]-y[g-1]<gainSeed*0.7))
                         { //check peak within 30% of expected gain w.r.t adj.
-                                //std::cout << "determined peak " << g << " (" << y[g] << " ADC) is false peak. removing..." << std::endl;
                                 for (int j=g; j<nPeak; j++) x[j] = x[j]-1;
                         }//overwrite current value, shifting higher values down by 1 index
                         //if not missed peak, could there have been a skipped peak?
@@ -590,124 +730,80 @@ void CrtCal::GainFit(TH1F* h, size_t chan, float** statsarr, bool save){
                                 if(g!=0&&g!=nPeak-1&&y[g+1]-y[g]<gainSeed*1.2&&y[g]-y[g-1]>gainSeed*1.5) //missed peak adjust
                                 {
                                         for (int j=g; j<nPeak; j++) x[j] = x[j]+1;
-                                        //std::cout << "missed peak detected. shifting peaks " << g << " and higher up by 1..." << std::endl;
                                 }
                                 //if last peak likely occuring after skipped peak
-                                if(g==nPeak-1 && (y[g]-y[g-1])/gainSeed >1.5) {
+                                if(g!=0 && g==nPeak-1 && (y[g]-y[g-1])/gainSeed >1.5) {
                                         x[g]+=(int)((y[g]-y[g-1])/gainSeed);
-                                        //std::cout << "missed peak(s) detected before last peak...shifting last peak" << std::endl;
                                 }
 
-                                peakXsqr[gg] = gfit->GetChisquare();
-                                peakNdf[gg] = gfit->GetNDF();
-				peakMean[gg] = gfit->GetParameter(1);
-				peakMeanErr[gg] = gfit->GetParError(1);
-				peakNorm[gg] = gfit->GetParameter(0);
-				peakNormErr[gg] = gfit->GetParError(0);
-                                peakSigma[gg] =  gfit->GetParameter(2);
-                                peakSigmaErr[gg] = gfit->GetParError(2);
+                                //the peak statistics have room for the first 4 peaks only
+                                if(gg<5){
+                                        peakXsqr[gg] = gfit.chi2;
+                                        peakNdf[gg] = std::max(gfit.ndf,0);
+                                        peakMean[gg] = gfit.parameters[1];
+                                        peakMeanErr[gg] = gfit.errors[1];
+                                        peakNorm[gg] = gfit.parameters[0];
+                                        peakNormErr[gg] = gfit.errors[0];
+                                        peakSigma[gg] =  gfit.parameters[2];
+                                        peakSigmaErr[gg] = gfit.errors[2];
+                                }
 
                                 gx[gg] = x[g];
-                                gy[gg] = gfit->GetParameter(1);
-                                gey[gg] = sqrt(gx[gg]+gey[0]*gey[0]);//gfit->GetParError(1);
+                                gy[gg] = gfit.parameters[1];
+                                gey[gg] = sqrt(gx[gg]+gey[0]*gey[0]);
                                 gg++;
                         }//end else not missed but was there skip
-                }//end if not edge peak, not far from TSpectrum value
+                }//end if not edge peak, not far from the candidate value
         }//end for peaks
 
-	//std::cout << "done looping over peaks" << std::endl;
-
         if (nplow>0) for (int i=1; i<gg; i++) gx[i] = gx[i]-(nplow-1);
 
-        //graph of adc(y) vs. photo-peak number (x)
-        TGraphErrors* gr_mean = new TGraphErrors(gg,gx,gy,0,gey);
+        //linear fit of adc(y) vs. photo-peak number (x): [0] "Pedestal" + [1] "Gain" * x
+        LeastSquaresFitter gainFitter(2);
+        gainFitter.setParLimits(1,gainSeed-20,gainSeed+20);
+        gainFitter.setParLimits(0,peds[chan]*0.8,peds[chan]*1.2);
 
-        //linear fit function
-        TF1 *fit = new TF1("fit","[0] + [1]*x",gx[0]-0.25,gx[gg-1]+0.25);
+        vector<double> fx(gx,gx+gg), fy(gy,gy+gg), fey(gey,gey+gg);
+        auto const fitGain = [&](vector<double> start){
+        	std::copy(gx,gx+gg,fx.begin());
+        	return gainFitter.fit(Line,fx,fy,fey,std::move(start));
+        };
 
-        //name, initialize gain fit parameters
-        fit->SetParName(1,"Gain");
-        fit->SetParName(0, "Pedestal");
-        fit->SetParameter(1,gainSeed);
-        fit->SetParameter(0,peds[chan]);
-        fit->SetParLimits(1,gainSeed-20,gainSeed+20);
-        fit->SetParLimits(0,peds[chan]*0.8,peds[chan]*1.2);
-
-	//std::cout << "gain fit..." << std::endl;
         //perform gain fit
-        gr_mean->Fit(fit, "QR");
+        LeastSquaresFitter::Result_t fit = fitGain({ peds[chan], gainSeed });
 
-	//std::cout << "check chi-square..." << std::endl;
         //check if gain fit is bad according to chi-square
-        if (fit->GetChisquare()/fit->GetNDF()>5.0)
+        if (fit.chi2/fit.ndf>5.0)
         {
                 //std::cout << "gain fit X^2 too large...shifting all peaks by 1" << std::endl;
-                chisqr=fit->GetChisquare();
+                chisqr=fit.chi2;
                 for(int i=1; i<gg; i++) gx[i]+=1;
-                gr_mean = new TGraphErrors(gg,gx,gy,0,gey);
-                fit->SetRange(gx[0]-0.25,gx[gg-1]+0.25);
-                gr_mean->Fit(fit, "QR");
-                if (fit->GetChisquare()<chisqr) chisqr=fit->GetChisquare();
+                fit = fitGain(fit.parameters);
+                if (fit.chi2<chisqr) chisqr=fit.chi2;
                 else
                 {
                         for(int i=1; i<gg; i++) gx[i]-=2;
-                        gr_mean = new TGraphErrors(gg,gx,gy,0,gey);
-                        fit->SetRange(gx[0]-0.25,gx[gg-1]+0.25);
-                        gr_mean->Fit(fit, "QR");
-                        if (fit->GetChisquare()<chisqr) chisqr=fit->GetChisquare();
+                        fit = fitGain(fit.parameters);
+                        if (fit.chi2<chisqr) chisqr=fit.chi2;
                         else
                         {
                                 for(int i=1; i<gg; i++) gx[i]+=1;
-                                gr_mean = new TGraphErrors(gg,gx,gy,0,gey);
-                                fit->SetRange(gx[0]-0.25,gx[gg-1]+0.25);
-                                gr_mean->Fit(fit, "QR");
+                                fit = fitGain(fit.parameters);
                         }
                 }
         }
 
-        string grtitle = "Mac5 "+std::to_string(fMac5)+", Ch. "+std::to_string(chan)+" Gain Fit";
-
-	//std::cout << "style and range opts" << std::endl;
-
-        gr_mean->SetTitle(grtitle.c_str());
-        gr_mean->GetXaxis()->SetTitle("Peak #");
-        gr_mean->GetYaxis()->SetTitle("ADC value");
-        gr_mean->SetMarkerColor(4);
-        gr_mean->SetMarkerStyle(20);
-        gr_mean->SetFillColor(0);
-	//std::cout << "set range..." << std::endl;
-        gr_mean->GetXaxis()->SetRangeUser(gx[0]-0.5,gx[gg-1]+0.5);
-
-	//std::cout << "done" << std::endl;
-        //if (fit->GetChisquare()/fit->GetNDF()>30.0) cout << "Poor X^2! mac5 " << mac << "ch. " << chan << endl;
-
-        gStyle->SetOptStat(0100);
-        gStyle->SetOptFit(1111);
-
-	//std::cout << "drawing..." << std::endl;
-
-        TCanvas *c2 = new TCanvas();
-        c2->cd();
-        c2->SetGrid();
-
-        gStyle->SetStatX(0.5);
-        gStyle->SetStatY(0.9);
-        gStyle->SetStatH(0.15);
-        gStyle->SetStatW(0.2);
-
-	//std::cout << "draw gr_mean..." << std::endl;
-        gr_mean->Draw("ALP");
-	//std::cout << "draw fit" << std::endl;
-        fit->Draw("L,SAME");
-
-	//std::cout << "filling statarr" << std::endl;
-
-        statsarr[0][0] = fit->GetParameter(1); //gain
-        statsarr[1][0] = fit->GetParError(1);  //gain error
-        statsarr[2][0] = fit->GetParameter(0); //pedestal mean
-        statsarr[3][0] = fit->GetParError(0);  //pedestal mean error
-        statsarr[4][0] = fit->GetChisquare();  //X^2
-        statsarr[5][0] = fit->GetNDF();        //NDF
+        plots.gain = Summary(fit,gx[0]-0.25,gx[gg-1]+0.25);
+        plots.gainX = fx;
+        plots.gainY = fy;
+        plots.gainEY = fey;
+
+        statsarr[0][0] = fit.parameters[1]; //gain
+        statsarr[1][0] = fit.errors[1];     //gain error
+        statsarr[2][0] = fit.parameters[0]; //pedestal mean
+        statsarr[3][0] = fit.errors[0];     //pedestal mean error
+        statsarr[4][0] = fit.chi2;          //X^2
+        statsarr[5][0] = std::max(fit.ndf,0); //NDF
         statsarr[6][0] = nPeak;
 	for(size_t i=0; i<5; i++) {
 	        statsarr[7][i]    = peakXsqr[i];
@@ -719,73 +815,139 @@ void CrtCal::GainFit(TH1F* h, size_t chan, float** statsarr, bool save){
 	        statsarr[13][i]   = peakSigmaErr[i];
 		statsarr[14][i]   = peakNdf[i];
 	}
-	
-	delete[] peakXsqr;
-	delete[] peakMean;
-	delete[] peakMeanErr;
-	delete[] peakNorm;
-	delete[] peakNormErr;
-	delete[] peakSigma;
-	delete[] peakSigmaErr;
-	delete[] peakNdf;
-
-        if ( save )
-        {
-		//std::cout << "saving plots..."<< std::endl;
-                int ctr=1, ctr2=1;
-                TString suff = ".png";
-                TString fname="./";
+
+        return;// statarr;
+
+}
+
+void CrtCal::SavePlots(){
+
+	for(size_t i=0; i<fHistos->size(); i++){
+		const size_t chan = fChanMap[i];
+		const ChannelFits_t& fits = fFits[chan];
+		if(fits.ped.par.empty()) continue;
+
+		TH1F* h = (TH1F*)fHistos->at(i)->Clone();
+		h->SetDirectory(nullptr);
+		h->GetXaxis()->SetRangeUser(1,300);
+		h->GetListOfFunctions()->Add(MakeFunction("gausfit","[0]*exp(-0.5*((x-[1])/[2])^2)",fits.ped));
+
+		TCanvas *c = new TCanvas();
+		c->SetGrid();
+
+		gStyle->Reset("Modern");
+		if(h->GetMean()>(300-1)/2)
+			gStyle->SetStatX(0.4);
+		else
+			gStyle->SetStatX(0.9);
+
+		gStyle->SetStatY(0.89);
+		gStyle->SetStatH(0.45);
+		gStyle->SetStatW(0.28);
+		gStyle->SetOptStat(1111);
+		gStyle->SetOptFit(111);
+		h->Draw("e0samehist");
+		c->Update();
+
+		TString fname = "./";
+		fname+=fMac5;
+		fname+="_";
+		fname+="chan";
+		if(chan<10) fname+="0";
+		fname+=to_string(chan)+"_pedfit";
+
+		TImage *img = TImage::Create();
+		img->FromPad(c);
+		img->WriteImage(PlotFileName(fname));
+
+		delete img;
+		delete c;
+		delete h;
+	}
+
+	for(size_t i=0; i<fHistos->size(); i++){
+		const size_t chan = fChanMap[i];
+		const ChannelFits_t& fits = fFits[chan];
+		if(!fActive[chan] || fits.gain.par.empty()) continue;
+
+		TH1F* h = (TH1F*)fHistos->at(i)->Clone();
+		h->SetDirectory(nullptr);
+		h->Rebin(4);
+		h->GetXaxis()->SetRangeUser(350,700);
+		h->SetStats(kFALSE);
+		vector<double> peakY;
+		for(double pos : fits.peakPos) peakY.push_back(h->GetBinContent(h->FindBin(pos)));
+		TPolyMarker* pm = new TPolyMarker(fits.peakPos.size(),fits.peakPos.data(),peakY.data());
+		pm->SetMarkerStyle(23);
+		pm->SetMarkerColor(kRed);
+		pm->SetMarkerSize(1.3);
+		h->GetListOfFunctions()->Add(pm);
+		for(const FitSummary_t& peak : fits.peaks)
+			h->GetListOfFunctions()->Add(MakeFunction("gfit","gaus",peak));
+
+		TCanvas* cspec = new TCanvas();
+		h->Draw("e0hist");
+
+		//graph of adc(y) vs. photo-peak number (x)
+		const int gg = fits.gainX.size();
+		TGraphErrors* gr_mean = new TGraphErrors(gg,fits.gainX.data(),fits.gainY.data(),
+		                                         nullptr,fits.gainEY.data());
+		TF1* fit = MakeFunction("fit","[0] + [1]*x",fits.gain);
+		fit->SetParName(1,"Gain");
+		fit->SetParName(0, "Pedestal");
+		gr_mean->GetListOfFunctions()->Add(fit);
+
+		string grtitle = "Mac5 "+std::to_string(fMac5)+", Ch. "+std::to_string(chan)+" Gain Fit";
+
+		gr_mean->SetTitle(grtitle.c_str());
+		gr_mean->GetXaxis()->SetTitle("Peak #");
+		gr_mean->GetYaxis()->SetTitle("ADC value");
+		gr_mean->SetMarkerColor(4);
+		gr_mean->SetMarkerStyle(20);
+		gr_mean->SetFillColor(0);
+		gr_mean->GetXaxis()->SetRangeUser(fits.gainX.front()-0.5,fits.gainX.back()+0.5);
+
+		gStyle->SetOptStat(0100);
+		gStyle->SetOptFit(1111);
+
+		TCanvas *c2 = new TCanvas();
+		c2->cd();
+		c2->SetGrid();
+
+		gStyle->SetStatX(0.5);
+		gStyle->SetStatY(0.9);
+		gStyle->SetStatH(0.15);
+		gStyle->SetStatW(0.2);
+
+		gr_mean->Draw("ALP");
+
+		TString fname="./";
 		TString fname2 = fname;
-                fname+=fMac5;
+		fname+=fMac5;
 		fname2+=fMac5;
 		fname+="_ch";
 		fname2+="_ch";
-                if(chan<10) fname+="0";
+		if(chan<10) fname+="0";
 		if(chan<10) fname2+="0";
 		fname2+=chan;
 		fname2+="_peak_fit_spec";
-                fname+=to_string(chan)+"_fit-gain";
-                fname+="_1"+suff;
-		fname2+="_1"+suff;
-                while (!gSystem->AccessPathName(fname))
-                {
-                        fname.Remove(fname.Length()-suff.Length(),fname.Length());
-                        fname.Remove(fname.Length()-1,fname.Length());
-                        ctr++;
-                        fname+=to_string(ctr)+suff;
-                }
+		fname+=to_string(chan)+"_fit-gain";
 
-                while (!gSystem->AccessPathName(fname2))
-                {
-                        fname2.Remove(fname2.Length()-suff.Length(),fname2.Length());
-                        fname2.Remove(fname2.Length()-1,fname2.Length());
-                        ctr2++;
-                        fname2+=to_string(ctr2)+suff;
-                }
+		//write image to file
+		TImage *img = TImage::Create();
+		img->FromPad(c2);
+		img->WriteImage(PlotFileName(fname));
 
-                //write image to file
-                TImage *img = TImage::Create();
-                img->FromPad(c2);
-                img->WriteImage(fname);
+		img->FromPad(cspec);
+		img->WriteImage(PlotFileName(fname2));
 
-                //TImage *img2 = TImage::Create();
-                img->FromPad(cspec);
-                img->WriteImage(fname2);
-
-                //deallocate memory
-                delete img;
-                delete c2;
+		//deallocate memory
+		delete img;
+		delete c2;
 		delete cspec;
-		//delete img2;
-                delete gr_mean;
-                delete fit;
-                delete s;
-        }
-
-	//std::cout << "done" << std::endl;
-
-        return;// statarr;
-
+		delete gr_mean;
+		delete h;
+	}
 }
 
 //methods for parsing stats arrays
@@ -832,132 +994,34 @@ void CrtCal::ParseGainStats(float** statarr, float& gainXsqr, short& gainNdf, fl
 	return;
 }
 
-Double_t langaufun(Double_t *x, Double_t *par) {
- 
-    //Fit parameters:
-    //par[0]=Width (scale) parameter of Landau density
-    //par[1]=Most Probable (MP, location) parameter of Landau density
-    //par[2]=Total area (integral -inf to inf, normalization constant)
-    //par[3]=Width (sigma) of convoluted Gaussian function
-    //
-    //In the Landau distribution (represented by the CERNLIB approximation),
-    //the maximum is located at x=-0.22278298 with the location parameter=0.
-    //This shift is corrected within this function, so that the actual
-    //maximum is identical to the MP parameter.
- 
-       // Numeric constants
-       Double_t invsq2pi = 0.3989422804014;   // (2 pi)^(-1/2)
-       Double_t mpshift  = -0.22278298;       // Landau maximum location
- 
-       // Control constants
-       Double_t np = 100.0;      // number of convolution steps
-       Double_t sc =   5.0;      // convolution extends to +-sc Gaussian sigmas
- 
-       // Variables
-       Double_t xx;
-       Double_t mpc;
-       Double_t fland;
-       Double_t sum = 0.0;
-       Double_t xlow,xupp;
-       Double_t step;
-       Double_t i;
- 
- 
-       // MP shift correction
-       mpc = par[1] - mpshift * par[0];
- 
-       // Range of convolution integral
-       xlow = x[0] - sc * par[3];
-       xupp = x[0] + sc * par[3];
- 
-       step = (xupp-xlow) / np;
- 
-       // Convolution integral of Landau and Gaussian by sum
-       for(i=1.0; i<=np/2; i++) {
-          xx = xlow + (i-.5) * step;
-          fland = TMath::Landau(xx,mpc,par[0]) / par[0];
-          sum += fland * TMath::Gaus(x[0],xx,par[3]);
- 
-          xx = xupp - (i-.5) * step;
-          fland = TMath::Landau(xx,mpc,par[0]) / par[0];
-          sum += fland * TMath::Gaus(x[0],xx,par[3]);
-       }
- 
-       return (par[2] * step * sum * invsq2pi / par[3]);
- }
- 
- 
- 
- TF1* CrtCal::langaufit(TH1F *his, Double_t *fitrange, Double_t *startvalues, Double_t *parlimitslo, Double_t *parlimitshi, Double_t *fitparams, Double_t *fiterrors, Double_t *ChiSqr, Int_t *NDF)
- {
-    // Once again, here are the Landau * Gaussian parameters:
-    //   par[0]=Width (scale) parameter of Landau density
-    //   par[1]=Most Probable (MP, location) parameter of Landau density
-    //   par[2]=Total area (integral -inf to inf, normalization constant)
-    //   par[3]=Width (sigma) of convoluted Gaussian function
-    //
-    // Variables for langaufit call:
-    //   his             histogram to fit
-    //   fitrange[2]     lo and hi boundaries of fit range
-    //   startvalues[4]  reasonable start values for the fit
-    //   parlimitslo[4]  lower parameter limits
-    //   parlimitshi[4]  upper parameter limits
-    //   fitparams[4]    returns the final fit parameters
-    //   fiterrors[4]    returns the final fit errors
-    //   ChiSqr          returns the chi square
-    //   NDF             returns ndf
- 
-    Int_t i;
-    Char_t FunName[100];
- 
-    sprintf(FunName,"Fitfcn_%s",his->GetName());
- 
-//    TF1 *ffitold = (TF1*)ROOT->GetListOfFunctions()->FindObject(FunName);
-//    if (ffitold) delete ffitold;
- 
-    TF1 *ffit = new TF1(FunName,langaufun,fitrange[0],fitrange[1],4);
-    ffit->SetParameters(startvalues);
-    ffit->SetParNames("Width","MP","Area","GSigma");
- 
-    for (i=0; i<4; i++) {
-       ffit->SetParLimits(i, parlimitslo[i], parlimitshi[i]);
-    }
- 
-    his->Fit(FunName,"RB0");   // fit within specified range, use ParLimits, do not plot
- 
-    ffit->GetParameters(fitparams);    // obtain fit parameters
-    for (i=0; i<4; i++) {
-       fiterrors[i] = ffit->GetParError(i);     // obtain fit parameter errors
-    }
-    ChiSqr[0] = ffit->GetChisquare();  // obtain chi^2
-    NDF[0] = ffit->GetNDF();           // obtain ndf
- 
-    return (ffit);              // return fit function
- 
- }
-
-void CrtCal::langaus_fit(TH1F* h, double& lang_lan_wid, double& lang_lan_wid_err, double& lang_lan_mp, double& lang_lan_mp_err, double& lang_area, double& lang_area_err, double& lang_gauss_sigma, double& lang_gauss_sigma_err, double& lang_chisq, double& lang_ndf){
-
-	//set up bounds, initial guesses for fit
-	Double_t my_fitrange[2] = { 800,4000 };
-	Double_t my_startvalues[4] = { 3, 200, 10000, 150 };
-	Double_t my_parlimitslo[4] = { 0, 100, 1000, 100 };
-	Double_t my_parlimitshi[4] = { 1000, 10000, 10000000, 1000 };
-
-	//set up receptacles for relevant fit information
-	Double_t my_fitparams[4], my_fiterrors[4], my_ChiSqr; 
-	Int_t my_NDF;
+void CrtCal::langaus_fit(const HistData_t& h, size_t chan){
 
-	TF1 *my_langaus = langaufit(h, my_fitrange, my_startvalues, my_parlimitslo, my_parlimitshi, my_fitparams, my_fiterrors, &my_ChiSqr, &my_NDF);
+	// Landau * Gaussian parameters:
+	//   par[0]=Width (scale) parameter of Landau density
+	//   par[1]=Most Probable (MP, location) parameter of Landau density
+	//   par[2]=Total area (integral -inf to inf, normalization constant)
+	//   par[3]=Width (sigma) of convoluted Gaussian function
 
-	lang_lan_wid = my_fitparams[0]; lang_lan_wid_err = my_fiterrors[0];
-	lang_lan_mp = my_fitparams[1]; lang_lan_mp_err = my_fiterrors[1];
-	lang_area = my_fitparams[2]; lang_area_err = my_fiterrors[2];
-	lang_gauss_sigma = my_fitparams[3]; lang_gauss_sigma_err = my_fiterrors[3];
-	lang_chisq = my_ChiSqr; lang_ndf = my_NDF;
+	//set up bounds, initial guesses for fit
+	const double my_fitrange[2] = { 800,4000 };
+	const double my_parlimitslo[4] = { 0, 100, 1000, 100 };
+	const double my_parlimitshi[4] = { 1000, 10000, 10000000, 1000 };
+
+	LeastSquaresFitter fitter(4);
+	fitter.setTolerance(1e-6);
+	for (size_t i=0; i<4; i++) {
+		fitter.setParLimits(i, my_parlimitslo[i], my_parlimitshi[i]);
+	}
 
+	const FitData_t data = FitData(h,{ 1, h.NBins() },my_fitrange[0],my_fitrange[1]);
+	const LeastSquaresFitter::Result_t fit = fitter.fit(Langaus,data.x,data.y,data.ey,
+	                                                    { 3, 200, 10000, 150 });
 
-	delete my_langaus;
+	fLangausWidth[chan] = fit.parameters[0]; fLangausWidthErr[chan] = fit.errors[0];
+	fLangausLandauMP[chan] = fit.parameters[1]; fLangausLandauMPErr[chan] = fit.errors[1];
+	fLangausArea[chan] = fit.parameters[2]; fLangausAreaErr[chan] = fit.errors[2];
+	fLangausGaussSigma[chan] = fit.parameters[3]; fLangausGaussSigmaErr[chan] = fit.errors[3];
+	fLangausXsqr[chan] = fit.chi2; fLangausNdf[chan] = std::max(fit.ndf,0);
 }
 
 
@@ -1080,6 +1144,9 @@ int*  CrtCal::GetNabove() const{
 
         return fNabove;
 }
+const vector<double>& CrtCal::GetPeakPos(size_t chan) const{
+        return fFits[chan].peakPos;
+}
 long*  CrtCal::GetChanStats() const{
         if(!fHasGainCal)
                 return nullptr;
@@ -6,6 +6,9 @@
 #include <map>
 #include <string>
 #include <climits>
+#include <array>
+#include <iostream>
+#include <sstream>
 
 //ROOT includes
 #include<TH1F.h>
@@ -33,16 +36,52 @@ using std::map;
 class icarus::crt::CrtCal {
 
   public:
+
+	/// Content of a histogram held in plain arrays, detached from ROOT.
+	/// Bins are numbered like in ROOT: 0 is the underflow, `NBins()+1` the overflow.
+	struct HistData_t {
+		string         name;
+		double         low = 0.0;    ///< lower edge of the first bin
+		double         width = 1.0;  ///< width of each bin
+		double         entries = 0.0;
+		vector<double> content;      ///< underflow, `NBins()` bins, overflow
+
+		int    NBins() const { return (int)content.size() - 2; }
+		double BinLowEdge(int bin) const { return low + (bin-1)*width; }
+		double BinCenter(int bin) const { return low + (bin-0.5)*width; }
+		int    FindBin(double x) const;
+		double Integral(int first, int last) const;
+		HistData_t Rebinned(int ngroup) const;
+	};
+
+	/// Outcome of one fit, of the calibration.
+	struct FitSummary_t {
+		double low = 0.0, high = 0.0; ///< fit range
+		vector<double> par, err;
+		double chi2 = 0.0;
+		int    ndf = 0;
+	};
+
 	//CrtCal(string runName);
-	CrtCal(const vector<TH1F*>* histos);
+	/// Copies the content of the histograms; plots of the fits are saved
+	/// by `Cal()` only if `savePlots` is set.
+	CrtCal(const vector<TH1F*>* histos, bool savePlots = true);
         ~CrtCal();
 
+	/// Runs the full calibration. Unless plots are requested, this does not
+	/// use ROOT global state and calibrations of different FEBs may run
+	/// concurrently. Its messages are collected and printed by `PrintLog()`,
+	/// which `Cal()` calls itself when plots are requested (serial use).
 	void    Cal();
+	/// Prints the messages collected by the calibration, and forgets them.
+	void    PrintLog(std::ostream& out = std::cout);
 	void    PedCal();
 	void    GainCal();
-        void    GainFit(TH1F* h, size_t chan, float** statsarr, bool save);
-        void    PedFit(TH1F* h, size_t chan, float* statsarr, bool save);
-        bool    IsActive(TH1F*);
+	/// Saves the plots of the fits (ROOT graphics: call serially).
+	void    SavePlots();
+        void    GainFit(const HistData_t& h, size_t chan, float** statsarr);
+        void    PedFit(const HistData_t& h, size_t chan, float* statsarr);
+        bool    IsActive(const HistData_t& h);
 
         void    ParsePedStats(const float* statarr, float& pedXsqr, float& ped, float& pedErr,
                            float& pedNorm, float& pedNormErr, float& pedSigma, float& pedSigmaErr,
@@ -53,9 +92,8 @@ class icarus::crt::CrtCal {
                             float* peakMean, float* peakMeanErr, float* peakNorm, float* peakNormErr,
                             float* peakSigma, float* peakSigmaErr,short* peakNdf);
 
-	int  FindThreshADC(TH1F* h);
-	float   FindThreshPE(TH1F* h);
-	int  FindNabove(TH1F *h, int thresh);
+	int  FindThreshADC(const HistData_t& h);
+	int  FindNabove(const HistData_t& h, int thresh);
 
 	bool*   GetActive() const;
 	float*  GetPed() const;
@@ -85,6 +123,8 @@ class icarus::crt::CrtCal {
         float** GetPeakXsqr() const;
 	short** GetPeakNdf() const;
 	long*   GetChanStats() const;
+	/// Photopeak candidates of `chan` from the peak search [ADC].
+	const vector<double>& GetPeakPos(size_t chan) const;
 
 	double* GetLangausWidth() const;
 	double* GetLangausWidthErr() const;
@@ -102,6 +142,9 @@ class icarus::crt::CrtCal {
         void IndexToMacChan();
 
         const vector<TH1F*>* fHistos;
+        vector<HistData_t> fHistData; ///< content of `fHistos`
+        bool fSavePlots;
+        std::ostringstream fLog; ///< messages from the calibration
         //string fRunName;
         //string fOutDir;
         map<uint8_t,uint8_t> fChanMap;
@@ -153,10 +196,17 @@ class icarus::crt::CrtCal {
 	double* fLangausNdf;
 
 
-	TF1 *langaufit(TH1F *his, Double_t *fitrange, Double_t *startvalues, Double_t *parlimitslo, Double_t *parlimitshi, Double_t *fitparams, Double_t *fiterrors, Double_t *ChiSqr, Int_t *NDF);
-	void langaus_fit(TH1F* h, double& lang_lan_wid, double& lang_lan_wid_err, double& lang_lan_mp, double& lang_lan_mp_err, double& lang_area, double& lang_area_err, double& lang_gauss_sigma, double& lang_gauss_sigma_err, double& lang_chisq, double& lang_ndf);
-
+	void langaus_fit(const HistData_t& h, size_t chan);
 
+	/// Fit details of a channel, kept for plotting.
+	struct ChannelFits_t {
+		FitSummary_t ped;
+		vector<double> peakPos;       ///< photopeak candidates [ADC]
+		vector<FitSummary_t> peaks;   ///< fits of the photopeaks
+		FitSummary_t gain;
+		vector<double> gainX, gainY, gainEY; ///< peak number, ADC, error
+	};
+	ChannelFits_t fFits[32];
 
 };
 
@@ -31,6 +31,9 @@
 #include "TH1F.h"
 #include "TNtuple.h"
 
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
 //c++ includes
 #include <algorithm>
 #include <cassert>
@@ -40,7 +43,9 @@
 #include <vector>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <string>
+#include <utility>
 
 namespace icarus {
  namespace crt {
@@ -69,6 +74,12 @@ public:
         Name("mac5"),
         Comment("mac addresses for each FEB in the diasychain")
         };
+
+      fhicl::Atom<bool> SaveFitPlots {
+        Name("saveFitPlots"),
+        Comment("save images of the calibration fits in the working directory"),
+        true
+        };
   };
 
   using Parameters = art::EDAnalyzer::Table<Config>;
@@ -85,6 +96,7 @@ private:
   art::ServiceHandle<art::TFileService> tfs;
 
   vector<uint8_t> macs; 
+  bool fSaveFitPlots;
   map<uint8_t,vector<TH1F*>*> macToHistos;
   TTree* calTree;
 
@@ -122,7 +134,7 @@ private:
 
 //Define the constructor
 icarus::crt::CrtCalAnalyzer::CrtCalAnalyzer(Parameters const& config)
-  : EDAnalyzer(config) , macs(config().Mac())
+  : EDAnalyzer(config) , macs(config().Mac()), fSaveFitPlots(config().SaveFitPlots())
 {
   fMac5 = 0;
   for(int i=0; i<(int)macs.size(); i++){
@@ -249,17 +261,27 @@ void icarus::crt::CrtCalAnalyzer::endJob(){
 		std::cout << "hist vect is empty!" << std::endl;
 	}
 
+	//the calibrations of the FEBs are independent and run concurrently;
+	//plots (ROOT graphics) and the tree are filled afterwards, one FEB at a time
+	vector<std::pair<uint8_t,std::unique_ptr<CrtCal>>> cals;
 	for(auto const& macHist	: macToHistos){
+		std::cout << "construct instance of CrtCal for mac5 " << (short)macHist.first << std::endl;
+		cals.emplace_back(macHist.first, std::make_unique<CrtCal>(macHist.second, false));
+	}
+
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, cals.size(), 1),
+		[&cals](tbb::blocked_range<size_t> const& range){
+			for(size_t i=range.begin(); i<range.end(); i++) cals[i].second->Cal();
+		});
 
-		uint8_t mac = macHist.first;
-		vector<TH1F*>* hvec = macHist.second;
+	for(auto const& [ mac, cal ] : cals){
 
-		std::cout << "construct instance of CrtCal for mac5 " << (short)mac << std::endl;
-		CrtCal* cal = new CrtCal(hvec);
-		cal->Cal();
+		std::cout << "calibration of mac5 " << (short)mac << ":" << std::endl;
+		cal->PrintLog();
+		if(fSaveFitPlots) cal->SavePlots();
 
 		std::cout << "retreiving cal data..." << std::endl;
-		fMac5         = macHist.first;
+		fMac5         = mac;
 		bool*    ptrActive       = cal->GetActive();
 		float*   ptrGain         = cal->GetGain();
 		float*   ptrGainErr      = cal->GetGainErr();
@@ -324,8 +346,6 @@ void icarus::crt::CrtCalAnalyzer::endJob(){
 
 		std::cout << "fill tree event" << std::endl;
 		calTree->Fill();
-
-		delete cal;
 	}
 
 	//calTree->Write();
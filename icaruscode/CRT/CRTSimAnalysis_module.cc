@@ -980,7 +980,7 @@ namespace crt {
                     //size_t adsid = channel.AuxDetSensitiveID();
                     fADType.push_back(fCrtutils->GetAuxDetTypeCode(adid));
                     fAuxDetReg.push_back(
-                       fCrtutils->AuxDetRegionNameToNum(fCrtutils->GetAuxDetRegion(adid)));
+                       fCrtutils->GetAuxDetRegionNum(adid));
 
                     // What is the distance from the hit (centroid of the entry
                     // and exit points) to the readout end?
@@ -12,40 +12,42 @@ CRTCommonUtils::CRTCommonUtils() {
   fGeoService  = lar::providerFrom<geo::Geometry>();
   FillFebMap();
   FillAuxDetMaps();
+  FillAuxDetTable();
 }
 
-//given an AuxDetGeo object, returns name of the CRT subsystem to which it belongs
-char CRTCommonUtils::GetAuxDetType(size_t adid) {
-    if(fAuxDetIdToType.find(adid)==fAuxDetIdToType.end()) {
-        throw cet::exception("CRTCommonUtils::GetAuxDetType")
+//------------------------------------------------------------------------------------
+CRTCommonUtils::AuxDetInfo_t const& CRTCommonUtils::AuxDetInfo(size_t adid, const char* caller) const {
+    if(adid >= fAuxDetInfo.size() || fAuxDetInfo[adid].type == 0) {
+        throw cet::exception(caller)
           << "unknown AuxDetID passed to function";
     }
-    return fAuxDetIdToType[adid];
+    return fAuxDetInfo[adid];
+}
+
+//given an AuxDetGeo object, returns name of the CRT subsystem to which it belongs
+char CRTCommonUtils::GetAuxDetType(size_t adid) const {
+    return AuxDetInfo(adid, "CRTCommonUtils::GetAuxDetType").type;
 }
 
 //------------------------------------------------------------------------------------
-int CRTCommonUtils::GetAuxDetTypeCode(size_t adid) {
-    char type = GetAuxDetType(adid);
-    switch(type){
-        case 'c': return 0;
-        case 'm': return 1;
-        case 'd': return 2;
-        default:  return -1;
-    }
+int CRTCommonUtils::GetAuxDetTypeCode(size_t adid) const {
+    return AuxDetInfo(adid, "CRTCommonUtils::GetAuxDetType").typeCode;
 }
 
 //------------------------------------------------------------------------------------
 //given an AuxDetGeo object, returns name of the CRT region to which it belongs
-string CRTCommonUtils::GetAuxDetRegion(size_t adid) {
-    if(fAuxDetIdToRegion.find(adid)==fAuxDetIdToRegion.end()) {
-        throw cet::exception("CRTCommonUtils::GetAuxDetRegion")
-          << "unknown AuxDetID passed to function";
-    }
-    return fAuxDetIdToRegion[adid];  
+string const& CRTCommonUtils::GetAuxDetRegion(size_t adid) const {
+    return AuxDetInfo(adid, "CRTCommonUtils::GetAuxDetRegion").regionName;
+}
+
+//------------------------------------------------------------------------------------
+//given an AuxDetGeo object, returns the code of the CRT region to which it belongs
+int CRTCommonUtils::GetAuxDetRegionNum(size_t adid) const {
+    return AuxDetInfo(adid, "CRTCommonUtils::GetAuxDetRegion").region;
 }
 
 //------------------------------------------------------------------------------
-int CRTCommonUtils::AuxDetRegionNameToNum(string reg)
+int CRTCommonUtils::AuxDetRegionNameToNum(string const& reg) const
 {
     if(reg == "Top")        return 30;
     if(reg == "RimWest")    return 31;
@@ -139,35 +141,18 @@ int CRTCommonUtils::GetTypeCodeFromRegion(string name) {
 //  numbering convention is module from FEB i 
 //  return pair<FEB i,FEB i> (C-, D-, Cut M- module)
 //  return pair<FEB i,FEB j> (Full-length M-modules)
-pair<uint8_t,uint8_t> CRTCommonUtils::ADToMac(size_t adid) {
-
-    if(fAuxDetIdToFeb.find(adid)==fAuxDetIdToFeb.end()) {
-        throw cet::exception("CRTCommonUtils::ADToMac")
-          << "unknown AuxDetID passed to function";
-    }
-    vector<pair<uint8_t,int>> febs = fAuxDetIdToFeb[adid];
-    if(febs.size()==2)
-        return std::make_pair(febs[0].first,febs[1].first);
-    else
-        return std::make_pair(febs[0].first,febs[0].first);
+pair<uint8_t,uint8_t> CRTCommonUtils::ADToMac(size_t adid) const {
+    return AuxDetInfo(adid, "CRTCommonUtils::ADToMac").macs;
 }
 
 //---------------------------------------------------------------------------------
-int CRTCommonUtils::ADToChanGroup(size_t adid){
-    if(fAuxDetIdToChanGroup.find(adid)==fAuxDetIdToChanGroup.end()){
-        throw cet::exception("CRTCommonUtils::ADMacToChanGroup")
-          << "unknown AuxDetID passed to function";
-    }
-    return fAuxDetIdToChanGroup[adid];
+int CRTCommonUtils::ADToChanGroup(size_t adid) const {
+    return AuxDetInfo(adid, "CRTCommonUtils::ADMacToChanGroup").chanGroup;
 }
 
 //-------------------------------------------------------------------------------------
-int CRTCommonUtils::NFeb(size_t adid){
-    if(fAuxDetIdToFeb.find(adid)==fAuxDetIdToFeb.end()) {
-        throw cet::exception("CRTCommonUtils::NFeb")
-          << "unknown AuxDetID passed to function";
-    }
-    return(fAuxDetIdToFeb[adid]).size();
+int CRTCommonUtils::NFeb(size_t adid) const {
+    return AuxDetInfo(adid, "CRTCommonUtils::NFeb").nFeb;
 }
 
 //--------------------------------------------------------------------------------------
@@ -196,13 +181,7 @@ int CRTCommonUtils::MacToTypeCode(uint8_t mac)
         throw cet::exception("CRTCommonUtils::MacToType")
           << "unknown mac passed to function";
     }
-    char type = GetAuxDetType(fFebToAuxDetId[mac][0]);
-    switch(type){
-        case 'c': return 0;
-        case 'm': return 1;
-        case 'd': return 2;
-        default:  return -1;
-    }
+    return GetAuxDetTypeCode(fFebToAuxDetId[mac][0]);
 }
 
 
@@ -245,11 +224,6 @@ size_t CRTCommonUtils::MacToAuxDetID(uint8_t mac, int chan)
     
     for(auto const& adid : fFebToAuxDetId[mac]) {
       
-      if(fAuxDetIdToChanGroup.find(adid)==fAuxDetIdToChanGroup.end()){
-	throw cet::exception("CRTCommonUtils::ADMacToChanGroup")
-	  << "unknown AuxDetID passed to function";
-      }
-      
 
       //std::cout << "mac: "  << (int)mac << " ,module number " << adid <<  ", pos " << fAuxDetIdToChanGroup[adid] 
       //	<<  ", chan " << chan <<", pos to match " << pos << std::endl;
@@ -268,7 +242,7 @@ size_t CRTCommonUtils::MacToAuxDetID(uint8_t mac, int chan)
       
       */
 
-      if (fAuxDetIdToChanGroup[adid]==pos){
+      if (ADToChanGroup(adid)==pos){
 	return adid;
       }
       //	 std::cout << "mac: "  << (int)mac << ", chan " << chan << ", pos " << pos << ", adid " << adid<< std::endl;
@@ -306,182 +280,39 @@ double CRTCommonUtils::LengthIDE(sim::AuxDetIDE ide) {
 }
 
 //----------------------------------------------------------------------
-int CRTCommonUtils::GetLayerID(sim::AuxDetSimChannel const& adsc){
-    int layer = -1;
-
-    auto const& adGeo = fGeoService->AuxDet(adsc.AuxDetID());
-    auto const& adsGeo = adGeo.SensitiveVolume(adsc.AuxDetSensitiveID());
-    int region = AuxDetRegionNameToNum(GetAuxDetRegion(adsc.AuxDetID()));
-    char type = GetAuxDetType(adsc.AuxDetID());
-
-    std::set<string> volNames = { adsGeo.TotalVolume()->GetName() };
-    vector<vector<TGeoNode const*> > paths = fGeoService->FindAllVolumePaths(volNames);
-
-    std::string path = "";
-    for (size_t inode=0; inode<paths.at(0).size(); inode++) {
-        path += paths.at(0).at(inode)->GetName();
-        if (inode < paths.at(0).size() - 1) {
-            path += "/";
-        }
-    }
-    TGeoManager* manager = fGeoService->ROOTGeoManager();
-    manager->cd(path.c_str());
-    TGeoNode* nodeStrip = manager->GetCurrentNode();
-    TGeoNode* nodeInner = manager->GetMother(1);
-    TGeoNode* nodeModule = manager->GetMother(2);
-    double origin[3] = {0, 0, 0};
-    double modulePosMother[3]; //position in CRT region volume
-    double stripPosMother[3]; // strip position in module frame
-    double stripPosModule[3];
-
-    nodeModule->LocalToMaster(origin, modulePosMother);
-    nodeStrip->LocalToMaster(origin, stripPosMother);
-    nodeInner->LocalToMaster(stripPosMother,stripPosModule);
-
-    //if 'c' or 'd' type
-    if ( type == 'c' || type == 'd' )
-        layer = (stripPosModule[1] > 0);
-
-    // if 'm' type
-    if ( type == 'm' ) {
-        // if east or west stacks (6 in total)
-        if ( region >=40 && region <=45 ) {
-            layer = ( modulePosMother[0]>0 );
-        }
-        // if north stack
-        if ( region == 47) {
-            layer = ( modulePosMother[2]> 0 );
-        }
-        // if south stack
-        if( region == 46) {
-	  auto const& adsGeo = adGeo.SensitiveVolume(0);
-	  //            if(adsGeo.Length() < 500) //is cut module?
-	  if(adsGeo.Length() == 400 || adsGeo.Length() == 485.15) //is cut module?
-	    layer = 1;
-	  else 
-	    layer = 0;
-        }
-    }
-
-    return layer;
+int CRTCommonUtils::GetLayerID(sim::AuxDetSimChannel const& adsc) const {
 
-}
+    AuxDetInfo_t const& info = AuxDetInfo(adsc.AuxDetID(), "CRTCommonUtils::GetAuxDetRegion");
 
-//----------------------------------------------------------------------
-int CRTCommonUtils::GetLayerID(const art::Ptr<sim::AuxDetSimChannel> adsc){
-    int layer = -1;
-
-    auto const& adGeo = fGeoService->AuxDet(adsc->AuxDetID());
-    auto const& adsGeo = adGeo.SensitiveVolume(adsc->AuxDetSensitiveID());
-    int region = AuxDetRegionNameToNum(GetAuxDetRegion(adsc->AuxDetID()));
-    char type = GetAuxDetType(adsc->AuxDetID());
-
-    std::set<string> volNames = { adsGeo.TotalVolume()->GetName() };
-    vector<vector<TGeoNode const*> > paths = fGeoService->FindAllVolumePaths(volNames);
-
-    std::string path = "";
-    for (size_t inode=0; inode<paths.at(0).size(); inode++) {
-        path += paths.at(0).at(inode)->GetName();
-        if (inode < paths.at(0).size() - 1) {
-            path += "/";
-        }
-    }
-    TGeoManager* manager = fGeoService->ROOTGeoManager();
-    manager->cd(path.c_str());
-    TGeoNode* nodeStrip = manager->GetCurrentNode();
-    TGeoNode* nodeInner = manager->GetMother(1);
-    TGeoNode* nodeModule = manager->GetMother(2);
-    double origin[3] = {0, 0, 0};
-    double modulePosMother[3]; //position in CRT region volume
-    double stripPosMother[3]; // strip position in module frame
-    double stripPosModule[3];
-
-    nodeModule->LocalToMaster(origin, modulePosMother);
-    nodeStrip->LocalToMaster(origin, stripPosMother);
-    nodeInner->LocalToMaster(stripPosMother,stripPosModule);
-
-    //if 'c' or 'd' type
-    if ( type == 'c' || type == 'd' )
-        layer = (stripPosModule[1] > 0);
-
-    // if 'm' type
-    if ( type == 'm' ) {
-        // if east or west stacks (6 in total)
-        if ( region >=40 && region <=45 ) {
-            layer = ( modulePosMother[0]>0 );
-        }
-        // if north stack
-        if ( region == 47) {
-            layer = ( modulePosMother[2]> 0 );
-        }
-        // if south stack
-        if( region == 46) {
-	  //if(adsGeo.Length() < 500) //is cut module?
-	  if(adsGeo.Length() == 400 || adsGeo.Length() == 485.15) //is cut module?
-                layer = 1;
-            else 
-                layer = 0;
-        }
+    if(adsc.AuxDetSensitiveID() >= info.nStrips) {
+        throw cet::exception("CRTCommonUtils::GetLayerID")
+          << "unknown AuxDetSensitiveID " << adsc.AuxDetSensitiveID()
+          << " for AuxDetID " << adsc.AuxDetID();
     }
 
-    return layer;
+    return fStripLayer[info.firstStrip + adsc.AuxDetSensitiveID()];
+}
 
+//----------------------------------------------------------------------
+int CRTCommonUtils::GetLayerID(const art::Ptr<sim::AuxDetSimChannel> adsc) const {
+    return GetLayerID(*adsc);
 }
 
 //--------------------------------------------------------------------------------------------------
-int CRTCommonUtils::GetMINOSLayerID(size_t adid) {
-    int layer = -1;
-
-    int region = AuxDetRegionNameToNum(GetAuxDetRegion(adid));
-    char type = GetAuxDetType(adid);
-    auto const& adGeo = fGeoService->AuxDet(adid);
-    if(type!='m') {
-        mf::LogError("CRTCommonUtils") << "non-MINOS module provided to GetMINOSLayerID";
-        return layer;
-    }
+int CRTCommonUtils::GetMINOSLayerID(size_t adid) const {
 
-    std::set<string> volNames = { adGeo.TotalVolume()->GetName() };
-    vector<vector<TGeoNode const*> > paths = fGeoService->FindAllVolumePaths(volNames);
+    AuxDetInfo_t const& info = AuxDetInfo(adid, "CRTCommonUtils::GetAuxDetRegion");
 
-    std::string path = "";
-    for (size_t inode=0; inode<paths.at(0).size(); inode++) {
-        path += paths.at(0).at(inode)->GetName();
-        if (inode < paths.at(0).size() - 1) {
-            path += "/";
-        }
-    }
-    TGeoManager* manager = fGeoService->ROOTGeoManager();
-    manager->cd(path.c_str());
-    TGeoNode* nodeModule = manager->GetCurrentNode(); //Mother(2);
-    double origin[3] = {0, 0, 0};
-    double modulePosMother[3]; //position in CRT region volume
-    nodeModule->LocalToMaster(origin, modulePosMother);
-
-    // if east or west stacks (6 in total)
-    if ( region >=40 && region <=45 ) {
-        layer = ( modulePosMother[0]>0 );
-    }
-    // if north stack
-    if ( region == 47) {
-        layer = ( modulePosMother[2]> 0 );
-    }
-    // if south stack
-    if( region == 46) {
-        auto const& adsGeo = adGeo.SensitiveVolume(0);
-	if(adsGeo.Length() == 400 || adsGeo.Length() == 485.15) //is cut module?
-	//        if(adsGeo.Length() < 500) //is cut module?
-            layer = 1;
-        else
-            layer = 0;
+    if(info.type!='m') {
+        mf::LogError("CRTCommonUtils") << "non-MINOS module provided to GetMINOSLayerID";
+        return -1;
     }
 
-    if(layer==-1)
+    if(info.layer==-1)
         mf::LogError("CRTCommonUtils::GetMINOSLayerID")
            << "layer ID not set!";
 
-    return layer;
-
-
+    return info.layer;
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -594,6 +425,126 @@ void CRTCommonUtils::FillAuxDetMaps() {
 
 }
 
+//------------------------------------------------------------------------
+namespace {
+
+  //layer of a MINOS module from its position in the CRT region volume
+  int MINOSModuleLayer(int region, double const* modulePosMother, bool isCut) {
+    // if east or west stacks (6 in total)
+    if ( region >=40 && region <=45 )
+      return ( modulePosMother[0]>0 );
+    // if north stack
+    if ( region == 47)
+      return ( modulePosMother[2]> 0 );
+    // if south stack
+    if( region == 46)
+      return isCut? 1: 0;
+    return -1;
+  }
+
+} // local namespace
+
+//------------------------------------------------------------------------
+//fills the table of module and strip properties from the maps and the geometry;
+//  all the geometry paths are found with a single walk of the geometry tree
+//  and the node transformations are taken from the paths directly
+void CRTCommonUtils::FillAuxDetTable() {
+
+    fAuxDetInfo.clear();
+    fStripLayer.clear();
+    if(fAuxDetIdToFeb.empty()) return;
+
+    fAuxDetInfo.resize(fAuxDetIdToFeb.rbegin()->first + 1);
+
+    std::set<string> volNames;
+    for(auto const& ad : fAuxDetIdToFeb){
+        auto const& adGeo = fGeoService->AuxDet(ad.first);
+        volNames.insert(adGeo.TotalVolume()->GetName());
+        for(size_t adsid=0; adsid<adGeo.NSensitiveVolume(); adsid++)
+            volNames.insert(adGeo.SensitiveVolume(adsid).TotalVolume()->GetName());
+    }
+
+    //first path to each volume, as found by a search of that volume alone
+    map<string,vector<TGeoNode const*>> volPaths;
+    for(auto& path : fGeoService->FindAllVolumePaths(volNames))
+        volPaths.emplace(path.back()->GetVolume()->GetName(), std::move(path));
+
+    auto const findPath = [&volPaths](string const& name) -> vector<TGeoNode const*> const& {
+        auto const iPath = volPaths.find(name);
+        if(iPath==volPaths.end()) {
+            throw cet::exception("CRTCommonUtils::FillAuxDetTable")
+              << "no geometry path found for volume '" << name << "'";
+        }
+        return iPath->second;
+    };
+
+    double origin[3] = {0, 0, 0};
+
+    for(auto const& ad : fAuxDetIdToFeb){
+        size_t const adid = ad.first;
+        auto const& adGeo = fGeoService->AuxDet(adid);
+        AuxDetInfo_t& info = fAuxDetInfo[adid];
+
+        info.type       = fAuxDetIdToType[adid];
+        switch(info.type){
+            case 'c': info.typeCode = 0; break;
+            case 'm': info.typeCode = 1; break;
+            case 'd': info.typeCode = 2; break;
+            default:  info.typeCode = -1;
+        }
+        info.regionName = fAuxDetIdToRegion[adid];
+        info.region     = AuxDetRegionNameToNum(info.regionName);
+        info.chanGroup  = fAuxDetIdToChanGroup[adid];
+        info.nFeb       = ad.second.size();
+        info.macs       = (ad.second.size()==2)
+            ? std::make_pair(ad.second[0].first,ad.second[1].first)
+            : std::make_pair(ad.second[0].first,ad.second[0].first);
+
+        //cut MINOS modules
+        double const length = adGeo.SensitiveVolume(0).Length();
+        bool const isCut = (length == 400 || length == 485.15);
+
+        if(info.type=='m') {
+            TGeoNode const* nodeModule = findPath(adGeo.TotalVolume()->GetName()).back();
+            double modulePosMother[3]; //position in CRT region volume
+            nodeModule->LocalToMaster(origin, modulePosMother);
+            info.layer = MINOSModuleLayer(info.region, modulePosMother, isCut);
+        }
+
+        info.firstStrip = fStripLayer.size();
+        info.nStrips    = adGeo.NSensitiveVolume();
+
+        for(size_t adsid=0; adsid<info.nStrips; adsid++) {
+            auto const& path = findPath(adGeo.SensitiveVolume(adsid).TotalVolume()->GetName());
+            if(path.size() < 3) {
+                throw cet::exception("CRTCommonUtils::FillAuxDetTable")
+                  << "geometry path of strip " << adsid << " of AuxDetID " << adid << " is too short";
+            }
+            TGeoNode const* nodeStrip  = path[path.size()-1];
+            TGeoNode const* nodeInner  = path[path.size()-2];
+            TGeoNode const* nodeModule = path[path.size()-3];
+            double modulePosMother[3]; //position in CRT region volume
+            double stripPosMother[3]; // strip position in module frame
+            double stripPosModule[3];
+
+            nodeModule->LocalToMaster(origin, modulePosMother);
+            nodeStrip->LocalToMaster(origin, stripPosMother);
+            nodeInner->LocalToMaster(stripPosMother,stripPosModule);
+
+            int layer = -1;
+            //if 'c' or 'd' type
+            if ( info.type == 'c' || info.type == 'd' )
+                layer = (stripPosModule[1] > 0);
+            // if 'm' type
+            if ( info.type == 'm' )
+                layer = MINOSModuleLayer(info.region, modulePosMother, isCut);
+
+            fStripLayer.push_back(layer);
+        }
+    }
+
+}
+
 //--------------------------------------------------------------------
 string CRTCommonUtils::AuxDetNameToRegion(string name) {
 
@@ -23,6 +23,7 @@
 #include "TVector3.h"
 
 
+#include <climits> // INT_MAX
 #include <map>
 #include <vector>
 #include <string>
@@ -44,16 +45,17 @@ class icarus::crt::CRTCommonUtils {
  public:
     CRTCommonUtils();
 
-    int            GetAuxDetTypeCode(size_t adid);
-    char           GetAuxDetType(size_t adid);
-    string         GetAuxDetRegion(size_t adid);
-    int            AuxDetRegionNameToNum(string reg);
+    int            GetAuxDetTypeCode(size_t adid) const;
+    char           GetAuxDetType(size_t adid) const;
+    string const&  GetAuxDetRegion(size_t adid) const;
+    int            GetAuxDetRegionNum(size_t adid) const;
+    int            AuxDetRegionNameToNum(string const& reg) const;
     string         GetRegionNameFromNum(int num);
     char           GetRegTypeFromRegName(string name);
     int            GetTypeCodeFromRegion(string name);
-    pair<uint8_t,uint8_t> ADToMac(size_t adid);
-    int            ADToChanGroup(size_t adid);
-    int            NFeb(size_t adid);
+    pair<uint8_t,uint8_t> ADToMac(size_t adid) const;
+    int            ADToChanGroup(size_t adid) const;
+    int            NFeb(size_t adid) const;
     string         MacToRegion(uint8_t mac);
     char           MacToType(uint8_t mac);
     int            MacToTypeCode(uint8_t mac);
@@ -61,9 +63,9 @@ class icarus::crt::CRTCommonUtils {
     size_t         MacToAuxDetID(uint8_t mac, int chan);
     TLorentzVector AvgIDEPoint(sim::AuxDetIDE ide);
     double         LengthIDE(sim::AuxDetIDE ide);
-    int            GetLayerID(sim::AuxDetSimChannel const& adsc);
-    int            GetLayerID(const art::Ptr<sim::AuxDetSimChannel> adsc);
-    int            GetMINOSLayerID(size_t adid);
+    int            GetLayerID(sim::AuxDetSimChannel const& adsc) const;
+    int            GetLayerID(const art::Ptr<sim::AuxDetSimChannel> adsc) const;
+    int            GetMINOSLayerID(size_t adid) const;
     TVector3       ChanToLocalCoords(const uint8_t mac, const int chan);
     TVector3       ChanToWorldCoords(const uint8_t mac, const int chan);
     TVector3       WorldToModuleCoords(TVector3 point, size_t adid);
@@ -83,6 +85,22 @@ class icarus::crt::CRTCommonUtils {
 
 
  private:
+    // Everything the per-hit accessors need about a CRT module, computed once
+    // in the constructor so that they are plain array reads (and do not touch
+    // the shared ROOT geometry navigation state)
+    struct AuxDetInfo_t {
+        char     type       = 0;        ///< 'c', 'm' or 'd' (0 if not a CRT module)
+        int      typeCode   = -1;       ///< 0, 1, 2 for 'c', 'm', 'd'
+        int      region     = INT_MAX;  ///< region code (30-50)
+        int      layer      = -1;       ///< layer of the module (MINOS modules only)
+        int      chanGroup  = 0;        ///< FEB channel block
+        int      nFeb       = 0;        ///< number of FEBs reading the module
+        pair<uint8_t,uint8_t> macs;     ///< mac5 of the FEBs
+        size_t   firstStrip = 0;        ///< index of the layer of strip 0 in fStripLayer
+        size_t   nStrips    = 0;        ///< number of sensitive volumes (strips)
+        string   regionName;            ///< region name
+    };
+
     //geo::AuxDetGeometryCore const* fGeoService;
     geo::GeometryCore const* fGeoService;
     map<size_t,vector<pair<uint8_t,int>>> fAuxDetIdToFeb;
@@ -91,9 +109,13 @@ class icarus::crt::CRTCommonUtils {
     map<size_t,string>          fAuxDetIdToRegion;
     map<string,size_t>          fNameToAuxDetId;
     map<size_t,int>             fAuxDetIdToChanGroup;
+    vector<AuxDetInfo_t>        fAuxDetInfo;   ///< module information, by AuxDetID
+    vector<int>                 fStripLayer;   ///< strip layer, by AuxDetInfo_t::firstStrip + AuxDetSensitiveID
 
     void   FillFebMap();
     void   FillAuxDetMaps();
+    void   FillAuxDetTable();
+    AuxDetInfo_t const& AuxDetInfo(size_t adid, const char* caller) const;
     string AuxDetNameToRegion(string name);
 
 };//CRTCommonUtils
@@ -386,8 +386,8 @@ sbn::crt::CRTHit CRTHitRecoAlg::MakeTopHit(
   map<uint8_t, vector<pair<int, float>>> pesmap;
   int adid = fCrtutils.MacToAuxDetID(mac, 0);          // module ID
   auto const& adGeo = fGeometryService->AuxDet(adid);  // module
-  string region = fCrtutils.GetAuxDetRegion(adid);
-  int plane = fCrtutils.AuxDetRegionNameToNum(region);
+  string const& region = fCrtutils.GetAuxDetRegion(adid);
+  int plane = fCrtutils.GetAuxDetRegionNum(adid);
   double hitpointerr[3];
   TVector3 hitpos(0., 0., 0.);
   float petot = 0., pemax = 0., pemaxx = 0., pemaxz = 0.;
@@ -511,8 +511,8 @@ sbn::crt::CRTHit CRTHitRecoAlg::MakeBottomHit(art::Ptr<CRTData> data) {
   map<uint8_t, vector<pair<int, float>>> pesmap;
   int adid = fCrtutils.MacToAuxDetID(mac, 0);          // module ID
   auto const& adGeo = fGeometryService->AuxDet(adid);  // module
-  string region = fCrtutils.GetAuxDetRegion(adid);
-  int plane = fCrtutils.AuxDetRegionNameToNum(region);
+  string const& region = fCrtutils.GetAuxDetRegion(adid);
+  int plane = fCrtutils.GetAuxDetRegionNum(adid);
   double hitpointerr[3];
   TVector3 hitpos(0., 0., 0.);
   float petot = 0., pemax = 0.;
@@ -589,8 +589,8 @@ sbn::crt::CRTHit CRTHitRecoAlg::MakeSideHit(
 
   int adid = fCrtutils.MacToAuxDetID(coinData[0]->fMac5, 0);  // module ID
   auto const& adGeo = fGeometryService->AuxDet(adid);         // module
-  string region = fCrtutils.GetAuxDetRegion(adid);            //region name
-  int plane = fCrtutils.AuxDetRegionNameToNum(region);        //region code (ranges from 30-50)
+  string const& region = fCrtutils.GetAuxDetRegion(adid);     //region name
+  int plane = fCrtutils.GetAuxDetRegionNum(adid);              //region code (ranges from 30-50)
   double hitpoint[3], hitpointerr[3];
   TVector3 hitpos(0., 0., 0.);
 
@@ -1270,13 +1270,14 @@ class icarus::DaqDecoderICARUSPMT: public art::EDProducer {
    * @param corrections the set of available corrections by channel
    * @return the time correction [us]
    *
-   * Corrections are preferably extracted from `corrections` if non-null.
-   * If no `corrections` are specified, cable delay corrections are applied
-   * according to the value of the configuration (`fApplyCableDelayCorrection`).
+   * Channels with no entry in `corrections` get a default correction.
+   * Waveforms not corrected this way get the cable delay corrections, applied
+   * to the whole collection at once by `prepareOutputWaveforms()` according to
+   * the value of the configuration (`fApplyCableDelayCorrection`).
    */
   double extractTimeCorrection(
     raw::OpDetWaveform const& waveform,
-    std::vector<icarus::timing::PMTWaveformTimeCorrection> const* corrections
+    std::vector<icarus::timing::PMTWaveformTimeCorrection> const& corrections
     ) const;
   
   
@@ -2777,24 +2778,30 @@ auto icarus::DaqDecoderICARUSPMT::prepareOutputWaveforms(
     
     if (!keep) continue;
     
-    // apply time correction only to "standard" waveforms;
-    // we may extend the logic if needed
-    bool const useCorrection
-      = (waveform.channelSetup->category == RegularWaveformCategory);
+    // apply time correction from the trigger signals only to "standard"
+    // waveforms; we may extend the logic if needed
+    bool const useCorrection = timeCorrections
+      && (waveform.channelSetup->category == RegularWaveformCategory);
 
-    double const correctTimeStamp
-      = waveform.waveform.TimeStamp()
-      + extractTimeCorrection
-        (waveform.waveform, useCorrection? timeCorrections: nullptr)
-      ;
-    
-    // Set a new Timestamp
-    waveform.waveform.SetTimeStamp(correctTimeStamp);
+    if (useCorrection) {
+      // Set a new Timestamp
+      waveform.waveform.SetTimeStamp(waveform.waveform.TimeStamp()
+        + extractTimeCorrection(waveform.waveform, *timeCorrections));
+    }
     itOutputWaves->second.push_back(std::move(waveform.waveform));
   } // for protowaveforms
   
   protoWaveforms.clear();
   
+  // all other waveforms get the cable delay correction, if requested
+  if (fApplyCableDelayCorrection) {
+    for (auto& [ category, waveforms ]: waveformProducts) {
+      if (timeCorrections && (category == RegularWaveformCategory)) continue;
+      fPMTTimingCorrectionsService->correctWaveforms
+        (waveforms, icarusDB::PMTTimingCorrections::ResetCableCorr);
+    }
+  } // if cable delay correction
+  
   return waveformProducts;
   
 } // icarus::DaqDecoderICARUSPMT::prepareOutputWaveforms()
@@ -2830,22 +2837,14 @@ icarus::DaqDecoderICARUSPMT::createRegularWaveformMetadata(
 //------------------------------------------------------------------------------
 double icarus::DaqDecoderICARUSPMT::extractTimeCorrection(
   raw::OpDetWaveform const& waveform,
-  std::vector<icarus::timing::PMTWaveformTimeCorrection> const* corrections
+  std::vector<icarus::timing::PMTWaveformTimeCorrection> const& corrections
 ) const {
 
   raw::Channel_t const channel = waveform.ChannelNumber();
   
-  if (corrections) {
-    if (channel < corrections->size())
-      return (*corrections)[channel].startTime;
-    else
-      return icarus::timing::PMTWaveformTimeCorrection{}.startTime;
-  }
-  
-  if (fApplyCableDelayCorrection)
-    return fPMTTimingCorrectionsService->getResetCableDelay(channel);
-  
-  return 0.0;
+  return (channel < corrections.size())
+    ? corrections[channel].startTime
+    : icarus::timing::PMTWaveformTimeCorrection{}.startTime;
 } // icarus::DaqDecoderICARUSPMT::extractTimeCorrection()
 
 
@@ -49,6 +49,8 @@
 #include "sbndaq-artdaq-core/Overlays/ICARUS/PhysCrateFragment.hh"
 
 #include "icaruscode/Utilities/ArtHandleTrackerManager.h"
+#include "icaruscode/Utilities/StageTimers.h"
+#include "icaruscode/TPC/Compression/A2795Compression.h"
 #include "icaruscode/Decode/DecoderTools/INoiseFilter.h"
 #include "icaruscode/Decode/ChannelMapping/IICARUSChannelMap.h"
 
@@ -192,9 +194,21 @@ private:
     // Tools for decoding fragments depending on type
     std::vector<std::unique_ptr<INoiseFilter>>                  fDecoderToolVec;       ///< Decoder tools
 
+    // Per thread working buffers the board waveforms are decoded into
+    std::vector<std::unique_ptr<ChannelArrayPair>>              fChannelArrayPairVec;  ///< Board working buffers
+
     // Useful services, keep copies for now (we can update during begin run periods)
     geo::GeometryCore const*                                    fGeometry;             ///< pointer to Geometry service
     const icarusDB::IICARUSChannelMap*                          fChannelMap;
+
+    // Timing of the processing stages, shared by all the module replicas
+    std::shared_ptr<util::StageTimers>                          fStageTimers;
+    util::StageTimers::StageID_t                                fEventStage;           ///< Whole event
+    util::StageTimers::StageID_t                                fFragmentStage;        ///< Single fragment, all steps
+    util::StageTimers::StageID_t                                fDecodeStage;          ///< Single board decoding
+    util::StageTimers::StageID_t                                fNoiseFilterStage;     ///< Single board noise filtering
+    util::StageTimers::StageID_t                                fOutputStage;          ///< Single board pedestal and ROIs
+    util::StageTimers::StageID_t                                fStoreStage;           ///< Sorting and storing of the products
 };
 
 DEFINE_ART_MODULE(DaqDecoderICARUSTPCwROI)
@@ -214,6 +228,14 @@ DaqDecoderICARUSTPCwROI::DaqDecoderICARUSTPCwROI(fhicl::ParameterSet const & pse
 
     configure(pset);
 
+    fStageTimers      = util::StageTimers::forModule(pset.get<std::string>("module_label"));
+    fEventStage       = fStageTimers->addStage("event");
+    fFragmentStage    = fStageTimers->addStage("fragment");
+    fDecodeStage      = fStageTimers->addStage("decode");
+    fNoiseFilterStage = fStageTimers->addStage("noiseFilter");
+    fOutputStage      = fStageTimers->addStage("output");
+    fStoreStage       = fStageTimers->addStage("store");
+
     // Check the concurrency 
     int max_concurrency = art::Globals::instance()->nthreads(); 
 
@@ -230,6 +252,11 @@ DaqDecoderICARUSTPCwROI::DaqDecoderICARUSTPCwROI(fhicl::ParameterSet const & pse
         decoderTool = art::make_tool<INoiseFilter>(decoderToolParams);
     }
 
+    // The working buffers are sized on first use
+    fChannelArrayPairVec.resize(max_concurrency);
+
+    for(auto& channelArrayPair : fChannelArrayPairVec) channelArrayPair = std::make_unique<ChannelArrayPair>();
+
     // Set up our "producers" 
     // Note that we can have multiple instances input to the module
     // Our convention will be to create a similar number of outputs with the same instance names
@@ -353,6 +380,8 @@ void DaqDecoderICARUSTPCwROI::produce(art::Event & event, art::ProcessingFrame c
 
     theClockTotal.start();
 
+    auto const eventTimer = fStageTimers->time(fEventStage);
+
     // Loop through the list of input daq fragment collections one by one 
     // We are not trying to multi thread at this stage because we are trying to control
     // overall memory usage at this level. We'll multi thread internally...
@@ -392,6 +421,8 @@ void DaqDecoderICARUSTPCwROI::produce(art::Event & event, art::ProcessingFrame c
 
         tbb::parallel_for(tbb::blocked_range<size_t>(0, daq_handle->size()), fragmentProcessing);
 
+        auto const storeTimer = fStageTimers->time(fStoreStage);
+
         // Now let's process the resulting images
     //    multiThreadImageProcessing imageProcessing(*this, clockData, channelArrayPairVec, concurrentRawDigits, coherentRawDigits, concurrentROIs);
 
@@ -485,6 +516,8 @@ void DaqDecoderICARUSTPCwROI::processSingleFragment(size_t
 
     theClockProcess.start();
 
+    auto const fragmentTimer = fStageTimers->time(fFragmentStage);
+
     art::Ptr<artdaq::Fragment> fragmentPtr(fragmentHandle, idx);
 
     mf::LogDebug("DaqDecoderICARUSTPCwROI") << "--> Processing fragment ID: " << fragmentPtr->fragmentID() << std::endl;
@@ -494,12 +527,13 @@ void DaqDecoderICARUSTPCwROI::processSingleFragment(size_t
 
     theClockTotal.start();
 
-    // convert fragment to Nevis fragment
-    icarus::PhysCrateFragment physCrateFragment(*fragmentPtr);
+    // Locate the boards in the fragment; compressed fragments (compression scheme 1)
+    // are decoded on the fly, board by board, directly into the working buffers
+    icarus::compression::FragmentBoardDecoder boardDecoder(*fragmentPtr);
 
-    size_t nBoardsPerFragment = physCrateFragment.nBoards();
-    size_t nChannelsPerBoard  = physCrateFragment.nChannelsPerBoard();
-    size_t nSamplesPerChannel = physCrateFragment.nSamplesPerChannel();
+    size_t nBoardsPerFragment = boardDecoder.nBoards();
+    size_t nChannelsPerBoard  = boardDecoder.nChannelsPerBoard();
+    size_t nSamplesPerChannel = boardDecoder.nSamplesPerChannel();
 //    size_t nChannelsPerFragment = nBoardsPerFragment * nChannelsPerBoard;
 
     // Recover the Fragment id:
@@ -551,11 +585,13 @@ void DaqDecoderICARUSTPCwROI::processSingleFragment(size_t
     // Recover pointer to the decoder needed here
     INoiseFilter* decoderTool = fDecoderToolVec[tbb::this_task_arena::current_thread_index()].get();
 
-    // Create a local channel pair  to hold at most a boards worth of info (64 channels x 4096 ticks)
-    ChannelArrayPair channelArrayPair;
+    // Recover the channel pair for this thread to hold at most a boards worth of info (64 channels x 4096 ticks)
+    ChannelArrayPair& channelArrayPair = *fChannelArrayPairVec[tbb::this_task_arena::current_thread_index()];
 
     channelArrayPair.first.resize(nChannelsPerBoard);
-    channelArrayPair.second.resize(nChannelsPerBoard,icarus_signal_processing::VectorFloat(nSamplesPerChannel));
+    channelArrayPair.second.resize(nChannelsPerBoard);
+
+    for(auto& rawDataVec : channelArrayPair.second) rawDataVec.resize(nSamplesPerChannel);
 
     // Now set up for output, we need to convert back from float to short int so use this
     raw::RawDigit::ADCvector_t wvfm(nSamplesPerChannel);
@@ -573,7 +609,7 @@ void DaqDecoderICARUSTPCwROI::processSingleFragment(size_t
 
         const icarusDB::ChannelPlanePairVec& channelPlanePairVec = fChannelMap->getChannelPlanePair(boardIDVec[board]);
 
-        uint32_t boardSlot = physCrateFragment.DataTileHeader(board)->StatusReg_SlotID();
+        uint32_t boardSlot = reinterpret_cast<icarus::PhysCrateDataTileHeader const*>(boardDecoder.boardHeader(board))->StatusReg_SlotID();
 
         // ** the line below removed as per request of the TPC hardware folks 
 //        const icarusDB::ChannelPlanePairVec& channelPlanePairVec = fChannelMap->getChannelPlanePair(boardIDVec[boardSlot]);
@@ -585,20 +621,28 @@ void DaqDecoderICARUSTPCwROI::processSingleFragment(size_t
         {
             mf::LogInfo(fLogCategory) << "==> Found board/boardSlot mismatch, crate: " << crateName << ", board: " << board << ", boardSlot: " << boardSlot << " channelPlanePair: " << fChannelMap->getChannelPlanePair(boardIDVec[board]).front().first << "/"  << fChannelMap->getChannelPlanePair(boardIDVec[board]).front().second << ", slot: " << channelPlanePairVec[0].first << "/" << channelPlanePairVec[0].second;
         }
-        // Copy to input data array
-        for(size_t chanIdx = 0; chanIdx < nChannelsPerBoard; chanIdx++)
-        {
-           icarus_signal_processing::VectorFloat& rawDataVec = channelArrayPair.second[chanIdx];
-           for (size_t tick = 0; tick < nSamplesPerChannel; ++tick)
-             rawDataVec[tick] = -physCrateFragment.adc_val(board, chanIdx, tick);
+        // Decode to input data array
+        icarus_signal_processing::ArrayFloat& rawDataArray = channelArrayPair.second;
 
-          // Keep track of the channel
-          channelArrayPair.first[chanIdx] = channelPlanePairVec[chanIdx];
-        }
+        auto decodeTimer = fStageTimers->time(fDecodeStage);
+
+        boardDecoder.decodeBoard(board, [&rawDataArray,nChannelsPerBoard](size_t tick, uint16_t const* adcs)
+            {for(size_t chanIdx = 0; chanIdx < nChannelsPerBoard; chanIdx++) rawDataArray[chanIdx][tick] = -adcs[chanIdx];});
+
+        decodeTimer.stop();
+
+        // Keep track of the channel
+        for(size_t chanIdx = 0; chanIdx < nChannelsPerBoard; chanIdx++) channelArrayPair.first[chanIdx] = channelPlanePairVec[chanIdx];
+
+        auto noiseFilterTimer = fStageTimers->time(fNoiseFilterStage);
 
         //process_fragment(event, rawfrag, product_collection, header_collection);
         decoderTool->process_fragment(clockData, channelArrayPair.first, channelArrayPair.second, fCoherentNoiseGrouping);
 
+        noiseFilterTimer.stop();
+
+        auto const outputTimer = fStageTimers->time(fOutputStage);
+
         // We need to recalculate pedestals for the noise corrected waveforms
         icarus_signal_processing::WaveformTools<float> waveformTools;
 
@@ -727,6 +771,8 @@ void DaqDecoderICARUSTPCwROI::processSingleFragment(size_t
 void DaqDecoderICARUSTPCwROI::endJob(art::ProcessingFrame const&)
 {
     mf::LogInfo(fLogCategory) << "Looked at " << fNumEvent << " events" << std::endl;
+
+    fStageTimers->report(fLogCategory);
 }
 
 } // end of namespace
@@ -24,6 +24,7 @@
 
 #include "icaruscode/Decode/DecoderTools/IDecoderFilter.h"
 #include "icaruscode/Decode/ChannelMapping/IICARUSChannelMap.h"
+#include "icaruscode/TPC/Compression/A2795Compression.h"
 
 #include "icarus_signal_processing/WaveformTools.h"
 #include "icarus_signal_processing/Denoising.h"
@@ -267,12 +268,12 @@ void TPCDecoderFilter1D::process_fragment(detinfo::DetectorClocksData const&,
 
     theClockTotal.start();
 
-    // convert fragment to Nevis fragment
-    icarus::PhysCrateFragment physCrateFragment(fragment);
+    // Locate the boards in the fragment, compressed fragments are decoded on the fly
+    icarus::compression::FragmentBoardDecoder boardDecoder(fragment);
 
-    size_t nBoardsPerFragment   = physCrateFragment.nBoards();
-    size_t nChannelsPerBoard    = physCrateFragment.nChannelsPerBoard();
-    size_t nSamplesPerChannel   = physCrateFragment.nSamplesPerChannel();
+    size_t nBoardsPerFragment   = boardDecoder.nBoards();
+    size_t nChannelsPerBoard    = boardDecoder.nChannelsPerBoard();
+    size_t nSamplesPerChannel   = boardDecoder.nSamplesPerChannel();
 //    size_t nChannelsPerFragment = nBoardsPerFragment * nChannelsPerBoard;
 
     // Recover the Fragment id:
@@ -384,7 +385,7 @@ void TPCDecoderFilter1D::process_fragment(detinfo::DetectorClocksData const&,
 
         const icarusDB::ChannelPlanePairVec& channelPlanePairVec = fChannelMap->getChannelPlanePair(boardIDVec[board]);
 
-        uint32_t boardSlot = physCrateFragment.DataTileHeader(board)->StatusReg_SlotID();
+        uint32_t boardSlot = reinterpret_cast<icarus::PhysCrateDataTileHeader const*>(boardDecoder.boardHeader(board))->StatusReg_SlotID();
 
         if (fDiagnosticOutput)
         {
@@ -396,6 +397,12 @@ void TPCDecoderFilter1D::process_fragment(detinfo::DetectorClocksData const&,
         // This is where we would recover the base channel for the board from database/module
         size_t boardOffset = nChannelsPerBoard * board;
 
+        // Decode the whole board into the input data array
+        icarus_signal_processing::ArrayFloat& rawWaveforms = fRawWaveforms;
+
+        boardDecoder.decodeBoard(board, [&rawWaveforms,boardOffset,nChannelsPerBoard](size_t tick, uint16_t const* adcs)
+            {for(size_t chanIdx = 0; chanIdx < nChannelsPerBoard; chanIdx++) rawWaveforms[boardOffset + chanIdx][tick] = -adcs[chanIdx];});
+
         // Copy to input data array
         for(size_t chanIdx = 0; chanIdx < nChannelsPerBoard; chanIdx++)
         {
@@ -403,8 +410,6 @@ void TPCDecoderFilter1D::process_fragment(detinfo::DetectorClocksData const&,
             size_t channelOnBoard = boardOffset + chanIdx;
 
             icarus_signal_processing::VectorFloat& rawDataVec = fRawWaveforms[channelOnBoard];
-            for (size_t tick = 0; tick < nSamplesPerChannel; ++tick)
-              rawDataVec[tick] = -physCrateFragment.adc_val(board, chanIdx, tick);
 
             icarus_signal_processing::VectorFloat& pedCorDataVec = fPedCorWaveforms[channelOnBoard];
 
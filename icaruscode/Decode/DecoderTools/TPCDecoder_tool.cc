@@ -23,6 +23,7 @@
 #include "sbndaq-artdaq-core/Overlays/ICARUS/PhysCrateFragment.hh"
 
 #include "icaruscode/Decode/DecoderTools/IDecoder.h"
+#include "icaruscode/TPC/Compression/A2795Compression.h"
 
 // std includes
 #include <string>
@@ -133,28 +134,30 @@ void TPCDecoder::process_fragment(const artdaq::Fragment &fragment)
 {
     size_t fragment_id = fragment.fragmentID() - fFragment_id_offset;
   
-    // convert fragment to Nevis fragment
-    icarus::PhysCrateFragment physCrateFragment(fragment);
+    // Locate the boards in the fragment, compressed fragments are decoded on the fly
+    icarus::compression::FragmentBoardDecoder boardDecoder(fragment);
     
-    size_t nBoardsPerFragment = physCrateFragment.nBoards();
-    size_t nChannelsPerBoard  = physCrateFragment.nChannelsPerBoard();
+    size_t nBoardsPerFragment = boardDecoder.nBoards();
+    size_t nChannelsPerBoard  = boardDecoder.nChannelsPerBoard();
+    size_t nSamplesPerChannel = boardDecoder.nSamplesPerChannel();
+
+    std::vector<raw::RawDigit::ADCvector_t> wvfms(nChannelsPerBoard, raw::RawDigit::ADCvector_t(nSamplesPerChannel));
 
     //int channel_count=0;
-    for(size_t board = 0; board < physCrateFragment.nBoards(); board++)
+    for(size_t board = 0; board < nBoardsPerFragment; board++)
     {
 //        size_t event_number = physCrateFragment.BoardEventNumber(i_b);
 //        size_t timestamp    = physCrateFragment.BoardTimeStamp(board);
 
         size_t boardId = nChannelsPerBoard * (nBoardsPerFragment * fragment_id + board);
 
-        for(size_t channel = 0; channel < physCrateFragment.nChannelsPerBoard(); channel++)
+        boardDecoder.decodeBoard(board, [&wvfms,nChannelsPerBoard](size_t sample, uint16_t const* adcs)
+            {for(size_t channel = 0; channel < nChannelsPerBoard; channel++) wvfms[channel][sample] = adcs[channel];});
+
+        for(size_t channel = 0; channel < nChannelsPerBoard; channel++)
         {
             raw::ChannelID_t           channel_num = boardId + channel;
-            raw::RawDigit::ADCvector_t wvfm(physCrateFragment.nSamplesPerChannel());
-            //wvfm.assign(physCrateFragment.channel_adc_vec(board, channel).begin(), physCrateFragment.channel_adc_vec(board, channel).end());
-            for (size_t sample = 0; sample < physCrateFragment.nSamplesPerChannel(); sample++)
-              wvfm.at(sample) = physCrateFragment.adc_val(board, channel, sample);
-            fRawDigitCollection->emplace_back(channel_num,physCrateFragment.nSamplesPerChannel(),wvfm);
+            fRawDigitCollection->emplace_back(channel_num,nSamplesPerChannel,wvfms[channel]);
         }//loop over channels
     }//loop over boards
 
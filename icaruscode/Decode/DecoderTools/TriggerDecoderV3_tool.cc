@@ -36,7 +36,7 @@
 #include "icaruscode/Decode/DecoderTools/IDecoder.h"
 #include "sbnobj/Common/Trigger/BeamBits.h"
 #include "icaruscode/Decode/DecoderTools/Dumpers/FragmentDumper.h" // dumpFragment()
-#include "icaruscode/Decode/DecoderTools/details/KeyedCSVparser.h"
+#include "icaruscode/Decode/DecoderTools/details/TriggerDataParserV3.h"
 #include "icaruscode/Decode/DecoderTools/details/KeyValuesData.h"
 #include "icaruscode/Decode/ChannelMapping/IICARUSChannelMap.h"
 #include "icaruscode/Decode/ChannelMapping/IICARUSChannelMapProvider.h"
@@ -293,16 +293,18 @@ namespace daq
     /// Map of LVDS bits.
     std::optional<icarus::trigger::LVDSbitMaps> fPMTpairMap;
     
+    /// Parser of the trigger data packet, configured once for all events.
+    icarus::details::TriggerDataParserV3 const fDataParser;
+    
     /// Creates a `ICARUSTriggerInfo` from a generic fragment.
     icarus::ICARUSTriggerV3Fragment makeTriggerFragment
       (artdaq::Fragment const& fragment) const;
     
-    /// Parses the trigger data packet with the "standard" parser.
-    icarus::ICARUSTriggerInfo parseTriggerString(std::string_view data) const;
+    /// Content of the trigger data packet.
+    using ParsedTriggerString_t = icarus::details::TriggerDataParserV3::Parsed_t;
     
-    /// Parses the trigger data packet with a CSV parser.
-    icarus::KeyValuesData parseTriggerStringAsCSV
-      (std::string const& data) const;
+    /// Parses the trigger data packet, filling `info` and `data` in one pass.
+    ParsedTriggerString_t parseTriggerString(std::string const& data) const;
     
     /// Name of the data product instance for the current trigger.
     static std::string const CurrentTriggerInstanceName;
@@ -469,48 +471,22 @@ namespace daq
   } // TriggerDecoderV3::makeTriggerFragment()
 
   
-  icarus::ICARUSTriggerInfo TriggerDecoderV3::parseTriggerString
-    (std::string_view data) const
+  auto TriggerDecoderV3::parseTriggerString(std::string const& data) const
+    -> ParsedTriggerString_t
   {
-    try {
-      return icarus::parse_ICARUSTriggerV3String(data.data());
-    }
-    catch(std::exception const& e) {
-      mf::LogSystem("TriggerDecoder")
-        << "Error while running standard parser on " << data.length()
-        << "-char long trigger string:\n==>|" << data
-        << "|<==\nError message: " << e.what();
-      throw;
-    }
-    catch(...) {
-      mf::LogSystem("TriggerDecoder")
-        << "Unidentified exception while running standard parser on "
-        << data.length() << "-char long trigger string:\n==>|" << data << "|.";
-      throw;
-    }
-  } // TriggerDecoderV3::parseTriggerString()
-
-
-  icarus::KeyValuesData TriggerDecoderV3::parseTriggerStringAsCSV
-    (std::string const& data) const
-  {
-    icarus::details::KeyedCSVparser parser;
-    parser.addPatterns({
-        { "Cryo. (EAST|WEST) Connector . and .", 1U }
-        , { "Trigger Type", 1U }
-      });
     std::string_view const dataLine = firstLine(data);
     try {
-      return parser(dataLine);
+      return fDataParser(dataLine);
     }
-    catch(icarus::details::KeyedCSVparser::Error const& e) {
+    catch(icarus::KeyValuesData::Error const& e) {
       mf::LogError("TriggerDecoder")
         << "Error parsing " << dataLine.length()
         << "-char long trigger string:\n==>|" << dataLine
         << "|<==\nError message: " << e.what() << std::endl;
       throw;
     }
-  } // TriggerDecoderV3::parseTriggerStringAsCSV()
+  } // TriggerDecoderV3::parseTriggerString()
+  
   
 
   void TriggerDecoderV3::setupRun(art::Run const& run) {
@@ -548,10 +524,12 @@ namespace daq
     // the decoder trusts it and references all the times with respect to it.
     uint64_t const artdaq_ts = fragment.timestamp();
     icarus::ICARUSTriggerV3Fragment frag { makeTriggerFragment(fragment) };
-    std::string data = frag.GetDataString();
-    char *buffer = const_cast<char*>(data.c_str());
+    std::string const data = frag.GetDataString();
 
-    icarus::ICARUSTriggerInfo datastream_info = parseTriggerString(buffer);
+    ParsedTriggerString_t const parsedString = parseTriggerString(data);
+    icarus::ICARUSTriggerInfo const& datastream_info = parsedString.info;
+    icarus::KeyValuesData const& parsedData = parsedString.data;
+    
     uint64_t const raw_wr_ts // this is raw, unadultered, uncorrected
       = makeTimestamp(frag.getWRSeconds(), frag.getWRNanoSeconds());
     
@@ -562,12 +540,6 @@ namespace daq
       { return time + WRtimeToTriggerTime; };
     assert(correctWRtime(raw_wr_ts) == artdaq_ts);
     
-    //
-    // we parse again the trigger string for information that was not saved
-    // by the board reader in the trigger fragment nor in `datastream_info`
-    //
-    auto const parsedData = parseTriggerStringAsCSV(data); 
-    
     unsigned int beamgate_count { std::numeric_limits<unsigned int>::max() };
     std::uint64_t beamgate_ts { artdaq_ts }; // we cheat
     /* [20210717, petrillo@slac.stanford.edu] `(pBeamGateInfo->nValues() == 3)`:
@@ -798,7 +770,7 @@ namespace daq
     // fill sbn::ExtraTriggerInfo::cryostats
     //
     auto setCryoInfo = [
-      this,&extra=*fTriggerExtra,isFirstEvent=(triggerID <= 1),data=parsedData
+      this,&extra=*fTriggerExtra,isFirstEvent=(triggerID <= 1),&data=parsedData
       ]
         (std::size_t cryo)
       {
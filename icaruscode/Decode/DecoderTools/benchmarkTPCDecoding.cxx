@@ -0,0 +1,683 @@
+/**
+ * @file   icaruscode/Decode/DecoderTools/benchmarkTPCDecoding.cxx
+ * @brief  Benchmark of the TPC decoding and noise filtering on synthetic data.
+ * @date   October 19, 2026
+ *
+ * The program generates a set of TPC fragments in the `PhysCrateFragment`
+ * layout (optionally with the A2795 difference compression) and runs on them
+ * the same sequence of steps as `DaqDecoderICARUSTPCwROI` with the
+ * `TPCNoiseFilter1D` tool:
+ *
+ * 1. _unpack_: decoding of the samples of each board
+ *    (`icarus::compression::FragmentBoardDecoder`);
+ * 2. _pedestal_: pedestal subtraction of each channel (with the low frequency
+ *    principal component analysis);
+ * 3. _denoise_: coherent noise removal and morphological ROI finding
+ *    (`icarus_signal_processing::Denoiser1D`);
+ * 4. _output_: pedestal of the denoised waveforms and creation of the
+ *    `raw::RawDigit` and `recob::ChannelROI` data products.
+ *
+ * Fragments are processed in parallel, one per task, with per-thread
+ * workspaces as in the module. For each requested number of threads the
+ * program prints the throughput, the average time spent in each step per
+ * fragment and the number of memory allocations per fragment in each step.
+ * Neither the _art_ framework nor input data are needed.
+ *
+ * Run `benchmarkTPCDecoding --help` for the list of options.
+ */
+
+// ICARUS libraries
+#include "icaruscode/TPC/Compression/A2795Compression.h"
+#include "icaruscode/TPC/Utilities/ChannelROICreator.h"
+#include "sbnobj/ICARUS/TPC/ChannelROI.h"
+
+// LArSoft libraries
+#include "lardataobj/RawData/RawDigit.h"
+
+// ICARUS signal processing
+#include "icarus_signal_processing/WaveformTools.h"
+#include "icarus_signal_processing/Denoising.h"
+
+// artdaq libraries
+#include "artdaq-core/Data/Fragment.hh"
+
+// Eigen
+#include "Eigen/Core"
+
+// TBB
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#include "tbb/global_control.h"
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/concurrent_vector.h"
+
+// C++/Boost libraries
+#include "boost/program_options.hpp"
+#include <arpa/inet.h> // htonl()
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath> // std::round()
+#include <cstdint>
+#include <cstdlib> // std::exit(), std::malloc(), std::free()
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ * Notable changes here:
+ *
+ * [20261019] [1.0]
+ *     initial version
+ *
+ */
+static std::string const ProgramVersion = "v1.0";
+
+
+// -----------------------------------------------------------------------------
+// --- memory allocation counting
+// -----------------------------------------------------------------------------
+namespace {
+  /// Number of allocations performed by this thread so far.
+  thread_local std::size_t NAllocations = 0U;
+} // local namespace
+
+// the replacement operators are a matching pair: GCC can't know and complains
+#if defined(__GNUC__) && !defined(__clang__)
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void* operator new(std::size_t size) {
+  ++NAllocations;
+  if (void* p = std::malloc(size? size: 1U)) return p;
+  throw std::bad_alloc{};
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+#if defined(__GNUC__) && !defined(__clang__)
+#  pragma GCC diagnostic pop
+#endif
+
+
+// -----------------------------------------------------------------------------
+// --- configuration
+// -----------------------------------------------------------------------------
+/// Parameters of the synthetic data and of the processing.
+struct Config_t {
+
+  // --- data
+  unsigned int nFragments = 8U;
+  unsigned int nBoards = 9U;
+  unsigned int nChannels = 64U;
+  unsigned int nSamples = 4096U;
+  bool compressed = false;
+  float noiseRMS = 2.5f; ///< Incoherent noise [ADC]
+  float coherentRMS = 2.0f; ///< Noise common to a channel group [ADC]
+  unsigned int coherentGroup = 32U; ///< Channels sharing the coherent noise.
+  float occupancy = 0.05f; ///< Fraction of channels with a signal pulse.
+  unsigned int seed = 12345U;
+
+  // --- processing
+  std::vector<unsigned int> threads;
+  unsigned int repeat = 3U;
+  float sigmaForTruncation = 3.5f;
+  unsigned int coherentGrouping = 64U;
+  unsigned int structuringElement = 16U;
+  unsigned int morphWindow = 10U;
+  float threshold = 2.75f;
+
+}; // Config_t
+
+
+// -----------------------------------------------------------------------------
+std::optional<Config_t> parseCommandLine(int argc, char** argv) {
+
+  namespace po = boost::program_options;
+
+  Config_t config;
+
+  po::options_description dataopt("Synthetic data");
+  dataopt.add_options()
+    ("fragments", po::value(&config.nFragments)->default_value(config.nFragments),
+      "number of fragments (one readout crate each) per event")
+    ("boards", po::value(&config.nBoards)->default_value(config.nBoards),
+      "boards per fragment")
+    ("channels", po::value(&config.nChannels)->default_value(config.nChannels),
+      "channels per board")
+    ("samples", po::value(&config.nSamples)->default_value(config.nSamples),
+      "samples per channel")
+    ("compressed", po::bool_switch(&config.compressed),
+      "use the A2795 difference compression")
+    ("noise", po::value(&config.noiseRMS)->default_value(config.noiseRMS),
+      "incoherent noise RMS [ADC]")
+    ("coherent", po::value(&config.coherentRMS)->default_value(config.coherentRMS),
+      "coherent noise RMS [ADC]")
+    ("coherentgroup", po::value(&config.coherentGroup)->default_value(config.coherentGroup),
+      "channels sharing the same coherent noise")
+    ("occupancy", po::value(&config.occupancy)->default_value(config.occupancy),
+      "fraction of channels with a signal pulse")
+    ("seed", po::value(&config.seed)->default_value(config.seed),
+      "random seed for the data generation")
+    ;
+
+  po::options_description procopt("Processing");
+  procopt.add_options()
+    ("threads", po::value(&config.threads)->multitoken(),
+      "numbers of threads to benchmark (default: 1 and all available)")
+    ("repeat", po::value(&config.repeat)->default_value(config.repeat),
+      "times each measurement is repeated")
+    ("grouping", po::value(&config.coherentGrouping)->default_value(config.coherentGrouping),
+      "channels in a coherent noise removal group")
+    ("structuringelement", po::value(&config.structuringElement)->default_value(config.structuringElement),
+      "size of the morphological filter structuring element")
+    ("window", po::value(&config.morphWindow)->default_value(config.morphWindow),
+      "window of the morphological filter")
+    ("threshold", po::value(&config.threshold)->default_value(config.threshold),
+      "ROI threshold")
+    ;
+
+  po::options_description genopt("General");
+  genopt.add_options()
+    ("help,?", "print usage instructions and exit")
+    ("version,V", "print version and exit")
+    ;
+
+  po::options_description allopt("Options");
+  allopt.add(dataopt).add(procopt).add(genopt);
+
+  po::variables_map optmap;
+  po::store(po::parse_command_line(argc, argv, allopt), optmap);
+  po::notify(optmap);
+
+  std::optional<int> exitWithCode;
+  if (optmap.count("version")) {
+    std::cout << argv[0] << " version " << ProgramVersion << std::endl;
+    exitWithCode = 0;
+  }
+  if (optmap.count("help")) {
+    std::cout
+      <<   "Measures the performance of the TPC decoding and noise filtering"
+      << "\non synthetic data, for different numbers of threads."
+      << "\n" << allopt
+      << std::endl
+      ;
+    exitWithCode = 0;
+  }
+  if (exitWithCode) std::exit(*exitWithCode);
+
+  if (config.threads.empty()) {
+    config.threads.push_back(1U);
+    unsigned int const nCores = std::thread::hardware_concurrency();
+    if (nCores > 1U) config.threads.push_back(nCores);
+  }
+  if ((config.nChannels % config.coherentGrouping != 0)
+    || (config.nChannels % config.coherentGroup != 0))
+  {
+    std::cerr << "The channel groups (" << config.coherentGroup << " and "
+      << config.coherentGrouping << ") must divide the channels in a board ("
+      << config.nChannels << ")." << std::endl;
+    return std::nullopt;
+  }
+  if (config.repeat == 0U) {
+    std::cerr << "At least one measurement must be requested." << std::endl;
+    return std::nullopt;
+  }
+  if (config.nFragments * config.nBoards * config.nSamples == 0U) {
+    std::cerr << "No data to process!" << std::endl;
+    return std::nullopt;
+  }
+
+  return config;
+
+} // parseCommandLine()
+
+
+// -----------------------------------------------------------------------------
+// --- synthetic data
+// -----------------------------------------------------------------------------
+/// Returns a fragment with the layout of the TPC readout crates.
+artdaq::Fragment makeFragment
+  (Config_t const& config, unsigned int fragmentID, std::mt19937& engine)
+{
+  using namespace icarus::compression;
+
+  std::size_t const nChannels = config.nChannels;
+  std::size_t const nSamples = config.nSamples;
+  std::size_t const boardDataWords = nChannels * nSamples;
+  std::size_t const boardWords
+    = BoardHeaderWords + boardDataWords + BoardTrailerWords;
+
+  // no board ID in the metadata: it is memory-copied into the fragment
+  MetaData const metadata{ 1U, config.nBoards, config.nChannels,
+    config.nSamples, 12U, NoCompression, {} };
+
+  std::unique_ptr<artdaq::Fragment> fragment = artdaq::Fragment::FragmentBytes(
+    config.nBoards * boardWords * sizeof(uint16_t),
+    1U, fragmentID, artdaq::Fragment::FirstUserFragmentType, metadata
+    );
+  uint16_t* const payload
+    = reinterpret_cast<uint16_t*>(fragment->dataBeginBytes());
+  std::fill(payload, payload + config.nBoards * boardWords, 0U);
+
+  std::normal_distribution<float> noise{ 0.0f, config.noiseRMS };
+  std::normal_distribution<float> coherent{ 0.0f, config.coherentRMS };
+  std::uniform_real_distribution<float> flat{ 0.0f, 1.0f };
+
+  std::vector<float> common(nSamples);
+  for (std::size_t board = 0; board < config.nBoards; ++board) {
+    uint16_t* const boardData = payload + board * boardWords;
+
+    TileHeader* const header = reinterpret_cast<TileHeader*>(boardData);
+    header->board_id = board;
+    header->packSize = htonl(boardWords * sizeof(uint16_t));
+
+    uint16_t* const samples = boardData + BoardHeaderWords;
+    for (std::size_t channel = 0; channel < nChannels; ++channel) {
+
+      if (channel % config.coherentGroup == 0)
+        for (float& sample: common) sample = coherent(engine);
+
+      float const pedestal = 2048.0f + 20.0f * flat(engine);
+
+      // a track crossing the channel: a unipolar pulse some ticks wide
+      bool const hasSignal = flat(engine) < config.occupancy;
+      float const peakTime = flat(engine) * nSamples;
+      float const amplitude = 20.0f + 40.0f * flat(engine);
+      float const width = 3.0f + 10.0f * flat(engine);
+
+      for (std::size_t sample = 0; sample < nSamples; ++sample) {
+        float value = pedestal + common[sample] + noise(engine);
+        if (hasSignal) {
+          float const t = (sample - peakTime) / width;
+          if (std::abs(t) < 5.0f) value -= amplitude * std::exp(-0.5f * t * t);
+        }
+        samples[sample * nChannels + channel] = static_cast<uint16_t>
+          (std::clamp(std::round(value), 0.0f, 4095.0f));
+      } // for samples
+    } // for channels
+  } // for boards
+
+  return config.compressed? compressFragment(*fragment): std::move(*fragment);
+
+} // makeFragment()
+
+
+// -----------------------------------------------------------------------------
+// --- processing
+// -----------------------------------------------------------------------------
+/// The steps of the processing.
+enum Stage_t: unsigned int {
+  Unpack, Pedestal, Denoise, Output, NStages
+};
+
+std::array<char const*, NStages> const StageNames
+  { "unpack", "pedestal", "denoise", "output" };
+
+
+/// Time and allocations in each step, accumulated by one thread.
+struct StageStats_t {
+  std::array<double, NStages> seconds {}; ///< Time spent [s]
+  std::array<std::size_t, NStages> allocations {};
+  std::size_t nFragments = 0U;
+
+  StageStats_t& operator+= (StageStats_t const& other)
+    {
+      for (unsigned int stage = 0; stage < NStages; ++stage) {
+        seconds[stage] += other.seconds[stage];
+        allocations[stage] += other.allocations[stage];
+      }
+      nFragments += other.nFragments;
+      return *this;
+    }
+}; // StageStats_t
+
+
+/// Measures the time and allocations of a step, into a `StageStats_t`.
+class StageTimer {
+  using Clock_t = std::chrono::steady_clock;
+
+  StageStats_t& fStats;
+  Stage_t fStage;
+  Clock_t::time_point fStart;
+  std::size_t fStartAllocations;
+
+    public:
+  StageTimer(StageStats_t& stats, Stage_t stage)
+    : fStats{ stats }, fStage{ stage }
+    , fStart{ Clock_t::now() }, fStartAllocations{ NAllocations }
+    {}
+  ~StageTimer()
+    {
+      fStats.seconds[fStage]
+        += std::chrono::duration<double>(Clock_t::now() - fStart).count();
+      fStats.allocations[fStage] += NAllocations - fStartAllocations;
+    }
+}; // StageTimer
+
+
+/// Output data products.
+struct Products_t {
+  tbb::concurrent_vector<raw::RawDigit> rawDigits;
+  tbb::concurrent_vector<recob::ChannelROI> ROIs;
+
+  void clear() { rawDigits.clear(); ROIs.clear(); }
+}; // Products_t
+
+
+/// Buffers of a thread for the processing of one board, reused.
+struct Workspace_t {
+  icarus_signal_processing::ArrayFloat rawWaveforms;
+  icarus_signal_processing::ArrayFloat pedCorWaveforms;
+  icarus_signal_processing::ArrayFloat waveLessCoherent;
+  icarus_signal_processing::ArrayFloat morphedWaveforms;
+  icarus_signal_processing::ArrayFloat intrinsicRMS;
+  icarus_signal_processing::ArrayFloat correctedMedians;
+  icarus_signal_processing::ArrayBool selectVals;
+  icarus_signal_processing::ArrayBool ROIVals;
+  icarus_signal_processing::VectorFloat pedestalVals;
+  icarus_signal_processing::VectorFloat fullRMSVals;
+  icarus_signal_processing::VectorFloat truncRMSVals;
+  icarus_signal_processing::VectorInt numTruncBins;
+  icarus_signal_processing::VectorInt rangeBins;
+  icarus_signal_processing::VectorFloat thresholdVec;
+  icarus_signal_processing::FilterFunctionVec filterFunctionVec;
+  icarus_signal_processing::VectorFloat pedCorWaveform;
+  raw::RawDigit::ADCvector_t wvfm;
+
+  StageStats_t stats;
+
+  explicit Workspace_t(Config_t const& config)
+    {
+      std::size_t const nChannels = config.nChannels;
+      std::size_t const nSamples = config.nSamples;
+      icarus_signal_processing::VectorFloat const floats(nSamples);
+      icarus_signal_processing::VectorBool const bools(nSamples);
+      rawWaveforms.resize(nChannels, floats);
+      pedCorWaveforms.resize(nChannels, floats);
+      waveLessCoherent.resize(nChannels, floats);
+      morphedWaveforms.resize(nChannels, floats);
+      intrinsicRMS.resize(nChannels, floats);
+      correctedMedians.resize(nChannels, floats);
+      selectVals.resize(nChannels, bools);
+      ROIVals.resize(nChannels, bools);
+      pedestalVals.resize(nChannels);
+      fullRMSVals.resize(nChannels);
+      truncRMSVals.resize(nChannels);
+      numTruncBins.resize(nChannels);
+      rangeBins.resize(nChannels);
+      thresholdVec.resize(nChannels, config.threshold);
+      filterFunctionVec.resize(nChannels);
+      pedCorWaveform.resize(nSamples);
+      wvfm.resize(nSamples);
+    }
+}; // Workspace_t
+
+
+/// Processes all the boards of a fragment, like `DaqDecoderICARUSTPCwROI`.
+void processFragment(
+  Config_t const& config, artdaq::Fragment const& fragment,
+  Workspace_t& work, Products_t& products
+) {
+
+  StageStats_t& stats = work.stats;
+
+  std::optional<icarus::compression::FragmentBoardDecoder> boardDecoder;
+  {
+    StageTimer const timer{ stats, Unpack };
+    boardDecoder.emplace(fragment);
+  }
+  std::size_t const nChannels = boardDecoder->nChannelsPerBoard();
+  raw::ChannelID_t const firstChannel
+    = fragment.fragmentID() * boardDecoder->nBoards() * nChannels;
+
+  icarus_signal_processing::Denoiser1D denoiser;
+  icarus_signal_processing::WaveformTools<float> waveformTools(5);
+
+  for (std::size_t board = 0; board < boardDecoder->nBoards(); ++board) {
+
+    unsigned int const plane = board % 3;
+    raw::ChannelID_t const boardChannel = firstChannel + board * nChannels;
+
+    // --- unpack
+    {
+      StageTimer const timer{ stats, Unpack };
+      icarus_signal_processing::ArrayFloat& rawWaveforms = work.rawWaveforms;
+      boardDecoder->decodeBoard(board,
+        [&rawWaveforms,nChannels](std::size_t tick, uint16_t const* adcs)
+          {
+            for (std::size_t chanIdx = 0; chanIdx < nChannels; ++chanIdx)
+              rawWaveforms[chanIdx][tick] = -adcs[chanIdx];
+          }
+        );
+    }
+
+    // --- pedestal
+    {
+      StageTimer const timer{ stats, Pedestal };
+      for (std::size_t chanIdx = 0; chanIdx < nChannels; ++chanIdx) {
+
+        // the filter functions of TPCNoiseFilter1D ("e", "g", "d")
+        switch (plane) {
+          case 0:
+            work.filterFunctionVec[chanIdx]
+              = std::make_unique<icarus_signal_processing::Erosion1D>
+                (config.structuringElement);
+            break;
+          case 1:
+            work.filterFunctionVec[chanIdx]
+              = std::make_unique<icarus_signal_processing::Gradient1D>
+                (config.structuringElement);
+            break;
+          default:
+            work.filterFunctionVec[chanIdx]
+              = std::make_unique<icarus_signal_processing::Dilation1D>
+                (config.structuringElement);
+        } // switch
+
+        Eigen::Vector2f meanPos;
+        Eigen::Matrix2f eigenVectors {{0.,0.},{0.,0.}};
+        Eigen::Vector2f eigenValues {0.,0.};
+        waveformTools.principalComponents(work.rawWaveforms[chanIdx],
+          meanPos, eigenVectors, eigenValues, 6.);
+
+        waveformTools.getPedestalCorrectedWaveform(
+          work.rawWaveforms[chanIdx], work.pedCorWaveforms[chanIdx],
+          config.sigmaForTruncation,
+          work.pedestalVals[chanIdx], work.fullRMSVals[chanIdx],
+          work.truncRMSVals[chanIdx], work.numTruncBins[chanIdx],
+          work.rangeBins[chanIdx]
+          );
+
+        std::fill(work.selectVals[chanIdx].begin(),
+          work.selectVals[chanIdx].end(), false);
+      } // for channels
+    }
+
+    // --- denoise
+    {
+      StageTimer const timer{ stats, Denoise };
+      denoiser(work.waveLessCoherent.begin(),
+               work.pedCorWaveforms.begin(),
+               work.morphedWaveforms.begin(),
+               work.intrinsicRMS.begin(),
+               work.selectVals.begin(),
+               work.ROIVals.begin(),
+               work.correctedMedians.begin(),
+               work.filterFunctionVec.begin(),
+               work.thresholdVec,
+               nChannels,
+               config.coherentGrouping,
+               0,
+               config.morphWindow);
+    }
+
+    // --- output
+    {
+      StageTimer const timer{ stats, Output };
+
+      float localPedestal(0.);
+      float localFullRMS(0.);
+      float localTruncRMS(0.);
+      int   localNumTruncBins(0);
+      int   localRangeBins(0);
+
+      for (std::size_t chanIdx = 0; chanIdx < nChannels; ++chanIdx) {
+        raw::ChannelID_t const channel = boardChannel + chanIdx;
+
+        waveformTools.getPedestalCorrectedWaveform(
+          work.waveLessCoherent[chanIdx], work.pedCorWaveform,
+          config.sigmaForTruncation, localPedestal, localFullRMS,
+          localTruncRMS, localNumTruncBins, localRangeBins
+          );
+
+        std::transform(work.pedCorWaveform.begin(), work.pedCorWaveform.end(),
+          work.wvfm.begin(), [](float val){ return short(std::round(val)); });
+
+        auto const digit = products.rawDigits.emplace_back
+          (channel, work.wvfm.size(), work.wvfm);
+        digit->SetPedestal(localPedestal, localFullRMS);
+
+        icarus_signal_processing::VectorBool const& chanROIs
+          = work.ROIVals[chanIdx];
+        recob::ChannelROI::RegionsOfInterest_t ROIVec;
+        std::size_t roiIdx = 0;
+        while (roiIdx < chanROIs.size()) {
+          std::size_t const roiStartIdx = roiIdx;
+          while ((roiIdx < chanROIs.size()) && chanROIs[roiIdx]) ++roiIdx;
+          if (roiIdx > roiStartIdx) {
+            ROIVec.add_range(roiStartIdx, std::vector<short>(
+              work.wvfm.begin() + roiStartIdx, work.wvfm.begin() + roiIdx
+              ));
+          }
+          ++roiIdx;
+        } // while
+
+        products.ROIs.push_back
+          (recob::ChannelROICreator(std::move(ROIVec), channel).move());
+      } // for channels
+    }
+
+  } // for boards
+
+  ++stats.nFragments;
+
+} // processFragment()
+
+
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv) {
+
+  std::optional<Config_t> const maybeConfig = parseCommandLine(argc, argv);
+  if (!maybeConfig) return 1;
+  Config_t const& config = *maybeConfig;
+
+  //
+  // data generation
+  //
+  std::mt19937 engine{ config.seed };
+  std::vector<artdaq::Fragment> fragments;
+  std::size_t dataBytes = 0U;
+  for (unsigned int iFragment = 0; iFragment < config.nFragments; ++iFragment) {
+    fragments.push_back(makeFragment(config, iFragment, engine));
+    dataBytes += fragments.back().dataSizeBytes();
+  }
+  std::size_t const nChannels
+    = std::size_t(config.nFragments) * config.nBoards * config.nChannels;
+
+  std::cout << "Event of " << config.nFragments << " fragments, "
+    << config.nBoards << " boards x " << config.nChannels << " channels x "
+    << config.nSamples << " samples"
+    << (config.compressed? " (compressed)": "") << ": "
+    << (dataBytes / 1048576.0) << " MiB, " << nChannels << " channels."
+    << std::endl;
+
+  //
+  // benchmark
+  //
+  std::cout << "\n" << std::setw(7) << "threads"
+    << std::setw(12) << "event [ms]" << std::setw(10) << "MiB/s"
+    << std::setw(12) << "channels/s";
+  for (char const* name: StageNames) std::cout << std::setw(11) << name;
+  std::cout << " [ms/fragment]";
+  for (char const* name: StageNames) std::cout << std::setw(10) << name;
+  std::cout << " [allocations/fragment]" << std::endl;
+
+  std::optional<std::size_t> referenceROIs;
+  int exitCode = 0;
+  Products_t products;
+  for (unsigned int const nThreads: config.threads) {
+
+    tbb::global_control const threadLimit
+      { tbb::global_control::max_allowed_parallelism, nThreads };
+
+    tbb::enumerable_thread_specific<Workspace_t> workspaces
+      { [&config](){ return Workspace_t{ config }; } };
+
+    double bestTime = 0.0;
+    for (unsigned int iRepeat = 0; iRepeat <= config.repeat; ++iRepeat) {
+
+      products.clear();
+      products.rawDigits.reserve(nChannels);
+      products.ROIs.reserve(nChannels);
+
+      // the first pass warms up the workspaces and is not measured
+      if (iRepeat == 1U) for (Workspace_t& work: workspaces) work.stats = {};
+
+      auto const start = std::chrono::steady_clock::now();
+      tbb::parallel_for(tbb::blocked_range<std::size_t>(0, fragments.size(), 1),
+        [&](tbb::blocked_range<std::size_t> const& range)
+          {
+            Workspace_t& work = workspaces.local();
+            for (std::size_t i = range.begin(); i < range.end(); ++i)
+              processFragment(config, fragments[i], work, products);
+          }
+        );
+      double const time = std::chrono::duration<double>
+        (std::chrono::steady_clock::now() - start).count();
+      if ((iRepeat == 1U) || (time < bestTime)) bestTime = time;
+
+    } // for repeat
+
+    StageStats_t stats;
+    for (Workspace_t const& work: workspaces) stats += work.stats;
+
+    std::size_t nROIs = 0U;
+    for (recob::ChannelROI const& channelROI: products.ROIs)
+      nROIs += channelROI.SignalROI().n_ranges();
+    if (!referenceROIs) referenceROIs = nROIs;
+    else if (nROIs != *referenceROIs) {
+      std::cerr << "ERROR: " << nROIs << " ROIs found with " << nThreads
+        << " threads, " << *referenceROIs << " with " << config.threads.front()
+        << "." << std::endl;
+      exitCode = 1;
+    }
+
+    std::cout << std::fixed << std::setprecision(1)
+      << std::setw(7) << nThreads << std::setw(12) << (bestTime * 1000.0)
+      << std::setw(10) << (dataBytes / 1048576.0 / bestTime)
+      << std::setw(12) << std::setprecision(0) << (nChannels / bestTime)
+      << std::setprecision(2);
+    for (double const seconds: stats.seconds)
+      std::cout << std::setw(11) << (seconds * 1000.0 / stats.nFragments);
+    std::cout << "              ";
+    for (std::size_t const allocations: stats.allocations)
+      std::cout << std::setw(10) << (allocations / stats.nFragments);
+    std::cout << std::endl;
+
+  } // for threads
+
+  std::cout << "\n" << products.rawDigits.size() << " raw digits, "
+    << referenceROIs.value_or(0U) << " regions of interest." << std::endl;
+
+  return exitCode;
+
+} // main()
+
+
+// -----------------------------------------------------------------------------
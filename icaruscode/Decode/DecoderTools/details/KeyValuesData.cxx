@@ -34,7 +34,7 @@ auto icarus::KeyValuesData::makeOrFetchItem(std::string const& key) -> Item& {
 
 // -----------------------------------------------------------------------------
 auto icarus::KeyValuesData::findItem
-  (std::string const& key) const noexcept -> Item const*
+  (std::string_view key) const noexcept -> Item const*
 {
   for (auto const& item: fItems) if (key == item.key()) return &item;
   return nullptr;
@@ -43,7 +43,7 @@ auto icarus::KeyValuesData::findItem
 
 // -----------------------------------------------------------------------------
 auto icarus::KeyValuesData::findItem
-  (std::string const& key) noexcept -> Item*
+  (std::string_view key) noexcept -> Item*
 {
   // no violations here: this is a non-const method, with the right to modify
   // object data; and this avoids code duplication.
@@ -52,17 +52,17 @@ auto icarus::KeyValuesData::findItem
 
 
 // -----------------------------------------------------------------------------
-auto icarus::KeyValuesData::getItem(std::string const& key) const
+auto icarus::KeyValuesData::getItem(std::string_view key) const
   -> Item const&
 {
   if (auto item = findItem(key); item) return *item;
-  throw ItemNotFound(key);
+  throw ItemNotFound(std::string{ key });
 } // icarus::KeyValuesData<>::getItem()
 
 
 // -----------------------------------------------------------------------------
 bool icarus::KeyValuesData::hasItem
-  (std::string const& key) const noexcept
+  (std::string_view key) const noexcept
 {
   return findItem(key);
 } // icarus::KeyValuesData<>::hasItem()
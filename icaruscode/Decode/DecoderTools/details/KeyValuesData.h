@@ -65,7 +65,7 @@ namespace icarus {
  * conversion).
  * 
  * Each converter object specialization for a type `T` should support a call
- * with argument `std::string` returning a `std::optional<T>`.
+ * with argument `std::string_view` returning a `std::optional<T>`.
  * 
  * 
  * Initialization and updates
@@ -152,7 +152,7 @@ namespace icarus {
  * is supported.
  * 
  * Each converter object specialization for a type `T` should support a call
- * with argument `std::string` returning a `std::optional<T>`.
+ * with argument `std::string_view` returning a `std::optional<T>`.
  * 
  */
 struct icarus::KeyValuesData {
@@ -478,7 +478,7 @@ struct icarus::KeyValuesData {
 
     /// Conversion functions.
     template <typename T>
-    std::optional<T> convertStringInto(std::string const& valueStr) const
+    std::optional<T> convertStringInto(std::string_view valueStr) const
       { return icarus::details::KeyValuesConverter<T>{}(valueStr); }
     
   }; // struct Item
@@ -497,7 +497,7 @@ struct icarus::KeyValuesData {
   Item& makeOrFetchItem(std::string const& key);
   
   /// Returns the item with specified `key`, `nullptr` if none.
-  Item* findItem(std::string const& key) noexcept;
+  Item* findItem(std::string_view key) noexcept;
   
   /// @}
   // --- END ---- Setter interface ---------------------------------------------
@@ -508,13 +508,13 @@ struct icarus::KeyValuesData {
   /// @{
   
   /// Returns the item with specified `key`, `nullptr` if none.
-  Item const* findItem(std::string const& key) const noexcept;
+  Item const* findItem(std::string_view key) const noexcept;
   
   /// Returns the item with specified `key`, throws `std::out_of_range` if none.
-  Item const& getItem(std::string const& key) const;
+  Item const& getItem(std::string_view key) const;
   
   /// Returns whether an item with the specified key is present.
-  bool hasItem(std::string const& key) const noexcept;
+  bool hasItem(std::string_view key) const noexcept;
   
   /// Returns whether there is no item in data.
   bool empty() const noexcept;
@@ -817,10 +817,10 @@ struct icarus::details::KeyValuesConverter {
   //@{
   /// Convert a string `s` into a type `T`;
   /// may return `std::nullopt` on "non-fatal" failure.
-  std::optional<T> operator() (std::string const& s) const
+  std::optional<T> operator() (std::string_view s) const
     { return convert(s); }
   
-  static std::optional<T> convert(std::string const& s)
+  static std::optional<T> convert(std::string_view s)
     {
       if constexpr (std::is_arithmetic_v<T>) {
         T number {}; // useless initialization to avoid GCC complains
@@ -828,9 +828,12 @@ struct icarus::details::KeyValuesConverter {
         return (std::from_chars(b, e, number).ptr == e)
           ? std::make_optional(number): std::nullopt;
       }
-      else if constexpr(std::is_constructible_v<T, std::string>){
+      else if constexpr(std::is_constructible_v<T, std::string_view>){
         return std::make_optional(T{ s });
       }
+      else if constexpr(std::is_constructible_v<T, std::string>){
+        return std::make_optional(T{ std::string{ s } });
+      }
       else return std::nullopt;
     } // convert()
   
@@ -850,10 +853,10 @@ struct icarus::details::KeyValuesConverter
   //@{
   /// Convert a string `s` into a numerical type `T` from the specified `base`;
   /// may return `std::nullopt` on "non-fatal" failure.
-  std::optional<T> operator() (std::string const& s) const
+  std::optional<T> operator() (std::string_view s) const
     { return convert(s); }
   
-  std::optional<T> convert(std::string const& s) const
+  std::optional<T> convert(std::string_view s) const
     {
       T number {}; // useless initialization to avoid GCC complains
       char const *b = s.data(), *e = b + s.length();
@@ -904,13 +907,13 @@ struct icarus::details::KeyValuesConverter
   <T, std::enable_if_t<std::is_floating_point_v<T>>>
 {
   
-  std::optional<T> operator() (std::string const& s) const
+  std::optional<T> operator() (std::string_view s) const
     { return convert(s); }
   
-  static std::optional<T> convert(std::string const& s)
+  static std::optional<T> convert(std::string_view s)
     {
       T number {}; // useless initialization to avoid GCC complains
-      std::istringstream sstr{ s };
+      std::istringstream sstr{ std::string{ s } };
       sstr >> number;
       // check that no non-space character is left in the stream
       return (sstr && (sstr >> std::ws).eof())
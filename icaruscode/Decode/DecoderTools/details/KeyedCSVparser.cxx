@@ -20,7 +20,13 @@
 // -----------------------------------------------------------------------------
 void icarus::details::KeyedCSVparser::parse
   (std::string_view const& s, ParsedData_t& data) const
-{
+  { parse(s, data, ItemCallback_t{}); }
+
+
+// -----------------------------------------------------------------------------
+void icarus::details::KeyedCSVparser::parse(
+  std::string_view const& s, ParsedData_t& data, ItemCallback_t const& onItem
+) const {
   
   auto stream = s;
   
@@ -33,8 +39,6 @@ void icarus::details::KeyedCSVparser::parse
     
     auto const token = extractToken(stream);
     
-    std::string tokenStr { cbegin(token), cend(token) };
-    
     bool bKey = false;
     do {
       
@@ -50,38 +54,13 @@ void icarus::details::KeyedCSVparser::parse
       
       // the token may still be a key (if `bKey` is true, it is for sure: we can
       // decide that a non-key (!bKey) is actually a key, but not the opposite)
-      for (auto const& [ pattern, values ]: fPatterns) {
-        if (!std::regex_match(begin(token), end(token), pattern)) continue;
-        bKey = true; // matching a pattern implies this is a key
-        std::string const& key = tokenStr;
-        // how many values to expect:
-        switch (values) {
-          case FixedSize: // read the next token immediately as fixed size
-            {
-              if (stream.empty()) throw MissingSize(key);
-              
-              auto const sizeToken = peekToken(stream);
-              if (empty(sizeToken)) throw MissingSize(key);
-              
-              // the value is loaded in `forcedValues` and already excludes
-              // the size token just read
-              char const *b = begin(sizeToken), *e = end(sizeToken);
-              if (std::from_chars(b, e, forcedValues).ptr != e)
-                throw MissingSize(key, std::string{ sizeToken });
-              
-              ++forcedValues; // the size will be forced in the values anyway
-              
-            } // FixedSize
-            break;
-          case DynamicSize:
-            // nothing to do, the normal algorithm rules will follow
-            break;
-          default:
-            forcedValues = values;
-            break;
-        } // switch
+      if (std::optional<unsigned int> const values = knownKeyValues(token)) {
+        bKey = true; // matching a known key or pattern implies this is a key
+        // DynamicSize: the normal algorithm rules will follow
+        if (*values != DynamicSize)
+          forcedValues = forcedValueCount(token, *values, stream);
         break;
-      } // for pattern
+      }
       if (bKey) break;
       
       // let the "standard" pattern decide
@@ -89,14 +68,18 @@ void icarus::details::KeyedCSVparser::parse
       
     } while (false);
     
-    if (bKey) currentItem = &(data.makeItem(std::move(tokenStr)));
+    if (bKey) {
+      // the previous item is complete
+      if (currentItem && onItem) onItem(*currentItem);
+      currentItem = &(data.makeItem(std::string{ token }));
+    }
     else {
       if (!currentItem) {
-        throw InvalidFormat(
-         "values started without a key ('" + tokenStr + "' is not a valid key)."
+        throw InvalidFormat("values started without a key ('"
+          + std::string{ token } + "' is not a valid key)."
          );
       }
-      currentItem->addValue(std::move(tokenStr));
+      currentItem->addValue(token);
     }
     
   } // while
@@ -106,6 +89,8 @@ void icarus::details::KeyedCSVparser::parse
     throw MissingValues(currentItem->key(), forcedValues);
   }
   
+  if (currentItem && onItem) onItem(*currentItem);
+  
 } // icarus::KeyedCSVparser::parse()
 
 
@@ -130,6 +115,52 @@ auto icarus::details::KeyedCSVparser::addPatterns
 } // icarus::details::KeyedCSVparser::addPatterns()
 
 
+// -----------------------------------------------------------------------------
+auto icarus::details::KeyedCSVparser::addKeys
+  (std::initializer_list<std::pair<std::string, unsigned int>> keys)
+  -> KeyedCSVparser&
+{
+  for (auto& key: keys) fKeys.emplace_back(key);
+  return *this;
+} // icarus::details::KeyedCSVparser::addKeys()
+
+
+// -----------------------------------------------------------------------------
+auto icarus::details::KeyedCSVparser::knownKeyValues
+  (SubBuffer_t const& token) const -> std::optional<unsigned int>
+{
+  for (auto const& [ key, values ]: fKeys)
+    if (token == key) return values;
+  
+  for (auto const& [ pattern, values ]: fPatterns)
+    if (std::regex_match(begin(token), end(token), pattern)) return values;
+  
+  return std::nullopt;
+} // icarus::details::KeyedCSVparser::knownKeyValues()
+
+
+// -----------------------------------------------------------------------------
+int icarus::details::KeyedCSVparser::forcedValueCount
+  (SubBuffer_t const& key, unsigned int values, Buffer_t const& stream) const
+{
+  if (values != FixedSize) return values;
+  
+  // read the next token immediately as fixed size
+  if (stream.empty()) throw MissingSize(std::string{ key });
+  
+  auto const sizeToken = peekToken(stream);
+  if (empty(sizeToken)) throw MissingSize(std::string{ key });
+  
+  // the value excludes the size token just read...
+  int forcedValues = -1;
+  char const *b = begin(sizeToken), *e = end(sizeToken);
+  if (std::from_chars(b, e, forcedValues).ptr != e)
+    throw MissingSize(std::string{ key }, std::string{ sizeToken });
+  
+  return forcedValues + 1; // ... but the size will be forced in the values too
+} // icarus::details::KeyedCSVparser::forcedValueCount()
+
+
 // -----------------------------------------------------------------------------
 auto icarus::details::KeyedCSVparser::parse
   (std::string const& s) const -> ParsedData_t
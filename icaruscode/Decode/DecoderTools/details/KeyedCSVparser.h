@@ -18,6 +18,7 @@
 #include <vector>
 #include <string>
 #include <optional>
+#include <functional> // std::function
 #include <regex>
 #include <initializer_list>
 #include <stdexcept> // std::runtime_error
@@ -64,6 +65,16 @@ namespace icarus::details { class KeyedCSVparser; }
  *   );
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  * will return `data` with 6 items.
+ * 
+ * Keys which are known exactly can be registered with `addKey()` instead than
+ * with a pattern: their match is a plain string comparison, which is much
+ * cheaper than a regular expression match. Since known keys and patterns are
+ * tested on (almost) every token, a parser meant to be used many times should
+ * be configured once and then reused.
+ * 
+ * The parsing itself is a single pass on the buffer, and tokens are handled as
+ * views into it: memory is allocated only to store keys and values in the
+ * output `KeyValuesData`.
  */
 class icarus::details::KeyedCSVparser {
   
@@ -71,6 +82,9 @@ class icarus::details::KeyedCSVparser {
   
   using ParsedData_t = icarus::KeyValuesData;
   
+  /// Type of function called on each item as soon as it is parsed.
+  using ItemCallback_t = std::function<void(ParsedData_t::Item const&)>;
+  
   /// Base of all errors by KeyedCSVparser.
   using Error = icarus::KeyValuesData::Error;
   using ErrorOnKey = icarus::KeyValuesData::ErrorOnKey;
@@ -106,6 +120,20 @@ class icarus::details::KeyedCSVparser {
   //@{
   /// Parses the buffer `s` and fills `data` with it.
   void parse(std::string_view const& s, ParsedData_t& data) const;
+  
+  /**
+   * @brief Parses the buffer `s`, fills `data` with it and reports each item.
+   * @param s the buffer to be parsed
+   * @param data the data structure to be filled
+   * @param onItem function called on each item, once all its values are in
+   * 
+   * This allows users to extract information from each item (e.g. to convert
+   * it into numbers) in the same pass over the buffer, without looking up
+   * the items in `data` later.
+   */
+  void parse
+    (std::string_view const& s, ParsedData_t& data, ItemCallback_t const& onItem)
+    const;
   //@}
   
   /**
@@ -158,6 +186,32 @@ class icarus::details::KeyedCSVparser {
     (std::initializer_list<std::pair<std::string, unsigned int>> patterns);
   //@}
   
+  //@{
+  /**
+   * @brief Adds a single known key.
+   * @param key the exact (stripped) token to be considered this key
+   * @param values the number of values for this key
+   * @return this parser (`addKey()` calls may be chained)
+   * 
+   * This is the same as `addPattern()` with a pattern matching only `key`.
+   * Known keys are tested before any pattern, and in the order they were added.
+   */
+  KeyedCSVparser& addKey(std::string key, unsigned int values)
+    { fKeys.emplace_back(std::move(key), values); return *this; }
+  //@}
+  
+  //@{
+  /**
+   * @brief Adds known keys.
+   * @param keys sequence of keys to be added
+   * @return this parser (`addKeys()` calls may be chained)
+   * 
+   * Each key is a pair key/number of values, like in `addKey()`.
+   */
+  KeyedCSVparser& addKeys
+    (std::initializer_list<std::pair<std::string, unsigned int>> keys);
+  //@}
+  
   /// @}
   
     private:
@@ -169,6 +223,17 @@ class icarus::details::KeyedCSVparser {
   /// List of known patterns for matching keys, and how many values they hold.
   std::vector<std::pair<std::regex, unsigned int>> fPatterns;
   
+  /// List of known keys, and how many values they hold.
+  std::vector<std::pair<std::string, unsigned int>> fKeys;
+  
+  /// Returns the number of values of a known key or pattern matching `token`.
+  std::optional<unsigned int> knownKeyValues
+    (SubBuffer_t const& token) const;
+  
+  /// Returns how many of the next tokens are forced as values of `key`.
+  int forcedValueCount
+    (SubBuffer_t const& key, unsigned int values, Buffer_t const& stream) const;
+  
   /// Returns the length of the next toke, up to the next separator (excluded).
   std::size_t findTokenLength(Buffer_t const& buffer) const noexcept;
 
@@ -0,0 +1,91 @@
+/**
+ * @file   icaruscode/Decode/DecoderTools/details/TriggerDataParserV3.cxx
+ * @brief  Parser of the data packet of the trigger fragments (implementation).
+ * @date   October 19, 2026
+ * @see    icaruscode/Decode/DecoderTools/details/TriggerDataParserV3.h
+ */
+
+// library header
+#include "icaruscode/Decode/DecoderTools/details/TriggerDataParserV3.h"
+
+// C++ standard libraries
+#include <string>
+#include <type_traits> // std::decay_t
+
+
+// -----------------------------------------------------------------------------
+// ---  icarus::details::TriggerDataParserV3
+// -----------------------------------------------------------------------------
+std::array<std::string_view, 8U> const
+icarus::details::TriggerDataParserV3::TriggerInfoKeys {
+    "WR_TS1", "Gate ID", "Gate Type", "BNB Gate ID", "NuMI Gate ID"
+  , "Offbeam BNB Gate ID", "Offbeam NuMI Gate ID", "Trigger Type"
+  };
+
+
+// -----------------------------------------------------------------------------
+icarus::details::TriggerDataParserV3::TriggerDataParserV3()
+  : fCSVparser{ makeCSVparser() }
+  {}
+
+
+// -----------------------------------------------------------------------------
+auto icarus::details::TriggerDataParserV3::operator()
+  (std::string_view dataLine) const -> Parsed_t
+{
+  Parsed_t parsed;
+  fCSVparser.parse(dataLine, parsed.data,
+    [&info=parsed.info](icarus::KeyValuesData::Item const& item)
+      { fillTriggerInfo(info, item); }
+    );
+  for (std::string_view const key: TriggerInfoKeys) {
+    if (!parsed.data.hasItem(key))
+      throw icarus::KeyValuesData::ItemNotFound(std::string{ key });
+  }
+  return parsed;
+} // icarus::details::TriggerDataParserV3::operator()
+
+
+// -----------------------------------------------------------------------------
+void icarus::details::TriggerDataParserV3::fillTriggerInfo
+  (icarus::ICARUSTriggerInfo& info, icarus::KeyValuesData::Item const& item)
+{
+  auto const setNumber = [&item](auto& field)
+    { field = item.getNumber<std::decay_t<decltype(field)>>(0); };
+
+  // keep in sync with `TriggerInfoKeys`
+  std::string const& key = item.key();
+  if      (key == "WR_TS1")               setNumber(info.wr_event_no);
+  else if (key == "Gate ID")              setNumber(info.gate_id);
+  else if (key == "Gate Type")            setNumber(info.gate_type);
+  else if (key == "BNB Gate ID")          setNumber(info.gate_id_BNB);
+  else if (key == "NuMI Gate ID")         setNumber(info.gate_id_NuMI);
+  else if (key == "Offbeam BNB Gate ID")  setNumber(info.gate_id_BNBOff);
+  else if (key == "Offbeam NuMI Gate ID") setNumber(info.gate_id_NuMIOff);
+  else if (key == "Trigger Type")         setNumber(info.trigger_type);
+} // icarus::details::TriggerDataParserV3::fillTriggerInfo()
+
+
+// -----------------------------------------------------------------------------
+icarus::details::KeyedCSVparser
+icarus::details::TriggerDataParserV3::makeCSVparser()
+{
+  /*
+   * The connector keys used to be matched by the regular expression
+   * "Cryo. (EAST|WEST) Connector . and ."; the keys are listed explicitly
+   * to spare a regular expression match on every token of every event.
+   * Their values are hexadecimal and may start with a letter.
+   */
+  icarus::details::KeyedCSVparser parser;
+  parser.addKeys({
+      { "Cryo1 EAST Connector 0 and 1", 1U }
+    , { "Cryo1 EAST Connector 2 and 3", 1U }
+    , { "Cryo2 WEST Connector 0 and 1", 1U }
+    , { "Cryo2 WEST Connector 2 and 3", 1U }
+    , { "Trigger Type", 1U }
+    });
+  return parser;
+} // icarus::details::TriggerDataParserV3::makeCSVparser()
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,86 @@
+/**
+ * @file   icaruscode/Decode/DecoderTools/details/TriggerDataParserV3.h
+ * @brief  Parser of the data packet of the trigger fragments (version 3).
+ * @date   October 19, 2026
+ * @see    icaruscode/Decode/DecoderTools/details/TriggerDataParserV3.cxx
+ */
+
+#ifndef ICARUSCODE_DECODE_DECODERTOOLS_DETAILS_TRIGGERDATAPARSERV3_H
+#define ICARUSCODE_DECODE_DECODERTOOLS_DETAILS_TRIGGERDATAPARSERV3_H
+
+// ICARUS libraries
+#include "icaruscode/Decode/DecoderTools/details/KeyedCSVparser.h"
+#include "icaruscode/Decode/DecoderTools/details/KeyValuesData.h"
+#include "sbndaq-artdaq-core/Overlays/ICARUS/ICARUSTriggerV3Fragment.hh"
+
+// C++ standard libraries
+#include <array>
+#include <string_view>
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::details { class TriggerDataParserV3; }
+/**
+ * @class icarus::details::TriggerDataParserV3
+ * @brief Parses the data packet of a trigger fragment in the V3 format.
+ *
+ * The data packet is a single line of comma-separated keys and values, e.g.
+ * `"WR_TS1, 0000000012, 1654629426, 359093500, Gate ID, 0000000034, ..."`.
+ * It is parsed only once, with a `KeyedCSVparser` configured at construction:
+ * all the items are stored in a `KeyValuesData`, and the ones the decoder
+ * needs in a `icarus::ICARUSTriggerInfo` are converted as soon as each of them
+ * is complete.
+ *
+ * This replaces `icarus::parse_ICARUSTriggerV3String()` from
+ * `sbndaq-artdaq-core`, which would parse the same packet a second time.
+ * Only the fields listed in `TriggerInfoKeys` are filled; the others keep
+ * their default value.
+ *
+ * A packet missing any of the `TriggerInfoKeys` is an error, reported with an
+ * exception derived from `icarus::KeyValuesData::Error`, as are the values
+ * which can't be converted.
+ */
+class icarus::details::TriggerDataParserV3 {
+
+    public:
+
+  /// Content of the trigger data packet.
+  struct Parsed_t {
+    icarus::ICARUSTriggerInfo info; ///< Information used by the decoder.
+    icarus::KeyValuesData data; ///< All the items of the packet.
+  };
+
+  /// Keys of all the items which `fillTriggerInfo()` uses.
+  static std::array<std::string_view, 8U> const TriggerInfoKeys;
+
+
+  /// Configures the parser.
+  TriggerDataParserV3();
+
+  /**
+   * @brief Parses the data packet `dataLine`.
+   * @param dataLine the first line of the data packet
+   * @return the parsed information
+   * @throw icarus::KeyValuesData::Error (or derived) on parsing errors
+   */
+  Parsed_t operator() (std::string_view dataLine) const;
+
+  /// Sets the field of `info` the `item` is about, if any.
+  static void fillTriggerInfo
+    (icarus::ICARUSTriggerInfo& info, icarus::KeyValuesData::Item const& item);
+
+
+    private:
+
+  /// Parser of the trigger data packet.
+  icarus::details::KeyedCSVparser const fCSVparser;
+
+  /// Returns a CSV parser configured for the trigger data packet.
+  static icarus::details::KeyedCSVparser makeCSVparser();
+
+}; // icarus::details::TriggerDataParserV3
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSCODE_DECODE_DECODERTOOLS_DETAILS_TRIGGERDATAPARSERV3_H
@@ -345,10 +345,7 @@ void FilterNoiseICARUS::processSingleFragment(size_t                         idx
     //process_fragment(event, rawfrag, product_collection, header_collection);
     decoderTool->process_fragment(clockData, *fragmentPtr);
 
-    // Useful numerology
-    // convert fragment to Nevis fragment
-    icarus::PhysCrateFragment physCrateFragment(*fragmentPtr);
-
+    // Useful numerology (the fragment may be compressed: do not use a PhysCrateFragment overlay on it)
 //    size_t nBoardsPerFragment = physCrateFragment.nBoards();
 //    size_t nChannelsPerBoard  = physCrateFragment.nChannelsPerBoard();
 
@@ -63,15 +63,21 @@
  *  The units in LArSoft are cm for distances and ns for time.
  *  The use of `TLorentzVector` below does not imply space and time have the same units
  *   (do not use `TLorentzVector::Boost()`).
+ *
+ *  The file is read by `evgen::HepMCTextReader`. Configuration parameters:
+ *  * `InputFilePath` (string, mandatory): path to the input file, relative to
+ *    `FW_SEARCH_PATH`; files under `/pnfs/` are fetched via IFDH.
+ *  * `EventsPerPOT` (real, default: `-1`): events per POT, for the subrun
+ *    POT summary.
+ *  * `SkipEvents` (integer, default: `0`): the first event generated is the
+ *    one with this index in the file (e.g. to split a file among jobs);
+ *    the skipped events are not parsed.
+ *  * `MemoryMap` (flag, default: `false`): map the input file in memory
+ *    instead of reading it through a buffer.
  */
+#include "icaruscode/Generators/HepMCTextReader.h"
 #include <string>
-#include <fstream>
-#include <math.h>
-#include <map>
-#include <iomanip>
-#include <algorithm>
-#include <sstream>
-#include <glob.h>
+#include <memory>
 #include <cstdlib>  // for unsetenv()
 #include "art/Framework/Core/EDProducer.h"
 #include "art/Framework/Core/ModuleMacros.h"
@@ -106,9 +112,12 @@ public:
   void beginRun(art::Run & run)                   override;
   void endSubRun(art::SubRun& sr)     override;
 private:
-  std::ifstream open_file();
+  std::unique_ptr<HepMCTextReader> open_file();
   std::string fInputFilePath; ///< Path to the HEPMC input file, relative to `FW_SEARCH_PATH`.
-  std::ifstream* fInputFile;
+  std::size_t    fSkipEvents;       ///< Number of events to skip at the start of the file.
+  bool           fMemoryMap;        ///< Whether to map the input file in memory.
+  std::unique_ptr<HepMCTextReader> fInputFile; ///< Reader of the input file.
+  HepMCTextReader::Event_t fEvent;  ///< Record of the event being read (reused).
   
   double         fEventsPerPOT;     ///< Number of events per POT (to be set)
   int            fEventsPerSubRun;  ///< Keeps track of the number of processed events per subrun
@@ -118,7 +127,8 @@ private:
 evgen::HepMCFileGen::HepMCFileGen(fhicl::ParameterSet const & p)
   : EDProducer{p}
   , fInputFilePath(p.get<std::string>("InputFilePath"))
-  , fInputFile(nullptr)
+  , fSkipEvents(p.get<std::size_t>("SkipEvents", 0U))
+  , fMemoryMap(p.get<bool>("MemoryMap", false))
   , fEventsPerPOT{p.get<double>("EventsPerPOT", -1.)}
   , fEventsPerSubRun(0)
 {
@@ -128,7 +138,7 @@ evgen::HepMCFileGen::HepMCFileGen(fhicl::ParameterSet const & p)
 }
 //------------------------------------------------------------------------------
 
-std::ifstream evgen::HepMCFileGen::open_file()
+std::unique_ptr<evgen::HepMCTextReader> evgen::HepMCFileGen::open_file()
 {
   /*
    * The plan:
@@ -163,12 +173,14 @@ std::ifstream evgen::HepMCFileGen::open_file()
   //
   mf::LogDebug("HepMCFileGen")
     << "Reading input file '" << fInputFilePath << "' as:\n" << fullFileName;
-  std::ifstream inputFile(fullFileName);
-  if (inputFile) return inputFile;
-  
-  // all attempts failed, give up:
-  throw cet::exception("HepMCFileGen")
-    << "HEPMC input file '" << fInputFilePath << "' can't be opened.\n";
+  try {
+    return std::make_unique<HepMCTextReader>(fullFileName, fMemoryMap);
+  }
+  catch (cet::exception const& e) {
+    // all attempts failed, give up:
+    throw cet::exception("HepMCFileGen", "", e)
+      << "HEPMC input file '" << fInputFilePath << "' can't be opened.\n";
+  }
   
 } // evgen::HepMCFileGen::open_file()
 
@@ -177,7 +189,19 @@ std::ifstream evgen::HepMCFileGen::open_file()
 //------------------------------------------------------------------------------
 void evgen::HepMCFileGen::beginJob()
 {
-  fInputFile = new std::ifstream(open_file());
+  fInputFile = open_file();
+  
+  if (fSkipEvents > 0U) {
+    if (!fInputFile->skipEvents(fSkipEvents)) {
+      throw cet::exception("HepMCFileGen")
+        << "HEPMC input file '" << fInputFilePath << "' has only "
+        << fInputFile->nextEvent() << " events, can't skip " << fSkipEvents
+        << ".\n";
+    }
+    mf::LogInfo("HepMCFileGen")
+      << "Skipped the first " << fSkipEvents << " events of '"
+      << fInputFilePath << "'.";
+  }
   
 }
 //------------------------------------------------------------------------------
@@ -199,72 +223,38 @@ void evgen::HepMCFileGen::endSubRun(art::SubRun& sr)
 //------------------------------------------------------------------------------
 void evgen::HepMCFileGen::produce(art::Event & e)
 {
-  // check that the file is still good
-  if( !fInputFile->good() || fInputFile->peek() == EOF) {
-    open_file();
-  }
-  if( !fInputFile->good() || fInputFile->peek() == EOF) {
-    throw cet::exception("HepMCFileGen") << "input text file "
-                                        << " cannot be read in produce().\n";
+  // read the next event record;
+  // only particles with status = 1 get tracked in Geant4. see GENIE GHepStatus
+  if (!fInputFile->readEvent(fEvent)) {
+    throw cet::exception("HepMCFileGen") << "input text file '"
+      << fInputFile->fileName() << "' has no more events after "
+      << fInputFile->nextEvent() << " in produce().\n";
   }
   std::unique_ptr< std::vector<simb::MCTruth> > truthcol(new std::vector<simb::MCTruth>);
   simb::MCTruth truth;
-  // declare the variables for reading in the event record
-  int            event          = 0;
-  unsigned short nParticles           = 0;
-  int            status         = 0;
-  int                   pdg            = 0;
-  int                   firstMother    = 0;
-  int                   secondMother   = 0;
-  int                   firstDaughter  = 0;
-  int                   secondDaughter = 0;
-  double          xMomentum      = 0.;
-  double          yMomentum           = 0.;
-  double          zMomentum           = 0.;
-  double          energy              = 0.;
-  double          mass                = 0.;
-  double          xPosition           = 0.;
-  double          yPosition           = 0.;
-  double          zPosition           = 0.;
-  double          time                = 0.;
   bool set_neutrino = false;
   // neutrino
   int ccnc = -1, mode = -1, itype = -1, target = -1, nucleon = -1, quark = -1;
   double w = -1, x = -1, y = -1, qsqr = -1;
-  // read in line to get event number and number of particles
-  std::string oneLine;
-  std::getline(*fInputFile, oneLine);
-  std::istringstream inputLine;
-  inputLine.str(oneLine);
-  inputLine >> event >> nParticles;
-  // now read in all the lines for the particles
-  // in this interaction. only particles with
-  // status = 1 get tracked in Geant4. see GENIE GHepStatus
-  for(unsigned short i = 0; i < nParticles; ++i){
-    std::getline(*fInputFile, oneLine);
-    inputLine.clear();
-    inputLine.str(oneLine);
-    inputLine >> status >> pdg
-              >> firstMother >> secondMother >> firstDaughter >> secondDaughter
-              >> xMomentum   >> yMomentum    >> zMomentum     >> energy >> mass
-              >> xPosition   >> yPosition    >> zPosition     >> time;
-    std::cout<<"pdg_all"<<pdg<<"xmomentum_all"<<xMomentum<<"ymomentum_all"<<yMomentum<<"zposition_all"<<zPosition<<std::endl;
-    TLorentzVector pos(xPosition, yPosition, zPosition, time);
-    TLorentzVector mom(xMomentum, yMomentum, zMomentum, energy);
-    simb::MCParticle part(i, pdg, "primary", firstMother, mass, status);
+  for(std::size_t i = 0; i < fEvent.particles.size(); ++i){
+    HepMCTextReader::Particle_t const& particle = fEvent.particles[i];
+    TLorentzVector pos(particle.xPosition, particle.yPosition, particle.zPosition, particle.time);
+    TLorentzVector mom(particle.xMomentum, particle.yMomentum, particle.zMomentum, particle.energy);
+    simb::MCParticle part(i, particle.pdg, "primary", particle.firstMother, particle.mass, particle.status);
     part.AddTrajectoryPoint(pos, mom);
     //if (abs(pdg) == 18 || abs(pdg) == 12) 
-    if (abs(pdg) == 52 )  // Animesh made changes
+    if (std::abs(particle.pdg) == 52 )  // Animesh made changes
 	{
       set_neutrino = true;
-      ccnc = firstDaughter; // for the neutrino we write ccnc in place of 1st daugther
-      mode = secondDaughter; // for the neutrino we write mode in place of 2nd daugther
+      ccnc = particle.firstDaughter; // for the neutrino we write ccnc in place of 1st daugther
+      mode = particle.secondDaughter; // for the neutrino we write mode in place of 2nd daugther
       itype = -1;
       target = nucleon = quark = w = x = y = qsqr = -1;
-     std::cout<<"pdg_mother"<<pdg<<"xmomentum_mother"<<xMomentum<<"ymomentum_mother"<<yMomentum<<"zposition_mother"<<zPosition<<std::endl;
     } 
     truth.Add(part);
-     std::cout << i << "  Particle added with Pdg " << part.PdgCode() << ", Mother " << part.Mother() << ", track id " << part.TrackId() << ", ene " << part.E() << std::endl;
+    mf::LogDebug("HepMCFileGen") << i << "  Particle added with Pdg " << part.PdgCode()
+      << ", Mother " << part.Mother() << ", track id " << part.TrackId() << ", ene " << part.E()
+      << ", position z " << particle.zPosition;
   }
  
   if (set_neutrino) {
@@ -0,0 +1,393 @@
+/**
+ * @file   icaruscode/Generators/HepMCTextReader.cxx
+ * @brief  Reader of particle records from text files in HEPEVT-like format.
+ * @date   October 19, 2026
+ * @see    icaruscode/Generators/HepMCTextReader.h
+ */
+
+// library header
+#include "icaruscode/Generators/HepMCTextReader.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::all_of()
+#include <charconv> // std::from_chars()
+#include <iterator> // std::size()
+#include <utility> // std::move()
+#include <cerrno>
+#include <cstring> // std::memchr(), std::memmove(), std::strerror()
+
+// POSIX
+#include <fcntl.h> // open()
+#include <sys/mman.h> // mmap(), munmap(), madvise()
+#include <sys/stat.h> // fstat()
+#include <unistd.h> // close()
+
+
+// -----------------------------------------------------------------------------
+namespace {
+
+  /// Names of the particle fields, in the order they appear in the file.
+  constexpr char const* ParticleFieldNames[] = {
+    "status", "PDG ID", "first mother", "second mother",
+    "first daughter", "second daughter",
+    "x momentum", "y momentum", "z momentum", "energy", "mass",
+    "x position", "y position", "z position", "time"
+  };
+
+  /// Returns whether `c` separates fields.
+  constexpr bool isBlank(char c) {
+    return (c == ' ') || (c == '\t') || (c == '\r')
+      || (c == '\v') || (c == '\f');
+  }
+
+  /// Returns whether `line` has only blank characters.
+  bool isBlankLine(std::string_view line)
+    { return std::all_of(line.begin(), line.end(), isBlank); }
+
+  /**
+   * @brief Parses the next field from `p` into `value`.
+   * @return whether the parsing was successful
+   *
+   * Blanks before the field are skipped, and `p` is moved after the field.
+   * The field must be followed by a blank or by the end of the line.
+   */
+  template <typename T>
+  bool parseField(char const*& p, char const* end, T& value) {
+
+    while ((p != end) && isBlank(*p)) ++p;
+
+    if ((p != end) && (*p == '+')) { // not supported by `std::from_chars()`
+      if ((++p != end) && (*p == '-')) return false;
+    }
+
+    auto const [ next, error ] = std::from_chars(p, end, value);
+    if ((error != std::errc{}) || ((next != end) && !isBlank(*next)))
+      return false;
+
+    p = next;
+    return true;
+  } // parseField()
+
+} // local namespace
+
+
+// -----------------------------------------------------------------------------
+// --- evgen::HepMCTextReader
+// -----------------------------------------------------------------------------
+evgen::HepMCTextReader::HepMCTextReader(
+  std::string fileName, bool memoryMap /* = false */,
+  std::size_t blockSize /* = DefaultBlockSize */
+)
+  : fFileName{ std::move(fileName) }
+  , fBlockSize{ blockSize }
+{
+  if (fBlockSize == 0U) {
+    throw cet::exception("HepMCTextReader")
+      << "Invalid read block size (0) for input file '" << fFileName << "'.\n";
+  }
+
+  if (memoryMap) {
+    mapFile();
+    return;
+  }
+
+  fFile.open(fFileName, std::ios::binary);
+  if (!fFile) {
+    throw cet::exception("HepMCTextReader")
+      << "Input file '" << fFileName << "' can't be opened.\n";
+  }
+
+} // evgen::HepMCTextReader::HepMCTextReader()
+
+
+// -----------------------------------------------------------------------------
+evgen::HepMCTextReader::~HepMCTextReader() {
+  if (fMap) ::munmap(const_cast<char*>(fMap), fMapSize);
+}
+
+
+// -----------------------------------------------------------------------------
+bool evgen::HepMCTextReader::readEvent(Event_t& event) {
+
+  std::size_t nParticles = 0;
+  if (!readHeader(event.number, nParticles)) return false;
+
+  event.particles.resize(nParticles);
+  for (std::size_t iParticle = 0; iParticle < nParticles; ++iParticle) {
+    parseParticle
+      (particleLine(iParticle, nParticles), event.particles[iParticle]);
+  }
+
+  ++fNextEvent;
+  return true;
+} // evgen::HepMCTextReader::readEvent()
+
+
+// -----------------------------------------------------------------------------
+bool evgen::HepMCTextReader::seekEvent(std::size_t iEvent) {
+
+  if (iEvent < fIndex.size()) {
+    seekOffset(fIndex[iEvent].offset, fIndex[iEvent].line - 1);
+    fNextEvent = iEvent;
+    return true;
+  }
+
+  // start from the last known event if that is closer
+  if (!fIndex.empty() && (fIndex.size() - 1 > fNextEvent)) {
+    seekOffset(fIndex.back().offset, fIndex.back().line - 1);
+    fNextEvent = fIndex.size() - 1;
+  }
+
+  // skip the events in between, without parsing their particles
+  int eventNumber = 0;
+  std::size_t nParticles = 0;
+  while (fNextEvent < iEvent) {
+    if (!readHeader(eventNumber, nParticles)) return false;
+    for (std::size_t iParticle = 0; iParticle < nParticles; ++iParticle)
+      particleLine(iParticle, nParticles);
+    ++fNextEvent;
+  } // while
+
+  // check that the requested event is there, and come back to its start
+  if (!readHeader(eventNumber, nParticles)) return false;
+  seekOffset(fIndex[iEvent].offset, fIndex[iEvent].line - 1);
+  return true;
+
+} // evgen::HepMCTextReader::seekEvent()
+
+
+// -----------------------------------------------------------------------------
+void evgen::HepMCTextReader::mapFile() {
+
+  int const fd = ::open(fFileName.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw cet::exception("HepMCTextReader")
+      << "Input file '" << fFileName << "' can't be opened: "
+      << std::strerror(errno) << "\n";
+  }
+
+  struct stat info;
+  if (::fstat(fd, &info) != 0) {
+    int const error = errno;
+    ::close(fd);
+    throw cet::exception("HepMCTextReader")
+      << "Input file '" << fFileName << "' can't be inspected: "
+      << std::strerror(error) << "\n";
+  }
+
+  fMapped = true;
+  fMapSize = info.st_size;
+  if (fMapSize == 0U) { // nothing to map
+    ::close(fd);
+    return;
+  }
+
+  void* const map = ::mmap(nullptr, fMapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  int const error = errno;
+  ::close(fd); // the mapping stays valid
+  if (map == MAP_FAILED) {
+    throw cet::exception("HepMCTextReader")
+      << "Input file '" << fFileName << "' can't be mapped in memory: "
+      << std::strerror(error) << "\n";
+  }
+  ::madvise(map, fMapSize, MADV_SEQUENTIAL); // just a hint
+
+  fMap = static_cast<char const*>(map);
+  fData = fMap;
+  fDataSize = fMapSize;
+
+} // evgen::HepMCTextReader::mapFile()
+
+
+// -----------------------------------------------------------------------------
+void evgen::HepMCTextReader::seekOffset(std::size_t offset, std::size_t line) {
+
+  fLine = line;
+
+  if (fMapped) {
+    fPos = std::min(offset, fDataSize);
+    return;
+  }
+
+  // already in the buffer?
+  if ((offset >= fBufferOffset) && (offset <= fBufferOffset + fBufferEnd)) {
+    fPos = offset - fBufferOffset;
+    return;
+  }
+
+  fFile.clear();
+  fFile.seekg(offset);
+  fBufferOffset = offset;
+  fBufferEnd = 0U;
+  fPos = 0U;
+  fFileEnd = false;
+  fDataSize = 0U;
+
+} // evgen::HepMCTextReader::seekOffset()
+
+
+// -----------------------------------------------------------------------------
+std::size_t evgen::HepMCTextReader::currentOffset() const
+  { return fMapped? fPos: fBufferOffset + fPos; }
+
+
+// -----------------------------------------------------------------------------
+bool evgen::HepMCTextReader::nextLine(std::string_view& line) {
+
+  while (true) {
+    char const* const begin = fData + fPos;
+    std::size_t const available = fDataSize - fPos;
+
+    void const* const newLine
+      = (available > 0U)? std::memchr(begin, '\n', available): nullptr;
+    if (newLine) {
+      std::size_t const length = static_cast<char const*>(newLine) - begin;
+      line = std::string_view{ begin, length };
+      fLineOffset = currentOffset();
+      fPos += length + 1;
+      ++fLine;
+      return true;
+    }
+
+    if (fMapped || fFileEnd) { // last line, without end-of-line character
+      if (available == 0U) return false;
+      line = std::string_view{ begin, available };
+      fLineOffset = currentOffset();
+      fPos += available;
+      ++fLine;
+      return true;
+    }
+
+    fillBuffer();
+  } // while
+
+} // evgen::HepMCTextReader::nextLine()
+
+
+// -----------------------------------------------------------------------------
+bool evgen::HepMCTextReader::nextNonBlankLine(std::string_view& line) {
+  do {
+    if (!nextLine(line)) return false;
+  } while (isBlankLine(line));
+  return true;
+} // evgen::HepMCTextReader::nextNonBlankLine()
+
+
+// -----------------------------------------------------------------------------
+bool evgen::HepMCTextReader::fillBuffer() {
+
+  // drop the data already consumed, and make room for a new block
+  std::size_t const left = fBufferEnd - fPos;
+  if (fPos > 0U) std::memmove(fBuffer.data(), fBuffer.data() + fPos, left);
+  fBufferOffset += fPos;
+  fBufferEnd = left;
+  fPos = 0U;
+  if (fBuffer.size() < fBufferEnd + fBlockSize)
+    fBuffer.resize(fBufferEnd + fBlockSize);
+
+  fFile.read(fBuffer.data() + fBufferEnd, fBlockSize);
+  std::size_t const nRead = fFile.gcount();
+  if (fFile.bad()) {
+    throw cet::exception("HepMCTextReader")
+      << "Error reading input file '" << fFileName << "' after "
+      << (fBufferOffset + fBufferEnd) << " bytes.\n";
+  }
+  if (nRead < fBlockSize) fFileEnd = true;
+  fBufferEnd += nRead;
+
+  fData = fBuffer.data();
+  fDataSize = fBufferEnd;
+  return nRead > 0U;
+
+} // evgen::HepMCTextReader::fillBuffer()
+
+
+// -----------------------------------------------------------------------------
+bool evgen::HepMCTextReader::readHeader
+  (int& eventNumber, std::size_t& nParticles)
+{
+  std::string_view line;
+  if (!nextNonBlankLine(line)) return false;
+
+  if (fNextEvent == fIndex.size())
+    fIndex.push_back({ fLineOffset, fLine });
+
+  char const* p = line.data();
+  char const* const end = p + line.size();
+  if (!parseField(p, end, eventNumber))
+    formatError("invalid or missing event number in event header", line);
+  if (!parseField(p, end, nParticles))
+    formatError("invalid or missing number of particles in event header", line);
+
+  return true;
+} // evgen::HepMCTextReader::readHeader()
+
+
+// -----------------------------------------------------------------------------
+void evgen::HepMCTextReader::parseParticle
+  (std::string_view line, Particle_t& particle) const
+{
+  int* const intFields[] = {
+    &particle.status, &particle.pdg,
+    &particle.firstMother, &particle.secondMother,
+    &particle.firstDaughter, &particle.secondDaughter
+  };
+  double* const realFields[] = {
+    &particle.xMomentum, &particle.yMomentum, &particle.zMomentum,
+    &particle.energy, &particle.mass,
+    &particle.xPosition, &particle.yPosition, &particle.zPosition,
+    &particle.time
+  };
+  constexpr std::size_t nIntFields = std::size(intFields);
+
+  auto const fieldError = [this,line](std::size_t iField)
+    {
+      formatError(
+        "invalid or missing " + std::string{ ParticleFieldNames[iField] }
+          + " (field #" + std::to_string(iField + 1) + ") of particle",
+        line
+        );
+    };
+
+  char const* p = line.data();
+  char const* const end = p + line.size();
+  for (std::size_t iField = 0; iField < nIntFields; ++iField)
+    if (!parseField(p, end, *intFields[iField])) fieldError(iField);
+  for (std::size_t iField = 0; iField < std::size(realFields); ++iField)
+    if (!parseField(p, end, *realFields[iField])) fieldError(nIntFields + iField);
+
+} // evgen::HepMCTextReader::parseParticle()
+
+
+// -----------------------------------------------------------------------------
+std::string_view evgen::HepMCTextReader::particleLine
+  (std::size_t iParticle, std::size_t nParticles)
+{
+  std::string_view line;
+  if (!nextLine(line)) {
+    formatError(
+      "file ends after " + std::to_string(iParticle) + " of the "
+        + std::to_string(nParticles) + " particles of the event",
+      {}
+      );
+  }
+  return line;
+} // evgen::HepMCTextReader::particleLine()
+
+
+// -----------------------------------------------------------------------------
+void evgen::HepMCTextReader::formatError
+  (std::string const& message, std::string_view line) const
+{
+  cet::exception e("HepMCTextReader");
+  e << "Format error in '" << fFileName << "' line " << fLine << ": "
+    << message << ".\n";
+  if (!line.empty()) e << "  \"" << line << "\"\n";
+  throw e;
+} // evgen::HepMCTextReader::formatError()
+
+
+// -----------------------------------------------------------------------------
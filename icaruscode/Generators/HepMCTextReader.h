@@ -0,0 +1,222 @@
+/**
+ * @file   icaruscode/Generators/HepMCTextReader.h
+ * @brief  Reader of particle records from text files in HEPEVT-like format.
+ * @date   October 19, 2026
+ * @see    icaruscode/Generators/HepMCTextReader.cxx
+ */
+
+#ifndef ICARUSCODE_GENERATORS_HEPMCTEXTREADER_H
+#define ICARUSCODE_GENERATORS_HEPMCTEXTREADER_H
+
+
+// C/C++ standard libraries
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace evgen { class HepMCTextReader; }
+
+/**
+ * @brief Reads events from a text file in the format of `HepMCFileGen`.
+ *
+ * Each event in the file starts with a header line with the event number and
+ * the number of particles in the event, followed by one line per particle with
+ * 15 fields (see `evgen::HepMCFileGen` and `Particle_t` for their meaning).
+ * Fields are separated by blanks, and additional fields at the end of a line
+ * are ignored. Blank lines between events are skipped.
+ *
+ * The numbers are parsed with `std::from_chars()`, which does not depend on
+ * the locale. The file content is accessed either via a read buffer, filled
+ * in blocks of a configurable size (`DefaultBlockSize` by default), or, if
+ * requested, via memory mapping of the whole file.
+ *
+ * The reader keeps an index of the position of the events it has met so far.
+ * `seekEvent()` jumps to an indexed event directly, and to the others by
+ * skipping lines without parsing the particles; `skipEvents()` does the
+ * same relative to the current event.
+ *
+ * Format errors (including a file ending in the middle of an event) are
+ * reported with a `cet::exception` (category `"HepMCTextReader"`) quoting the
+ * file name, the line number and the offending line.
+ *
+ * Example of usage:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * evgen::HepMCTextReader reader{ "cosmics.hepmc" };
+ * reader.skipEvents(100);
+ *
+ * evgen::HepMCTextReader::Event_t event;
+ * while (reader.readEvent(event)) {
+ *   for (evgen::HepMCTextReader::Particle_t const& particle: event.particles)
+ *     std::cout << particle.pdg << " " << particle.energy << std::endl;
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class evgen::HepMCTextReader {
+
+    public:
+
+  /// Record of a particle, with the fields in the order they are in the file.
+  struct Particle_t {
+    int status = 0; ///< Status code (`1`: to be tracked).
+    int pdg = 0; ///< PDG ID of the particle.
+    int firstMother = 0; ///< Entry of the first mother (`0`: none).
+    int secondMother = 0; ///< Entry of the second mother (`0`: none).
+    int firstDaughter = 0; ///< Entry of the first daughter (`0`: none).
+    int secondDaughter = 0; ///< Entry of the second daughter (`0`: none).
+    double xMomentum = 0.0; ///< _x_ component of the momentum.
+    double yMomentum = 0.0; ///< _y_ component of the momentum.
+    double zMomentum = 0.0; ///< _z_ component of the momentum.
+    double energy = 0.0; ///< Energy.
+    double mass = 0.0; ///< Mass.
+    double xPosition = 0.0; ///< _x_ coordinate of the initial position.
+    double yPosition = 0.0; ///< _y_ coordinate of the initial position.
+    double zPosition = 0.0; ///< _z_ coordinate of the initial position.
+    double time = 0.0; ///< Production time.
+  }; // Particle_t
+
+  /// Record of an event.
+  struct Event_t {
+    int number = 0; ///< Event number, as written in the file.
+    std::vector<Particle_t> particles; ///< All particles in the event.
+  }; // Event_t
+
+
+  /// Default size of the read blocks of the buffered reader [bytes].
+  static constexpr std::size_t DefaultBlockSize = 1U << 20;
+
+
+  /**
+   * @brief Opens the specified file for reading.
+   * @param fileName path of the file to be read
+   * @param memoryMap (default: `false`) map the whole file in memory
+   * @param blockSize (default: `DefaultBlockSize`) size of the read blocks
+   *                  [bytes]; ignored if the file is memory-mapped
+   * @throw cet::exception (category `"HepMCTextReader"`) if file can't be read
+   *                       or `blockSize` is `0`
+   */
+  HepMCTextReader(
+    std::string fileName, bool memoryMap = false,
+    std::size_t blockSize = DefaultBlockSize
+    );
+
+  // the memory map is owned: no copy
+  HepMCTextReader(HepMCTextReader const&) = delete;
+  HepMCTextReader& operator= (HepMCTextReader const&) = delete;
+
+  ~HepMCTextReader();
+
+
+  /**
+   * @brief Reads the next event into `event`.
+   * @param event the event record to be filled
+   * @return whether an event was read (`false` at the end of the file)
+   * @throw cet::exception (category `"HepMCTextReader"`) on format errors
+   */
+  bool readEvent(Event_t& event);
+
+  /**
+   * @brief Moves to the event with the specified index in the file.
+   * @param iEvent index of the event (the first one in the file is `0`)
+   * @return whether the event is present in the file
+   * @throw cet::exception (category `"HepMCTextReader"`) on format errors
+   *
+   * If the event is not present, the reader is left at the end of the file.
+   */
+  bool seekEvent(std::size_t iEvent);
+
+  /// Skips the next `nEvents` events; returns whether all were present.
+  bool skipEvents(std::size_t nEvents)
+    { return seekEvent(nextEvent() + nEvents); }
+
+  /// Returns the index in the file of the next event to be read.
+  std::size_t nextEvent() const { return fNextEvent; }
+
+  /// Returns the number of events whose position in the file is known.
+  std::size_t nIndexedEvents() const { return fIndex.size(); }
+
+  /// Returns the name of the file being read.
+  std::string const& fileName() const { return fFileName; }
+
+  /// Returns whether the file is memory-mapped.
+  bool isMemoryMapped() const { return fMapped; }
+
+  /// Returns the size of the read blocks of the buffered reader [bytes].
+  std::size_t blockSize() const { return fBlockSize; }
+
+
+    private:
+
+  /// Position of an event in the file.
+  struct EventPosition_t {
+    std::size_t offset; ///< Offset of the header line from the file start.
+    std::size_t line; ///< Number of the header line (the first one is `1`).
+  }; // EventPosition_t
+
+  std::string const fFileName; ///< Name of the file.
+  std::size_t const fBlockSize; ///< Size of the read blocks [bytes].
+
+  // --- BEGIN -- Memory-mapped file -------------------------------------------
+  bool fMapped = false; ///< Whether the file is memory-mapped.
+  char const* fMap = nullptr; ///< Start of the mapped file, if mapped.
+  std::size_t fMapSize = 0U; ///< Size of the mapped file.
+  // --- END ---- Memory-mapped file -------------------------------------------
+
+  // --- BEGIN -- Buffered file ------------------------------------------------
+  std::ifstream fFile; ///< The input file, if not mapped.
+  std::vector<char> fBuffer; ///< Data read from the file.
+  std::size_t fBufferOffset = 0U; ///< File offset of the buffer start.
+  std::size_t fBufferEnd = 0U; ///< Size of the valid data in the buffer.
+  bool fFileEnd = false; ///< Whether the file has been read to its end.
+  // --- END ---- Buffered file ------------------------------------------------
+
+  char const* fData = nullptr; ///< Start of the accessible data.
+  std::size_t fDataSize = 0U; ///< Size of the accessible data.
+  std::size_t fPos = 0U; ///< Current position in the accessible data.
+  std::size_t fLine = 0U; ///< Number of the last line read.
+  std::size_t fLineOffset = 0U; ///< File offset of the last line read.
+
+  std::size_t fNextEvent = 0U; ///< Index of the next event.
+  std::vector<EventPosition_t> fIndex; ///< Position of the known events.
+
+
+  /// Maps the whole file in memory.
+  void mapFile();
+
+  /// Moves to the specified `offset` in the file, at line number `line`.
+  void seekOffset(std::size_t offset, std::size_t line);
+
+  /// Returns the file offset of the current position.
+  std::size_t currentOffset() const;
+
+  /// Reads the next line into `line`; returns `false` at the end of file.
+  bool nextLine(std::string_view& line);
+
+  /// Reads the next non-blank line into `line`; `false` at the end of file.
+  bool nextNonBlankLine(std::string_view& line);
+
+  /// Reads more data into the buffer; returns whether any was read.
+  bool fillBuffer();
+
+  /// Reads the header of the next event; returns `false` at the end of file.
+  bool readHeader(int& eventNumber, std::size_t& nParticles);
+
+  /// Parses a particle `line` into `particle`.
+  void parseParticle(std::string_view line, Particle_t& particle) const;
+
+  /// Returns the next line of a particle; throws at the end of file.
+  std::string_view particleLine(std::size_t iParticle, std::size_t nParticles);
+
+  /// Throws an exception about a format error at the current `line`.
+  [[noreturn]] void formatError
+    (std::string const& message, std::string_view line) const;
+
+}; // evgen::HepMCTextReader
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSCODE_GENERATORS_HEPMCTEXTREADER_H
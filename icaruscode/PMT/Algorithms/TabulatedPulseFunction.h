@@ -0,0 +1,378 @@
+/**
+ * @file   icaruscode/PMT/Algorithms/TabulatedPulseFunction.h
+ * @brief  Pulse from one photoelectron as an interpolated table of values.
+ * @date   October 19, 2026
+ *
+ * This library is header only.
+ *
+ */
+
+#ifndef ICARUSCODE_PMT_ALGORITHMS_TABULATEDPULSEFUNCTION_H
+#define ICARUSCODE_PMT_ALGORITHMS_TABULATEDPULSEFUNCTION_H
+
+// library header
+#include "icaruscode/PMT/Algorithms/PhotoelectronPulseFunction.h"
+
+// LArSoft libraries
+#include "lardataalg/Utilities/quantities/electronics.h" // counts_f
+
+// C++ standard library
+#include <istream>
+#include <ios> // std::ios
+#include <ostream> // std::ostream
+#include <vector>
+#include <string>
+#include <optional>
+#include <algorithm> // std::equal(), std::min()
+#include <stdexcept> // std::runtime_error
+#include <utility> // std::move()
+#include <cmath> // std::floor()
+#include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::opdet {
+  template <typename T> class TabulatedPulseFunction;
+}
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Describes the waveform from a single photoelectron as a table.
+ * @tparam T type of time unit to be used
+ *
+ * This functor (class behaving like a function) describes the shape of the
+ * response to a single photoelectron by linear interpolation of a table of
+ * values equally spaced in time.
+ * The table is usually filled by sampling another pulse function with a fine
+ * time step (see the constructor): evaluating the tabulated shape then costs
+ * a table lookup, regardless of how expensive the original function was
+ * (for example, an interpreted `TFormula` in `CustomPulseFunction`).
+ *
+ * Outside the tabulated time interval the shape is at its baseline.
+ * Peak time, peak amplitude and baseline are the ones of the original
+ * function.
+ *
+ * The table can be saved into a binary stream (`write()`) and restored
+ * (`read()`) without the need of the original function, which allows for
+ * caching it.
+ */
+template <typename T>
+class icarus::opdet::TabulatedPulseFunction
+  : public icarus::opdet::PhotoelectronPulseFunction<T>
+{
+  using Base_t = icarus::opdet::PhotoelectronPulseFunction<T>;
+
+    public:
+  /// Type for ADC counts (floating point).
+  using ADCcount = typename Base_t::ADCcount;
+
+  using Time = typename Base_t::Time; ///< Type of time being used.
+
+  /// All the information defining the tabulated shape.
+  struct TableSpecs_t {
+    Time start;                     ///< Time of the first entry of the table.
+    Time step;                      ///< Time between two consecutive entries.
+    std::vector<ADCcount> values;   ///< Tabulated values.
+    Time peakTime;                  ///< Time of the pulse peak.
+    ADCcount peakAmplitude;         ///< Pulse amplitude at peak time.
+    ADCcount baseline;              ///< Pulse baseline.
+    std::string description;        ///< Description of the tabulated shape.
+  }; // TableSpecs_t
+
+
+  /**
+   * @brief Constructor: tabulates the specified pulse function.
+   * @param function the pulse function to be tabulated
+   * @param start time of the first entry of the table
+   * @param duration time interval covered by the table
+   * @param step time interval between two consecutive entries of the table
+   * @throw std::runtime_error if `step` is not positive
+   *
+   * The `function` is evaluated at `start`, `start + step`, `start + 2 step`
+   * and so on up to and including `start + duration`.
+   * The `function` object is not used after construction.
+   */
+  TabulatedPulseFunction
+    (Base_t const& function, Time start, Time duration, Time step);
+
+  /// Constructor: uses the specified table.
+  TabulatedPulseFunction(TableSpecs_t specs);
+
+
+  /// Returns all the information defining this shape.
+  TableSpecs_t const& specs() const { return fSpecs; }
+
+  /// Returns the number of entries of the table.
+  std::size_t size() const { return fSpecs.values.size(); }
+
+
+  // --- BEGIN -- Serialization ------------------------------------------------
+  /// @name Serialization
+  /// @{
+
+  /// Writes this shape in binary format into the `out` stream.
+  void write(std::ostream& out) const;
+
+  /**
+   * @brief Reads a shape in binary format from the `in` stream.
+   * @return the shape, or no value if the stream does not contain a valid one
+   * @see `write()`
+   *
+   * The sizes stored in the stream are checked against the data left in it
+   * (or against `MaxReadSize` if the stream can't tell) before any memory
+   * is allocated for them, so that a corrupted stream is just rejected.
+   */
+  static std::optional<TabulatedPulseFunction> read(std::istream& in);
+
+  /// Largest amount of data accepted by `read()`, in bytes.
+  static constexpr std::uint64_t MaxReadSize = std::uint64_t{ 1 } << 30;
+
+  /// @}
+  // --- END ---- Serialization ------------------------------------------------
+
+
+    private:
+
+  TableSpecs_t fSpecs; ///< The shape.
+
+  double fStart; ///< Start time, in `Time` units.
+  double fInvStep; ///< Inverse of the time step, in inverse `Time` units.
+
+
+  // --- BEGIN -- Interface implementation -------------------------------------
+  /**
+   * @brief Evaluates the pulse at the given time.
+   * @param time time to evaluate the shape at
+   *
+   * The value is linearly interpolated between the two closest entries.
+   */
+  virtual ADCcount doEvaluateAt(Time time) const override;
+
+  /// Returns the time at which the first peak is found.
+  virtual Time doPeakTime() const override { return fSpecs.peakTime; }
+
+  /// Returns the amplitude of the first peak in ADC counts.
+  virtual ADCcount doPeakAmplitude() const override
+    { return fSpecs.peakAmplitude; }
+
+  /// Returns the baseline of the pulse.
+  virtual ADCcount doBaseline() const override { return fSpecs.baseline; }
+
+  /**
+   * @brief Prints on stream the parameters of this shape.
+   * @param out the stream to write into
+   * @param indent indentation string, prepended to all lines except first
+   * @param indentFirst indentation string prepended to the first line
+   */
+  virtual void doDump(
+    std::ostream& out,
+    std::string const& indent, std::string const& firstIndent
+    ) const override;
+
+  // --- END -- Interface implementation -------------------------------------
+
+
+  /// Returns the table of `function` (see the constructor for the arguments).
+  static TableSpecs_t tabulate
+    (Base_t const& function, Time start, Time duration, Time step);
+
+  /// Returns the bytes left in `in` (at most `MaxReadSize`).
+  static std::uint64_t remainingBytes(std::istream& in);
+
+  /// Identifier of the binary format of `write()`.
+  static constexpr char FormatTag[8]
+    = { 'P', 'E', 'T', 'A', 'B', 'L', 'E', '1' };
+
+}; // class icarus::opdet::TabulatedPulseFunction<>
+
+
+// -----------------------------------------------------------------------------
+// ---  template implementation
+// -----------------------------------------------------------------------------
+template <typename T>
+icarus::opdet::TabulatedPulseFunction<T>::TabulatedPulseFunction
+  (Base_t const& function, Time start, Time duration, Time step)
+  : TabulatedPulseFunction(tabulate(function, start, duration, step))
+  {}
+
+
+// -----------------------------------------------------------------------------
+template <typename T>
+icarus::opdet::TabulatedPulseFunction<T>::TabulatedPulseFunction
+  (TableSpecs_t specs)
+  : fSpecs(std::move(specs))
+  , fStart(static_cast<double>(fSpecs.start))
+  , fInvStep(1.0 / static_cast<double>(fSpecs.step))
+{
+  if (!(static_cast<double>(fSpecs.step) > 0.0)) {
+    throw std::runtime_error(
+      "TabulatedPulseFunction: the time step must be positive ("
+      + std::to_string(static_cast<double>(fSpecs.step)) + " was specified)"
+      );
+  }
+} // icarus::opdet::TabulatedPulseFunction<>::TabulatedPulseFunction()
+
+
+// -----------------------------------------------------------------------------
+template <typename T>
+auto icarus::opdet::TabulatedPulseFunction<T>::doEvaluateAt(Time time) const
+  -> ADCcount
+{
+  std::vector<ADCcount> const& values = fSpecs.values;
+
+  double const x = (static_cast<double>(time) - fStart) * fInvStep;
+  if (!(x >= 0.0)) return fSpecs.baseline; // also catches NaN
+
+  double const left = std::floor(x);
+  double const last = static_cast<double>(values.size()) - 1.0;
+  if (left >= last) return (x == last)? values.back(): fSpecs.baseline;
+
+  std::size_t const i = static_cast<std::size_t>(left);
+  double const v0 = values[i].value(), v1 = values[i + 1].value();
+  return ADCcount::castFrom(v0 + (v1 - v0) * (x - left));
+} // icarus::opdet::TabulatedPulseFunction<>::doEvaluateAt()
+
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void icarus::opdet::TabulatedPulseFunction<T>::write(std::ostream& out) const
+{
+  auto const writeValue = [&out](auto value)
+    { out.write(reinterpret_cast<char const*>(&value), sizeof(value)); };
+
+  out.write(FormatTag, sizeof(FormatTag));
+  writeValue(static_cast<double>(fSpecs.start));
+  writeValue(static_cast<double>(fSpecs.step));
+  writeValue(static_cast<double>(fSpecs.peakTime));
+  writeValue(static_cast<double>(fSpecs.peakAmplitude.value()));
+  writeValue(static_cast<double>(fSpecs.baseline.value()));
+  writeValue(static_cast<std::uint64_t>(fSpecs.description.size()));
+  out.write(fSpecs.description.data(), fSpecs.description.size());
+  writeValue(static_cast<std::uint64_t>(fSpecs.values.size()));
+  for (ADCcount const value: fSpecs.values)
+    writeValue(static_cast<double>(value.value()));
+
+} // icarus::opdet::TabulatedPulseFunction<>::write()
+
+
+// -----------------------------------------------------------------------------
+template <typename T>
+auto icarus::opdet::TabulatedPulseFunction<T>::read(std::istream& in)
+  -> std::optional<TabulatedPulseFunction>
+{
+  auto const readValue = [&in](auto& value) -> bool
+    { return bool(in.read(reinterpret_cast<char*>(&value), sizeof(value))); };
+
+  char tag[sizeof(FormatTag)];
+  if (!in.read(tag, sizeof(tag))) return std::nullopt;
+  if (!std::equal(tag, tag + sizeof(tag), FormatTag)) return std::nullopt;
+
+  double start, step, peakTime, peakAmplitude, baseline;
+  if (!readValue(start) || !readValue(step) || !readValue(peakTime)
+    || !readValue(peakAmplitude) || !readValue(baseline)
+  ) {
+    return std::nullopt;
+  }
+  if (!(step > 0.0)) return std::nullopt;
+
+  std::uint64_t length;
+  if (!readValue(length)) return std::nullopt;
+  if (length > remainingBytes(in)) return std::nullopt;
+  std::string description(length, '\0');
+  if (!in.read(description.data(), length)) return std::nullopt;
+
+  std::uint64_t nValues;
+  if (!readValue(nValues)) return std::nullopt;
+  if (nValues > remainingBytes(in) / sizeof(double)) return std::nullopt;
+  std::vector<ADCcount> values;
+  values.reserve(nValues);
+  for (double value; values.size() < nValues; ) {
+    if (!readValue(value)) return std::nullopt;
+    values.push_back(ADCcount::castFrom(value));
+  } // for
+
+  return TabulatedPulseFunction{ TableSpecs_t{
+      Time{ start }                       // start
+    , Time{ step }                        // step
+    , std::move(values)                   // values
+    , Time{ peakTime }                    // peakTime
+    , ADCcount::castFrom(peakAmplitude)   // peakAmplitude
+    , ADCcount::castFrom(baseline)        // baseline
+    , std::move(description)              // description
+    } };
+
+} // icarus::opdet::TabulatedPulseFunction<>::read()
+
+
+// -----------------------------------------------------------------------------
+template <typename T>
+std::uint64_t icarus::opdet::TabulatedPulseFunction<T>::remainingBytes
+  (std::istream& in)
+{
+  std::istream::pos_type const here = in.tellg();
+  if (here == std::istream::pos_type(-1)) return MaxReadSize; // not seekable
+
+  in.seekg(0, std::ios::end);
+  std::istream::pos_type const end = in.tellg();
+  in.clear();
+  in.seekg(here);
+  if (end == std::istream::pos_type(-1)) return MaxReadSize;
+
+  return (end > here)
+    ? std::min(static_cast<std::uint64_t>(end - here), MaxReadSize): 0;
+} // icarus::opdet::TabulatedPulseFunction<>::remainingBytes()
+
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void icarus::opdet::TabulatedPulseFunction<T>::doDump(
+  std::ostream& out,
+  std::string const& indent, std::string const& firstIndent
+  ) const
+{
+  out
+    << firstIndent << "Tabulated pulse shape: " << size() << " entries from "
+      << fSpecs.start << " every " << fSpecs.step
+    << "\n" << indent << "  peak " << fSpecs.peakAmplitude
+      << " at " << fSpecs.peakTime
+    ;
+  if (!fSpecs.description.empty())
+    out << "\n" << indent << "Tabulated from: " << fSpecs.description;
+  out << '\n';
+} // icarus::opdet::TabulatedPulseFunction<>::doDump()
+
+
+// -----------------------------------------------------------------------------
+template <typename T>
+auto icarus::opdet::TabulatedPulseFunction<T>::tabulate
+  (Base_t const& function, Time start, Time duration, Time step)
+  -> TableSpecs_t
+{
+  TableSpecs_t specs;
+  specs.start = start;
+  specs.step = step;
+  specs.peakTime = function.peakTime();
+  specs.peakAmplitude = function.peakAmplitude();
+  specs.baseline = function.baseline();
+  specs.description = function.toString();
+  while (!specs.description.empty() && (specs.description.back() == '\n'))
+    specs.description.pop_back();
+
+  if (!(static_cast<double>(step) > 0.0)) return specs; // constructor throws
+
+  std::size_t const nSteps = static_cast<std::size_t>
+    (std::floor(static_cast<double>(duration) / static_cast<double>(step)));
+  specs.values.reserve(nSteps + 1);
+  double const startValue = static_cast<double>(start);
+  double const stepValue = static_cast<double>(step);
+  for (std::size_t i = 0; i <= nSteps; ++i)
+    specs.values.push_back(function(Time{ startValue + stepValue * i }));
+
+  return specs;
+} // icarus::opdet::TabulatedPulseFunction<>::tabulate()
+
+
+// -----------------------------------------------------------------------------
+
+#endif //  ICARUSCODE_PMT_ALGORITHMS_TABULATEDPULSEFUNCTION_H
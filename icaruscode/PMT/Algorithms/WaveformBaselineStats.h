@@ -0,0 +1,209 @@
+/**
+ * @file   icaruscode/PMT/Algorithms/WaveformBaselineStats.h
+ * @brief  Robust statistics (median, mode, RMS) of 16-bit PMT waveforms.
+ * @date   October 19, 2026
+ *
+ * This library is header-only.
+ */
+
+#ifndef ICARUSCODE_PMT_ALGORITHMS_WAVEFORMBASELINESTATS_H
+#define ICARUSCODE_PMT_ALGORITHMS_WAVEFORMBASELINESTATS_H
+
+// framework libraries
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
+// C/C++ standard library
+#include <algorithm> // std::max_element(), std::fill()
+#include <cmath> // std::sqrt()
+#include <cstddef> // std::size_t
+#include <cstdint> // std::int16_t, std::uint32_t
+#include <iterator> // std::size()
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::opdet { class WaveformBaselineStats; }
+/**
+ * @brief Extracts baseline statistics from 16-bit waveforms.
+ *
+ * For each waveform, the algorithm returns:
+ * * the median of the samples (for an even number of samples, the larger of
+ *   the two central ones, like `std::nth_element()` at `size() / 2`);
+ * * the mode, i.e. the most frequent sample value (the lowest one in case of
+ *   ties);
+ * * the mean and RMS of the samples within `window()` ADC counts from the
+ *   mode ("truncated" mean and RMS), which exclude the signal pulses from
+ *   the estimation of the baseline and of its noise.
+ *
+ * All of them are extracted from a histogram of the sample values, with no
+ * copy nor sorting of the waveform: the cost is linear in the number of
+ * samples plus the range of their values. The histogram is kept in a buffer
+ * private to each thread and reused from one waveform to the next.
+ * The loops on the samples are written to be vectorized by the compiler:
+ * the range of values is found with a branchless minimum/maximum pass and,
+ * when there are many samples for each possible value, the samples are
+ * counted into four interleaved histograms which are then summed, so that
+ * consecutive equal samples do not serialize on the same counter.
+ *
+ * `all()` processes a whole collection of waveforms in parallel.
+ *
+ * Example:
+ * @code
+ * icarus::opdet::WaveformBaselineStats const baselineStats;
+ *
+ * std::vector<icarus::opdet::WaveformBaselineStats::Stats_t> const stats
+ *   = baselineStats.all(waveforms);
+ * @endcode
+ */
+class icarus::opdet::WaveformBaselineStats {
+
+    public:
+
+  using Sample_t = std::int16_t; ///< Type of waveform sample.
+
+  /// Statistics of a single waveform.
+  struct Stats_t {
+    Sample_t median = 0; ///< Median of the samples.
+    Sample_t mode = 0; ///< Most frequent sample value.
+    float truncatedMean = 0.0f; ///< Mean of the samples around the mode.
+    float RMS = 0.0f; ///< RMS of the samples around the mode.
+    std::size_t nSamples = 0U; ///< Number of samples in the waveform.
+    std::size_t nTruncatedSamples = 0U; ///< Samples around the mode.
+  }; // Stats_t
+
+
+  /// Constructor: truncated statistics use samples within `window` of mode.
+  explicit WaveformBaselineStats(unsigned int window = 3U)
+    : fWindow{ window } {}
+
+  /// Returns the half width of the window of the truncated statistics [ADC].
+  unsigned int window() const { return fWindow; }
+
+  /// Returns the statistics of the samples in `[ begin, end [`.
+  Stats_t operator() (Sample_t const* begin, Sample_t const* end) const;
+
+  /// Returns the statistics of the samples of `waveform` (contiguous).
+  template <typename Waveform>
+  Stats_t operator() (Waveform const& waveform) const
+    { return (*this)(waveform.data(), waveform.data() + std::size(waveform)); }
+
+  /// Returns the statistics of each of the `waveforms`, computed in parallel.
+  template <typename Waveforms>
+  std::vector<Stats_t> all(Waveforms const& waveforms) const;
+
+
+    private:
+
+  /// Number of interleaved histograms the samples are counted into.
+  static constexpr std::size_t NHistograms = 4U;
+
+  unsigned int fWindow; ///< Half width of the truncated statistics window.
+
+  /// Returns the histogram buffer of this thread, resized to `size` zeroes.
+  static std::uint32_t* histogramBuffer(std::size_t size);
+
+}; // class icarus::opdet::WaveformBaselineStats
+
+
+// -----------------------------------------------------------------------------
+// --- inline implementation
+// -----------------------------------------------------------------------------
+inline std::uint32_t* icarus::opdet::WaveformBaselineStats::histogramBuffer
+  (std::size_t size)
+{
+  thread_local std::vector<std::uint32_t> buffer;
+  if (buffer.size() < size) buffer.resize(size);
+  std::fill(buffer.begin(), buffer.begin() + size, 0U);
+  return buffer.data();
+} // icarus::opdet::WaveformBaselineStats::histogramBuffer()
+
+
+// -----------------------------------------------------------------------------
+inline auto icarus::opdet::WaveformBaselineStats::operator()
+  (Sample_t const* begin, Sample_t const* end) const -> Stats_t
+{
+  Stats_t stats;
+  std::size_t const n = end - begin;
+  stats.nSamples = n;
+  if (n == 0) return stats;
+
+  // range of the sample values
+  Sample_t low = *begin, high = *begin;
+  for (Sample_t const* s = begin; s != end; ++s) {
+    low = (*s < low)? *s: low;
+    high = (*s > high)? *s: high;
+  }
+  std::size_t const nBins = std::size_t(high - low) + 1U;
+
+  // histogram of the sample values (bin `i` is value `low + i`); when the
+  // samples are many compared to the values, they are counted in interleaved
+  // histograms, the last of which eventually receives the sum of all of them
+  std::size_t const nHistograms = (n >= NHistograms * nBins)? NHistograms: 1U;
+  std::uint32_t* const buffer = histogramBuffer(nHistograms * nBins);
+  std::uint32_t* const counts = buffer + (nHistograms - 1U) * nBins;
+  std::size_t i = 0;
+  if (nHistograms == NHistograms) {
+    for (; i + NHistograms <= n; i += NHistograms) {
+      for (std::size_t h = 0; h < NHistograms; ++h)
+        ++buffer[h * nBins + (begin[i + h] - low)];
+    }
+  }
+  for (; i < n; ++i) ++counts[begin[i] - low];
+  for (std::size_t h = 0; h < nHistograms - 1U; ++h) {
+    std::uint32_t const* const sub = buffer + h * nBins;
+    for (std::size_t bin = 0; bin < nBins; ++bin) counts[bin] += sub[bin];
+  }
+
+  // median: the sample with `n / 2` samples before it
+  std::size_t const medianRank = n / 2;
+  std::size_t cumulative = 0;
+  std::size_t medianBin = 0;
+  while ((cumulative += counts[medianBin]) <= medianRank) ++medianBin;
+  stats.median = static_cast<Sample_t>(low + medianBin);
+
+  // mode
+  std::size_t const modeBin = std::max_element(counts, counts + nBins) - counts;
+  stats.mode = static_cast<Sample_t>(low + modeBin);
+
+  // truncated mean and RMS, with values relative to the mode
+  std::size_t const firstBin = (modeBin > fWindow)? modeBin - fWindow: 0;
+  std::size_t const endBin = std::min(modeBin + fWindow + 1U, nBins);
+  double sumW = 0.0, sumX = 0.0, sumX2 = 0.0;
+  for (std::size_t bin = firstBin; bin < endBin; ++bin) {
+    double const x = double(bin) - double(modeBin);
+    double const w = counts[bin];
+    sumW += w;
+    sumX += w * x;
+    sumX2 += w * x * x;
+  } // for
+  double const mean = sumX / sumW;
+  stats.truncatedMean = static_cast<float>(stats.mode + mean);
+  stats.RMS
+    = static_cast<float>(std::sqrt(std::max(sumX2 / sumW - mean * mean, 0.0)));
+  stats.nTruncatedSamples = static_cast<std::size_t>(sumW);
+
+  return stats;
+} // icarus::opdet::WaveformBaselineStats::operator()
+
+
+// -----------------------------------------------------------------------------
+template <typename Waveforms>
+auto icarus::opdet::WaveformBaselineStats::all
+  (Waveforms const& waveforms) const -> std::vector<Stats_t>
+{
+  std::vector<Stats_t> stats(std::size(waveforms));
+  tbb::parallel_for(tbb::blocked_range<std::size_t>(0, stats.size()),
+    [this, &waveforms, &stats](tbb::blocked_range<std::size_t> const& range)
+      {
+        for (std::size_t i = range.begin(); i < range.end(); ++i)
+          stats[i] = (*this)(waveforms[i]);
+      }
+    );
+  return stats;
+} // icarus::opdet::WaveformBaselineStats::all()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSCODE_PMT_ALGORITHMS_WAVEFORMBASELINESTATS_H
@@ -3,49 +3,58 @@
 FitBackgroundPhotons::FitBackgroundPhotons(){}
 
 FitBackgroundPhotons::FitBackgroundPhotons( unsigned int nparameters, IdealPmtResponse fitf )
+	: m_nparameters(nparameters)
+	, m_fitf(fitf)
+{
+}
+
+void FitBackgroundPhotons::fitHistogram( TH1D *hist )
 {
-	m_nparameters=nparameters;
-	m_fitf = new TF1( "fitFunction", fitf, m_fitrange[0], m_fitrange[1], m_nparameters);
+
+	m_result = fitData( extractData(*hist) );
 
 }
 
-void FitBackgroundPhotons::fitHistogram( TH1D *hist, std::string fitoption )
+FitBackgroundPhotons::HistogramData_t FitBackgroundPhotons::extractData( TH1D const& hist ) const
 {
 
-	m_fitf->SetParameters( 0.1, 0.8, 0.3, hist->Integral()*0.2, hist->Integral()*0.8, -3. );
-	m_fitf->SetParLimits( 0, 0.0, 2.0 );
-	m_fitf->SetParLimits( 1, 0.0, 2.0 );
-	m_fitf->SetParLimits( 2, 0.0, 2.0 );
-	m_fitf->SetParLimits( 3, 0.0, hist->Integral()*10 );
-	m_fitf->SetParLimits( 4, 0.0, hist->Integral()*10 );
-	m_fitf->SetParLimits( 5, -10, 0.0 );
+	// Like in a ROOT chi2 fit, empty bins are skipped
+	HistogramData_t data;
+	data.integral = hist.Integral();
 
-	int fitstatus = hist->Fit("fitFunction", fitoption.c_str(), "", m_fitrange[0], m_fitrange[1]);
+	for( int bin=1; bin<=hist.GetNbinsX(); bin++ ){
 
-	int nrefit = 0;
+		double const x = hist.GetBinCenter(bin);
+		if( x < m_fitrange[0] || x > m_fitrange[1] ) continue;
 
-	m_vresults.resize(m_nparameters);
-	m_verrors.resize(m_nparameters);
+		double const error = hist.GetBinError(bin);
+		if( error <= 0 ) continue;
 
-	while( fitstatus !=0 && nrefit < m_maxrefit ){
+		data.x.push_back( x );
+		data.y.push_back( hist.GetBinContent(bin) );
+		data.sigma.push_back( error );
+	}
 
-		for(unsigned int i=0; i<m_nparameters; i++){
-			m_vresults[i] = m_fitf->GetParameter(i);
-			m_verrors[i] = m_fitf->GetParError(i);
-		}
+	return data;
 
-		fitstatus = hist->Fit("fitFunction", fitoption.c_str(), "", m_fitrange[0], m_fitrange[1]);
+}
 
-		nrefit++;
+util::LeastSquaresFitter::Result_t FitBackgroundPhotons::fitData( HistogramData_t const& data ) const
+{
 
+	util::LeastSquaresFitter fitter( m_nparameters );
+	fitter.setParLimits( 0, 0.0, 2.0 );
+	fitter.setParLimits( 1, 0.0, 2.0 );
+	fitter.setParLimits( 2, 0.0, 2.0 );
+	fitter.setParLimits( 3, 0.0, data.integral*10 );
+	if( m_nparameters > 5 ){
+		fitter.setParLimits( 4, 0.0, data.integral*10 );
+		fitter.setParLimits( 5, -10, 0.0 );
 	}
 
-	// Final assigment of the parameters and parameters errors
-	for(unsigned int i=0; i<m_nparameters; i++){
-		m_vresults[i] = m_fitf->GetParameter(i);
-		m_verrors[i] = m_fitf->GetParError(i);
-	}
+	std::vector<double> start{ 0.1, 0.8, 0.3, data.integral*0.2, data.integral*0.8, -3. };
+	start.resize( m_nparameters, 0.0 );
 
-	m_fitstatus=fitstatus;
+	return fitter.fit( m_fitf, data.x, data.y, data.sigma, std::move(start) );
 
-}
\ No newline at end of file
+}
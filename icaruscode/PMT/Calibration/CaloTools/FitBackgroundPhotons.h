@@ -8,8 +8,8 @@
 #include <vector>
 
 #include "TH1D.h"
-#include "TF1.h"
 #include "IdealPmtResponse.h"
+#include "icaruscode/Utilities/LeastSquaresFitter.h"
 
 
 //namespace pmtcalo{
@@ -20,16 +20,29 @@ class FitBackgroundPhotons {
 
 	public: 
 
+		/// Content of a histogram in the fit range, detached from ROOT.
+		struct HistogramData_t {
+			std::vector<double> x;      // bin centers
+			std::vector<double> y;      // bin contents
+			std::vector<double> sigma;  // bin errors
+			double integral = 0;        // integral of the whole histogram
+		};
+
 		FitBackgroundPhotons();
 		FitBackgroundPhotons( unsigned int nparameters, IdealPmtResponse fitf );
 
-		void fitHistogram( TH1D *hist, std::string fitoption="RQ0+" );
+		void fitHistogram( TH1D *hist );
+
+		// Thread-safe interface: extract the data (ROOT objects are not
+		// thread-safe) then fit them, possibly in parallel
+		HistogramData_t extractData( TH1D const& hist ) const;
+		util::LeastSquaresFitter::Result_t fitData( HistogramData_t const& data ) const;
 
-		float getParameter(int num){ return m_vresults[num]; };
-		float getParError(int num){ return m_verrors[num]; };
-		float getChi2(){ return m_fitf->GetChisquare(); };
-		int getNDF(){ return m_fitf->GetNDF(); };
-		int getFitStatus(){ return m_fitstatus; };
+		float getParameter(int num){ return m_result.parameters[num]; };
+		float getParError(int num){ return m_result.errors[num]; };
+		float getChi2(){ return m_result.chi2; };
+		int getNDF(){ return m_result.ndf; };
+		int getFitStatus(){ return m_result.status; };
 
 		void setFitRange( float low, float high ){ m_fitrange[0]=low; m_fitrange[1]=high; };
 		void getFitRange( float &low, float &high ){ low=m_fitrange[0]; high=m_fitrange[1]; };
@@ -37,17 +50,13 @@ class FitBackgroundPhotons {
 	private: 
 
 		unsigned int m_nparameters=6;
-		int m_maxrefit=4;
-		int m_fitstatus=-99;
 
 		float m_fitrange[2] = { 0.1, 2 };
 
-		TF1 *m_fitf;
+		IdealPmtResponse m_fitf;
 
-		//float m_start[m_nparameters]
-		std::vector<float> m_vresults; //(m_nparameters, 1.);
-		std::vector<float> m_verrors;// (m_nparameters, 1.);
+		util::LeastSquaresFitter::Result_t m_result;
 
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -44,19 +44,69 @@ class  IdealPmtResponse {
       
 		};
 
+		// same function, also filling the derivatives in grad (for LeastSquaresFitter)
+		double operator() (double x, double const* par, double* grad) const {
+
+			double const mu = par[0];
+			double const q = par[1];
+			double const sigma = par[2];
+			double const amplitude = par[3];
+
+			grad[0] = grad[1] = grad[2] = grad[3] = 0.0;
+
+			double val = 0;
+
+			for( int n=m_nstart; n<m_nstart+m_nsum; n++ ){
+
+				// Poisson term and its derivative in mu (written to be finite at mu = 0)
+				double const poisson = TMath::Power(mu,n)*TMath::Exp(-1.0*mu)/TMath::Factorial(n);
+				double const dpoisson = ( n > 0 ? TMath::Power(mu,n-1)*TMath::Exp(-1.0*mu)/TMath::Factorial(n-1) : 0.0 ) - poisson;
+
+				double const d = x - q*n;
+				double const gauss = TMath::Exp(-1.0*d*d/(2.0*n*sigma*sigma))/(sigma*TMath::Sqrt(2.0*TMath::Pi()*n));
+
+				val += amplitude*poisson*gauss;
+
+				grad[0] += amplitude*dpoisson*gauss;
+				grad[1] += amplitude*poisson*gauss*d/(sigma*sigma);
+				grad[2] += amplitude*poisson*gauss*( d*d/(n*sigma*sigma*sigma) - 1.0/sigma );
+				grad[3] += poisson*gauss;
+
+			}
+
+			if( m_useExpPedestal ){
+
+				double const a0 = par[4];
+				double const c0 = par[5];
+
+				double const ped = pedestal( x, 1.0, c0 );
+
+				val += a0*ped;
+
+				grad[4] = ped;
+				grad[5] = a0*x*ped;
+			}
+
+			return val;
+
+		};
+
+		/// Number of parameters used by the function.
+		unsigned int nParameters() const { return m_useExpPedestal? 6: 4; }
+
 	private: 
 
 		int m_nstart=1;
 		int m_nsum=4;
 		bool m_useExpPedestal=false;
 
-		double pedestal( double x, double a0, double c0 ){
+		double pedestal( double x, double a0, double c0 ) const {
 
 			return a0*TMath::Exp( x*c0 );
              
 		}
 
-		double poissonGauss( double x, double amplitude, double n, double mu, double q, double sigma ){
+		double poissonGauss( double x, double amplitude, double n, double mu, double q, double sigma ) const {
 
 			return amplitude*(TMath::Power(mu,n)*TMath::Exp(-1.0*mu)/TMath::Factorial(n)
                 *TMath::Exp(-1.0*(x-q*n)*(x-q*n)/(2.0*n*sigma*sigma))/(sigma*TMath::Sqrt(2.0*TMath::Pi()*n))) ;
@@ -222,7 +222,8 @@ namespace pmtcalo
       // the given m_nbins interval, the maximum, the position at maximum
       //
       // if m_dofit is set to true:
-      //  1) An exp gauss function is fitted to the pulse
+      //  1) An exp gauss function is fitted to the pulse samples (least squares
+      //     with analytic derivatives, see LeastSquaresFitter)
       //  2) A limit on the peak amplutude is configurable to skip waveform under
       //     the selected threshold
       //  3) the fit is perfomed in a rage around the maximum, controlled my
@@ -244,26 +245,27 @@ namespace pmtcalo
             t_max = (m_startbin+m_nbins)*m_sampling_period;
         }
 
-        // Crop the area around the pulse of the waveform and return a TH1D
-        TH1D* h_pulse = this->makeWaveformHist();
+        // Collect the samples in the fit range; all have the same uncertainty
+        std::vector<double> times, values;
+        double sum = 0;
+        for( int bin=m_startbin; bin<m_startbin+m_nbins; bin++ ){
+          sum += m_waveform[bin];
+          double const t = bin*m_sampling_period;
+          if( t < t_min || t > t_max ) continue;
+          times.push_back( t );
+          values.push_back( m_waveform[bin] );
+        }
 
-        char funcname[100]; sprintf(funcname, "func_pulse_direct");
+        PulseShapeFunction_ExpGaus const function_obj;
+        util::LeastSquaresFitter::Result_t const fit = m_pulsefitter.fit(
+          function_obj, times, values, {},
+          { temp_pulse.time_peak - 5, 2, 0.1, 2.0*sum }
+          );
+        int const status = fit.status;
 
-        PulseShapeFunction_ExpGaus function_obj;
-        TF1* func = new TF1(funcname, function_obj, t_min, t_max, 4);
-        func->SetParNames("t0","#mu","#sigma","a");
-        func->SetParameters(temp_pulse.time_peak - 5, 2, 0.1, 2.0*h_pulse->Integral() );
-        int status = h_pulse->Fit(funcname,"RQN","",t_min, t_max);
-
-        // Refit two more times with the latest version of the parameters
-        double par[5];
-        for(int k=0; k<2; k++){
-          for(int j=0; j<4; j++){
-            par[j] = func->GetParameter(j);
-            func->SetParameter(j,par[j]);
-          }
-          status = h_pulse->Fit(funcname,"RQN","",t_min, t_max);
-        }
+        double grad[4];
+        auto const fitfunc
+          = [&](double t){ return function_obj(t, fit.parameters.data(), grad); };
 
         //If the fit status is ok we calculated the rising time as the time
         // when the fitted function has value 10% of its max
@@ -281,31 +283,29 @@ namespace pmtcalo
           double max=0.0;
           for(int i=0; i<npoints; i++){
             double t=t_start + dt*i;
-            if(max < func->Eval(t) ){ max = func->Eval(t); };
+            max = std::max( max, fitfunc(t) );
           }
 
           double startval = 0.1 * max;
           for(int i=0; i<npoints; i++){
             double t=t_start + dt*i;
-            if(startval < func->Eval(t) ){ first_spe_time = t; break; };
+            if(startval < fitfunc(t) ){ first_spe_time = t; break; };
           }
         }
 
         // Save the fit paramteters to the pulse object
         temp_pulse.fit_start_time = first_spe_time;
         temp_pulse.error_start_time = dt; // TODO: need a correct error propagation
-        temp_pulse.fit_mu = func->GetParameter(1);
-        temp_pulse.error_mu = func->GetParError(1);
-        temp_pulse.fit_sigma = func->GetParameter(2);
-        temp_pulse.error_sigma = func->GetParError(2);
-        temp_pulse.fit_amplitude = func->GetParameter(3);
-        temp_pulse.error_amplitude = func->GetParError(3);
-        temp_pulse.chi2 = func->GetChisquare();
-        temp_pulse.ndf = func->GetNDF();
+        temp_pulse.fit_mu = fit.parameters[1];
+        temp_pulse.error_mu = fit.errors[1];
+        temp_pulse.fit_sigma = fit.parameters[2];
+        temp_pulse.error_sigma = fit.errors[2];
+        temp_pulse.fit_amplitude = fit.parameters[3];
+        temp_pulse.error_amplitude = fit.errors[3];
+        temp_pulse.chi2 = fit.chi2;
+        temp_pulse.ndf = fit.ndf;
         temp_pulse.fitstatus = status;
 
-        delete h_pulse;
-
       }
 
       return temp_pulse;
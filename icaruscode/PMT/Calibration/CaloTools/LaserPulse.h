@@ -13,10 +13,13 @@
 #include <stdio.h>
 #include <numeric>
 #include <complex>
+#include <cmath>
 
 #include "fhiclcpp/ParameterSet.h"
 #include "lardataobj/RawData/OpDetWaveform.h"
 
+#include "icaruscode/Utilities/LeastSquaresFitter.h"
+
 #include "TH1D.h"
 #include "TMath.h"
 #include "TF1.h"
@@ -44,6 +47,30 @@ namespace pmtcalo
         return a*c/2.0*TMath::Exp(c*c*w*w/2.0)*TMath::Exp(-1.0*c*(t-t0))
                                      * TMath::Erfc( 1.0/1.414* (c*w-(t-t0)/w) );
       }
+
+      // same function, also filling the derivatives in grad (for LeastSquaresFitter)
+      double operator() (double t, double const* par, double* grad) const {
+        double const t0 = par[0];
+        double const w = par[1];
+        double const c = par[2];
+        double const a = par[3];
+
+        double const k = 1.0/1.414;
+        double const u = t - t0;
+        double const z = k*(c*w - u/w);
+        double const E = std::exp(c*c*w*w/2.0 - c*u);
+        double const C = std::erfc(z);
+        double const dC = -2.0/std::sqrt(M_PI)*std::exp(-z*z); // d erfc(z) / dz
+
+        double const f = a*c/2.0*E*C;
+
+        grad[0] = a*c/2.0*E*( c*C + dC*k/w );                 // d/dt0
+        grad[1] = a*c/2.0*E*( c*c*w*C + dC*k*(c + u/(w*w)) ); // d/dw
+        grad[2] = a/2.0*E*( C + c*(c*w*w - u)*C + c*dC*k*w ); // d/dc
+        grad[3] = c/2.0*E*C;                                  // d/da
+
+        return f;
+      }
   };
 
   class LaserPulse
@@ -129,6 +156,7 @@ namespace pmtcalo
         bool m_dofit;
         double m_pulsethreshold; // in mV
         std::vector<double> m_fitrange;
+        util::LeastSquaresFitter m_pulsefitter{ 4 };
 
         double m_baseline_mean;
 
@@ -36,6 +36,8 @@
 #include "icaruscode/IcarusObj/PMTWaveformTimeCorrection.h"
 #include "icaruscode/PMT/Calibration/CaloTools/LaserPulse.h"
 
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
 
 #include "TTree.h"
 
@@ -254,19 +256,48 @@ void pmtcalo::PMTLaserCalibration::analyze(art::Event const& event)
   if( event.getByLabel(fOpDetWaveformLabel, rawWaveformHandle) ) {
 
 
+    // We are interesed only in the illuminated channels 
+    std::vector<raw::OpDetWaveform const*> laserWaveforms;
     for( auto const& raw_waveform : (*rawWaveformHandle) ) {
+      if( isIlluminated(raw_waveform.ChannelNumber()) )
+        laserWaveforms.push_back( &raw_waveform );
+    }
 
-      raw::Channel_t channelId = raw_waveform.ChannelNumber();
+    // Analyze the waveforms in parallel: each task works on its own copy
+    // of the waveform analysis object
+    struct LaserPulseResult_t {
+      LaserPulse::Pulse pulse;
+      float totalCharge = 0;
+    };
+    std::vector<LaserPulseResult_t> results( laserWaveforms.size() );
+
+    tbb::parallel_for( tbb::blocked_range<std::size_t>(0, laserWaveforms.size()),
+      [this, &laserWaveforms, &results](tbb::blocked_range<std::size_t> const& range){
+
+        LaserPulse waveformAna{ *myWaveformAna };
 
-      // We are interesed only in the illuminated channels 
-      if( !isIlluminated(channelId) ){ continue; }
+        for( std::size_t i=range.begin(); i<range.end(); i++ ){
+
+          waveformAna.loadData( *laserWaveforms[i] );
+          results[i].pulse = waveformAna.getLaserPulse();
+          results[i].totalCharge = waveformAna.getTotalCharge();
+
+          // Prepare for the next waveform
+          waveformAna.clean();
+
+        }
+      }
+    );
+
+    for( std::size_t i=0; i<laserWaveforms.size(); i++ ) {
+
+      raw::OpDetWaveform const& raw_waveform = *laserWaveforms[i];
+      LaserPulse::Pulse const& pulse = results[i].pulse;
+
+      raw::Channel_t channelId = raw_waveform.ChannelNumber();
 
       m_channel_id->push_back( channelId );
      
-
-      myWaveformAna->loadData( raw_waveform );
-      auto pulse = myWaveformAna->getLaserPulse();
-      
       // Mostly here we fill up our TTrees
       m_peak_time->push_back( pulse.time_peak );
       
@@ -274,7 +305,7 @@ void pmtcalo::PMTLaserCalibration::analyze(art::Event const& event)
       
       m_integral->push_back( pulse.integral );
       
-      m_total_charge->push_back( myWaveformAna->getTotalCharge() );
+      m_total_charge->push_back( results[i].totalCharge );
 
       // NB sampling period should be taken from services
       double laser_time = raw_waveform.TimeStamp() + pulse.fit_start_time/1000.; 
@@ -317,9 +348,6 @@ void pmtcalo::PMTLaserCalibration::analyze(art::Event const& event)
 
       m_fitstatus->push_back(pulse.fitstatus);
 
-      // Prepare for the next event
-      myWaveformAna->clean();
-
     } // end loop over pmt channels
 
     m_pulse_ttree->Fill();
@@ -6,9 +6,13 @@
 #include "CaloTools/IdealPmtResponse.h"
 #include "CaloTools/FitBackgroundPhotons.h"
 
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+
 #include <stdio.h>
 #include <fstream>
 #include <iostream>
+#include <vector>
 
 
 int main( int argc, char **argv ){
@@ -90,7 +94,15 @@ int main( int argc, char **argv ){
     std::cout << line << std::endl;
 
 
-  // Now we fit the histograms
+  // Now we read the histograms: ROOT input is not thread-safe, so this is serial
+  struct PMTData_t {
+    int pmt;
+    int nentries;
+    FitBackgroundPhotons::HistogramData_t data;
+    util::LeastSquaresFitter::Result_t result;
+  };
+  std::vector<PMTData_t> pmtData;
+
   for( int pmt=startch; pmt<=endch; pmt++ )
   {
 
@@ -113,17 +125,31 @@ int main( int argc, char **argv ){
     int nentries = hintegral->GetEntries();
     if( nentries < 100 ){ continue; }
 
-    // Do the fit 
-    fitPMTResponse.fitHistogram( hintegral, "RQ0" );
+    pmtData.push_back( { pmt, nentries, fitPMTResponse.extractData( *hintegral ), {} } );
+
+  }
+
+  // Do the fits, in parallel
+  tbb::parallel_for( tbb::blocked_range<std::size_t>(0, pmtData.size()),
+    [&pmtData, &fitPMTResponse](tbb::blocked_range<std::size_t> const& range){
+      for( std::size_t i=range.begin(); i<range.end(); i++ )
+        pmtData[i].result = fitPMTResponse.fitData( pmtData[i].data );
+    }
+  );
+
+  // Write the results to file
+  for( PMTData_t const& pmtInfo: pmtData )
+  {
+
+    util::LeastSquaresFitter::Result_t const& result = pmtInfo.result;
 
-    // Write the results to file
-    std::string line = std::to_string(pmt) + "," + std::to_string(nentries) + "," ;
+    std::string line = std::to_string(pmtInfo.pmt) + "," + std::to_string(pmtInfo.nentries) + "," ;
 
     for( int i=0; i<4; i++ )
-      line += std::to_string(fitPMTResponse.getParameter(i)) + "," + std::to_string(fitPMTResponse.getParError(i)) + "," ;
+      line += std::to_string(float(result.parameters[i])) + "," + std::to_string(float(result.errors[i])) + "," ;
 
-    line += std::to_string(fitPMTResponse.getChi2()) + "," + std::to_string(fitPMTResponse.getNDF()) + "," ;
-    line += std::to_string(fitPMTResponse.getFitStatus()) + "\n" ;
+    line += std::to_string(float(result.chi2)) + "," + std::to_string(result.ndf) + "," ;
+    line += std::to_string(result.status) + "\n" ;
 
     myfile << line;
 
@@ -13,6 +13,7 @@
 // ICARUS libraries
 #include "icaruscode/PMT/SinglePhotonPulseFunctionTool.h"
 #include "icaruscode/PMT/Algorithms/CustomPulseFunction.h"
+#include "icaruscode/PMT/Algorithms/TabulatedPulseFunction.h"
 
 // LArSoft libraries
 #include "lardataalg/Utilities/quantities/electromagnetism.h" // picocoulomb
@@ -21,16 +22,28 @@
 // framework libraries
 #include "art/Utilities/ToolConfigTable.h"
 #include "art/Utilities/ToolMacros.h"
+#include "canvas/Utilities/Exception.h"
 
 // framework libraries
 #include "messagefacility/MessageLogger/MessageLogger.h"
 #include "fhiclcpp/types/OptionalDelegatedParameter.h"
+#include "fhiclcpp/types/OptionalAtom.h"
 #include "fhiclcpp/types/Atom.h"
 #include "fhiclcpp/ParameterSet.h"
 
 // C/C++ standard libraries
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <ios> // std::hexfloat
 #include <memory> // std::unique_ptr()
+#include <optional>
+#include <exception> // std::exception
+#include <string>
+#include <functional> // std::hash
+#include <system_error> // std::error_code
 #include <cassert>
+#include <unistd.h> // getpid()
 
 
 //------------------------------------------------------------------------------
@@ -70,6 +83,20 @@ namespace icarus::opdet { struct CustomPulseFunctionTool; }
  *   parameter in `ShapeFormula` and no extra values; if `ShapeFormula` has
  *   no parameters, the `Parameters` table can be omitted.
  * 
+ * * **TabulationStep** (time, optional): if specified, the shape is evaluated
+ *   once, at construction, every this much time, and then linearly
+ *   interpolated from that table (`icarus::opdet::TabulatedPulseFunction`);
+ *   the formula is then never evaluated again, which is much faster;
+ *   for example: `"0.05 ns"`;
+ * * **TabulationDuration** (time, default: `1 us`): the extent of the table,
+ *   starting from `x = 0`; after that time, the pulse is considered to be
+ *   ended; it must not be negative;
+ * * **TabulationCache** (string, default: empty): path of a directory where the
+ *   tabulated shapes are saved; if a shape with the same formula, parameters
+ *   and tabulation settings is found there, it is loaded and the formula is
+ *   not even compiled; if empty, no cache is used. A cache file which can't be
+ *   read is ignored, and the shape is tabulated again.
+ * 
  * @note Because of the limitations of FHiCL language in `Parameters`
  *       specification, the names of the parameters need to be simple (e.g.
  *       `[mu]` rather than `[#mu]`).
@@ -98,6 +125,20 @@ struct icarus::opdet::CustomPulseFunctionTool
       Name("Parameters"),
       Comment("collection of parameter names and their numerical values")
       };
+    fhicl::OptionalAtom<nanoseconds> TabulationStep {
+      Name("TabulationStep"),
+      Comment("if set, the shape is tabulated with this time step")
+      };
+    fhicl::Atom<nanoseconds> TabulationDuration {
+      Name("TabulationDuration"),
+      Comment("time interval covered by the tabulated shape"),
+      nanoseconds{ 1000.0 }
+      };
+    fhicl::Atom<std::string> TabulationCache {
+      Name("TabulationCache"),
+      Comment("directory of the tabulated shape cache (empty: no cache)"),
+      ""
+      };
     
   }; // struct Config
 
@@ -124,10 +165,31 @@ struct icarus::opdet::CustomPulseFunctionTool
   std::unique_ptr<PulseFunction_t> fPulseFunction;
   
   
+  using CustomFunction_t = icarus::opdet::CustomPulseFunction<nanoseconds>;
+  using TabulatedFunction_t
+    = icarus::opdet::TabulatedPulseFunction<nanoseconds>;
+  
   /// Creates and returns a pulse function with the specified configuration.
   static std::unique_ptr<PulseFunction_t> makePulseFunction
     (Config const& config);
   
+  /// Creates and returns the formula-based pulse function.
+  static std::unique_ptr<CustomFunction_t> makeCustomPulseFunction
+    (Config const& config);
+  
+  /// Returns a string identifying the configured shape and its tabulation.
+  static std::string tabulationKey(Config const& config);
+  
+  /// Returns the tabulated shape with the specified `key` from the cache.
+  static std::optional<TabulatedFunction_t> readFromCache
+    (std::filesystem::path const& path, std::string const& key);
+  
+  /// Saves the tabulated `shape` with the specified `key` into the cache.
+  static void writeToCache(
+    std::filesystem::path const& path, std::string const& key,
+    TabulatedFunction_t const& shape
+    );
+  
   
 }; // icarus::opdet::CustomPulseFunctionTool
 
@@ -139,7 +201,51 @@ auto icarus::opdet::CustomPulseFunctionTool::makePulseFunction
   (Config const& config) -> std::unique_ptr<PulseFunction_t>
 {
   
-  using MyFunction_t = icarus::opdet::CustomPulseFunction<nanoseconds>;
+  std::optional<nanoseconds> const step = config.TabulationStep();
+  if (!step) return makeCustomPulseFunction(config);
+  
+  if (config.TabulationDuration() < nanoseconds{ 0.0 }) {
+    throw art::Exception(art::errors::Configuration)
+      << "CustomPulseFunctionTool: '" << config.TabulationDuration.name()
+      << "' must not be negative (" << config.TabulationDuration()
+      << " was specified)!\n";
+  }
+  
+  //
+  // tabulated shape: look into the cache first
+  //
+  std::string const key = tabulationKey(config);
+  std::filesystem::path cachePath;
+  if (!config.TabulationCache().empty()) {
+    cachePath = std::filesystem::path{ config.TabulationCache() }
+      / ("CustomPulseFunction_" + std::to_string(std::hash<std::string>{}(key))
+         + ".table");
+    std::optional<TabulatedFunction_t> shape = readFromCache(cachePath, key);
+    if (shape) {
+      mf::LogDebug("CustomPulseFunctionTool")
+        << "Tabulated pulse shape read from '" << cachePath.string() << "'.";
+      return std::make_unique<TabulatedFunction_t>(std::move(*shape));
+    }
+  } // if cache
+  
+  auto shape = std::make_unique<TabulatedFunction_t>(
+    *makeCustomPulseFunction(config),
+    nanoseconds{ 0.0 }, config.TabulationDuration(), *step
+    );
+  
+  if (!cachePath.empty()) writeToCache(cachePath, key, *shape);
+  
+  return shape;
+  
+} // icarus::opdet::CustomPulseFunctionTool::makePulseFunction()
+
+
+//------------------------------------------------------------------------------
+auto icarus::opdet::CustomPulseFunctionTool::makeCustomPulseFunction
+  (Config const& config) -> std::unique_ptr<CustomFunction_t>
+{
+  
+  using MyFunction_t = CustomFunction_t;
   
   std::string const& expression = config.ShapeFormula();
   
@@ -170,7 +276,98 @@ auto icarus::opdet::CustomPulseFunctionTool::makePulseFunction
   
   return std::make_unique<MyFunction_t>(expression, parameters, peakTimeStr);
   
-} // icarus::opdet::CustomPulseFunctionTool::makePulseFunction()
+} // icarus::opdet::CustomPulseFunctionTool::makeCustomPulseFunction()
+
+
+//------------------------------------------------------------------------------
+std::string icarus::opdet::CustomPulseFunctionTool::tabulationKey
+  (Config const& config)
+{
+  fhicl::ParameterSet configuredParameters; // will stay empty if not present
+  config.Parameters.get_if_present(configuredParameters);
+  
+  // numbers are written exactly
+  std::ostringstream sstr;
+  sstr << std::hexfloat
+    << "ShapeFormula: " << config.ShapeFormula()
+    << "\nPeakTime: " << config.PeakTime()
+    << "\nParameters:";
+  for (auto const& parName: configuredParameters.get_names())
+    sstr << " " << parName << "=" << configuredParameters.get<double>(parName);
+  sstr
+    << "\nTabulationStep: " << config.TabulationStep()->value()
+    << "\nTabulationDuration: " << config.TabulationDuration().value();
+  return std::move(sstr).str();
+} // icarus::opdet::CustomPulseFunctionTool::tabulationKey()
+
+
+//------------------------------------------------------------------------------
+auto icarus::opdet::CustomPulseFunctionTool::readFromCache
+  (std::filesystem::path const& path, std::string const& key)
+  -> std::optional<TabulatedFunction_t>
+{
+  // a failure to read the cache is not fatal: the shape is tabulated again
+  std::optional<TabulatedFunction_t> shape;
+  try {
+    std::ifstream in { path, std::ios::binary };
+    if (!in) return std::nullopt;
+    
+    // the key is stored first, to protect against hash collisions
+    std::string storedKey;
+    if (!std::getline(in, storedKey, '\0') || (storedKey != key)) {
+      mf::LogDebug("CustomPulseFunctionTool")
+        << "Cache file '" << path.string() << "' is for a different shape.";
+      return std::nullopt;
+    }
+    
+    shape = TabulatedFunction_t::read(in);
+  }
+  catch (std::exception const& e) {
+    mf::LogWarning("CustomPulseFunctionTool")
+      << "Failed to read the cache file '" << path.string() << "' ("
+      << e.what() << "); it will be ignored.";
+    return std::nullopt;
+  }
+  
+  if (!shape) {
+    mf::LogWarning("CustomPulseFunctionTool")
+      << "Cache file '" << path.string()
+      << "' is corrupted and will be ignored.";
+  }
+  return shape;
+} // icarus::opdet::CustomPulseFunctionTool::readFromCache()
+
+
+//------------------------------------------------------------------------------
+void icarus::opdet::CustomPulseFunctionTool::writeToCache(
+  std::filesystem::path const& path, std::string const& key,
+  TabulatedFunction_t const& shape
+) {
+  // a failure to write the cache is not fatal: the shape is still available;
+  // the file is written under a temporary name and then atomically renamed,
+  // so that concurrent jobs never read a partial file
+  std::error_code ec;
+  std::filesystem::create_directories(path.parent_path(), ec);
+  
+  std::filesystem::path tempPath = path;
+  tempPath += ".tmp" + std::to_string(::getpid());
+  {
+    std::ofstream out { tempPath, std::ios::binary };
+    out.write(key.c_str(), key.size() + 1); // including the terminator
+    shape.write(out);
+    if (!out) ec = std::make_error_code(std::errc::io_error);
+  }
+  if (!ec) std::filesystem::rename(tempPath, path, ec);
+  if (ec) {
+    std::filesystem::remove(tempPath, ec);
+    mf::LogWarning("CustomPulseFunctionTool")
+      << "Failed to save the tabulated pulse shape into '" << path.string()
+      << "'.";
+    return;
+  }
+  mf::LogDebug("CustomPulseFunctionTool")
+    << "Tabulated pulse shape saved into '" << path.string() << "'.";
+} // icarus::opdet::CustomPulseFunctionTool::writeToCache()
 
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,83 @@
+/**
+ * @file   icaruscode/PMT/OpReco/Algorithms/BarycenterMatchMatrix.cxx
+ * @brief  Distances between charge and light barycenters of slices and flashes.
+ * @date   October 19, 2026
+ * @see    icaruscode/PMT/OpReco/Algorithms/BarycenterMatchMatrix.h
+ */
+
+// library header
+#include "icaruscode/PMT/OpReco/Algorithms/BarycenterMatchMatrix.h"
+
+// C/C++ standard libraries
+#include <cassert>
+#include <utility> // std::move()
+
+
+// -----------------------------------------------------------------------------
+void icarus::opdet::BarycenterMatchMatrix::setFlashes
+  (std::vector<double> centerY, std::vector<double> centerZ)
+{
+  assert(centerY.size() == centerZ.size());
+  fFlashY = std::move(centerY);
+  fFlashZ = std::move(centerZ);
+  fDistance2.clear();
+  fNSlices = 0;
+} // icarus::opdet::BarycenterMatchMatrix::setFlashes()
+
+
+// -----------------------------------------------------------------------------
+std::size_t icarus::opdet::BarycenterMatchMatrix::addSlice
+  (double centerY, double centerZ)
+{
+  std::size_t const n = nFlashes();
+  std::size_t const offset = fDistance2.size();
+  fDistance2.resize(offset + n);
+
+  double* const row = fDistance2.data() + offset;
+  double const* const flashY = fFlashY.data();
+  double const* const flashZ = fFlashZ.data();
+  for (std::size_t flash = 0; flash < n; ++flash) {
+    double const dy = flashY[flash] - centerY;
+    double const dz = flashZ[flash] - centerZ;
+    row[flash] = dy * dy + dz * dz;
+  }
+
+  return fNSlices++;
+} // icarus::opdet::BarycenterMatchMatrix::addSlice()
+
+
+// -----------------------------------------------------------------------------
+std::size_t icarus::opdet::BarycenterMatchMatrix::addSlice
+  (double centerY, double centerZ, std::vector<bool> const& candidates)
+{
+  assert(candidates.size() == nFlashes());
+
+  std::size_t const slice = addSlice(centerY, centerZ);
+
+  double* const row = fDistance2.data() + slice * nFlashes();
+  for (std::size_t flash = 0; flash < nFlashes(); ++flash)
+    if (!candidates[flash]) row[flash] = std::numeric_limits<double>::infinity();
+
+  return slice;
+} // icarus::opdet::BarycenterMatchMatrix::addSlice(candidates)
+
+
+// -----------------------------------------------------------------------------
+std::size_t icarus::opdet::BarycenterMatchMatrix::bestFlash
+  (std::size_t slice) const
+{
+  std::size_t const n = nFlashes();
+  double const* const row = fDistance2.data() + slice * n;
+
+  std::size_t best = NoMatch;
+  double minDistance2 = MaxDistance * MaxDistance;
+  for (std::size_t flash = 0; flash < n; ++flash) {
+    if (!(row[flash] < minDistance2)) continue; // also skips NaN distances
+    minDistance2 = row[flash];
+    best = flash;
+  }
+  return best;
+} // icarus::opdet::BarycenterMatchMatrix::bestFlash()
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,105 @@
+/**
+ * @file   icaruscode/PMT/OpReco/Algorithms/BarycenterMatchMatrix.h
+ * @brief  Distances between charge and light barycenters of slices and flashes.
+ * @date   October 19, 2026
+ * @see    icaruscode/PMT/OpReco/Algorithms/BarycenterMatchMatrix.cxx
+ */
+
+#ifndef ICARUSCODE_PMT_OPRECO_ALGORITHMS_BARYCENTERMATCHMATRIX_H
+#define ICARUSCODE_PMT_OPRECO_ALGORITHMS_BARYCENTERMATCHMATRIX_H
+
+
+// C/C++ standard libraries
+#include <cmath> // std::sqrt()
+#include <cstddef> // std::size_t
+#include <limits>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::opdet { class BarycenterMatchMatrix; }
+/**
+ * @brief Matrix of the distances between slice and flash barycenters.
+ *
+ * The barycenters of the flashes on the PMT plane (_y_ and _z_ coordinates)
+ * are set once per event with `setFlashes()`; then each slice with charge
+ * adds a row to the matrix with `addSlice()`, which computes its distance from
+ * all the flashes in a single pass over contiguous arrays.
+ * A slice may be restricted to a subset of the flashes (e.g. the ones
+ * compatible with its time), in which case the distance from the others is
+ * infinite.
+ *
+ * `bestFlash()` returns for a slice the index of the closest candidate flash.
+ * Each slice is matched independently: a flash may be the best match of many
+ * slices.
+ *
+ * Example of usage:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * icarus::opdet::BarycenterMatchMatrix matrix;
+ * matrix.setFlashes(std::move(flashCenterY), std::move(flashCenterZ));
+ *
+ * std::size_t const slice = matrix.addSlice(chargeCenterY, chargeCenterZ);
+ * std::size_t const flash = matrix.bestFlash(slice);
+ * if (flash != icarus::opdet::BarycenterMatchMatrix::NoMatch) {
+ *   double const radius = matrix.distance(slice, flash);
+ *   // ...
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class icarus::opdet::BarycenterMatchMatrix {
+
+    public:
+
+  /// Value returned by `bestFlash()` when no flash is a candidate.
+  static constexpr std::size_t NoMatch = std::numeric_limits<std::size_t>::max();
+
+  /// Flashes farther than this from the slice are never matched [cm].
+  static constexpr double MaxDistance = 1e6;
+
+
+  /// Sets the barycenters of the flashes [cm]; all the slices are removed.
+  void setFlashes(std::vector<double> centerY, std::vector<double> centerZ);
+
+  /// Adds a slice with its charge barycenter [cm]; returns its index.
+  std::size_t addSlice(double centerY, double centerZ);
+
+  /**
+   * @brief Adds a slice which can match only some of the flashes.
+   * @param centerY _y_ coordinate of the charge barycenter [cm]
+   * @param centerZ _z_ coordinate of the charge barycenter [cm]
+   * @param candidates whether each flash is a candidate for this slice
+   * @return the index of the slice
+   */
+  std::size_t addSlice
+    (double centerY, double centerZ, std::vector<bool> const& candidates);
+
+  /// Number of slices in the matrix.
+  std::size_t nSlices() const { return fNSlices; }
+
+  /// Number of flashes in the matrix.
+  std::size_t nFlashes() const { return fFlashY.size(); }
+
+  /// Returns the distance of `slice` and `flash` on the PMT plane [cm].
+  double distance(std::size_t slice, std::size_t flash) const
+    { return std::sqrt(fDistance2[slice * nFlashes() + flash]); }
+
+  /// Returns the closest candidate flash (first if tied), or `NoMatch`.
+  std::size_t bestFlash(std::size_t slice) const;
+
+
+    private:
+
+  std::vector<double> fFlashY; ///< _y_ of the flash barycenters.
+  std::vector<double> fFlashZ; ///< _z_ of the flash barycenters.
+
+  /// Squared distances, one row of `nFlashes()` entries per slice.
+  std::vector<double> fDistance2;
+
+  std::size_t fNSlices = 0; ///< Number of slices.
+
+}; // icarus::opdet::BarycenterMatchMatrix
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSCODE_PMT_OPRECO_ALGORITHMS_BARYCENTERMATCHMATRIX_H
@@ -0,0 +1,376 @@
+/**
+ * @file   icaruscode/PMT/OpReco/Algorithms/benchmarkBarycenterMatch.cxx
+ * @brief  Compares nested-loop and matrix slice-flash barycenter matching.
+ * @date   October 19, 2026
+ *
+ * The program runs on synthetic events the matching of
+ * `TPCPMTBarycenterMatchProducer`: each slice with charge is matched to the
+ * closest flash on the PMT plane among the ones compatible with its time
+ * range, and the time of the first hit and the PE asymmetry of the matched
+ * flash are extracted. It does so in two ways:
+ *
+ * * _nested_: for each slice, a loop on all the flashes and the extraction of
+ *   the flash information at each match (the original module);
+ * * _matrix_: flash barycenters tabulated once per event, distances scored in
+ *   a `icarus::opdet::BarycenterMatchMatrix` and flash information extracted
+ *   once per matched flash.
+ *
+ * The results of the two are checked to be the same, and the number of
+ * events per second is printed for both.
+ * The look up of the associated data products in the _art_ event, which the
+ * module now performs once per event rather than once per slice, is not
+ * included. Run `benchmarkBarycenterMatch --help` for the options.
+ */
+
+// ICARUS libraries
+#include "icaruscode/PMT/OpReco/Algorithms/BarycenterMatchMatrix.h"
+
+// C++/Boost libraries
+#include "boost/program_options.hpp"
+#include <algorithm> // std::min()
+#include <chrono>
+#include <cmath> // std::hypot(), std::abs()
+#include <cstddef> // std::size_t
+#include <cstdlib> // std::exit()
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+/*
+ * Notable changes here:
+ *
+ * [20261019] [1.0]
+ *     initial version
+ *
+ */
+static std::string const ProgramVersion = "v1.0";
+
+
+// -----------------------------------------------------------------------------
+/// Parameters of the benchmark.
+struct Config_t {
+  unsigned int nSlices = 60U; ///< Slices in an event.
+  unsigned int nFlashes = 25U; ///< Flashes in an event.
+  unsigned int nEvents = 20000U; ///< Events for each measurement.
+  double timeRangeMargin = 5.0; ///< Margin of the slice time ranges [us].
+}; // Config_t
+
+
+// -----------------------------------------------------------------------------
+std::optional<Config_t> parseCommandLine(int argc, char** argv) {
+
+  namespace po = boost::program_options;
+
+  Config_t config;
+
+  po::options_description benchopt("Benchmark");
+  benchopt.add_options()
+    ("slices", po::value(&config.nSlices)->default_value(config.nSlices),
+      "slices in an event")
+    ("flashes", po::value(&config.nFlashes)->default_value(config.nFlashes),
+      "flashes in an event")
+    ("events", po::value(&config.nEvents)->default_value(config.nEvents),
+      "events processed for each measurement")
+    ("margin",
+      po::value(&config.timeRangeMargin)->default_value(config.timeRangeMargin),
+      "margin of the slice time ranges [us]")
+    ;
+
+  po::options_description genopt("General");
+  genopt.add_options()
+    ("help,?", "print usage instructions and exit")
+    ("version,V", "print version and exit")
+    ;
+
+  po::options_description allopt("Options");
+  allopt.add(benchopt).add(genopt);
+
+  po::variables_map optmap;
+  po::store(po::parse_command_line(argc, argv, allopt), optmap);
+  po::notify(optmap);
+
+  std::optional<int> exitWithCode;
+  if (optmap.count("version")) {
+    std::cout << argv[0] << " version " << ProgramVersion << std::endl;
+    exitWithCode = 0;
+  }
+  if (optmap.count("help")) {
+    std::cout
+      <<   "Compares the slice-flash matching of TPCPMTBarycenterMatchProducer"
+      << "\nwith nested loops and with a distance matrix."
+      << "\n" << allopt
+      << std::endl
+      ;
+    exitWithCode = 0;
+  }
+  if (exitWithCode) std::exit(*exitWithCode);
+
+  if ((config.nSlices == 0U) || (config.nFlashes == 0U)
+    || (config.nEvents == 0U))
+  {
+    std::cerr << "No data to process!" << std::endl;
+    return std::nullopt;
+  }
+
+  return config;
+
+} // parseCommandLine()
+
+
+// -----------------------------------------------------------------------------
+/// A flash: barycenter, time, PE per PMT and time of its hits.
+struct Flash_t {
+  double centerY, centerZ; ///< Barycenter on the PMT plane [cm].
+  double time; ///< Time [us].
+  std::vector<double> PEs; ///< PE per channel (180 channels).
+  std::vector<double> hitTimes; ///< Peak time of the hits [us].
+};
+
+/// A slice: charge barycenter and allowed time range.
+struct Slice_t {
+  double centerY, centerZ; ///< Charge barycenter [cm].
+  bool hasRange; ///< Whether the time range is valid.
+  double start, stop; ///< Allowed time range [us].
+};
+
+/// An event.
+struct Event_t {
+  std::vector<Flash_t> flashes;
+  std::vector<Slice_t> slices;
+};
+
+/// Result of the matching of one slice.
+struct Match_t {
+  std::size_t flash = icarus::opdet::BarycenterMatchMatrix::NoMatch;
+  double radius = -9999.;
+  double firstHit = -9999.;
+  double asymmetry = -9999.;
+
+  bool operator== (Match_t const& other) const
+    {
+      return (flash == other.flash) && (radius == other.radius)
+        && (firstHit == other.firstHit) && (asymmetry == other.asymmetry);
+    }
+}; // Match_t
+
+
+/// Returns synthetic events, with flashes and slices spread in the detector.
+std::vector<Event_t> makeEvents(Config_t const& config, unsigned int nEvents) {
+
+  std::mt19937 engine{ 12345U };
+  std::uniform_real_distribution<double> posY{ -180.0, 130.0 };
+  std::uniform_real_distribution<double> posZ{ -900.0, 900.0 };
+  std::uniform_real_distribution<double> time{ -1500.0, 1500.0 };
+  std::uniform_real_distribution<double> driftWindow{ 0.0, 1000.0 };
+  std::exponential_distribution<double> PE{ 1.0 / 20.0 };
+  std::exponential_distribution<double> hitDelay{ 1.0 / 0.5 };
+  std::bernoulli_distribution hasRange{ 0.8 };
+
+  std::vector<Event_t> events(nEvents);
+  for (Event_t& event: events) {
+    for (unsigned int i = 0; i < config.nFlashes; ++i) {
+      Flash_t flash;
+      flash.centerY = posY(engine);
+      flash.centerZ = posZ(engine);
+      flash.time = time(engine);
+      flash.PEs.resize(180U);
+      for (double& pe: flash.PEs) pe = PE(engine);
+      flash.hitTimes.resize(120U);
+      for (double& t: flash.hitTimes) t = flash.time + hitDelay(engine);
+      event.flashes.push_back(std::move(flash));
+    }
+    for (unsigned int i = 0; i < config.nSlices; ++i) {
+      Slice_t slice;
+      slice.centerY = posY(engine);
+      slice.centerZ = posZ(engine);
+      slice.hasRange = hasRange(engine);
+      slice.start = time(engine);
+      slice.stop = slice.start + driftWindow(engine);
+      event.slices.push_back(slice);
+    }
+  } // for events
+
+  return events;
+} // makeEvents()
+
+
+/// Whether the flash `time` is compatible with the range of the `slice`.
+bool inTimeRange(Slice_t const& slice, double time, double margin) {
+  return (time >= slice.start - margin) && (time <= slice.stop + margin);
+}
+
+/// East-west PE asymmetry of `flash` (as in the module).
+double asymmetry(Flash_t const& flash) {
+  double sumEast = 0., sumWest = 0.;
+  for (int PMT = 0; PMT < 180; PMT++) {
+    if (PMT <= 89) sumEast += flash.PEs.at(PMT);
+    else sumWest += flash.PEs.at(PMT);
+  }
+  return (sumWest - sumEast) / (sumWest + sumEast);
+}
+
+/// Time of the earliest hit of `flash` (as in the module).
+double firstHitTime(Flash_t const& flash) {
+  double minTime = 1e6;
+  for (double t: flash.hitTimes) if (t < minTime) minTime = t;
+  return minTime;
+}
+
+
+/// Matches the slices of `event` with nested loops (the original module).
+void matchNested
+  (Config_t const& config, Event_t const& event, std::vector<Match_t>& matches)
+{
+  matches.assign(event.slices.size(), Match_t{});
+  for (std::size_t j = 0; j < event.slices.size(); ++j) {
+    Slice_t const& slice = event.slices[j];
+
+    int matchIndex = -5;
+    double minDistance = 1e6;
+    for (std::size_t m = 0; m < event.flashes.size(); ++m) {
+      Flash_t const& flash = event.flashes[m];
+      if (slice.hasRange
+        && !inTimeRange(slice, flash.time, config.timeRangeMargin))
+        continue;
+      double const thisDistance = std::hypot
+        (flash.centerY - slice.centerY, flash.centerZ - slice.centerZ);
+      if (thisDistance < minDistance) {
+        minDistance = thisDistance;
+        matchIndex = m;
+      }
+    } // for flashes
+    if (matchIndex == -5) continue;
+
+    Flash_t const& flash = event.flashes[matchIndex];
+    Match_t& match = matches[j];
+    match.flash = matchIndex;
+    match.radius = std::hypot(std::abs(flash.centerY - slice.centerY),
+      std::abs(flash.centerZ - slice.centerZ));
+    match.firstHit = firstHitTime(flash);
+    match.asymmetry = asymmetry(flash);
+  } // for slices
+} // matchNested()
+
+
+/// Matches the slices of `event` via the distance matrix.
+void matchMatrix(
+  Config_t const& config, Event_t const& event,
+  icarus::opdet::BarycenterMatchMatrix& matrix, std::vector<Match_t>& matches
+) {
+  std::size_t const nFlashes = event.flashes.size();
+  std::vector<double> centerY(nFlashes), centerZ(nFlashes), times(nFlashes);
+  for (std::size_t m = 0; m < nFlashes; ++m) {
+    centerY[m] = event.flashes[m].centerY;
+    centerZ[m] = event.flashes[m].centerZ;
+    times[m] = event.flashes[m].time;
+  }
+  matrix.setFlashes(std::move(centerY), std::move(centerZ));
+
+  struct FlashInfo_t { bool filled = false; double firstHit, asymmetry; };
+  std::vector<FlashInfo_t> flashInfo(nFlashes);
+  std::vector<bool> candidates(nFlashes);
+
+  matches.assign(event.slices.size(), Match_t{});
+  for (std::size_t j = 0; j < event.slices.size(); ++j) {
+    Slice_t const& slice = event.slices[j];
+
+    std::size_t row;
+    if (slice.hasRange) {
+      for (std::size_t m = 0; m < nFlashes; ++m)
+        candidates[m] = inTimeRange(slice, times[m], config.timeRangeMargin);
+      row = matrix.addSlice(slice.centerY, slice.centerZ, candidates);
+    }
+    else row = matrix.addSlice(slice.centerY, slice.centerZ);
+
+    std::size_t const matchIndex = matrix.bestFlash(row);
+    if (matchIndex == icarus::opdet::BarycenterMatchMatrix::NoMatch) continue;
+
+    Flash_t const& flash = event.flashes[matchIndex];
+    FlashInfo_t& info = flashInfo[matchIndex];
+    if (!info.filled) info = { true, firstHitTime(flash), asymmetry(flash) };
+
+    Match_t& match = matches[j];
+    match.flash = matchIndex;
+    match.radius = std::hypot(std::abs(flash.centerY - slice.centerY),
+      std::abs(flash.centerZ - slice.centerZ));
+    match.firstHit = info.firstHit;
+    match.asymmetry = info.asymmetry;
+  } // for slices
+} // matchMatrix()
+
+
+/// Returns the events per second of `process` run on all `events`.
+template <typename Process>
+double eventRate(std::vector<Event_t> const& events, Process&& process) {
+  process(events.front()); // warm up (not measured)
+  auto const start = std::chrono::steady_clock::now();
+  for (Event_t const& event: events) process(event);
+  double const seconds = std::chrono::duration<double>
+    (std::chrono::steady_clock::now() - start).count();
+  return events.size() / seconds;
+} // eventRate()
+
+
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv) {
+
+  std::optional<Config_t> const maybeConfig = parseCommandLine(argc, argv);
+  if (!maybeConfig) return 1;
+  Config_t const& config = *maybeConfig;
+
+  // the events cycle over a smaller set, to keep the memory usage limited
+  std::vector<Event_t> const events
+    = makeEvents(config, std::min(config.nEvents, 1000U));
+
+  std::cout << "Events of " << config.nSlices << " slices and "
+    << config.nFlashes << " flashes." << std::endl;
+
+  // check that the two methods agree
+  icarus::opdet::BarycenterMatchMatrix matrix;
+  std::vector<Match_t> nestedMatches, matrixMatches;
+  unsigned int nMatches = 0U, nDifferent = 0U;
+  for (Event_t const& event: events) {
+    matchNested(config, event, nestedMatches);
+    matchMatrix(config, event, matrix, matrixMatches);
+    for (std::size_t j = 0; j < nestedMatches.size(); ++j) {
+      if (nestedMatches[j].flash
+        != icarus::opdet::BarycenterMatchMatrix::NoMatch)
+      {
+        ++nMatches;
+      }
+      if (!(nestedMatches[j] == matrixMatches[j])) ++nDifferent;
+    }
+  } // for events
+  std::cout << nMatches << " matched slices in " << events.size()
+    << " events, " << nDifferent << " different matches." << std::endl;
+
+  unsigned int const nPasses
+    = (config.nEvents + events.size() - 1) / events.size();
+  double nestedRate = 0.0, matrixRate = 0.0;
+  for (unsigned int pass = 0; pass < nPasses; ++pass) {
+    nestedRate += eventRate(events,
+      [&](Event_t const& event){ matchNested(config, event, nestedMatches); });
+    matrixRate += eventRate(events,
+      [&](Event_t const& event)
+        { matchMatrix(config, event, matrix, matrixMatches); });
+  } // for passes
+  nestedRate /= nPasses;
+  matrixRate /= nPasses;
+
+  std::cout << "\n" << std::setw(16) << "nested [ev/s]"
+    << std::setw(16) << "matrix [ev/s]" << std::setw(10) << "speedup"
+    << std::endl;
+  std::cout << std::fixed << std::setprecision(1)
+    << std::setw(16) << nestedRate << std::setw(16) << matrixRate
+    << std::setprecision(2) << std::setw(10) << (matrixRate / nestedRate)
+    << std::endl;
+
+  return (nDifferent == 0U)? 0: 2;
+
+} // main()
+
+
+// -----------------------------------------------------------------------------
@@ -22,7 +22,8 @@ namespace pmtana
 
     virtual void Configure(const Config_t &p) = 0;
 
-    virtual LiteOpFlashArray_t RecoFlash(const LiteOpHitArray_t ophits) = 0;
+    /// Reconstructs the flashes from `ophits`; must be safe to call concurrently.
+    virtual LiteOpFlashArray_t RecoFlash(const LiteOpHitArray_t ophits) const = 0;
 
     virtual void Reset();
 
@@ -9,19 +9,20 @@
 
 #include "icaruscode/PMT/OpReco/Algorithms/OpHitTimeSelector.h"
 
-#include "art/Framework/Core/EDProducer.h"
+#include "art/Framework/Core/SharedProducer.h"
 #include "art/Framework/Core/ModuleMacros.h"
 #include "art/Framework/Principal/Event.h"
 #include "art/Framework/Principal/Handle.h"
 #include "art/Framework/Principal/Run.h"
 #include "art/Framework/Principal/SubRun.h"
+#include "art/Persistency/Common/PtrMaker.h"
+#include "canvas/Persistency/Common/Assns.h"
 #include "canvas/Utilities/InputTag.h"
 #include "fhiclcpp/ParameterSet.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
 #include "lardataobj/RecoBase/OpHit.h"
 #include "lardataobj/RecoBase/OpFlash.h"
-#include "lardata/Utilities/AssociationUtil.h"
 
 #include <memory>
 #include <string>
@@ -31,9 +32,9 @@
 
 class ICARUSFlashFinder;
 
-class ICARUSFlashFinder : public art::EDProducer {
+class ICARUSFlashFinder : public art::SharedProducer {
 public:
-  explicit ICARUSFlashFinder(fhicl::ParameterSet const & p);
+  explicit ICARUSFlashFinder(fhicl::ParameterSet const & p, art::ProcessingFrame const&);
   // The destructor generated by the compiler is fine for classes
   // without bare pointers or other resource use.
 
@@ -44,7 +45,7 @@ public:
   ICARUSFlashFinder & operator = (ICARUSFlashFinder &&) = delete;
 
   // Required functions.
-  void produce(art::Event & e) override;
+  void produce(art::Event & e, art::ProcessingFrame const&) override;
 
 
 private:
@@ -57,13 +58,13 @@ private:
   /// Extracts a configured time from `recob::OpHit`.
   recob::OpHitTimeSelector const fHitTime;
 
-  void GetFlashLocation(std::vector<double>, double&, double&, double&, double&);
+  void GetFlashLocation(std::vector<double>, double&, double&, double&, double&) const;
 
 };
 
 
-ICARUSFlashFinder::ICARUSFlashFinder(pmtana::Config_t const & p)
-  : EDProducer{p}
+ICARUSFlashFinder::ICARUSFlashFinder(pmtana::Config_t const & p, art::ProcessingFrame const&)
+  : SharedProducer{p}
   , fHitTime{ recob::opHitTimeType(p.get<std::string>("TimeType", "Start")) }
 // Initialize member data here.
 {
@@ -79,9 +80,12 @@ ICARUSFlashFinder::ICARUSFlashFinder(pmtana::Config_t const & p)
 
   produces< std::vector<recob::OpFlash>   >();
   produces< art::Assns <recob::OpHit, recob::OpFlash> >();
+
+  // the flash algorithm keeps no state between events
+  async<art::InEvent>();
 }
 
-void ICARUSFlashFinder::produce(art::Event & e)
+void ICARUSFlashFinder::produce(art::Event & e, art::ProcessingFrame const&)
 {
 
   // produce OpFlash data-product to be filled within module
@@ -112,6 +116,8 @@ void ICARUSFlashFinder::produce(art::Event & e)
   
   auto const flash_v = _mgr.RecoFlash(ophits);
 
+  art::PtrMaker<recob::OpFlash> const makeFlashPtr(e);
+
   for(const auto& lflash :  flash_v) {
 
     double Ycenter, Zcenter, Ywidth, Zwidth;
@@ -125,9 +131,10 @@ void ICARUSFlashFinder::produce(art::Event & e)
                          Ycenter, Ywidth, Zcenter, Zwidth);
     opflashes->emplace_back(std::move(flash));
 
+    art::Ptr<recob::OpFlash> const flash_ptr = makeFlashPtr(opflashes->size() - 1);
     for(auto const& hitidx : lflash.asshit_idx) {
       const art::Ptr<recob::OpHit> hit_ptr(ophit_h, hitidx);
-      util::CreateAssn(*this, e, *opflashes, hit_ptr, *flash2hit_assn_v);
+      flash2hit_assn_v->addSingle(hit_ptr, flash_ptr);
     }
   }
   
@@ -139,7 +146,7 @@ void ICARUSFlashFinder::GetFlashLocation(std::vector<double> pePerOpChannel,
                                      double& Ycenter, 
                                      double& Zcenter, 
                                      double& Ywidth, 
-                                     double& Zwidth)
+                                     double& Zwidth) const
 {
 
   // Reset variables
@@ -2,6 +2,7 @@
 #define SIMPLEFLASHALGO_CXX
 
 #include "SimpleFlashAlgo.h"
+#include <algorithm>
 #include <set>
 namespace pmtana{
     
@@ -106,16 +107,38 @@ namespace pmtana{
     SimpleFlashAlgo::~SimpleFlashAlgo()
     {}
     
-    LiteOpFlashArray_t SimpleFlashAlgo::RecoFlash(const LiteOpHitArray_t ophits) {
+    void SimpleFlashAlgo::Workspace::Reset(size_t nbins, size_t nopdet)
+    {
+        // only the bins touched by the previous call need to be cleared
+        for(auto const& idx : touched) {
+            pesum[idx] = 0;
+            mult[idx]  = 0;
+            row[idx]   = -1;
+        }
+        touched.clear();
+        hits.clear();
+        seeds.clear();
+        pespec.clear();
+        pespec.reserve(nopdet * 64);
+        if(pesum.size() < nbins) {
+            pesum.resize(nbins,0);
+            mult.resize(nbins,0);
+            row.resize(nbins,-1);
+        }
+    }
+    
+    LiteOpFlashArray_t SimpleFlashAlgo::RecoFlash(const LiteOpHitArray_t ophits) const {
+        
+        // workspaces are reused within the thread (their content is not kept)
+        thread_local Workspace ws;
+        return RecoFlash(ophits, ws);
+    }
+    
+    LiteOpFlashArray_t SimpleFlashAlgo::RecoFlash(const LiteOpHitArray_t& ophits, Workspace& ws) const {
         
-        Reset();
         size_t max_ch = _opch_to_index_v.size() - 1;
         size_t NOpDet = _index_to_opch_v.size();
         
-        //static std::vector<double> pesum_v;
-        static std::vector<double> mult_v;  //< this is not strictly a multiplicity of PMTs, but multiplicity of hits
-        static std::vector<std::vector<double> > pespec_v;
-        static std::vector<std::vector<unsigned int> > hitidx_v;
         double min_time=1.1e20;
         double max_time=1.1e20;
         for(auto const& oph : ophits) {
@@ -128,18 +151,9 @@ namespace pmtana{
             std::cout << "T span: " << min_time << " => " << max_time << " ... " << (size_t)((max_time - min_time) / _time_res) << std::endl;
         
         size_t nbins_pesum_v = (size_t)((max_time - min_time) / _time_res) + 1;
-        if(_pesum_v.size() < nbins_pesum_v) _pesum_v.resize(nbins_pesum_v,0);
-        if(mult_v.size()   < nbins_pesum_v) mult_v.resize(nbins_pesum_v,0);
-        if(pespec_v.size() < nbins_pesum_v) pespec_v.resize(nbins_pesum_v,std::vector<double>(NOpDet));
-        if(hitidx_v.size() < nbins_pesum_v) hitidx_v.resize(nbins_pesum_v,std::vector<unsigned int>());
-        for(size_t i=0; i<_pesum_v.size(); ++i) {
-            _pesum_v[i] = 0;
-            mult_v[i]  = 0;
-            hitidx_v[i].clear();
-            for(auto& v : pespec_v[i]) v=0;
-        }
+        ws.Reset(nbins_pesum_v, NOpDet);
         
-        // Fill _pesum_v
+        // Fill the PE sum and the spectrum of the touched bins
         for(size_t hitidx = 0; hitidx < ophits.size(); ++hitidx) {
             auto const& oph = ophits[hitidx];
             if(oph.channel > max_ch || _opch_to_index_v[oph.channel] < 0) {
@@ -153,19 +167,34 @@ namespace pmtana{
 	    if(oph.pe <= 0.) continue;
 	    if(_min_pe_hit > 0. && oph.pe < _min_pe_hit) continue;
             size_t index = (size_t)((oph.peak_time - min_time) / _time_res);
-            _pesum_v[index] += oph.pe;
-            mult_v[index] += 1;
-            pespec_v[index][_opch_to_index_v[oph.channel]] += oph.pe;
-            hitidx_v[index].push_back(hitidx);
+            if(ws.row[index] < 0) {
+                ws.row[index] = ws.touched.size();
+                ws.touched.push_back(index);
+                ws.pespec.resize(ws.pespec.size() + NOpDet, 0);
+            }
+            ws.pesum[index] += oph.pe;
+            ws.mult[index] += 1;
+            ws.pespec[ws.row[index] * NOpDet + _opch_to_index_v[oph.channel]] += oph.pe;
+            ws.hits.emplace_back(index, hitidx);
         }
+        std::sort(ws.touched.begin(), ws.touched.end());
+        // by bin, and by hit index within the same bin
+        std::sort(ws.hits.begin(), ws.hits.end());
         
-        // Order by pe (above threshold)
-        std::map<double,size_t> pesum_idx_map;
-        for(size_t idx=0; idx<nbins_pesum_v; ++idx) {
-            if(_pesum_v[idx] < _min_pe_coinc   ) continue;
-            if(mult_v[idx]  < _min_mult_coinc ) continue;
-            pesum_idx_map[1./(_pesum_v[idx])] = idx;
+        // Order by pe (above threshold); bins without hits are never seeds
+        for(auto const& idx : ws.touched) {
+            if(ws.pesum[idx] < _min_pe_coinc   ) continue;
+            if(ws.mult[idx]  < _min_mult_coinc ) continue;
+            ws.seeds.emplace_back(1./(ws.pesum[idx]), idx);
         }
+        // all candidates are visited below, so they are fully sorted; of the
+        // bins with the same PE sum only the latest one is a candidate
+        std::sort(ws.seeds.begin(), ws.seeds.end(),
+                  [](auto const& a, auto const& b)
+                  { return (a.first < b.first) || (a.first == b.first && a.second > b.second); });
+        ws.seeds.erase(std::unique(ws.seeds.begin(), ws.seeds.end(),
+                                   [](auto const& a, auto const& b) { return a.first == b.first; }),
+                       ws.seeds.end());
         
         // Get candidate flash times
         std::vector<std::pair<size_t,size_t> > flash_period_v;
@@ -173,13 +202,13 @@ namespace pmtana{
         size_t veto_ctr = (size_t)(_veto_time / _time_res);
         size_t default_integral_ctr = (size_t)(_integral_time / _time_res);
         size_t precount = (size_t)(_pre_sample / _time_res);
-        flash_period_v.reserve(pesum_idx_map.size());
-        flash_time_v.reserve(pesum_idx_map.size());
+        flash_period_v.reserve(ws.seeds.size());
+        flash_time_v.reserve(ws.seeds.size());
         
         double sum_baseline = 0;
         //for(auto const& v : _pe_baseline_v) sum_baseline += v;
         
-        for(auto const& pe_idx : pesum_idx_map) {
+        for(auto const& pe_idx : ws.seeds) {
             
             //auto const& pe  = 1./(pe_idx.first);
             auto const& idx = pe_idx.second;
@@ -224,7 +253,7 @@ namespace pmtana{
             double pesum = 0;
             for(size_t i=start_time; i<std::min(nbins_pesum_v,(start_time+integral_ctr)); ++i)
                 
-                pesum += _pesum_v[i];
+                pesum += ws.pesum[i];
             
             if(pesum < (_min_pe_flash + sum_baseline)) {
                 if(_debug) std::cout << "Skipping a candidate @ " << start_time  << " => " << start_time + integral_ctr
@@ -245,12 +274,17 @@ namespace pmtana{
             auto const& period = flash_period_v[flash_idx].second;
             auto const& time   = flash_time_v[flash_idx];
             
+            // touched bins in [ start, start + period [
+            auto const first_bin = std::lower_bound(ws.touched.begin(), ws.touched.end(), start);
+            auto const last_bin  = std::lower_bound(first_bin, ws.touched.end(), start + period);
+            
             std::vector<double> pe_v(max_ch+1,0);
-            for(size_t index=start; index<(start+period) && index<pespec_v.size(); ++index) {
+            for(auto iBin = first_bin; iBin != last_bin; ++iBin) {
                 
+                double const* pespec = ws.pespec.data() + ws.row[*iBin] * NOpDet;
                 for(size_t pmt_index=0; pmt_index<NOpDet; ++pmt_index)
                     
-                    pe_v[_index_to_opch_v[pmt_index]] += pespec_v[index][pmt_index];
+                    pe_v[_index_to_opch_v[pmt_index]] += pespec[pmt_index];
                 
             }
             
@@ -264,11 +298,12 @@ namespace pmtana{
                 
             }
             
+            auto const first_hit = std::lower_bound(ws.hits.begin(), ws.hits.end(), std::make_pair(start, 0U));
+            auto const last_hit  = std::lower_bound(first_hit, ws.hits.end(), std::make_pair(start + period, 0U));
             std::vector<unsigned int> asshit_v;
-            for(size_t index=start; index<(start+period) && index<pespec_v.size(); ++index) {
-                for(auto const& idx : hitidx_v[index])
-                    asshit_v.push_back(idx);
-            }
+            asshit_v.reserve(last_hit - first_hit);
+            for(auto iHit = first_hit; iHit != last_hit; ++iHit)
+                asshit_v.push_back(iHit->second);
             
             if(_debug) {
                 std::cout << "Claiming a flash @ " << min_time + time * _time_res
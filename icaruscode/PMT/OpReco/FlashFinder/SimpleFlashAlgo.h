@@ -4,6 +4,8 @@
 #include "FlashAlgoBase.h"
 #include "FlashAlgoFactory.h"
 #include <map>
+#include <utility>
+#include <vector>
 namespace pmtana
 {
 
@@ -11,17 +13,40 @@ namespace pmtana
 
   public:
 
+    /**
+     * @brief Buffers for the PE-time histogram of a single `RecoFlash()` call.
+     *
+     * Only the time bins with hits (_touched_ bins) get a row of PE per
+     * channel, in a single flat array; the dense per-bin arrays are kept
+     * zeroed between calls by resetting just the touched bins, so that a
+     * workspace can be reused without allocations or full clearing.
+     */
+    struct Workspace {
+      std::vector<double>       pesum;   ///< PE sum per time bin.
+      std::vector<unsigned int> mult;    ///< Number of hits per time bin.
+      std::vector<int>          row;     ///< PE spectrum row of each bin (-1 if none).
+      std::vector<size_t>       touched; ///< Time bins with hits, sorted.
+      std::vector<double>       pespec;  ///< PE per channel, one row per touched bin.
+      std::vector<std::pair<size_t,unsigned int> > hits;  ///< (bin, hit index).
+      std::vector<std::pair<double,size_t> >       seeds; ///< (1/PE sum, bin).
+
+      /// Prepares the workspace for `nbins` time bins and `nopdet` channels.
+      void Reset(size_t nbins, size_t nopdet);
+    };
+
     SimpleFlashAlgo(const std::string name);
 
     void Configure(const Config_t &p);
     
     virtual ~SimpleFlashAlgo();
 
-    LiteOpFlashArray_t RecoFlash(const LiteOpHitArray_t ophits);
+    /// Finds flashes using a per-thread workspace; safe to call concurrently.
+    LiteOpFlashArray_t RecoFlash(const LiteOpHitArray_t ophits) const override;
 
-    bool Veto(double t) const;
+    /// Finds flashes using the buffers in `ws`.
+    LiteOpFlashArray_t RecoFlash(const LiteOpHitArray_t& ophits, Workspace& ws) const;
 
-    const std::vector<double>& PESumArray() const { return _pesum_v; }
+    bool Veto(double t) const;
 
     const double TimeRes() const { return _time_res; }
 
@@ -53,9 +78,6 @@ namespace pmtana
     // time pre-sample
     double _pre_sample;
 
-    // pw aum array
-    std::vector<double> _pesum_v;
-
     // calibration: PEs to be subtracted from each opdet
     std::vector<double> _pe_baseline_v;
 
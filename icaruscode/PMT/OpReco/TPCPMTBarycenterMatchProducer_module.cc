@@ -29,6 +29,7 @@
 #include "canvas/Persistency/Common/FindManyP.h"
 
 //LArSoft includes
+#include "icaruscode/PMT/OpReco/Algorithms/BarycenterMatchMatrix.h"
 #include "icarusalg/Utilities/TrackTimeInterval.h"
 #include "lardata/DetectorInfoServices/DetectorPropertiesService.h"
 #include "lardata/DetectorInfoServices/DetectorClocksService.h"
@@ -54,7 +55,9 @@
 #include "TTree.h"
 #include "TVector3.h"
 
+#include <array>
 #include <cmath> // std::hypot(), std::abs(), std::sqrt()
+#include <cstddef> // std::size_t
 #include <iostream>
 #include <memory>
 #include <string>
@@ -234,12 +237,19 @@ public:
 
 private:
 
+  /// Information from the hits of a flash, computed only for matched flashes.
+  struct FlashHitInfo_t {
+    bool   filled = false; ///< Whether the information has been computed.
+    double firstHit;       ///< Earliest OpHit time in the flash (us).
+    double asymmetry;      ///< East-West asymmetry of PEs in the flash.
+  };
+
   // Declare member data here.
   void InitializeSlice();                                                                     ///< Re-initialize all slice-level data members
   double CentroidOverlap(double center1, double center2, double width1, double width2) const; ///< Return overlap between charge and light centroids OR distance apart if no overlap
   double CalculateAsymmetry(art::Ptr<recob::OpFlash> flash, int cryo);                        ///< Return the east-west asymmetry of PEs in a given OpFlash
   void updateChargeVars(double sumCharge, TVector3 const& sumPos, TVector3 const& sumPosSqr, std::array<double, 2> const& triggerFlashCenter); ///< Update slice-level data members with charge and trigger match info
-  void updateFlashVars(art::Ptr<recob::OpFlash> flash, double firstHit);                      ///< Update slice-level data members with best match info
+  void updateFlashVars(art::Ptr<recob::OpFlash> flash, double firstHit, double asymmetry);    ///< Update slice-level data members with best match info
   void updateMatchInfo(sbn::TPCPMTBarycenterMatch& matchInfo);                                      ///< Update match product with slice-level data members
  
   // Input parameters
@@ -429,23 +439,35 @@ void TPCPMTBarycenterMatchProducer::produce(art::Event& e)
     art::FindMany<recob::OpHit> fmOpHits(flashHandle, e, fOpFlashLabel + inputTag);
     int nFlashes = (*flashHandle).size();
 
+    //Flash barycenters and times, shared by all the slices
+    std::vector<double> flashCenterY(nFlashes), flashCenterZ(nFlashes);
+    std::vector<electronics_time> flashTimes;
+    flashTimes.reserve(nFlashes);
+
     std::array<double, 2> triggerFlashCenter = {-9999., -9999.};
-    //If triggered event..
-    if ( triggerTime >= 0. ) {
-      double minTimeDiff = 1.6;
-      //For flash...
-      for ( int i = 0; i < nFlashes; i++ ) {
-        const recob::OpFlash &flash = (*flashHandle)[i];
-
-        //Identify the triggering flash
-        double timeDiff = abs( (triggerTime - flash.AbsTime()) - fTriggerDelay );
-        if ( timeDiff < fTriggerTolerance && timeDiff < minTimeDiff ) {
-          triggerFlashCenter = {flash.YCenter(), flash.ZCenter()};
-          minTimeDiff = timeDiff;
-        }
+    double minTimeDiff = 1.6;
+    //For flash...
+    for ( int i = 0; i < nFlashes; i++ ) {
+      const recob::OpFlash &flash = (*flashHandle)[i];
+      flashCenterY[i] = flash.YCenter();
+      flashCenterZ[i] = flash.ZCenter();
+      flashTimes.emplace_back(flash.AbsTime());
+
+      //If triggered event, identify the triggering flash
+      if ( triggerTime < 0. ) continue;
+      double timeDiff = abs( (triggerTime - flash.AbsTime()) - fTriggerDelay );
+      if ( timeDiff < fTriggerTolerance && timeDiff < minTimeDiff ) {
+        triggerFlashCenter = {flash.YCenter(), flash.ZCenter()};
+        minTimeDiff = timeDiff;
+      }
+
+    } //End for flash
 
-      } //End for flash
-    } //End if triggered event
+    icarus::opdet::BarycenterMatchMatrix matchMatrix;
+    matchMatrix.setFlashes(std::move(flashCenterY), std::move(flashCenterZ));
+
+    //Time of the first OpHit and PE asymmetry of each flash, computed when first matched
+    std::vector<FlashHitInfo_t> flashHitInfo(nFlashes);
 
     if ( fVerbose ) std::cout << "Event: " << fEvent << ", Cryo: " << inputTag << ", nFlashes: " << nFlashes << ", Triggering flash center Y: " << triggerFlashCenter[0] << ", Triggering flash center Z: " << triggerFlashCenter[1]  << std::endl;
 
@@ -453,7 +475,7 @@ void TPCPMTBarycenterMatchProducer::produce(art::Event& e)
 /* ~~~~~~~~~~~~~~~~~~~~ TPC Section
  * Here we start by gathering the Slices in the event
  * For each slice, the charge centroid is first calculated
- * Then we iterate through flashes to identify the best match flash
+ * Then the slice distances from all the flashes are scored at once to identify the best match flash
  * If a triggering flash was found in this cyrostat, the barycenter distance to the triggering flash is also stored
  */
 
@@ -465,6 +487,26 @@ void TPCPMTBarycenterMatchProducer::produce(art::Event& e)
 
     unsigned nSlices = (*sliceHandle).size();
 
+    //SpacePoints of the hits and T0 of the first PFP of all slices, each looked up in a single pass
+    std::vector<art::Ptr<recob::Hit>> allTPCHits;
+    std::vector<std::size_t> firstSliceHit(nSlices + 1);
+    std::vector<art::Ptr<recob::PFParticle>> firstPFPs;
+    std::vector<int> sliceT0Index(nSlices, -1);
+    for ( unsigned j = 0; j < nSlices; j++ ) {
+      firstSliceHit[j] = allTPCHits.size();
+      const std::vector<art::Ptr<recob::Hit>> &tpcHitsVec = fmTPCHits.at(j);
+      allTPCHits.insert(allTPCHits.end(), tpcHitsVec.begin(), tpcHitsVec.end());
+      const std::vector<art::Ptr<recob::PFParticle>> &pfpsVec = fmPFPs.at(j);
+      if ( pfpsVec.empty() ) continue;
+      sliceT0Index[j] = firstPFPs.size();
+      firstPFPs.push_back(pfpsVec.front());
+    }
+    firstSliceHit[nSlices] = allTPCHits.size();
+    art::FindOne<recob::SpacePoint> f1SpacePoint(allTPCHits, e, fPandoraLabel + inputTag);
+    art::FindOne<anab::T0> f1T0(firstPFPs, e, fPandoraLabel + inputTag);
+
+    std::vector<bool> candidateFlashes(nFlashes);
+
     //For slice...
     for ( unsigned j = 0; j < nSlices; j++ ) {
       fSliceNum = j;
@@ -474,21 +516,15 @@ void TPCPMTBarycenterMatchProducer::produce(art::Event& e)
       updateMatchInfo(sliceMatchInfo);
 
       const std::vector<art::Ptr<recob::Hit>> &tpcHitsVec = fmTPCHits.at(j);
-      const std::vector<art::Ptr<recob::PFParticle>> &pfpsVec = fmPFPs.at(j);
-      art::FindOne<recob::SpacePoint> f1SpacePoint(tpcHitsVec, e, fPandoraLabel + inputTag);
-
-      int nHits = tpcHitsVec.size();
-      int nPFPs = pfpsVec.size();
 
       //Establish possible time range for this slice
       lar::util::TrackTimeInterval::TimeRange const& timeRange = timeIntervals.timeRangeOfHits(tpcHitsVec);
       const bool rangeIsValid = timeRange.isValid();
 
       //Retrieve Pandora's T0 for this slice if available, same for every PFP in slice so we only need one
-      if ( nPFPs != 0 ) {
-        art::FindOne<anab::T0> f1T0( {pfpsVec.at(0)}, e, fPandoraLabel + inputTag);
-        if ( f1T0.at(0).isValid() ) {
-          fChargeT0 = f1T0.at(0).ref().Time() / 1e3;
+      if ( sliceT0Index[j] >= 0 ) {
+        if ( f1T0.at(sliceT0Index[j]).isValid() ) {
+          fChargeT0 = f1T0.at(sliceT0Index[j]).ref().Time() / 1e3;
         }
       }
 
@@ -498,14 +534,14 @@ void TPCPMTBarycenterMatchProducer::produce(art::Event& e)
       TVector3 sumPosSqr {0.,0.,0.};
 
       //For hit...
-      for ( int k = 0; k < nHits; k++ ) {
-        const art::Ptr<recob::Hit> &tpcHit = tpcHitsVec.at(k);
+      for ( std::size_t k = firstSliceHit[j]; k < firstSliceHit[j + 1]; k++ ) {
+        const art::Ptr<recob::Hit> &tpcHit = allTPCHits[k];
 
         //Only use hits with associated SpacePoints, and optionally only collection plane hits
         if ( fCollectionOnly && tpcHit->SignalType() != geo::kCollection ) continue;
         if ( !f1SpacePoint.at(k).isValid() ) continue;
 
-        const recob::SpacePoint point = f1SpacePoint.at(k).ref();
+        const recob::SpacePoint& point = f1SpacePoint.at(k).ref();
         thisCharge = tpcHit->Integral();
         TVector3 const thisPoint = point.XYZ();
         TVector3 const thisPointSqr {thisPoint.X()*thisPoint.X(), thisPoint.Y()*thisPoint.Y(), thisPoint.Z()*thisPoint.Z()};
@@ -528,34 +564,22 @@ void TPCPMTBarycenterMatchProducer::produce(art::Event& e)
       updateChargeVars(sumCharge, sumPos, sumPosSqr, triggerFlashCenter);
       updateMatchInfo(sliceMatchInfo);
 
-      int matchIndex = -5;
-      double minDistance = 1e6;
-      double thisFlashCenterY, thisFlashCenterZ, thisDistance;
-
-      //For flash...
-      for ( int m = 0; m < nFlashes; m++ ) {
-        const recob::OpFlash &flash = (*flashHandle).at(m);
-
-        //Skip over flashes that are very out of time with respect to the slice
-        if ( fUseTimeRange && rangeIsValid ) {
-          electronics_time eTime (flash.AbsTime());
-          if ( !timeRange.contains(eTime, fTimeRangeMargin) ) continue;
-        }
+      //Score all flashes, skipping over flashes that are very out of time with respect to the slice
+      std::size_t matchRow;
+      if ( fUseTimeRange && rangeIsValid ) {
+        for ( int m = 0; m < nFlashes; m++ )
+          candidateFlashes[m] = timeRange.contains(flashTimes[m], fTimeRangeMargin);
+        matchRow = matchMatrix.addSlice(fChargeCenterY, fChargeCenterZ, candidateFlashes);
+      }
+      else matchRow = matchMatrix.addSlice(fChargeCenterY, fChargeCenterZ);
 
-        //TODO: if ( flash has entering CRT match ) continue? Or at least just store that as a bool?
+      //TODO: if ( flash has entering CRT match ) continue? Or at least just store that as a bool?
 
-        //Find index of flash that minimizes barycenter distance in YZ place
-        thisFlashCenterY = flash.YCenter();
-        thisFlashCenterZ = flash.ZCenter();
-        thisDistance = std::hypot( (thisFlashCenterY - fChargeCenterY), (thisFlashCenterZ - fChargeCenterZ) );
-        if ( thisDistance < minDistance ) {
-          minDistance = thisDistance;
-          matchIndex = m;
-        }
-      } //End for flash
+      //Find index of flash that minimizes barycenter distance in YZ place
+      std::size_t const matchIndex = matchMatrix.bestFlash(matchRow);
 
       //No valid match found...
-      if ( matchIndex == -5 ) {
+      if ( matchIndex == icarus::opdet::BarycenterMatchMatrix::NoMatch ) {
         if ( fFillMatchTree ) fMatchTree->Fill();
         art::Ptr<sbn::TPCPMTBarycenterMatch> const infoPtr = makeInfoPtr(matchInfoVector->size());
         sliceAssns->addSingle(infoPtr, slicePtr);
@@ -565,16 +589,19 @@ void TPCPMTBarycenterMatchProducer::produce(art::Event& e)
       }
 
       //Best match flash pointer
-      unsigned unsignedMatchIndex = matchIndex;
-      const art::Ptr<recob::OpFlash> flashPtr { flashHandle, unsignedMatchIndex };
+      const art::Ptr<recob::OpFlash> flashPtr { flashHandle, matchIndex };
 
       //Find time of first OpHit in matched flash
-      const std::vector<recob::OpHit const*> &opHitsVec = fmOpHits.at(matchIndex);
-      double minTime = 1e6;
-      for (const recob::OpHit *opHit : opHitsVec ) { if ( opHit->PeakTime() < minTime ) minTime = opHit->PeakTime(); }
+      FlashHitInfo_t& hitInfo = flashHitInfo[matchIndex];
+      if ( !hitInfo.filled ) {
+        const std::vector<recob::OpHit const*> &opHitsVec = fmOpHits.at(matchIndex);
+        double minTime = 1e6;
+        for (const recob::OpHit *opHit : opHitsVec ) { if ( opHit->PeakTime() < minTime ) minTime = opHit->PeakTime(); }
+        hitInfo = { true, minTime, CalculateAsymmetry(flashPtr, fCryo) };
+      }
 
       //Update match info
-      updateFlashVars(flashPtr, minTime);
+      updateFlashVars(flashPtr, hitInfo.firstHit, hitInfo.asymmetry);
       updateMatchInfo(sliceMatchInfo);
       art::Ptr<sbn::TPCPMTBarycenterMatch> const infoPtr = makeInfoPtr(matchInfoVector->size());
       sliceAssns->addSingle(infoPtr, slicePtr);
@@ -671,7 +698,7 @@ void TPCPMTBarycenterMatchProducer::updateChargeVars(double sumCharge, TVector3
 } //End updateChargeVars()
 
 
-void TPCPMTBarycenterMatchProducer::updateFlashVars(art::Ptr<recob::OpFlash> flash, double firstHit) {
+void TPCPMTBarycenterMatchProducer::updateFlashVars(art::Ptr<recob::OpFlash> flash, double firstHit, double asymmetry) {
   double matchedTime = flash->Time();
   double matchedYCenter = flash->YCenter();
   double matchedZCenter = flash->ZCenter();
@@ -681,7 +708,7 @@ void TPCPMTBarycenterMatchProducer::updateFlashVars(art::Ptr<recob::OpFlash> fla
   fFlashFirstHit = firstHit;
   fFlashTime = matchedTime;
   fFlashPEs =  flash->TotalPE();
-  fFlashAsymmetry = CalculateAsymmetry(flash, fCryo);
+  fFlashAsymmetry = asymmetry;
   fFlashCenterY = matchedYCenter;
   fFlashCenterZ = matchedZCenter;
   fFlashWidthY = matchedYWidth;
@@ -11,6 +11,7 @@
 #include "cetlib_except/exception.h"
 
 #include "icaruscode/PMT/OpticalTools/IOpHitFinder.h"
+#include "icaruscode/PMT/Algorithms/WaveformBaselineStats.h"
 #include "larreco/HitFinder/HitFinderTools/ICandidateHitFinder.h"
 
 #include <cmath>
@@ -165,38 +166,10 @@ void OpHitFinder::FindOpHits(const raw::OpDetWaveform& opDetWaveform,
 
 float OpHitFinder::getBaseline(const raw::OpDetWaveform& locWaveform) const
 {
-    // Fill a map to determine the most probable value
-    std::map<raw::ADC_Count_t,int> adcFrequencyMap;
+    // Mean of the samples within 3 counts of the most probable value
+    static icarus::opdet::WaveformBaselineStats const baselineStats(3);
     
-    raw::ADC_Count_t maxBin(0);
-    int              maxCount(0);
-    
-    for(const auto& adc : locWaveform)
-    {
-        int& adcFrequency = adcFrequencyMap[adc];
-        
-        if (++adcFrequency > maxCount)
-        {
-            maxBin   = adc;
-            maxCount = adcFrequency;
-        }
-    }
-    
-    float mostProbableBaseline(0.);
-    int   mostProbableCount(0);
-    
-    for(raw::ADC_Count_t adcBin = maxBin - 3; adcBin <= maxBin + 3; adcBin++)
-    {
-        try{
-            mostProbableBaseline += adcFrequencyMap.at(adcBin) * float(adcBin);
-            mostProbableCount    += adcFrequencyMap.at(adcBin);
-        }
-        catch(...) {}
-    }
-    
-    mostProbableBaseline /= mostProbableCount;
-   
-    return mostProbableBaseline;
+    return baselineStats(locWaveform).truncatedMean;
 }
 
     
@@ -6,6 +6,7 @@
  */
 
 // ICARUS libraries
+#include "icaruscode/PMT/Algorithms/WaveformBaselineStats.h"
 #include "sbnobj/ICARUS/PMT/Data/WaveformBaseline.h"
 // #include "icaruscode/Utilities/DataProductPointerMap.h"
 
@@ -39,9 +40,8 @@
 
 // C/C++ standard libraries
 #include <vector>
-#include <algorithm> // std::partial_sort_copy()
-#include <iterator> // std::distance()
-#include <memory> // std::make_unique(), std::allocator
+#include <algorithm> // std::sort(), std::max()
+#include <memory> // std::make_unique()
 #include <string>
 #include <cmath> // std::ceil()
 #include <cassert>
@@ -196,6 +196,9 @@ class icarus::PMTWaveformBaselines: public art::EDProducer {
   
   // --- BEGIN Algorithms ------------------------------------------------------
   
+  /// Median (and more) of all the waveforms of the event, in parallel.
+  icarus::opdet::WaveformBaselineStats const fBaselineStats;
+  
   // --- END Algorithms --------------------------------------------------------
   
   std::size_t fNPlotChannels = 0U; ///< Number of plotted channels
@@ -211,10 +214,6 @@ class icarus::PMTWaveformBaselines: public art::EDProducer {
   /// Removes the empty plots.
   void buildBaselineGraphs();
   
-  /// Extracts a baseline as median from a single waveform.
-  icarus::WaveformBaseline baselineFromMedian
-    (raw::OpDetWaveform const& waveform) const;
-  
 }; // icarus::PMTWaveformBaselines
 
 
@@ -222,27 +221,6 @@ class icarus::PMTWaveformBaselines: public art::EDProducer {
 //------------------------------------------------------------------------------
 //--- Implementation
 //------------------------------------------------------------------------------
-namespace {
-  
-  /// Extracts the median of the collection between the specified iterators.
-  template <typename BIter, typename EIter>
-  auto median(BIter begin, EIter end) {
-    
-    using value_type = typename BIter::value_type;
-    
-    std::vector<value_type> data{ begin, end };
-    assert(!data.empty());
-    
-    auto const middle = data.begin() + data.size() / 2;
-    std::nth_element(data.begin(), middle, data.end());
-    
-    return *middle;
-    
-  } // median()
-  
-} // local namespace
-
-
 //------------------------------------------------------------------------------
 //--- icarus::PMTWaveformBaselines
 //------------------------------------------------------------------------------
@@ -324,10 +302,15 @@ void icarus::PMTWaveformBaselines::produce(art::Event& event) {
   
   art::PtrMaker<icarus::WaveformBaseline> const makeBaselinePtr(event);
   
+  // the baseline is the median of the waveform
+  std::vector<icarus::opdet::WaveformBaselineStats::Stats_t> const stats
+    = fBaselineStats.all(waveforms);
+  
   for (auto const& [ iWaveform, waveform ]: util::enumerate(waveforms)) {
     assert(iWaveform == baselines.size());
     
-    icarus::WaveformBaseline const baseline { baselineFromMedian(waveform) };
+    icarus::WaveformBaseline const baseline
+      { waveform.empty()? 0.0f: float(stats[iWaveform].median) };
     
     if (!averages.empty())
       averages[waveform.ChannelNumber()].add(baseline.baseline());
@@ -473,17 +456,6 @@ void icarus::PMTWaveformBaselines::buildBaselineGraphs() {
 } // icarus::PMTWaveformBaselines::buildBaselineGraphs()
 
 
-//------------------------------------------------------------------------------
-icarus::WaveformBaseline icarus::PMTWaveformBaselines::baselineFromMedian
-  (raw::OpDetWaveform const& waveform) const
-{
-  
-  return icarus::WaveformBaseline
-    { waveform.empty()? 0.0f: median(waveform.begin(), waveform.end()) };
-  
-} // icarus::PMTWaveformBaselines::baselineFromMedian()
-
-
 //------------------------------------------------------------------------------
 DEFINE_ART_MODULE(icarus::PMTWaveformBaselines)
 
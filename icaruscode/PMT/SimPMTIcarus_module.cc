@@ -16,6 +16,7 @@
 #include "icaruscode/PMT/Algorithms/NoiseGeneratorAlg.h"
 #include "icaruscode/PMT/Algorithms/PhotoelectronPulseFunction.h"
 #include "icaruscode/IcarusObj/OpDetWaveformMeta.h"
+#include "icaruscode/Utilities/StageTimers.h"
 
 // LArSoft libraries
 #include "larcore/CoreUtils/ServiceUtil.h"
@@ -255,6 +256,9 @@ namespace icarus::opdet {
     // Required functions.
     void produce(art::Event & e) override;
     
+    /// Reports the timing of the simulation stages.
+    void endJob() override;
+    
   private:
     
     /// Type of single photoelectron response function.
@@ -288,6 +292,14 @@ namespace icarus::opdet {
     /// True if `firstTime()` has already been called.
     std::atomic_flag fNotFirstTime;
     
+    // --- BEGIN -- Timing -----------------------------------------------------
+    std::shared_ptr<util::StageTimers> fStageTimers; ///< Stage timing.
+    util::StageTimers::StageID_t fEventStage; ///< Whole event.
+    util::StageTimers::StageID_t fChannelStage; ///< Simulation of a channel.
+    util::StageTimers::StageID_t fMetadataStage; ///< Waveform metadata.
+    util::StageTimers::StageID_t fStoreStage; ///< Storing of the products.
+    // --- END ---- Timing -----------------------------------------------------
+    
     /// Returns the metadata of `waveforms` and their associations.
     std::pair<
       std::vector<sbn::OpDetWaveformMeta>,
@@ -345,6 +357,12 @@ SimPMTIcarus::SimPMTIcarus(Parameters const& config)
           ->makeGenerator(fElectronicsNoiseEngine)
       }
     , makePMTsimulator(config().algoConfig())
+    , fStageTimers{ util::StageTimers::forModule
+        (config.get_PSet().get<std::string>("module_label")) }
+    , fEventStage{ fStageTimers->addStage("event") }
+    , fChannelStage{ fStageTimers->addStage("channel") }
+    , fMetadataStage{ fStageTimers->addStage("metadata") }
+    , fStoreStage{ fStageTimers->addStage("store") }
   {
     // Call appropriate produces<>() functions here.
     produces<std::vector<raw::OpDetWaveform>>();
@@ -363,6 +381,8 @@ SimPMTIcarus::SimPMTIcarus(Parameters const& config)
   {
     mf::LogDebug("SimPMTIcarus") << e.id();
     
+    auto const eventTimer = fStageTimers->time(fEventStage);
+    
     //
     // fetch the input
     //
@@ -416,6 +436,7 @@ SimPMTIcarus::SimPMTIcarus(Parameters const& config)
 
         sim::SimPhotonsLite lite_photons(photons.OpChannel());
 
+        auto const channelTimer = fStageTimers->time(fChannelStage);
         auto const& [ channelWaveforms, photons_used ]
           = PMTsimulator->simulate(photons, lite_photons);
         std::move(
@@ -435,6 +456,7 @@ SimPMTIcarus::SimPMTIcarus(Parameters const& config)
 
         sim::SimPhotons photons(lite_photons.OpChannel);
       
+        auto const channelTimer = fStageTimers->time(fChannelStage);
         auto const& [ channelWaveforms, photons_used ]
           = PMTsimulator->simulate(photons, lite_photons);
         std::move(
@@ -453,6 +475,7 @@ SimPMTIcarus::SimPMTIcarus(Parameters const& config)
     std::unique_ptr<art::Assns<raw::OpDetWaveform, sbn::OpDetWaveformMeta>>
       metadataAssns;
     if (fMakeMetadata) {
+      auto const metadataTimer = fStageTimers->time(fMetadataStage);
       metadataVec = std::make_unique<std::vector<sbn::OpDetWaveformMeta>>();
       metadataAssns =
         std::make_unique<art::Assns<raw::OpDetWaveform, sbn::OpDetWaveformMeta>>
@@ -468,6 +491,7 @@ SimPMTIcarus::SimPMTIcarus(Parameters const& config)
     //
     // save the result
     //
+    auto const storeTimer = fStageTimers->time(fStoreStage);
     e.put(std::move(pulseVecPtr));
     if (fMakeMetadata) {
       e.put(std::move(metadataVec));
@@ -477,6 +501,10 @@ SimPMTIcarus::SimPMTIcarus(Parameters const& config)
   } // SimPMTIcarus::produce()
   
   
+  // ---------------------------------------------------------------------------
+  void SimPMTIcarus::endJob() { fStageTimers->report("SimPMTIcarus"); }
+  
+  
   // ---------------------------------------------------------------------------
   std::pair<
     std::vector<sbn::OpDetWaveformMeta>,
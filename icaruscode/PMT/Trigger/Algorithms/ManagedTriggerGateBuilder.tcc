@@ -19,11 +19,11 @@
 
 // ICARUS libraries
 #include "icaruscode/PMT/Trigger/Algorithms/TriggerTypes.h" // icarus::trigger::ADCCounts_t
+#include "icaruscode/PMT/Trigger/Utilities/ThresholdCrossingScan.h"
 #include "icarusalg/Utilities/WaveformOperations.h"
 
 // LArSoft libraries
 #include "lardataobj/RawData/OpDetWaveform.h"
-#include "larcorealg/CoreUtils/counter.h"
 // #include "larcorealg/CoreUtils/StdUtils.h" // util::to_string()
 
 // framework libraries
@@ -33,10 +33,8 @@
 #include "range/v3/view/chunk_by.hpp"
 
 // C/C++ standard libraries
-#include <optional>
-#include <iterator> // std::next(), std::prev()
 #include <cmath> // std::round()
-#include <cstddef> // std::ptrdiff_t
+#include <cstddef> // std::size_t
 
 
 //------------------------------------------------------------------------------
@@ -111,6 +109,7 @@ void icarus::trigger::ManagedTriggerGateBuilder::buildChannelGates(
 ) const
 {
   using ops = icarus::waveform_operations::NegativePolarityOperations<float>;
+  using Sample_t = raw::OpDetWaveform::value_type;
   
   if (channelWaveforms.empty()) return;
   
@@ -126,12 +125,22 @@ void icarus::trigger::ManagedTriggerGateBuilder::buildChannelGates(
   optical_tick lastWaveformTick [[gnu::unused]]
     = timeStampToOpticalTick(firstWaveform.TimeStamp());
   
+  std::vector<ADCCounts_t> const& thresholds = channelThresholds();
+  assert(channelGates.size() == thresholds.size());
+  
   /*
    * The algorithm finds gate openings and closing.
    * The actual actions on opening and closing depends on the gate info class.
    * For example, while a dynamic gate duration algorithm will perform open and
    * close operations directly, a fixed gate duration algorithm may perform
    * both opening and closing at open time, and nothing at all at closing time.
+   * 
+   * The crossings are found by `scanThresholdCrossings()`, which only
+   * subtracts the baseline from the samples leaving the bracket between the
+   * two thresholds enclosing the current signal level.
+   * The subtraction into `ADCCounts_t` (`short`) wraps for raw values far
+   * from the baseline; the scan only evaluates it within the range of the
+   * samples of the waveform, where this does not happen.
    */
   unsigned int nWaveforms = 0U;
   for (auto const& waveformData: channelWaveforms) {
@@ -168,145 +177,39 @@ void icarus::trigger::ManagedTriggerGateBuilder::buildChannelGates(
     assert(lastWaveformTick <= waveformTickStart);
     lastWaveformTick = waveformTickEnd;
     
-    auto const tbegin = channelThresholds().begin();
-    auto const tend = channelThresholds().end();
-    
     // register this waveform with the gates (this feature is unused here)
     for (auto& gateInfo: channelGates) gateInfo.addTrackingInfo(waveform);
     
-    // all gates start closed; this gate is not necessarily closed, but the
-    // waveform is not above the gate threshold any more.
-    auto nextGateToOpen = channelGates.begin();
-    
-    // we keep track of whether we have no lower or higher thresholds available
-    // to simplify the checks;
-    // we name them "pp" because they behave (almost) like pointers to pointers
-    #if defined( __GNUC__ )
-    # pragma GCC diagnostic push
-    # if (__GNUC__ <= 9) // last tested with: GCC 9.3.0
-    #  pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
-    # else
-    //#  error "Maintenance required here. See comments in the code"
-    /* [20210715 petrillo@slac.stanford.edu] The comments in the code:
-     * GCC 9.3.0 erroneously thinks that `ppXxxerThreshold` value _might_ be
-     * used before initialization. Due to the logic of the program, that is
-     * not the case (unless I am wrong!), and the only "solution" I have found
-     * is to disable the warning; Clang 7 on the other end does not complain.
-     * When GCC is updated and support for GCC 9 is dropped, this situation
-     * should be revisited by attempting the compilation with the warning
-     * still enabled (by just commenting out the #error directive).
-     * If compilation succeeds, this whole block and the `pop` directive below
-     * have become unnecessary and should be removed. Otherwise, the GCC version
-     * in the check above should be bumped up to cover the last tested GCC
-     * (here I went lazy and stuck to just the major version).
-     * I do not know which newer GCC version, if any, solves this issue so far.
-     */
-    # endif // GCC version
-    #endif // GCC
-    using ThresholdIterPtr_t
-      = std::optional<std::vector<ADCCounts_t>::const_iterator>;
-    // start at bottom with no lower threshold:
-    ThresholdIterPtr_t ppLowerThreshold = std::nullopt;
-    ThresholdIterPtr_t ppUpperThreshold = std::nullopt;
-    if (!channelThresholds().empty())
-      ppUpperThreshold = channelThresholds().begin(); // std::optional behavior
-    
-    for (auto iSample: util::counter<std::ptrdiff_t>(waveform.size())) {
-      
-      // baseline subtraction is always a subtraction (as in "A minus B"),
-      // regardless the polarity of the waveform
-      auto const sample = waveform[iSample];
-      ADCCounts_t const relSample = subtractBaseline(sample);
-      
-      /* // this is too much also for regular debugging...
-      MF_LOG_TRACE(details::TriggerGateDebugLog)
-        << "Sample #" << iSample << ": " << sample << " [=> " << relSample
-        << "]; thresholds lower: "
-          << (ppLowerThreshold? util::to_string(**ppLowerThreshold): "none")
-        << ", upper: "
-          << (ppUpperThreshold? util::to_string(**ppUpperThreshold): "none")
-        ;
-      */
-      
-      //
-      // if this sample is lower than the current lower threshold,
-      // we are just tracking the thresholds: gate closing has already happened
-      //
-      if (ppLowerThreshold && (relSample < **ppLowerThreshold)) {
-        
+    // the gate `channelGates[iThr]` is the one of `thresholds[iThr]`
+    auto const onPass
+      = [&](std::size_t iThr, std::size_t iSample, ADCCounts_t relSample)
+      {
+        // note that it is not guaranteed that gates at lower thresholds are
+        // still open (that depends on the builder implementation)
         MF_LOG_TRACE(details::TriggerGateDebugLog)
-          << "Sample " << sample << " (" << relSample << " on "
-          << waveOps.baseline() << ") leaving thresholds at "
-          << waveformTickStart << " + " << optical_time_ticks{ iSample };
-        
-        do { // we keep opening gates at increasing thresholds
-          
-          // if there is an lower threshold, there must also be a open gate!
-          assert(nextGateToOpen != channelGates.begin());
-          
-          
-          (--nextGateToOpen)->belowThresholdAt
-            (waveformTickStart + optical_time_ticks{ iSample });
-          
-          MF_LOG_TRACE(details::TriggerGateDebugLog)
-            << "  => decreasing threshold " << **ppLowerThreshold;
-          
-          if (*ppLowerThreshold == tbegin) { // was this the bottom threshold?
-            ppLowerThreshold = std::nullopt;
-            break;
-          }
-          --*ppLowerThreshold; // point to previous threshold
-          
-        } while (relSample < **ppLowerThreshold);
-        
-        // we can't be at the top since we just closed a gate
-        ppUpperThreshold
-          = ppLowerThreshold? std::next(*ppLowerThreshold): tbegin;
-        
-      } // if closing gate
-      
-      //
-      // if this sample is greater or matching the next threshold,
-      // we *are* opening gate(s)
-      //
-      else if (ppUpperThreshold && (relSample >= **ppUpperThreshold)) {
-        
+          << "Sample " << waveform[iSample] << " (" << relSample << " on "
+          << waveOps.baseline() << ") passing thr=" << thresholds[iThr]
+          << " at " << waveformTickStart << " + " << iSample;
+        channelGates[iThr].aboveThresholdAt
+          (waveformTickStart + optical_time_ticks::castFrom(iSample));
+      };
+    auto const onLeave
+      = [&](std::size_t iThr, std::size_t iSample, ADCCounts_t relSample)
+      {
         MF_LOG_TRACE(details::TriggerGateDebugLog)
-          << "Sample " << sample << " (" << relSample << " on "
-          << waveOps.baseline() << ") passing thresholds at "
-          << waveformTickStart << " + " << optical_time_ticks{ iSample };
-        
-        do { // we keep opening gates at increasing thresholds
-          
-          // note that it is not guaranteed that gates at lower thresholds are
-          // still open (that depends on the builder implementation)
-          
-          // if there is an upper threshold, there must also be a closed gate!
-          assert(nextGateToOpen != channelGates.end());
-          
-          MF_LOG_TRACE(details::TriggerGateDebugLog)
-            << "Opening thr=" << (**ppUpperThreshold);
-          
-          (nextGateToOpen++)->aboveThresholdAt
-            (waveformTickStart + optical_time_ticks{ iSample });
-          
-          if (++*ppUpperThreshold == tend) { // was this the top threshold?
-            ppUpperThreshold = std::nullopt;
-            break;
-          }
-          
-        } while (relSample >= **ppUpperThreshold);
-        
-        // we can't be at the bottom since we just opened a gate
-        ppLowerThreshold = std::prev(ppUpperThreshold? *ppUpperThreshold: tend);
-        
-      } // if opening gate
-      
-    } // for threshold
-
-    #if defined( __GNUC__ )
-    # pragma GCC diagnostic pop
-    #endif // __clang__
+          << "Sample " << waveform[iSample] << " (" << relSample << " on "
+          << waveOps.baseline() << ") leaving thr=" << thresholds[iThr]
+          << " at " << waveformTickStart << " + " << iSample;
+        channelGates[iThr].belowThresholdAt
+          (waveformTickStart + optical_time_ticks::castFrom(iSample));
+      };
+    
+    // baseline subtraction is always a subtraction (as in "A minus B"),
+    // regardless the polarity of the waveform
+    icarus::trigger::scanThresholdCrossings<Sample_t>(
+      waveform.data(), waveform.size(), thresholds, subtractBaseline,
+      onPass, onLeave
+      );
     
   } // for waveforms
   
@@ -24,9 +24,10 @@
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
 // C/C++ standard libraries
-#include <algorithm> // std::binary_search()
+#include <algorithm> // std::binary_search(), std::min(), std::max()
 #include <utility> // std::pair<>, std::move()
 #include <optional>
+#include <vector>
 #include <cassert>
 
 
@@ -66,19 +67,62 @@ auto icarus::trigger::SlidingWindowPatternAlg::simulateResponse
   
   auto const& inBeamGates = fBeamGate? fBeamGate->applyToAll(gates): gates;
   
+  return simulatePatternResponse
+    (fWindowPattern, inBeamGates, discretize(inBeamGates));
+  
+} // icarus::trigger::SlidingWindowPatternAlg::simulateResponse()
+
+
+//------------------------------------------------------------------------------
+auto icarus::trigger::SlidingWindowPatternAlg::simulateResponses(
+  icarus::trigger::WindowPatterns_t const& patterns,
+  TriggerGates_t const& gates
+) const -> std::vector<AllTriggerInfo_t>
+{
+  
+  // ensures input gates are in the same order as the configured windows
+  verifyInputTopology(gates);
+  
+  auto const& inBeamGates = fBeamGate? fBeamGate->applyToAll(gates): gates;
+  
+  std::optional<WindowLevels_t> const levels = discretize(inBeamGates);
+  
+  std::vector<AllTriggerInfo_t> responses;
+  responses.reserve(patterns.size());
+  for (WindowPattern_t const& pattern: patterns)
+    responses.push_back(simulatePatternResponse(pattern, inBeamGates, levels));
+  
+  return responses;
+} // icarus::trigger::SlidingWindowPatternAlg::simulateResponses()
+
+
+//------------------------------------------------------------------------------
+auto icarus::trigger::SlidingWindowPatternAlg::simulatePatternResponse(
+  WindowPattern_t const& pattern,
+  TriggerGates_t const& inBeamGates,
+  std::optional<WindowLevels_t> const& levels
+) const -> AllTriggerInfo_t
+{
+  
   //
   // 2.   apply pattern:
   //
   std::size_t const nWindows = fWindowTopology.nWindows();
-    
+  
+  std::vector<OpeningCount_t> buffer; // reused by all windows
+  
   //
   // 2.1.   for each main window, apply the pattern
   //
   WindowTriggerInfo_t triggerInfo; // start empty
   for (std::size_t const iWindow: util::counter(nWindows)) {
     
-    TriggerInfo_t const windowResponse
-      = applyWindowPattern(fWindowPattern, iWindow, inBeamGates);
+    TriggerInfo_t const windowResponse = levels
+      ? applyWindowPattern(
+        fWindowTopology.info(iWindow), pattern, *levels, inBeamGates, buffer
+        )
+      : applyWindowPattern(pattern, iWindow, inBeamGates)
+      ;
     
     if (!windowResponse) continue;
     
@@ -115,7 +159,7 @@ auto icarus::trigger::SlidingWindowPatternAlg::simulateResponse
   } // main window choice
   
   return { std::move(triggerInfo.info), MoreInfo_t{ triggerInfo.windowIndex } };
-} // icarus::trigger::SlidingWindowPatternAlg::simulateResponse()
+} // icarus::trigger::SlidingWindowPatternAlg::simulatePatternResponse()
 
 
 //------------------------------------------------------------------------------
@@ -338,6 +382,187 @@ auto icarus::trigger::SlidingWindowPatternAlg::applyWindowPattern(
 } // icarus::trigger::SlidingWindowTriggerEfficiencyPlots::applyWindowPattern()
 
 
+//------------------------------------------------------------------------------
+auto icarus::trigger::SlidingWindowPatternAlg::applyWindowPattern(
+  WindowTopology_t::WindowInfo_t const& windowInfo,
+  WindowPattern_t const& pattern,
+  WindowLevels_t const& levels,
+  TriggerGates_t const& gates,
+  std::vector<OpeningCount_t>& buffer
+  ) const -> TriggerInfo_t
+{
+  /*
+   * This is the same algorithm as the gate-based `applyWindowPattern()`,
+   * with the discrimination and AND performed tick by tick on the levels:
+   * 1. check that the pattern can be applied; if not, return no trigger
+   * 2. compute the levels of the trigger primitive: the base level (main or
+   *    main plus opposite window) where all the requirements are met, closed
+   *    elsewhere
+   * 3. if the primitive ever opens, convert it into a gate, find the trigger
+   *    time, fill the trigger information accordingly
+   */
+  TriggerInfo_t res; // no trigger by default
+  assert(!res);
+  
+  WindowTopology_t::WindowTopology_t const& winTopology = windowInfo.topology;
+  
+  //
+  // 1. check that the pattern can be applied; if not, return no trigger
+  //
+  if (pattern.requireUpstreamWindow && !winTopology.hasUpstreamWindow())
+    return res;
+  if (pattern.requireDownstreamWindow && !winTopology.hasDownstreamWindow())
+    return res;
+  
+  //
+  // 2. compute the levels of the trigger primitive
+  //
+  // missing windows are replaced by a closed one, and requirements which are
+  // not applied by a threshold of 0, which is always passed
+  std::size_t const nTicks = levels.nTicks;
+  auto const levelsOf = [&levels](bool present, std::size_t index)
+    { return present? levels.window(index): levels.closed(); };
+  
+  OpeningCount_t const* main = levels.window(winTopology.index);
+  OpeningCount_t const* opposite
+    = levelsOf(winTopology.hasOppositeWindow(), winTopology.opposite);
+  OpeningCount_t const* upstream
+    = levelsOf(winTopology.hasUpstreamWindow(), winTopology.upstream);
+  OpeningCount_t const* downstream
+    = levelsOf(winTopology.hasDownstreamWindow(), winTopology.downstream);
+  
+  OpeningCount_t const minMain = pattern.minInMainWindow;
+  OpeningCount_t const minOpposite = winTopology.hasOppositeWindow()
+    ? pattern.minInOppositeWindow: 0U;
+  OpeningCount_t const minSum = pattern.minSumInOppositeWindows;
+  OpeningCount_t const minUpstream = winTopology.hasUpstreamWindow()
+    ? pattern.minInUpstreamWindow: 0U;
+  OpeningCount_t const minDownstream = winTopology.hasDownstreamWindow()
+    ? pattern.minInDownstreamWindow: 0U;
+  bool const baseIsSum = (minSum > 0U);
+  
+  buffer.resize(nTicks);
+  OpeningCount_t* primitive = buffer.data();
+  OpeningCount_t anyOpen = 0U;
+  for (std::size_t iTick = 0; iTick < nTicks; ++iTick) {
+    OpeningCount_t const sum = main[iTick] + opposite[iTick];
+    bool const pass = (main[iTick] >= minMain)
+      & (opposite[iTick] >= minOpposite) & (sum >= minSum)
+      & (upstream[iTick] >= minUpstream) & (downstream[iTick] >= minDownstream);
+    OpeningCount_t const base = baseIsSum? sum: main[iTick];
+    primitive[iTick] = pass? base: 0U;
+    anyOpen |= primitive[iTick];
+  } // for
+  
+  if (!anyOpen) return res;
+  
+  //
+  // 3. convert the primitive into a gate, find the trigger time,
+  //    fill the trigger information accordingly
+  //
+  
+  // the gate is copied to keep its metadata; levels are then replaced
+  TriggerGateData_t trigPrimitive { gateIn(gates[winTopology.index]) };
+  trigPrimitive.clear();
+  trigPrimitive.setOpeningAt(trigPrimitive.MinTick, 0U);
+  OpeningCount_t level = 0U;
+  for (std::size_t iTick = 0; iTick < nTicks; ++iTick) {
+    if (primitive[iTick] == level) continue;
+    ClockTick_t const tick = levels.startTick + iTick;
+    if (primitive[iTick] > level)
+      trigPrimitive.openAt(tick, primitive[iTick] - level);
+    else
+      trigPrimitive.closeAt(tick, level - primitive[iTick]);
+    level = primitive[iTick];
+  } // for
+  assert(level == 0U); // the table always ends with all windows closed
+  
+  mfLogTrace() << "Window info #" << winTopology.index << " pattern "
+    << pattern.tag() << ": " << compactdump(trigPrimitive);
+  
+  icarus::trigger::details::GateOpeningInfoExtractor extractOpeningInfo
+    { trigPrimitive };
+
+  extractOpeningInfo.setLocation
+    (TriggerInfo_t::LocationID_t{ winTopology.index });
+
+  while (extractOpeningInfo) {
+    auto info = extractOpeningInfo();
+    if (info) res.add(info.value());
+  } // while
+
+  return res;
+  
+} // icarus::trigger::SlidingWindowPatternAlg::applyWindowPattern(levels)
+
+
+//------------------------------------------------------------------------------
+auto icarus::trigger::SlidingWindowPatternAlg::discretize
+  (TriggerGates_t const& gates) const -> std::optional<WindowLevels_t>
+{
+  
+  ClockTick_t const MinTick = TriggerGateData_t::MinTick;
+  ClockTick_t const MaxTick = TriggerGateData_t::MaxTick;
+  
+  //
+  // find the time span of all openings, and whether it is a sane one
+  //
+  ClockTick_t firstOpen = MaxTick, lastClose = MinTick;
+  for (auto const& gate: gatesIn(gates)) {
+    
+    ClockTick_t tick = gate.findOpen(1U);
+    if (tick == MaxTick) continue; // never open
+    if (tick == MinTick) return std::nullopt; // open since forever
+    firstOpen = std::min(firstOpen, tick);
+    
+    while (true) {
+      ClockTick_t const close = gate.findClose(1U, tick + 1);
+      if (close == MaxTick) return std::nullopt; // never closes
+      tick = gate.findOpen(1U, close + 1);
+      if (tick == MaxTick) {
+        lastClose = std::max(lastClose, close);
+        break;
+      }
+    } // while
+    
+  } // for gates
+  
+  WindowLevels_t levels;
+  std::size_t const nWindows = gates.size();
+  if (firstOpen == MaxTick) { // all gates are closed
+    levels.startTick = MinTick;
+    levels.nTicks = 1U;
+  }
+  else {
+    // include the tick of the last closing, where all windows are closed
+    std::size_t const nTicks = lastClose - firstOpen + 1;
+    if (nTicks > MaxLevelTicks) return std::nullopt;
+    levels.startTick = firstOpen;
+    levels.nTicks = nTicks;
+  }
+  
+  //
+  // fill the table, one opening interval at a time
+  //
+  levels.levels.assign((nWindows + 1) * levels.nTicks, 0U);
+  for (auto const& [ iWindow, gate ]: util::enumerate(gatesIn(gates))) {
+    
+    OpeningCount_t* windowLevels
+      = levels.levels.data() + iWindow * levels.nTicks;
+    ClockTick_t tick = gate.findOpen(1U);
+    while (tick != MaxTick) {
+      ClockTick_t const close = gate.findClose(1U, tick + 1);
+      for (; tick < close; ++tick)
+        windowLevels[tick - levels.startTick] = gate.openingCount(tick);
+      tick = gate.findOpen(1U, close + 1);
+    } // while
+    
+  } // for gates
+  
+  return levels;
+} // icarus::trigger::SlidingWindowPatternAlg::discretize()
+
+
 //------------------------------------------------------------------------------
 auto icarus::trigger::SlidingWindowPatternAlg::applyWindowPattern(
   WindowPattern_t const& pattern,
@@ -47,6 +47,19 @@ namespace icarus::trigger { class SlidingWindowPatternAlg; }
  * 
  * For the definition of the windows, see `icarus::trigger::WindowChannelMap`.
  * 
+ * 
+ * Implementation details
+ * -----------------------
+ * 
+ * The input gates (after the beam gate, if any) are converted once into a
+ * table of opening levels, one row per window and one column per tick, covering
+ * the time interval where any of the gates is open. The requirements of a
+ * pattern are then tested on all the ticks of a window with plain comparisons
+ * on those rows, and a trigger gate is built only for the windows which do
+ * fire. `simulateResponses()` shares the same table among many patterns.
+ * If the gates are open for too long (or forever), the pattern is evaluated
+ * by combining the trigger gates directly (`applyWindowPattern()`).
+ * 
  */
 class icarus::trigger::SlidingWindowPatternAlg
   : public icarus::ns::util::mfLoggingClass
@@ -151,6 +164,22 @@ class icarus::trigger::SlidingWindowPatternAlg
    */
   AllTriggerInfo_t simulateResponse(TriggerGates_t const& gates) const;
   
+  /**
+   * @brief Returns the trigger response to each of the `patterns`.
+   * @param patterns the requirement patterns to apply
+   * @param gates the trigger gates to be used as input, one per window
+   * @return the response to each of the `patterns`, in the same order
+   * @see `simulateResponse()`
+   * 
+   * This is equivalent to calling `simulateResponse()` from algorithms
+   * configured with each of the `patterns` in turn, but the input `gates` are
+   * verified, restricted to the beam gate and converted only once.
+   * The pattern configured in this algorithm is ignored.
+   */
+  std::vector<AllTriggerInfo_t> simulateResponses
+    (icarus::trigger::WindowPatterns_t const& patterns, TriggerGates_t const& gates)
+    const;
+  
 
   /// Returns a new collection of gates, set each in coincidence with beam gate.
   TriggerGates_t applyBeamGate(TriggerGates_t const& gates) const;
@@ -197,6 +226,34 @@ class icarus::trigger::SlidingWindowPatternAlg
   
     private:
   
+  /// Type of tick in the trigger gates.
+  using ClockTick_t = TriggerGateData_t::ClockTick_t;
+  
+  /// Type of opening level of the trigger gates.
+  using OpeningCount_t = TriggerGateData_t::OpeningCount_t;
+  
+  /// Opening levels of all windows, tick by tick.
+  struct WindowLevels_t {
+    
+    ClockTick_t startTick {}; ///< Tick of the first level of each window.
+    std::size_t nTicks = 0U; ///< Number of levels of each window.
+    
+    /// All levels, window after window; the last row is all closed.
+    std::vector<OpeningCount_t> levels;
+    
+    /// Returns the levels of window `iWindow` (`nTicks` of them).
+    OpeningCount_t const* window(std::size_t iWindow) const
+      { return levels.data() + iWindow * nTicks; }
+    
+    /// Returns a row of `nTicks` levels all closed.
+    OpeningCount_t const* closed() const
+      { return levels.data() + levels.size() - nTicks; }
+    
+  }; // WindowLevels_t
+  
+  /// Largest number of ticks converted into a level table.
+  static constexpr std::size_t MaxLevelTicks = 1U << 20;
+  
   /// Data structure to communicate internally a trigger response.
   struct WindowTriggerInfo_t {
     
@@ -242,6 +299,43 @@ class icarus::trigger::SlidingWindowPatternAlg
     TriggerGates_t const& gates
     ) const;
   
+  /**
+   * @brief Returns the trigger response for the specified window pattern.
+   * @param windowInfo the topology of the windows
+   * @param pattern the trigger requirement pattern
+   * @param levels the opening levels of all windows (see `discretize()`)
+   * @param gates trigger gates, one per window (used as gate template)
+   * @param buffer space for the opening levels of the result (overwritten)
+   * @return a `TriggerInfo_t` record with the response of the pattern
+   * @see `applyWindowPattern(WindowChannelMap::WindowInfo const&, WindowPattern_t const&, TriggerGates_t const&)`
+   * 
+   * The result is the same as the gate-based `applyWindowPattern()`.
+   */
+  TriggerInfo_t applyWindowPattern(
+    WindowTopology_t::WindowInfo_t const& windowInfo,
+    WindowPattern_t const& pattern,
+    WindowLevels_t const& levels,
+    TriggerGates_t const& gates,
+    std::vector<OpeningCount_t>& buffer
+    ) const;
+  
+  /// Returns the response to `pattern` from gates already in beam gate.
+  AllTriggerInfo_t simulatePatternResponse(
+    WindowPattern_t const& pattern,
+    TriggerGates_t const& inBeamGates,
+    std::optional<WindowLevels_t> const& levels
+    ) const;
+  
+  /**
+   * @brief Converts the `gates` into a table of opening levels.
+   * @param gates the gates, one per window
+   * @return the table, or no value if the gates are open for too long
+   * 
+   * The table covers all the ticks from the first opening of any gate to the
+   * last closing of any gate.
+   */
+  std::optional<WindowLevels_t> discretize(TriggerGates_t const& gates) const;
+  
   /**
    * @brief Checks `gates` are compatible with the current window configuration.
    * @param gates the combined sliding window trigger gates, per cryostat
@@ -0,0 +1,195 @@
+/**
+ * @file   icaruscode/PMT/Trigger/Algorithms/WaveformAdder.h
+ * @brief  Sum of baseline-subtracted digitized waveforms.
+ * @date   October 19, 2026
+ *
+ * This library is header-only.
+ */
+
+#ifndef ICARUSCODE_PMT_TRIGGER_ALGORITHMS_WAVEFORMADDER_H
+#define ICARUSCODE_PMT_TRIGGER_ALGORITHMS_WAVEFORMADDER_H
+
+
+// C/C++ standard libraries
+#include <algorithm> // std::fill_n(), std::min(), std::max()
+#include <memory> // std::unique_ptr
+#include <new> // std::align_val_t
+#include <cstddef> // std::size_t, std::ptrdiff_t
+
+
+// -----------------------------------------------------------------------------
+namespace icarus::trigger { class WaveformAdder; }
+
+/**
+ * @brief Adds baseline-subtracted digitized waveforms into a single one.
+ *
+ * The sum covers a fixed number of samples, all initialized to `0`.
+ * Each waveform is added with `add()`, specifying where its first sample lies
+ * with respect to the first sample of the sum: waveforms may start before or
+ * after the sum and have any length, and only the samples overlapping the sum
+ * are added. Finally, `scale()` may be applied to the whole sum.
+ *
+ * The samples of the sum are stored in single precision in a buffer aligned to
+ * `Alignment` bytes, and each addition is a single loop on contiguous data
+ * without branches, which the compiler can vectorize.
+ *
+ * Each sample of the sum is the result of the same sequence of floating point
+ * operations as for the sum of whole waveforms in a `std::valarray<float>`:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * for (float& sample: sum) sample += *(itWaveform++);
+ * sum -= baseline;
+ * // ... (more waveforms)
+ * sum *= scale;
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * and therefore the result is identical to the last bit.
+ *
+ * Example of usage:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * icarus::trigger::WaveformAdder adder{ 2000 };
+ * for (raw::OpDetWaveform const& waveform: waveforms) {
+ *   adder.add
+ *     (waveform.data(), waveform.size(), startTick(waveform), baseline(waveform));
+ * }
+ * adder.scale(0.5f);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * where `startTick()` would return the tick of the first sample of the
+ * waveform relative to the first sample of the sum.
+ */
+class icarus::trigger::WaveformAdder {
+
+    public:
+
+  /// Alignment of the sum samples in memory [bytes].
+  static constexpr std::size_t Alignment = 64U;
+
+  /// Type of the samples of the sum.
+  using Sample_t = float;
+
+
+  /// Constructor: a sum of `nSamples` samples, all `0`.
+  explicit WaveformAdder(std::size_t nSamples = 0U)
+    : fSamples{ allocate(nSamples) }, fNSamples{ nSamples }
+    { std::fill_n(fSamples.get(), fNSamples, Sample_t{ 0 }); }
+
+
+  /**
+   * @brief Adds a waveform, subtracting its `baseline` from each sample.
+   * @tparam Sample type of the samples of the waveform
+   * @param samples pointer to the first sample of the waveform
+   * @param nSamples number of samples in the waveform
+   * @param startSample position of the first waveform sample in the sum
+   * @param baseline (default: `0`) baseline to be subtracted
+   * @return the number of samples added
+   *
+   * The waveform sample `samples[i]` is added to the sample
+   * `startSample + i` of the sum, which may be negative (waveform starting
+   * before the sum) or beyond the end of the sum. Only the samples of the sum
+   * overlapping the waveform are affected, including the subtraction of the
+   * `baseline`.
+   */
+  template <typename Sample>
+  std::size_t add(
+    Sample const* samples, std::size_t nSamples,
+    std::ptrdiff_t startSample, Sample_t baseline = Sample_t{ 0 }
+    );
+
+  /// Multiplies all the samples of the sum by `factor`.
+  void scale(Sample_t factor);
+
+
+  // --- BEGIN -- Access to the sum --------------------------------------------
+  /// @name Access to the sum
+  /// @{
+
+  /// Returns the number of samples in the sum.
+  std::size_t size() const { return fNSamples; }
+
+  /// Returns whether the sum has no sample.
+  bool empty() const { return fNSamples == 0U; }
+
+  /// Returns a pointer to the first sample of the sum.
+  Sample_t const* data() const { return fSamples.get(); }
+
+  /// Returns the sample `i` of the sum (no range check).
+  Sample_t operator[] (std::size_t i) const { return fSamples[i]; }
+
+  /// Returns an iterator to the first sample of the sum.
+  Sample_t const* begin() const { return data(); }
+
+  /// Returns an iterator past the last sample of the sum.
+  Sample_t const* end() const { return data() + size(); }
+
+  /// @}
+  // --- END ---- Access to the sum --------------------------------------------
+
+
+    private:
+
+  /// Deleter of the aligned sample buffer.
+  struct AlignedDeleter {
+    void operator() (Sample_t* ptr) const
+      { ::operator delete[](ptr, std::align_val_t{ Alignment }); }
+  }; // AlignedDeleter
+
+  using Buffer_t = std::unique_ptr<Sample_t[], AlignedDeleter>;
+
+  Buffer_t fSamples; ///< Samples of the sum.
+
+  std::size_t fNSamples = 0U; ///< Number of samples in the sum.
+
+
+  /// Returns an uninitialized buffer of `nSamples` samples.
+  static Buffer_t allocate(std::size_t nSamples)
+    {
+      return Buffer_t{ static_cast<Sample_t*>(::operator new[]
+        (nSamples * sizeof(Sample_t), std::align_val_t{ Alignment })
+        ) };
+    }
+
+}; // icarus::trigger::WaveformAdder
+
+
+// -----------------------------------------------------------------------------
+// --- template implementation
+// -----------------------------------------------------------------------------
+template <typename Sample>
+std::size_t icarus::trigger::WaveformAdder::add(
+  Sample const* samples, std::size_t nSamples,
+  std::ptrdiff_t startSample, Sample_t baseline /* = 0 */
+) {
+
+  // range of the sum covered by the waveform
+  std::ptrdiff_t const first = std::max(startSample, std::ptrdiff_t{ 0 });
+  std::ptrdiff_t const last = std::min(
+    startSample + static_cast<std::ptrdiff_t>(nSamples),
+    static_cast<std::ptrdiff_t>(fNSamples)
+    );
+  if (first >= last) return 0U;
+
+  std::size_t const n = last - first;
+  Sample_t* const sum = fSamples.get() + first;
+  Sample const* const src = samples + (first - startSample);
+
+  // the order of the operations is the same as adding the waveform first
+  // and subtracting the baseline after, sample by sample
+  for (std::size_t i = 0; i < n; ++i)
+    sum[i] = (sum[i] + static_cast<Sample_t>(src[i])) - baseline;
+
+  return n;
+} // icarus::trigger::WaveformAdder::add()
+
+
+// -----------------------------------------------------------------------------
+inline void icarus::trigger::WaveformAdder::scale(Sample_t factor) {
+
+  if (factor == Sample_t{ 1 }) return; // exact no-op
+
+  Sample_t* const sum = fSamples.get();
+  for (std::size_t i = 0; i < fNSamples; ++i) sum[i] *= factor;
+
+} // icarus::trigger::WaveformAdder::scale()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSCODE_PMT_TRIGGER_ALGORITHMS_WAVEFORMADDER_H
@@ -0,0 +1,271 @@
+/**
+ * @file   icaruscode/PMT/Trigger/Algorithms/benchmarkWaveformAdder.cxx
+ * @brief  Compares `std::valarray` and `WaveformAdder` sums of PMT waveforms.
+ * @date   October 19, 2026
+ *
+ * The program builds the adder waveforms of `DiscriminatedAdderSignal` from
+ * synthetic PMT waveforms in two ways:
+ *
+ * * _valarray_: each waveform is added to a `std::valarray<float>`, and its
+ *   baseline is subtracted in a second pass (the original module);
+ * * _kernel_: each waveform is added and its baseline subtracted in a single
+ *   pass by `icarus::trigger::WaveformAdder`.
+ *
+ * The two sums are checked to be identical to the last bit, and the number of
+ * adder waveforms per second is printed for both.
+ * Run `benchmarkWaveformAdder --help` for the options.
+ */
+
+// ICARUS libraries
+#include "icaruscode/PMT/Trigger/Algorithms/WaveformAdder.h"
+
+// C++/Boost libraries
+#include "boost/program_options.hpp"
+#include <algorithm> // std::min()
+#include <chrono>
+#include <cstddef> // std::size_t
+#include <cstdlib> // std::exit()
+#include <cstring> // std::memcmp()
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <valarray>
+#include <vector>
+
+/*
+ * Notable changes here:
+ *
+ * [20261019] [1.0]
+ *     initial version
+ *
+ */
+static std::string const ProgramVersion = "v1.0";
+
+
+// -----------------------------------------------------------------------------
+/// Parameters of the benchmark.
+struct Config_t {
+  unsigned int nChannels = 15U; ///< PMT channels in an adder.
+  unsigned int nSamples = 5000U; ///< Samples of each PMT waveform.
+  unsigned int nAdderSamples = 4500U; ///< Samples of each adder waveform.
+  unsigned int nAdders = 20000U; ///< Adder waveforms for each measurement.
+  float scale = 1.0f; ///< Scale factor of the adder waveforms.
+}; // Config_t
+
+
+// -----------------------------------------------------------------------------
+std::optional<Config_t> parseCommandLine(int argc, char** argv) {
+
+  namespace po = boost::program_options;
+
+  Config_t config;
+
+  po::options_description benchopt("Benchmark");
+  benchopt.add_options()
+    ("channels", po::value(&config.nChannels)->default_value(config.nChannels),
+      "PMT channels in each adder")
+    ("samples", po::value(&config.nSamples)->default_value(config.nSamples),
+      "samples of each PMT waveform")
+    ("addersamples",
+      po::value(&config.nAdderSamples)->default_value(config.nAdderSamples),
+      "samples of each adder waveform")
+    ("adders", po::value(&config.nAdders)->default_value(config.nAdders),
+      "adder waveforms built for each measurement")
+    ("scale", po::value(&config.scale)->default_value(config.scale),
+      "scale factor of the adder waveforms")
+    ;
+
+  po::options_description genopt("General");
+  genopt.add_options()
+    ("help,?", "print usage instructions and exit")
+    ("version,V", "print version and exit")
+    ;
+
+  po::options_description allopt("Options");
+  allopt.add(benchopt).add(genopt);
+
+  po::variables_map optmap;
+  po::store(po::parse_command_line(argc, argv, allopt), optmap);
+  po::notify(optmap);
+
+  std::optional<int> exitWithCode;
+  if (optmap.count("version")) {
+    std::cout << argv[0] << " version " << ProgramVersion << std::endl;
+    exitWithCode = 0;
+  }
+  if (optmap.count("help")) {
+    std::cout
+      <<   "Compares the sum of PMT waveforms of DiscriminatedAdderSignal"
+      << "\nwith std::valarray and with icarus::trigger::WaveformAdder."
+      << "\n" << allopt
+      << std::endl
+      ;
+    exitWithCode = 0;
+  }
+  if (exitWithCode) std::exit(*exitWithCode);
+
+  if ((config.nChannels == 0U) || (config.nAdderSamples == 0U)
+    || (config.nAdders == 0U))
+  {
+    std::cerr << "No data to process!" << std::endl;
+    return std::nullopt;
+  }
+  if (config.nAdderSamples > config.nSamples) {
+    std::cerr << "Adder waveforms (" << config.nAdderSamples
+      << " samples) can't be longer than PMT waveforms (" << config.nSamples
+      << " samples)." << std::endl;
+    return std::nullopt;
+  }
+
+  return config;
+
+} // parseCommandLine()
+
+
+// -----------------------------------------------------------------------------
+/// A PMT waveform with its baseline.
+struct Waveform_t {
+  std::vector<short int> samples;
+  float baseline;
+};
+
+/// The input of one adder: one waveform per channel.
+struct Adder_t {
+  std::vector<Waveform_t> waveforms;
+  std::size_t startSample; ///< First sample of each waveform in the adder.
+};
+
+
+/// Returns synthetic adder inputs, with PMT-like noise and pulses.
+std::vector<Adder_t> makeAdders(Config_t const& config, unsigned int nAdders) {
+
+  std::mt19937 engine{ 12345U };
+  std::uniform_real_distribution<float> baseline{ 14800.0f, 15200.0f };
+  std::normal_distribution<float> noise{ 0.0f, 2.5f };
+  std::exponential_distribution<float> pulse{ 1.0f / 300.0f };
+  std::bernoulli_distribution hasPulse{ 0.01 };
+  std::uniform_int_distribution<std::size_t> start
+    { 0U, config.nSamples - config.nAdderSamples };
+
+  std::vector<Adder_t> adders(nAdders);
+  for (Adder_t& adder: adders) {
+    adder.startSample = start(engine);
+    adder.waveforms.resize(config.nChannels);
+    for (Waveform_t& waveform: adder.waveforms) {
+      waveform.baseline = baseline(engine);
+      waveform.samples.resize(config.nSamples);
+      float signal = 0.0f;
+      for (short int& sample: waveform.samples) {
+        signal = 0.8f * signal + (hasPulse(engine)? pulse(engine): 0.0f);
+        sample = static_cast<short int>
+          (waveform.baseline + noise(engine) - signal);
+      }
+    } // for waveforms
+  } // for adders
+
+  return adders;
+} // makeAdders()
+
+
+/// Adds the waveforms of `adder` in a `std::valarray` (the original module).
+std::valarray<float> addValarray(Config_t const& config, Adder_t const& adder)
+{
+  std::valarray<float> added(0.0f, config.nAdderSamples);
+  for (Waveform_t const& waveform: adder.waveforms) {
+    auto itSample = std::next(waveform.samples.cbegin(), adder.startSample);
+    for (float& sample: added) sample += *(itSample++);
+
+    added -= waveform.baseline;
+  }
+  added *= config.scale;
+  return added;
+} // addValarray()
+
+
+/// Adds the waveforms of `adder` with `icarus::trigger::WaveformAdder`.
+icarus::trigger::WaveformAdder addKernel
+  (Config_t const& config, Adder_t const& adder)
+{
+  icarus::trigger::WaveformAdder added{ config.nAdderSamples };
+  for (Waveform_t const& waveform: adder.waveforms) {
+    added.add(
+      waveform.samples.data(), waveform.samples.size(),
+      -static_cast<std::ptrdiff_t>(adder.startSample), waveform.baseline
+      );
+  }
+  added.scale(config.scale);
+  return added;
+} // addKernel()
+
+
+/// Returns the adders per second of `process` run on all `adders`.
+template <typename Process>
+double adderRate(std::vector<Adder_t> const& adders, Process&& process) {
+  process(adders.front()); // warm up (not measured)
+  auto const start = std::chrono::steady_clock::now();
+  for (Adder_t const& adder: adders) process(adder);
+  double const seconds = std::chrono::duration<double>
+    (std::chrono::steady_clock::now() - start).count();
+  return adders.size() / seconds;
+} // adderRate()
+
+
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv) {
+
+  std::optional<Config_t> const maybeConfig = parseCommandLine(argc, argv);
+  if (!maybeConfig) return 1;
+  Config_t const& config = *maybeConfig;
+
+  // the adders cycle over a smaller set, to keep the memory usage limited
+  std::vector<Adder_t> const adders
+    = makeAdders(config, std::min(config.nAdders, 100U));
+
+  std::cout << "Adders of " << config.nChannels << " waveforms, "
+    << config.nAdderSamples << " samples each." << std::endl;
+
+  // check that the two methods agree to the last bit
+  unsigned int nDifferent = 0U;
+  for (Adder_t const& adder: adders) {
+    std::valarray<float> const expected = addValarray(config, adder);
+    icarus::trigger::WaveformAdder const added = addKernel(config, adder);
+    if (std::memcmp
+      (added.data(), &expected[0], expected.size() * sizeof(float)) != 0)
+    {
+      ++nDifferent;
+    }
+  } // for adders
+  std::cout << nDifferent << " of " << adders.size()
+    << " adder waveforms are different." << std::endl;
+
+  // the result is accumulated so that the sums are not optimized away
+  double checksum = 0.0;
+  unsigned int const nPasses
+    = (config.nAdders + adders.size() - 1) / adders.size();
+  double valarrayRate = 0.0, kernelRate = 0.0;
+  for (unsigned int pass = 0; pass < nPasses; ++pass) {
+    valarrayRate += adderRate(adders,
+      [&](Adder_t const& adder){ checksum += addValarray(config, adder)[0]; });
+    kernelRate += adderRate(adders,
+      [&](Adder_t const& adder){ checksum -= addKernel(config, adder)[0]; });
+  } // for passes
+  valarrayRate /= nPasses;
+  kernelRate /= nPasses;
+
+  std::cout << "\n" << std::setw(18) << "valarray [adder/s]"
+    << std::setw(18) << "kernel [adder/s]" << std::setw(10) << "speedup"
+    << std::endl;
+  std::cout << std::fixed << std::setprecision(1)
+    << std::setw(18) << valarrayRate << std::setw(18) << kernelRate
+    << std::setprecision(2) << std::setw(10) << (kernelRate / valarrayRate)
+    << std::endl;
+  if (checksum != 0.0) std::cout << "(checksum: " << checksum << ")" << std::endl;
+
+  return (nDifferent == 0U)? 0: 2;
+
+} // main()
+
+
+// -----------------------------------------------------------------------------
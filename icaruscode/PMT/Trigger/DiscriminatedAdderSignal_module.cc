@@ -10,6 +10,7 @@
 #include "icaruscode/PMT/Trigger/Algorithms/SlidingWindowDefinitionAlg.h"
 #include "icaruscode/PMT/Trigger/Algorithms/TriggerGateBuilder.h"
 #include "icaruscode/PMT/Trigger/Algorithms/TriggerTypes.h" // ADCCounts_t
+#include "icaruscode/PMT/Trigger/Algorithms/WaveformAdder.h"
 #include "icaruscode/PMT/Trigger/Utilities/TriggerGateOperations.h" // GateOps
 #include "icaruscode/PMT/Trigger/Utilities/TriggerDataUtils.h"
 #include "icaruscode/PMT/Algorithms/OpDetWaveformMetaUtils.h" // OpDetWaveformMetaMaker
@@ -65,7 +66,6 @@
 #include <functional> // std::mem_fn()
 #include <memory> // std::unique_ptr
 #include <map>
-#include <valarray>
 #include <vector>
 #include <string>
 #include <optional>
@@ -512,8 +512,11 @@ class icarus::trigger::DiscriminatedAdderSignal: public art::SharedProducer {
    * 
    * It is assumed that for each channel _one_ of the input `waveforms` covers
    * the whole `timeInterval`.
+   * The samples of each waveform are added, minus their baseline, in a single
+   * pass by `icarus::trigger::WaveformAdder`.
    */
-  std::pair<std::valarray<float> , std::vector<WaveformWithBaseline const*>>
+  std::pair
+    <icarus::trigger::WaveformAdder, std::vector<WaveformWithBaseline const*>>
   addWaveformsInInterval(
     TimeInterval_t const& timeInterval,
     std::vector<std::vector<WaveformWithBaseline const*>> const& waveforms,
@@ -1116,7 +1119,7 @@ auto icarus::trigger::DiscriminatedAdderSignal::makeAdderWaveform(
     auto const [ startBaseline, endBaseline ]
       = computeSimpleBaselines(added, 500_ns);
     float const peak
-      = startBaseline - *std::min_element(begin(added), end(added));
+      = startBaseline - *std::min_element(added.begin(), added.end());
     mf::LogTrace log{ fLogCategory };
     log << "Adder waveform CH=" << waveform.ChannelNumber()
       << " created from " << contribs.size() << " waveforms: "
@@ -1239,13 +1242,14 @@ auto icarus::trigger::DiscriminatedAdderSignal::addWaveformsInInterval(
   std::vector<std::vector<WaveformWithBaseline const*>> const& waveforms,
   raw::Channel_t channel /* = std::numeric_limits<raw::Channel_t>::max() */
 ) const
-  -> std::pair<std::valarray<float> , std::vector<WaveformWithBaseline const*>>
+  -> std::pair
+    <icarus::trigger::WaveformAdder, std::vector<WaveformWithBaseline const*>>
 {
   
   std::size_t const nSamples = timeInterval.empty()
     ? 0: tickDistance(timeInterval.start, timeInterval.stop);
   
-  std::valarray<float> added(0.0f, nSamples);
+  icarus::trigger::WaveformAdder added{ nSamples };
   std::vector<WaveformWithBaseline const*> used;
   
   mf::LogTrace{ fLogCategory } << "Building adder waveform CH=" << channel
@@ -1268,10 +1272,10 @@ auto icarus::trigger::DiscriminatedAdderSignal::addWaveformsInInterval(
       std::ptrdiff_t const startSample
         = tickDistance(wfCoverage.start, timeInterval.start);
       
-      auto itSample = std::next(wi->waveform().cbegin(), startSample);
-      for (float& sample: added) sample += *(itSample++);
-      
-      if (wi->hasBaseline()) added -= wi->baseline().baseline();
+      added.add(
+        wi->waveform().data(), wi->waveform().size(), -startSample,
+        wi->hasBaseline()? wi->baseline().baseline(): 0.0f
+        );
       
       { // --- BEGIN -- DEBUG --------------------------------------------------
         auto const [ startBaseline, endBaseline ]
@@ -1326,7 +1330,7 @@ auto icarus::trigger::DiscriminatedAdderSignal::addWaveformsInInterval(
     
   } // for channels
   
-  added *= fAmplitudeScale;
+  added.scale(fAmplitudeScale);
   
   return { std::move(added), std::move(used) };
   
@@ -48,6 +48,7 @@
 #include <vector>
 #include <array>
 #include <memory> // std::unique_ptr
+#include <optional>
 #include <utility> // std::pair<>, std::move()
 #include <limits> // std::numeric_limits<>
 #include <type_traits> // std::is_pointer_v, ...
@@ -399,8 +400,8 @@ class icarus::trigger::SlidingWindowTriggerEfficiencyPlots
   // mutable = not thread-safe; optional to allow delayed construction
   mutable icarus::trigger::WindowTopologyManager fWindowMapMan;
   
-  /// All algorithm instances, one per pattern.
-  std::vector<icarus::trigger::SlidingWindowPatternAlg> fPatternAlgs;
+  /// Algorithm instance, simulating all patterns at once.
+  std::optional<icarus::trigger::SlidingWindowPatternAlg> fPatternAlg;
   
   std::unique_ptr<ResponseTree> fResponseTree; ///< Handler of ROOT tree output.
   
@@ -783,12 +784,12 @@ void icarus::trigger::SlidingWindowTriggerEfficiencyPlots::simulateAndPlot(
   //
   // 2. for each pattern:
   //
+  std::vector<WindowTriggerInfo_t> const responses
+    = fPatternAlg->simulateResponses(fPatterns, inBeamGates);
+  
   for (auto const& [ iPattern, pattern ]: util::enumerate(fPatterns)) {
 
-    auto& patternAlg = fPatternAlgs[iPattern];
-    
-    WindowTriggerInfo_t const triggerInfo
-      = patternAlg.simulateResponse(inBeamGates);
+    WindowTriggerInfo_t const& triggerInfo = responses[iPattern];
     
     registerTriggerResult(thresholdIndex, iPattern, triggerInfo.info);
 
@@ -819,9 +820,10 @@ void
 icarus::trigger::SlidingWindowTriggerEfficiencyPlots::initializePatternAlgorithms
   ()
 {
-  fPatternAlgs.clear();
-  for (auto const& pattern: fPatterns)
-    fPatternAlgs.emplace_back(*fWindowMapMan, pattern, helper().logCategory());
+  // the pattern of the algorithm is not used: all patterns are simulated at once
+  assert(!fPatterns.empty());
+  fPatternAlg.emplace
+    (*fWindowMapMan, fPatterns.front(), helper().logCategory());
 } // icarus::trigger::SlidingWindowTriggerEfficiencyPlots::initializePatternAlgorithms()
 
 
@@ -10,7 +10,7 @@
 #include "icaruscode/PMT/Trigger/Algorithms/BeamGateStruct.h"
 #include "icaruscode/PMT/Trigger/Algorithms/BeamGateMaker.h"
 #include "icaruscode/PMT/Trigger/Algorithms/TriggerTypes.h" // ADCCounts_t
-#include "icaruscode/PMT/Trigger/Utilities/TriggerGateOperations.h" // sumGates()
+#include "icaruscode/PMT/Trigger/Utilities/TriggerGateOperations.h" // sumGates(), maxGates()
 #include "icaruscode/PMT/Trigger/Utilities/TriggerDataUtils.h" // FillTriggerGates()
 #include "icarusalg/Utilities/PlotSandbox.h"
 #include "icarusalg/Utilities/ROOTutils.h" // util::ROOT
@@ -2221,15 +2221,8 @@ auto icarus::trigger::TriggerEfficiencyPlots::computeMaxGate
   (TrigGateColl const& gates)
 {
   
-  // if `gates` is empty return a default-constructed gate of the contained type
-  if (empty(gates)) return decltype(*begin(gates)){};
-  
-  auto iGate = cbegin(gates);
-  auto const gend = cend(gates);
-  auto maxGate = *iGate;
-  while (++iGate != gend) maxGate.Max(*iGate);
-  
-  return maxGate;
+  // if `gates` is empty returns a default-constructed gate
+  return icarus::trigger::maxGates(gates);
 } // icarus::trigger::TriggerEfficiencyPlots::computeMaxGate()
 
 
@@ -0,0 +1,280 @@
+/**
+ * @file   icaruscode/PMT/Trigger/Utilities/ThresholdCrossingScan.h
+ * @brief  Finds where a waveform crosses a set of thresholds.
+ * @date   October 19, 2026
+ * @see    `icaruscode/PMT/Trigger/Algorithms/ManagedTriggerGateBuilder.tcc`
+ *
+ * This library is header-only.
+ */
+
+#ifndef ICARUSCODE_PMT_TRIGGER_UTILITIES_THRESHOLDCROSSINGSCAN_H
+#define ICARUSCODE_PMT_TRIGGER_UTILITIES_THRESHOLDCROSSINGSCAN_H
+
+
+// C/C++ standard libraries
+#include <vector>
+#include <algorithm> // std::min(), std::max()
+#include <limits> // std::numeric_limits<>
+#include <tuple> // std::tie()
+#include <utility> // std::make_pair(), std::pair
+#include <cstddef> // std::size_t
+
+
+namespace icarus::trigger {
+
+  /**
+   * @brief Calls back at each crossing of `thresholds` by the samples.
+   * @tparam Sample type of the raw sample
+   * @tparam Threshold type of the thresholds
+   * @tparam RelSample type of the callable converting a sample into
+   *                   the threshold scale
+   * @tparam OnPass type of the callable for thresholds being passed
+   * @tparam OnLeave type of the callable for thresholds being left
+   * @param samples pointer to the first sample of the waveform
+   * @param nSamples number of samples in the waveform
+   * @param thresholds list of thresholds, sorted in increasing order
+   * @param relSample callable converting a sample into the threshold scale
+   * @param onPass called as `onPass(iThreshold, iSample, relSample)`
+   * @param onLeave called as `onLeave(iThreshold, iSample, relSample)`
+   *
+   * The waveform starts below all the thresholds. A threshold is passed
+   * when a sample (converted by `relSample`) is at least as large as it,
+   * and it is left when a sample is smaller than it; `onPass` is called for
+   * all the thresholds passed by a sample in increasing order, and `onLeave`
+   * for all the thresholds left by a sample in decreasing order. A sample
+   * can either pass or leave thresholds, but not both: a sample lower than
+   * the current lower threshold is only checked for leaving thresholds.
+   *
+   * The conversion `relSample` must be monotonic in the raw sample value, as
+   * a baseline subtraction followed by rounding is. The bracket between the
+   * two thresholds enclosing the current level of the waveform is then
+   * translated into a range of raw sample values, and the waveform is
+   * scanned for the next sample out of that range directly, without
+   * converting each sample.
+   *
+   * The conversion is only evaluated on raw values between the lowest and
+   * the highest sample of the waveform, and it is required to be monotonic
+   * only there. For example, a baseline subtraction returning `short` (which
+   * overflows far from the baseline, e.g. at the opposite end of the range
+   * of `short` from a baseline of 15000 ADC) is still fine.
+   */
+  template <
+    typename Sample, typename Threshold, typename RelSample,
+    typename OnPass, typename OnLeave
+    >
+  void scanThresholdCrossings(
+    Sample const* samples, std::size_t nSamples,
+    std::vector<Threshold> const& thresholds, RelSample relSample,
+    OnPass onPass, OnLeave onLeave
+    );
+
+
+  namespace details {
+
+    /**
+     * @brief Returns the raw sample values matching each of the `thresholds`.
+     * @tparam Sample type of the raw sample
+     * @tparam Threshold type of the thresholds
+     * @tparam RelSample type of the callable converting a sample into
+     *                   the threshold scale
+     * @param thresholds sorted list of thresholds
+     * @param relSample callable converting a sample into the threshold scale
+     * @param rising whether `relSample` increases with the raw sample value
+     * @param lowest the lowest raw value to consider
+     * @param highest the highest raw value to consider
+     * @return the sample value at which each threshold is crossed
+     *
+     * The conversion `relSample` must be monotonic in the raw sample value
+     * within `[ lowest, highest ]`, and it is evaluated only there.
+     * Under that condition, the samples at or above a threshold `thr` form a
+     * single half-line of raw values, which is delimited by the returned
+     * value `cut`: the sample `s` passes `thr` if `s >= cut` (`rising`) or
+     * `s <= cut` (not `rising`). When no raw value in the range passes,
+     * `cut` is just outside the range.
+     */
+    template <typename Sample, typename Threshold, typename RelSample>
+    std::vector<int> rawThresholdCuts(
+      std::vector<Threshold> const& thresholds, RelSample relSample,
+      bool rising, int lowest, int highest
+      );
+
+
+    /// Returns the lowest and the highest of the `nSamples` samples.
+    template <typename Sample>
+    std::pair<Sample, Sample> sampleRange
+      (Sample const* samples, std::size_t nSamples);
+
+
+    /**
+     * @brief Returns the index of the first sample outside `[ low, high ]`.
+     * @param samples pointer to the samples
+     * @param begin index of the first sample to test
+     * @param end index after the last sample to test
+     * @param low lowest sample value considered inside
+     * @param high highest sample value considered inside
+     * @return the index of the first sample outside the range, `end` if none
+     *
+     * The samples are tested in blocks of fixed size without branching,
+     * which allows the compiler to vectorize the test; only the block with
+     * the crossing is then walked one sample at a time.
+     */
+    template <typename Sample>
+    std::size_t findFirstOutside(
+      Sample const* samples, std::size_t begin, std::size_t end,
+      int low, int high
+      );
+
+  } // namespace details
+
+} // namespace icarus::trigger
+
+
+//------------------------------------------------------------------------------
+//--- template implementation
+//------------------------------------------------------------------------------
+template <typename Sample, typename Threshold, typename RelSample>
+std::vector<int> icarus::trigger::details::rawThresholdCuts(
+  std::vector<Threshold> const& thresholds, RelSample relSample,
+  bool rising, int lowest, int highest
+) {
+  std::vector<int> cuts;
+  cuts.reserve(thresholds.size());
+  for (Threshold const& threshold: thresholds) {
+
+    // find the first raw value on which the test changes answer
+    auto const passes = [&relSample,&threshold](int s)
+      { return relSample(static_cast<Sample>(s)) >= threshold; };
+    int low = lowest, high = highest + 1;
+    while (low < high) {
+      int const middle = low + (high - low) / 2;
+      if (passes(middle) == rising) high = middle;
+      else                          low = middle + 1;
+    } // while
+
+    cuts.push_back(rising? low: low - 1);
+  } // for thresholds
+  return cuts;
+} // icarus::trigger::details::rawThresholdCuts()
+
+
+//------------------------------------------------------------------------------
+template <typename Sample>
+std::pair<Sample, Sample> icarus::trigger::details::sampleRange
+  (Sample const* samples, std::size_t nSamples)
+{
+  // plain loop on values (not iterators), which the compiler can vectorize
+  Sample lowest = std::numeric_limits<Sample>::max();
+  Sample highest = std::numeric_limits<Sample>::lowest();
+  for (std::size_t i = 0; i < nSamples; ++i) {
+    lowest = std::min(lowest, samples[i]);
+    highest = std::max(highest, samples[i]);
+  }
+  return { lowest, highest };
+} // icarus::trigger::details::sampleRange()
+
+
+//------------------------------------------------------------------------------
+template <typename Sample>
+std::size_t icarus::trigger::details::findFirstOutside(
+  Sample const* samples, std::size_t begin, std::size_t end,
+  int low, int high
+) {
+  constexpr std::size_t BlockSize = 32;
+
+  std::size_t iSample = begin;
+  while (iSample + BlockSize <= end) {
+    unsigned int outside = 0U;
+    for (std::size_t i = 0; i < BlockSize; ++i) {
+      int const sample = samples[iSample + i];
+      outside |= (sample < low) | (sample > high);
+    }
+    if (outside) break;
+    iSample += BlockSize;
+  } // while blocks
+
+  for (; iSample < end; ++iSample) {
+    int const sample = samples[iSample];
+    if ((sample < low) || (sample > high)) return iSample;
+  }
+  return end;
+} // icarus::trigger::details::findFirstOutside()
+
+
+//------------------------------------------------------------------------------
+template <
+  typename Sample, typename Threshold, typename RelSample,
+  typename OnPass, typename OnLeave
+  >
+void icarus::trigger::scanThresholdCrossings(
+  Sample const* samples, std::size_t nSamples,
+  std::vector<Threshold> const& thresholds, RelSample relSample,
+  OnPass onPass, OnLeave onLeave
+) {
+  std::size_t const nThresholds = thresholds.size();
+  if (nSamples == 0) return;
+
+  // translate the thresholds into raw sample values; the conversion is
+  // evaluated only within the range of the samples of this waveform
+  auto const [ lowestSample, highestSample ]
+    = details::sampleRange(samples, nSamples);
+  bool const rising = relSample(highestSample) >= relSample(lowestSample);
+  std::vector<int> const rawCuts = details::rawThresholdCuts<Sample>
+    (thresholds, relSample, rising, lowestSample, highestSample);
+
+  // `nBelow` is the number of thresholds the waveform is currently at or
+  // above of, i.e. the index of the next higher threshold (if any),
+  // while `nBelow - 1` is the one of the lower (if any)
+  std::size_t nBelow = 0;
+
+  // range of raw samples which do not cross either enclosing threshold
+  auto rawBracket = [&rawCuts,nThresholds,rising](std::size_t nBelow)
+    {
+      constexpr int noLimit = std::numeric_limits<int>::max();
+      int const passLower = (nBelow > 0)? rawCuts[nBelow - 1]: 0;
+      int const passUpper = (nBelow < nThresholds)? rawCuts[nBelow]: 0;
+      return rising
+        ? std::make_pair(
+            (nBelow > 0)? passLower: -noLimit,
+            (nBelow < nThresholds)? passUpper - 1: noLimit
+          )
+        : std::make_pair(
+            (nBelow < nThresholds)? passUpper + 1: -noLimit,
+            (nBelow > 0)? passLower: noLimit
+          )
+        ;
+    };
+
+  auto [ lowSample, highSample ] = rawBracket(nBelow);
+
+  for (std::size_t iSample = 0; iSample < nSamples; ++iSample) {
+
+    // skip to the next sample which crosses one of the thresholds
+    iSample = details::findFirstOutside
+      (samples, iSample, nSamples, lowSample, highSample);
+    if (iSample == nSamples) break;
+
+    auto const rel = relSample(samples[iSample]);
+
+    if ((nBelow > 0) && (rel < thresholds[nBelow - 1])) {
+      do { // we keep leaving decreasing thresholds
+        --nBelow;
+        onLeave(nBelow, iSample, rel);
+      } while ((nBelow > 0) && (rel < thresholds[nBelow - 1]));
+    }
+    else if ((nBelow < nThresholds) && (rel >= thresholds[nBelow])) {
+      do { // we keep passing increasing thresholds
+        onPass(nBelow, iSample, rel);
+        ++nBelow;
+      } while ((nBelow < nThresholds) && (rel >= thresholds[nBelow]));
+    }
+
+    std::tie(lowSample, highSample) = rawBracket(nBelow);
+
+  } // for samples
+
+} // icarus::trigger::scanThresholdCrossings()
+
+
+//------------------------------------------------------------------------------
+
+#endif // ICARUSCODE_PMT_TRIGGER_UTILITIES_THRESHOLDCROSSINGSCAN_H
@@ -124,7 +124,7 @@ class icarus::trigger::TrackedTriggerGate {
     bool hasTracked() const;
     
     /// Returns an iterable of all tracked objects.
-    auto getTracked() const;
+    auto const& getTracked() const;
     
   }; // class TrackingInfo
   
@@ -225,7 +225,7 @@ icarus::trigger::TrackedTriggerGate<Gate, TrackedType>::TrackingInfo::hasTracked
 
 // -----------------------------------------------------------------------------
 template <typename Gate, typename TrackedType>
-auto icarus::trigger::TrackedTriggerGate<Gate, TrackedType>::TrackingInfo::getTracked()
+auto const& icarus::trigger::TrackedTriggerGate<Gate, TrackedType>::TrackingInfo::getTracked()
   const
   { return fTracked; }
 
@@ -16,7 +16,12 @@
 #include "sbnobj/ICARUS/PMT/Trigger/Data/OpticalTriggerGate.h"
 
 // C/C++ standard libraries
-#include <iterator> // std::iterator_traits
+#include <vector>
+#include <iterator> // std::iterator_traits, std::distance()
+#include <utility> // std::move(), std::as_const()
+#include <type_traits> // std::decay_t, std::is_same_v
+#include <cassert>
+#include <cstddef> // std::size_t
 
 
 namespace icarus::trigger {
@@ -33,6 +38,13 @@ namespace icarus::trigger {
    *
    * Operations on more than one gate can take a sequence (begin and end
    * iterators), a collection or an arbitrary number of gates.
+   * 
+   * Sequences and collections are combined in a balanced tree of pairwise
+   * operations (`AssocOpGatesSequence()`), so that each step combines gates
+   * of similar complexity: the cost is proportional to the total number of
+   * gate changes times the logarithm of the number of gates, while the plain
+   * sequential application of the operation (`OpGatesSequence()`) has a cost
+   * which grows with the square of the number of gates.
    */
   /// @{
 
@@ -369,6 +381,40 @@ namespace icarus::trigger {
   template <typename Op, typename BIter, typename EIter>
   [[nodiscard]] auto OpGatesSequence(Op op, BIter const begin, EIter const end);
   
+  /**
+   * @brief Computes the result of an associative operation on a sequence.
+   * @tparam Op type of binary operation `AGate (Op)(AGate, BGate)`
+   * @tparam BIter type of iterator to the gates to add
+   * @tparam EIter type of iterator past-the-end of the sequence of gates to add
+   * @param op the binary operation to apply (copied); must be associative
+   * @param begin iterator to the first gate to add
+   * @param end iterator past-the-last gate to add
+   * @return a new gate result of `op` on all the `gates`
+   * @see `OpGatesSequence()`, `AssocOpGateColl()`
+   * 
+   * The result is the same as `OpGatesSequence()` for an associative `op`
+   * (like all the ones in `GateOps`), but the gates are combined in pairs,
+   * then the results in pairs again, and so on (the relative order of the
+   * operands is preserved). Each gate change in the input is therefore
+   * processed about log2(_N_) times rather than up to _N_ times.
+   * 
+   * If the gates are tracking (`TrackedTriggerGate`), the tracking information
+   * of all the gates is merged once into the result, and the operations are
+   * performed on the plain gates.
+   * The returned gate has the same type as the one pointed by the begin
+   * iterator (`BIter::value_type` for standard iterators).
+   */
+  template <typename Op, typename BIter, typename EIter>
+  [[nodiscard]] auto AssocOpGatesSequence
+    (Op op, BIter const begin, EIter const end);
+  
+  /**
+   * @brief Computes the result of an associative operation on a collection.
+   * @see `AssocOpGatesSequence()`
+   */
+  template <typename Op, typename GateColl>
+  [[nodiscard]] auto AssocOpGateColl(Op op, GateColl const& gates);
+  
   // --- END ---- Gate operations: generic -------------------------------------
   
   
@@ -512,6 +558,94 @@ auto icarus::trigger::OpGatesSequence(Op op, BIter const begin, EIter const end)
 } // icarus::trigger::OpGatesSequence()
 
 
+// -----------------------------------------------------------------------------
+namespace icarus::trigger::details {
+  
+  /// Combines all `gates` with `op`, in a balanced tree; `gates` is consumed.
+  template <typename Op, typename Gate>
+  Gate reduceGatesBalanced(Op op, std::vector<Gate> gates) {
+    
+    assert(!gates.empty());
+    while (gates.size() > 1) {
+      std::size_t const nPairs = gates.size() / 2;
+      for (std::size_t iPair = 0; iPair < nPairs; ++iPair) {
+        gates[iPair]
+          = op(std::move(gates[2 * iPair]), std::as_const(gates[2 * iPair + 1]));
+      }
+      // an unpaired gate is moved on untouched to the next level
+      std::size_t nLeft = nPairs;
+      if (gates.size() % 2 == 1) gates[nLeft++] = std::move(gates.back());
+      gates.erase(gates.begin() + nLeft, gates.end());
+    } // while
+    
+    return std::move(gates.front());
+  } // reduceGatesBalanced()
+  
+  
+  /// Combines the gates in the sequence by `op`, in a balanced tree.
+  template <typename Op, typename BIter, typename EIter, typename GetGate>
+  auto reduceGateSequenceBalanced
+    (Op op, BIter const begin, EIter const end, GetGate getGate)
+  {
+    using Gate_t = std::decay_t<decltype(getGate(*begin))>;
+    
+    // the first level of the tree copies only the first gate of each pair
+    std::vector<Gate_t> partial;
+    if constexpr(std::is_same_v<BIter, EIter>)
+      partial.reserve((std::distance(begin, end) + 1) / 2);
+    for (BIter iGate = begin; iGate != end; ) {
+      Gate_t gate { getGate(*iGate) };
+      if (++iGate != end) {
+        gate = op(std::move(gate), getGate(*iGate));
+        ++iGate;
+      }
+      partial.push_back(std::move(gate));
+    } // for
+    
+    return reduceGatesBalanced(std::move(op), std::move(partial));
+  } // reduceGateSequenceBalanced()
+  
+} // namespace icarus::trigger::details
+
+
+// -----------------------------------------------------------------------------
+template <typename Op, typename BIter, typename EIter>
+auto icarus::trigger::AssocOpGatesSequence
+  (Op op, BIter const begin, EIter const end)
+{
+  
+  using Gate_t = typename std::iterator_traits<BIter>::value_type;
+  
+  // if `gates` is empty return a default-constructed gate
+  if (begin == end) return Gate_t{};
+  
+  if constexpr(isTrackedTriggerGate_v<Gate_t>) {
+    
+    Gate_t resGate { details::reduceGateSequenceBalanced(
+      std::move(op), begin, end,
+      [](auto const& gate) -> decltype(auto) { return gateIn(gate); }
+      ) };
+    
+    for (BIter iGate = begin; iGate != end; ++iGate)
+      resGate.tracking().add((*iGate).tracking());
+    return resGate;
+  }
+  else {
+    return Gate_t{ details::reduceGateSequenceBalanced(
+      std::move(op), begin, end,
+      [](auto const& gate) -> decltype(auto) { return gate; }
+      ) };
+  }
+  
+} // icarus::trigger::AssocOpGatesSequence()
+
+
+// -----------------------------------------------------------------------------
+template <typename Op, typename GateColl>
+auto icarus::trigger::AssocOpGateColl(Op op, GateColl const& gates)
+  { return AssocOpGatesSequence(std::move(op), begin(gates), end(gates)); }
+
+
 // -----------------------------------------------------------------------------
 // ---  Sum
 // -----------------------------------------------------------------------------
@@ -523,7 +657,7 @@ auto icarus::trigger::sumGates(AGate A, BGate const& B, OGates const&... others)
 // -----------------------------------------------------------------------------
 template <typename BIter, typename EIter>
 auto icarus::trigger::sumGatesSequence(BIter const begin, EIter const end)
-  { return OpGatesSequence(GateOps::Sum, begin, end); }
+  { return AssocOpGatesSequence(GateOps::Sum, begin, end); }
 
 
 // -----------------------------------------------------------------------------
@@ -543,7 +677,7 @@ auto icarus::trigger::mulGates(AGate A, BGate const& B, OGates const&... others)
 // -----------------------------------------------------------------------------
 template <typename BIter, typename EIter>
 auto icarus::trigger::mulGatesSequence(BIter const begin, EIter const end)
-  { return OpGatesSequence(GateOps::Mul, begin, end); }
+  { return AssocOpGatesSequence(GateOps::Mul, begin, end); }
 
 
 // -----------------------------------------------------------------------------
@@ -563,7 +697,7 @@ auto icarus::trigger::maxGates(AGate A, BGate const& B, OGates const&... others)
 // -----------------------------------------------------------------------------
 template <typename BIter, typename EIter>
 auto icarus::trigger::maxGatesSequence(BIter const begin, EIter const end)
-  { return OpGatesSequence(GateOps::Max, begin, end); }
+  { return AssocOpGatesSequence(GateOps::Max, begin, end); }
 
 
 // -----------------------------------------------------------------------------
@@ -583,7 +717,7 @@ auto icarus::trigger::minGates(AGate A, BGate const& B, OGates const&... others)
 // -----------------------------------------------------------------------------
 template <typename BIter, typename EIter>
 auto icarus::trigger::minGatesSequence(BIter const begin, EIter const end)
-  { return OpGatesSequence(GateOps::Min, begin, end); }
+  { return AssocOpGatesSequence(GateOps::Min, begin, end); }
 
 
 // -----------------------------------------------------------------------------
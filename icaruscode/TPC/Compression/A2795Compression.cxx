@@ -0,0 +1,352 @@
+/** ****************************************************************************
+ * @file   A2795Compression.cxx
+ * @brief  Encoder and decoder for the A2795 TPC difference-compression format.
+ * @see    A2795Compression.h
+ * ****************************************************************************/
+
+// library header
+#include "icaruscode/TPC/Compression/A2795Compression.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::copy()
+#include <arpa/inet.h> // htonl(), ntohl()
+#include <utility> // std::swap()
+
+
+namespace {
+
+  /// Throws if the codec can't handle a board with `nChannels` channels.
+  void checkChannelsPerBoard(std::size_t nChannels)
+  {
+    using namespace icarus::compression;
+    if ((nChannels > MaxChannelsPerBoard) || (nChannels % ChannelBlockSize != 0))
+    {
+      throw cet::exception("A2795Compression")
+        << "Unsupported number of channels per board: " << nChannels
+        << " (must be a multiple of " << ChannelBlockSize
+        << " not larger than " << MaxChannelsPerBoard << ")\n";
+    }
+  } // checkChannelsPerBoard()
+
+  /// Returns the mask applied to the uncompressed ADC words.
+  uint16_t adcMask(icarus::compression::MetaData const& metadata)
+    { return uint16_t(~(1U << (metadata.num_adc_bits() + 1))); }
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+bool icarus::compression::isCompressed(artdaq::Fragment const& fragment)
+{
+  return fragment.hasMetadata()
+    && (fragment.metadata<MetaData>()->compression_scheme() == DifferenceCompression);
+} // icarus::compression::isCompressed()
+
+
+//------------------------------------------------------------------------------
+std::size_t icarus::compression::compressBoardData(uint16_t const* in,
+                                                   std::size_t nChannels,
+                                                   std::size_t nSamples,
+                                                   uint16_t adcMask,
+                                                   uint16_t* out)
+{
+  checkChannelsPerBoard(nChannels);
+
+  if (nSamples == 0) return 0;
+
+  constexpr std::size_t MaxBlocks = MaxChannelsPerBoard / ChannelBlockSize;
+
+  std::array<uint16_t, MaxChannelsPerBoard> rowA;
+  std::array<uint16_t, MaxChannelsPerBoard> rowB;
+  std::array<uint16_t, MaxChannelsPerBoard> diff;
+  std::array<uint16_t, MaxBlocks>           packed;
+  std::array<uint8_t,  MaxBlocks>           isSmall;
+
+  uint16_t* prev = rowA.data();
+  uint16_t* curr = rowB.data();
+  uint16_t* word = out;
+
+  std::size_t const nBlocks = nChannels / ChannelBlockSize;
+
+  // since the 0th sample is used as a reference, store it as is
+  for (std::size_t channel = 0; channel < nChannels; ++channel)
+  {
+    prev[channel] = in[channel] & adcMask;
+    word[channel] = (prev[channel] & 0x0FFF) + UncompressedTag;
+  }
+  word += nChannels;
+
+  // from here on we store the difference between samples for each channel
+  for (std::size_t sample = 1; sample < nSamples; ++sample)
+  {
+    uint16_t const* inRow = in + sample * nChannels;
+
+    // the whole row at once: differences...
+    for (std::size_t channel = 0; channel < nChannels; ++channel)
+    {
+      curr[channel] = inRow[channel] & adcMask;
+      diff[channel] = uint16_t(curr[channel] - prev[channel]);
+    }
+
+    // ... then range check and packing of all the blocks of 4 channels
+    for (std::size_t block = 0; block < nBlocks; ++block)
+    {
+      uint16_t const* d = diff.data() + ChannelBlockSize * block;
+      // `d + 7 < 15` selects differences in [ -7, +7 ] in two's complement
+      isSmall[block] = (uint16_t(d[0] + 7) < 15) & (uint16_t(d[1] + 7) < 15)
+                     & (uint16_t(d[2] + 7) < 15) & (uint16_t(d[3] + 7) < 15);
+      packed[block] = (d[0] & 0x000F)
+                    | ((d[1] & 0x000F) << 4)
+                    | ((d[2] & 0x000F) << 8)
+                    | ((d[3] & 0x000F) << 12);
+    } // for blocks
+
+    // emission of the variable-length sample
+    std::size_t nPacked = 0;
+    for (std::size_t block = 0; block < nBlocks; ++block)
+    {
+      if (isSmall[block])
+      {
+        *(word++) = packed[block];
+        ++nPacked;
+        continue;
+      }
+      uint16_t const* d = diff.data() + ChannelBlockSize * block;
+      for (std::size_t cInSet = 0; cInSet < ChannelBlockSize; ++cInSet)
+        *(word++) = (d[cInSet] & 0x0FFF) + UncompressedTag;
+    } // for blocks
+
+    // if there are an odd number of words in the difference then there needs to be a spacer added
+    if (nPacked % 2) *(word++) = 0;
+
+    std::swap(prev, curr);
+  } // for samples
+
+  return word - out;
+} // icarus::compression::compressBoardData()
+
+
+//------------------------------------------------------------------------------
+std::size_t icarus::compression::decompressBoardData(uint16_t const* in,
+                                                     std::size_t nChannels,
+                                                     std::size_t nSamples,
+                                                     uint16_t* out)
+{
+  checkChannelsPerBoard(nChannels);
+
+  return decodeBoardData(in, nChannels, nSamples,
+    [out, nChannels](std::size_t sample, uint16_t const* adcs)
+      { std::copy(adcs, adcs + nChannels, out + sample * nChannels); }
+    );
+} // icarus::compression::decompressBoardData()
+
+
+//------------------------------------------------------------------------------
+std::size_t icarus::compression::compressedBoardDataWords(uint16_t const* in,
+                                                          std::size_t nChannels,
+                                                          std::size_t nSamples)
+{
+  checkChannelsPerBoard(nChannels);
+
+  if (nSamples == 0) return 0;
+
+  std::size_t const nBlocks = nChannels / ChannelBlockSize;
+
+  uint16_t const* word = in + nChannels;
+  for (std::size_t sample = 1; sample < nSamples; ++sample)
+  {
+    std::size_t nPacked = 0;
+    for (std::size_t block = 0; block < nBlocks; ++block)
+    {
+      bool const packedBlock = (*word & 0xF000) != UncompressedTag;
+      word += packedBlock? 1: ChannelBlockSize;
+      nPacked += packedBlock;
+    }
+    word += nPacked % 2;
+  } // for samples
+
+  return word - in;
+} // icarus::compression::compressedBoardDataWords()
+
+
+//------------------------------------------------------------------------------
+std::vector<std::size_t> icarus::compression::boardOffsets
+  (artdaq::Fragment const& fragment)
+{
+  MetaData const& metadata = *(fragment.metadata<MetaData>());
+
+  std::size_t const nBoards = metadata.num_boards();
+  std::size_t const payloadWords = fragment.dataSizeBytes() / sizeof(uint16_t);
+  uint16_t const* payload
+    = reinterpret_cast<uint16_t const*>(fragment.dataBeginBytes());
+
+  std::vector<std::size_t> offsets;
+  offsets.reserve(nBoards);
+
+  std::size_t offset = 0;
+  for (std::size_t board = 0; board < nBoards; ++board)
+  {
+    if (offset + BoardHeaderWords > payloadWords)
+    {
+      throw cet::exception("A2795Compression")
+        << "Board " << board << " of fragment " << fragment.fragmentID()
+        << " starts beyond the end of the payload (word " << offset << " of "
+        << payloadWords << ")\n";
+    }
+    offsets.push_back(offset);
+
+    TileHeader const* header = reinterpret_cast<TileHeader const*>(payload + offset);
+    offset += ntohl(header->packSize) / sizeof(uint16_t);
+  } // for boards
+
+  return offsets;
+} // icarus::compression::boardOffsets()
+
+
+//------------------------------------------------------------------------------
+icarus::compression::FragmentBoardDecoder::FragmentBoardDecoder
+  (artdaq::Fragment const& fragment)
+  : fPayload{ reinterpret_cast<uint16_t const*>(fragment.dataBeginBytes()) }
+  , fCompressed{ isCompressed(fragment) }
+{
+  MetaData const& metadata = *(fragment.metadata<MetaData>());
+
+  fNChannels = metadata.channels_per_board();
+  fNSamples  = metadata.samples_per_channel();
+  fADCmask   = adcMask(metadata);
+
+  checkChannelsPerBoard(fNChannels);
+
+  if (fCompressed)
+  {
+    fBoardOffsets = boardOffsets(fragment);
+  }
+  else
+  {
+    std::size_t const boardWords
+      = BoardHeaderWords + fNChannels * fNSamples + BoardTrailerWords;
+    fBoardOffsets.resize(metadata.num_boards());
+    for (std::size_t board = 0; board < fBoardOffsets.size(); ++board)
+      fBoardOffsets[board] = board * boardWords;
+  }
+} // icarus::compression::FragmentBoardDecoder::FragmentBoardDecoder()
+
+
+//------------------------------------------------------------------------------
+artdaq::Fragment icarus::compression::compressFragment
+  (artdaq::Fragment const& fragment)
+{
+  MetaData const& metadata = *(fragment.metadata<MetaData>());
+
+  std::size_t const nBoards   = metadata.num_boards();
+  std::size_t const nChannels = metadata.channels_per_board();
+  std::size_t const nSamples  = metadata.samples_per_channel();
+  uint16_t const mask = adcMask(metadata);
+
+  std::size_t const boardDataWords = nChannels * nSamples;
+  std::size_t const boardWords
+    = BoardHeaderWords + boardDataWords + BoardTrailerWords;
+
+  // the compressed data is never larger than the uncompressed one,
+  // so the copy of the fragment has room enough for it
+  artdaq::Fragment compressed(fragment);
+
+  uint16_t const* in
+    = reinterpret_cast<uint16_t const*>(fragment.dataBeginBytes());
+  uint16_t* out = reinterpret_cast<uint16_t*>(compressed.dataBeginBytes());
+
+  std::size_t outWords = 0;
+  for (std::size_t board = 0; board < nBoards; ++board)
+  {
+    uint16_t const* boardIn = in + board * boardWords;
+    uint16_t* boardOut = out + outWords;
+
+    // each board has a header...
+    std::copy(boardIn, boardIn + BoardHeaderWords, boardOut);
+
+    std::size_t const dataWords = compressBoardData(
+      boardIn + BoardHeaderWords, nChannels, nSamples, mask,
+      boardOut + BoardHeaderWords
+      );
+
+    // ...and each board has a trailer
+    uint16_t const* trailerIn = boardIn + BoardHeaderWords + boardDataWords;
+    std::copy(trailerIn, trailerIn + BoardTrailerWords,
+      boardOut + BoardHeaderWords + dataWords);
+
+    std::size_t const boardOutWords
+      = BoardHeaderWords + dataWords + BoardTrailerWords;
+
+    // now that we know the size for the data tile, store that in the tile header
+    // endianness is weird for this, hence the htonl...
+    reinterpret_cast<TileHeader*>(boardOut)->packSize
+      = htonl(boardOutWords * sizeof(uint16_t));
+
+    outWords += boardOutWords;
+  } // for boards
+
+  // resize the fragment down to the compressed size
+  compressed.resizeBytes(outWords * sizeof(uint16_t));
+
+  // updated the metadata to reflect the compression
+  compressed.metadata<MetaData>()->SetCompressionScheme(DifferenceCompression);
+
+  return compressed;
+} // icarus::compression::compressFragment()
+
+
+//------------------------------------------------------------------------------
+artdaq::Fragment icarus::compression::decompressFragment
+  (artdaq::Fragment const& fragment)
+{
+  if (!isCompressed(fragment)) return fragment;
+
+  MetaData const& metadata = *(fragment.metadata<MetaData>());
+
+  std::size_t const nBoards   = metadata.num_boards();
+  std::size_t const nChannels = metadata.channels_per_board();
+  std::size_t const nSamples  = metadata.samples_per_channel();
+
+  std::size_t const boardDataWords = nChannels * nSamples;
+  std::size_t const boardWords
+    = BoardHeaderWords + boardDataWords + BoardTrailerWords;
+
+  std::vector<std::size_t> const offsets = boardOffsets(fragment);
+
+  artdaq::Fragment uncompressed(fragment);
+  uncompressed.resizeBytes(nBoards * boardWords * sizeof(uint16_t));
+
+  uint16_t const* in
+    = reinterpret_cast<uint16_t const*>(fragment.dataBeginBytes());
+  uint16_t* out = reinterpret_cast<uint16_t*>(uncompressed.dataBeginBytes());
+
+  for (std::size_t board = 0; board < nBoards; ++board)
+  {
+    uint16_t const* boardIn = in + offsets[board];
+    uint16_t* boardOut = out + board * boardWords;
+
+    std::copy(boardIn, boardIn + BoardHeaderWords, boardOut);
+
+    std::size_t const dataWords = decompressBoardData(
+      boardIn + BoardHeaderWords, nChannels, nSamples,
+      boardOut + BoardHeaderWords
+      );
+
+    uint16_t const* trailerIn = boardIn + BoardHeaderWords + dataWords;
+    std::copy(trailerIn, trailerIn + BoardTrailerWords,
+      boardOut + BoardHeaderWords + boardDataWords);
+
+    reinterpret_cast<TileHeader*>(boardOut)->packSize
+      = htonl(boardWords * sizeof(uint16_t));
+  } // for boards
+
+  uncompressed.metadata<MetaData>()->SetCompressionScheme(NoCompression);
+
+  return uncompressed;
+} // icarus::compression::decompressFragment()
+
+
+//------------------------------------------------------------------------------
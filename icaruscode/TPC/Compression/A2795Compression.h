@@ -0,0 +1,368 @@
+/** ****************************************************************************
+ * @file   A2795Compression.h
+ * @brief  Encoder and decoder for the A2795 TPC difference-compression format.
+ * @see    A2795Compression.cxx ICARUSProduceCompressed_module.cc
+ *
+ * The compressed format (compression scheme `1`) stores, for each board:
+ *
+ *  * the 18 16-bit words of the board header (data tile header plus A2795
+ *    header), with the `packSize` of the tile header updated to the size of
+ *    the compressed board;
+ *  * the first sample of every channel, as a 12-bit value tagged with `0x8`
+ *    in the top nibble;
+ *  * for each following sample, the difference with the previous one,
+ *    in blocks of 4 channels: if all 4 differences are in [ -7, +7 ] they are
+ *    packed as 4-bit values in a single untagged word, otherwise they are
+ *    stored as 4 tagged 12-bit words; when the number of packed blocks in a
+ *    sample is odd, a padding word is added to keep 32-bit alignment;
+ *  * the 4 words of the board trailer.
+ *
+ * The encoder and decoder here work one sample (a row of all the channels of
+ * a board) at a time on fixed-size arrays, so that the difference, range check,
+ * nibble packing and accumulation loops are vectorized by the compiler.
+ * ****************************************************************************/
+
+#ifndef ICARUSCODE_TPC_COMPRESSION_A2795COMPRESSION_H
+#define ICARUSCODE_TPC_COMPRESSION_A2795COMPRESSION_H
+
+// artdaq libraries
+#include "artdaq-core/Data/Fragment.hh"
+
+// C/C++ standard libraries
+#include <array>
+#include <cstddef> // std::size_t
+#include <cstdint>
+#include <utility> // std::forward()
+#include <vector>
+
+
+namespace icarus::compression {
+
+  // ---------------------------------------------------------------------------
+  /// Data tile header of a board, as stored in the fragment.
+  struct TileHeader
+  {
+    uint32_t token;
+    uint32_t info1;
+    uint32_t info2;
+    uint32_t info3;
+    uint32_t timeinfo;
+    uint32_t pkt_fmt_ver  : 8;
+    uint32_t crate_id     : 8;
+    uint32_t board_id     : 8;
+    uint32_t board_status : 8;
+    uint32_t packSize;
+
+    TileHeader(){};
+  }; // end of TileHeader struct
+
+  /// Fragment metadata layout including the compression scheme.
+  class MetaData
+  {
+    public:
+      MetaData(){}
+      MetaData(uint32_t run_number,
+               uint32_t n_boards,
+               uint32_t channels_per_board,
+               uint32_t samples_per_channel,
+               uint32_t adcs_per_sample,
+               uint32_t compression,
+               std::vector<uint32_t> const& idvec)
+      {
+        _run_number = run_number;
+        _num_boards = n_boards;
+        _channels_per_board = channels_per_board;
+        _samples_per_channel = samples_per_channel;
+        _num_adc_bits = adcs_per_sample;
+        _compression_scheme = compression;
+        SetBoardIDs(idvec);
+      }
+
+      uint32_t const& run_number() const { return _run_number; }
+      uint32_t const& samples_per_channel() const { return _samples_per_channel; }
+      uint32_t const& num_adc_bits() const { return _num_adc_bits; }
+      uint32_t const& channels_per_board() const { return _channels_per_board; }
+      uint32_t const& num_boards() const { return _num_boards; }
+      uint32_t const& compression_scheme() const { return _compression_scheme; }
+      uint32_t const& board_id(size_t i) const { return _board_ids[i]; }
+
+      void SetBoardID(size_t i,uint32_t id) { _board_ids[i] = id; }
+      void SetBoardIDs(std::vector<uint32_t> const& idvec) {_board_ids = idvec; }
+      void SetCompressionScheme(uint32_t scheme) { _compression_scheme = scheme; }
+
+    private:
+      uint32_t _run_number;
+      uint32_t _samples_per_channel;
+      uint32_t _num_adc_bits;
+      uint32_t _channels_per_board;
+      uint32_t _num_boards;
+      uint32_t _compression_scheme;
+      std::vector<uint32_t> _board_ids;
+  }; // end MetaData class
+
+
+  // ---------------------------------------------------------------------------
+  /// Compression scheme value for uncompressed fragments.
+  constexpr uint32_t NoCompression = 0;
+
+  /// Compression scheme value for the 4-channel-block difference format.
+  constexpr uint32_t DifferenceCompression = 1;
+
+  /// Number of 16-bit words in a board header (tile header + A2795 header).
+  constexpr std::size_t BoardHeaderWords = (28 + 8) / sizeof(uint16_t);
+
+  /// Number of 16-bit words in a board trailer.
+  constexpr std::size_t BoardTrailerWords = 4;
+
+  /// Number of channels sharing a compression flag.
+  constexpr std::size_t ChannelBlockSize = 4;
+
+  /// Largest number of channels per board supported by the codec.
+  constexpr std::size_t MaxChannelsPerBoard = 64;
+
+  /// Tag of the uncompressed (12-bit) words in the top nibble.
+  constexpr uint16_t UncompressedTag = 0x8000;
+
+
+  // ---------------------------------------------------------------------------
+  /// Returns whether the fragment metadata declares the difference compression.
+  bool isCompressed(artdaq::Fragment const& fragment);
+
+  /**
+   * @brief Compresses the samples of one board.
+   * @param in pointer to the first sample of the board (sample-major)
+   * @param nChannels number of channels in the board
+   * @param nSamples number of samples per channel
+   * @param adcMask mask applied to each input ADC word
+   * @param out pointer to the output buffer
+   * @return the number of 16-bit words written into `out`
+   *
+   * Only the sample block is processed (no header nor trailer).
+   * The output buffer must have room for `nChannels * nSamples` words, which is
+   * the largest possible size of the compressed data; it must not overlap the
+   * input.
+   */
+  std::size_t compressBoardData(uint16_t const* in,
+                                std::size_t nChannels,
+                                std::size_t nSamples,
+                                uint16_t adcMask,
+                                uint16_t* out);
+
+  /**
+   * @brief Decodes the compressed samples of one board.
+   * @tparam StoreRow callable as `store(std::size_t sample, uint16_t const* adcs)`
+   * @param in pointer to the first compressed word of the board sample block
+   * @param nChannels number of channels in the board
+   * @param nSamples number of samples per channel
+   * @param store callable receiving each decoded sample row
+   * @return the number of 16-bit words read from `in`
+   *
+   * The callable is invoked once per sample, in order, with a pointer to the
+   * `nChannels` decoded ADC values of that sample; the pointed data is only
+   * valid during the call.
+   */
+  template <typename StoreRow>
+  std::size_t decodeBoardData(uint16_t const* in,
+                              std::size_t nChannels,
+                              std::size_t nSamples,
+                              StoreRow&& store);
+
+  /**
+   * @brief Decodes the compressed samples of one board into a buffer.
+   * @param in pointer to the first compressed word of the board sample block
+   * @param nChannels number of channels in the board
+   * @param nSamples number of samples per channel
+   * @param out buffer of `nChannels * nSamples` words, filled sample-major
+   * @return the number of 16-bit words read from `in`
+   *
+   * The output layout is the same as the uncompressed board data.
+   */
+  std::size_t decompressBoardData(uint16_t const* in,
+                                  std::size_t nChannels,
+                                  std::size_t nSamples,
+                                  uint16_t* out);
+
+  /**
+   * @brief Returns the size of the compressed samples of one board.
+   * @param in pointer to the first compressed word of the board sample block
+   * @param nChannels number of channels in the board
+   * @param nSamples number of samples per channel
+   * @return the number of 16-bit words in the compressed sample block
+   *
+   * Only the compression flags are inspected, no sample is decoded.
+   */
+  std::size_t compressedBoardDataWords(uint16_t const* in,
+                                       std::size_t nChannels,
+                                       std::size_t nSamples);
+
+  /**
+   * @brief Returns the offset of each board in a compressed fragment payload.
+   * @param fragment the compressed fragment
+   * @return the offset of each board header, in 16-bit words
+   *
+   * The offsets are obtained by walking the `packSize` of the tile headers.
+   */
+  std::vector<std::size_t> boardOffsets(artdaq::Fragment const& fragment);
+
+  /// Returns a copy of `fragment` compressed with the difference scheme.
+  artdaq::Fragment compressFragment(artdaq::Fragment const& fragment);
+
+  /// Returns an uncompressed copy of a difference-compressed `fragment`.
+  artdaq::Fragment decompressFragment(artdaq::Fragment const& fragment);
+
+
+  // ---------------------------------------------------------------------------
+  /**
+   * @brief Access to the board samples of a fragment, compressed or not.
+   *
+   * The decoder locates the boards of the fragment once at construction, and
+   * then delivers the samples of each board one row (sample) at a time,
+   * decoding them on the fly if the fragment is compressed:
+   * @code{.cpp}
+   * icarus::compression::FragmentBoardDecoder const decoder(fragment);
+   * for (std::size_t board = 0; board < decoder.nBoards(); ++board) {
+   *   decoder.decodeBoard(board,
+   *     [&waveforms](std::size_t tick, uint16_t const* adcs)
+   *       {
+   *         for (std::size_t channel = 0; channel < 64; ++channel)
+   *           waveforms[channel][tick] = -adcs[channel];
+   *       }
+   *     );
+   * }
+   * @endcode
+   * No copy of the fragment payload is made.
+   */
+  class FragmentBoardDecoder
+  {
+    public:
+      /// Prepares the decoding of `fragment`, which must outlive the decoder.
+      explicit FragmentBoardDecoder(artdaq::Fragment const& fragment);
+
+      /// Returns whether the fragment is compressed.
+      bool compressed() const { return fCompressed; }
+
+      std::size_t nBoards() const { return fBoardOffsets.size(); }
+      std::size_t nChannelsPerBoard() const { return fNChannels; }
+      std::size_t nSamplesPerChannel() const { return fNSamples; }
+
+      /// Returns a pointer to the header of the specified board.
+      uint16_t const* boardHeader(std::size_t board) const
+        { return fPayload + fBoardOffsets[board]; }
+
+      /**
+       * @brief Delivers all the samples of the specified board.
+       * @tparam StoreRow callable as `store(std::size_t sample, uint16_t const* adcs)`
+       * @param board index of the board in the fragment
+       * @param store callable receiving each sample row
+       * @see decodeBoardData()
+       *
+       * The ADC values have the same masking as `PhysCrateFragment::adc_val()`.
+       */
+      template <typename StoreRow>
+      void decodeBoard(std::size_t board, StoreRow&& store) const;
+
+    private:
+      uint16_t const* fPayload = nullptr;      ///< Start of fragment payload.
+      bool fCompressed = false;                ///< Whether the data is compressed.
+      std::size_t fNChannels = 0;              ///< Channels per board.
+      std::size_t fNSamples = 0;               ///< Samples per channel.
+      uint16_t fADCmask = 0xFFFF;              ///< Mask for uncompressed samples.
+      std::vector<std::size_t> fBoardOffsets;  ///< Board offsets [words]
+  }; // class FragmentBoardDecoder
+
+} // namespace icarus::compression
+
+
+//------------------------------------------------------------------------------
+//--- template implementation
+//------------------------------------------------------------------------------
+template <typename StoreRow>
+std::size_t icarus::compression::decodeBoardData(uint16_t const* in,
+                                                 std::size_t nChannels,
+                                                 std::size_t nSamples,
+                                                 StoreRow&& store)
+{
+  std::array<uint16_t, MaxChannelsPerBoard> row;
+  std::array<uint16_t, MaxChannelsPerBoard> diff;
+
+  uint16_t const* word = in;
+
+  if (nSamples == 0) return 0;
+
+  // the first sample is stored as is
+  for (std::size_t channel = 0; channel < nChannels; ++channel)
+    row[channel] = word[channel] & 0x0FFF;
+  word += nChannels;
+  store(std::size_t(0), row.data());
+
+  std::size_t const nBlocks = nChannels / ChannelBlockSize;
+
+  for (std::size_t sample = 1; sample < nSamples; ++sample)
+  {
+    std::size_t nPacked = 0;
+    for (std::size_t block = 0; block < nBlocks; ++block)
+    {
+      uint16_t* blockDiff = diff.data() + ChannelBlockSize * block;
+      if ((word[0] & 0xF000) == UncompressedTag)
+      {
+        // four sign-extended 12-bit differences
+        for (std::size_t cInSet = 0; cInSet < ChannelBlockSize; ++cInSet)
+        {
+          uint16_t const twelveBitDiff = word[cInSet] & 0x0FFF;
+          blockDiff[cInSet] = twelveBitDiff | (-(twelveBitDiff >> 11) & 0xF000);
+        }
+        word += ChannelBlockSize;
+      }
+      else
+      {
+        // four sign-extended 4-bit differences packed in one word
+        for (std::size_t cInSet = 0; cInSet < ChannelBlockSize; ++cInSet)
+        {
+          uint16_t const fourBitDiff = (word[0] >> (4 * cInSet)) & 0x000F;
+          blockDiff[cInSet] = fourBitDiff | (-(fourBitDiff >> 3) & 0xFFF0);
+        }
+        ++word;
+        ++nPacked;
+      }
+    } // for blocks
+
+    // an odd number of packed blocks is followed by a spacer
+    word += nPacked % 2;
+
+    for (std::size_t channel = 0; channel < nChannels; ++channel)
+      row[channel] = uint16_t(row[channel] + diff[channel]);
+
+    store(sample, row.data());
+  } // for samples
+
+  return word - in;
+} // icarus::compression::decodeBoardData()
+
+
+//------------------------------------------------------------------------------
+template <typename StoreRow>
+void icarus::compression::FragmentBoardDecoder::decodeBoard
+  (std::size_t board, StoreRow&& store) const
+{
+  uint16_t const* data = boardHeader(board) + BoardHeaderWords;
+
+  if (fCompressed)
+  {
+    decodeBoardData(data, fNChannels, fNSamples, std::forward<StoreRow>(store));
+    return;
+  }
+
+  std::array<uint16_t, MaxChannelsPerBoard> row;
+  for (std::size_t sample = 0; sample < fNSamples; ++sample)
+  {
+    uint16_t const* inRow = data + sample * fNChannels;
+    for (std::size_t channel = 0; channel < fNChannels; ++channel)
+      row[channel] = inRow[channel] & fADCmask;
+    store(sample, row.data());
+  }
+} // icarus::compression::FragmentBoardDecoder::decodeBoard()
+
+
+//------------------------------------------------------------------------------
+
+#endif // ICARUSCODE_TPC_COMPRESSION_A2795COMPRESSION_H
@@ -20,6 +20,7 @@
 
 //icarus includes
 #include "icaruscode/Decode/ChannelMapping/IICARUSChannelMap.h"
+#include "icaruscode/TPC/Compression/A2795Compression.h"
 
 //sbndaq includes
 #include "sbndaq-artdaq-core/Overlays/ICARUS/PhysCrateFragment.cc"
@@ -82,121 +83,64 @@ namespace tcpCompression {
       icarus::PhysCrateFragment fragOverlay(frag);
       std::string fragCrateName = fChannelMap->getCrateName(frag.fragmentID());
 
-      if (true)
+      // walk the boards with the shared decoder; the board sizes found by the
+      // decoder must match both the tile headers and the fragment size
+      MF_LOG_VERBATIM("ValidateCompression")
+        << "****************************" << '\n'
+        << "Crate " << fragCrateName;
+
+      if (!icarus::compression::isCompressed(frag))
       {
-        // iterate through the fragment which wasn't compressed and check which boards are or aren't working
         MF_LOG_VERBATIM("ValidateCompression")
-          << "****************************" << '\n'
-          << "Crate " << fragCrateName;
-        size_t cumulativePrevBlockSize = 0;
-        icarus::A2795DataBlock::data_t const* boardData = new icarus::A2795DataBlock::data_t[frag.dataSize()];
-        for (size_t board = 0; board < fragOverlay.nBoards(); ++board)
+          << "  Fragment is UNCOMPRESSED";
+        fDcmpHist->Fill(frag.dataSizeBytes());
+        ++fragNumber;
+        continue;
+      }
+
+      size_t const nChannels = fragOverlay.nChannelsPerBoard();
+      size_t const nSamples  = fragOverlay.nSamplesPerChannel();
+
+      uint16_t const* payload = reinterpret_cast<uint16_t const*>(frag.dataBeginBytes());
+      std::vector<size_t> const offsets = icarus::compression::boardOffsets(frag);
+      std::vector<uint16_t> adcs(nChannels*nSamples);
+
+      size_t totalWords = 0;
+      for (size_t board = 0; board < offsets.size(); ++board)
+      {
+        uint16_t const* boardData = payload + offsets[board] + icarus::compression::BoardHeaderWords;
+
+        size_t const dataWords = icarus::compression::decompressBoardData(boardData, nChannels, nSamples, adcs.data());
+        size_t const boardWords = icarus::compression::BoardHeaderWords + dataWords + icarus::compression::BoardTrailerWords;
+
+        size_t const nextOffset = (board + 1 < offsets.size()) ? offsets[board + 1] : frag.dataSizeBytes()/sizeof(uint16_t);
+        std::string boardCompStr = (offsets[board] + boardWords == nextOffset) ? " is compressed" : " is UNCOMPRESSED or CORRUPTED";
+        MF_LOG_VERBATIM("ValidateCompression")
+          << "  Board " << board << boardCompStr;
+
+        if (fDumpADCs)
         {
-          bool boardCompressed = true;
-          size_t word = 0;
-          boardData = reinterpret_cast<icarus::A2795DataBlock::data_t const*>
-                      ( frag.dataBeginBytes()
-                      + (1+board)*sizeof(icarus::PhysCrateDataTileHeader)
-                      + (1+board)*sizeof(icarus::A2795DataBlock::Header)
-                      + 4*board*sizeof(uint16_t)
-                      + cumulativePrevBlockSize                     );
-
-          for (size_t sample = 0; sample < fragOverlay.nSamplesPerChannel(); ++sample)
+          for (size_t channel = 0; channel < nChannels; ++channel)
           {
-            bool oddCompressions = false;
-            std::vector<icarus::A2795DataBlock::data_t> prevSample(fragOverlay.nChannelsPerBoard(), 0);
-            for (size_t cSet = 0; cSet < fragOverlay.nChannelsPerBoard() / 4; ++cSet)
-            {
-              // get word
-              icarus::A2795DataBlock::data_t dataWord = boardData[word];
-              
-              // check if the word is interpretable as a compressed set of 4 ADC differences
-              bool wordNotTagged = ((dataWord & 0xF000) != 0x8000);
-              if (not wordNotTagged)
-              {
-                // if the word is tagged, then it's not compressed, but should exist in a compressed fragment
-                // check the next three words are also tagged, if they are then we are good (might need to check the delta sizes)
-                // otherwise something has gone wrong
-                bool wordTagged_plus1 = (boardData[word + 1] & 0xF000) == 0x8000;
-                bool wordTagged_plus2 = (boardData[word + 2] & 0xF000) == 0x8000;
-                bool wordTagged_plus3 = (boardData[word + 3] & 0xF000) == 0x8000;
-                if (wordTagged_plus1 && wordTagged_plus2 && wordTagged_plus3)
-                {
-                  if (not boardCompressed)
-                  {
-                    MF_LOG_VERBATIM("ValidateCompression")
-                      << "SOMEHOW FOUND COMPRESSED SEQUENCE IN UNCOMPRESSED BOARD";
-                  }
-                  // it's good
-                  word += 4;
-                  cumulativePrevBlockSize += 8;
-                  for (size_t cInSet = 0; cInSet < 4; ++cInSet)
-                  {
-                    icarus::A2795DataBlock::data_t twelveBitDiff = (boardData[word + 1] & 0x0FFF);
-                    bool isNeg = (sample != 0) && (twelveBitDiff >> 11);
-                    prevSample[4*cSet + cInSet] += isNeg*0xF000 + twelveBitDiff;
-                  }
-                } else {
-                  // something has gone wrong
-                  MF_LOG_VERBATIM("ValidateCompression")
-                    << "TAGGED BUT NOT FROM COMPRESSED FRAGMENT";
-                  boardCompressed = false;
-                  word += 4;
-                  cumulativePrevBlockSize += 8;
-                  for (size_t cInSet = 0; cInSet < 4; ++cInSet)
-                  {
-                    prevSample[4*cSet + cInSet] = (boardData[word + cInSet] & (~(1<<(fragOverlay.metadata()->num_adc_bits()+1))));
-                  }
-                }
-              } else {
-                if (sample == 0)
-                {
-                  boardCompressed = false;
-                }
-                if (boardCompressed)
-                {
-                  oddCompressions = (not oddCompressions);
-                  // if we don't have the tag check if it makes more sense as one value or 4 differences
-                  // first try adding to previous samples and see if the results are reasonable
-                  for (size_t cInSet = 0; cInSet < 4; ++cInSet)
-                  {
-                    icarus::A2795DataBlock::data_t fourBitDiff = (dataWord >> (4*cInSet)) & 0x000F;
-                    bool isNeg = (fourBitDiff >> 3);
-                    prevSample[4*cSet + cInSet] += (isNeg*0xFFF0 + fourBitDiff);
-                  }
-                  ++word;
-                  cumulativePrevBlockSize += 2;
-                } else {
-                  word += 4;
-                  cumulativePrevBlockSize += 8;
-                  for (size_t cInSet = 0; cInSet < 4; ++cInSet)
-                  {
-                    prevSample[4*cSet + cInSet] = (boardData[word + cInSet] & (~(1<<(fragOverlay.metadata()->num_adc_bits()+1))));
-                  }
-                }
-              }
-            }
-            if (oddCompressions)
-            {
-              ++word;
-              cumulativePrevBlockSize += 2;
-            }
+            mf::LogVerbatim log("ValidateCompression");
+            log << "    channel " << channel << ":";
+            for (size_t sample = 0; sample < nSamples; ++sample)
+              log << " " << adcs[sample*nChannels + channel];
           }
-          std::string boardCompStr = (boardCompressed) ? " is compressed" : " is UNCOMPRESSED";
-          MF_LOG_VERBATIM("ValidateCompression")
-            << "  Board " << board << boardCompStr;
         }
-        uint32_t totalBytes = fragOverlay.nBoards()*sizeof(icarus::PhysCrateDataTileHeader)
-                            + fragOverlay.nBoards()*sizeof(icarus::A2795DataBlock::Header)
-                            + 4*fragOverlay.nBoards()*sizeof(uint16_t)
-                            + cumulativePrevBlockSize;
-        MF_LOG_DEBUG("ValidateCompression")
-          << "****************************" << '\n'
-          << "Crate " << fragCrateName << '\n'
-          << "  Estimated data bytes " << totalBytes << '\n'
-          << "  should be            " << frag.dataSizeBytes() << '\n'
-          << "****************************";
+
+        totalWords += boardWords;
       }
+      uint32_t totalBytes = totalWords*sizeof(uint16_t);
+      MF_LOG_DEBUG("ValidateCompression")
+        << "****************************" << '\n'
+        << "Crate " << fragCrateName << '\n'
+        << "  Estimated data bytes " << totalBytes << '\n'
+        << "  should be            " << frag.dataSizeBytes() << '\n'
+        << "****************************";
+
+      fCompHist->Fill(frag.dataSizeBytes());
+      fDcmpHist->Fill(offsets.size()*(icarus::compression::BoardHeaderWords + nChannels*nSamples + icarus::compression::BoardTrailerWords)*sizeof(uint16_t));
 
       ++fragNumber;
     }
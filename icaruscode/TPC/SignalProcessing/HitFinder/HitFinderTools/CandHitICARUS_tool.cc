@@ -12,8 +12,13 @@
 #include "larcore/Geometry/Geometry.h"
 #include "larcore/CoreUtils/ServiceUtil.h" // lar::providerFrom()
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <fstream>
+#include <limits>
+#include <vector>
 
 namespace reco_tool
 {
@@ -35,6 +40,23 @@ public:
 
 private:
 
+    /// Hit finding parameters for one plane.
+    struct PlaneParams_t
+    {
+        double       threshold = 0.; //< Threshold on the signal
+        int          above     = 0;  //< Minimal number of ticks on falling/rising edges
+        int          fall      = 0;  //< Minimal number of ticks from peak to end of hit
+        unsigned int width     = 0;  //< Minimal width of the hit [ticks]
+    };
+
+    /// Plane number for channels which are not mapped to any plane.
+    static constexpr geo::PlaneID::PlaneID_t NoPlane = std::numeric_limits<std::uint8_t>::max();
+
+    /// Finds the hit candidates in `waveform` with the parameters of a plane.
+    static void findPlaneHitCandidates(const Waveform&      waveform,
+                                       const PlaneParams_t& params,
+                                       HitCandidateVec&     hits);
+
     void findHitCandidates(std::vector<float>::const_iterator,
                            std::vector<float>::const_iterator,
                            size_t,
@@ -44,21 +66,8 @@ private:
     void expandHit(HitCandidate& h, std::vector<float> holder, HitCandidateVec how);
     void prova() {return ;}
 
-    int          fInd1Width;            //INITIAL WIDTH FOR INDUCTION HITFINDING.
-    int              fInd2Width;            //INITIAL WIDTH FOR INDUCTION HITFINDING.
-    int              fColWidth;            //INITIAL WIDTH FOR COLLECTION HITFINDING.
-    unsigned int              fInd1Window;            //INITIAL WINDOW FOR INDUCTION HITFINDING.
-    unsigned int              fInd2Window;            //INITIAL WINDOW FOR INDUCTION HITFINDING.
-    unsigned int              fColWindow;            //INITIAL WINDOW FOR COLLECTION HITFINDING.
-    int              fInd1Threshold;            //THRESHOLD FOR INDUCTION HITFINDING.
-    int              fInd2Threshold;            //THRESHOLD FOR INDUCTION HITFINDING.
-    int              fColThreshold;            //THRESHOLD FOR COLLECTION HITFINDING.
-    int              fInd1Above;            //MINIMAL NUMBER OF TICKS ABOVE THRESHOLD FOR INDUCTION HITFINDING.
-    int              fInd2Above;
-    int              fColAbove;
-    int              fInd1Fall;
-    int              fInd2Fall;
-    int              fColFall;
+    std::array<PlaneParams_t, 3> fPlaneParams;     //< Parameters for induction 1, induction 2 and collection
+    std::vector<std::uint8_t>    fChannelPlanes;   //< Plane of each channel (`NoPlane` if none)
     float                fMinHitHeight;         //< Drop candidate hits with height less than this
     size_t               fNumInterveningTicks;  //< Number ticks between candidate hits to merge
 
@@ -70,25 +79,32 @@ private:
 CandHitICARUS::CandHitICARUS(const fhicl::ParameterSet& pset)
 {
     // Start by recovering the parameters
-
-    fInd1Width = pset.get< int  >("Ind1Width");
-    fInd2Width = pset.get< int  >("Ind2Width");
-    fColWidth = pset.get< int  >("ColWidth");
-    fInd1Window = pset.get< unsigned int  >("Ind1Window");
-    fInd2Window = pset.get< unsigned int  >("Ind2Window");
-    fColWindow = pset.get< unsigned int  >("ColWindow");
-    fInd1Threshold = pset.get< int  >("Ind1Threshold");
-    fInd2Threshold = pset.get< int  >("Ind2Threshold");
-    fColThreshold = pset.get< int  >("ColThreshold");
-    fInd1Above = pset.get< int  >("Ind1Above");
-    fInd2Above = pset.get< int  >("Ind2Above");
-    fColAbove = pset.get< int  >("ColAbove");
-    fInd1Fall = pset.get< int  >("Ind1Fall");
-    fInd2Fall = pset.get< int  >("Ind2Fall");
-    fColFall = pset.get< int  >("ColFall");
+    // (the "*Window" parameters of the running mean are not used anymore)
+    fPlaneParams[0].threshold = pset.get< int  >("Ind1Threshold");
+    fPlaneParams[1].threshold = pset.get< int  >("Ind2Threshold");
+    fPlaneParams[2].threshold = pset.get< int  >("ColThreshold");
+    fPlaneParams[0].above     = pset.get< int  >("Ind1Above");
+    fPlaneParams[1].above     = pset.get< int  >("Ind2Above");
+    fPlaneParams[2].above     = pset.get< int  >("ColAbove");
+    fPlaneParams[0].fall      = pset.get< int  >("Ind1Fall");
+    fPlaneParams[1].fall      = pset.get< int  >("Ind2Fall");
+    fPlaneParams[2].fall      = pset.get< int  >("ColFall");
+    fPlaneParams[0].width     = pset.get< int  >("Ind1Width");
+    fPlaneParams[1].width     = pset.get< int  >("Ind2Width");
+    fPlaneParams[2].width     = pset.get< int  >("ColWidth");
     fMinHitHeight        = pset.get< float  >("MinHitHeight",        1.0);
     fNumInterveningTicks = pset.get< size_t >("NumInterveningTicks", 6);
 
+    // Cache the plane of each channel, to avoid querying the geometry
+    // (and allocating its answer) for each region of interest;
+    // for now, just take the first option returned from ChannelToWire
+    fChannelPlanes.resize(fGeometry->Nchannels(), NoPlane);
+    for(raw::ChannelID_t channel = 0; channel < fChannelPlanes.size(); channel++)
+    {
+        std::vector<geo::WireID> const wids = fGeometry->ChannelToWire(channel);
+        if (!wids.empty()) fChannelPlanes[channel] = wids.front().Plane;
+    }
+
     return;
 }
 
@@ -98,153 +114,105 @@ void CandHitICARUS::findHitCandidates(const recob::Wire::RegionsOfInterest_t::da
                                       size_t                                               cnt,
                                       HitCandidateVec&                                     hits) const
 {
-    // get the WireID for this hit
-    std::vector<geo::WireID> wids = fGeometry->ChannelToWire(channel);
-    // for now, just take the first option returned from ChannelToWire
-    geo::WireID wid  = wids[0];
-    // We need to know the plane to look up parameters
-    geo::PlaneID::PlaneID_t plane = wid.Plane;
-    //int wire = wid.Wire;
-
-    const Waveform& waveform = rangeData.data();
-
-   // if(plane==1) return;
-    // if(wire>2639) return;
-   // if(plane==0&&wire==528)
-    // for( int j=0;j<4096;j++)
-     // std::cout << " j " << j << " waveform " << waveform[j] << std::endl;
-    int iflag;
-    int localbellow,rising;
-    int begin;
-    // int nSamp=digitVec->Samples();
-    int lastcomputedmean,count;
-    int peakheight;
-    int localminidx,localmin;
-    // int jj, jcount;
-    // float area;
-    HitCandidate h;
-    //std::vector<HitCandidate> hits;
-    unsigned int i;
-    // Hit finding parameters
-    const int rise=5;
+    // We need to know the plane to look up parameters;
+    // channels on no plane (or on a plane with no parameters) use all zeroes
+    const geo::PlaneID::PlaneID_t plane = (channel < fChannelPlanes.size())? fChannelPlanes[channel]: NoPlane;
 
-    double threshold=0;
-    unsigned int window=0;
-    int abovecut(0),fall(0);
-    unsigned int width(0);
+    static const PlaneParams_t noParams;
+    const PlaneParams_t& params = (plane < fPlaneParams.size())? fPlaneParams[plane]: noParams;
 
+    findPlaneHitCandidates(rangeData.data(), params, hits);
+
+    return;
+}
+
+void CandHitICARUS::findPlaneHitCandidates(const Waveform&      waveform,
+                                           const PlaneParams_t& params,
+                                           HitCandidateVec&     hits)
+{
+    // The scan covers exactly the samples of the region of interest.
+    // The baseline the signal is compared to is always 0: a running mean used
+    // to be computed here, but it never contributed to the comparisons.
+    const unsigned int nSamples = waveform.size();
+
+    // Hit finding parameters
+    const int          rise      = 5;
+    const double       threshold = params.threshold;
+    const int          abovecut  = params.above;
+    const int          fall      = params.fall;
+    const unsigned int width     = params.width;
+
+    // Number of rising minus falling edges among the <rise> samples after i
+    auto const risingEdges = [&waveform,nSamples](unsigned int i)
+    {
+        const unsigned int last = std::min(i + rise, nSamples - 1);
+        int rising = 0;
+        for(unsigned int j=i;j<last;j++)
+            rising += (waveform[j+1] > waveform[j]) - (waveform[j+1] < waveform[j]);
+        return rising;
+    };
+
+    // Stores the candidate `h` if it passes the requirements on its extent
+    auto const saveIfGood = [&hits,fall,width](HitCandidate& h) -> bool
+    {
+        if(!((h.stopTick-h.hitCenter)>=fall && (h.stopTick-h.startTick)>width)) return false;
+        h.minTick  = h.startTick;
+        h.maxTick  = h.stopTick;
+        h.hitSigma = 0.5*(h.stopTick-h.startTick);
+        hits.push_back(h);
+        return true;
+    };
+
+    HitCandidate h;
 
     // initialize parameters
-    iflag=0;                // equal to one if we are within a hit candidate
-    peakheight=-9999;       // last found hit maximum
-    begin=-1;               // last found hit initial sample
-    localbellow=0;          // number of times we are bellow peakheight
-    lastcomputedmean=0;     // the value we compare with to know if we have a hit
-    count=0;
-    for(unsigned int j=0;j<window;j++)
-        count+=waveform[j];
-    lastcomputedmean=(count>=0)? 0 : count/window;
-    //      negpeakwidth=0;
-    //      if(lastcomputedmean<0) negpeakwidth++;
-    localmin=9999;
-    localminidx=-1;
-
-    // loop on the selected samples
-
-            //std::cout << "candhitfinderICARUS " << std::endl;
-
-    if(plane == 0) threshold=fInd1Threshold;
-    else if(plane == 1) threshold=fInd2Threshold;
-    else if(plane == 2) threshold=fColThreshold;
-    if(plane == 0) window=fInd1Window;
-    else if(plane == 1) window=fInd2Window;
-    else if(plane == 2) window=fColWindow;
-    if(plane == 0) abovecut=fInd1Above;
-    else if(plane == 1) abovecut=fInd2Above;
-    else if(plane == 2) abovecut=fColAbove;
-    if(plane == 0) fall=fInd1Fall;
-    else if(plane == 1) fall=fInd2Fall;
-    else if(plane == 2) fall=fColFall;
-    if(plane == 0) width=fInd1Width;
-    else if(plane == 1) width=fInd2Width;
-    else if(plane == 2) width=fColWidth;
-
-    for( i=0;i<4096;i++)
-    { //2
-        //std::cout << " i " << i << " waveform " << waveform[i] << std::endl;
-        // skip sharp peaks
-        //if(abs(waveform[i]-lastcomputedmean)>100)
-        //  continue;
-
-        if(!iflag)
-            lastcomputedmean=0;
-
-        if(waveform[i]-lastcomputedmean>threshold) // we're within a hit OR hit group
-        { //3
-            //      if(iwire==4526&&plane==2&&cryostat==0&&tpc==0)
-             //   std::cout << " over threshold bin " << i << std::endl;
+    int iflag       = 0;     // equal to one if we are within a hit candidate
+    int peakheight  = -9999; // last found hit maximum
+    int begin       = -1;    // last found hit initial sample
+    int localbellow = 0;     // number of times we are bellow peakheight
+    int localmin    = 9999;
+    int localminidx = -1;
+
+    // loop on the samples of the region of interest
+    unsigned int i;
+    for(i=0;i<nSamples;i++)
+    {
+        const float sample = waveform[i];
+
+        if(sample>threshold) // we're within a hit OR hit group
+        {
             iflag=1;
 
             // we're in the beginning of the hit
-            if(begin<0) {
-
-                begin=i;     // hit starting point
-            }
+            if(begin<0) begin=i; // hit starting point
 
             // keep peak info
-            if(waveform[i]-lastcomputedmean>peakheight)
+            if(sample>peakheight)
             {
-                peakheight=waveform[i]-lastcomputedmean;
-     //           h.hitCenter=waveform[i];
+                peakheight=sample;
                 h.hitHeight=peakheight;
-//                h.iWire=iw;
                 h.hitCenter=i;
-              //  std::cout << " hitcenter " << i << std::endl;
                 localbellow=0;
             }
 
             // resolve close hits
-            //          if(*(pf+i)-(peakheight+lastcomputedmean)<-threshold) // we're in the slope down
-            if(waveform[i]-(peakheight+lastcomputedmean)<-1) // we're in the slope down
-            {
-                localbellow++;
-             //   std::cout << " i " << i << " localbellow " << localbellow << " abovecut " << abovecut << std::endl;
-            }
+            if(sample-peakheight<-1) localbellow++; // we're in the slope down
+
             if(localbellow>abovecut)
-            { //4
+            {
                 // keep local minimum as border between consecutive hits
-                if(waveform[i]<localmin) {localmin=waveform[i];localminidx=i;}
+                if(sample<localmin) {localmin=sample;localminidx=i;}
 
-                // count the number of rising samples within the following n=<rise> samples
-                rising=0;
-                for(int l=0;l<rise;l++)
-                {
-                    if(i+l<4096) {
-                        if(waveform[i+l+1]-waveform[i+l]>0) rising++;
-                        else if(waveform[i+l+1]-waveform[i+l]<0) rising--;
-                    }
-                }
-            //    std::cout << " rising " << rising << " abovecut " << abovecut << std::endl;
                 // if after a slope down there's a slope up save the previous hit
-                if(rising>abovecut)
-                { //5
+                if(risingEdges(i)>abovecut)
+                {
                     h.startTick=begin;
-                    //              h.finDrift=i+iniSamp;
                     h.stopTick=localminidx;
 
-                //std::cout << "  saving previous hit " << begin << " fin " << localminidx << std::endl;
-
-                    if((h.stopTick-h.hitCenter)>=fall && h.stopTick-h.startTick>width)
-                    { //6
-                        h.minTick=h.startTick;
-                        h.maxTick=h.stopTick;
-                        // std::cout << " adding hit case 1" << std::endl;
-                        h.hitSigma      = 0.5*(h.stopTick-h.startTick);
-
-                        hits.push_back(h);
+                    if(saveIfGood(h))
+                    {
                         peakheight=-9999;
                         h.hitHeight=0;
-                        //begin=i+iniSamp+1;
                         begin=localminidx+1;
                         localbellow=0;
                         localminidx=-1;
@@ -253,83 +221,26 @@ void CandHitICARUS::findHitCandidates(const recob::Wire::RegionsOfInterest_t::da
                 }
             }
         }
-        else // outside the hit
-        { //3
-            //if (  typ == BasicData::ISBASICPLANE_PMT  && iw==1){
-            //    cout << "out hit " << iflag << "iadc " << h.iAdcMax <<endl;
-            //    cout << " in, fin " << begin << " " << i+iniSamp << "peak "<<h.iDrift <<endl;}
-            if (iflag==1 && h.hitHeight) //just getting out of the latest hit
-            { //4
-                h.startTick=begin;
-                h.stopTick=i;
-
-                if((h.stopTick-h.hitCenter)>=fall && (h.stopTick-h.startTick)>width)
-                { //5
-                    h.minTick=h.startTick;
-                    h.maxTick=h.stopTick;
-                    //if(iwire==4526&&plane==1&&cryostat==0&&tpc==0)
-                    //std::cout << " adding hit case 2, tick " << i << std::endl;
-                 //   if(cryostat==0&&tpc==0&&plane==2&&h.iWire==2656)
-                   //     std::cout << "  before expand ini " << h.iniDrift << " fin " << h.finDrift << std::endl;
-                //expandHit(h,waveform,hits);
-
-                   // if(cryostat==0&&tpc==0&&plane==2&&h.iWire==2656)
-                     //   std::cout << "  after expand ini " << h.iniDrift << " fin " << h.finDrift << std::endl;
-                    h.hitSigma      = 0.5*(h.stopTick-h.startTick);
-
-                    hits.push_back(h);
-                    //InsertHit(&h);
-                    //  if ( typ != BasicData::ISBASICPLANE_PMT)
-
-                }
-
-                peakheight=-9999;
-                begin=-1;
-                iflag=0;
-                localbellow=0;
-            }
-
-        }
-
-        //keep the last mean value to which we have to come back after the hit
-        if(i>=window && window) {
-            if(waveform[i]-count/window>-10)
-            {
-                count+=waveform[i];
-                count-=waveform[i-window];
-                //        if((float) count/window<0) negpeakwidth++;
-                //        else negpeakwidth=0;
-            }
+        else if(iflag==1 && h.hitHeight) // just getting out of the latest hit
+        {
+            h.startTick=begin;
+            h.stopTick=i;
+            saveIfGood(h);
+
+            peakheight=-9999;
+            begin=-1;
+            iflag=0;
+            localbellow=0;
         }
     } //end loop on samples
 
     //if we were within a hit while reaching last sample, keep it
-    if(iflag==1 && h.hitHeight) //just getting out of the latest hit
-    { //3
+    if(iflag==1 && h.hitHeight)
+    {
         h.startTick=begin;
         h.stopTick=i-1;
-
-        if((h.stopTick-h.hitCenter)>=fall && (h.stopTick-h.startTick)>width)
-        {
-          //  if(cryostat==0&&tpc==0&&plane==2&&h.iWire==2656)
-//                std::cout << "  before expand ini " << h.iniDrift << " fin " << h.finDrift << std::endl;
-       // expandHit(h,waveform,hits);
-
-  //          if(cryostat==0&&tpc==0&&plane==2&&h.iWire==2656)
-    //            std::cout << "  after expand ini " << h.iniDrift << " fin " << h.finDrift << std::endl;
-            h.minTick=h.startTick;
-            h.maxTick=h.stopTick;
-            //std::cout << " adding hit case 3 " << i << std::endl;
-
-            h.hitSigma      = 0.5*(h.stopTick-h.startTick);
-            hits.push_back(h);
-            // InsertHit(&h);
-        }
+        saveIfGood(h);
     }
-  //  if(hits.size())
-  //   std::cout << " wire " << wire << " found hits " << hits.size() << std::endl;
-
-
 
     return;
 }
@@ -50,6 +50,7 @@
 
 #include "larreco/RecoAlg/GausFitCache.h" // hit::GausFitCache
 #include "larreco/HitFinder/HitFinderTools/ICandidateHitFinder.h"
+#include "icaruscode/Utilities/StageTimers.h"
 //#include "icaruscode/HitFinder/PeakFitterICARUS.h"
 
 //ROOT from CalData
@@ -229,6 +230,13 @@ double                fChi2NDF;                  ///maximum Chisquared / NDF all
       mutable ICARUSlongHitFitCache fLongFitCache; ///< Cached functions for long hits.
       
       const geo::GeometryCore* fGeometry = lar::providerFrom<geo::Geometry>();
+      
+      // timing of the processing stages
+      std::shared_ptr<util::StageTimers> fStageTimers;
+      util::StageTimers::StageID_t fEventStage;      ///< whole event
+      util::StageTimers::StageID_t fCandidateStage;  ///< candidate finding on a wire
+      util::StageTimers::StageID_t fFitStage;        ///< collection hit fits on a wire
+      util::StageTimers::StageID_t fStoreStage;      ///< storing of the hits
      
   }; // class ICARUSHitFinder
 
@@ -238,6 +246,12 @@ double                fChi2NDF;                  ///maximum Chisquared / NDF all
   {
     this->reconfigure(pset);
 
+    fStageTimers    = util::StageTimers::forModule(pset.get<std::string>("module_label"));
+    fEventStage     = fStageTimers->addStage("event");
+    fCandidateStage = fStageTimers->addStage("candidates");
+    fFitStage       = fStageTimers->addStage("collectionFit");
+    fStoreStage     = fStageTimers->addStage("store");
+
     //LET HITCOLLECTIONCREATOR DECLARE THAT WE ARE GOING TO PRODUCE
     //HITS AND ASSOCIATIONS TO RAW DIGITS BUT NOT ASSOCIATIONS TO WIRES
     //(WITH NO PARTICULAR PRODUCT LABEL).
@@ -315,12 +329,13 @@ double                fChi2NDF;                  ///maximum Chisquared / NDF all
   void ICARUSHitFinder::endJob()
   {
    //   std::cout << " ICARUSHitFinder endjob " << std::endl;
-   
+      fStageTimers->report("ICARUSHitFinder");
   }
 
   //-------------------------------------------------
   void ICARUSHitFinder::produce(art::Event& evt)
     {
+      auto const eventTimer = fStageTimers->time(fEventStage);
       
       //0
       //return;
@@ -526,6 +541,8 @@ double                fChi2NDF;                  ///maximum Chisquared / NDF all
           
     std::vector<geo::WireID> wids = geom->ChannelToWire(channel);
           
+          auto candidateTimer = fStageTimers->time(fCandidateStage);
+
           std::vector<float> tempVec = holder;
           recob::Wire::RegionsOfInterest_t::datarange_t rangeData(size_t(0),std::move(tempVec));
           
@@ -540,6 +557,8 @@ double                fChi2NDF;                  ///maximum Chisquared / NDF all
           
           fHitFinderTool->MergeHitCandidates(rangeData, hitCandidateVec, mergedCandidateHitVec);
 
+          candidateTimer.stop();
+
       //numHits = hits.size();
           int nghC=0;
           int nghI2=0;
@@ -551,6 +570,7 @@ double                fChi2NDF;                  ///maximum Chisquared / NDF all
           
      //FIT ONLY COLLECTION HITS
     if(plane==2) {
+        auto const fitTimer = fStageTimers->time(fFitStage);
         //std::cout << " mergedcands size " << mergedCandidateHitVec.size() << std::endl;
         
           for(auto& mergedCands : mergedCandidateHitVec)
@@ -887,6 +907,7 @@ for(unsigned int jhit=0;jhit<mergedCands.size(); jhit++)
           fnhwC->Fill(nhWire[jw]);
       
       
+    auto const storeTimer = fStageTimers->time(fStoreStage);
     hcol.put_into(evt);
       //std::cout << " end ICARUSHitfinder " << std::endl;
    
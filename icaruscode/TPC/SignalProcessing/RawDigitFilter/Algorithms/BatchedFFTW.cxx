@@ -0,0 +1,133 @@
+#include "BatchedFFTW.h"
+#include "FFTWPlanPool.h" // fftwPlanningMutex()
+
+#include <fftw3.h>
+
+#include <mutex>
+#include <new>
+
+namespace caldata
+{
+//----------------------------------------------------------------------------
+BatchedFFTW::BatchedFFTW(unsigned int fftSize) :
+    fFFTSize(fftSize),
+    fHalfFFTSize(fftSize / 2 + 1),
+    fNWaveforms(0),
+    fCapacity(0),
+    fWaveforms(nullptr),
+    fSpectra(nullptr)
+{
+}
+
+//----------------------------------------------------------------------------
+BatchedFFTW::~BatchedFFTW()
+{
+    {
+        std::lock_guard<std::mutex> const lock(fftwPlanningMutex());
+
+        for(auto& sizeAndPlans : fPlansBySize)
+        {
+            fftw_destroy_plan(static_cast<fftw_plan>(sizeAndPlans.second.forward));
+            fftw_destroy_plan(static_cast<fftw_plan>(sizeAndPlans.second.inverse));
+        }
+    }
+
+    fftw_free(fWaveforms);
+    fftw_free(fSpectra);
+}
+
+//----------------------------------------------------------------------------
+void BatchedFFTW::reserve(size_t nWaveforms)
+{
+    if (nWaveforms <= fCapacity) return;
+
+    fftw_free(fWaveforms);
+    fftw_free(fSpectra);
+
+    fWaveforms = fftw_alloc_real(nWaveforms * fFFTSize);
+    fSpectra   = reinterpret_cast<Complex_t*>(fftw_alloc_complex(nWaveforms * fHalfFFTSize));
+
+    if (!fWaveforms || !fSpectra) throw std::bad_alloc();
+
+    fCapacity = nWaveforms;
+}
+
+//----------------------------------------------------------------------------
+void BatchedFFTW::resize(size_t nWaveforms)
+{
+    reserve(nWaveforms);
+
+    fNWaveforms = nWaveforms;
+
+    if (nWaveforms == 0 || fPlansBySize.count(nWaveforms)) return;
+
+    // The plans are executed through the "new array" interface, so they only need
+    // to be made once for each batch size: all the buffers from fftw_alloc share alignment
+    int const n          = fFFTSize;
+    int const halfN      = fHalfFFTSize;
+    int const nTransform = nWaveforms;
+
+    std::lock_guard<std::mutex> const lock(fftwPlanningMutex());
+
+    Plans plans;
+
+    plans.forward = fftw_plan_many_dft_r2c(1, &n, nTransform,
+                                           fWaveforms, nullptr, 1, n,
+                                           reinterpret_cast<fftw_complex*>(fSpectra), nullptr, 1, halfN,
+                                           FFTW_ESTIMATE);
+    plans.inverse = fftw_plan_many_dft_c2r(1, &n, nTransform,
+                                           reinterpret_cast<fftw_complex*>(fSpectra), nullptr, 1, halfN,
+                                           fWaveforms, nullptr, 1, n,
+                                           FFTW_ESTIMATE);
+
+    fPlansBySize.emplace(nWaveforms, plans);
+}
+
+//----------------------------------------------------------------------------
+void BatchedFFTW::forward()
+{
+    if (fNWaveforms == 0) return;
+
+    fftw_execute_dft_r2c(static_cast<fftw_plan>(plans().forward), fWaveforms, reinterpret_cast<fftw_complex*>(fSpectra));
+}
+
+//----------------------------------------------------------------------------
+void BatchedFFTW::inverse()
+{
+    if (fNWaveforms == 0) return;
+
+    // Note that the c2r transform overwrites the spectra
+    fftw_execute_dft_c2r(static_cast<fftw_plan>(plans().inverse), reinterpret_cast<fftw_complex*>(fSpectra), fWaveforms);
+
+    double const norm     = 1. / fFFTSize;
+    size_t const nSamples = fNWaveforms * fFFTSize;
+
+    for(size_t idx = 0; idx < nSamples; idx++) fWaveforms[idx] *= norm;
+}
+
+//----------------------------------------------------------------------------
+void BatchedFFTW::applyFilter(std::vector<Complex_t> const& filter)
+{
+    // The product is written out on the real and imaginary parts so that the compiler
+    // can vectorize it (std::complex multiplication carries checks for infinities)
+    double const* filterData = reinterpret_cast<double const*>(filter.data());
+    size_t const  nValues    = std::min(filter.size(), size_t(fHalfFFTSize));
+
+    for(size_t waveIdx = 0; waveIdx < fNWaveforms; waveIdx++)
+    {
+        double* values = reinterpret_cast<double*>(spectrum(waveIdx));
+
+        for(size_t idx = 0; idx < nValues; idx++)
+        {
+            double const re  = values[2*idx];
+            double const im  = values[2*idx+1];
+            double const fRe = filterData[2*idx];
+            double const fIm = filterData[2*idx+1];
+
+            values[2*idx]   = re * fRe - im * fIm;
+            values[2*idx+1] = re * fIm + im * fRe;
+        }
+    }
+}
+
+} // end of namespace caldata
@@ -0,0 +1,133 @@
+#ifndef BATCHEDFFTW_H
+#define BATCHEDFFTW_H
+////////////////////////////////////////////////////////////////////////
+//
+// Class:       BatchedFFTW
+// Module Type: algorithm
+// File:        BatchedFFTW.h
+//
+//              Transforms a batch of real waveforms of the same length
+//              with a single FFTW "many" plan (fftw_plan_many_dft_r2c and
+//              its c2r inverse) instead of one transform per waveform.
+//
+//              The waveforms are stored one after the other in a single
+//              aligned array, and so are their spectra (fftSize/2 + 1
+//              complex values each). Plans are made once for each batch
+//              size and kept for the lifetime of the object.
+//
+//              The inverse transform is normalized by 1/fftSize, as the
+//              one of util::LArFFTW, so that forward() followed by
+//              inverse() returns the original waveforms.
+//
+//              An object is not meant to be shared among threads.
+//
+// Usage:
+//
+//    caldata::BatchedFFTW batch(fftSize);
+//    batch.resize(nWaveforms);
+//    for(size_t idx = 0; idx < nWaveforms; idx++) batch.setWaveform(idx, waveforms[idx]);
+//    batch.forward();
+//    batch.applyFilter(filterVec);
+//    batch.inverse();
+//    batch.getWaveform(idx, waveforms[idx]);
+//
+////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+namespace caldata
+{
+class BatchedFFTW
+{
+public:
+
+    using Complex_t = std::complex<double>;
+
+    explicit BatchedFFTW(unsigned int fftSize);
+    ~BatchedFFTW();
+
+    BatchedFFTW(BatchedFFTW const&)            = delete;
+    BatchedFFTW& operator=(BatchedFFTW const&) = delete;
+
+    unsigned int fftSize()     const {return fFFTSize;}
+    unsigned int halfFFTSize() const {return fHalfFFTSize;}
+
+    /// Number of waveforms in the batch.
+    size_t size() const {return fNWaveforms;}
+
+    /// Sets the number of waveforms in the batch (planning on first use of this size).
+    /// The content of the buffers is not preserved.
+    void resize(size_t nWaveforms);
+
+    /// Access to the samples of a waveform (fftSize() of them).
+    double*       waveform(size_t idx)       {return fWaveforms + idx * fFFTSize;}
+    double const* waveform(size_t idx) const {return fWaveforms + idx * fFFTSize;}
+
+    /// Access to the spectrum of a waveform (halfFFTSize() values).
+    Complex_t*       spectrum(size_t idx)       {return fSpectra + idx * fHalfFFTSize;}
+    Complex_t const* spectrum(size_t idx) const {return fSpectra + idx * fHalfFFTSize;}
+
+    /// Copies `input` into waveform `idx`, padding with zeroes or truncating to fftSize().
+    template <typename T> void setWaveform(size_t idx, std::vector<T> const& input);
+
+    /// Copies the first `output.size()` samples of waveform `idx` into `output`.
+    template <typename T> void getWaveform(size_t idx, std::vector<T>& output) const;
+
+    /// Transforms all the waveforms into their spectra.
+    void forward();
+
+    /// Transforms all the spectra back into (normalized) waveforms; the spectra are overwritten.
+    void inverse();
+
+    /// Multiplies all the spectra by the same filter (halfFFTSize() values).
+    void applyFilter(std::vector<Complex_t> const& filter);
+
+private:
+
+    struct Plans
+    {
+        void* forward;
+        void* inverse;
+    };
+
+    /// Makes sure the buffers hold at least `nWaveforms` waveforms and spectra.
+    void reserve(size_t nWaveforms);
+
+    Plans const& plans() const {return fPlansBySize.at(fNWaveforms);}
+
+    unsigned int  fFFTSize;
+    unsigned int  fHalfFFTSize;
+    size_t        fNWaveforms;
+    size_t        fCapacity;
+    double*       fWaveforms;
+    Complex_t*    fSpectra;
+
+    std::map<size_t, Plans> fPlansBySize;
+};
+
+//----------------------------------------------------------------------------
+template <typename T> void BatchedFFTW::setWaveform(size_t idx, std::vector<T> const& input)
+{
+    double*      samples = waveform(idx);
+    size_t const nCopy   = std::min(input.size(), size_t(fFFTSize));
+
+    std::copy(input.begin(), input.begin() + nCopy, samples);
+    std::fill(samples + nCopy, samples + fFFTSize, 0.);
+}
+
+//----------------------------------------------------------------------------
+template <typename T> void BatchedFFTW::getWaveform(size_t idx, std::vector<T>& output) const
+{
+    double const* samples = waveform(idx);
+    size_t const  nCopy   = std::min(output.size(), size_t(fFFTSize));
+
+    std::transform(samples, samples + nCopy, output.begin(), [](double sample){return T(sample);});
+}
+
+} // end of namespace caldata
+
+#endif
@@ -0,0 +1,42 @@
+#include "FFTWPlanPool.h"
+
+namespace caldata
+{
+
+//----------------------------------------------------------------------------
+std::mutex& fftwPlanningMutex()
+{
+    static std::mutex planningMutex;
+    return planningMutex;
+}
+
+//----------------------------------------------------------------------------
+FFTWPlanPool::Transforms::Transforms(unsigned int fftSize) :
+    fFFTSize(fftSize),
+    fPlan(fftSize, "ES")
+{
+}
+
+//----------------------------------------------------------------------------
+util::LArFFTW& FFTWPlanPool::Transforms::local() const
+{
+    std::unique_ptr<util::LArFFTW>& transform = fTransforms.local();
+
+    if (!transform) transform = std::make_unique<util::LArFFTW>(fFFTSize, fPlan.fPlan, fPlan.rPlan, 0);
+
+    return *transform;
+}
+
+//----------------------------------------------------------------------------
+FFTWPlanPool::Transforms const& FFTWPlanPool::get(unsigned int fftSize)
+{
+    std::lock_guard<std::mutex> const lock(fftwPlanningMutex());
+
+    std::unique_ptr<Transforms>& transforms = fTransformsBySize[fftSize];
+
+    if (!transforms) transforms = std::make_unique<Transforms>(fftSize);
+
+    return *transforms;
+}
+
+} // end of namespace caldata
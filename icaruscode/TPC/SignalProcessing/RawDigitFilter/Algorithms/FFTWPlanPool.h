@@ -0,0 +1,75 @@
+#ifndef FFTWPLANPOOL_H
+#define FFTWPLANPOOL_H
+////////////////////////////////////////////////////////////////////////
+//
+// Class:       FFTWPlanPool
+// Module Type: algorithm
+// File:        FFTWPlanPool.h
+//
+//              Keeps the FFTW plans for the lifetime of a job, one for
+//              each FFT size, and hands to each thread its own transform
+//              object (util::LArFFTW, with its aligned input and output
+//              arrays) to be reused from one waveform to the next.
+//
+//              Planning happens only the first time a size is requested;
+//              the plans are then shared by all the threads, which is
+//              allowed by FFTW since each thread executes them on its own
+//              arrays.
+//
+// Usage:
+//
+//    caldata::FFTWPlanPool::Transforms const& fftw = pool.get(fftSize);
+//    tbb::parallel_for(range, [&fftw](...){
+//        util::LArFFTW& lfftw = fftw.local();
+//        lfftw.Convolute(waveform, kernel);
+//    });
+//
+////////////////////////////////////////////////////////////////////////
+
+#include "lardata/Utilities/LArFFTWPlan.h"
+#include "lardata/Utilities/LArFFTW.h"
+
+#include "tbb/enumerable_thread_specific.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace caldata
+{
+/// FFTW planning is not thread safe: all the planning in this package holds this lock.
+std::mutex& fftwPlanningMutex();
+
+class FFTWPlanPool
+{
+public:
+
+    /// The plan of one FFT size, and the transform objects of each thread.
+    class Transforms
+    {
+    public:
+        explicit Transforms(unsigned int fftSize);
+
+        unsigned int fftSize() const {return fFFTSize;}
+
+        /// Returns the transform object of the calling thread (created on first use).
+        util::LArFFTW& local() const;
+
+    private:
+        unsigned int      fFFTSize;
+        util::LArFFTWPlan fPlan;
+
+        mutable tbb::enumerable_thread_specific<std::unique_ptr<util::LArFFTW>> fTransforms;
+    };
+
+    /// Returns the transforms for the specified FFT size, planning it on the first request.
+    Transforms const& get(unsigned int fftSize);
+
+private:
+
+    std::map<unsigned int, std::unique_ptr<Transforms>> fTransformsBySize;
+};
+
+} // end of namespace caldata
+
+#endif
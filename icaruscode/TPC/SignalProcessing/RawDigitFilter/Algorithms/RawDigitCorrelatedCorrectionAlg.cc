@@ -131,93 +131,19 @@ void RawDigitCorrelatedCorrectionAlg::removeCorrelatedNoise(RawDigitAdcIdxPair&
     // This method represents and enhanced implementation of "Corey's Algorithm" for correcting the
     // correlated noise across a group of wires. The primary enhancement involves using a FFT to
     // "fit" for the underlying noise as a way to reduce the impact on the signal.
-    WireToRawDigitVecMap& wireToRawDigitVecMap = digitIdxPair.first;
-    WireToAdcIdxMap&      wireToAdcIdxMap      = digitIdxPair.second;
-
-    size_t maxTimeSamples(wireToRawDigitVecMap.begin()->second.size());
-    size_t baseWireIdx(wireToRawDigitVecMap.begin()->first - wireToRawDigitVecMap.begin()->first % fNumWiresToGroup[planeIdx]);
-
-    std::vector<float> corValVec(maxTimeSamples);
+    std::vector<float> corValVec;
 
     // First step is to get the correction values to apply to this set of input waveforms
-    // Don't try to do correction if too few wires unless they have gaps
-    if (wireToAdcIdxMap.size() > 2) // || largestGapSize > 2)
+    if (getCorrectionVec(digitIdxPair, planeIdx, truncMeanWireVec, corValVec))
     {
-        // Zero? This is probably not necessary
-        std::fill(corValVec.begin(),corValVec.end(),0.);
-
-        // Build the vector of corrections for each time bin
-        for(size_t sampleIdx = 0; sampleIdx < maxTimeSamples; sampleIdx++)
-        {
-            // Define a vector for accumulating values...
-            // Loop over the wires at this time bin and get their pedestal corrected ADC values
-            // We'll use a simple stl vector for this
-            std::vector<float> adcValuesVec;
-
-            for(const auto& wireAdcItr : wireToAdcIdxMap)
-            {
-                // Check that we should be doing something in this range
-                // Note that if the wire is not to be considered then the "start" bin will be after the last bin
-                if (sampleIdx < wireAdcItr.second.first || sampleIdx >= wireAdcItr.second.second) continue;
-
-                int wireIdx(wireAdcItr.first - baseWireIdx);
-
-                // Accumulate
-                adcValuesVec.push_back(float(wireToRawDigitVecMap.at(wireAdcItr.first)[sampleIdx]) - truncMeanWireVec[wireIdx]);
-            }
-
-//            float medianValue = getMedian(adcValuesVec, float(-10000.));
-            float aveValue    = std::accumulate(adcValuesVec.begin(),adcValuesVec.end(),0.) / float(adcValuesVec.size());
-
-//            corValVec[sampleIdx] = medianValue;
-            corValVec[sampleIdx] = aveValue;
-        }
-
-        // Try to eliminate any real outliers
-        if (fApplyCorSmoothing) smoothCorrectionVec(corValVec, planeIdx);
-
         // Get the FFT correction
         if (fApplyFFTCorrection) {
           std::vector<std::complex<double>> fftOutputVec(halfFFTSize);
           util::LArFFTW lfftw(fftSize, fplan, rplan, 0);
           lfftw.DoFFT(corValVec, fftOutputVec);
 
-          std::vector<double> powerVec(halfFFTSize);
-          std::transform(fftOutputVec.begin(), fftOutputVec.begin() + halfFFTSize, powerVec.begin(), [](const auto& val){return std::abs(val);});
-
-          // Want the first derivative
-          std::vector<double> firstDerivVec(powerVec.size(), 0.);
-    
-          //fWaveformTool->firstDerivative(powerVec, firstDerivVec);
-          for(size_t idx = 1; idx < firstDerivVec.size() - 1; idx++)
-              firstDerivVec.at(idx) = 0.5 * (powerVec.at(idx + 1) - powerVec.at(idx - 1));
-
-          // Find the peaks
-          std::vector<std::tuple<size_t,size_t,size_t>> peakTupleVec;
-    
-          findPeaks(firstDerivVec.begin(),firstDerivVec.end(),peakTupleVec,fFFTMinPowerThreshold[planeIdx],0);
-    
-          if (!peakTupleVec.empty())
+          if (removeNoiseSpectrumPeaks(fftOutputVec.data(), halfFFTSize, planeIdx))
           {
-              for(const auto& peakTuple : peakTupleVec)
-              {
-                  size_t startTick = std::get<0>(peakTuple);
-                  size_t stopTick  = std::get<2>(peakTuple);
-            
-                  if (stopTick > startTick)
-                  {
-                      std::complex<double> slope = (fftOutputVec[stopTick] - fftOutputVec[startTick]) / double(stopTick - startTick);
-                
-                      for(size_t tick = startTick; tick < stopTick; tick++)
-                      {
-                          std::complex<double> interpVal = fftOutputVec[startTick] + double(tick - startTick) * slope;
-                    
-                          fftOutputVec[tick]                   = interpVal;
-                          //fftOutputVec[fftDataSize - tick - 1] = interpVal;
-                      }
-                  }
-              }
-        
               std::vector<double> tmpVec(corValVec.size());
         
               lfftw.DoInvFFT(fftOutputVec, tmpVec);
@@ -227,30 +153,193 @@ void RawDigitCorrelatedCorrectionAlg::removeCorrelatedNoise(RawDigitAdcIdxPair&
         } // fApplyFFTCorrection
 
         // Now go through and apply the correction
-        for(size_t sampleIdx = 0; sampleIdx < maxTimeSamples; sampleIdx++)
+        applyCorrectionVec(digitIdxPair, planeIdx, corValVec, pedCorWireVec);
+    }
+    return;
+}
+
+void RawDigitCorrelatedCorrectionAlg::removeCorrelatedNoise(GroupToDigitIdxPairMap& groupToDigitIdxPairMap,
+                                                            unsigned int            planeIdx,
+                                                            std::vector<float>&     truncMeanWireVec,
+                                                            std::vector<float>&     pedCorWireVec,
+                                                            BatchedFFTW&            batchedFFT) const
+{
+    // Same as above for all the groups at once: the FFT's of the corrections of all the groups
+    // are done by a single (batched) transform each way
+    std::vector<RawDigitAdcIdxPair*> digitIdxPairVec;
+    std::vector<std::vector<float>>  corValVecs;
+
+    for(auto& groupToDigitIdxPair : groupToDigitIdxPairMap)
+    {
+        std::vector<float> corValVec;
+
+        if (!getCorrectionVec(groupToDigitIdxPair.second, planeIdx, truncMeanWireVec, corValVec)) continue;
+
+        digitIdxPairVec.push_back(&groupToDigitIdxPair.second);
+        corValVecs.push_back(std::move(corValVec));
+    }
+
+    if (fApplyFFTCorrection && !corValVecs.empty())
+    {
+        batchedFFT.resize(corValVecs.size());
+
+        for(size_t groupIdx = 0; groupIdx < corValVecs.size(); groupIdx++) batchedFFT.setWaveform(groupIdx, corValVecs[groupIdx]);
+
+        batchedFFT.forward();
+
+        std::vector<bool> modifiedVec(corValVecs.size());
+
+        for(size_t groupIdx = 0; groupIdx < corValVecs.size(); groupIdx++)
+            modifiedVec[groupIdx] = removeNoiseSpectrumPeaks(batchedFFT.spectrum(groupIdx), batchedFFT.halfFFTSize(), planeIdx);
+
+        // Only go back if at least one of the spectra was changed
+        if (std::find(modifiedVec.begin(),modifiedVec.end(),true) != modifiedVec.end())
         {
-            // Now run through and apply correction
-            for (const auto& wireAdcItr : wireToAdcIdxMap)
+            batchedFFT.inverse();
+
+            for(size_t groupIdx = 0; groupIdx < corValVecs.size(); groupIdx++)
             {
-                float corVal(corValVec[sampleIdx]);
-                int   wireIdx(wireAdcItr.first - baseWireIdx);
+                if (!modifiedVec[groupIdx]) continue;
+
+                std::vector<float>& corValVec = corValVecs[groupIdx];
+                double const*       tmpVec    = batchedFFT.waveform(groupIdx);
+
+                std::transform(corValVec.begin(),corValVec.end(),tmpVec,corValVec.begin(),std::minus<double>());
+            }
+        }
+    } // fApplyFFTCorrection
+
+    // Now go through and apply the corrections
+    for(size_t groupIdx = 0; groupIdx < corValVecs.size(); groupIdx++)
+        applyCorrectionVec(*digitIdxPairVec[groupIdx], planeIdx, corValVecs[groupIdx], pedCorWireVec);
 
-                // If the "start" bin is after the "stop" bin then we are meant to skip this wire in the averaging process
-                // Or if the sample index is in a chirping section then no correction is applied.
-                // Both cases are handled by looking at the sampleIdx
-                if (sampleIdx < wireAdcItr.second.first || sampleIdx >= wireAdcItr.second.second)
-                    corVal = 0.;
+    return;
+}
 
-                //RawDigitVector& rawDataTimeVec = wireToRawDigitVecMap.at(wireIdx);
-                short& rawDataTimeVal = wireToRawDigitVecMap.at(wireAdcItr.first)[sampleIdx];
+bool RawDigitCorrelatedCorrectionAlg::getCorrectionVec(const RawDigitAdcIdxPair& digitIdxPair,
+                                                       unsigned int              planeIdx,
+                                                       const std::vector<float>& truncMeanWireVec,
+                                                       std::vector<float>&       corValVec) const
+{
+    const WireToRawDigitVecMap& wireToRawDigitVecMap = digitIdxPair.first;
+    const WireToAdcIdxMap&      wireToAdcIdxMap      = digitIdxPair.second;
 
-                // Probably doesn't matter, but try to get slightly more accuracy by doing float math and rounding
-                float newAdcValueFloat = float(rawDataTimeVal) - corVal - pedCorWireVec[wireIdx];
-                rawDataTimeVal = std::round(newAdcValueFloat);
+    // Don't try to do correction if too few wires unless they have gaps
+    if (wireToAdcIdxMap.size() <= 2) return false; // || largestGapSize > 2)
+
+    size_t maxTimeSamples(wireToRawDigitVecMap.begin()->second.size());
+    size_t baseWireIdx(wireToRawDigitVecMap.begin()->first - wireToRawDigitVecMap.begin()->first % fNumWiresToGroup[planeIdx]);
+
+    // Zero? This is probably not necessary
+    corValVec.assign(maxTimeSamples, 0.);
+
+    // Build the vector of corrections for each time bin
+    for(size_t sampleIdx = 0; sampleIdx < maxTimeSamples; sampleIdx++)
+    {
+        // Define a vector for accumulating values...
+        // Loop over the wires at this time bin and get their pedestal corrected ADC values
+        // We'll use a simple stl vector for this
+        std::vector<float> adcValuesVec;
+
+        for(const auto& wireAdcItr : wireToAdcIdxMap)
+        {
+            // Check that we should be doing something in this range
+            // Note that if the wire is not to be considered then the "start" bin will be after the last bin
+            if (sampleIdx < wireAdcItr.second.first || sampleIdx >= wireAdcItr.second.second) continue;
+
+            int wireIdx(wireAdcItr.first - baseWireIdx);
+
+            // Accumulate
+            adcValuesVec.push_back(float(wireToRawDigitVecMap.at(wireAdcItr.first)[sampleIdx]) - truncMeanWireVec[wireIdx]);
+        }
+
+//        float medianValue = getMedian(adcValuesVec, float(-10000.));
+        float aveValue    = std::accumulate(adcValuesVec.begin(),adcValuesVec.end(),0.) / float(adcValuesVec.size());
+
+//        corValVec[sampleIdx] = medianValue;
+        corValVec[sampleIdx] = aveValue;
+    }
+
+    // Try to eliminate any real outliers
+    if (fApplyCorSmoothing) smoothCorrectionVec(corValVec, planeIdx);
+
+    return true;
+}
+
+bool RawDigitCorrelatedCorrectionAlg::removeNoiseSpectrumPeaks(std::complex<double>* fftOutputVec,
+                                                               unsigned int          halfFFTSize,
+                                                               unsigned int          planeIdx) const
+{
+    std::vector<double> powerVec(halfFFTSize);
+    std::transform(fftOutputVec, fftOutputVec + halfFFTSize, powerVec.begin(), [](const auto& val){return std::abs(val);});
+
+    // Want the first derivative
+    std::vector<double> firstDerivVec(powerVec.size(), 0.);
+
+    //fWaveformTool->firstDerivative(powerVec, firstDerivVec);
+    for(size_t idx = 1; idx < firstDerivVec.size() - 1; idx++)
+        firstDerivVec.at(idx) = 0.5 * (powerVec.at(idx + 1) - powerVec.at(idx - 1));
+
+    // Find the peaks
+    std::vector<std::tuple<size_t,size_t,size_t>> peakTupleVec;
+
+    findPeaks(firstDerivVec.begin(),firstDerivVec.end(),peakTupleVec,fFFTMinPowerThreshold[planeIdx],0);
+
+    for(const auto& peakTuple : peakTupleVec)
+    {
+        size_t startTick = std::get<0>(peakTuple);
+        size_t stopTick  = std::get<2>(peakTuple);
+
+        if (stopTick > startTick)
+        {
+            std::complex<double> slope = (fftOutputVec[stopTick] - fftOutputVec[startTick]) / double(stopTick - startTick);
+
+            for(size_t tick = startTick; tick < stopTick; tick++)
+            {
+                std::complex<double> interpVal = fftOutputVec[startTick] + double(tick - startTick) * slope;
+
+                fftOutputVec[tick]                   = interpVal;
+                //fftOutputVec[fftDataSize - tick - 1] = interpVal;
             }
         }
     }
-    return;
+
+    return !peakTupleVec.empty();
+}
+
+void RawDigitCorrelatedCorrectionAlg::applyCorrectionVec(RawDigitAdcIdxPair&       digitIdxPair,
+                                                         unsigned int              planeIdx,
+                                                         const std::vector<float>& corValVec,
+                                                         const std::vector<float>& pedCorWireVec) const
+{
+    WireToRawDigitVecMap& wireToRawDigitVecMap = digitIdxPair.first;
+    WireToAdcIdxMap&      wireToAdcIdxMap      = digitIdxPair.second;
+
+    size_t maxTimeSamples(corValVec.size());
+    size_t baseWireIdx(wireToRawDigitVecMap.begin()->first - wireToRawDigitVecMap.begin()->first % fNumWiresToGroup[planeIdx]);
+
+    for(size_t sampleIdx = 0; sampleIdx < maxTimeSamples; sampleIdx++)
+    {
+        // Now run through and apply correction
+        for (const auto& wireAdcItr : wireToAdcIdxMap)
+        {
+            float corVal(corValVec[sampleIdx]);
+            int   wireIdx(wireAdcItr.first - baseWireIdx);
+
+            // If the "start" bin is after the "stop" bin then we are meant to skip this wire in the averaging process
+            // Or if the sample index is in a chirping section then no correction is applied.
+            // Both cases are handled by looking at the sampleIdx
+            if (sampleIdx < wireAdcItr.second.first || sampleIdx >= wireAdcItr.second.second)
+                corVal = 0.;
+
+            //RawDigitVector& rawDataTimeVec = wireToRawDigitVecMap.at(wireIdx);
+            short& rawDataTimeVal = wireToRawDigitVecMap.at(wireAdcItr.first)[sampleIdx];
+
+            // Probably doesn't matter, but try to get slightly more accuracy by doing float math and rounding
+            float newAdcValueFloat = float(rawDataTimeVal) - corVal - pedCorWireVec[wireIdx];
+            rawDataTimeVal = std::round(newAdcValueFloat);
+        }
+    }
 }
 
 template<class T> T RawDigitCorrelatedCorrectionAlg::getMedian(std::vector<T>& valuesVec, T defaultValue) const
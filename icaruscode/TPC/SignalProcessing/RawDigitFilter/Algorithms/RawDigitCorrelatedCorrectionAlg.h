@@ -29,6 +29,7 @@
 ////////////////////////////////////////////////////////////////////////
 
 #include "RawDigitNoiseFilterDefs.h"
+#include "BatchedFFTW.h"
 #include "fhiclcpp/ParameterSet.h"
 #include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "art_root_io/TFileService.h"
@@ -39,6 +40,7 @@
 #include "TProfile.h"
 #include "TProfile2D.h"
 
+#include <complex>
 #include <set>
 
 namespace caldata
@@ -67,10 +69,21 @@ public:
                                unsigned int& fftSize, unsigned int& halfFFTSize,
                                void* fplan, void* rplan) const;
 
+    // Same as above for all the groups of a block of wires, with batched FFT's
+    void removeCorrelatedNoise(GroupToDigitIdxPairMap& groupToDigitIdxPairMap,
+                               unsigned int            viewIdx,
+                               std::vector<float>&     truncMeanWireVec,
+                               std::vector<float>&     pedCorWireVec,
+                               BatchedFFTW&            batchedFFT) const;
+
 private:
 
     void smoothCorrectionVec(std::vector<float>&, unsigned int&) const;
 
+    bool getCorrectionVec(const RawDigitAdcIdxPair&, unsigned int, const std::vector<float>&, std::vector<float>&) const;
+    bool removeNoiseSpectrumPeaks(std::complex<double>*, unsigned int, unsigned int) const;
+    void applyCorrectionVec(RawDigitAdcIdxPair&, unsigned int, const std::vector<float>&, const std::vector<float>&) const;
+
     template<class T> T getMedian(std::vector<T>&, T) const;
 
     template <typename T> void findPeaks(typename std::vector<T>::iterator startItr,
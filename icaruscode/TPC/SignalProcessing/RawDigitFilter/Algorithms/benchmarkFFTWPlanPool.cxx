@@ -0,0 +1,294 @@
+/**
+ * @file   icaruscode/TPC/SignalProcessing/RawDigitFilter/Algorithms/benchmarkFFTWPlanPool.cxx
+ * @brief  Compares per-event FFTW planning with the `FFTWPlanPool`.
+ * @date   October 19, 2026
+ *
+ * The program runs on synthetic waveforms the FFT work of
+ * `mtRawDigitFilterICARUS`: the convolution of each wire with a filter and,
+ * for each group of wires, the forward and inverse transforms of the
+ * correlated noise correction. It does so in two ways:
+ *
+ * * _per event_: a new `util::LArFFTWPlan` for each event and a new
+ *   `util::LArFFTW` for each wire and each group (the original module);
+ * * _pool_: a `caldata::FFTWPlanPool` for the whole job, which plans once and
+ *   reuses the transform object of each thread.
+ *
+ * For each requested number of threads the number of events per second is
+ * printed for both. Run `benchmarkFFTWPlanPool --help` for the options.
+ */
+
+// ICARUS libraries
+#include "icaruscode/TPC/SignalProcessing/RawDigitFilter/Algorithms/FFTWPlanPool.h"
+
+// LArSoft libraries
+#include "lardata/Utilities/LArFFTWPlan.h"
+#include "lardata/Utilities/LArFFTW.h"
+
+// TBB
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#include "tbb/global_control.h"
+
+// C++/Boost libraries
+#include "boost/program_options.hpp"
+#include <algorithm> // std::min()
+#include <chrono>
+#include <cmath> // std::exp()
+#include <complex>
+#include <cstdlib> // std::exit()
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+/*
+ * Notable changes here:
+ *
+ * [20261019] [1.0]
+ *     initial version
+ *
+ */
+static std::string const ProgramVersion = "v1.0";
+
+
+// -----------------------------------------------------------------------------
+/// Parameters of the benchmark.
+struct Config_t {
+  unsigned int nWires = 4608U; ///< Wires in an event.
+  unsigned int nTicks = 4096U; ///< FFT size.
+  unsigned int groupSize = 64U; ///< Wires sharing a correlated noise correction.
+  unsigned int nEvents = 5U; ///< Events for each measurement.
+  std::vector<unsigned int> threads { 1U, 4U, 16U };
+}; // Config_t
+
+
+// -----------------------------------------------------------------------------
+std::optional<Config_t> parseCommandLine(int argc, char** argv) {
+
+  namespace po = boost::program_options;
+
+  Config_t config;
+
+  po::options_description benchopt("Benchmark");
+  benchopt.add_options()
+    ("wires", po::value(&config.nWires)->default_value(config.nWires),
+      "wires in an event")
+    ("ticks", po::value(&config.nTicks)->default_value(config.nTicks),
+      "samples per wire (FFT size)")
+    ("group", po::value(&config.groupSize)->default_value(config.groupSize),
+      "wires in a correlated noise group")
+    ("events", po::value(&config.nEvents)->default_value(config.nEvents),
+      "events processed for each measurement")
+    ("threads", po::value(&config.threads)->multitoken(),
+      "numbers of threads to benchmark (default: 1 4 16)")
+    ;
+
+  po::options_description genopt("General");
+  genopt.add_options()
+    ("help,?", "print usage instructions and exit")
+    ("version,V", "print version and exit")
+    ;
+
+  po::options_description allopt("Options");
+  allopt.add(benchopt).add(genopt);
+
+  po::variables_map optmap;
+  po::store(po::parse_command_line(argc, argv, allopt), optmap);
+  po::notify(optmap);
+
+  std::optional<int> exitWithCode;
+  if (optmap.count("version")) {
+    std::cout << argv[0] << " version " << ProgramVersion << std::endl;
+    exitWithCode = 0;
+  }
+  if (optmap.count("help")) {
+    std::cout
+      <<   "Compares the FFT processing of mtRawDigitFilterICARUS with per-event"
+      << "\nFFTW planning and with a job-wide plan pool."
+      << "\n" << allopt
+      << std::endl
+      ;
+    exitWithCode = 0;
+  }
+  if (exitWithCode) std::exit(*exitWithCode);
+
+  if ((config.nWires == 0U) || (config.nTicks < 2U) || (config.groupSize == 0U)
+    || (config.nEvents == 0U))
+  {
+    std::cerr << "No data to process!" << std::endl;
+    return std::nullopt;
+  }
+
+  return config;
+
+} // parseCommandLine()
+
+
+// -----------------------------------------------------------------------------
+/// Input of the benchmark: noisy waveforms and a filter kernel.
+struct Data_t {
+  std::vector<std::vector<float>> waveforms;
+  std::vector<std::complex<double>> filter;
+
+  explicit Data_t(Config_t const& config)
+    : waveforms(config.nWires, std::vector<float>(config.nTicks))
+    , filter(config.nTicks / 2 + 1)
+    {
+      std::mt19937 engine{ 12345U };
+      std::normal_distribution<float> noise{ 0.0f, 3.0f };
+      for (std::vector<float>& waveform: waveforms)
+        for (float& sample: waveform) sample = noise(engine);
+      // a smooth low-pass filter
+      for (std::size_t i = 0; i < filter.size(); ++i) {
+        double const f = double(i) / filter.size();
+        filter[i] = std::exp(-0.5 * f * f / 0.04);
+      }
+    }
+}; // Data_t
+
+
+/// FFT work on one wire: convolution with the filter (as `WaveformChar`).
+void processWire(
+  util::LArFFTW& lfftw, Data_t const& data, std::size_t wire,
+  std::vector<std::vector<float>>& output
+) {
+  std::vector<float>& holder = output[wire];
+  holder = data.waveforms[wire];
+  std::vector<std::complex<double>> filterVec(data.filter);
+  lfftw.Convolute(holder, filterVec);
+} // processWire()
+
+
+/// FFT work on one group: correction spectrum (as `RemoveCorrelatedNoise`).
+void processGroup(
+  util::LArFFTW& lfftw, Config_t const& config,
+  std::vector<std::vector<float>> const& output, std::size_t group
+) {
+  std::size_t const first = group * config.groupSize;
+  std::size_t const last = std::min<std::size_t>
+    (first + config.groupSize, config.nWires);
+
+  std::vector<float> corValVec(config.nTicks, 0.0f);
+  for (std::size_t wire = first; wire < last; ++wire)
+    for (std::size_t tick = 0; tick < config.nTicks; ++tick)
+      corValVec[tick] += output[wire][tick] / (last - first);
+
+  std::vector<std::complex<double>> fftOutputVec(config.nTicks / 2 + 1);
+  lfftw.DoFFT(corValVec, fftOutputVec);
+  std::vector<double> tmpVec(corValVec.size());
+  lfftw.DoInvFFT(fftOutputVec, tmpVec);
+} // processGroup()
+
+
+/// Processes one event creating plans and transforms anew.
+void processEventPerEvent(
+  Config_t const& config, Data_t const& data,
+  std::vector<std::vector<float>>& output
+) {
+  util::LArFFTWPlan lfftwp(config.nTicks, "ES");
+
+  tbb::parallel_for(tbb::blocked_range<std::size_t>(0, config.nWires),
+    [&](tbb::blocked_range<std::size_t> const& range)
+      {
+        for (std::size_t wire = range.begin(); wire < range.end(); ++wire) {
+          util::LArFFTW lfftw(config.nTicks, lfftwp.fPlan, lfftwp.rPlan, 0);
+          processWire(lfftw, data, wire, output);
+        }
+      }
+    );
+
+  std::size_t const nGroups
+    = (config.nWires + config.groupSize - 1) / config.groupSize;
+  tbb::parallel_for(tbb::blocked_range<std::size_t>(0, nGroups),
+    [&](tbb::blocked_range<std::size_t> const& range)
+      {
+        for (std::size_t group = range.begin(); group < range.end(); ++group) {
+          util::LArFFTW lfftw(config.nTicks, lfftwp.fPlan, lfftwp.rPlan, 0);
+          processGroup(lfftw, config, output, group);
+        }
+      }
+    );
+} // processEventPerEvent()
+
+
+/// Processes one event with the transforms from the pool.
+void processEventPool(
+  Config_t const& config, Data_t const& data, caldata::FFTWPlanPool& pool,
+  std::vector<std::vector<float>>& output
+) {
+  caldata::FFTWPlanPool::Transforms const& fftw = pool.get(config.nTicks);
+
+  tbb::parallel_for(tbb::blocked_range<std::size_t>(0, config.nWires),
+    [&](tbb::blocked_range<std::size_t> const& range)
+      {
+        for (std::size_t wire = range.begin(); wire < range.end(); ++wire)
+          processWire(fftw.local(), data, wire, output);
+      }
+    );
+
+  std::size_t const nGroups
+    = (config.nWires + config.groupSize - 1) / config.groupSize;
+  tbb::parallel_for(tbb::blocked_range<std::size_t>(0, nGroups),
+    [&](tbb::blocked_range<std::size_t> const& range)
+      {
+        for (std::size_t group = range.begin(); group < range.end(); ++group)
+          processGroup(fftw.local(), config, output, group);
+      }
+    );
+} // processEventPool()
+
+
+/// Returns the events per second of `process` run on `nEvents` events.
+template <typename Process>
+double eventRate(unsigned int nEvents, Process&& process) {
+  process(); // warm up (not measured)
+  auto const start = std::chrono::steady_clock::now();
+  for (unsigned int iEvent = 0; iEvent < nEvents; ++iEvent) process();
+  double const seconds = std::chrono::duration<double>
+    (std::chrono::steady_clock::now() - start).count();
+  return nEvents / seconds;
+} // eventRate()
+
+
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv) {
+
+  std::optional<Config_t> const maybeConfig = parseCommandLine(argc, argv);
+  if (!maybeConfig) return 1;
+  Config_t const& config = *maybeConfig;
+
+  Data_t const data{ config };
+  std::vector<std::vector<float>> output(config.nWires);
+
+  std::cout << "Events of " << config.nWires << " wires x " << config.nTicks
+    << " ticks, groups of " << config.groupSize << " wires." << std::endl;
+  std::cout << "\n" << std::setw(7) << "threads"
+    << std::setw(20) << "per event [ev/s]" << std::setw(14) << "pool [ev/s]"
+    << std::setw(10) << "speedup" << std::endl;
+
+  caldata::FFTWPlanPool pool;
+  for (unsigned int const nThreads: config.threads) {
+
+    tbb::global_control const threadLimit
+      { tbb::global_control::max_allowed_parallelism, nThreads };
+
+    double const perEventRate = eventRate(config.nEvents,
+      [&](){ processEventPerEvent(config, data, output); });
+    double const poolRate = eventRate(config.nEvents,
+      [&](){ processEventPool(config, data, pool, output); });
+
+    std::cout << std::fixed << std::setprecision(2)
+      << std::setw(7) << nThreads << std::setw(20) << perEventRate
+      << std::setw(14) << poolRate << std::setw(10) << (poolRate / perEventRate)
+      << std::endl;
+
+  } // for threads
+
+  return 0;
+
+} // main()
+
+
+// -----------------------------------------------------------------------------
@@ -53,13 +53,12 @@
 #include "larevt/CalibrationDBI/Interface/DetPedestalProvider.h"
 #include "larevt/CalibrationDBI/Interface/ChannelStatusService.h"
 #include "larevt/CalibrationDBI/Interface/ChannelStatusProvider.h"
-#include "lardata/Utilities/LArFFTWPlan.h"
-#include "lardata/Utilities/LArFFTW.h"
 
 #include "icaruscode/TPC/SignalProcessing/RawDigitFilter/Algorithms/RawDigitNoiseFilterDefs.h"
 #include "icaruscode/TPC/SignalProcessing/RawDigitFilter/Algorithms/RawDigitBinAverageAlg.h"
 #include "icaruscode/TPC/SignalProcessing/RawDigitFilter/Algorithms/RawDigitCharacterizationAlg.h"
 #include "icaruscode/TPC/SignalProcessing/RawDigitFilter/Algorithms/RawDigitCorrelatedCorrectionAlg.h"
+#include "icaruscode/TPC/SignalProcessing/RawDigitFilter/Algorithms/BatchedFFTW.h"
 #include "icaruscode/TPC/SignalProcessing/RawDigitFilter/Algorithms/IRawDigitFilter.h"
 #include "icaruscode/TPC/Utilities/tools/IFilter.h"
 
@@ -113,6 +112,7 @@ private:
     caldata::RawDigitCorrelatedCorrectionAlg               fCorCorrectAlg;
 
     std::unique_ptr<caldata::IRawDigitFilter>              fRawDigitFilterTool;
+    std::unique_ptr<caldata::BatchedFFTW>                  fBatchedFFT;
     std::map<size_t,icarusutil::FrequencyVec>              fFilterVec;
     std::map<size_t,std::unique_ptr<icarus_tool::IFilter>> fFilterToolMap;
 
@@ -279,8 +279,6 @@ void RawDigitFilterICARUS::produce(art::Event & event, art::ProcessingFrame cons
         else                fftSize = fDataSize;
 
         // .. First set up the filters
-        unsigned int halfFFTSize(fftSize/2 + 1);
-            
         if (fDoFFTCorrection)
         {
             for(unsigned int plne = 0; plne < 3; plne++)
@@ -294,8 +292,8 @@ void RawDigitFilterICARUS::produce(art::Event & event, art::ProcessingFrame cons
             }
         }
 
-        // .. Now set up the fftw plan
-        util::LArFFTWPlan lfftwp(fftSize,"ES");
+        // .. Now set up the (batched) fftw plans, kept as long as the size does not change
+        if (!fBatchedFFT || fBatchedFFT->fftSize() != fftSize) fBatchedFFT = std::make_unique<caldata::BatchedFFTW>(fftSize);
 
         // Declare a temporary digit holder and resize it if downsizing the waveform
         caldata::RawDigitVector tempVec(fDataSize);
@@ -457,19 +455,11 @@ void RawDigitFilterICARUS::produce(art::Event & event, art::ProcessingFrame cons
                 int baseWireIdx = wire - wire % fNumWiresToGroup[plane];
 
                 // Now go through the groups to remove correlated noise in those groups
-                for(auto& groupToDigitIdxPair : groupToDigitIdxPairMap)
-                {
-                    fCorCorrectAlg.removeCorrelatedNoise(groupToDigitIdxPair.second,
-                                                         plane,
-                                                         truncMeanWireVec,
-                                                         truncRmsWireVec,
-                                                         minMaxWireVec,
-                                                         meanWireVec,
-                                                         skewnessWireVec,
-                                                         neighborRatioWireVec,
-                                                         pedCorWireVec,
-                                                         fftSize, halfFFTSize, lfftwp.fPlan, lfftwp.rPlan);
-                }
+                fCorCorrectAlg.removeCorrelatedNoise(groupToDigitIdxPairMap,
+                                                     plane,
+                                                     truncMeanWireVec,
+                                                     pedCorWireVec,
+                                                     *fBatchedFFT);
 
                 // One more pass through to store the good channels
                 for (size_t locWireIdx = 0; locWireIdx < fNumWiresToGroup[plane]; locWireIdx++)
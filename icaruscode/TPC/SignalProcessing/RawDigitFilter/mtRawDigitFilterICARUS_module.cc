@@ -20,7 +20,6 @@
 #include "larcore/Geometry/Geometry.h"
 #include "larevt/CalibrationDBI/Interface/DetPedestalService.h"
 #include "larevt/CalibrationDBI/Interface/DetPedestalProvider.h"
-#include "lardata/Utilities/LArFFTWPlan.h"
 #include "lardata/Utilities/LArFFTW.h"
 
 #include "icaruscode/TPC/SignalProcessing/RawDigitFilter/Algorithms/RawDigitNoiseFilterDefs.h"
@@ -29,6 +28,7 @@
 #include "icaruscode/TPC/SignalProcessing/RawDigitFilter/Algorithms/RawDigitCorrelatedCorrectionAlg.h"
 #include "icaruscode/TPC/SignalProcessing/RawDigitFilter/Algorithms/IRawDigitFilter.h"
 #include "icaruscode/TPC/SignalProcessing/RawDigitFilter/Algorithms/ChannelGroups.h"
+#include "icaruscode/TPC/SignalProcessing/RawDigitFilter/Algorithms/FFTWPlanPool.h"
 #include "icaruscode/TPC/Utilities/tools/IFilter.h"
 
 #include "lardataobj/RawData/RawDigit.h"
@@ -80,14 +80,14 @@ public:
     virtual void produce(art::Event & e, art::ProcessingFrame const& frame);
     virtual void beginJob(art::ProcessingFrame const& frame);
     virtual void endJob(art::ProcessingFrame const& frame);
-    void WaveformChar(unsigned int i, unsigned int& fDataSize, unsigned int& fftsize, void* fplan, void* rplan,
+    void WaveformChar(unsigned int i, unsigned int& fDataSize, unsigned int& fftsize, caldata::FFTWPlanPool::Transforms const& fftw,
                       vector<GroupWireDigIndx>& igwvec,
                       std::vector<const raw::RawDigit*>& rawDigitVec,
                       vector<vector<caldata::RawDigitVector>>& rawadcgvec,
                       vector<vector<WireChar>>& wgcvec,
                       vector<vector<vector <int>>>& wgqvec,
                       std::unique_ptr<std::vector<raw::RawDigit> >& filteredRawDigit)const;
-    void RemoveCorrelatedNoise(unsigned int igrp, unsigned int& fftSize, unsigned int& halfFFTSize, void* fplan, void* rplan,
+    void RemoveCorrelatedNoise(unsigned int igrp, unsigned int& fftSize, unsigned int& halfFFTSize, caldata::FFTWPlanPool::Transforms const& fftw,
                                vector<vector<caldata::RawDigitVector>>& rawadcgvec,
                                vector<vector<WireChar>>& wgcvec,
                                vector<vector<vector <int>>>& wgqvec,
@@ -143,6 +143,9 @@ private:
 
     // mwang added
     caldata::ChannelGroups fChannelGroups;
+
+    // FFTW plans and per-thread transform buffers, kept for the whole job
+    caldata::FFTWPlanPool  fFFTWPlanPool;
 };
 
 DEFINE_ART_MODULE(RawDigitFilterICARUS)
@@ -153,7 +156,7 @@ class lartbb_WaveformChar {
     lartbb_WaveformChar(RawDigitFilterICARUS const & prod,
       unsigned int & fdatasize,
       unsigned int & fftsize,
-      void* fplan, void* rplan,
+      caldata::FFTWPlanPool::Transforms const& fftw,
       vector<GroupWireDigIndx>& igwv,
       std::vector<const raw::RawDigit*>& rawdigitvec,
       vector<vector<caldata::RawDigitVector>>& rawadcgv,
@@ -163,8 +166,7 @@ class lartbb_WaveformChar {
       : prod(prod),
         fDataSize(fdatasize),
         fftSize(fftsize),
-        fplan(fplan),
-        rplan(rplan),
+        fftw(fftw),
         igwvec(igwv),
         rawDigitVec(rawdigitvec),
         rawadcgvec(rawadcgv),
@@ -174,14 +176,13 @@ class lartbb_WaveformChar {
     void operator()(const tbb::blocked_range<size_t>& range) const{
       //std::cout << " !!!!!!!!!! range.begin(): " << range.begin() << " and range.end(): " << range.end() << std::endl;
       for (size_t i = range.begin(); i < range.end(); ++i)
-        prod.WaveformChar(i, fDataSize, fftSize, fplan, rplan, igwvec, rawDigitVec, rawadcgvec, wgcvec, wgqvec, filteredRawDigit);
+        prod.WaveformChar(i, fDataSize, fftSize, fftw, igwvec, rawDigitVec, rawadcgvec, wgcvec, wgqvec, filteredRawDigit);
     }
   private:
     RawDigitFilterICARUS const & prod;
     unsigned int & fDataSize;
     unsigned int & fftSize;
-    void* fplan;
-    void* rplan;
+    caldata::FFTWPlanPool::Transforms const& fftw;
     vector<GroupWireDigIndx>& igwvec;
     std::vector<const raw::RawDigit*>& rawDigitVec;
     vector<vector<caldata::RawDigitVector>>& rawadcgvec;
@@ -196,7 +197,7 @@ class lartbb_RemoveCorrelatedNoise {
     lartbb_RemoveCorrelatedNoise(RawDigitFilterICARUS const & prod,
       unsigned int & fftsize,
       unsigned int & halffftsize,
-      void* fplan, void* rplan,
+      caldata::FFTWPlanPool::Transforms const& fftw,
       vector<vector<caldata::RawDigitVector>>& rawadcgv,
       vector<vector<WireChar>>& wgcv,
       vector<vector<vector <int>>>& wgqv,
@@ -204,22 +205,20 @@ class lartbb_RemoveCorrelatedNoise {
       : prod(prod),
         fftSize(fftsize),
         halfFFTSize(halffftsize),
-        fplan(fplan),
-        rplan(rplan),
+        fftw(fftw),
         rawadcgvec(rawadcgv),
         wgcvec(wgcv),
         wgqvec(wgqv),
         filteredRawDigit(filteredrawdigit){}
     void operator()(const tbb::blocked_range<size_t>& range) const{
       for (size_t i = range.begin(); i < range.end(); ++i)
-        prod.RemoveCorrelatedNoise(i, fftSize, halfFFTSize, fplan, rplan, rawadcgvec, wgcvec, wgqvec, filteredRawDigit);
+        prod.RemoveCorrelatedNoise(i, fftSize, halfFFTSize, fftw, rawadcgvec, wgcvec, wgqvec, filteredRawDigit);
     }
   private:
     RawDigitFilterICARUS const & prod;
     unsigned int & fftSize;
     unsigned int & halfFFTSize;
-    void* fplan;
-    void* rplan;
+    caldata::FFTWPlanPool::Transforms const& fftw;
     vector<vector<caldata::RawDigitVector>>& rawadcgvec;
     vector<vector<WireChar>>& wgcvec;
     vector<vector<vector <int>>>& wgqvec;
@@ -450,8 +449,8 @@ void RawDigitFilterICARUS::produce(art::Event & event, art::ProcessingFrame cons
         fFilterVec[plne] = fFilterToolMap.at(plne)->getResponseVec();
     }
 
-    // .. Now set up the fftw plan
-    util::LArFFTWPlan lfftwp(fftSize,"ES");
+    // .. Now recover the fftw plan (planned only on the first event) and the per-thread buffers
+    caldata::FFTWPlanPool::Transforms const& fftw = fFFTWPlanPool.get(fftSize);
 
     //int nwavedump = 0;
 
@@ -459,7 +458,7 @@ void RawDigitFilterICARUS::produce(art::Event & event, art::ProcessingFrame cons
     //  WaveformChar(i, fDataSize, igwvec, rawDigitVec, rawadcgvec, wgcvec, filteredRawDigit);
     //}
     // ... Launch multiple threads with TBB to do the waveform characterization and fft correction in parallel
-    auto func = lartbb_WaveformChar(*this, fDataSize, fftSize, lfftwp.fPlan, lfftwp.rPlan, igwvec, rawDigitVec,
+    auto func = lartbb_WaveformChar(*this, fDataSize, fftSize, fftw, igwvec, rawDigitVec,
                                     rawadcgvec, wgcvec, wgqvec, filteredRawDigit);
     tbb::parallel_for(tbb::blocked_range<size_t>(0, igwvec.size()), func);
 
@@ -471,9 +470,9 @@ void RawDigitFilterICARUS::produce(art::Event & event, art::ProcessingFrame cons
 
       // .. Loop over each group of wires
       //for (size_t igrp = 0; igrp < wgcvec.size(); igrp++) {
-      //  RemoveCorrelatedNoise(igrp, fftSize, halfFFTSize, lfftwp.fPlan, lfftwp.rPlan, rawadcgvec, wgcvec, wgqvec, filteredRawDigit);
+      //  RemoveCorrelatedNoise(igrp, fftSize, halfFFTSize, fftw, rawadcgvec, wgcvec, wgqvec, filteredRawDigit);
       //} // loop over igrp
-      auto func = lartbb_RemoveCorrelatedNoise(*this, fftSize, halfFFTSize, lfftwp.fPlan, lfftwp.rPlan,
+      auto func = lartbb_RemoveCorrelatedNoise(*this, fftSize, halfFFTSize, fftw,
                                                rawadcgvec, wgcvec, wgqvec, filteredRawDigit);
       tbb::parallel_for(tbb::blocked_range<size_t>(0, wgcvec.size()), func);
     } // if do and smooth correlated noise
@@ -496,7 +495,7 @@ void RawDigitFilterICARUS::produce(art::Event & event, art::ProcessingFrame cons
 }
 
 //----------------------------------------------------------------------------
-void RawDigitFilterICARUS::RemoveCorrelatedNoise(unsigned int igrp, unsigned int& fftSize, unsigned int& halfFFTSize, void* fplan, void* rplan,
+void RawDigitFilterICARUS::RemoveCorrelatedNoise(unsigned int igrp, unsigned int& fftSize, unsigned int& halfFFTSize, caldata::FFTWPlanPool::Transforms const& fftw,
                                                  vector<vector<caldata::RawDigitVector>>& rawadcgvec,
                                                  vector<vector<WireChar>>& wgcvec,
                                                  vector<vector<vector <int>>>& wgqvec,
@@ -589,7 +588,7 @@ void RawDigitFilterICARUS::RemoveCorrelatedNoise(unsigned int igrp, unsigned int
     // ... Get the FFT correction
     if (fApplyFFTCorrection) {
       std::vector<std::complex<double>> fftOutputVec(halfFFTSize);
-      util::LArFFTW lfftw(fftSize, fplan, rplan, 0);
+      util::LArFFTW& lfftw = fftw.local();
       lfftw.DoFFT(corValVec, fftOutputVec);
 
       std::vector<double> powerVec(halfFFTSize);
@@ -696,7 +695,7 @@ void RawDigitFilterICARUS::RemoveCorrelatedNoise(unsigned int igrp, unsigned int
 }
 
 //----------------------------------------------------------------------------
-void RawDigitFilterICARUS::WaveformChar(unsigned int i, unsigned int& fDataSize, unsigned int& fftSize, void* fplan, void* rplan,
+void RawDigitFilterICARUS::WaveformChar(unsigned int i, unsigned int& fDataSize, unsigned int& fftSize, caldata::FFTWPlanPool::Transforms const& fftw,
                                         vector<GroupWireDigIndx>& igwvec,
                                         std::vector<const raw::RawDigit*>& rawDigitVec,
                                         vector<vector<caldata::RawDigitVector>>& rawadcgvec,
@@ -737,7 +736,7 @@ void RawDigitFilterICARUS::WaveformChar(unsigned int i, unsigned int& fDataSize,
           filterVec[idx] = filterVecPlane[idx];
 
       // .. Do the correction
-      util::LArFFTW lfftw(fftSize, fplan, rplan, 0);
+      util::LArFFTW& lfftw = fftw.local();
       lfftw.Convolute(holder, filterVec);
 
       // .. Restore the pedestal
@@ -51,6 +51,7 @@
 #include "icaruscode/TPC/SignalProcessing/RecoWire/DeconTools/IROIFinder.h"
 #include "icaruscode/TPC/SignalProcessing/RecoWire/DeconTools/IDeconvolution.h"
 #include "icaruscode/TPC/SignalProcessing/RecoWire/DeconTools/IBaseline.h"
+#include "icaruscode/Utilities/StageTimers.h"
 #include "icarus_signal_processing/WaveformTools.h"
 
 #include "tbb/parallel_for.h"
@@ -72,7 +73,7 @@ class Decon1DROI : public art::ReplicatedProducer
     
     void produce(art::Event& evt, art::ProcessingFrame const&) override; 
  //   void beginJob() override;  
- //   void endJob() override;                 
+    void endJob(art::ProcessingFrame const&) override;
     void reconfigure(fhicl::ParameterSet const& p);
     
   private:
@@ -140,6 +141,14 @@ class Decon1DROI : public art::ReplicatedProducer
 
     icarus_signal_processing::WaveformTools<float>             fWaveformTool;
 
+    // Timing of the processing stages, shared by all the module replicas
+    std::shared_ptr<util::StageTimers>                         fStageTimers;
+    util::StageTimers::StageID_t                               fEventStage;                 ///< Whole event
+    util::StageTimers::StageID_t                               fChannelStage;               ///< Single channel, all steps
+    util::StageTimers::StageID_t                               fDeconvolveStage;            ///< Single channel deconvolution
+    util::StageTimers::StageID_t                               fROIStage;                   ///< Single channel ROI finding
+    util::StageTimers::StageID_t                               fStoreStage;                 ///< Sorting and storing of the wires
+
     const geo::GeometryCore*                                   fGeometry        = lar::providerFrom<geo::Geometry>();
     const lariov::ChannelStatusProvider*                       fChannelFilter   = lar::providerFrom<lariov::ChannelStatusService>();
     const lariov::DetPedestalProvider*                         fPedRetrievalAlg = lar::providerFrom<lariov::DetPedestalService>();
@@ -163,6 +172,13 @@ Decon1DROI::Decon1DROI(fhicl::ParameterSet const & pset, art::ProcessingFrame co
 {
     this->reconfigure(pset);
 
+    fStageTimers     = util::StageTimers::forModule(pset.get<std::string>("module_label"));
+    fEventStage      = fStageTimers->addStage("event");
+    fChannelStage    = fStageTimers->addStage("channel");
+    fDeconvolveStage = fStageTimers->addStage("deconvolution");
+    fROIStage        = fStageTimers->addStage("ROIfinding");
+    fStoreStage      = fStageTimers->addStage("store");
+
     // We create a separate output instance for each input instance
     for(const auto& rawDigit : fRawDigitLabelVec)
     {
@@ -251,15 +267,19 @@ void Decon1DROI::reconfigure(fhicl::ParameterSet const& pset)
 {
     fEventCount = 0;
 } // beginJob
+*/
 
 //////////////////////////////////////////////////////
-void Decon1DROI::endJob()
+void Decon1DROI::endJob(art::ProcessingFrame const&)
 {
-}*/
+    fStageTimers->report("Decon1DROI");
+}
   
 //////////////////////////////////////////////////////
 void Decon1DROI::produce(art::Event& evt, art::ProcessingFrame const& frame)
 {
+    auto const eventTimer = fStageTimers->time(fEventStage);
+
     // We loop over the collection of RawDigits in our input list
     // This is not done multi threaded as a way to cut down on overall job memory usage...
     for(const auto& rawDigitLabel : fRawDigitLabelVec)
@@ -312,6 +332,8 @@ void Decon1DROI::produce(art::Event& evt, art::ProcessingFrame const& frame)
             }
         }
     
+        auto const storeTimer = fStageTimers->time(fStoreStage);
+
         // Make sure the collection is sorted
         std::sort(wireCol->begin(), wireCol->end(), [](const auto& left, const auto& right){return left.Channel() < right.Channel();});
        
@@ -427,6 +449,8 @@ void  Decon1DROI::processChannel(size_t                                  idx,
                                  art::Assns<raw::RawDigit,recob::Wire>&  wireAssns,
                                  const std::string&                      instance) const
 {
+    auto const channelTimer = fStageTimers->time(fChannelStage);
+
     // vector that will be moved into the Wire object
     recob::Wire::RegionsOfInterest_t deconVec;
     recob::Wire::RegionsOfInterest_t ROIVec;
@@ -494,11 +518,15 @@ void  Decon1DROI::processChannel(size_t                                  idx,
     
     // Do the deconvolution on the full waveform
     auto const clockData = art::ServiceHandle<detinfo::DetectorClocksService const>()->DataFor(event);
+    auto deconvolveTimer = fStageTimers->time(fDeconvolveStage);
     fDeconvolution->Deconvolve(rawAdcLessPedVec, sampling_rate(clockData), channel, deconROIVec, deconVec);
+    deconvolveTimer.stop();
     
     // Recover the deconvolved waveform
     const std::vector<float>& deconvolvedWaveform = deconVec.get_ranges().front().data();
 
+    auto roiTimer = fStageTimers->time(fROIStage);
+
     // vector of candidate ROI begin and end bins
     icarus_tool::IROIFinder::CandidateROIVec candRoiVec;
     
@@ -527,6 +555,8 @@ void  Decon1DROI::processChannel(size_t                                  idx,
         ROIVec.add_range(candROI.first, std::move(holder));
     }
 
+    roiTimer.stop();
+
     // Make some histograms?
     if (fOutputHistograms)
     {
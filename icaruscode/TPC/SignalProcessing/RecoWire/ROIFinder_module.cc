@@ -67,8 +67,8 @@ struct PlaneWireData
     std::size_t size() const { return wires.size(); }
     void resize(std::size_t nWires)
     { wires.clear(); wires.resize(nWires, nullptr); }
-    void addWire(std::size_t iWire, recob::Wire const& wire)
-    { wires.at(iWire) = &wire; }
+    void addWire(std::size_t iWire, recob::Wire const* wire)
+    { wires.at(iWire) = wire; }
     icarus_signal_processing::ArrayFloat operator() () const
     {
         icarus_signal_processing::ArrayFloat data;
@@ -284,7 +284,6 @@ void ROIFinder::produce(art::Event& evt)
         // The first step is to break up into groups by logical TPC/plane in order to do the parallel loop
         PlaneIDToDataPairMap planeIDToDataPairMap;
         PlaneIDVec           planeIDVec;
-        size_t               numChannels(0);
     
         for(const auto& wire : *wireVecHandle)
         {
@@ -319,39 +318,29 @@ void ROIFinder::produce(art::Event& evt)
     
                 // Add waveform to the 2D array
                 mapItr->second.first[wireID.Wire] = channel;
-                mapItr->second.second.addWire(wireID.Wire, wire);
-                numChannels++;
+                mapItr->second.second.addWire(wireID.Wire, &wire);
             }
         }
 
-        // We might need this... it allows a temporary wire object to prevent crashes when some data is missing
-        std::vector<recob::Wire> tempWireVec(numChannels/4);
-
         // Check integrity of map
         for(auto& mapInfo : planeIDToDataPairMap)
         {
-            const std::vector<raw::ChannelID_t>&        channelVec = mapInfo.second.first;
-            const icarus_signal_processing::ArrayFloat& dataArray  = mapInfo.second.second();
+            const std::vector<raw::ChannelID_t>& channelVec = mapInfo.second.first;
+            const PlaneWireData&                 wireData   = mapInfo.second.second;
 
             for(size_t idx = 0; idx < channelVec.size(); idx++)
             {
-                if (dataArray[idx].size() < 100) 
-                {
-                    mf::LogInfo("ROIFinder") << "  **> Found truncated wire, size: " << dataArray[idx].size() << ", channel: " << channelVec[idx] << std::endl;
-
-                    std::vector<float>               zeroVec(4096,0.);
-                    recob::Wire::RegionsOfInterest_t ROIVec;
-
-                    ROIVec.add_range(0, std::move(zeroVec));
+                const recob::Wire* wire = wireData.getWirePtr(idx);
 
-                    std::vector<geo::WireID> wireIDVec = fGeometry->ChannelToWire(channelVec[idx]);
+                if (wire && wire->NSignal() < 100) 
+                {
+                    mf::LogInfo("ROIFinder") << "  **> Found truncated wire, size: " << wire->NSignal() << ", channel: " << channelVec[idx] << std::endl;
 
                     // Given channel a large number so we know to not save
                     mapInfo.second.first[idx] = 100000 + idx;
 
-                    tempWireVec.emplace_back(recob::WireCreator(std::move(ROIVec),idx,fGeometry->View(wireIDVec[0].planeID())).move());
-
-                    mapInfo.second.second.addWire(idx,tempWireVec.back());
+                    // Its waveform will be all zeroes
+                    mapInfo.second.second.addWire(idx,nullptr);
                }
             }
         }
@@ -409,15 +398,13 @@ void  ROIFinder::processPlane(size_t                          idx,
 
     fROIToolMap.at(planeID.Plane)->FindROIs(event, dataArray, channelVec, mapItr->first, outputArray, selectedVals);
 
-//    icarus_signal_processing::ArrayFloat morphedWaveforms(dataArray.size());
-
     // Copy the "morphed" array
     if (fOutputMorphed)
     {
         for(size_t waveIdx = 0; waveIdx < outputArray.size(); waveIdx++)
         {
             // skip if a bad channbel
-            if (channelVec[idx] >= 100000) continue;
+            if (channelVec[waveIdx] >= 100000) continue;
 
             // First get a lock to make sure we don't conflict
             tbb::spin_mutex::scoped_lock lock(roifinderSpinMutex);
@@ -123,7 +123,7 @@ void ROIFromDecoder::FindROIs(const art::Event& event, const ArrayFloat& inputIm
             {
                 if (wireID.asPlaneID() != planeID) continue;
 
-                if (wireID.Wire > outputROIs.size())
+                if (wireID.Wire >= outputROIs.size())
                 {
                     std::cout << "#################################### Wire out of bounds! Wire: " << wireID.Wire << ", max: " << outputROIs.size() << " #################" << std::endl;
                     continue;
@@ -19,6 +19,8 @@
 #include <functional>
 #include <random>
 #include <chrono>
+#include <numeric> // std::accumulate()
+#include <limits>
 
 // ROOT libraries
 #include "TMath.h"
@@ -40,6 +42,11 @@
 #include "art/Utilities/make_tool.h"
 #include "fhiclcpp/ParameterSet.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
+#include "art/Utilities/Globals.h"
+
+#include "tbb/parallel_for.h"
+#include "tbb/blocked_range.h"
+#include "tbb/task_arena.h"
 
 // art extensions
 #include "nurandom/RandomUtils/NuRandomService.h"
@@ -82,7 +89,37 @@ public:
     void reconfigure(fhicl::ParameterSet const& p);
     
 private:
-    
+
+    // Working space for one thread
+    struct ThreadBuffers
+    {
+        std::unique_ptr<icarus_signal_processing::ICARUSFFT<double>> fFFT;  ///< FFT for this thread
+        std::vector<short>                                            adcvec;
+        icarusutil::TimeVec                                           chargeWork;
+    };
+
+    using SimChannelTable = std::vector<const sim::SimChannel*>;
+
+    // Response, gain and pedestal of a channel to overlay, from the services
+    struct ChannelResponse
+    {
+        const sim::SimChannel*         simChan  = nullptr;  ///< SimChannel to overlay (nullptr if none)
+        const icarus_tool::IResponse*  response = nullptr;  ///< Response functions of the channel
+        double                         gain     = 0.;       ///< ASIC gain, in electrons per tick
+        int                            tOffset  = 0;        ///< Time offset of the response [ticks]
+        float                          pedestal = 0.;       ///< Pedestal mean
+    };
+
+    using ChannelResponseVec = std::vector<ChannelResponse>;
+
+    // Overlays a block of input RawDigits into the preallocated output slots
+    void overlayChannels(const tbb::blocked_range<size_t>&         range,
+                         detinfo::DetectorClocksData const&        clockData,
+                         const std::vector<raw::RawDigit>&         inputRawDigits,
+                         const ChannelResponseVec&                 channelResponses,
+                         std::vector<raw::RawDigit>&               outputRawDigits,
+                         std::vector<short>&                       areaVec) const;
+
     void MakeADCVec(std::vector<short>& adc, icarusutil::TimeVec const& charge, float ped_mean) const;
     
     art::InputTag                fInputRawDataLabel; ///< Label for the underlying raw digit data
@@ -90,6 +127,7 @@ private:
     raw::Compress_t              fCompression;       ///< compression type to use
         
     bool                         fMakeHistograms;
+    size_t                       fChannelBlockSize;  ///< Number of channels each task processes at once
 
     TH1F*                        fSimCharge;
     TH2F*                        fSimChargeWire;
@@ -109,8 +147,11 @@ private:
         size_t m_time;
     };
 
-    using FFTPointer = std::unique_ptr<icarus_signal_processing::ICARUSFFT<double>>;
-    FFTPointer                              fFFT;                   //< Object to handle thread safe FFT
+    std::vector<std::unique_ptr<ThreadBuffers>> fThreadBuffersVec;  //< Working buffers (and FFT), one per thread
+
+    // Plane of each channel (-1 for channels not connected to a wire), and first wire of it
+    std::vector<int>                        fChannelToPlane;
+    std::vector<unsigned int>               fChannelToWire;
     
     //services
     const geo::GeometryCore&                fGeometry;
@@ -148,9 +189,33 @@ void OverlayICARUS::reconfigure(fhicl::ParameterSet const& p)
     //detector properties information
     auto const detprop = art::ServiceHandle<detinfo::DetectorPropertiesService>()->DataForJob();
     
+    fMakeHistograms    = p.get< bool          >("MakeHistograms",         false);
+    fChannelBlockSize  = p.get< size_t        >("ChannelBlockSize",          64);
+
     fSignalShapingService = art::ServiceHandle<icarusutil::SignalShapingICARUSService>{}.get();
 
-    fFFT = std::make_unique<icarus_signal_processing::ICARUSFFT<double>>(detprop.NumberTimeSamples());
+    // Each thread gets its own FFT and working buffers
+    fThreadBuffersVec.resize(art::Globals::instance()->nthreads());
+
+    for(auto& threadBuffers : fThreadBuffersVec)
+    {
+        threadBuffers = std::make_unique<ThreadBuffers>();
+        threadBuffers->fFFT = std::make_unique<icarus_signal_processing::ICARUSFFT<double>>(detprop.NumberTimeSamples());
+    }
+
+    // Dense channel to plane/wire lookup, so the event loop does not query the geometry
+    fChannelToPlane.assign(fGeometry.Nchannels(), -1);
+    fChannelToWire.assign(fGeometry.Nchannels(), 0);
+
+    for(raw::ChannelID_t channel = 0; channel < fGeometry.Nchannels(); channel++)
+    {
+        std::vector<geo::WireID> widVec = fGeometry.ChannelToWire(channel);
+
+        if (widVec.empty()) continue;
+
+        fChannelToPlane[channel] = widVec[0].Plane;
+        fChannelToWire[channel]  = widVec[0].Wire;
+    }
     
     return;
 }
@@ -192,65 +257,120 @@ void OverlayICARUS::produce(art::Event& evt)
 
     if (!simChanHandle.isValid()) throw std::runtime_error("Failed to recover the SimChannel information for the overlay");
 
-    // Keep track of the SimChannel information by channel
-    using SimChannelMap = std::unordered_map<raw::ChannelID_t, const sim::SimChannel*>;
-
-    SimChannelMap simChannelMap;
+    // Keep track of the SimChannel information by channel, in a table indexed by channel
+    SimChannelTable simChannelTable(fChannelToPlane.size(), nullptr);
         
-    for(const auto& simChannel : *simChanHandle) simChannelMap[simChannel.Channel()] = &simChannel;
+    for(const auto& simChannel : *simChanHandle)
+    {
+        if (simChannel.Channel() < simChannelTable.size()) simChannelTable[simChannel.Channel()] = &simChannel;
+    }
     
     // make a unique_ptr of sim::SimDigits that allows ownership of the produced
-    // digits to be transferred to the art::Event after the put statement below
-    std::unique_ptr< std::vector<raw::RawDigit>> digcol(new std::vector<raw::RawDigit>);
-    digcol->reserve(inputRawDigitHandle->size());
-    
-    // vectors for working in the following for loop
-    std::vector<short>  adcvec;
-    icarusutil::TimeVec zeroCharge;
+    // digits to be transferred to the art::Event after the put statement below;
+    // each input RawDigit has its own slot, so the output keeps the input order
+    const std::vector<raw::RawDigit>& inputRawDigits = *inputRawDigitHandle;
+
+    std::unique_ptr< std::vector<raw::RawDigit>> digcol(new std::vector<raw::RawDigit>(inputRawDigits.size()));
+
+    // Collection plane areas for the histograms, filled after the parallel loop
+    std::vector<short> areaVec(fMakeHistograms ? inputRawDigits.size() : 0, std::numeric_limits<short>::min());
     
     //detector properties information
     auto const clockData = art::ServiceHandle<detinfo::DetectorClocksService>()->DataFor(evt);
+
+    // Need the to convert from deposited number of electrons to ADC units
+    double samplingRate = sampling_rate(clockData) * 1.e-3; // Gain returned is electrons/us, this converts to electrons/tick
+
+    // The signal shaping service and the pedestal provider are not guaranteed to be
+    // thread safe, so everything needed from them is looked up here, before the parallel loop
+    ChannelResponseVec channelResponses(inputRawDigits.size());
+
+    for(size_t idx = 0; idx < inputRawDigits.size(); idx++)
+    {
+        raw::ChannelID_t channel = inputRawDigits[idx].Channel();
+
+        // We skip channels that are not connected to a physical wire or without a SimChannel
+        if (channel >= fChannelToPlane.size() || fChannelToPlane[channel] < 0 || !simChannelTable[channel]) continue;
+
+        ChannelResponse& channelResponse = channelResponses[idx];
+
+        channelResponse.simChan  = simChannelTable[channel];
+        channelResponse.response = &fSignalShapingService->GetResponse(channel);
+        channelResponse.gain     = fSignalShapingService->GetASICGain(channel) * samplingRate;
+        channelResponse.tOffset  = fSignalShapingService->ResponseTOffset(channel);
+        channelResponse.pedestal = fPedestalRetrievalAlg.PedMean(channel);
+    }
     
-    // The outer loop is over the input RawDigits which will always be written out
-    for(const auto& rawDigit : *inputRawDigitHandle)        
+    // The outer loop is over the input RawDigits which will always be written out, in blocks of channels
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, inputRawDigits.size(), fChannelBlockSize),
+                      [&](const tbb::blocked_range<size_t>& range)
+                      {overlayChannels(range, clockData, inputRawDigits, channelResponses, *digcol, areaVec);});
+
+    if (fMakeHistograms)
+    {
+        for(size_t idx = 0; idx < inputRawDigits.size(); idx++)
+        {
+            short area = areaVec[idx];
+
+            if(area>0)
+            {
+                fSimCharge->Fill(area);
+                fSimChargeWire->Fill(fChannelToWire[inputRawDigits[idx].Channel()],area);
+            }
+        }
+    }
+    
+    evt.put(std::move(digcol));
+    
+    return;
+}
+
+//-------------------------------------------------
+void OverlayICARUS::overlayChannels(const tbb::blocked_range<size_t>&         range,
+                                    detinfo::DetectorClocksData const&        clockData,
+                                    const std::vector<raw::RawDigit>&         inputRawDigits,
+                                    const ChannelResponseVec&                 channelResponses,
+                                    std::vector<raw::RawDigit>&               outputRawDigits,
+                                    std::vector<short>&                       areaVec) const
+{
+    // Recover the working buffers for this thread
+    ThreadBuffers& threadBuffers = *fThreadBuffersVec[tbb::this_task_arena::current_thread_index()];
+
+    // vectors for working in the following for loop
+    std::vector<short>&  adcvec     = threadBuffers.adcvec;
+    icarusutil::TimeVec& chargeWork = threadBuffers.chargeWork;
+
+    for(size_t idx = range.begin(); idx < range.end(); idx++)
     {
+        const raw::RawDigit& rawDigit = inputRawDigits[idx];
+
         // Recover the channel
         raw::ChannelID_t channel = rawDigit.Channel();
             
         //use channel number to set some useful numbers
-        std::vector<geo::WireID> widVec = fGeometry.ChannelToWire(channel);
+        int plane = channel < fChannelToPlane.size() ? fChannelToPlane[channel] : -1;
 
-        // We skip channels that are not connected to a physical wire
-        if (!widVec.empty())
-        {
-            size_t plane = widVec[0].Plane;    
+        // Make sure local vector is correct size (and note the vector above may be compressed so can't use its size yet)
+        adcvec.resize(rawDigit.Samples(),0);
 
-            // Recover the ADC values and copy to local vector
-            const raw::RawDigit::ADCvector_t& adcVector = rawDigit.ADCs();
+        // and do the copyh
+        raw::Uncompress(rawDigit.ADCs(), adcvec, rawDigit.Compression());
 
-            // Make sure local vector is correct size (and note the vector above may be compressed so can't use its size yet)
-            adcvec.resize(rawDigit.Samples(),0);
-            zeroCharge.resize(rawDigit.Samples(),0);
-
-            // and do the copyh
-            raw::Uncompress(adcVector, adcvec, rawDigit.Compression());
+        // We skip channels that are not connected to a physical wire
+        if (plane >= 0)
+        {
+            // Response, gain and pedestal were looked up before the parallel loop (if there is a SimChannel)
+            const ChannelResponse& channelResponse = channelResponses[idx];
 
             // Check for the existence of a SimChannel for this channel
-            SimChannelMap::const_iterator simChanItr = simChannelMap.find(channel);
+            const sim::SimChannel* simChan = channelResponse.simChan;
 
-            if (simChanItr != simChannelMap.end())
+            if (simChan)
             {
-                // Recover the response function information for this channel
-                const icarus_tool::IResponse& response = fSignalShapingService->GetResponse(channel);
-
-                // Recover the SimChannel (if one) for this channel
-                const sim::SimChannel* simChan = simChanItr->second;
-
                 // Allocate local vector to hold the deposited charge
-                icarusutil::TimeVec chargeWork(adcvec.size(),0.);
+                chargeWork.assign(adcvec.size(),0.);
 
-                // Need the to convert from deposited number of electrons to ADC units
-                double gain = fSignalShapingService->GetASICGain(channel) * sampling_rate(clockData) * 1.e-3; // Gain returned is electrons/us, this converts to electrons/tick
+                double gain = channelResponse.gain;
 
                 // Loop through the simchannel energy deposits
                 for(const auto& tdcide : simChan->TDCIDEMap())
@@ -261,40 +381,36 @@ void OverlayICARUS::produce(art::Event& evt)
                     int tick = clockData.TPCTDC2Tick(tdc);
 
                     // If out of range what is right thing to do?
-                    if (tick < 0 ||tick > int(adcvec.size()))
+                    if (tick < 0 ||tick >= int(adcvec.size()))
                     {
-                        std::cout << "tick out of range: " << tick << ", tdc: " << tdc << std::endl;
+                        mf::LogDebug("OverlayICARUS") << "tick out of range: " << tick << ", tdc: " << tdc;
                         continue;
                     }
 
-                    // Recover the charge for this tick
-                    double charge = simChan->Charge(tdc);
+                    // Recover the charge for this tick directly from the IDEs at hand
+                    double charge = std::accumulate(tdcide.second.begin(),tdcide.second.end(),0.,[](double sum, const auto& ide){return sum + ide.numElectrons;});
 
                     chargeWork[tick] += charge / gain;
                 }
 
                 // now we have the tempWork for the adjacent wire of interest
                 // convolve it with the appropriate response function
-                fFFT->convolute(chargeWork, response.getConvKernel(), fSignalShapingService->ResponseTOffset(channel));
-
-                //Get the pedestal and rms from the input waveform
-                float pedestal = fPedestalRetrievalAlg.PedMean(channel);
+                threadBuffers.fFFT->convolute(chargeWork, channelResponse.response->getConvKernel(), channelResponse.tOffset);
 
                 // "Make" the ADC vector
-                MakeADCVec(adcvec, chargeWork, pedestal);
+                MakeADCVec(adcvec, chargeWork, channelResponse.pedestal);
             }
         
             if(fMakeHistograms && plane==2)
             {
-                short area = std::accumulate(adcvec.begin(),adcvec.end(),0,[](const auto& val,const auto& sum){return sum + val - 400;});
-            
-                if(area>0)
-                {
-                    fSimCharge->Fill(area);
-                    fSimChargeWire->Fill(widVec[0].Wire,area);
-                }
+                areaVec[idx] = std::accumulate(adcvec.begin(),adcvec.end(),0,[](const auto& val,const auto& sum){return sum + val - 400;});
             }
         }
+
+        // compress the adc vector using the desired compression scheme,
+        // if raw::kNone is selected nothing happens to adcvec
+        // This shrinks adcvec, if fCompression is not kNone.
+        raw::Compress(adcvec, fCompression);
             
         // add this digit to the collection;
         // adcvec is copied, not moved: in case of compression, adcvec will show
@@ -303,16 +419,16 @@ void OverlayICARUS::produce(art::Event& evt)
         // is still there, although unused; a copy of adcvec will instead have
         // only 5000 items. All 9600 items of adcvec will be recovered for free
         // and used on the next loop.
-        raw::RawDigit rd(channel, adcvec.size(), adcvec, fCompression);
+        raw::RawDigit& rd = outputRawDigits[idx];
+
+        rd = raw::RawDigit(channel, rawDigit.Samples(), adcvec, fCompression);
         
         rd.SetPedestal(rawDigit.GetPedestal(),rawDigit.GetSigma());
-        digcol->push_back(std::move(rd)); // we do move the raw digit copy, though
     }
-    
-    evt.put(std::move(digcol));
-    
+
     return;
 }
+
 //-------------------------------------------------
 void OverlayICARUS::MakeADCVec(std::vector<short>& adcvec, icarusutil::TimeVec const& chargevec, float ped_mean) const
 {
@@ -327,10 +443,6 @@ void OverlayICARUS::MakeADCVec(std::vector<short>& adcvec, icarusutil::TimeVec c
         // Remove the temporary offset while we add the signal to the existing vector. 
         adcvec[i] += std::round(adcval - ped_mean);
     }// end loop over signal size
-    // compress the adc vector using the desired compression scheme,
-    // if raw::kNone is selected nothing happens to adcvec
-    // This shrinks adcvec, if fCompression is not kNone.
-    raw::Compress(adcvec, fCompression);
     
     return;
 }
@@ -29,6 +29,7 @@
 // C/C++ standard libraries
 #include <optional>
 #include <memory> // std::unique_ptr<>
+#include <cstddef> // std::size_t
 #include <string>
 #include <utility> // std::move()
 
@@ -131,6 +132,9 @@ private:
 
   bool const fCorrectCosmics;
 
+  /// Corrections to apply (bit mask).
+  icarusDB::PMTTimingCorrections::CorrectionMask_t const fCorrections;
+
   bool const fVerbose = false; ///< Whether to print the configuration we read.
   
   std::string const fLogCategory; ///< Category tag for messages.
@@ -148,6 +152,10 @@ icarus::OpHitTimingCorrection::OpHitTimingCorrection
     , fInputLabels{ config().InputLabels() }
     , fCorrectLaser{ config().CorrectLaser() }
     , fCorrectCosmics{ config().CorrectCosmics() }
+    , fCorrections{
+        (fCorrectLaser? icarusDB::PMTTimingCorrections::LaserCorr: 0U)
+        | (fCorrectCosmics? icarusDB::PMTTimingCorrections::CosmicsCorr: 0U)
+      }
     , fVerbose{ config().Verbose() }
     , fLogCategory{ config().LogCategory() }
     , fPMTTimingCorrectionsService
@@ -194,56 +202,19 @@ void icarus::OpHitTimingCorrection::produce( art::Event& event, art::ProcessingF
         
         auto const& opHits = event.getProduct<std::vector<recob::OpHit>>(label);
 
-        for(  auto const & opHit : opHits  ){
-
-            double peakTime = opHit.PeakTime();
-            double peakTimeAbs = opHit.PeakTimeAbs();
-            double startTime = opHit.StartTime();
-            double riseTime = opHit.RiseTime();
-
-            double laserTimeCorrection=0;
-            double cosmicsCorrection=0;
-
-            if( fCorrectLaser ){
-                laserTimeCorrection = 
-                    fPMTTimingCorrectionsService.getLaserCorrections(opHit.OpChannel());
-            }
-
-            if( fCorrectLaser && fCorrectCosmics ){
-
-                cosmicsCorrection = 
-                    fPMTTimingCorrectionsService.getCosmicsCorrections(opHit.OpChannel());
-            }
+        std::size_t const firstHit = correctedOpHits.size();
+        fPMTTimingCorrectionsService.correctOpHits
+            (opHits, correctedOpHits, fCorrections);
 
-            double const totalCorrection = laserTimeCorrection + cosmicsCorrection;
-            peakTime += totalCorrection;
-            peakTimeAbs += totalCorrection;
-            startTime += totalCorrection;
-            // riseTime is currently relative to the start time, no correction needed
-            
-            if(log){
-                *log << opHit.OpChannel() << ", " 
+        if(log){
+            for( std::size_t iHit = 0; iHit < opHits.size(); ++iHit ){
+                recob::OpHit const& opHit = opHits[iHit];
+                *log << "\n" << opHit.OpChannel() << ", " 
                      << opHit.PeakTime() << ", " 
-                     << peakTime << ", " 
-                     << cosmicsCorrection << ", " 
-                     << laserTimeCorrection
-                     << totalCorrection;
+                     << correctedOpHits[firstHit + iHit].PeakTime() << ", " 
+                     << (fCorrectCosmics? fPMTTimingCorrectionsService.getCosmicsCorrections(opHit.OpChannel()): 0.0) << ", " 
+                     << (fCorrectLaser? fPMTTimingCorrectionsService.getLaserCorrections(opHit.OpChannel()): 0.0);
             }
-
-
-            correctedOpHits.emplace_back(
-                opHit.OpChannel(),   // channel
-                peakTime,            // peaktime
-                peakTimeAbs,         // peaktimeabs
-                startTime,           // starttime
-                riseTime,            // risetime
-                opHit.Frame(),       // frame
-                opHit.Width(),       // width
-                opHit.Area(),        // area
-                opHit.Amplitude(),   // peakheight
-                opHit.PE(),          // pe
-                opHit.FastToTotal()  // fasttototal
-            );
         }
 
     }
@@ -7,11 +7,15 @@
 #include "icaruscode/Timing/IPMTTimingCorrectionService.h"
 #include "icaruscode/Timing/PMTTimingCorrectionsProvider.h"
 
+// LArSoft libraries
+#include "larcore/Geometry/Geometry.h"
+
 // framework libraries
 #include "art/Framework/Principal/Run.h"
 #include "art/Framework/Services/Registry/ActivityRegistry.h"
 #include "art/Framework/Services/Registry/ServiceDefinitionMacros.h"
 #include "art/Framework/Services/Registry/ServiceDeclarationMacros.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
 #include "fhiclcpp/ParameterSet.h"
 #include "cetlib_except/exception.h"
 
@@ -39,7 +43,8 @@ class icarusDB::PMTTimingCorrectionService
 // -----------------------------------------------------------------------------
 icarusDB::PMTTimingCorrectionService::PMTTimingCorrectionService
   (const fhicl::ParameterSet& pset, art::ActivityRegistry& reg)
-  : PMTTimingCorrectionsProvider(pset)
+  : PMTTimingCorrectionsProvider
+    (pset, art::ServiceHandle<geo::Geometry const>()->NOpChannels())
 {
   reg.sPreBeginRun.watch(this, &PMTTimingCorrectionService::preBeginRun);
 }
@@ -15,16 +15,28 @@
 
 
 #include "larcorealg/CoreUtils/UncopiableAndUnmovableClass.h"
+#include "lardataobj/RawData/OpDetWaveform.h"
+#include "lardataobj/RecoBase/OpHit.h"
 
 #include "art/Framework/Services/Registry/ServiceDeclarationMacros.h"
 #include "art/Framework/Principal/Run.h"
 
+#include <vector>
+
 namespace icarusDB {
 
 	class PMTTimingCorrections: lar::UncopiableClass
 	{
 		public: 
 			
+			/// Bit mask selecting which corrections to apply in the batch methods.
+			using CorrectionMask_t = unsigned int;
+			
+			static constexpr CorrectionMask_t TriggerCableCorr = 0x1; ///< Trigger cable delay.
+			static constexpr CorrectionMask_t ResetCableCorr   = 0x2; ///< PPS reset cable delay.
+			static constexpr CorrectionMask_t LaserCorr        = 0x4; ///< Laser corrections.
+			static constexpr CorrectionMask_t CosmicsCorr      = 0x8; ///< Cosmics corrections.
+			
 			virtual ~PMTTimingCorrections() noexcept = default;
 			
 			virtual double getTriggerCableDelay( unsigned int channelID ) const = 0;
@@ -35,6 +47,20 @@ namespace icarusDB {
 
 			virtual double getCosmicsCorrections( unsigned int channelID ) const = 0;
 
+			/// Appends to `corrected` a copy of `hits` with the selected corrections
+			/// added to their start and peak times.
+			virtual void correctOpHits(
+				std::vector<recob::OpHit> const& hits,
+				std::vector<recob::OpHit>& corrected,
+				CorrectionMask_t corrections
+				) const = 0;
+
+			/// Adds the selected corrections to the time stamp of all `waveforms`.
+			virtual void correctWaveforms(
+				std::vector<raw::OpDetWaveform>& waveforms,
+				CorrectionMask_t corrections
+				) const = 0;
+
 	}; // end class
 
 }// end of namespace
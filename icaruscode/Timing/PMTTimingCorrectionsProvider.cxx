@@ -25,8 +25,9 @@
 //--------------------------------------------------------------------------------
 
 icarusDB::PMTTimingCorrectionsProvider::PMTTimingCorrectionsProvider
-    (const fhicl::ParameterSet& pset) 
-    : fVerbose{ pset.get<bool>("Verbose", false) }
+    (const fhicl::ParameterSet& pset, unsigned int nChannels) 
+    : fNChannels{ nChannels }
+    , fVerbose{ pset.get<bool>("Verbose", false) }
     , fLogCategory{ pset.get<std::string>("LogCategory", "PMTTimingCorrection") }
     { 
         fhicl::ParameterSet const tags{ pset.get<fhicl::ParameterSet>("CorrectionTags") };
@@ -60,7 +61,8 @@ uint64_t icarusDB::PMTTimingCorrectionsProvider::RunToDatabaseTimestamp( uint32_
 // -------------------------------------------------------------------------------
 
 /// Function to look up the calibration database at the table holding the pmt hardware cables corrections
-void icarusDB::PMTTimingCorrectionsProvider::ReadPMTCablesCorrections( uint32_t run ) { 
+void icarusDB::PMTTimingCorrectionsProvider::ReadPMTCablesCorrections
+    ( uint32_t run, CorrectionTable_t& table ) const { 
 
     // pmt_cables_delay: delays of the cables relative to trigger 
     // and reset distribution
@@ -107,7 +109,7 @@ void icarusDB::PMTTimingCorrectionsProvider::ReadPMTCablesCorrections( uint32_t
         /// It can be absorbed within other corrections if necessary
         /// Corrections are saved in ns, but icaruscode wants us
         /// Correction are saved with the sing correspoding to their time direction 
-        fDatabaseTimingCorrections[channel].triggerCableDelay = -(trigger_reference_delay-phase_correction)/1000.;
+        channelEntry(table, channel).triggerCableDelay = -(trigger_reference_delay-phase_correction)/1000.;
 
         /// This is the delay along the distribution line of the TTT reset
         /// The phase correction is an additional fudge factor 
@@ -115,7 +117,7 @@ void icarusDB::PMTTimingCorrectionsProvider::ReadPMTCablesCorrections( uint32_t
         /// It can be absorbed within other corrections if necessary
         /// Corrections are saved in ns, but icaruscode wants us
         /// Corrections are additive! 
-        fDatabaseTimingCorrections[channel].resetCableDelay = (reset_distribution_delay-phase_correction)/1000.; 
+        channelEntry(table, channel).resetCableDelay = (reset_distribution_delay-phase_correction)/1000.; 
     }
 
 }
@@ -124,7 +126,8 @@ void icarusDB::PMTTimingCorrectionsProvider::ReadPMTCablesCorrections( uint32_t
 // -----------------------------------------------------------------------------
 
 /// Function to look up the calibration database at the table holding the pmt timing corrections measured using the laser
-void icarusDB::PMTTimingCorrectionsProvider::ReadLaserCorrections( uint32_t run ) { 
+void icarusDB::PMTTimingCorrectionsProvider::ReadLaserCorrections
+    ( uint32_t run, CorrectionTable_t& table ) const { 
 
     const std::string dbname("pmt_laser_timing_data");
     lariov::DBFolder db(dbname, "", "", fLaserTag, true, false);
@@ -157,14 +160,15 @@ void icarusDB::PMTTimingCorrectionsProvider::ReadLaserCorrections( uint32_t run
         /// and the PMT signal cable 
         /// corrections are saved in ns, but icaruscode wants us
         /// Corrections are additive! 
-        fDatabaseTimingCorrections[channel].laserCableDelay = -t_signal/1000.; 
+        channelEntry(table, channel).laserCableDelay = -t_signal/1000.; 
     }
 }
 
 // -----------------------------------------------------------------------------
 
 /// Function to look up the calibration database at the table holding the pmt timing corrections measured using cosmic muons
-void icarusDB::PMTTimingCorrectionsProvider::ReadCosmicsCorrections( uint32_t run ) { 
+void icarusDB::PMTTimingCorrectionsProvider::ReadCosmicsCorrections
+    ( uint32_t run, CorrectionTable_t& table ) const { 
 
     const std::string dbname("pmt_cosmics_timing_data");
     lariov::DBFolder db(dbname, "", "", fCosmicsTag, true, false);
@@ -197,7 +201,7 @@ void icarusDB::PMTTimingCorrectionsProvider::ReadCosmicsCorrections( uint32_t ru
         /// correcting for point-like laser emission and pmts that do not see laser light
         /// corrections are saved in ns, but icaruscode wants us
         /// Corrections are additive! 
-        fDatabaseTimingCorrections[channel].cosmicsCorrections = -mean_residual_ns/1000.; 
+        channelEntry(table, channel).cosmicsCorrections = -mean_residual_ns/1000.; 
     }
 
 }
@@ -206,24 +210,40 @@ void icarusDB::PMTTimingCorrectionsProvider::ReadCosmicsCorrections( uint32_t ru
 // -----------------------------------------------------------------------------
 
 
-/// Read all the corrections from the database and save them inside a map, whose index 
-/// is the PMT channel number
-void icarusDB::PMTTimingCorrectionsProvider::readTimeCorrectionDatabase(const art::Run& run){
+auto icarusDB::PMTTimingCorrectionsProvider::channelEntry
+    (CorrectionTable_t& table, unsigned int channel) const -> PMTTimeCorrectionsDB&
+{
+    // the table is sized for all the PMT channels (see `readRunCorrections()`)
+    if( channel >= table.size() ) {
+        throw cet::exception("PMTTimingCorrectionsProvider")
+          << "The database has corrections for channel " << channel
+          << ", but there are only " << table.size() << " PMT channels.\n";
+    }
+    return table[channel];
+}
 
-    // Clear before the run
-    fDatabaseTimingCorrections.clear();
 
-    ReadPMTCablesCorrections(run.id().run());
-    ReadLaserCorrections(run.id().run());
-    ReadCosmicsCorrections(run.id().run());
+// -----------------------------------------------------------------------------
+
+/// Read all the corrections for a run from the database into a table, whose index 
+/// is the PMT channel number
+auto icarusDB::PMTTimingCorrectionsProvider::readRunCorrections( uint32_t run ) const
+    -> CorrectionTable_t
+{
+    CorrectionTable_t table(fNChannels);
+
+    ReadPMTCablesCorrections(run, table);
+    ReadLaserCorrections(run, table);
+    ReadCosmicsCorrections(run, table);
 
     if( fVerbose ) {
 
         mf::LogInfo(fLogCategory) << "Dump information from database " << std::endl;
         mf::LogVerbatim(fLogCategory) << "channel, trigger cable delay, reset cable delay, laser corrections, muons corrections" << std::endl;
-        for( auto const & [key, value] : fDatabaseTimingCorrections ){
+        for( unsigned int channel = 0; channel < table.size(); ++channel ){
+            PMTTimeCorrectionsDB const& value = table[channel];
             mf::LogVerbatim(fLogCategory) 
-               << key << " " 
+               << channel << " " 
                << value.triggerCableDelay << "," 
                << value.resetCableDelay << ", " 
                << value.laserCableDelay << ", "
@@ -232,4 +252,47 @@ void icarusDB::PMTTimingCorrectionsProvider::readTimeCorrectionDatabase(const ar
         }
     }
 
+    return table;
+}
+
+
+// -----------------------------------------------------------------------------
+
+/// Select the corrections for the run, reading them from the database
+/// only if that run was not read already
+void icarusDB::PMTTimingCorrectionsProvider::readTimeCorrectionDatabase(const art::Run& run){
+
+    uint32_t const runNumber = run.id().run();
+
+    auto itRun = fRunCorrections.find(runNumber);
+    if( itRun == fRunCorrections.end() ) {
+        itRun = fRunCorrections.emplace(runNumber, readRunCorrections(runNumber)).first;
+    }
+    else {
+        mf::LogDebug(fLogCategory) << "Reusing the corrections already read for run " << runNumber;
+    }
+
+    fCorrections = &(itRun->second);
+
+}
+
+
+// -----------------------------------------------------------------------------
+
+void icarusDB::PMTTimingCorrectionsProvider::correctOpHits(
+    std::vector<recob::OpHit> const& hits,
+    std::vector<recob::OpHit>& corrected,
+    CorrectionMask_t corrections
+) const {
+    details::correctOpHits(currentTable(), hits, corrected, corrections);
+}
+
+
+// -----------------------------------------------------------------------------
+
+void icarusDB::PMTTimingCorrectionsProvider::correctWaveforms(
+    std::vector<raw::OpDetWaveform>& waveforms,
+    CorrectionMask_t corrections
+) const {
+    details::correctWaveforms(currentTable(), waveforms, corrections);
 }
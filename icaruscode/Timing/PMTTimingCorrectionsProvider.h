@@ -19,26 +19,14 @@
 
 // Local
 #include "icaruscode/Timing/PMTTimingCorrections.h"
+#include "icaruscode/Timing/PMTTimingCorrectionsTable.h"
 
 // C/C++ standard libraries
 #include <string>
 #include <map>
+#include <vector>
 #include <stdint.h>
 
-namespace icarusDB::details {
-    
-  /// Structure for single channel corrections
-  struct PMTTimeCorrectionsDB { 
-
-    double triggerCableDelay=0;  ///< [&micro;s]
-    double resetCableDelay=0;    ///< [&micro;s]
-    double laserCableDelay=0;    ///< [&micro;s]
-    double cosmicsCorrections=0; ///< [&micro;s]
-    
-  };
-  
-} // icarusDB::details
-
 namespace icarusDB{ class PMTTimingCorrectionsProvider; }
 /**
  * @brief 
@@ -47,6 +35,14 @@ namespace icarusDB{ class PMTTimingCorrectionsProvider; }
  * Corrections are picked according to the run number being processed.  
  *
  * All time corrections are offsets (in microseconds) that need to be _added_ to the uncorrected time.
+ *
+ * The corrections of a run are stored in a table indexed by channel number.
+ * Tables are kept for all the runs read in the job, so that going back to a run
+ * already processed does not query the database again.
+ * The batch methods `correctOpHits()` and `correctWaveforms()` apply the
+ * corrections to a whole collection in one call.
+ * The table covers the PMT channels of the detector (whose number is passed
+ * to the constructor); a channel from the database beyond them is an error.
  * 
  * Configuration parameters
  * -------------------------
@@ -62,9 +58,10 @@ class icarusDB::PMTTimingCorrectionsProvider : public PMTTimingCorrections {
 
     public: 
 
-        PMTTimingCorrectionsProvider(const fhicl::ParameterSet& pset);
+        /// Constructor: `nChannels` is the number of PMT channels in the detector.
+        PMTTimingCorrectionsProvider(const fhicl::ParameterSet& pset, unsigned int nChannels);
 
-	/// Read timing corrections from the database
+	/// Read timing corrections from the database (or from the ones of the runs already read)
         void readTimeCorrectionDatabase(const art::Run& run);
 
 	/// Get time delay on the trigger line
@@ -87,36 +84,67 @@ class icarusDB::PMTTimingCorrectionsProvider : public PMTTimingCorrections {
             return getChannelCorrOrDefault(channelID).cosmicsCorrections;
         };
 
+	/// Appends to `corrected` the `hits` with the selected corrections applied
+        void correctOpHits(
+            std::vector<recob::OpHit> const& hits,
+            std::vector<recob::OpHit>& corrected,
+            CorrectionMask_t corrections
+            ) const override;
+
+	/// Adds the selected corrections to the time stamp of the `waveforms`
+        void correctWaveforms(
+            std::vector<raw::OpDetWaveform>& waveforms,
+            CorrectionMask_t corrections
+            ) const override;
+
     private:
         
         using PMTTimeCorrectionsDB = details::PMTTimeCorrectionsDB;
-        static constexpr PMTTimeCorrectionsDB CorrectionDefaults {}; ///< Default values
 
+        unsigned int fNChannels; ///< Number of PMT channels.
         bool fVerbose = false; ///< Whether to print the configuration we read.
         std::string fLogCategory; ///< Category tag for messages.
 	std::string fCablesTag;  ///< Tag for cable corrections database.	
 	std::string fLaserTag;   ///< Tag for laser corrections database.
 	std::string fCosmicsTag; ///< Tag for cosmics corrections database.	
 
-	/// Map of corrections by channel
-        std::map<unsigned int, PMTTimeCorrectionsDB> fDatabaseTimingCorrections;
+	/// Corrections of all channels, indexed by channel number
+        using CorrectionTable_t = details::PMTTimeCorrectionsTable_t;
+
+	/// Correction tables of the runs read so far, by run number
+        std::map<uint32_t, CorrectionTable_t> fRunCorrections;
+
+	/// Table of the current run (`nullptr` before the first run)
+        CorrectionTable_t const* fCorrections = nullptr;
         
+	/// Table of the current run (an empty one before the first run)
+        CorrectionTable_t const& currentTable() const
+            {
+                static CorrectionTable_t const NoTable;
+                return fCorrections? *fCorrections: NoTable;
+            }
+
         /// Internal access to the channel correction record; returns defaults if not present.
         PMTTimeCorrectionsDB const& getChannelCorrOrDefault
             (unsigned int channelID) const
-            {
-                auto const it = fDatabaseTimingCorrections.find(channelID);
-                return (it == fDatabaseTimingCorrections.end())? CorrectionDefaults: it->second;
-            }
+            { return details::channelCorrOrDefault(currentTable(), channelID); }
+
+	/// Returns the record of `channel` in `table`
+	/// @throw cet::exception if `channel` is not a PMT channel
+        PMTTimeCorrectionsDB& channelEntry
+            (CorrectionTable_t& table, unsigned int channel) const;
+
+	/// Reads from the database all the corrections for `run`
+        CorrectionTable_t readRunCorrections(uint32_t run) const;
 
 	/// Convert run number to internal database
 	uint64_t RunToDatabaseTimestamp(uint32_t run) const;
 
-        void ReadPMTCablesCorrections(uint32_t run);
+        void ReadPMTCablesCorrections(uint32_t run, CorrectionTable_t& table) const;
 
-        void ReadLaserCorrections(uint32_t run);
+        void ReadLaserCorrections(uint32_t run, CorrectionTable_t& table) const;
 
-        void ReadCosmicsCorrections(uint32_t run);
+        void ReadCosmicsCorrections(uint32_t run, CorrectionTable_t& table) const;
 
 }; // services class
 
@@ -0,0 +1,112 @@
+/**
+ * @file   icaruscode/Timing/PMTTimingCorrectionsTable.h
+ * @brief  Table of the PMT timing corrections of a run, and its application.
+ * @date   October 19, 2026
+ * @see    `icaruscode/Timing/PMTTimingCorrectionsProvider.h`
+ *
+ * This library is header only.
+ */
+
+#ifndef ICARUSCODE_TIMING_PMTTIMINGCORRECTIONSTABLE_H
+#define ICARUSCODE_TIMING_PMTTIMINGCORRECTIONSTABLE_H
+
+// Local
+#include "icaruscode/Timing/PMTTimingCorrections.h"
+
+// LArSoft libraries
+#include "lardataobj/RawData/OpDetWaveform.h"
+#include "lardataobj/RecoBase/OpHit.h"
+
+// C/C++ standard libraries
+#include <vector>
+
+
+namespace icarusDB::details {
+
+  /// Structure for single channel corrections
+  struct PMTTimeCorrectionsDB {
+
+    double triggerCableDelay=0;  ///< [&micro;s]
+    double resetCableDelay=0;    ///< [&micro;s]
+    double laserCableDelay=0;    ///< [&micro;s]
+    double cosmicsCorrections=0; ///< [&micro;s]
+
+  };
+
+  /// Corrections of all channels, indexed by channel number
+  using PMTTimeCorrectionsTable_t = std::vector<PMTTimeCorrectionsDB>;
+
+  /// Corrections of a channel not in the table (no correction at all)
+  inline constexpr PMTTimeCorrectionsDB NoCorrections {};
+
+
+  /// Returns the corrections of `channel` in `table` (`NoCorrections` if not present)
+  inline PMTTimeCorrectionsDB const& channelCorrOrDefault
+    (PMTTimeCorrectionsTable_t const& table, unsigned int channel)
+    { return (channel < table.size())? table[channel]: NoCorrections; }
+
+
+  /// Returns the sum of the `corrections` selected by the mask in `corr`
+  inline double totalCorrection(
+    PMTTimeCorrectionsDB const& corr,
+    PMTTimingCorrections::CorrectionMask_t corrections
+  ) {
+    double total = 0.0;
+    if (corrections & PMTTimingCorrections::TriggerCableCorr) total += corr.triggerCableDelay;
+    if (corrections & PMTTimingCorrections::ResetCableCorr) total += corr.resetCableDelay;
+    if (corrections & PMTTimingCorrections::LaserCorr) total += corr.laserCableDelay;
+    if (corrections & PMTTimingCorrections::CosmicsCorr) total += corr.cosmicsCorrections;
+    return total;
+  }
+
+
+  /// Appends to `corrected` the `hits` with the selected corrections from `table`
+  inline void correctOpHits(
+    PMTTimeCorrectionsTable_t const& table,
+    std::vector<recob::OpHit> const& hits,
+    std::vector<recob::OpHit>& corrected,
+    PMTTimingCorrections::CorrectionMask_t corrections
+  ) {
+
+    corrected.reserve(corrected.size() + hits.size());
+    for( recob::OpHit const& opHit: hits ) {
+
+        double const correction
+          = totalCorrection(channelCorrOrDefault(table, opHit.OpChannel()), corrections);
+
+        corrected.emplace_back(
+            opHit.OpChannel(),                  // channel
+            opHit.PeakTime() + correction,      // peaktime
+            opHit.PeakTimeAbs() + correction,   // peaktimeabs
+            opHit.StartTime() + correction,     // starttime
+            opHit.RiseTime(),                   // risetime (relative to start time)
+            opHit.Frame(),                      // frame
+            opHit.Width(),                      // width
+            opHit.Area(),                       // area
+            opHit.Amplitude(),                  // peakheight
+            opHit.PE(),                         // pe
+            opHit.FastToTotal()                 // fasttototal
+        );
+    }
+
+  }
+
+
+  /// Adds the selected corrections from `table` to the time stamp of the `waveforms`
+  inline void correctWaveforms(
+    PMTTimeCorrectionsTable_t const& table,
+    std::vector<raw::OpDetWaveform>& waveforms,
+    PMTTimingCorrections::CorrectionMask_t corrections
+  ) {
+
+    for( raw::OpDetWaveform& waveform: waveforms ) {
+        waveform.SetTimeStamp( waveform.TimeStamp()
+          + totalCorrection(channelCorrOrDefault(table, waveform.ChannelNumber()), corrections) );
+    }
+
+  }
+
+} // icarusDB::details
+
+
+#endif // ICARUSCODE_TIMING_PMTTIMINGCORRECTIONSTABLE_H
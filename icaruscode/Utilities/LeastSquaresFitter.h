@@ -0,0 +1,273 @@
+/**
+ * @file   icaruscode/Utilities/LeastSquaresFitter.h
+ * @brief  Levenberg-Marquardt least squares fit of a model with analytic gradient.
+ * @date   October 19, 2026
+ *
+ * The fitter does not rely on ROOT/Minuit global state: independent fits can
+ * run concurrently in different threads.
+ *
+ * This library is header only.
+ */
+
+#ifndef ICARUSCODE_UTILITIES_LEASTSQUARESFITTER_H
+#define ICARUSCODE_UTILITIES_LEASTSQUARESFITTER_H
+
+// Eigen libraries
+#include <Eigen/Dense>
+
+// C/C++ standard libraries
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility> // std::move()
+#include <vector>
+
+
+namespace util
+{
+
+  /**
+   * @brief Weighted least squares fitter with analytic derivatives.
+   *
+   * The model is a callable object with the signature
+   * `double model(double x, double const* par, double* grad)`: it returns the
+   * value of the function at `x` for the parameters `par`, and it stores in
+   * `grad` the derivatives of that value with respect to each parameter.
+   *
+   * The fit minimizes `chi2 = sum_i ((y_i - model(x_i)) / sigma_i)^2` with
+   * the Levenberg-Marquardt algorithm. Parameters can be constrained within
+   * limits; the steps out of the limits are clamped back to them.
+   * A parameter which does not affect the model (all derivatives are zero)
+   * stays at its starting value, with error `0`.
+   *
+   * The errors of the parameters are from the covariance matrix, the inverse
+   * of the curvature matrix at the minimum, like the ones of a ROOT chi2 fit.
+   * When the points have no uncertainties, the covariance is scaled by
+   * `chi2/ndf`, i.e. the uncertainty of the points is estimated from their
+   * scatter around the best fit, as ROOT does for data with no errors.
+   *
+   * The fitter object is not changed by `fit()`, which can be called
+   * concurrently from different threads.
+   */
+  class LeastSquaresFitter
+  {
+
+    public:
+
+      /// Outcome of the fit.
+      struct Result_t
+      {
+        std::vector<double> parameters; ///< Best fit parameters.
+        std::vector<double> errors; ///< Parameter uncertainties.
+        double chi2 = -1;
+        int ndf = -1;
+        int status = -1; ///< 0: converged, 1: too many iterations, 2: failed
+        unsigned int iterations = 0;
+      };
+
+      explicit LeastSquaresFitter( std::size_t nparameters )
+        : m_nparameters(nparameters)
+        , m_low(nparameters, -std::numeric_limits<double>::infinity())
+        , m_high(nparameters, std::numeric_limits<double>::infinity())
+        {}
+
+      std::size_t nParameters() const { return m_nparameters; }
+
+      /// Constrains the parameter `ipar` within `[ low, high ]`.
+      void setParLimits( std::size_t ipar, double low, double high )
+        { m_low.at(ipar) = low; m_high.at(ipar) = high; }
+
+      void setMaxIterations( unsigned int n ){ m_maxiterations = n; }
+
+      /// Convergence when the chi2 relative improvement is smaller than this.
+      void setTolerance( double tolerance ){ m_tolerance = tolerance; }
+
+      /**
+       * @brief Fits `model` to the points `(x, y)`.
+       * @param model the function to fit (see class documentation)
+       * @param x abscissae of the points
+       * @param y values of the points
+       * @param sigma uncertainties of `y` (if empty, see below)
+       * @param start starting values of the parameters
+       * @return the result of the fit
+       *
+       * If `sigma` is empty, all the points have the same weight, and the
+       * errors of the parameters are scaled by `sqrt(chi2/ndf)`.
+       */
+      template <typename Model>
+      Result_t fit(
+        Model const& model,
+        std::vector<double> const& x,
+        std::vector<double> const& y,
+        std::vector<double> const& sigma,
+        std::vector<double> start
+        ) const;
+
+    private:
+
+      std::size_t m_nparameters;
+      std::vector<double> m_low;
+      std::vector<double> m_high;
+      unsigned int m_maxiterations = 200;
+      double m_tolerance = 1e-9;
+
+      /// Returns the chi2 of the model; fills the curvature and gradient
+      /// if `alpha` is not null.
+      template <typename Model>
+      double computeChi2(
+        Model const& model,
+        std::vector<double> const& x,
+        std::vector<double> const& y,
+        std::vector<double> const& weight,
+        std::vector<double> const& par,
+        Eigen::MatrixXd* alpha, Eigen::VectorXd* beta
+        ) const;
+
+  };
+
+} // namespace util
+
+
+//------------------------------------------------------------------------------
+template <typename Model>
+double util::LeastSquaresFitter::computeChi2(
+  Model const& model,
+  std::vector<double> const& x,
+  std::vector<double> const& y,
+  std::vector<double> const& weight,
+  std::vector<double> const& par,
+  Eigen::MatrixXd* alpha, Eigen::VectorXd* beta
+) const {
+
+  std::size_t const npar = m_nparameters;
+  std::vector<double> grad(npar, 0.0);
+
+  if( alpha ){ alpha->setZero(npar, npar); beta->setZero(npar); }
+
+  double chi2 = 0.0;
+  for( std::size_t i=0; i<x.size(); i++ ){
+
+    double const f = model(x[i], par.data(), grad.data());
+    double const r = y[i] - f;
+    chi2 += weight[i]*r*r;
+
+    if( !alpha ) continue;
+
+    // only the lower triangle is filled
+    for( std::size_t j=0; j<npar; j++ ){
+      double const wg = weight[i]*grad[j];
+      (*beta)[j] += wg*r;
+      for( std::size_t k=0; k<=j; k++ ) (*alpha)(j, k) += wg*grad[k];
+    }
+
+  }
+
+  return std::isfinite(chi2)? chi2: std::numeric_limits<double>::infinity();
+
+} // util::LeastSquaresFitter::computeChi2()
+
+
+//------------------------------------------------------------------------------
+template <typename Model>
+auto util::LeastSquaresFitter::fit(
+  Model const& model,
+  std::vector<double> const& x,
+  std::vector<double> const& y,
+  std::vector<double> const& sigma,
+  std::vector<double> start
+) const -> Result_t {
+
+  assert(start.size() == m_nparameters);
+  assert(x.size() == y.size());
+  assert(sigma.empty() || (sigma.size() == x.size()));
+
+  std::size_t const npar = m_nparameters;
+
+  Result_t result;
+  result.ndf = int(x.size()) - int(npar);
+  result.errors.assign(npar, 0.0);
+
+  std::vector<double> weight(x.size(), 1.0);
+  if( !sigma.empty() ){
+    std::transform(sigma.begin(), sigma.end(), weight.begin(),
+      [](double s){ return 1.0/(s*s); });
+  }
+
+  auto const clamp = [this](std::vector<double>& par){
+    for( std::size_t j=0; j<par.size(); j++ )
+      par[j] = std::clamp(par[j], m_low[j], m_high[j]);
+  };
+
+  std::vector<double> par = std::move(start);
+  clamp(par);
+
+  Eigen::MatrixXd alpha(npar, npar), A(npar, npar);
+  Eigen::VectorXd beta(npar);
+
+  double chi2 = computeChi2(model, x, y, weight, par, &alpha, &beta);
+  result.parameters = par;
+  result.chi2 = chi2;
+  if( (result.ndf <= 0) || !std::isfinite(chi2) ){
+    result.status = 2;
+    return result;
+  }
+
+  double lambda = 1e-3;
+  std::vector<double> trial(npar);
+  result.status = 1;
+  while( result.iterations < m_maxiterations ){
+
+    ++result.iterations;
+
+    // damped normal equations; parameters with no effect are left alone
+    A = alpha.selfadjointView<Eigen::Lower>();
+    for( std::size_t j=0; j<npar; j++ ){
+      if( A(j, j) > 0.0 ) A(j, j) *= 1.0 + lambda;
+      else { A.row(j).setZero(); A.col(j).setZero(); A(j, j) = 1.0; }
+    }
+    Eigen::VectorXd b = beta;
+    for( std::size_t j=0; j<npar; j++ ) if( alpha(j, j) <= 0.0 ) b[j] = 0.0;
+    Eigen::VectorXd const delta = A.ldlt().solve(b);
+
+    for( std::size_t j=0; j<npar; j++ ) trial[j] = par[j] + delta[j];
+    clamp(trial);
+
+    double const trialChi2 = computeChi2(model, x, y, weight, trial, nullptr, nullptr);
+
+    if( trialChi2 <= chi2 ){
+      bool const converged = (chi2 - trialChi2) <= m_tolerance*(chi2 + m_tolerance);
+      par.swap(trial);
+      chi2 = computeChi2(model, x, y, weight, par, &alpha, &beta);
+      lambda = std::max(lambda/10.0, 1e-12);
+      if( converged ){ result.status = 0; break; }
+    }
+    else {
+      lambda *= 10.0;
+      // no step can improve further: we are at the minimum
+      if( lambda > 1e12 ){ result.status = 0; break; }
+    }
+
+  } // while
+
+  // covariance from the curvature at the minimum
+  A = alpha.selfadjointView<Eigen::Lower>();
+  for( std::size_t j=0; j<npar; j++ ){
+    if( A(j, j) <= 0.0 ){ A.row(j).setZero(); A.col(j).setZero(); A(j, j) = 1.0; }
+  }
+  Eigen::MatrixXd cov = A.ldlt().solve(Eigen::MatrixXd::Identity(npar, npar));
+  // with no uncertainties, they are estimated from the residuals
+  if( sigma.empty() ) cov *= chi2/result.ndf;
+  for( std::size_t j=0; j<npar; j++ ){
+    result.errors[j] = (alpha(j, j) > 0.0)? std::sqrt(std::max(cov(j, j), 0.0)): 0.0;
+  }
+
+  result.parameters = std::move(par);
+  result.chi2 = chi2;
+  return result;
+
+} // util::LeastSquaresFitter::fit()
+
+
+#endif // ICARUSCODE_UTILITIES_LEASTSQUARESFITTER_H
@@ -0,0 +1,167 @@
+/**
+ * @file   icaruscode/Utilities/StageTimers.cxx
+ * @brief  Low-overhead timers of the processing stages of a module.
+ * @date   October 19, 2026
+ * @see    icaruscode/Utilities/StageTimers.h
+ */
+
+// library header
+#include "icaruscode/Utilities/StageTimers.h"
+
+// framework libraries
+#include "art_root_io/TFileService.h"
+#include "art_root_io/TFileDirectory.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "art/Framework/Services/Registry/ServiceRegistry.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// ROOT libraries
+#include "TH1D.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::find()
+#include <cmath> // std::ldexp()
+#include <map>
+#include <mutex>
+#include <utility> // std::move()
+
+
+// -----------------------------------------------------------------------------
+// --- util::StageTimers::Stats_t
+// -----------------------------------------------------------------------------
+void util::StageTimers::Stats_t::merge(Stats_t const& other) noexcept {
+
+  count += other.count;
+  totalNs += other.totalNs;
+  if (other.minNs < minNs) minNs = other.minNs;
+  if (other.maxNs > maxNs) maxNs = other.maxNs;
+  for (std::size_t bin = 0U; bin < NBins; ++bin)
+    histogram[bin] += other.histogram[bin];
+
+} // util::StageTimers::Stats_t::merge()
+
+
+// -----------------------------------------------------------------------------
+// --- util::StageTimers
+// -----------------------------------------------------------------------------
+util::StageTimers::StageTimers(std::string moduleLabel)
+  : fModuleLabel{ std::move(moduleLabel) }
+  {}
+
+
+// -----------------------------------------------------------------------------
+std::shared_ptr<util::StageTimers> util::StageTimers::forModule
+  (std::string const& moduleLabel)
+{
+  static std::mutex registryMutex;
+  static std::map<std::string, std::weak_ptr<StageTimers>> registry;
+
+  std::lock_guard const lock{ registryMutex };
+
+  std::weak_ptr<StageTimers>& entry = registry[moduleLabel];
+  std::shared_ptr<StageTimers> timers = entry.lock();
+  if (!timers) {
+    timers = std::make_shared<StageTimers>(moduleLabel);
+    entry = timers;
+  }
+  return timers;
+
+} // util::StageTimers::forModule()
+
+
+// -----------------------------------------------------------------------------
+auto util::StageTimers::addStage(std::string const& name) -> StageID_t {
+
+  auto const itStage = std::find(fStageNames.begin(), fStageNames.end(), name);
+  if (itStage != fStageNames.end()) return itStage - fStageNames.begin();
+
+  fStageNames.push_back(name);
+  return fStageNames.size() - 1U;
+
+} // util::StageTimers::addStage()
+
+
+// -----------------------------------------------------------------------------
+auto util::StageTimers::stats() const -> std::vector<Stats_t> {
+
+  std::vector<Stats_t> allStats(nStages());
+  for (std::vector<Stats_t> const& threadStats: fThreadStats) {
+    for (std::size_t stage = 0U; stage < threadStats.size(); ++stage)
+      allStats[stage].merge(threadStats[stage]);
+  } // for threads
+  return allStats;
+
+} // util::StageTimers::stats()
+
+
+// -----------------------------------------------------------------------------
+double util::StageTimers::binLowEdge(std::size_t bin) {
+
+  std::size_t const octave = bin / BinsPerOctave;
+  std::size_t const sub = bin % BinsPerOctave;
+  return std::ldexp(1.0 + double(sub) / BinsPerOctave, octave);
+
+} // util::StageTimers::binLowEdge()
+
+
+// -----------------------------------------------------------------------------
+void util::StageTimers::writeHistograms(art::TFileDirectory& dir) const {
+
+  std::vector<Stats_t> const allStats = stats();
+
+  TH1D* totals = dir.make<TH1D>(
+    "StageTotalTime",
+    ("Time spent in each stage of " + moduleLabel()
+      + ";;total wall clock time  [ s ]").c_str(),
+    nStages(), 0.0, nStages()
+    );
+
+  for (StageID_t stage = 0U; stage < allStats.size(); ++stage) {
+    Stats_t const& stats = allStats[stage];
+
+    totals->GetXaxis()->SetBinLabel(stage + 1, stageName(stage).c_str());
+    totals->SetBinContent(stage + 1, stats.totalTime());
+
+    // only the range of bins with recorded times is included
+    std::size_t firstBin = 0U;
+    std::size_t lastBin = 0U;
+    if (stats.count > 0U) {
+      firstBin = timeBin(stats.minNs);
+      lastBin = timeBin(stats.maxNs);
+    }
+
+    std::vector<double> edges;
+    edges.reserve(lastBin - firstBin + 2U);
+    for (std::size_t bin = firstBin; bin <= lastBin + 1U; ++bin)
+      edges.push_back(binLowEdge(bin) * 1e-9); // in seconds
+
+    TH1D* hist = dir.make<TH1D>(
+      ("StageTime_" + stageName(stage)).c_str(),
+      ("Time of stage " + stageName(stage) + " of " + moduleLabel()
+        + ";wall clock time  [ s ];calls").c_str(),
+      edges.size() - 1U, edges.data()
+      );
+    for (std::size_t bin = firstBin; bin <= lastBin; ++bin)
+      hist->SetBinContent(bin - firstBin + 1, stats.histogram[bin]);
+    hist->SetEntries(stats.count);
+
+  } // for stages
+  totals->SetEntries(nStages());
+
+} // util::StageTimers::writeHistograms()
+
+
+// -----------------------------------------------------------------------------
+void util::StageTimers::report(std::string const& logCategory) {
+
+  if (!claimReport()) return;
+
+  dump(mf::LogInfo{ logCategory });
+
+  if (art::ServiceRegistry::isAvailable<art::TFileService>())
+    writeHistograms(*art::ServiceHandle<art::TFileService>());
+
+} // util::StageTimers::report()
+
+
+// -----------------------------------------------------------------------------
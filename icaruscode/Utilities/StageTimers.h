@@ -0,0 +1,333 @@
+/**
+ * @file   icaruscode/Utilities/StageTimers.h
+ * @brief  Low-overhead timers of the processing stages of a module.
+ * @date   October 19, 2026
+ * @see    icaruscode/Utilities/StageTimers.cxx
+ */
+
+#ifndef ICARUSCODE_UTILITIES_STAGETIMERS_H
+#define ICARUSCODE_UTILITIES_STAGETIMERS_H
+
+
+// TBB libraries
+#include "tbb/cache_aligned_allocator.h"
+#include "tbb/enumerable_thread_specific.h"
+
+// C/C++ standard libraries
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory> // std::shared_ptr
+#include <string>
+#include <vector>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+
+
+// -----------------------------------------------------------------------------
+namespace art { class TFileDirectory; }
+namespace util { class StageTimers; }
+
+/**
+ * @brief Accumulates the time spent in the processing stages of a module.
+ *
+ * Each stage is registered with a name (`addStage()`) when the module is
+ * constructed, and then timed by the `Scope` object returned by `time()`:
+ * the elapsed (wall clock) time from the creation of the scope to its
+ * destruction, or to an explicit `Scope::stop()`, is recorded for the stage.
+ * Scopes may be opened from any thread, including from TBB tasks: each thread
+ * accumulates its own statistics, with no locking, and the statistics are
+ * merged only when asked via `stats()`, typically at the end of the job.
+ *
+ * For each stage the number of calls, the total, minimum and maximum time,
+ * and a histogram of the times are kept. The histogram has logarithmic bins,
+ * four per power of 2 (about 19% wide), from 1 ns to about 78 hours.
+ *
+ * The cost of a timed scope is two reads of `std::chrono::steady_clock` and
+ * the update of a few counters, about 100 ns; the clock reads also stall the
+ * processor pipeline, which may make the actual cost a few times larger.
+ * It is negligible for stages of a few tens of microseconds or longer
+ * (`benchmarkStageTimers` measures it), and timing shorter steps should be
+ * avoided.
+ *
+ * Modules which are replicated (`art::ReplicatedProducer`) should share the
+ * same timers among all the replicas via `forModule()`, and leave the
+ * reporting to the first replica calling `claimReport()` (or `report()`).
+ *
+ * Example of usage in a module:
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.cpp}
+ * // in the constructor:
+ * fTimers = util::StageTimers::forModule(pset.get<std::string>("module_label"));
+ * fDecodeStage = fTimers->addStage("decode");
+ *
+ * // in produce():
+ * {
+ *   auto const timer = fTimers->time(fDecodeStage);
+ *   decode(data);
+ * } // time recorded here
+ *
+ * // in endJob():
+ * fTimers->report("MyModule");
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ */
+class util::StageTimers {
+
+    public:
+
+  using Clock_t = std::chrono::steady_clock; ///< Clock used for timing.
+  using StageID_t = std::size_t; ///< Type of stage identifier.
+
+  /// Number of histogram bins for each power of 2.
+  static constexpr std::size_t BinsPerOctave = 4U;
+
+  /// Number of powers of 2 covered by the histogram, starting from 1 ns.
+  static constexpr std::size_t NOctaves = 48U;
+
+  /// Total number of histogram bins.
+  static constexpr std::size_t NBins = BinsPerOctave * NOctaves;
+
+
+  /// Timing statistics of a stage.
+  struct Stats_t {
+
+    std::uint64_t count = 0U; ///< Number of recorded times.
+    std::uint64_t totalNs = 0U; ///< Total of the recorded times [ns].
+    std::uint64_t minNs = ~std::uint64_t{ 0U }; ///< Shortest time [ns].
+    std::uint64_t maxNs = 0U; ///< Longest time [ns].
+    std::array<std::uint64_t, NBins> histogram {}; ///< Counts per time bin.
+
+    /// Records a time of `ns` nanoseconds.
+    void add(std::uint64_t ns) noexcept;
+
+    /// Adds all the times recorded in `other`.
+    void merge(Stats_t const& other) noexcept;
+
+    /// Returns the total time [s].
+    double totalTime() const { return totalNs * 1e-9; }
+
+    /// Returns the average time [s] (`0` if no time was recorded).
+    double meanTime() const { return count? totalTime() / count: 0.0; }
+
+  }; // Stats_t
+
+
+  /// Times a stage from construction to destruction (or `stop()`).
+  class Scope {
+
+      public:
+
+    /// Starts timing `stage` of `timers`.
+    Scope(StageTimers& timers, StageID_t stage)
+      : fTimers{ &timers }, fStage{ stage }, fStart{ Clock_t::now() }
+      {}
+
+    Scope(Scope const&) = delete;
+    Scope& operator= (Scope const&) = delete;
+
+    ~Scope() { stop(); }
+
+    /// Records the time elapsed so far; later calls have no effect.
+    void stop()
+      {
+        if (!fTimers) return;
+        fTimers->record(fStage, Clock_t::now() - fStart);
+        fTimers = nullptr;
+      }
+
+      private:
+    StageTimers* fTimers; ///< Timers to record into (`nullptr` if stopped).
+    StageID_t fStage; ///< Stage being timed.
+    Clock_t::time_point fStart; ///< Start of the timing.
+
+  }; // Scope
+
+
+  /// Constructor: timers with no stage, for the specified module.
+  explicit StageTimers(std::string moduleLabel);
+
+  /**
+   * @brief Returns the timers of the module with the specified label.
+   * @param moduleLabel label of the module
+   * @return timers shared by all the callers with the same `moduleLabel`
+   *
+   * This function is thread-safe.
+   */
+  static std::shared_ptr<StageTimers> forModule(std::string const& moduleLabel);
+
+
+  // --- BEGIN -- Configuration ------------------------------------------------
+  /**
+   * @brief Registers a new stage.
+   * @param name name of the stage
+   * @return the identifier of the stage
+   *
+   * If a stage with the same `name` is already registered, its identifier is
+   * returned. Stages must be all registered before any is timed: this function
+   * is not thread-safe against `record()`.
+   */
+  StageID_t addStage(std::string const& name);
+
+  /// Returns the label of the module these timers belong to.
+  std::string const& moduleLabel() const { return fModuleLabel; }
+
+  /// Returns the number of registered stages.
+  std::size_t nStages() const { return fStageNames.size(); }
+
+  /// Returns the name of the specified stage.
+  std::string const& stageName(StageID_t stage) const
+    { return fStageNames.at(stage); }
+  // --- END ---- Configuration ------------------------------------------------
+
+
+  // --- BEGIN -- Timing -------------------------------------------------------
+  /// Returns a scope timing the specified `stage` until its destruction.
+  [[nodiscard]] Scope time(StageID_t stage) { return { *this, stage }; }
+
+  /// Records `elapsed` time for the specified `stage` (thread-safe).
+  void record(StageID_t stage, Clock_t::duration elapsed)
+    {
+      threadStats(stage).add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()
+        );
+    }
+  // --- END ---- Timing -------------------------------------------------------
+
+
+  // --- BEGIN -- Results ------------------------------------------------------
+  /**
+   * @brief Returns the statistics of all stages, merged from all threads.
+   *
+   * This function must not be called while stages are being timed.
+   */
+  std::vector<Stats_t> stats() const;
+
+  /// Returns the lower edge of the histogram `bin` [ns].
+  static double binLowEdge(std::size_t bin);
+
+  /// Returns the histogram bin the time `ns` [ns] is recorded into.
+  static std::size_t timeBin(std::uint64_t ns) noexcept;
+
+  /**
+   * @brief Returns whether the caller is the first to ask to report.
+   *
+   * This allows replicas of a module sharing these timers to report only once.
+   */
+  bool claimReport() { return !fReported.test_and_set(); }
+
+  /**
+   * @brief Prints a table of the timing of all stages into `out`.
+   * @tparam Stream type of output stream
+   * @param out the stream to write into
+   * @param indent (default: none) indentation of each line of the table
+   */
+  template <typename Stream>
+  void dump(Stream&& out, std::string const& indent = "") const;
+
+  /**
+   * @brief Writes a histogram per stage and a summary into `dir`.
+   * @param dir the ROOT directory to write into
+   *
+   * The time histogram of each stage is written as `StageTime_<name>` (times
+   * in seconds, variable bins covering only the range of recorded times).
+   * The histogram `StageTotalTime` has one bin per stage, labelled with the
+   * stage name, with the total time spent in that stage [s].
+   */
+  void writeHistograms(art::TFileDirectory& dir) const;
+
+  /**
+   * @brief Reports the timing at the end of the job.
+   * @param logCategory message facility category for the printout
+   *
+   * Unless already claimed (`claimReport()`), the summary is printed via
+   * `mf::LogInfo` and, if `art::TFileService` is configured in the job, the
+   * histograms are written into its current directory (`writeHistograms()`).
+   * It is meant to be called from the `endJob()` of the module.
+   */
+  void report(std::string const& logCategory);
+  // --- END ---- Results ------------------------------------------------------
+
+
+    private:
+
+  /// Per-thread statistics of all stages; one thread-local key per instance.
+  using ThreadStats_t = tbb::enumerable_thread_specific<
+    std::vector<Stats_t>,
+    tbb::cache_aligned_allocator<std::vector<Stats_t>>,
+    tbb::ets_key_per_instance
+    >;
+
+  std::string const fModuleLabel; ///< Label of the module.
+
+  std::vector<std::string> fStageNames; ///< Name of the stages.
+
+  ThreadStats_t fThreadStats; ///< Statistics of each thread.
+
+  std::atomic_flag fReported = ATOMIC_FLAG_INIT; ///< Whether reported already.
+
+
+  /// Returns the statistics of `stage` for the current thread.
+  Stats_t& threadStats(StageID_t stage)
+    {
+      std::vector<Stats_t>& stats = fThreadStats.local();
+      if (stage >= stats.size()) stats.resize(fStageNames.size());
+      return stats[stage];
+    }
+
+}; // util::StageTimers
+
+
+// -----------------------------------------------------------------------------
+// --- inline implementation
+// -----------------------------------------------------------------------------
+inline std::size_t util::StageTimers::timeBin(std::uint64_t ns) noexcept {
+
+  if (ns == 0U) return 0U;
+
+  // the octave is the position of the highest bit set,
+  // the bin within the octave is given by the next bits
+  std::size_t const octave = 63U - __builtin_clzll(ns);
+  std::size_t const sub = (octave >= 2U)
+    ? ((ns >> (octave - 2U)) & (BinsPerOctave - 1U))
+    : ((ns << (2U - octave)) & (BinsPerOctave - 1U));
+  std::size_t const bin = octave * BinsPerOctave + sub;
+  return (bin < NBins)? bin: NBins - 1U;
+
+} // util::StageTimers::timeBin()
+
+
+// -----------------------------------------------------------------------------
+inline void util::StageTimers::Stats_t::add(std::uint64_t ns) noexcept {
+  ++count;
+  totalNs += ns;
+  if (ns < minNs) minNs = ns;
+  if (ns > maxNs) maxNs = ns;
+  ++histogram[timeBin(ns)];
+} // util::StageTimers::Stats_t::add()
+
+
+// -----------------------------------------------------------------------------
+// --- template implementation
+// -----------------------------------------------------------------------------
+template <typename Stream>
+void util::StageTimers::dump
+  (Stream&& out, std::string const& indent /* = "" */) const
+{
+  std::vector<Stats_t> const allStats = stats();
+
+  out << indent << "Timing of " << nStages() << " stages of module '"
+    << moduleLabel() << "' (wall clock time, seconds):";
+  for (StageID_t stage = 0U; stage < allStats.size(); ++stage) {
+    Stats_t const& stats = allStats[stage];
+    out << "\n" << indent << "  " << stageName(stage) << ": " << stats.count
+      << " calls";
+    if (stats.count == 0U) continue;
+    out << ", total " << stats.totalTime() << ", mean " << stats.meanTime()
+      << ", min " << (stats.minNs * 1e-9) << ", max " << (stats.maxNs * 1e-9);
+  } // for stages
+
+} // util::StageTimers::dump()
+
+
+// -----------------------------------------------------------------------------
+
+#endif // ICARUSCODE_UTILITIES_STAGETIMERS_H
@@ -0,0 +1,254 @@
+/**
+ * @file   icaruscode/Utilities/benchmarkStageTimers.cxx
+ * @brief  Measures the overhead of timing stages with `util::StageTimers`.
+ * @date   October 19, 2026
+ *
+ * The program measures:
+ *
+ * * the cost of an empty timed scope, with one thread;
+ * * the time of a synthetic workload split into "stages" of configurable
+ *   length, with and without a timed scope around each stage, running in a
+ *   `tbb::parallel_for` loop as the instrumented modules do.
+ *
+ * The relative overhead of the timing on the workload is printed, both as
+ * measured and as estimated from the cost of a scope and the average stage
+ * time. The first is subject to the fluctuations of the machine load, which
+ * may easily be larger than the overhead itself, so the program exits with
+ * code `2` only if the latter is larger than the requested limit.
+ * Run `benchmarkStageTimers --help` for the options.
+ */
+
+// ICARUS libraries
+#include "icaruscode/Utilities/StageTimers.h"
+
+// TBB libraries
+#include "tbb/blocked_range.h"
+#include "tbb/global_control.h"
+#include "tbb/parallel_for.h"
+
+// C++/Boost libraries
+#include "boost/program_options.hpp"
+#include <algorithm> // std::max()
+#include <atomic>
+#include <chrono>
+#include <cmath> // std::sqrt()
+#include <cstddef> // std::size_t
+#include <cstdlib> // std::exit()
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+
+/*
+ * Notable changes here:
+ *
+ * [20261019] [1.0]
+ *     initial version
+ *
+ */
+static std::string const ProgramVersion = "v1.0";
+
+
+// -----------------------------------------------------------------------------
+/// Parameters of the benchmark.
+struct Config_t {
+  double stageTime = 20.0; ///< Duration of each workload stage [us].
+  unsigned int nStages = 10000U; ///< Workload stages in each measurement.
+  unsigned int nEmptyScopes = 10000000U; ///< Empty scopes timed.
+  unsigned int nThreads = 0U; ///< Threads for the workload (`0`: TBB default).
+  unsigned int nPasses = 20U; ///< Measurements of each mode.
+  double maxOverhead = 0.01; ///< Largest acceptable relative overhead.
+}; // Config_t
+
+
+// -----------------------------------------------------------------------------
+std::optional<Config_t> parseCommandLine(int argc, char** argv) {
+
+  namespace po = boost::program_options;
+
+  Config_t config;
+
+  po::options_description benchopt("Benchmark");
+  benchopt.add_options()
+    ("stagetime", po::value(&config.stageTime)->default_value(config.stageTime),
+      "duration of each timed stage of the workload [us]")
+    ("stages", po::value(&config.nStages)->default_value(config.nStages),
+      "workload stages in each measurement")
+    ("emptyscopes",
+      po::value(&config.nEmptyScopes)->default_value(config.nEmptyScopes),
+      "empty scopes timed to measure the cost of a scope")
+    ("threads", po::value(&config.nThreads)->default_value(config.nThreads),
+      "threads running the workload (0: TBB default)")
+    ("passes", po::value(&config.nPasses)->default_value(config.nPasses),
+      "measurements of each mode (alternated, and summed)")
+    ("maxoverhead",
+      po::value(&config.maxOverhead)->default_value(config.maxOverhead),
+      "largest acceptable expected overhead (exit code 2 if exceeded)")
+    ;
+
+  po::options_description genopt("General");
+  genopt.add_options()
+    ("help,?", "print usage instructions and exit")
+    ("version,V", "print version and exit")
+    ;
+
+  po::options_description allopt("Options");
+  allopt.add(benchopt).add(genopt);
+
+  po::variables_map optmap;
+  po::store(po::parse_command_line(argc, argv, allopt), optmap);
+  po::notify(optmap);
+
+  std::optional<int> exitWithCode;
+  if (optmap.count("version")) {
+    std::cout << argv[0] << " version " << ProgramVersion << std::endl;
+    exitWithCode = 0;
+  }
+  if (optmap.count("help")) {
+    std::cout
+      <<   "Measures the overhead of timing processing stages with"
+      << "\nutil::StageTimers."
+      << "\n" << allopt
+      << std::endl
+      ;
+    exitWithCode = 0;
+  }
+  if (exitWithCode) std::exit(*exitWithCode);
+
+  if ((config.nStages == 0U) || (config.nPasses == 0U)
+    || (config.stageTime <= 0.0))
+  {
+    std::cerr << "No workload to process!" << std::endl;
+    return std::nullopt;
+  }
+
+  return config;
+
+} // parseCommandLine()
+
+
+// -----------------------------------------------------------------------------
+/// Serial computation of `nSteps` steps, not optimized away.
+double work(unsigned int nSteps, double x) {
+  for (unsigned int i = 0; i < nSteps; ++i) x = std::sqrt(x + 1.0 + i);
+  return x;
+} // work()
+
+
+/// Returns the seconds spent running `f()`.
+template <typename F>
+double timeOf(F&& f) {
+  auto const start = std::chrono::steady_clock::now();
+  f();
+  return std::chrono::duration<double>
+    (std::chrono::steady_clock::now() - start).count();
+} // timeOf()
+
+
+/// Returns the steps of `work()` taking about `seconds`.
+unsigned int calibrateWork(double seconds) {
+  unsigned int nSteps = 1000U;
+  double checksum = 0.0;
+  double elapsed = 0.0;
+  while ((elapsed = timeOf([&](){ checksum += work(nSteps, 1.0); })) < 0.1)
+    nSteps *= 2U;
+  if (checksum < 0.0) std::cout << "(checksum: " << checksum << ")\n";
+  return std::max(1U, static_cast<unsigned int>(nSteps * seconds / elapsed));
+} // calibrateWork()
+
+
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv) {
+
+  std::optional<Config_t> const maybeConfig = parseCommandLine(argc, argv);
+  if (!maybeConfig) return 1;
+  Config_t const& config = *maybeConfig;
+
+  std::optional<tbb::global_control> threadLimit;
+  if (config.nThreads > 0U) {
+    threadLimit.emplace
+      (tbb::global_control::max_allowed_parallelism, config.nThreads);
+  }
+
+  util::StageTimers timers{ "benchmark" };
+  util::StageTimers::StageID_t const emptyStage = timers.addStage("empty");
+  util::StageTimers::StageID_t const workStage = timers.addStage("work");
+
+  //
+  // cost of a single scope
+  //
+  double const emptyTime = timeOf([&]()
+    {
+      for (unsigned int i = 0; i < config.nEmptyScopes; ++i)
+        auto const timer = timers.time(emptyStage);
+    });
+  double const scopeCost
+    = config.nEmptyScopes? emptyTime / config.nEmptyScopes: 0.0;
+
+  //
+  // overhead on the workload
+  //
+  unsigned int const nSteps = calibrateWork(config.stageTime * 1e-6);
+  std::atomic<double> checksum = 0.0;
+  auto const runWorkload = [&](bool timed)
+    {
+      tbb::parallel_for(tbb::blocked_range<unsigned int>(0U, config.nStages),
+        [&](tbb::blocked_range<unsigned int> const& range)
+        {
+          double sum = 0.0;
+          for (unsigned int i = range.begin(); i < range.end(); ++i) {
+            if (timed) {
+              auto const timer = timers.time(workStage);
+              sum += work(nSteps, i);
+            }
+            else sum += work(nSteps, i);
+          } // for
+          checksum = checksum + sum; // races may drop terms: it is not checked
+        });
+    };
+
+  runWorkload(true); // warm up (not measured)
+  double bareTime = 0.0, timedTime = 0.0;
+  for (unsigned int pass = 0; pass < config.nPasses; ++pass) {
+    // the order of the two modes is alternated, to avoid a systematic bias
+    double bare = 0.0, timed = 0.0;
+    if (pass % 2U == 0U) {
+      bare = timeOf([&](){ runWorkload(false); });
+      timed = timeOf([&](){ runWorkload(true); });
+    }
+    else {
+      timed = timeOf([&](){ runWorkload(true); });
+      bare = timeOf([&](){ runWorkload(false); });
+    }
+    bareTime += bare;
+    timedTime += timed;
+  } // for passes
+  double const overhead = timedTime / bareTime - 1.0;
+
+  util::StageTimers::Stats_t const workStats = timers.stats()[workStage];
+  double const expectedOverhead = scopeCost / workStats.meanTime();
+
+  std::cout << "Cost of a timed scope: " << std::fixed << std::setprecision(1)
+    << (scopeCost * 1e9) << " ns" << std::endl;
+  std::cout << "Workload: " << config.nStages << " stages of "
+    << std::setprecision(2) << (workStats.meanTime() * 1e6) << " us each"
+    << std::endl;
+  std::cout << "\n" << std::setw(16) << "untimed [s]" << std::setw(16)
+    << "timed [s]" << std::setw(14) << "overhead [%]" << std::setw(14)
+    << "expected [%]" << std::endl;
+  std::cout << std::setprecision(4) << std::setw(16) << bareTime
+    << std::setw(16) << timedTime << std::setprecision(3)
+    << std::setw(14) << (overhead * 100.0)
+    << std::setw(14) << (expectedOverhead * 100.0) << std::endl;
+  if (checksum < 0.0) std::cout << "(checksum: " << checksum << ")" << std::endl;
+
+  std::cout << "\n" << std::defaultfloat;
+  timers.dump(std::cout);
+  std::cout << std::endl;
+
+  return (expectedOverhead <= config.maxOverhead)? 0: 2;
+
+} // main()
+
+
+// -----------------------------------------------------------------------------
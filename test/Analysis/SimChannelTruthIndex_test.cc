@@ -0,0 +1,288 @@
+/**
+ * @file   test/Analysis/SimChannelTruthIndex_test.cc
+ * @brief  Unit test for `icarus::SimChannelTruthIndex`.
+ * @date   October 19, 2026
+ * @see    `icaruscode/Analysis/SimChannelTruthIndex.h`
+ *
+ * The index answers the queries on the deposits of a channel from cumulative
+ * sums, instead of scanning the `sim::SimChannel` collection. This test checks
+ * the channel lookup and the deposits in TDC ranges, including the edges of
+ * the ranges, on a small fixed set of channels, and compares the deposits with
+ * the ones summed directly from the ionization deposits of random channels.
+ */
+
+// ICARUS libraries
+#include "icaruscode/Analysis/SimChannelTruthIndex.h"
+
+// LArSoft libraries
+#include "lardataobj/Simulation/SimChannel.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( SimChannelTruthIndex_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard library
+#include <limits>
+#include <random>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+using Index_t = icarus::SimChannelTruthIndex;
+using Deposit_t = Index_t::Deposit_t;
+using TDC_t = Index_t::TDC_t;
+
+
+/// Adds a deposit of `n` electrons and `energy` MeV at `tdc` to `channel`.
+void addDeposit
+  (sim::SimChannel& channel, TDC_t tdc, double n, double energy)
+{
+  double const xyz[3] = { 0.0, 0.0, 0.0 };
+  channel.AddIonizationElectrons(1, tdc, n, xyz, energy);
+}
+
+
+/**
+ * @brief Returns a small fixed set of channels.
+ *
+ * All the values are exactly representable, so that the sums are exact:
+ *  * channel 3: ticks 10 (two deposits, one with 0.25 MeV), 20 and 35;
+ *  * channel 5: no deposit at all;
+ *  * channel 7: the first and the last possible ticks.
+ */
+std::vector<sim::SimChannel> makeFixedChannels() {
+
+  std::vector<sim::SimChannel> channels;
+
+  sim::SimChannel& ch3 = channels.emplace_back(3U);
+  addDeposit(ch3, 10U, 100.0, 1.0);
+  addDeposit(ch3, 10U, 8.0, 0.25);
+  addDeposit(ch3, 20U, 200.0, 2.0);
+  addDeposit(ch3, 35U, 400.0, 4.0);
+
+  channels.emplace_back(5U);
+
+  sim::SimChannel& ch7 = channels.emplace_back(7U);
+  addDeposit(ch7, 0U, 16.0, 0.5);
+  addDeposit(ch7, std::numeric_limits<unsigned short>::max(), 32.0, 1.5);
+
+  return channels;
+} // makeFixedChannels()
+
+
+/// Deposit on `channel` in `[ firstTDC, endTDC [` from a scan of its IDE.
+Deposit_t referenceDeposit(
+  sim::SimChannel const& channel, TDC_t firstTDC, TDC_t endTDC,
+  double minEnergy = std::numeric_limits<double>::lowest()
+) {
+  Deposit_t dep;
+  for (auto const& [ tdc, ides ]: channel.TDCIDEMap()) {
+    if ((tdc < firstTDC) || (tdc >= endTDC)) continue;
+    for (sim::IDE const& ide: ides) {
+      if (ide.energy < minEnergy) continue;
+      dep.numElectrons += ide.numElectrons;
+      dep.energy += ide.energy;
+    }
+  } // for
+  return dep;
+} // referenceDeposit()
+
+
+/// Checks that `dep` has `numElectrons` electrons and `energy` MeV.
+void checkDeposit(Deposit_t const& dep, double numElectrons, double energy) {
+  BOOST_TEST(dep.numElectrons == numElectrons);
+  BOOST_TEST(dep.energy == energy);
+}
+
+
+// -----------------------------------------------------------------------------
+// --- Tests
+// -----------------------------------------------------------------------------
+void LookupTest() {
+
+  std::vector<sim::SimChannel> const channels = makeFixedChannels();
+  Index_t const index{ channels };
+
+  BOOST_TEST(!index.empty());
+  BOOST_TEST(index.simChannel(3U) == &channels[0]);
+  BOOST_TEST(index.simChannel(5U) == &channels[1]);
+  BOOST_TEST(index.simChannel(7U) == &channels[2]);
+  for (raw::ChannelID_t const channel: { 0U, 4U, 6U, 8U, 1000U }) {
+    BOOST_TEST_CONTEXT("channel: " << channel) {
+      BOOST_TEST(!index.hasChannel(channel));
+      BOOST_TEST(index.simChannel(channel) == nullptr);
+      BOOST_TEST(index.channelDeposit(channel).empty());
+      BOOST_TEST(index.deposit(channel, 0U, 100U).empty());
+    }
+  } // for
+
+  checkDeposit(index.channelDeposit(3U), 708.0, 7.25);
+  BOOST_TEST(index.hasChannel(5U));
+  BOOST_TEST(index.channelDeposit(5U).empty());
+  checkDeposit(index.channelDeposit(7U), 48.0, 2.0);
+
+  // the index can be filled again, and emptied
+  Index_t other{ channels };
+  other.fill(std::vector<sim::SimChannel>{});
+  BOOST_TEST(other.empty());
+  BOOST_TEST(!other.hasChannel(3U));
+
+  other.fill(channels);
+  checkDeposit(other.channelDeposit(3U), 708.0, 7.25);
+  other.clear();
+  BOOST_TEST(other.empty());
+  BOOST_TEST(other.channelDeposit(3U).empty());
+
+} // LookupTest()
+
+
+void RangeEdgesTest() {
+
+  std::vector<sim::SimChannel> const channels = makeFixedChannels();
+  Index_t const index{ channels };
+
+  // the first tick is included, the end tick is not
+  checkDeposit(index.deposit(3U, 10U, 11U), 108.0, 1.25);
+  checkDeposit(index.deposit(3U,  9U, 10U),   0.0, 0.0);
+  checkDeposit(index.deposit(3U, 11U, 20U),   0.0, 0.0);
+  checkDeposit(index.deposit(3U, 10U, 20U), 108.0, 1.25);
+  checkDeposit(index.deposit(3U, 10U, 21U), 308.0, 3.25);
+  checkDeposit(index.deposit(3U, 11U, 21U), 200.0, 2.0);
+  checkDeposit(index.deposit(3U, 20U, 35U), 200.0, 2.0);
+  checkDeposit(index.deposit(3U, 20U, 36U), 600.0, 6.0);
+  checkDeposit(index.deposit(3U, 35U, 36U), 400.0, 4.0);
+  checkDeposit(index.deposit(3U, 36U, 1000U), 0.0, 0.0);
+  checkDeposit(index.deposit(3U, 0U, 1000U), 708.0, 7.25);
+
+  // empty and inverted ranges
+  BOOST_TEST(index.deposit(3U, 20U, 20U).empty());
+  BOOST_TEST(index.deposit(3U, 36U, 10U).empty());
+
+  // the range of a channel does not include the neighbouring ones
+  BOOST_TEST(index.deposit(5U, 0U, 100000U).empty());
+
+  // first and last ticks
+  checkDeposit(index.deposit(7U, 0U, 1U), 16.0, 0.5);
+  checkDeposit(index.deposit(7U, 1U, 65535U), 0.0, 0.0);
+  checkDeposit(index.deposit(7U, 65535U, 65536U), 32.0, 1.5);
+  checkDeposit(
+    index.deposit(7U, 0U, std::numeric_limits<TDC_t>::max()), 48.0, 2.0
+    );
+
+} // RangeEdgesTest()
+
+
+void MinEnergyTest() {
+
+  std::vector<sim::SimChannel> const channels = makeFixedChannels();
+
+  // the deposit of 0.25 MeV at tick 10 of channel 3 is dropped
+  Index_t const index{ channels, 0.5 };
+  checkDeposit(index.channelDeposit(3U), 700.0, 7.0);
+  checkDeposit(index.deposit(3U, 10U, 11U), 100.0, 1.0);
+  checkDeposit(index.channelDeposit(7U), 48.0, 2.0);
+
+  // a tick with all its deposits dropped is still there, with no deposit
+  Index_t const highIndex{ channels, 1.5 };
+  BOOST_TEST(highIndex.deposit(3U, 10U, 11U).empty());
+  checkDeposit(highIndex.deposit(3U, 10U, 21U), 200.0, 2.0);
+  checkDeposit(highIndex.channelDeposit(7U), 32.0, 1.5);
+
+} // MinEnergyTest()
+
+
+void PointerCollectionTest() {
+
+  std::vector<sim::SimChannel> const channels = makeFixedChannels();
+
+  // a channel repeated in the collection is indexed with its last appearance
+  sim::SimChannel repeated{ 3U };
+  addDeposit(repeated, 50U, 1.0, 0.5);
+
+  std::vector<sim::SimChannel const*> const pointers
+    { &channels[0], nullptr, &channels[2], &repeated, &channels[1] };
+  Index_t const index{ pointers };
+
+  BOOST_TEST(index.simChannel(3U) == &repeated);
+  BOOST_TEST(index.simChannel(5U) == &channels[1]);
+  BOOST_TEST(index.simChannel(7U) == &channels[2]);
+  checkDeposit(index.channelDeposit(3U), 1.0, 0.5);
+  BOOST_TEST(index.deposit(3U, 0U, 50U).empty());
+  checkDeposit(index.deposit(3U, 50U, 51U), 1.0, 0.5);
+  checkDeposit(index.channelDeposit(7U), 48.0, 2.0);
+
+} // PointerCollectionTest()
+
+
+void RandomRangesTest() {
+
+  std::mt19937 engine{ 20261019U };
+  std::uniform_int_distribution<unsigned int> nTicksDist{ 0U, 40U };
+  std::uniform_int_distribution<TDC_t> tdcDist{ 0U, 200U };
+  std::uniform_int_distribution<unsigned int> nIDEDist{ 1U, 3U };
+  std::uniform_real_distribution<double> energyDist{ 0.0, 2.0 };
+
+  // channels in no particular order, with some gaps
+  std::vector<sim::SimChannel> channels;
+  for (raw::ChannelID_t const channel: { 12U, 2U, 3U, 30U, 0U, 17U, 8U }) {
+    sim::SimChannel& simChannel = channels.emplace_back(channel);
+    unsigned int const nTicks = nTicksDist(engine);
+    for (unsigned int i = 0; i < nTicks; ++i) {
+      TDC_t const tdc = tdcDist(engine);
+      unsigned int const nIDE = nIDEDist(engine);
+      for (unsigned int j = 0; j < nIDE; ++j) {
+        double const energy = energyDist(engine);
+        addDeposit(simChannel, tdc, 1000.0 * energy, energy);
+      }
+    } // for ticks
+  } // for channels
+
+  for (double const minEnergy: { std::numeric_limits<double>::lowest(), 0.8 })
+  {
+    Index_t const index{ channels, minEnergy };
+    for (sim::SimChannel const& simChannel: channels) {
+      raw::ChannelID_t const channel = simChannel.Channel();
+      for (unsigned int i = 0; i < 100U; ++i) {
+        TDC_t const firstTDC = tdcDist(engine);
+        TDC_t const endTDC = tdcDist(engine);
+        BOOST_TEST_CONTEXT("channel: " << channel << ", min energy: "
+          << minEnergy << ", TDC: [ " << firstTDC << " ; " << endTDC << " [")
+        {
+          Deposit_t const dep = index.deposit(channel, firstTDC, endTDC);
+          Deposit_t const expected
+            = referenceDeposit(simChannel, firstTDC, endTDC, minEnergy);
+          BOOST_TEST(dep.numElectrons == expected.numElectrons,
+            boost::test_tools::tolerance(1e-9));
+          BOOST_TEST(dep.energy == expected.energy,
+            boost::test_tools::tolerance(1e-9));
+        } // context
+      } // for ranges
+    } // for channels
+  } // for minimum energies
+
+} // RandomRangesTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(Lookup_testCase) {
+  LookupTest();
+} // BOOST_AUTO_TEST_CASE(Lookup_testCase)
+
+BOOST_AUTO_TEST_CASE(RangeEdges_testCase) {
+  RangeEdgesTest();
+} // BOOST_AUTO_TEST_CASE(RangeEdges_testCase)
+
+BOOST_AUTO_TEST_CASE(MinEnergy_testCase) {
+  MinEnergyTest();
+} // BOOST_AUTO_TEST_CASE(MinEnergy_testCase)
+
+BOOST_AUTO_TEST_CASE(PointerCollection_testCase) {
+  PointerCollectionTest();
+} // BOOST_AUTO_TEST_CASE(PointerCollection_testCase)
+
+BOOST_AUTO_TEST_CASE(RandomRanges_testCase) {
+  RandomRangesTest();
+} // BOOST_AUTO_TEST_CASE(RandomRanges_testCase)
+
+
+// -----------------------------------------------------------------------------
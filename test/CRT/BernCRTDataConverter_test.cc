@@ -0,0 +1,219 @@
+/**
+ * @file   test/CRT/BernCRTDataConverter_test.cc
+ * @brief  Unit test for the conversion of BernCRT hits into CRT data.
+ * @see    `icaruscode/CRT/CRTDecoder/BernCRTDataConverter.h`
+ *
+ * The parallel conversion is checked to give exactly the same result as the
+ * sequential one on synthetic hits from side and top CRT boards.
+ */
+
+// ICARUS libraries
+#include "icaruscode/CRT/CRTDecoder/BernCRTDataConverter.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+#include "tbb/global_control.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( BernCRTDataConverter_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard library
+#include <algorithm> // std::is_sorted()
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+using Converter_t = icarus::crt::BernCRTDataConverter;
+
+/// Side CRT boards, including the ones with special channel mapping.
+std::vector<std::uint8_t> const SideMacs
+  { 1, 2, 3, 6, 7, 10, 21, 35, 48, 60, 88, 89, 90, 91, 96, 97 };
+
+/// Top CRT boards.
+std::vector<std::uint8_t> const TopMacs { 105, 110, 122, 131, 140 };
+
+
+/// Returns a converter with synthetic mapping and delays.
+Converter_t makeConverter() {
+
+  Converter_t::Delays_t sideDelays, topDelays;
+  for (std::uint8_t const mac: SideMacs) sideDelays[mac] = 200 + 3 * mac;
+  for (std::uint8_t const mac: TopMacs) topDelays[mac] = 150 + mac;
+
+  return Converter_t{
+    // side: identity, except board 3 which has no valid simulation address
+    [](unsigned int mac5){ return (mac5 == 3)? 0U: mac5; },
+    // top: shifted
+    [](unsigned int mac5){ return mac5 + 100U; },
+    std::move(sideDelays), std::move(topDelays)
+    };
+
+} // makeConverter()
+
+
+/// Returns `nHits` synthetic hits, with many timestamp ties.
+std::vector<Converter_t::Hit_t> makeHits(std::size_t nHits, unsigned int seed)
+{
+  std::mt19937 engine{ seed };
+  std::uniform_int_distribution<std::size_t> pickSide{ 0, SideMacs.size() - 1 };
+  std::uniform_int_distribution<std::size_t> pickTop{ 0, TopMacs.size() - 1 };
+  std::uniform_int_distribution<int> ts0{ 0, 999 }; // few values: many ties
+  std::uniform_int_distribution<int> adc{ 0, 4095 };
+  std::bernoulli_distribution isSide{ 0.8 };
+
+  std::uint64_t const pollTime = 1'650'000'000'000'000'000ULL;
+
+  std::vector<Converter_t::Hit_t> hits(nHits);
+  for (Converter_t::Hit_t& hit: hits) {
+    bool const side = isSide(engine);
+    hit.fragment_ID = side? 0x3100: 0x3000;
+    hit.mac5 = side? SideMacs[pickSide(engine)]: TopMacs[pickTop(engine)];
+    hit.flags = 0; // neither T0 nor T1 reference
+    hit.ts0 = ts0(engine) * 1'000'000;
+    hit.ts1 = hit.ts0 / 2;
+    hit.coinc = 0;
+    hit.lost_hits = 0;
+    hit.hits_in_poll = nHits;
+    hit.last_accepted_timestamp = 0;
+    hit.last_poll_start = pollTime;
+    hit.this_poll_start = pollTime + 100'000'000ULL;
+    hit.this_poll_end = pollTime + 200'000'000ULL;
+    for (auto& value: hit.adc) value = adc(engine);
+  } // for
+
+  return hits;
+} // makeHits()
+
+
+/// Checks that two data collections are identical.
+void checkSameData(
+  std::vector<Converter_t::Data_t> const& data,
+  std::vector<Converter_t::Data_t> const& expected
+) {
+  BOOST_TEST_REQUIRE(data.size() == expected.size());
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    BOOST_TEST_CONTEXT("data #" << i) {
+      BOOST_TEST(data[i].fMac5 == expected[i].fMac5);
+      BOOST_TEST(data[i].fTs0 == expected[i].fTs0);
+      BOOST_TEST(data[i].fTs1 == expected[i].fTs1);
+      BOOST_TEST(data[i].fFlags == expected[i].fFlags);
+      BOOST_TEST(data[i].fThisPollStart == expected[i].fThisPollStart);
+      BOOST_TEST(data[i].fLastPollStart == expected[i].fLastPollStart);
+      BOOST_TEST(data[i].fCoinc == expected[i].fCoinc);
+      for (std::size_t ch = 0; ch < 32; ++ch)
+        BOOST_TEST(data[i].fAdc[ch] == expected[i].fAdc[ch]);
+    }
+  } // for
+} // checkSameData()
+
+
+// -----------------------------------------------------------------------------
+// --- BernCRTDataConverter tests
+// -----------------------------------------------------------------------------
+void ParallelTest() {
+
+  Converter_t const converter = makeConverter();
+  std::vector<Converter_t::Hit_t> const hits = makeHits(20000U, 1234U);
+
+  std::vector<Converter_t::Data_t> const serial = converter.convert(hits);
+  BOOST_TEST(!serial.empty());
+
+  for (std::size_t const nThreads: { 1U, 2U, 4U, 8U }) {
+    BOOST_TEST_CONTEXT("threads: " << nThreads) {
+      tbb::global_control const threadLimit
+        { tbb::global_control::max_allowed_parallelism, nThreads };
+      checkSameData(converter.convertParallel(hits), serial);
+    }
+  } // for threads
+
+} // ParallelTest()
+
+
+void SortingTest() {
+
+  Converter_t const converter = makeConverter();
+  std::vector<Converter_t::Hit_t> const hits = makeHits(5000U, 5678U);
+
+  std::vector<Converter_t::Data_t> const data = converter.convertParallel(hits);
+
+  auto const byMacAndTime
+    = [](Converter_t::Data_t const& a, Converter_t::Data_t const& b)
+      {
+        return (a.fMac5 < b.fMac5)
+          || ((a.fMac5 == b.fMac5) && (a.fTs0 < b.fTs0));
+      };
+  BOOST_TEST(std::is_sorted(data.begin(), data.end(), byMacAndTime));
+
+  // no data without a valid address (board 3 maps to none)
+  for (Converter_t::Data_t const& elem: data) BOOST_TEST(elem.fMac5 != 0);
+
+  // each side hit gives three data, each top hit one (minus board 3 hits)
+  std::size_t expected = 0;
+  for (Converter_t::Hit_t const& hit: hits) {
+    if (!Converter_t::IsSideCRT(hit)) ++expected;
+    else if (hit.mac5 != 3) expected += 3;
+  }
+  BOOST_TEST(data.size() == expected);
+
+} // SortingTest()
+
+
+void MappingTest() {
+
+  Converter_t const converter = makeConverter();
+
+  std::vector<Converter_t::Hit_t> hits = makeHits(2U, 42U);
+
+  // a plain side board: 3 blocks of 10 channels, from source channel 2 on
+  hits[0].fragment_ID = 0x3100;
+  hits[0].mac5 = 10;
+  for (std::size_t ch = 0; ch < 32; ++ch) hits[0].adc[ch] = ch;
+
+  // a top board: all channels copied
+  hits[1].fragment_ID = 0x3000;
+  hits[1].mac5 = 105;
+  for (std::size_t ch = 0; ch < 32; ++ch) hits[1].adc[ch] = 100 + ch;
+
+  std::vector<Converter_t::Data_t> const data = converter.convert(hits);
+  BOOST_TEST_REQUIRE(data.size() == 4U);
+
+  for (std::size_t i = 0; i < 3; ++i) {
+    BOOST_TEST(data[i].fMac5 == 10U);
+    BOOST_TEST(data[i].fTs1 == hits[0].ts1 + 230); // cable delay: 200 + 3 x 10
+  }
+  // blocks sorted by their order in the hit
+  BOOST_TEST(data[0].fAdc[0] == 2U);
+  BOOST_TEST(data[0].fAdc[9] == 11U);
+  BOOST_TEST(data[1].fAdc[10] == 12U);
+  BOOST_TEST(data[2].fAdc[29] == 31U);
+
+  BOOST_TEST(data[3].fMac5 == 205U);
+  BOOST_TEST(data[3].fTs1 == hits[1].ts1 + 255); // cable delay: 150 + 105
+  for (std::size_t ch = 0; ch < 32; ++ch)
+    BOOST_TEST(data[3].fAdc[ch] == 100U + ch);
+
+  // a board with no known delay
+  hits[1].mac5 = 99;
+  BOOST_CHECK_THROW(converter.convert(hits), cet::exception);
+
+} // MappingTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(BernCRTDataConverterParallel_testCase) {
+  ParallelTest();
+} // BOOST_AUTO_TEST_CASE(BernCRTDataConverterParallel_testCase)
+
+BOOST_AUTO_TEST_CASE(BernCRTDataConverterSorting_testCase) {
+  SortingTest();
+} // BOOST_AUTO_TEST_CASE(BernCRTDataConverterSorting_testCase)
+
+BOOST_AUTO_TEST_CASE(BernCRTDataConverterMapping_testCase) {
+  MappingTest();
+} // BOOST_AUTO_TEST_CASE(BernCRTDataConverterMapping_testCase)
+
+
+// -----------------------------------------------------------------------------
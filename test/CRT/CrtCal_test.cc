@@ -0,0 +1,305 @@
+/**
+ * @file   test/CRT/CrtCal_test.cc
+ * @brief  Unit test for the photopeak search and gain fit of `CrtCal`.
+ * @date   October 19, 2026
+ * @see    `icaruscode/CRT/CRTDecoder/CrtCal.h`
+ *
+ * `CrtCal` used to find the photopeaks of the ADC spectrum with
+ * `TSpectrum::Search()` and to fit them with binned likelihood fits, while it
+ * now uses its own peak finder and chi-square fits. This test runs the
+ * calibration on a synthetic spectrum with photopeaks at known positions, and
+ * compares the peak positions and the gain with the ones of the old
+ * algorithm, which is reproduced here with ROOT. The pedestal is the one from
+ * the new calibration in both cases, so that only the gain fit is compared.
+ * It also checks that a spectrum with many peaks in the search range does not
+ * overflow the peak lists.
+ */
+
+// ICARUS libraries
+#include "icaruscode/CRT/CRTDecoder/CrtCal.h"
+
+// ROOT libraries
+#include "TH1F.h"
+#include "TF1.h"
+#include "TGraphErrors.h"
+#include "TSpectrum.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( CrtCal_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard library
+#include <algorithm> // std::sort()
+#include <memory> // std::unique_ptr
+#include <string>
+#include <vector>
+#include <cmath> // std::exp(), std::sqrt(), std::round()
+#include <cstdlib> // std::abs()
+
+
+// -----------------------------------------------------------------------------
+using icarus::crt::CrtCal;
+
+constexpr int TestMac5 = 7;
+constexpr std::size_t TestChannel = 3;
+
+/// Features of the synthetic spectrum.
+struct Spectrum_t {
+  double pedestal;  ///< pedestal position [ADC]
+  double pedSigma;  ///< pedestal width [ADC]
+  double gain;      ///< distance between photopeaks [ADC]
+  double peakSigma; ///< width of the first photopeak [ADC]
+  double peakNorm;  ///< height of the first photopeak [counts]
+  double decay;     ///< relative height decrease from a photopeak to the next
+  unsigned int nPeaks; ///< number of photopeaks
+};
+
+
+/**
+ * @brief Returns the ADC spectrum of a channel, with no fluctuations.
+ *
+ * The histogram has the binning of the calibration modules (1 ADC per bin).
+ * The content is the pedestal, a sequence of photopeaks with widths growing
+ * with the photoelectron number, and a smooth background extending above
+ * 600 ADC, which makes the channel active.
+ */
+std::unique_ptr<TH1F> makeSpectrum(Spectrum_t const& spec) {
+
+  std::string const name
+    = "hadc_" + std::to_string(TestMac5) + "_" + std::to_string(TestChannel);
+  auto hist = std::make_unique<TH1F>(name.c_str(), name.c_str(), 4100, 0, 4100);
+  hist->SetDirectory(nullptr);
+
+  auto const gaus = [](double x, double mean, double sigma)
+    { double const u = (x - mean) / sigma; return std::exp(-0.5 * u * u); };
+
+  for (int bin = 1; bin <= hist->GetNbinsX(); ++bin) {
+    double const x = hist->GetBinCenter(bin);
+    double content = 20000.0 * gaus(x, spec.pedestal, spec.pedSigma);
+    for (unsigned int k = 1; k <= spec.nPeaks; ++k) {
+      double const sigma = std::sqrt(spec.peakSigma * spec.peakSigma
+        + (k - 1) * spec.pedSigma * spec.pedSigma);
+      content += spec.peakNorm * std::exp(-spec.decay * (k - 1))
+        * gaus(x, spec.pedestal + k * spec.gain, sigma);
+    } // for peaks
+    if (x > spec.pedestal + 2.0 * spec.gain)
+      content += 40.0 * std::exp(-(x - spec.pedestal) / 800.0);
+    content = std::round(content);
+    hist->SetBinContent(bin, content);
+    hist->SetBinError(bin, std::sqrt(content));
+  } // for
+  hist->SetEntries(hist->Integral(0, hist->GetNbinsX() + 1));
+
+  return hist;
+} // makeSpectrum()
+
+
+/// Results of the old gain calibration.
+struct ReferenceGain_t {
+  std::vector<double> peaks;     ///< photopeak candidates [ADC]
+  std::vector<double> peakMeans; ///< means of the accepted photopeak fits
+  double gain = 0.0;
+  double gainPed = 0.0;
+};
+
+
+/**
+ * @brief The gain calibration of `CrtCal` before the removal of `TSpectrum`.
+ * @param spectrum the ADC spectrum of the channel (not modified)
+ * @param ped the pedestal of the channel [ADC]
+ * @param pedSigma the pedestal width of the channel [ADC]
+ * @return the photopeak candidates, the fitted peaks and the gain
+ *
+ * This is the same algorithm as the old `CrtCal::GainFit()`, without the
+ * plots: `TSpectrum::Search()` on the rebinned spectrum, binned likelihood
+ * fits of the candidates and the linear fit of their positions.
+ */
+ReferenceGain_t referenceGainFit
+  (TH1F const& spectrum, double ped, double pedSigma)
+{
+  float const gainSeed = 55.0;
+  double const tSpectrumSigma = 1.75;
+  double const tSpectrumThreshold = 0.18;
+  int const nPeakMax = 5;
+
+  std::unique_ptr<TH1F> h{ static_cast<TH1F*>(spectrum.Clone()) };
+  h->SetDirectory(nullptr);
+  h->Rebin(4);
+  h->GetXaxis()->SetRangeUser(350, 700);
+
+  TSpectrum s;
+  int const nPeak
+    = s.Search(h.get(), tSpectrumSigma, "goff", tSpectrumThreshold);
+
+  ReferenceGain_t result;
+  result.peaks.assign(s.GetPositionX(), s.GetPositionX() + nPeak);
+  std::sort(result.peaks.begin(), result.peaks.end());
+  std::vector<double> const& y = result.peaks;
+  if (nPeak == 0) return result;
+
+  std::vector<float> x(nPeak);
+  float gx[nPeakMax + 1], gy[nPeakMax + 1], gey[nPeakMax + 1];
+  int const peak_offset = std::round((y[0] - ped) / gainSeed);
+  for (int j = 0; j < nPeak; ++j) x[j] = j + peak_offset;
+
+  int gg = 1;
+  int nplow = 0;
+  gx[0] = 0;
+  gy[0] = ped;
+  gey[0] = pedSigma;
+
+  for (int g = 0; g < nPeak && g < nPeakMax; ++g) {
+    TF1 gfit("gfit", "gaus", y[g] - 20, y[g] + 20);
+    gfit.SetParameter(0, h->GetBinContent(h->FindBin(y[g])));
+    gfit.SetParameter(1, y[g]);
+    gfit.SetParameter(2, 12);
+    gfit.SetParLimits(0, 0, 20000);
+    gfit.SetParLimits(1, y[g] - 15, y[g] + 15);
+    gfit.SetParLimits(2, 8, 40);
+    h->Fit(&gfit, "MQLRN0");
+
+    if (y[g] < h->GetBinLowEdge(1) + 15) nplow++;
+
+    if (y[g] > h->GetBinLowEdge(1) + 15
+      && y[g] < h->GetBinLowEdge(h->GetNbinsX()) - 15
+      && std::abs(y[g] - gfit.GetParameter(1)) < 15
+    ) {
+      if (g != 0 && g != nPeak - 1
+        && (y[g+1] - y[g] < gainSeed*0.7 || y[g] - y[g-1] < gainSeed*0.7))
+      {
+        for (int j = g; j < nPeak; ++j) x[j] = x[j] - 1;
+      }
+      else {
+        if (g != 0 && g != nPeak - 1 && y[g+1] - y[g] < gainSeed*1.2
+          && y[g] - y[g-1] > gainSeed*1.5)
+        {
+          for (int j = g; j < nPeak; ++j) x[j] = x[j] + 1;
+        }
+        if (g != 0 && g == nPeak - 1 && (y[g] - y[g-1]) / gainSeed > 1.5)
+          x[g] += (int)((y[g] - y[g-1]) / gainSeed);
+
+        result.peakMeans.push_back(gfit.GetParameter(1));
+        gx[gg] = x[g];
+        gy[gg] = gfit.GetParameter(1);
+        gey[gg] = std::sqrt(gx[gg] + gey[0]*gey[0]);
+        gg++;
+      }
+    }
+  } // for peaks
+
+  if (nplow > 0) for (int i = 1; i < gg; ++i) gx[i] = gx[i] - (nplow - 1);
+
+  TF1 fit("fit", "[0] + [1]*x", gx[0] - 0.25, gx[gg-1] + 0.25);
+  fit.SetParameter(1, gainSeed);
+  fit.SetParameter(0, ped);
+  fit.SetParLimits(1, gainSeed - 20, gainSeed + 20);
+  fit.SetParLimits(0, ped*0.8, ped*1.2);
+
+  auto const fitGain = [&](){
+    TGraphErrors graph(gg, gx, gy, nullptr, gey);
+    fit.SetRange(gx[0] - 0.25, gx[gg-1] + 0.25);
+    graph.Fit(&fit, "QRN0");
+  };
+  fitGain();
+
+  if (fit.GetChisquare() / fit.GetNDF() > 5.0) {
+    double chisqr = fit.GetChisquare();
+    for (int i = 1; i < gg; ++i) gx[i] += 1;
+    fitGain();
+    if (fit.GetChisquare() < chisqr) chisqr = fit.GetChisquare();
+    else {
+      for (int i = 1; i < gg; ++i) gx[i] -= 2;
+      fitGain();
+      if (fit.GetChisquare() >= chisqr) {
+        for (int i = 1; i < gg; ++i) gx[i] += 1;
+        fitGain();
+      }
+    }
+  }
+
+  result.gain = fit.GetParameter(1);
+  result.gainPed = fit.GetParameter(0);
+  return result;
+} // referenceGainFit()
+
+
+// -----------------------------------------------------------------------------
+// --- Tests
+// -----------------------------------------------------------------------------
+void ReferenceComparisonTest() {
+
+  // photopeaks at 240, 300, ... 720 ADC: six in the search range [ 350, 700 ]
+  Spectrum_t const spec{ 180.0, 6.0, 60.0, 10.0, 3000.0, 0.1, 9U };
+  std::unique_ptr<TH1F> const hist = makeSpectrum(spec);
+
+  std::vector<TH1F*> const histos{ hist.get() };
+  CrtCal cal{ &histos, false };
+  cal.Cal();
+
+  BOOST_TEST_REQUIRE(cal.GetActive()[TestChannel]);
+  double const ped = cal.GetPed()[TestChannel];
+  double const pedSigma = cal.GetPedSigma()[TestChannel];
+  BOOST_TEST(ped == spec.pedestal, boost::test_tools::tolerance(0.01));
+
+  ReferenceGain_t const expected = referenceGainFit(*hist, ped, pedSigma);
+
+  // same candidates, within a bin of the rebinned spectrum
+  std::vector<double> const& peaks = cal.GetPeakPos(TestChannel);
+  BOOST_TEST_REQUIRE(expected.peaks.size() == 6U);
+  BOOST_TEST_REQUIRE(peaks.size() == expected.peaks.size());
+  for (std::size_t i = 0; i < peaks.size(); ++i) {
+    BOOST_TEST_CONTEXT("peak #" << i) {
+      BOOST_TEST(std::abs(peaks[i] - expected.peaks[i]) < 4.0);
+      BOOST_TEST(std::abs(peaks[i] - (spec.pedestal + (i + 3) * spec.gain)) < 4.0);
+    }
+  } // for
+
+  // same fitted peaks (the first entry of the lists is the pedestal, and
+  // there is room for four peaks only)
+  BOOST_TEST(cal.GetNpeak()[TestChannel] == (short) expected.peaks.size());
+  float const* peakMeans = cal.GetPeakMean()[TestChannel];
+  BOOST_TEST(expected.peakMeans.size() >= 4U);
+  for (std::size_t i = 0; i < std::min(expected.peakMeans.size(), std::size_t{ 4 }); ++i) {
+    BOOST_TEST_CONTEXT("fitted peak #" << i) {
+      BOOST_TEST(std::abs(peakMeans[i + 1] - expected.peakMeans[i]) < 2.0);
+    }
+  } // for
+
+  // same gain, and close to the true one
+  double const gain = cal.GetGain()[TestChannel];
+  BOOST_TEST(gain == expected.gain, boost::test_tools::tolerance(0.02));
+  BOOST_TEST(gain == spec.gain, boost::test_tools::tolerance(0.02));
+  BOOST_TEST(cal.GetGainPed()[TestChannel] == expected.gainPed,
+    boost::test_tools::tolerance(0.02));
+
+} // ReferenceComparisonTest()
+
+
+void ManyPeaksTest() {
+
+  // photopeaks every 25 ADC: fourteen in the search range [ 350, 700 ]
+  Spectrum_t const spec{ 180.0, 2.0, 25.0, 4.0, 2000.0, 0.05, 30U };
+  std::unique_ptr<TH1F> const hist = makeSpectrum(spec);
+
+  std::vector<TH1F*> const histos{ hist.get() };
+  CrtCal cal{ &histos, false };
+  cal.Cal();
+
+  BOOST_TEST_REQUIRE(cal.GetActive()[TestChannel]);
+  BOOST_TEST(cal.GetPeakPos(TestChannel).size() > 10U);
+  BOOST_TEST(cal.GetNpeak()[TestChannel] > 10);
+
+} // ManyPeaksTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ReferenceComparison_testCase) {
+  ReferenceComparisonTest();
+} // BOOST_AUTO_TEST_CASE(ReferenceComparison_testCase)
+
+BOOST_AUTO_TEST_CASE(ManyPeaks_testCase) {
+  ManyPeaksTest();
+} // BOOST_AUTO_TEST_CASE(ManyPeaks_testCase)
+
+
+// -----------------------------------------------------------------------------
@@ -156,6 +156,94 @@ void KeyedCSVparser_documentation_test() {
 } // KeyedCSVparser_documentation_test()
 
 
+// -----------------------------------------------------------------------------
+void KeyedCSVparser_knownKeys_test() {
+  
+  /*
+   * Known keys must behave like patterns matching only themselves,
+   * and they take precedence over the patterns.
+   */
+  using namespace std::string_view_literals;
+  icarus::details::KeyedCSVparser parser;
+  parser.addKeys({
+        { "Cryo1 EAST Connector 0 and 1", 1U }
+      , { "Trigger Type", 1U }
+    });
+  parser.addPattern("Cryo1 EAST .*", 2U); // shadowed by the key above
+  
+  icarus::KeyValuesData const data = parser(
+    "Trigger Type, S5, Cryo1 EAST Connector 0 and 1, A00000F0,"
+    " Cryo1 EAST counts, 3, Gate ID, 12\n"sv
+    );
+  
+  std::cout << data << std::endl;
+  
+  BOOST_TEST(data.size() == 4U);
+  
+  BOOST_TEST(data.getItem("Trigger Type").nValues() == 1U);
+  BOOST_TEST(data.getItem("Trigger Type").value() == "S5");
+  
+  auto const& connector = data.getItem("Cryo1 EAST Connector 0 and 1");
+  BOOST_TEST(connector.nValues() == 1U);
+  BOOST_TEST(connector.getNumber<std::uint64_t>(0, 16) == 0xA00000F0);
+  
+  auto const& counts = data.getItem("Cryo1 EAST counts"sv);
+  BOOST_TEST(counts.nValues() == 2U);
+  BOOST_TEST(counts.getNumber<int>(0) == 3);
+  BOOST_TEST(counts.value(1) == "Gate ID");
+  
+  BOOST_TEST(data.getItem("12").values().empty());
+  
+} // KeyedCSVparser_knownKeys_test()
+
+
+// -----------------------------------------------------------------------------
+void KeyedCSVparser_itemCallback_test() {
+  
+  /*
+   * The callback must be called once per item, in order, and only after all
+   * the values of the item have been parsed.
+   */
+  using namespace std::string_view_literals;
+  icarus::details::KeyedCSVparser parser;
+  parser.addKey("Trigger Type", 1U);
+  
+  std::vector<std::string> keys;
+  std::vector<std::size_t> nValues;
+  long int gateID = 0;
+  
+  icarus::KeyValuesData data;
+  parser.parse(
+    "WR_TS1, 0000000012, 1654629426, 359093500, Trigger Type, S5,"
+    " Gate ID, 0000000034\n"sv,
+    data,
+    [&](icarus::KeyValuesData::Item const& item)
+      {
+        keys.push_back(item.key());
+        nValues.push_back(item.nValues());
+        if (item.key() == "Gate ID") gateID = item.getNumber<long int>(0);
+      }
+    );
+  
+  std::vector<std::string> const expectedKeys
+    { "WR_TS1", "Trigger Type", "Gate ID" };
+  std::vector<std::size_t> const expectedValues{ 3U, 1U, 1U };
+  BOOST_TEST(keys == expectedKeys, boost::test_tools::per_element());
+  BOOST_TEST(nValues == expectedValues, boost::test_tools::per_element());
+  BOOST_TEST(gateID == 34L);
+  
+  BOOST_TEST(data.size() == 3U);
+  BOOST_TEST(data.getItem("WR_TS1").getNumber<long int>(0) == 12L);
+  
+  // no items, no calls
+  icarus::KeyValuesData empty;
+  unsigned int nCalls = 0U;
+  parser.parse(""sv, empty, [&nCalls](auto const&){ ++nCalls; });
+  BOOST_TEST(nCalls == 0U);
+  
+} // KeyedCSVparser_itemCallback_test()
+
+
 // -----------------------------------------------------------------------------
 // BEGIN Test cases  -----------------------------------------------------------
 // -----------------------------------------------------------------------------
@@ -166,6 +254,20 @@ BOOST_AUTO_TEST_CASE(KeyedCSVparser_documentation_testcase) {
 } // BOOST_AUTO_TEST_CASE(KeyedCSVparser_documentation_testcase)
 
 
+BOOST_AUTO_TEST_CASE(KeyedCSVparser_knownKeys_testcase) {
+  
+  KeyedCSVparser_knownKeys_test();
+  
+} // BOOST_AUTO_TEST_CASE(KeyedCSVparser_knownKeys_testcase)
+
+
+BOOST_AUTO_TEST_CASE(KeyedCSVparser_itemCallback_testcase) {
+  
+  KeyedCSVparser_itemCallback_test();
+  
+} // BOOST_AUTO_TEST_CASE(KeyedCSVparser_itemCallback_testcase)
+
+
 // -----------------------------------------------------------------------------
 // END Test cases  -------------------------------------------------------------
 // -----------------------------------------------------------------------------
@@ -0,0 +1,149 @@
+/**
+ * @file   test/Decode/DecoderTools/TriggerDataParserV3_test.cc
+ * @brief  Unit test for `icarus::details::TriggerDataParserV3`.
+ * @date   October 19, 2026
+ * @see    `icaruscode/Decode/DecoderTools/details/TriggerDataParserV3.h`
+ *
+ * A trigger data packet in the V3 format, with the layout of the ones written
+ * by the trigger board reader, is decoded end to end, and both the
+ * `icarus::ICARUSTriggerInfo` fields and the items used by the decoder are
+ * compared with the values in the packet.
+ */
+
+// ICARUS libraries
+#include "icaruscode/Decode/DecoderTools/details/TriggerDataParserV3.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( TriggerDataParserV3_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard library
+#include <string>
+#include <string_view>
+#include <cstdint> // std::uint64_t
+
+
+// -----------------------------------------------------------------------------
+using namespace std::string_view_literals;
+
+/// A data packet in the V3 format (a majority trigger in a BNB gate).
+constexpr std::string_view TriggerPacket =
+  "Local_TS1, 0000000012, 1654629426, 359093610,"
+  " WR_TS1, 0000000012, 1654629426, 359093500,"
+  " Enable Type, 04, Enable_TS, 0000000012, 1654629426, 359060500,"
+  " Gate ID, 0000000034, Gate Type, 1,"
+  " Beam_TS, 0000000034, 1654629426, 359091900,"
+  " BNB Gate ID, 0000000021, NuMI Gate ID, 0000000008,"
+  " Offbeam BNB Gate ID, 0000000003, Offbeam NuMI Gate ID, 0000000002,"
+  " Calib Gate ID, 0000000000,"
+  " Trigger Type, 0, Trigger Source, 1,"
+  " Cryo1 EAST Connector 0 and 1, 00fe000000000800,"
+  " Cryo1 EAST Connector 2 and 3, 0000040000000000,"
+  " Cryo2 WEST Connector 0 and 1, 0000000000000000,"
+  " Cryo2 WEST Connector 2 and 3, 0000000000000000,"
+  " Cryo1 EAST counts, 0000000011, Cryo2 WEST counts, 0000000001,"
+  " MJ_Adder Source EAST, 2, MJ_Adder Source WEST, 2"sv;
+
+
+// -----------------------------------------------------------------------------
+// --- Tests
+// -----------------------------------------------------------------------------
+void TriggerPacketTest() {
+
+  icarus::details::TriggerDataParserV3 const parser;
+  icarus::details::TriggerDataParserV3::Parsed_t const parsed
+    = parser(TriggerPacket);
+
+  icarus::ICARUSTriggerInfo const& info = parsed.info;
+  BOOST_TEST(info.wr_event_no == 12);
+  BOOST_TEST(info.gate_id == 34);
+  BOOST_TEST(info.gate_type == 1);
+  BOOST_TEST(info.gate_id_BNB == 21);
+  BOOST_TEST(info.gate_id_NuMI == 8);
+  BOOST_TEST(info.gate_id_BNBOff == 3);
+  BOOST_TEST(info.gate_id_NuMIOff == 2);
+  BOOST_TEST(info.trigger_type == 0);
+
+  icarus::KeyValuesData const& data = parsed.data;
+  BOOST_TEST(data.size() == 22U);
+
+  auto const& WRtime = data.getItem("WR_TS1"sv);
+  BOOST_TEST(WRtime.nValues() == 3U);
+  BOOST_TEST(WRtime.getNumber<unsigned int>(1) == 1654629426U);
+  BOOST_TEST(WRtime.getNumber<unsigned int>(2) == 359093500U);
+
+  auto const& beamTime = data.getItem("Beam_TS"sv);
+  BOOST_TEST(beamTime.nValues() == 3U);
+  BOOST_TEST(beamTime.getNumber<unsigned int>(0) == 34U);
+  BOOST_TEST(beamTime.getNumber<unsigned int>(2) == 359091900U);
+
+  BOOST_TEST(data.getItem("Enable_TS"sv).getNumber<unsigned int>(2)
+    == 359060500U);
+  BOOST_TEST(data.getItem("Trigger Source"sv).getNumber<int>(0) == 1);
+  BOOST_TEST(data.getItem("MJ_Adder Source EAST"sv).getNumber<int>(0) == 2);
+  BOOST_TEST
+    (data.getItem("Cryo1 EAST counts"sv).getNumber<unsigned long int>(0) == 11UL);
+
+  // connector words are hexadecimal, and may start with a letter
+  auto const& connector01 = data.getItem("Cryo1 EAST Connector 0 and 1"sv);
+  BOOST_TEST(connector01.nValues() == 1U);
+  BOOST_TEST
+    (connector01.getNumber<std::uint64_t>(0, 16) == 0x00fe000000000800ULL);
+  BOOST_TEST(
+    data.getItem("Cryo1 EAST Connector 2 and 3"sv).getNumber<std::uint64_t>(0, 16)
+    == 0x0000040000000000ULL
+    );
+  BOOST_TEST(
+    data.getItem("Cryo2 WEST Connector 0 and 1"sv).getNumber<std::uint64_t>(0, 16)
+    == 0ULL
+    );
+
+  // the packet is parsed again, with the same result
+  icarus::details::TriggerDataParserV3::Parsed_t const again
+    = parser(TriggerPacket);
+  BOOST_TEST(again.info.gate_id == info.gate_id);
+  BOOST_TEST(again.data.size() == data.size());
+
+} // TriggerPacketTest()
+
+
+void MissingKeysTest() {
+
+  icarus::details::TriggerDataParserV3 const parser;
+
+  // each of the keys needed in `ICARUSTriggerInfo` is required
+  std::string const packet{ TriggerPacket };
+  for (std::string_view const key
+    : icarus::details::TriggerDataParserV3::TriggerInfoKeys
+  ) {
+    std::string missing = packet;
+    std::string const tag = " " + std::string{ key } + ",";
+    std::size_t const pos = missing.find(tag);
+    BOOST_TEST_REQUIRE(pos != std::string::npos);
+    missing.replace(pos + 1, key.size(), "Unused");
+    BOOST_TEST_CONTEXT("missing key: '" << key << "'") {
+      BOOST_CHECK_THROW(parser(missing), icarus::KeyValuesData::ItemNotFound);
+    }
+  } // for
+
+  // a value which is not a number
+  std::string wrongGate = packet;
+  std::size_t const pos = wrongGate.find("Gate Type, 1");
+  BOOST_TEST_REQUIRE(pos != std::string::npos);
+  wrongGate.replace(pos, 12, "Gate Type, X");
+  BOOST_CHECK_THROW(parser(wrongGate), icarus::KeyValuesData::Error);
+
+} // MissingKeysTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(TriggerPacket_testCase) {
+  TriggerPacketTest();
+} // BOOST_AUTO_TEST_CASE(TriggerPacket_testCase)
+
+BOOST_AUTO_TEST_CASE(MissingKeys_testCase) {
+  MissingKeysTest();
+} // BOOST_AUTO_TEST_CASE(MissingKeys_testCase)
+
+
+// -----------------------------------------------------------------------------
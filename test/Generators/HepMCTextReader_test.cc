@@ -0,0 +1,291 @@
+/**
+ * @file   test/Generators/HepMCTextReader_test.cc
+ * @brief  Unit test for `evgen::HepMCTextReader`.
+ * @date   October 19, 2026
+ * @see    `icaruscode/Generators/HepMCTextReader.h`
+ *
+ * A small text file is generated, then read back both buffered and
+ * memory-mapped, sequentially and jumping between events. The buffered reader
+ * is also run with read blocks much smaller than the events and the lines, so
+ * that lines and events span several blocks and seeks leave the buffer.
+ */
+
+// ICARUS libraries
+#include "icaruscode/Generators/HepMCTextReader.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( HepMCTextReader_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard library
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+using Reader_t = evgen::HepMCTextReader;
+
+
+/// Returns `nEvents` events with random particles.
+std::vector<Reader_t::Event_t> makeEvents(std::size_t nEvents) {
+
+  std::mt19937 engine{ 2468U };
+  std::uniform_int_distribution<std::size_t> nParticles{ 0U, 12U };
+  std::uniform_int_distribution<int> status{ 0, 1 };
+  std::uniform_int_distribution<int> pdg{ -2212, 2212 };
+  std::uniform_int_distribution<int> index{ 0, 12 };
+  std::normal_distribution<double> momentum{ 0.0, 0.5 };
+  std::uniform_real_distribution<double> position{ -1000.0, 1000.0 };
+  std::uniform_real_distribution<double> time{ -1.0e6, 1.0e6 };
+
+  std::vector<Reader_t::Event_t> events(nEvents);
+  for (std::size_t iEvent = 0; iEvent < nEvents; ++iEvent) {
+    Reader_t::Event_t& event = events[iEvent];
+    event.number = iEvent;
+    event.particles.resize(nParticles(engine));
+    for (Reader_t::Particle_t& particle: event.particles) {
+      particle.status = status(engine);
+      particle.pdg = pdg(engine);
+      particle.firstMother = index(engine);
+      particle.secondMother = index(engine);
+      particle.firstDaughter = index(engine);
+      particle.secondDaughter = index(engine);
+      particle.xMomentum = momentum(engine);
+      particle.yMomentum = momentum(engine);
+      particle.zMomentum = momentum(engine);
+      particle.mass = std::abs(momentum(engine));
+      particle.energy = particle.mass + std::abs(momentum(engine));
+      particle.xPosition = position(engine);
+      particle.yPosition = position(engine);
+      particle.zPosition = position(engine);
+      particle.time = time(engine);
+    } // for particles
+  } // for events
+
+  return events;
+} // makeEvents()
+
+
+/// Writes `events` into a file; some irregular (but valid) spacing is added.
+void writeEvents
+  (std::string const& fileName, std::vector<Reader_t::Event_t> const& events)
+{
+  std::ofstream out{ fileName };
+  out << std::setprecision(std::numeric_limits<double>::max_digits10);
+  for (Reader_t::Event_t const& event: events) {
+    if (event.number % 7 == 3) out << "\n  \n"; // blank lines between events
+    out << event.number << " " << event.particles.size() << "\n";
+    for (Reader_t::Particle_t const& p: event.particles) {
+      out << p.status << " " << p.pdg
+        << "\t" << p.firstMother << " " << p.secondMother
+        << " " << p.firstDaughter << "  " << p.secondDaughter
+        << " " << p.xMomentum << " " << p.yMomentum << " " << p.zMomentum
+        << " " << p.energy << " " << p.mass
+        << " " << p.xPosition << " " << p.yPosition << " " << p.zPosition
+        << " " << p.time;
+      out << ((event.number % 5 == 1)? " \r\n": "\n"); // some DOS lines
+    } // for particles
+  } // for events
+} // writeEvents()
+
+
+/// Checks that `event` is identical to `expected`.
+void checkEvent
+  (Reader_t::Event_t const& event, Reader_t::Event_t const& expected)
+{
+  BOOST_TEST(event.number == expected.number);
+  BOOST_TEST_REQUIRE(event.particles.size() == expected.particles.size());
+  for (std::size_t i = 0; i < event.particles.size(); ++i) {
+    Reader_t::Particle_t const& p = event.particles[i];
+    Reader_t::Particle_t const& e = expected.particles[i];
+    BOOST_TEST_CONTEXT("event " << expected.number << " particle #" << i) {
+      BOOST_TEST(p.status == e.status);
+      BOOST_TEST(p.pdg == e.pdg);
+      BOOST_TEST(p.firstMother == e.firstMother);
+      BOOST_TEST(p.secondMother == e.secondMother);
+      BOOST_TEST(p.firstDaughter == e.firstDaughter);
+      BOOST_TEST(p.secondDaughter == e.secondDaughter);
+      BOOST_TEST(p.xMomentum == e.xMomentum);
+      BOOST_TEST(p.yMomentum == e.yMomentum);
+      BOOST_TEST(p.zMomentum == e.zMomentum);
+      BOOST_TEST(p.energy == e.energy);
+      BOOST_TEST(p.mass == e.mass);
+      BOOST_TEST(p.xPosition == e.xPosition);
+      BOOST_TEST(p.yPosition == e.yPosition);
+      BOOST_TEST(p.zPosition == e.zPosition);
+      BOOST_TEST(p.time == e.time);
+    }
+  } // for
+} // checkEvent()
+
+
+/// Returns a predicate checking that an exception message has `text`.
+auto messageHas(std::string text) {
+  return [text](cet::exception const& e)
+    {
+      BOOST_TEST_MESSAGE(e.what());
+      return std::string{ e.what() }.find(text) != std::string::npos;
+    };
+} // messageHas()
+
+
+// -----------------------------------------------------------------------------
+// --- HepMCTextReader tests
+// -----------------------------------------------------------------------------
+void RoundTripTest
+  (bool memoryMap, std::size_t blockSize = Reader_t::DefaultBlockSize)
+{
+
+  std::string const fileName = "HepMCTextReader_test_roundtrip.hepmc";
+  std::vector<Reader_t::Event_t> const events = makeEvents(50U);
+  writeEvents(fileName, events);
+
+  Reader_t reader{ fileName, memoryMap, blockSize };
+  BOOST_TEST(reader.isMemoryMapped() == memoryMap);
+  BOOST_TEST(reader.blockSize() == blockSize);
+
+  Reader_t::Event_t event;
+  for (Reader_t::Event_t const& expected: events) {
+    BOOST_TEST_REQUIRE(reader.readEvent(event));
+    checkEvent(event, expected);
+  }
+  BOOST_TEST(!reader.readEvent(event));
+  BOOST_TEST(reader.nextEvent() == events.size());
+  BOOST_TEST(reader.nIndexedEvents() == events.size());
+
+} // RoundTripTest()
+
+
+void SeekTest
+  (bool memoryMap, std::size_t blockSize = Reader_t::DefaultBlockSize)
+{
+
+  std::string const fileName = "HepMCTextReader_test_seek.hepmc";
+  std::vector<Reader_t::Event_t> const events = makeEvents(40U);
+  writeEvents(fileName, events);
+
+  Reader_t reader{ fileName, memoryMap, blockSize };
+  Reader_t::Event_t event;
+
+  // skip forward without reading (as for a job with `SkipEvents`)
+  BOOST_TEST(reader.skipEvents(17U));
+  BOOST_TEST(reader.nextEvent() == 17U);
+  BOOST_TEST_REQUIRE(reader.readEvent(event));
+  checkEvent(event, events[17]);
+
+  // back to an indexed event, then forward past the index
+  for (std::size_t const iEvent: { 4U, 30U, 0U, 18U, 39U, 17U }) {
+    BOOST_TEST_CONTEXT("event " << iEvent) {
+      BOOST_TEST(reader.seekEvent(iEvent));
+      BOOST_TEST(reader.nextEvent() == iEvent);
+      BOOST_TEST_REQUIRE(reader.readEvent(event));
+      checkEvent(event, events[iEvent]);
+    }
+  } // for
+
+  // beyond the end of the file
+  BOOST_TEST(!reader.seekEvent(events.size()));
+  BOOST_TEST(!reader.readEvent(event));
+  BOOST_TEST(reader.seekEvent(events.size() - 1));
+  BOOST_TEST(reader.readEvent(event));
+  checkEvent(event, events.back());
+
+} // SeekTest()
+
+
+void MalformedTest(bool memoryMap) {
+
+  std::string const fileName = "HepMCTextReader_test_malformed.hepmc";
+  Reader_t::Event_t event;
+
+  {
+    std::ofstream{ fileName }
+      << "0 1\n"
+      << "1 13 0 0 0 0 0. 0. 1.0 5.0011 0.105 1.0 1.0 1.0 0.0\n"
+      << "1 2\n"
+      << "1 13 0 0 0 0 0. 0. 1.0 5.0011 0.105 1.0 1.0 1.0 0.0\n"
+      << "1 13 0 0 0 0 0. 0. 1.0 5,0011 0.105 1.0 1.0 1.0 0.0\n"
+      ;
+    Reader_t reader{ fileName, memoryMap };
+    BOOST_TEST(reader.readEvent(event));
+    BOOST_CHECK_EXCEPTION(reader.readEvent(event), cet::exception,
+      messageHas("line 5: invalid or missing energy (field #10)"));
+  }
+
+  {
+    std::ofstream{ fileName }
+      << "0 1\n"
+      << "1 13 0 0 0 0 0. 0. 1.0 5.0011 0.105 1.0 1.0\n"
+      ;
+    Reader_t reader{ fileName, memoryMap };
+    BOOST_CHECK_EXCEPTION(reader.readEvent(event), cet::exception,
+      messageHas("line 2: invalid or missing z position (field #14)"));
+  }
+
+  {
+    std::ofstream{ fileName } << "0 1\n\n1 two\n";
+    Reader_t reader{ fileName, memoryMap };
+    BOOST_CHECK_EXCEPTION(reader.readEvent(event), cet::exception,
+      messageHas("line 2: invalid or missing status (field #1)"));
+  }
+
+  {
+    std::ofstream{ fileName }
+      << "0 3\n"
+      << "1 13 0 0 0 0 0. 0. 1.0 5.0011 0.105 1.0 1.0 1.0 0.0\n"
+      ;
+    Reader_t reader{ fileName, memoryMap };
+    BOOST_CHECK_EXCEPTION(reader.readEvent(event), cet::exception,
+      messageHas("file ends after 1 of the 3 particles"));
+  }
+
+  {
+    std::ofstream{ fileName } << "\n0 -1\n";
+    Reader_t reader{ fileName, memoryMap };
+    BOOST_CHECK_EXCEPTION(reader.skipEvents(1), cet::exception,
+      messageHas("line 2: invalid or missing number of particles"));
+  }
+
+  BOOST_CHECK_THROW(Reader_t("HepMCTextReader_test_nofile.hepmc", memoryMap),
+    cet::exception);
+  BOOST_CHECK_EXCEPTION(Reader_t(fileName, memoryMap, 0U), cet::exception,
+    messageHas("Invalid read block size"));
+
+} // MalformedTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(HepMCTextReaderRoundTrip_testCase) {
+  RoundTripTest(false);
+  RoundTripTest(true);
+} // BOOST_AUTO_TEST_CASE(HepMCTextReaderRoundTrip_testCase)
+
+BOOST_AUTO_TEST_CASE(HepMCTextReaderSeek_testCase) {
+  SeekTest(false);
+  SeekTest(true);
+} // BOOST_AUTO_TEST_CASE(HepMCTextReaderSeek_testCase)
+
+BOOST_AUTO_TEST_CASE(HepMCTextReaderSmallBlocks_testCase) {
+  // a particle line is about 300 characters long
+  for (std::size_t const blockSize: { 1U, 7U, 64U, 1000U }) {
+    BOOST_TEST_CONTEXT("block size: " << blockSize) {
+      RoundTripTest(false, blockSize);
+      SeekTest(false, blockSize);
+    }
+  }
+} // BOOST_AUTO_TEST_CASE(HepMCTextReaderSmallBlocks_testCase)
+
+BOOST_AUTO_TEST_CASE(HepMCTextReaderMalformed_testCase) {
+  MalformedTest(false);
+  MalformedTest(true);
+} // BOOST_AUTO_TEST_CASE(HepMCTextReaderMalformed_testCase)
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,177 @@
+/**
+ * @file   test/PMT/Algorithms/TabulatedPulseFunction_test.cc
+ * @brief  Unit test for `TabulatedPulseFunction.h` header.
+ * @date   October 19, 2026
+ * @see    `icaruscode/PMT/Algorithms/TabulatedPulseFunction.h`
+ *
+ */
+
+// ICARUS libraries
+#include "icaruscode/PMT/Algorithms/TabulatedPulseFunction.h"
+
+// LArSoft libraries
+#include "lardataalg/Utilities/quantities/spacetime.h" // nanosecond
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( TabulatedPulseFunction_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard library
+#include <sstream>
+#include <optional>
+#include <string>
+#include <limits>
+#include <cstdint> // std::uint64_t
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+using nanoseconds = util::quantities::nanosecond;
+
+/// Triangular pulse, negative, starting at 0 with peak at 10 ns.
+struct TrianglePulse
+  : public icarus::opdet::PhotoelectronPulseFunction<nanoseconds>
+{
+  virtual ADCcount doEvaluateAt(nanoseconds time) const override
+    {
+      double const t = time.value();
+      double const v
+        = (t < 0.0)? 0.0: (t < 10.0)? -t: (t < 20.0)? t - 20.0: 0.0;
+      return ADCcount::castFrom(v);
+    }
+  virtual nanoseconds doPeakTime() const override
+    { return nanoseconds{ 10.0 }; }
+}; // TrianglePulse
+
+
+// -----------------------------------------------------------------------------
+void TabulatedPulseFunction_test() {
+  
+  TrianglePulse const pulse;
+  
+  // the triangle is linear between table entries: interpolation is exact
+  icarus::opdet::TabulatedPulseFunction<nanoseconds> const tabulated
+    { pulse, nanoseconds{ 0.0 }, nanoseconds{ 30.0 }, nanoseconds{ 0.5 } };
+  
+  BOOST_TEST(tabulated.size() == 61U);
+  BOOST_TEST(tabulated.peakTime() == pulse.peakTime());
+  BOOST_TEST(tabulated.peakAmplitude() == pulse.peakAmplitude());
+  BOOST_TEST(tabulated.polarity() == -1);
+  
+  for (double t = -5.0; t < 40.0; t += 0.1) {
+    nanoseconds const time { t };
+    BOOST_TEST_CONTEXT("time: " << time) {
+      BOOST_TEST(tabulated(time).value() == pulse(time).value(),
+        boost::test_tools::tolerance(1e-5f));
+    }
+  } // for
+  
+} // TabulatedPulseFunction_test()
+
+
+// -----------------------------------------------------------------------------
+void TabulatedPulseFunction_serialization_test() {
+  
+  using TabulatedPulse_t = icarus::opdet::TabulatedPulseFunction<nanoseconds>;
+  
+  TrianglePulse const pulse;
+  TabulatedPulse_t const tabulated
+    { pulse, nanoseconds{ 0.0 }, nanoseconds{ 30.0 }, nanoseconds{ 0.5 } };
+  
+  std::stringstream buffer;
+  tabulated.write(buffer);
+  
+  std::optional<TabulatedPulse_t> const restored
+    = TabulatedPulse_t::read(buffer);
+  BOOST_TEST_REQUIRE(restored.has_value());
+  BOOST_TEST(restored->size() == tabulated.size());
+  BOOST_TEST(restored->peakTime() == tabulated.peakTime());
+  BOOST_TEST(restored->peakAmplitude() == tabulated.peakAmplitude());
+  for (double t = -5.0; t < 40.0; t += 0.1) {
+    nanoseconds const time { t };
+    BOOST_TEST(restored->evaluateAt(time) == tabulated.evaluateAt(time));
+  }
+  
+  std::istringstream garbage { "not a pulse" };
+  BOOST_TEST(!TabulatedPulse_t::read(garbage).has_value());
+  
+} // TabulatedPulseFunction_serialization_test()
+
+
+// -----------------------------------------------------------------------------
+void TabulatedPulseFunction_corruption_test() {
+  
+  using TabulatedPulse_t = icarus::opdet::TabulatedPulseFunction<nanoseconds>;
+  
+  TrianglePulse const pulse;
+  TabulatedPulse_t const tabulated
+    { pulse, nanoseconds{ 0.0 }, nanoseconds{ 30.0 }, nanoseconds{ 0.5 } };
+  
+  std::ostringstream sstr;
+  tabulated.write(sstr);
+  std::string const data = sstr.str();
+  
+  // the format: tag (8 bytes), five `double`, then the description length
+  // and the description, then the number of entries and the entries
+  std::size_t const lengthPos = 8 + 5 * sizeof(double);
+  std::size_t const nValuesPos
+    = lengthPos + sizeof(std::uint64_t) + tabulated.specs().description.size();
+  
+  // replaces the size at `pos` with `value`, and reads the result back
+  auto const readPatched = [&data](std::size_t pos, std::uint64_t value)
+    {
+      std::string patched = data;
+      patched.replace
+        (pos, sizeof(value), reinterpret_cast<char const*>(&value), sizeof(value));
+      std::istringstream in { patched };
+      return TabulatedPulse_t::read(in);
+    };
+  
+  // the unmodified data is fine
+  BOOST_TEST(readPatched(nValuesPos, tabulated.size()).has_value());
+  
+  // sizes beyond the end of the data are rejected without allocating them
+  for (std::uint64_t const size: {
+    std::uint64_t(data.size()), std::uint64_t{ 1 } << 40,
+    std::numeric_limits<std::uint64_t>::max()
+  }) {
+    BOOST_TEST_CONTEXT("size: " << size) {
+      BOOST_TEST(!readPatched(lengthPos, size).has_value());
+      BOOST_TEST(!readPatched(nValuesPos, size).has_value());
+    }
+  } // for
+  
+  // truncated data
+  std::istringstream truncated { data.substr(0, data.size() - 4) };
+  BOOST_TEST(!TabulatedPulse_t::read(truncated).has_value());
+  
+} // TabulatedPulseFunction_corruption_test()
+
+
+// -----------------------------------------------------------------------------
+// BEGIN Test cases  -----------------------------------------------------------
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(TabulatedPulseFunction_testcase) {
+  
+  TabulatedPulseFunction_test();
+  
+} // BOOST_AUTO_TEST_CASE(TabulatedPulseFunction_testcase)
+
+
+BOOST_AUTO_TEST_CASE(TabulatedPulseFunction_serialization_testcase) {
+  
+  TabulatedPulseFunction_serialization_test();
+  
+} // BOOST_AUTO_TEST_CASE(TabulatedPulseFunction_serialization_testcase)
+
+
+BOOST_AUTO_TEST_CASE(TabulatedPulseFunction_corruption_testcase) {
+  
+  TabulatedPulseFunction_corruption_test();
+  
+} // BOOST_AUTO_TEST_CASE(TabulatedPulseFunction_corruption_testcase)
+
+
+// -----------------------------------------------------------------------------
+// END Test cases  -------------------------------------------------------------
+// -----------------------------------------------------------------------------
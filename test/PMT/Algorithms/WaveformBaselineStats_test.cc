@@ -0,0 +1,155 @@
+/**
+ * @file   test/PMT/Algorithms/WaveformBaselineStats_test.cc
+ * @brief  Unit test for `WaveformBaselineStats.h` header.
+ * @date   October 19, 2026
+ * @see    `icaruscode/PMT/Algorithms/WaveformBaselineStats.h`
+ *
+ */
+
+// ICARUS libraries
+#include "icaruscode/PMT/Algorithms/WaveformBaselineStats.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( WaveformBaselineStats_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard library
+#include <algorithm> // std::nth_element()
+#include <cmath> // std::sqrt()
+#include <cstdint> // std::int16_t
+#include <map>
+#include <random>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+using Waveform_t = std::vector<std::int16_t>;
+
+/// Baseline with Gaussian noise and a few negative pulses.
+Waveform_t makeWaveform
+  (std::size_t nSamples, double baseline, double noise, std::mt19937& engine)
+{
+  std::normal_distribution<double> noiseDist{ baseline, noise };
+  Waveform_t waveform(nSamples);
+  for (std::int16_t& sample: waveform)
+    sample = static_cast<std::int16_t>(std::round(noiseDist(engine)));
+  for (std::size_t peak = nSamples / 5; peak + 30 < nSamples; peak += nSamples / 3)
+  {
+    for (std::size_t i = 0; i < 30; ++i)
+      waveform[peak + i] -= static_cast<std::int16_t>(800.0 / (1.0 + i));
+  } // for
+  return waveform;
+} // makeWaveform()
+
+
+/// Reference median, as `std::nth_element()` at the middle.
+std::int16_t referenceMedian(Waveform_t data) {
+  auto const middle = data.begin() + data.size() / 2;
+  std::nth_element(data.begin(), middle, data.end());
+  return *middle;
+} // referenceMedian()
+
+
+// -----------------------------------------------------------------------------
+void WaveformBaselineStats_test() {
+  
+  icarus::opdet::WaveformBaselineStats const baselineStats{ 3U };
+  BOOST_TEST(baselineStats.window() == 3U);
+  
+  std::mt19937 engine{ 12345U };
+  for (std::size_t const nSamples: { 1U, 2U, 7U, 100U, 5000U }) {
+    Waveform_t const waveform = makeWaveform(nSamples, 14900.0, 2.5, engine);
+    
+    BOOST_TEST_CONTEXT("samples: " << nSamples) {
+      
+      icarus::opdet::WaveformBaselineStats::Stats_t const stats
+        = baselineStats(waveform);
+      
+      BOOST_TEST(stats.nSamples == nSamples);
+      BOOST_TEST(stats.median == referenceMedian(waveform));
+      
+      // mode and truncated statistics from a frequency table
+      std::map<std::int16_t, unsigned int> frequency;
+      for (std::int16_t const sample: waveform) ++frequency[sample];
+      auto mode = frequency.begin();
+      for (auto it = frequency.begin(); it != frequency.end(); ++it)
+        if (it->second > mode->second) mode = it;
+      BOOST_TEST(stats.mode == mode->first);
+      
+      double sumW = 0.0, sumX = 0.0, sumX2 = 0.0;
+      for (auto const [ value, count ]: frequency) {
+        if (std::abs(value - mode->first) > 3) continue;
+        sumW += count;
+        sumX += double(count) * value;
+        sumX2 += double(count) * value * value;
+      } // for
+      double const mean = sumX / sumW;
+      BOOST_TEST(stats.nTruncatedSamples == sumW);
+      BOOST_TEST(stats.truncatedMean == mean, boost::test_tools::tolerance(1e-6));
+      BOOST_TEST(stats.RMS
+        == std::sqrt(std::max(sumX2 / sumW - mean * mean, 0.0)),
+        boost::test_tools::tolerance(1e-4)
+        );
+      
+    } // BOOST_TEST_CONTEXT
+  } // for
+  
+  // empty waveform
+  icarus::opdet::WaveformBaselineStats::Stats_t const empty
+    = baselineStats(Waveform_t{});
+  BOOST_TEST(empty.nSamples == 0U);
+  BOOST_TEST(empty.nTruncatedSamples == 0U);
+  
+} // WaveformBaselineStats_test()
+
+
+// -----------------------------------------------------------------------------
+void WaveformBaselineStats_all_test() {
+  
+  icarus::opdet::WaveformBaselineStats const baselineStats;
+  
+  std::mt19937 engine{ 67890U };
+  std::vector<Waveform_t> waveforms;
+  for (unsigned int i = 0; i < 50; ++i)
+    waveforms.push_back(makeWaveform(1000U + 17U * i, 15000.0 - i, 3.0, engine));
+  waveforms.emplace_back(); // an empty one too
+  
+  std::vector<icarus::opdet::WaveformBaselineStats::Stats_t> const stats
+    = baselineStats.all(waveforms);
+  
+  BOOST_TEST_REQUIRE(stats.size() == waveforms.size());
+  for (std::size_t i = 0; i < waveforms.size(); ++i) {
+    BOOST_TEST_CONTEXT("waveform #" << i) {
+      icarus::opdet::WaveformBaselineStats::Stats_t const expected
+        = baselineStats(waveforms[i]);
+      BOOST_TEST(stats[i].nSamples == expected.nSamples);
+      BOOST_TEST(stats[i].median == expected.median);
+      BOOST_TEST(stats[i].mode == expected.mode);
+      BOOST_TEST(stats[i].truncatedMean == expected.truncatedMean);
+      BOOST_TEST(stats[i].RMS == expected.RMS);
+    }
+  } // for
+  
+} // WaveformBaselineStats_all_test()
+
+
+// -----------------------------------------------------------------------------
+// BEGIN Test cases  -----------------------------------------------------------
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(WaveformBaselineStats_testcase) {
+  
+  WaveformBaselineStats_test();
+  
+} // BOOST_AUTO_TEST_CASE(WaveformBaselineStats_testcase)
+
+
+BOOST_AUTO_TEST_CASE(WaveformBaselineStats_all_testcase) {
+  
+  WaveformBaselineStats_all_test();
+  
+} // BOOST_AUTO_TEST_CASE(WaveformBaselineStats_all_testcase)
+
+
+// -----------------------------------------------------------------------------
+// END Test cases  -------------------------------------------------------------
+// -----------------------------------------------------------------------------
@@ -0,0 +1,376 @@
+/**
+ * @file   test/PMT/OpReco/SimpleFlashAlgo_test.cc
+ * @brief  Regression test for `pmtana::SimpleFlashAlgo`.
+ * @see    `icaruscode/PMT/OpReco/FlashFinder/SimpleFlashAlgo.h`
+ *
+ * The flashes are compared with the ones from the original implementation of
+ * the algorithm (with a dense PE-time histogram and a map of the seeds), which
+ * is reproduced here, on synthetic optical hit collections.
+ * The algorithm is also run concurrently from several threads.
+ */
+
+// ICARUS libraries
+#include "icaruscode/PMT/OpReco/FlashFinder/SimpleFlashAlgo.h"
+
+// framework libraries
+#include "fhiclcpp/ParameterSet.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( SimpleFlashAlgo_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard library
+#include <algorithm> // std::min()
+#include <cmath> // std::round()
+#include <map>
+#include <random>
+#include <thread>
+#include <utility> // std::pair
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+/// Configuration of the algorithm (a subset of the FHiCL parameters).
+struct AlgoConfig_t {
+  double min_pe_hit = 0.5;
+  double min_pe_flash = 40.;
+  double min_pe_coinc = 40.;
+  double min_mult_coinc = 5.;
+  double integral_time = 8.;
+  double pre_sample = 0.1;
+  double veto_time = 8.;
+  double time_res = 0.1;
+  std::vector<double> veto_start, veto_end;
+  int first_channel = 0;
+  int last_channel = 179;
+};
+
+/// Standard simulation configuration (`SimpleFlashCryo0`).
+AlgoConfig_t const StandardConfig;
+
+/// Data configuration (`SimpleFlashDataCryo0`), with a hit veto window.
+AlgoConfig_t const DataConfig = [](){
+  AlgoConfig_t config;
+  config.min_pe_hit = 1.0;
+  config.min_pe_flash = 100.;
+  config.min_pe_coinc = 100.;
+  config.integral_time = 1.;
+  config.pre_sample = 0.02;
+  config.veto_time = 1.;
+  config.time_res = 0.01;
+  config.veto_start = { 200.0 };
+  config.veto_end = { 250.0 };
+  return config;
+}();
+
+
+fhicl::ParameterSet makeParameterSet(AlgoConfig_t const& config) {
+  fhicl::ParameterSet pset;
+  pset.put("PEThresholdHit", config.min_pe_hit);
+  pset.put("PEThreshold", config.min_pe_flash);
+  pset.put("MinPECoinc", config.min_pe_coinc);
+  pset.put("MinMultCoinc", config.min_mult_coinc);
+  pset.put("IntegralTime", config.integral_time);
+  pset.put("PreSample", config.pre_sample);
+  pset.put("VetoSize", config.veto_time);
+  pset.put("TimeResolution", config.time_res);
+  pset.put("HitVetoRangeStart", config.veto_start);
+  pset.put("HitVetoRangeEnd", config.veto_end);
+  pset.put("OpChannelRange",
+    std::vector<int>{ config.first_channel, config.last_channel });
+  pset.put("DebugMode", false);
+  return pset;
+} // makeParameterSet()
+
+
+// -----------------------------------------------------------------------------
+/// The original implementation of `SimpleFlashAlgo::RecoFlash()`.
+pmtana::LiteOpFlashArray_t referenceRecoFlash
+  (AlgoConfig_t const& config, pmtana::LiteOpHitArray_t const& ophits)
+{
+  std::vector<int> opch_to_index_v(config.last_channel + 1, -1);
+  std::vector<int> index_to_opch_v;
+  for (int ch = config.first_channel; ch <= config.last_channel; ++ch) {
+    opch_to_index_v[ch] = index_to_opch_v.size();
+    index_to_opch_v.push_back(ch);
+  }
+  std::map<double,double> flash_veto_range_m;
+  for (size_t i = 0; i < config.veto_start.size(); ++i)
+    flash_veto_range_m.emplace(config.veto_end[i], config.veto_start[i]);
+  auto Veto = [&flash_veto_range_m](double t)
+    {
+      auto iter = flash_veto_range_m.lower_bound(t);
+      if(iter == flash_veto_range_m.end()) return false;
+      return (t >= (*iter).second);
+    };
+  double const _time_res = config.time_res;
+
+  size_t max_ch = opch_to_index_v.size() - 1;
+  size_t NOpDet = index_to_opch_v.size();
+
+  double min_time=1.1e20;
+  double max_time=1.1e20;
+  for(auto const& oph : ophits) {
+    if(max_time > 1.e20 || oph.peak_time > max_time) max_time = oph.peak_time;
+    if(min_time > 1.e20 || oph.peak_time < min_time) min_time = oph.peak_time;
+  }
+  min_time -= 10* _time_res;
+  max_time += 10* _time_res;
+
+  size_t nbins_pesum_v = (size_t)((max_time - min_time) / _time_res) + 1;
+  std::vector<double> pesum_v(nbins_pesum_v, 0);
+  std::vector<double> mult_v(nbins_pesum_v, 0);
+  std::vector<std::vector<double> > pespec_v
+    (nbins_pesum_v, std::vector<double>(NOpDet));
+  std::vector<std::vector<unsigned int> > hitidx_v(nbins_pesum_v);
+
+  for(size_t hitidx = 0; hitidx < ophits.size(); ++hitidx) {
+    auto const& oph = ophits[hitidx];
+    if(oph.channel > max_ch || opch_to_index_v[oph.channel] < 0) continue;
+    if(Veto(oph.peak_time)) continue;
+    if(oph.pe <= 0.) continue;
+    if(config.min_pe_hit > 0. && oph.pe < config.min_pe_hit) continue;
+    size_t index = (size_t)((oph.peak_time - min_time) / _time_res);
+    pesum_v[index] += oph.pe;
+    mult_v[index] += 1;
+    pespec_v[index][opch_to_index_v[oph.channel]] += oph.pe;
+    hitidx_v[index].push_back(hitidx);
+  }
+
+  std::map<double,size_t> pesum_idx_map;
+  for(size_t idx=0; idx<nbins_pesum_v; ++idx) {
+    if(pesum_v[idx] < config.min_pe_coinc   ) continue;
+    if(mult_v[idx]  < config.min_mult_coinc ) continue;
+    pesum_idx_map[1./(pesum_v[idx])] = idx;
+  }
+
+  std::vector<std::pair<size_t,size_t> > flash_period_v;
+  std::vector<size_t> flash_time_v;
+  size_t veto_ctr = (size_t)(config.veto_time / _time_res);
+  size_t default_integral_ctr = (size_t)(config.integral_time / _time_res);
+  size_t precount = (size_t)(config.pre_sample / _time_res);
+
+  for(auto const& pe_idx : pesum_idx_map) {
+    auto const& idx = pe_idx.second;
+    size_t start_time = idx;
+    if(start_time < precount) start_time = 0;
+    else start_time = idx - precount;
+
+    bool skip=false;
+    size_t integral_ctr = default_integral_ctr;
+    for(auto const& used_period : flash_period_v) {
+      if( start_time <= used_period.first && (start_time + veto_ctr) > used_period.first ) {
+        skip=true;
+        break;
+      }
+      if( used_period.first <= start_time && start_time < (used_period.first + veto_ctr) ) {
+        skip=true;
+        break;
+      }
+      if( used_period.first >= start_time && used_period.first < (start_time + integral_ctr) )
+        integral_ctr = used_period.first - start_time;
+    }
+    if(skip) continue;
+
+    double pesum = 0;
+    for(size_t i=start_time; i<std::min(nbins_pesum_v,(start_time+integral_ctr)); ++i)
+      pesum += pesum_v[i];
+    if(pesum < config.min_pe_flash) continue;
+
+    flash_period_v.push_back(std::pair<size_t,size_t>(start_time,integral_ctr));
+    flash_time_v.push_back(idx);
+  }
+
+  pmtana::LiteOpFlashArray_t res;
+  for(size_t flash_idx=0; flash_idx<flash_period_v.size(); ++flash_idx) {
+    auto const& start  = flash_period_v[flash_idx].first;
+    auto const& period = flash_period_v[flash_idx].second;
+    auto const& time   = flash_time_v[flash_idx];
+
+    std::vector<double> pe_v(max_ch+1,0);
+    for(size_t index=start; index<(start+period) && index<pespec_v.size(); ++index) {
+      for(size_t pmt_index=0; pmt_index<NOpDet; ++pmt_index)
+        pe_v[index_to_opch_v[pmt_index]] += pespec_v[index][pmt_index];
+    }
+    std::vector<unsigned int> asshit_v;
+    for(size_t index=start; index<(start+period) && index<pespec_v.size(); ++index) {
+      for(auto const& idx : hitidx_v[index])
+        asshit_v.push_back(idx);
+    }
+    res.emplace_back(min_time + time * _time_res, period * _time_res / 2.,
+                     std::move(pe_v), std::move(asshit_v));
+  }
+  return res;
+} // referenceRecoFlash()
+
+
+// -----------------------------------------------------------------------------
+/**
+ * @brief Returns a synthetic collection of optical hits.
+ * @param seed random seed
+ * @param quantizedPE whether hit PE are multiple of 0.5 (making ties likely)
+ *
+ * The collection includes flashes with fast and slow light components spread
+ * over the channels, dark noise, and hits which are to be ignored (channels
+ * out of range and non-positive PE).
+ */
+pmtana::LiteOpHitArray_t makeOpHits(unsigned int seed, bool quantizedPE) {
+
+  std::mt19937 engine{ seed };
+  std::uniform_real_distribution<double> flashTime{ -1500.0, 1500.0 };
+  std::uniform_int_distribution<std::size_t> channel{ 0U, 179U };
+  std::uniform_int_distribution<std::size_t> otherChannel{ 180U, 359U };
+  std::uniform_int_distribution<int> nFlashHits{ 20, 400 };
+  std::exponential_distribution<double> fastLight{ 1.0 / 0.006 };
+  std::exponential_distribution<double> slowLight{ 1.0 / 1.5 };
+  std::bernoulli_distribution isFast{ 0.3 };
+  std::exponential_distribution<double> flashPE{ 1.0 / 6.0 };
+  std::uniform_real_distribution<double> noiseTime{ -1600.0, 1600.0 };
+  std::uniform_real_distribution<double> noisePE{ -0.2, 2.0 };
+
+  auto pe = [quantizedPE](double value)
+    { return quantizedPE? std::round(2.0 * value) / 2.0: value; };
+
+  pmtana::LiteOpHitArray_t ophits;
+  auto addHit = [&ophits](std::size_t channel, double time, double pe)
+    {
+      pmtana::LiteOpHit_t hit;
+      hit.channel = channel;
+      hit.peak_time = time;
+      hit.pe = pe;
+      ophits.push_back(hit);
+    };
+
+  for (int iFlash = 0; iFlash < 25; ++iFlash) {
+    double const t0 = flashTime(engine);
+    int const nHits = nFlashHits(engine);
+    for (int iHit = 0; iHit < nHits; ++iHit) {
+      double const dt = isFast(engine)? fastLight(engine): slowLight(engine);
+      addHit(channel(engine), t0 + dt, pe(flashPE(engine)));
+    }
+    // a few hits in the other cryostat
+    for (int iHit = 0; iHit < nHits / 10; ++iHit)
+      addHit(otherChannel(engine), t0 + slowLight(engine), pe(flashPE(engine)));
+  } // for flashes
+
+  for (int iHit = 0; iHit < 3000; ++iHit)
+    addHit(channel(engine), noiseTime(engine), pe(noisePE(engine)));
+
+  std::shuffle(ophits.begin(), ophits.end(), engine);
+  return ophits;
+} // makeOpHits()
+
+
+/// Checks that two flash collections are identical.
+void checkSameFlashes(
+  pmtana::LiteOpFlashArray_t const& flashes,
+  pmtana::LiteOpFlashArray_t const& expected
+) {
+  BOOST_TEST_REQUIRE(flashes.size() == expected.size());
+  for (std::size_t i = 0; i < flashes.size(); ++i) {
+    BOOST_TEST_CONTEXT("flash #" << i) {
+      BOOST_TEST(flashes[i].time == expected[i].time);
+      BOOST_TEST(flashes[i].time_err == expected[i].time_err);
+      BOOST_TEST(flashes[i].channel_pe == expected[i].channel_pe,
+        boost::test_tools::per_element());
+      BOOST_TEST(flashes[i].asshit_idx == expected[i].asshit_idx,
+        boost::test_tools::per_element());
+    }
+  } // for
+} // checkSameFlashes()
+
+
+// -----------------------------------------------------------------------------
+// --- SimpleFlashAlgo tests
+// -----------------------------------------------------------------------------
+void RegressionTest(AlgoConfig_t const& config) {
+
+  pmtana::SimpleFlashAlgo algo{ "SimpleFlashAlgo" };
+  algo.Configure(makeParameterSet(config));
+
+  // a reused workspace must give the same result as a new one
+  pmtana::SimpleFlashAlgo::Workspace ws;
+
+  unsigned int nFlashes = 0;
+  for (unsigned int event = 0; event < 12; ++event) {
+    BOOST_TEST_CONTEXT("event " << event) {
+      pmtana::LiteOpHitArray_t const ophits
+        = makeOpHits(1000U + event, event % 2 == 1);
+      pmtana::LiteOpFlashArray_t const expected
+        = referenceRecoFlash(config, ophits);
+      nFlashes += expected.size();
+
+      checkSameFlashes(algo.RecoFlash(ophits), expected);
+      checkSameFlashes(algo.RecoFlash(ophits, ws), expected);
+    }
+  } // for events
+  BOOST_TEST(nFlashes > 0U);
+
+  // no hits, no flashes
+  BOOST_TEST(algo.RecoFlash(pmtana::LiteOpHitArray_t{}).empty());
+
+} // RegressionTest()
+
+
+void ConcurrencyTest() {
+
+  // two algorithms (like one per cryostat) shared by all the threads
+  pmtana::SimpleFlashAlgo algoE{ "SimpleFlashAlgo" }, algoW{ "SimpleFlashAlgo" };
+  algoE.Configure(makeParameterSet(StandardConfig));
+  AlgoConfig_t configW = StandardConfig;
+  configW.first_channel = 180;
+  configW.last_channel = 359;
+  algoW.Configure(makeParameterSet(configW));
+
+  constexpr unsigned int NEvents = 16U;
+  std::vector<pmtana::LiteOpHitArray_t> events;
+  std::vector<pmtana::LiteOpFlashArray_t> expectedE, expectedW;
+  for (unsigned int event = 0; event < NEvents; ++event) {
+    events.push_back(makeOpHits(2000U + event, event % 2 == 0));
+    expectedE.push_back(algoE.RecoFlash(events.back()));
+    expectedW.push_back(algoW.RecoFlash(events.back()));
+  }
+
+  constexpr unsigned int NThreads = 4U;
+  std::vector<std::vector<pmtana::LiteOpFlashArray_t>> resultsE(NThreads), resultsW(NThreads);
+  std::vector<std::thread> threads;
+  for (unsigned int iThread = 0; iThread < NThreads; ++iThread) {
+    threads.emplace_back([&, iThread](){
+        // each thread processes all events, starting from a different one
+        for (unsigned int i = 0; i < NEvents; ++i) {
+          unsigned int const event = (i + iThread * 5) % NEvents;
+          resultsE[iThread].push_back(algoE.RecoFlash(events[event]));
+          resultsW[iThread].push_back(algoW.RecoFlash(events[event]));
+        }
+      });
+  } // for
+  for (std::thread& thread: threads) thread.join();
+
+  for (unsigned int iThread = 0; iThread < NThreads; ++iThread) {
+    for (unsigned int i = 0; i < NEvents; ++i) {
+      unsigned int const event = (i + iThread * 5) % NEvents;
+      BOOST_TEST_CONTEXT("thread " << iThread << " event " << event) {
+        checkSameFlashes(resultsE[iThread][i], expectedE[event]);
+        checkSameFlashes(resultsW[iThread][i], expectedW[event]);
+      }
+    } // for events
+  } // for threads
+
+} // ConcurrencyTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(SimpleFlashAlgoStandard_testCase) {
+  RegressionTest(StandardConfig);
+} // BOOST_AUTO_TEST_CASE(SimpleFlashAlgoStandard_testCase)
+
+BOOST_AUTO_TEST_CASE(SimpleFlashAlgoData_testCase) {
+  RegressionTest(DataConfig);
+} // BOOST_AUTO_TEST_CASE(SimpleFlashAlgoData_testCase)
+
+BOOST_AUTO_TEST_CASE(SimpleFlashAlgoConcurrency_testCase) {
+  ConcurrencyTest();
+} // BOOST_AUTO_TEST_CASE(SimpleFlashAlgoConcurrency_testCase)
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,289 @@
+/**
+ * @file   test/PMT/Trigger/Algorithms/SlidingWindowPatternAlg_test.cc
+ * @brief  Unit test for the pattern evaluation in `SlidingWindowPatternAlg`.
+ * @date   October 19, 2026
+ * @see    `icaruscode/PMT/Trigger/Algorithms/SlidingWindowPatternAlg.h`
+ *
+ * `SlidingWindowPatternAlg::simulateResponse()` evaluates the patterns on a
+ * table of the opening levels of the windows, while they used to be
+ * evaluated by combining the trigger gates of the windows, which is still
+ * what the public `applyWindowPattern()` does. This test checks that the
+ * responses of the two are the same on a fixed set of window gates.
+ */
+
+// ICARUS libraries
+#include "icaruscode/PMT/Trigger/Algorithms/SlidingWindowPatternAlg.h"
+#include "icaruscode/PMT/Trigger/Algorithms/WindowChannelMap.h"
+#include "icaruscode/PMT/Trigger/Algorithms/WindowPattern.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( SlidingWindowPatternAlg_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard library
+#include <random>
+#include <utility> // std::move()
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+using Alg_t = icarus::trigger::SlidingWindowPatternAlg;
+using WindowChannelMap_t = icarus::trigger::WindowChannelMap;
+using WindowPattern_t = icarus::trigger::WindowPattern;
+using Gate_t = Alg_t::TriggerGateData_t;
+using TriggerGates_t = Alg_t::TriggerGates_t;
+
+
+/**
+ * @brief Returns the topology of `nWindows` windows on two opposite walls.
+ *
+ * Windows `0` to `nWindows/2 - 1` are on a wall, from upstream to
+ * downstream, and the other ones are on the opposite wall in the same order.
+ * Window `i` holds channels `2i` and `2i + 1`.
+ */
+WindowChannelMap_t makeTopology(std::size_t nWindows) {
+
+  std::size_t const nWallWindows = nWindows / 2;
+
+  std::vector<WindowChannelMap_t::WindowInfo_t> windows(nWindows);
+  for (std::size_t iWindow = 0; iWindow < nWindows; ++iWindow) {
+    std::size_t const iWall = iWindow % nWallWindows;
+
+    WindowChannelMap_t::WindowInfo_t& info = windows[iWindow];
+    info.composition.channels = {
+      static_cast<raw::Channel_t>(2 * iWindow),
+      static_cast<raw::Channel_t>(2 * iWindow + 1)
+    };
+    info.topology.index = iWindow;
+    info.topology.opposite = (iWindow + nWallWindows) % nWindows;
+    if (iWall > 0) info.topology.upstream = iWindow - 1;
+    if (iWall + 1 < nWallWindows) info.topology.downstream = iWindow + 1;
+  } // for
+
+  return WindowChannelMap_t{ std::move(windows) };
+
+} // makeTopology()
+
+
+/// Returns a pattern with the specified requirements.
+WindowPattern_t makePattern(
+  unsigned int main, unsigned int opposite = 0U, unsigned int sum = 0U,
+  unsigned int upstream = 0U, unsigned int downstream = 0U,
+  bool requireUpstream = false, bool requireDownstream = false
+) {
+  WindowPattern_t pattern;
+  pattern.minInMainWindow = main;
+  pattern.minInOppositeWindow = opposite;
+  pattern.minSumInOppositeWindows = sum;
+  pattern.minInUpstreamWindow = upstream;
+  pattern.minInDownstreamWindow = downstream;
+  pattern.requireUpstreamWindow = requireUpstream;
+  pattern.requireDownstreamWindow = requireDownstream;
+  return pattern;
+} // makePattern()
+
+
+/// The patterns used in the tests.
+icarus::trigger::WindowPatterns_t const Patterns {
+  makePattern(1U),
+  makePattern(2U),
+  makePattern(4U),
+  makePattern(2U, 1U),
+  makePattern(0U, 0U, 3U),
+  makePattern(1U, 1U, 4U),
+  makePattern(2U, 0U, 0U, 1U),
+  makePattern(1U, 0U, 0U, 0U, 1U, false, true),
+  makePattern(1U, 1U, 0U, 1U, 1U, true, true),
+};
+
+
+/// Returns `nWindows` gates with random openings (always the same ones).
+TriggerGates_t makeGates(std::size_t nWindows, unsigned int seed) {
+
+  std::mt19937 engine{ seed };
+  std::uniform_int_distribution<int> startDist{ 0, 400 };
+  std::uniform_int_distribution<int> lengthDist{ 1, 30 };
+  std::uniform_int_distribution<unsigned int> countDist{ 1U, 2U };
+  std::uniform_int_distribution<unsigned int> nOpeningsDist{ 0U, 12U };
+
+  TriggerGates_t gates;
+  for (std::size_t iWindow = 0; iWindow < nWindows; ++iWindow) {
+    Gate_t gate;
+    unsigned int const nOpenings = nOpeningsDist(engine);
+    for (unsigned int i = 0; i < nOpenings; ++i) {
+      int const start = startDist(engine);
+      gate.openBetween(start, start + lengthDist(engine), countDist(engine));
+    }
+    gates.emplace_back(std::move(gate));
+  } // for
+  return gates;
+
+} // makeGates()
+
+
+/// Response to `pattern` combining the gates, window by window.
+Alg_t::AllTriggerInfo_t referenceResponse(
+  Alg_t const& alg, WindowChannelMap_t const& topology,
+  WindowPattern_t const& pattern, TriggerGates_t const& gates
+) {
+  Alg_t::AllTriggerInfo_t response;
+  for (std::size_t iWindow = 0; iWindow < topology.nWindows(); ++iWindow) {
+    Alg_t::TriggerInfo_t const windowResponse
+      = alg.applyWindowPattern(topology.info(iWindow), pattern, gates);
+    if (!windowResponse) continue;
+    if (response && (response.info.atTick() <= windowResponse.atTick()))
+      continue;
+    response.info = windowResponse;
+    response.extra.windowIndex = iWindow;
+  } // for
+  return response;
+} // referenceResponse()
+
+
+/// Checks that two responses are the same.
+void checkSameResponse(
+  Alg_t::AllTriggerInfo_t const& response,
+  Alg_t::AllTriggerInfo_t const& expected
+) {
+  BOOST_TEST(response.info.fired() == expected.info.fired());
+  if (!expected.info.fired() || !response.info.fired()) return;
+
+  BOOST_TEST(response.extra.windowIndex == expected.extra.windowIndex);
+  BOOST_TEST(response.info.atTick().value() == expected.info.atTick().value());
+  BOOST_TEST(response.info.level() == expected.info.level());
+  BOOST_TEST(response.info.location() == expected.info.location());
+
+  auto const& openings = response.info.all();
+  auto const& expectedOpenings = expected.info.all();
+  BOOST_TEST_REQUIRE(openings.size() == expectedOpenings.size());
+  for (std::size_t i = 0; i < openings.size(); ++i) {
+    BOOST_TEST_CONTEXT("opening #" << i) {
+      BOOST_TEST(openings[i].tick.value() == expectedOpenings[i].tick.value());
+      BOOST_TEST(openings[i].level == expectedOpenings[i].level);
+      BOOST_TEST(openings[i].locationID == expectedOpenings[i].locationID);
+    }
+  } // for
+
+} // checkSameResponse()
+
+
+/// Checks the responses of `alg` against the ones combining the gates.
+void checkAllPatterns(
+  WindowChannelMap_t const& topology, TriggerGates_t const& gates
+) {
+
+  Alg_t const alg{ topology, Patterns.front() };
+
+  std::vector<Alg_t::AllTriggerInfo_t> const responses
+    = alg.simulateResponses(Patterns, gates);
+  BOOST_TEST_REQUIRE(responses.size() == Patterns.size());
+
+  for (std::size_t iPattern = 0; iPattern < Patterns.size(); ++iPattern) {
+    WindowPattern_t const& pattern = Patterns[iPattern];
+    BOOST_TEST_CONTEXT("pattern: " << pattern.tag()) {
+
+      Alg_t::AllTriggerInfo_t const expected
+        = referenceResponse(alg, topology, pattern, gates);
+      checkSameResponse(responses[iPattern], expected);
+
+      // the single-pattern interface gives the same answer
+      Alg_t const patternAlg{ topology, pattern };
+      checkSameResponse(patternAlg.simulateResponse(gates), expected);
+
+    } // context
+  } // for patterns
+
+} // checkAllPatterns()
+
+
+// -----------------------------------------------------------------------------
+// --- Tests
+// -----------------------------------------------------------------------------
+void FixedGatesTest() {
+
+  WindowChannelMap_t const topology = makeTopology(6U);
+
+  // window #1 reaches level 2 in [ 12 ; 15 [, its opposite #4 is open at 13;
+  // window #5 reaches level 2 earlier, in [ 8 ; 10 [, with its opposite closed
+  TriggerGates_t gates(6U);
+  gateIn(gates[1]).openBetween(10, 20);
+  gateIn(gates[1]).openBetween(12, 15);
+  gateIn(gates[4]).openBetween(13, 30);
+  gateIn(gates[5]).openBetween(8, 10, 2U);
+
+  Alg_t const alg{ topology, makePattern(2U, 1U) };
+  Alg_t::AllTriggerInfo_t const response = alg.simulateResponse(gates);
+  BOOST_TEST_REQUIRE(response.info.fired());
+  BOOST_TEST(response.extra.windowIndex == 1U);
+  BOOST_TEST(response.info.atTick().value() == 13);
+  BOOST_TEST(response.info.level() == 2U);
+
+  Alg_t const mainAlg{ topology, makePattern(2U) };
+  Alg_t::AllTriggerInfo_t const mainResponse = mainAlg.simulateResponse(gates);
+  BOOST_TEST_REQUIRE(mainResponse.info.fired());
+  BOOST_TEST(mainResponse.extra.windowIndex == 5U);
+  BOOST_TEST(mainResponse.info.atTick().value() == 8);
+
+  checkAllPatterns(topology, gates);
+
+} // FixedGatesTest()
+
+
+void RandomGatesTest() {
+
+  for (std::size_t const nWindows: { 2U, 6U, 12U }) {
+    WindowChannelMap_t const topology = makeTopology(nWindows);
+    for (unsigned int seed = 20261019U; seed < 20261019U + 20U; ++seed) {
+      BOOST_TEST_CONTEXT("windows: " << nWindows << ", seed: " << seed) {
+        checkAllPatterns(topology, makeGates(nWindows, seed));
+      }
+    } // for seeds
+  } // for window numbers
+
+} // RandomGatesTest()
+
+
+void ClosedGatesTest() {
+
+  WindowChannelMap_t const topology = makeTopology(6U);
+  checkAllPatterns(topology, TriggerGates_t(6U));
+
+} // ClosedGatesTest()
+
+
+void LongGatesTest() {
+
+  // gates open forever are evaluated combining the gates directly;
+  // the answer must be the same anyway
+  WindowChannelMap_t const topology = makeTopology(6U);
+  TriggerGates_t gates = makeGates(6U, 20261019U);
+  gateIn(gates[2]).openAt(50, 2U);
+  checkAllPatterns(topology, gates);
+
+  gates = makeGates(6U, 20261020U);
+  gateIn(gates[3]).openBetween(Gate_t::MinTick, 100);
+  checkAllPatterns(topology, gates);
+
+} // LongGatesTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(FixedGates_testCase) {
+  FixedGatesTest();
+} // BOOST_AUTO_TEST_CASE(FixedGates_testCase)
+
+BOOST_AUTO_TEST_CASE(RandomGates_testCase) {
+  RandomGatesTest();
+} // BOOST_AUTO_TEST_CASE(RandomGates_testCase)
+
+BOOST_AUTO_TEST_CASE(ClosedGates_testCase) {
+  ClosedGatesTest();
+} // BOOST_AUTO_TEST_CASE(ClosedGates_testCase)
+
+BOOST_AUTO_TEST_CASE(LongGates_testCase) {
+  LongGatesTest();
+} // BOOST_AUTO_TEST_CASE(LongGates_testCase)
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,166 @@
+/**
+ * @file   test/PMT/Trigger/Algorithms/WaveformAdder_test.cc
+ * @brief  Unit test for `icarus::trigger::WaveformAdder`.
+ * @date   October 19, 2026
+ * @see    `icaruscode/PMT/Trigger/Algorithms/WaveformAdder.h`
+ *
+ * The sum is checked to be bit-exact with the `std::valarray` addition
+ * previously used in `DiscriminatedAdderSignal` module.
+ */
+
+// ICARUS libraries
+#include "icaruscode/PMT/Trigger/Algorithms/WaveformAdder.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( WaveformAdder_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard library
+#include <cstdint> // std::uintptr_t
+#include <cstring> // std::memcmp()
+#include <random>
+#include <valarray>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+using Sample_t = short int; // as raw::ADC_Count_t
+
+/// A waveform with its baseline.
+struct Waveform_t {
+  std::vector<Sample_t> samples;
+  float baseline;
+  bool hasBaseline = true;
+};
+
+
+/// Returns `n` PMT-like waveforms of `nSamples` samples each.
+std::vector<Waveform_t> makeWaveforms
+  (std::size_t n, std::size_t nSamples, unsigned int seed)
+{
+  std::mt19937 engine{ seed };
+  std::uniform_real_distribution<float> baseline{ 14800.0f, 15200.0f };
+  std::normal_distribution<float> noise{ 0.0f, 2.5f };
+  std::exponential_distribution<float> pulse{ 1.0f / 300.0f };
+  std::bernoulli_distribution hasPulse{ 0.01 };
+
+  std::vector<Waveform_t> waveforms(n);
+  for (Waveform_t& waveform: waveforms) {
+    waveform.baseline = baseline(engine);
+    waveform.samples.resize(nSamples);
+    float signal = 0.0f;
+    for (Sample_t& sample: waveform.samples) {
+      signal = 0.8f * signal + (hasPulse(engine)? pulse(engine): 0.0f);
+      sample = static_cast<Sample_t>
+        (waveform.baseline + noise(engine) - signal); // negative polarity
+    }
+  } // for
+  waveforms.back().hasBaseline = false;
+
+  return waveforms;
+} // makeWaveforms()
+
+
+/// The addition previously in `DiscriminatedAdderSignal` module.
+std::valarray<float> referenceSum(
+  std::vector<Waveform_t> const& waveforms, std::size_t startSample,
+  std::size_t nSamples, float scale
+) {
+  std::valarray<float> added(0.0f, nSamples);
+  for (Waveform_t const& waveform: waveforms) {
+    auto itSample = std::next(waveform.samples.cbegin(), startSample);
+    for (float& sample: added) sample += *(itSample++);
+
+    if (waveform.hasBaseline) added -= waveform.baseline;
+  }
+  added *= scale;
+  return added;
+} // referenceSum()
+
+
+// -----------------------------------------------------------------------------
+// --- WaveformAdder tests
+// -----------------------------------------------------------------------------
+void BitExactTest() {
+
+  std::vector<Waveform_t> const waveforms
+    = makeWaveforms(15U, 5000U, 1234U);
+
+  for (float const scale: { 1.0f, 0.7f }) {
+    for (std::size_t const startSample: { 0U, 3U, 250U }) {
+      BOOST_TEST_CONTEXT("scale: " << scale << ", start: " << startSample) {
+
+        std::size_t const nSamples = 4501U - startSample;
+        std::valarray<float> const expected
+          = referenceSum(waveforms, startSample, nSamples, scale);
+
+        icarus::trigger::WaveformAdder added{ nSamples };
+        for (Waveform_t const& waveform: waveforms) {
+          std::size_t const nAdded = added.add(
+            waveform.samples.data(), waveform.samples.size(),
+            -static_cast<std::ptrdiff_t>(startSample),
+            waveform.hasBaseline? waveform.baseline: 0.0f
+            );
+          BOOST_TEST(nAdded == nSamples);
+        }
+        added.scale(scale);
+
+        BOOST_TEST_REQUIRE(added.size() == expected.size());
+        BOOST_TEST(std::memcmp
+          (added.data(), &expected[0], nSamples * sizeof(float)) == 0);
+      }
+    } // for start
+  } // for scale
+
+} // BitExactTest()
+
+
+void PartialOverlapTest() {
+
+  std::vector<Sample_t> const samples { 1, 2, 3, 4, 5 };
+
+  icarus::trigger::WaveformAdder added{ 8U };
+  BOOST_TEST(added.size() == 8U);
+  BOOST_TEST(!added.empty());
+  BOOST_TEST
+    (reinterpret_cast<std::uintptr_t>(added.data())
+      % icarus::trigger::WaveformAdder::Alignment == 0U);
+  for (float const sample: added) BOOST_TEST(sample == 0.0f);
+
+  // starts before the sum
+  BOOST_TEST(added.add(samples.data(), samples.size(), -3, 0.5f) == 2U);
+  // starts within the sum
+  BOOST_TEST(added.add(samples.data(), samples.size(), 2, 1.0f) == 5U);
+  // ends after the sum
+  BOOST_TEST(added.add(samples.data(), samples.size(), 6) == 2U);
+  // entirely outside the sum
+  BOOST_TEST(added.add(samples.data(), samples.size(), -5) == 0U);
+  BOOST_TEST(added.add(samples.data(), samples.size(), 8) == 0U);
+
+  std::vector<float> const expected
+    { 3.5f, 4.5f, 0.0f, 1.0f, 2.0f, 3.0f, 5.0f, 2.0f };
+  BOOST_TEST(std::vector<float>(added.begin(), added.end()) == expected,
+    boost::test_tools::per_element());
+
+  added.scale(2.0f);
+  for (std::size_t i = 0; i < expected.size(); ++i)
+    BOOST_TEST(added[i] == 2.0f * expected[i]);
+
+  icarus::trigger::WaveformAdder const none;
+  BOOST_TEST(none.empty());
+  BOOST_TEST(none.begin() == none.end());
+
+} // PartialOverlapTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(WaveformAdderBitExact_testCase) {
+  BitExactTest();
+} // BOOST_AUTO_TEST_CASE(WaveformAdderBitExact_testCase)
+
+BOOST_AUTO_TEST_CASE(WaveformAdderPartialOverlap_testCase) {
+  PartialOverlapTest();
+} // BOOST_AUTO_TEST_CASE(WaveformAdderPartialOverlap_testCase)
+
+
+// -----------------------------------------------------------------------------
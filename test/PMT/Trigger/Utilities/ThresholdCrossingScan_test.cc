@@ -0,0 +1,335 @@
+/**
+ * @file   test/PMT/Trigger/Utilities/ThresholdCrossingScan_test.cc
+ * @brief  Unit test for `scanThresholdCrossings()`.
+ * @date   October 19, 2026
+ * @see    `icaruscode/PMT/Trigger/Utilities/ThresholdCrossingScan.h`
+ *
+ * The threshold crossings used to be found by `ManagedTriggerGateBuilder`
+ * subtracting the baseline from each sample of the waveform and comparing it
+ * with the thresholds. This test checks that `scanThresholdCrossings()`,
+ * which skips the samples not crossing any threshold, finds the same
+ * crossings on a fixed set of waveforms of both polarities.
+ * The baseline subtraction is also tested returning a `short` value, as
+ * `ADCCounts_t` in `ManagedTriggerGateBuilder` does, which overflows for raw
+ * values far from the baseline.
+ */
+
+// ICARUS libraries
+#include "icaruscode/PMT/Trigger/Utilities/ThresholdCrossingScan.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( ThresholdCrossingScan_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard library
+#include <algorithm> // std::clamp()
+#include <limits>
+#include <ostream>
+#include <random>
+#include <vector>
+#include <cmath> // std::round()
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+using Sample_t = short int; // as in `raw::OpDetWaveform`
+using Waveform_t = std::vector<Sample_t>;
+
+
+/// A threshold passed (`pass`) or left (`!pass`) at a sample.
+struct Crossing_t {
+  std::size_t threshold;
+  std::size_t sample;
+  bool pass;
+
+  bool operator== (Crossing_t const& other) const
+    {
+      return (threshold == other.threshold) && (sample == other.sample)
+        && (pass == other.pass);
+    }
+}; // Crossing_t
+
+std::ostream& operator<< (std::ostream& out, Crossing_t const& crossing)
+{
+  out << (crossing.pass? "pass": "leave") << " thr #" << crossing.threshold
+    << " at #" << crossing.sample;
+  return out;
+}
+
+
+/// Baseline subtraction with rounding, as in `ManagedTriggerGateBuilder`.
+struct SubtractBaseline {
+  float baseline;
+  bool negative; ///< whether the signal polarity is negative
+
+  int operator() (float sample) const
+    {
+      return static_cast<int>
+        (std::round(negative? baseline - sample: sample - baseline));
+    }
+}; // SubtractBaseline
+
+
+/// Baseline subtraction returning `short`, which wraps far from the baseline.
+struct SubtractBaselineShort {
+  float baseline;
+  bool negative; ///< whether the signal polarity is negative
+
+  short int operator() (float sample) const
+    {
+      return static_cast<short int>(SubtractBaseline{ baseline, negative }(sample));
+    }
+}; // SubtractBaselineShort
+
+
+/// Crossings found by `scanThresholdCrossings()`.
+template <typename SubtractBaseline>
+std::vector<Crossing_t> scanCrossings(
+  Waveform_t const& waveform, std::vector<int> const& thresholds,
+  SubtractBaseline subtractBaseline
+) {
+  std::vector<Crossing_t> crossings;
+  icarus::trigger::scanThresholdCrossings<Sample_t>(
+    waveform.data(), waveform.size(), thresholds, subtractBaseline,
+    [&crossings](std::size_t iThr, std::size_t iSample, int)
+      { crossings.push_back({ iThr, iSample, true }); },
+    [&crossings](std::size_t iThr, std::size_t iSample, int)
+      { crossings.push_back({ iThr, iSample, false }); }
+    );
+  return crossings;
+} // scanCrossings()
+
+
+/// Crossings found testing every sample, as `ManagedTriggerGateBuilder` did.
+template <typename SubtractBaseline>
+std::vector<Crossing_t> referenceCrossings(
+  Waveform_t const& waveform, std::vector<int> const& thresholds,
+  SubtractBaseline subtractBaseline
+) {
+  std::size_t const nThresholds = thresholds.size();
+
+  std::vector<Crossing_t> crossings;
+  std::size_t nextGateToOpen = 0;
+  for (std::size_t iSample = 0; iSample < waveform.size(); ++iSample) {
+
+    int const relSample = subtractBaseline(waveform[iSample]);
+
+    if ((nextGateToOpen > 0) && (relSample < thresholds[nextGateToOpen - 1]))
+    {
+      do {
+        crossings.push_back({ --nextGateToOpen, iSample, false });
+      } while (
+        (nextGateToOpen > 0) && (relSample < thresholds[nextGateToOpen - 1])
+        );
+    }
+    else if
+      ((nextGateToOpen < nThresholds) && (relSample >= thresholds[nextGateToOpen]))
+    {
+      do {
+        crossings.push_back({ nextGateToOpen++, iSample, true });
+      } while (
+        (nextGateToOpen < nThresholds)
+        && (relSample >= thresholds[nextGateToOpen])
+        );
+    }
+
+  } // for samples
+  return crossings;
+} // referenceCrossings()
+
+
+/// Returns a waveform with pulses of random height on `baseline`.
+Waveform_t makeWaveform
+  (std::size_t nSamples, float baseline, bool negative, unsigned int seed)
+{
+  std::mt19937 engine{ seed };
+  std::normal_distribution<float> noiseDist{ 0.0f, 2.0f };
+  std::uniform_real_distribution<float> pulseStartDist{ 0.0f, 1.0f };
+  std::uniform_real_distribution<float> pulseHeightDist{ 2.0f, 800.0f };
+
+  constexpr float pulseProb = 0.01f;
+  constexpr float pulseDecay = 0.8f;
+
+  Waveform_t waveform;
+  waveform.reserve(nSamples);
+  float pulse = 0.0f;
+  for (std::size_t i = 0; i < nSamples; ++i) {
+    if (pulseStartDist(engine) < pulseProb) pulse += pulseHeightDist(engine);
+    float const signal = pulse + noiseDist(engine);
+    float const sample = std::round(negative? baseline - signal: baseline + signal);
+    waveform.push_back(static_cast<Sample_t>(std::clamp(
+      sample,
+      float(std::numeric_limits<Sample_t>::min()),
+      float(std::numeric_limits<Sample_t>::max())
+      )));
+    pulse *= pulseDecay;
+  } // for
+  return waveform;
+
+} // makeWaveform()
+
+
+// -----------------------------------------------------------------------------
+// --- Tests
+// -----------------------------------------------------------------------------
+void FixedWaveformTest() {
+
+  // positive polarity, baseline 100; thresholds at 5 and 20 (i.e. 105 and 120)
+  Waveform_t const waveform
+    { 100, 104, 105, 130, 119, 120, 104, 100, 125, 90, 105 };
+  std::vector<int> const thresholds{ 5, 20 };
+  std::vector<Crossing_t> const expected{
+    { 0U,  2U, true  },
+    { 1U,  3U, true  },
+    { 1U,  4U, false },
+    { 1U,  5U, true  },
+    { 1U,  6U, false },
+    { 0U,  6U, false },
+    { 0U,  8U, true  },
+    { 1U,  8U, true  },
+    { 1U,  9U, false },
+    { 0U,  9U, false },
+    { 0U, 10U, true  },
+  };
+
+  std::vector<Crossing_t> const crossings
+    = scanCrossings(waveform, thresholds, SubtractBaseline{ 100.0f, false });
+  BOOST_TEST(crossings == expected, boost::test_tools::per_element());
+
+} // FixedWaveformTest()
+
+
+void ReferenceEquivalenceTest() {
+
+  std::vector<std::vector<int>> const allThresholds{
+    {},
+    { 0 },
+    { 10 },
+    { 5, 10, 25, 50, 100, 400 },
+    { 1, 2, 3, 4, 5, 6, 7, 8 },
+    { -3, 15, 15, 60 }, // including a repeated threshold
+  };
+
+  unsigned int seed = 20261019U;
+  for (bool const negative: { true, false }) {
+    for (float const baseline: { 15000.0f, 14999.5f, 14999.6f, 8000.4f, 2.0f })
+    {
+      for (std::size_t const nSamples: { 0U, 1U, 31U, 32U, 33U, 5000U }) {
+
+        Waveform_t const waveform
+          = makeWaveform(nSamples, baseline, negative, ++seed);
+        SubtractBaseline const subtractBaseline{ baseline, negative };
+
+        for (std::vector<int> const& thresholds: allThresholds) {
+          BOOST_TEST_CONTEXT(
+            "polarity: " << (negative? "negative": "positive")
+            << ", baseline: " << baseline << ", samples: " << nSamples
+            << ", thresholds: " << thresholds.size()
+          ) {
+            BOOST_TEST(
+              scanCrossings(waveform, thresholds, subtractBaseline)
+                == referenceCrossings(waveform, thresholds, subtractBaseline),
+              boost::test_tools::per_element()
+              );
+          } // context
+        } // for thresholds
+
+      } // for samples
+    } // for baselines
+  } // for polarities
+
+} // ReferenceEquivalenceTest()
+
+
+void ExtremeSamplesTest() {
+
+  // samples at the limits of the range, and thresholds beyond them
+  constexpr Sample_t minSample = std::numeric_limits<Sample_t>::min();
+  constexpr Sample_t maxSample = std::numeric_limits<Sample_t>::max();
+  Waveform_t const waveform{
+    0, maxSample, minSample, 1000, maxSample, 0, minSample, minSample, 0
+  };
+  std::vector<int> const thresholds{ -40000, 0, 1000, 40000 };
+
+  for (bool const negative: { true, false }) {
+    for (float const baseline: { 0.0f, 0.5f, -0.5f, 1000.0f }) {
+      BOOST_TEST_CONTEXT(
+        "polarity: " << (negative? "negative": "positive")
+        << ", baseline: " << baseline
+      ) {
+        SubtractBaseline const subtractBaseline{ baseline, negative };
+        BOOST_TEST(
+          scanCrossings(waveform, thresholds, subtractBaseline)
+            == referenceCrossings(waveform, thresholds, subtractBaseline),
+          boost::test_tools::per_element()
+          );
+      } // context
+    } // for baselines
+  } // for polarities
+
+} // ExtremeSamplesTest()
+
+
+void ShortBaselineSubtractionTest() {
+
+  /*
+   * With a baseline of 15000, the subtraction of the baseline from raw values
+   * on the other end of the range of `short` overflows, and the conversion
+   * is not monotonic on the whole range of the samples any more;
+   * it still is on the range of the actual waveform samples.
+   */
+  std::vector<std::vector<int>> const allThresholds{
+    { 10 },
+    { 5, 10, 25, 50, 100, 400 },
+    { -3, 15, 15, 60 },
+  };
+
+  unsigned int seed = 20261119U;
+  for (bool const negative: { true, false }) {
+    for (float const baseline: { 15000.0f, 14999.5f, -15000.0f }) {
+
+      Waveform_t const waveform
+        = makeWaveform(5000U, baseline, negative, ++seed);
+      SubtractBaselineShort const subtractBaseline{ baseline, negative };
+
+      for (std::vector<int> const& thresholds: allThresholds) {
+        BOOST_TEST_CONTEXT(
+          "polarity: " << (negative? "negative": "positive")
+          << ", baseline: " << baseline
+          << ", thresholds: " << thresholds.size()
+        ) {
+          std::vector<Crossing_t> const expected
+            = referenceCrossings(waveform, thresholds, subtractBaseline);
+          BOOST_TEST(!expected.empty());
+          BOOST_TEST(
+            scanCrossings(waveform, thresholds, subtractBaseline) == expected,
+            boost::test_tools::per_element()
+            );
+        } // context
+      } // for thresholds
+
+    } // for baselines
+  } // for polarities
+
+} // ShortBaselineSubtractionTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(FixedWaveform_testCase) {
+  FixedWaveformTest();
+} // BOOST_AUTO_TEST_CASE(FixedWaveform_testCase)
+
+BOOST_AUTO_TEST_CASE(ReferenceEquivalence_testCase) {
+  ReferenceEquivalenceTest();
+} // BOOST_AUTO_TEST_CASE(ReferenceEquivalence_testCase)
+
+BOOST_AUTO_TEST_CASE(ExtremeSamples_testCase) {
+  ExtremeSamplesTest();
+} // BOOST_AUTO_TEST_CASE(ExtremeSamples_testCase)
+
+BOOST_AUTO_TEST_CASE(ShortBaselineSubtraction_testCase) {
+  ShortBaselineSubtractionTest();
+} // BOOST_AUTO_TEST_CASE(ShortBaselineSubtraction_testCase)
+
+
+// -----------------------------------------------------------------------------
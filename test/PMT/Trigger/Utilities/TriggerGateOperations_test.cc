@@ -0,0 +1,186 @@
+/**
+ * @file   test/PMT/Trigger/Utilities/TriggerGateOperations_test.cc
+ * @brief  Unit test for the gate combinations in `TriggerGateOperations.h`.
+ * @date   October 19, 2026
+ * @see    `icaruscode/PMT/Trigger/Utilities/TriggerGateOperations.h`
+ *
+ * The operations on sequences and collections of gates (`sumGates()`,
+ * `maxGates()`, ...) combine the gates in a balanced tree of pairwise
+ * operations. This test checks that their result is the same as the one of
+ * the sequential application of the operation (`OpGateColl()`), which is how
+ * they used to be computed, on a fixed set of gates.
+ */
+
+// ICARUS libraries
+#include "icaruscode/PMT/Trigger/Utilities/TriggerGateOperations.h"
+#include "icaruscode/PMT/Trigger/Utilities/TrackedOpticalTriggerGate.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( TriggerGateOperations_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard library
+#include <random>
+#include <utility> // std::move()
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+// -----------------------------------------------------------------------------
+using Gate_t = icarus::trigger::OpticalTriggerGateData_t;
+using TrackedGate_t = icarus::trigger::TrackedTriggerGate<Gate_t, int>;
+
+
+/// Returns `nGates` gates with random openings (always the same ones).
+std::vector<Gate_t> makeGates(std::size_t nGates) {
+
+  std::mt19937 engine{ 20261019U + static_cast<unsigned int>(nGates) };
+  std::uniform_int_distribution<int> startDist{ -50, 200 };
+  std::uniform_int_distribution<int> lengthDist{ 1, 40 };
+  std::uniform_int_distribution<unsigned int> countDist{ 1U, 3U };
+  std::uniform_int_distribution<unsigned int> nOpeningsDist{ 0U, 6U };
+
+  std::vector<Gate_t> gates(nGates);
+  for (Gate_t& gate: gates) {
+    unsigned int const nOpenings = nOpeningsDist(engine);
+    for (unsigned int i = 0; i < nOpenings; ++i) {
+      int const start = startDist(engine);
+      gate.openBetween(start, start + lengthDist(engine), countDist(engine));
+    }
+  } // for
+  return gates;
+
+} // makeGates()
+
+
+/// Returns `nGates` tracked gates with random openings and tracked objects.
+std::vector<TrackedGate_t> makeTrackedGates(std::size_t nGates) {
+
+  std::vector<TrackedGate_t> trackedGates;
+  int tracked = 0;
+  for (Gate_t& gate: makeGates(nGates)) {
+    TrackedGate_t trackedGate{ std::move(gate) };
+    trackedGate.tracking().add(tracked % 7); // some objects tracked many times
+    trackedGate.tracking().add(100 + tracked);
+    trackedGates.push_back(std::move(trackedGate));
+    ++tracked;
+  } // for
+  return trackedGates;
+
+} // makeTrackedGates()
+
+
+// -----------------------------------------------------------------------------
+// --- Tests
+// -----------------------------------------------------------------------------
+void FixedSumTest() {
+
+  // three overlapping gates: [ 2 ; 12 [, [ 6 ; 16 [ and [ 9 ; 20 [
+  std::vector<Gate_t> gates(3);
+  gates[0].openBetween( 2, 12);
+  gates[1].openBetween( 6, 16);
+  gates[2].openBetween( 9, 20);
+
+  Gate_t const sum = icarus::trigger::sumGates(gates);
+  for (int tick: { 0, 2, 5, 6, 8, 9, 11, 12, 15, 16, 19, 20, 25 }) {
+    unsigned int const expected
+      = (tick >= 2 && tick < 12) + (tick >= 6 && tick < 16)
+      + (tick >= 9 && tick < 20);
+    BOOST_TEST_CONTEXT("tick: " << tick) {
+      BOOST_TEST(sum.openingCount(tick) == expected);
+    }
+  } // for
+
+  Gate_t const max = icarus::trigger::maxGates(gates);
+  BOOST_TEST(max.openingCount(1) == 0U);
+  BOOST_TEST(max.openingCount(10) == 1U);
+  BOOST_TEST(max.openingCount(20) == 0U);
+
+  Gate_t const min = icarus::trigger::minGates(gates);
+  BOOST_TEST(min.openingCount(8) == 0U);
+  BOOST_TEST(min.openingCount(10) == 1U);
+  BOOST_TEST(min.openingCount(12) == 0U);
+
+} // FixedSumTest()
+
+
+void SequentialEquivalenceTest() {
+
+  namespace GateOps = icarus::trigger::GateOps;
+
+  // the product grows fast: it is tested on fewer gates
+  for (std::size_t const nGates: { 1U, 2U, 3U, 4U, 5U, 8U, 13U, 32U }) {
+    BOOST_TEST_CONTEXT("gates: " << nGates) {
+
+      std::vector<Gate_t> const gates = makeGates(nGates);
+
+      BOOST_TEST((icarus::trigger::sumGates(gates)
+        == icarus::trigger::OpGateColl(GateOps::Sum, gates)));
+      BOOST_TEST((icarus::trigger::maxGates(gates)
+        == icarus::trigger::OpGateColl(GateOps::Max, gates)));
+      BOOST_TEST((icarus::trigger::minGates(gates)
+        == icarus::trigger::OpGateColl(GateOps::Min, gates)));
+      if (nGates <= 5U) {
+        BOOST_TEST((icarus::trigger::mulGates(gates)
+          == icarus::trigger::OpGateColl(GateOps::Mul, gates)));
+      }
+      BOOST_TEST((
+        icarus::trigger::sumGatesSequence(gates.begin() + nGates / 2, gates.end())
+        == icarus::trigger::OpGatesSequence
+          (GateOps::Sum, gates.begin() + nGates / 2, gates.end())
+        ));
+
+    } // context
+  } // for
+
+  // empty collections give a default-constructed gate
+  BOOST_TEST(icarus::trigger::sumGates(std::vector<Gate_t>{}).alwaysClosed());
+
+} // SequentialEquivalenceTest()
+
+
+void TrackedEquivalenceTest() {
+
+  namespace GateOps = icarus::trigger::GateOps;
+
+  for (std::size_t const nGates: { 1U, 2U, 7U, 16U }) {
+    BOOST_TEST_CONTEXT("gates: " << nGates) {
+
+      std::vector<TrackedGate_t> const gates = makeTrackedGates(nGates);
+
+      TrackedGate_t const sum = icarus::trigger::sumGates(gates);
+      TrackedGate_t const expected
+        = icarus::trigger::OpGateColl(GateOps::Sum, gates);
+
+      BOOST_TEST((sum.gate() == expected.gate()));
+      BOOST_TEST(sum.tracking().nTracked() == expected.tracking().nTracked());
+      BOOST_TEST((sum.tracking().getTracked()
+        == expected.tracking().getTracked()));
+
+      TrackedGate_t const max = icarus::trigger::maxGates(gates);
+      BOOST_TEST((max.gate()
+        == icarus::trigger::OpGateColl(GateOps::Max, gates).gate()));
+      BOOST_TEST((max.tracking().getTracked()
+        == expected.tracking().getTracked()));
+
+    } // context
+  } // for
+
+} // TrackedEquivalenceTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(FixedSum_testCase) {
+  FixedSumTest();
+} // BOOST_AUTO_TEST_CASE(FixedSum_testCase)
+
+BOOST_AUTO_TEST_CASE(SequentialEquivalence_testCase) {
+  SequentialEquivalenceTest();
+} // BOOST_AUTO_TEST_CASE(SequentialEquivalence_testCase)
+
+BOOST_AUTO_TEST_CASE(TrackedEquivalence_testCase) {
+  TrackedEquivalenceTest();
+} // BOOST_AUTO_TEST_CASE(TrackedEquivalence_testCase)
+
+
+// -----------------------------------------------------------------------------
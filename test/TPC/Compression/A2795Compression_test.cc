@@ -0,0 +1,122 @@
+/**
+ * @file   test/TPC/Compression/A2795Compression_test.cc
+ * @brief  Unit test for the A2795 TPC difference-compression codec.
+ * @see    `icaruscode/TPC/Compression/A2795Compression.h`
+ *
+ */
+
+// ICARUS libraries
+#include "icaruscode/TPC/Compression/A2795Compression.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( A2795Compression_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard library
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+// --- A2795Compression tests
+// -----------------------------------------------------------------------------
+/// Returns a sample-major board with slow noise and a few large pulses.
+std::vector<uint16_t> makeBoardData
+  (std::size_t nChannels, std::size_t nSamples, unsigned int seed)
+{
+  std::mt19937 engine(seed);
+  std::normal_distribution<float> noise(0.0, 2.5);
+
+  std::vector<uint16_t> data(nChannels * nSamples);
+  for (std::size_t channel = 0; channel < nChannels; ++channel) {
+    float const pedestal = 1800.0 + 10.0 * (channel % 7);
+    for (std::size_t sample = 0; sample < nSamples; ++sample) {
+      float value = pedestal + noise(engine);
+      // a pulse every now and then, to exercise the 12-bit path
+      if ((sample + 37 * channel) % 500 < 20) value += 300.0;
+      data[sample * nChannels + channel] = static_cast<uint16_t>(value) & 0x0FFF;
+    } // for samples
+  } // for channels
+  return data;
+} // makeBoardData()
+
+
+void roundTrip_test(std::size_t nChannels, std::size_t nSamples) {
+
+  using namespace icarus::compression;
+
+  std::vector<uint16_t> const original
+    = makeBoardData(nChannels, nSamples, nChannels * 1000 + nSamples);
+
+  std::vector<uint16_t> compressed(original.size());
+  std::size_t const nWords = compressBoardData(
+    original.data(), nChannels, nSamples, 0xDFFF, compressed.data()
+    );
+  BOOST_TEST(nWords <= original.size());
+  BOOST_TEST(nWords % 2 == 0); // 32-bit alignment is preserved
+
+  BOOST_TEST(compressedBoardDataWords(compressed.data(), nChannels, nSamples)
+    == nWords);
+
+  std::vector<uint16_t> decoded(original.size(), 0xFFFF);
+  std::size_t const nRead = decompressBoardData
+    (compressed.data(), nChannels, nSamples, decoded.data());
+  BOOST_TEST(nRead == nWords);
+  BOOST_TEST(decoded == original, boost::test_tools::per_element());
+
+} // roundTrip_test()
+
+
+void boundary_test() {
+
+  using namespace icarus::compression;
+
+  // differences of exactly +/-7 are packed, +/-8 are not
+  constexpr std::size_t nChannels = 4;
+  std::vector<uint16_t> const original {
+    100, 100, 100, 100,
+    107,  93, 100, 100, // packed
+    115,  93, 100, 100, // +8: not packed
+    107,  93, 100, 100, // -8: not packed
+    };
+  std::size_t const nSamples = original.size() / nChannels;
+
+  std::vector<uint16_t> compressed(original.size());
+  std::size_t const nWords = compressBoardData(
+    original.data(), nChannels, nSamples, 0xDFFF, compressed.data()
+    );
+  // 4 (first sample) + 1 + 1 (spacer) + 4 + 4
+  BOOST_TEST(nWords == 14U);
+  BOOST_TEST((compressed[4] & 0xF000) != UncompressedTag);
+  BOOST_TEST(compressed[5] == 0U);
+  BOOST_TEST((compressed[6] & 0xF000) == UncompressedTag);
+
+  std::vector<uint16_t> decoded(original.size());
+  decompressBoardData(compressed.data(), nChannels, nSamples, decoded.data());
+  BOOST_TEST(decoded == original, boost::test_tools::per_element());
+
+} // boundary_test()
+
+
+// -----------------------------------------------------------------------------
+// BEGIN Test cases  -----------------------------------------------------------
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(A2795Compression_roundTrip_testcase) {
+
+  roundTrip_test(64, 4096);
+  roundTrip_test(64, 1);
+  roundTrip_test(16, 333);
+
+} // BOOST_AUTO_TEST_CASE(A2795Compression_roundTrip_testcase)
+
+BOOST_AUTO_TEST_CASE(A2795Compression_boundary_testcase) {
+
+  boundary_test();
+
+} // BOOST_AUTO_TEST_CASE(A2795Compression_boundary_testcase)
+
+
+// -----------------------------------------------------------------------------
+// END Test cases  -------------------------------------------------------------
+// -----------------------------------------------------------------------------
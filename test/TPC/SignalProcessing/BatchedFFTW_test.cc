@@ -0,0 +1,245 @@
+/**
+ * @file   test/TPC/SignalProcessing/BatchedFFTW_test.cc
+ * @brief  Unit test for the batched FFTW transforms.
+ * @see    `icaruscode/TPC/SignalProcessing/RawDigitFilter/Algorithms/BatchedFFTW.h`
+ *
+ * The batched transforms are compared with the ones of `util::LArFFTW` applied
+ * one waveform at a time, as done by `RawDigitCorrelatedCorrectionAlg` for each
+ * group of wires, on synthetic correlated noise corrections.
+ */
+
+// ICARUS libraries
+#include "icaruscode/TPC/SignalProcessing/RawDigitFilter/Algorithms/BatchedFFTW.h"
+
+// LArSoft libraries
+#include "lardata/Utilities/LArFFTWPlan.h"
+#include "lardata/Utilities/LArFFTW.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( BatchedFFTW_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard library
+#include <cmath>
+#include <complex>
+#include <random>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+using Complex_t = std::complex<double>;
+
+constexpr unsigned int FFTSize = 4096U;
+constexpr double Tolerance = 1e-9; // relative to the waveform scale
+
+
+/// Returns the average over groups of `nWires` wires with common noise lines.
+std::vector<std::vector<float>> makeCorrelatedNoise
+  (unsigned int nGroups, unsigned int nWires, unsigned int seed)
+{
+  std::mt19937 engine{ seed };
+  std::normal_distribution<float> wireNoise{ 0.0f, 4.0f };
+  std::uniform_real_distribution<double> phase{ 0.0, 2.0 * M_PI };
+
+  std::vector<std::vector<float>> corValVecs(nGroups);
+  for (std::vector<float>& corValVec: corValVecs) {
+    // coherent noise of the group: a few lines, plus incoherent wire noise
+    double const phase1 = phase(engine), phase2 = phase(engine);
+    std::vector<double> sum(FFTSize, 0.0);
+    for (unsigned int wire = 0; wire < nWires; ++wire) {
+      for (unsigned int tick = 0; tick < FFTSize; ++tick) {
+        double const t = 2.0 * M_PI * tick / FFTSize;
+        sum[tick] += 6.0 * std::sin(150.0 * t + phase1)
+          + 2.5 * std::sin(410.0 * t + phase2) + wireNoise(engine);
+      } // for ticks
+    } // for wires
+    corValVec.resize(FFTSize);
+    for (unsigned int tick = 0; tick < FFTSize; ++tick)
+      corValVec[tick] = float(sum[tick] / nWires);
+  } // for groups
+
+  return corValVecs;
+} // makeCorrelatedNoise()
+
+
+/// Replaces the bins around `bin` by a linear interpolation (like the
+/// correlated noise correction does around the peaks of the spectrum).
+void interpolateAround(Complex_t* spectrum, std::size_t bin) {
+  std::size_t const startBin = bin - 3, stopBin = bin + 3;
+  Complex_t const slope
+    = (spectrum[stopBin] - spectrum[startBin]) / double(stopBin - startBin);
+  for (std::size_t i = startBin; i < stopBin; ++i)
+    spectrum[i] = spectrum[startBin] + double(i - startBin) * slope;
+} // interpolateAround()
+
+
+/// A low pass filter.
+std::vector<Complex_t> makeFilter() {
+  std::vector<Complex_t> filter(FFTSize / 2 + 1);
+  for (std::size_t i = 0; i < filter.size(); ++i) {
+    double const f = double(i) / filter.size();
+    filter[i] = std::polar(std::exp(-0.5 * f * f / 0.01), -0.3 * f);
+  }
+  return filter;
+} // makeFilter()
+
+
+// -----------------------------------------------------------------------------
+// --- BatchedFFTW tests
+// -----------------------------------------------------------------------------
+void ForwardInverseTest() {
+
+  std::vector<std::vector<float>> const corValVecs
+    = makeCorrelatedNoise(6U, 32U, 1234U);
+
+  util::LArFFTWPlan lfftwp(FFTSize, "ES");
+  util::LArFFTW lfftw(FFTSize, lfftwp.fPlan, lfftwp.rPlan, 0);
+
+  caldata::BatchedFFTW batch(FFTSize);
+  BOOST_TEST(batch.halfFFTSize() == FFTSize / 2 + 1);
+
+  batch.resize(corValVecs.size());
+  BOOST_TEST(batch.size() == corValVecs.size());
+  for (std::size_t group = 0; group < corValVecs.size(); ++group)
+    batch.setWaveform(group, corValVecs[group]);
+
+  batch.forward();
+
+  std::vector<std::vector<Complex_t>> expectedSpectra;
+  for (std::size_t group = 0; group < corValVecs.size(); ++group) {
+    std::vector<float> corValVec = corValVecs[group];
+    std::vector<Complex_t> fftOutputVec(FFTSize / 2 + 1);
+    lfftw.DoFFT(corValVec, fftOutputVec);
+
+    Complex_t const* spectrum = batch.spectrum(group);
+    for (std::size_t i = 0; i < fftOutputVec.size(); ++i) {
+      BOOST_TEST_CONTEXT("group " << group << " bin " << i) {
+        BOOST_TEST(std::abs(spectrum[i] - fftOutputVec[i])
+          <= Tolerance * FFTSize * 10.0);
+      }
+    } // for bins
+    expectedSpectra.push_back(std::move(fftOutputVec));
+  } // for groups
+
+  // the correction: remove the noise lines from the spectra of some groups,
+  // transform back and subtract
+  for (std::size_t group = 0; group < corValVecs.size(); group += 2) {
+    interpolateAround(batch.spectrum(group), 150U);
+    interpolateAround(batch.spectrum(group), 410U);
+    interpolateAround(expectedSpectra[group].data(), 150U);
+    interpolateAround(expectedSpectra[group].data(), 410U);
+  }
+
+  batch.inverse();
+
+  for (std::size_t group = 0; group < corValVecs.size(); ++group) {
+    std::vector<double> tmpVec(corValVecs[group].size());
+    lfftw.DoInvFFT(expectedSpectra[group], tmpVec);
+
+    std::vector<double> batchVec(corValVecs[group].size());
+    batch.getWaveform(group, batchVec);
+
+    for (std::size_t tick = 0; tick < tmpVec.size(); ++tick) {
+      BOOST_TEST_CONTEXT("group " << group << " tick " << tick) {
+        BOOST_TEST(std::abs(batchVec[tick] - tmpVec[tick]) <= Tolerance * 10.0);
+      }
+    } // for ticks
+
+    // unchanged spectra give back the input
+    if (group % 2 == 1) {
+      for (std::size_t tick = 0; tick < tmpVec.size(); ++tick)
+        BOOST_TEST(std::abs(batchVec[tick] - corValVecs[group][tick]) <= 1e-4);
+    }
+  } // for groups
+
+} // ForwardInverseTest()
+
+
+void FilterTest() {
+
+  std::vector<std::vector<float>> const corValVecs
+    = makeCorrelatedNoise(5U, 16U, 5678U);
+  std::vector<Complex_t> const filter = makeFilter();
+
+  util::LArFFTWPlan lfftwp(FFTSize, "ES");
+  util::LArFFTW lfftw(FFTSize, lfftwp.fPlan, lfftwp.rPlan, 0);
+
+  caldata::BatchedFFTW batch(FFTSize);
+  batch.resize(corValVecs.size());
+  for (std::size_t group = 0; group < corValVecs.size(); ++group)
+    batch.setWaveform(group, corValVecs[group]);
+
+  batch.forward();
+  batch.applyFilter(filter);
+  batch.inverse();
+
+  for (std::size_t group = 0; group < corValVecs.size(); ++group) {
+    std::vector<float> corValVec = corValVecs[group];
+    std::vector<Complex_t> fftOutputVec(FFTSize / 2 + 1);
+    lfftw.DoFFT(corValVec, fftOutputVec);
+    for (std::size_t i = 0; i < fftOutputVec.size(); ++i)
+      fftOutputVec[i] *= filter[i];
+    std::vector<double> expected(FFTSize);
+    lfftw.DoInvFFT(fftOutputVec, expected);
+
+    std::vector<double> filtered(FFTSize);
+    batch.getWaveform(group, filtered);
+    for (std::size_t tick = 0; tick < FFTSize; ++tick) {
+      BOOST_TEST_CONTEXT("group " << group << " tick " << tick) {
+        BOOST_TEST(std::abs(filtered[tick] - expected[tick]) <= Tolerance * 10.0);
+      }
+    } // for ticks
+  } // for groups
+
+} // FilterTest()
+
+
+void ResizeTest() {
+
+  // batches of different sizes share the object (and reuse the plans)
+  caldata::BatchedFFTW batch(FFTSize);
+
+  for (unsigned int const nGroups: { 3U, 8U, 1U, 3U }) {
+    std::vector<std::vector<float>> const corValVecs
+      = makeCorrelatedNoise(nGroups, 4U, 100U + nGroups);
+
+    batch.resize(nGroups);
+    BOOST_TEST(batch.size() == nGroups);
+    for (std::size_t group = 0; group < nGroups; ++group)
+      batch.setWaveform(group, corValVecs[group]);
+    batch.forward();
+    batch.inverse();
+
+    for (std::size_t group = 0; group < nGroups; ++group) {
+      std::vector<float> back(FFTSize);
+      batch.getWaveform(group, back);
+      for (std::size_t tick = 0; tick < FFTSize; ++tick)
+        BOOST_TEST(std::abs(back[tick] - corValVecs[group][tick]) <= 1e-4);
+    } // for groups
+  } // for batch sizes
+
+  // shorter waveforms are padded with zeroes
+  batch.resize(1U);
+  batch.setWaveform(0U, std::vector<float>(FFTSize / 2, 1.0f));
+  BOOST_TEST(batch.waveform(0U)[FFTSize / 2 - 1] == 1.0);
+  BOOST_TEST(batch.waveform(0U)[FFTSize / 2] == 0.0);
+  BOOST_TEST(batch.waveform(0U)[FFTSize - 1] == 0.0);
+
+} // ResizeTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(BatchedFFTWForwardInverse_testCase) {
+  ForwardInverseTest();
+} // BOOST_AUTO_TEST_CASE(BatchedFFTWForwardInverse_testCase)
+
+BOOST_AUTO_TEST_CASE(BatchedFFTWFilter_testCase) {
+  FilterTest();
+} // BOOST_AUTO_TEST_CASE(BatchedFFTWFilter_testCase)
+
+BOOST_AUTO_TEST_CASE(BatchedFFTWResize_testCase) {
+  ResizeTest();
+} // BOOST_AUTO_TEST_CASE(BatchedFFTWResize_testCase)
+
+
+// -----------------------------------------------------------------------------
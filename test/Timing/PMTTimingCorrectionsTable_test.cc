@@ -0,0 +1,200 @@
+/**
+ * @file   test/Timing/PMTTimingCorrectionsTable_test.cc
+ * @brief  Unit test for the application of the PMT timing corrections.
+ * @date   October 19, 2026
+ * @see    `icaruscode/Timing/PMTTimingCorrectionsTable.h`
+ *
+ * The corrections of each channel are added up according to a mask selecting
+ * the types to be applied. This test checks the sum for all the combinations
+ * of the mask, and that `correctOpHits()` and `correctWaveforms()` shift the
+ * times of each channel by that sum, leaving alone the channels with no entry
+ * in the table.
+ */
+
+// ICARUS libraries
+#include "icaruscode/Timing/PMTTimingCorrectionsTable.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( PMTTimingCorrectionsTable_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard library
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+using icarusDB::PMTTimingCorrections;
+using CorrectionMask_t = PMTTimingCorrections::CorrectionMask_t;
+using icarusDB::details::PMTTimeCorrectionsDB;
+using icarusDB::details::PMTTimeCorrectionsTable_t;
+
+/// All the correction types together.
+constexpr CorrectionMask_t AllCorr = PMTTimingCorrections::TriggerCableCorr
+  | PMTTimingCorrections::ResetCableCorr | PMTTimingCorrections::LaserCorr
+  | PMTTimingCorrections::CosmicsCorr;
+
+
+/**
+ * @brief Returns a table of corrections for three channels.
+ *
+ * Each correction type of channel `c` is a different power of 2 times `c + 1`,
+ * so that every combination of them has a distinct, exact sum:
+ * trigger cable 1, reset cable 2, laser 4 and cosmics 8 (times `c + 1`).
+ */
+PMTTimeCorrectionsTable_t makeTable() {
+
+  PMTTimeCorrectionsTable_t table;
+  for (unsigned int channel = 0; channel < 3U; ++channel) {
+    double const f = channel + 1.0;
+    table.push_back({ 1.0 * f, 2.0 * f, 4.0 * f, 8.0 * f });
+  }
+  return table;
+
+} // makeTable()
+
+
+/// Expected correction for `channel` from `makeTable()` with mask `mask`.
+double expectedCorrection(unsigned int channel, CorrectionMask_t mask) {
+  // the mask bits have the same values as the corrections of channel 0
+  return (channel < 3U)? (channel + 1.0) * (mask & AllCorr): 0.0;
+}
+
+
+// -----------------------------------------------------------------------------
+// --- Tests
+// -----------------------------------------------------------------------------
+void TotalCorrectionTest() {
+
+  PMTTimeCorrectionsTable_t const table = makeTable();
+
+  for (CorrectionMask_t mask = 0; mask <= AllCorr; ++mask) {
+    for (unsigned int channel = 0; channel < 3U; ++channel) {
+      BOOST_TEST_CONTEXT("channel: " << channel << ", mask: " << mask) {
+        BOOST_TEST(icarusDB::details::totalCorrection(table[channel], mask)
+          == expectedCorrection(channel, mask));
+      }
+    } // for channels
+  } // for masks
+
+  // bits outside the known types are ignored
+  BOOST_TEST(icarusDB::details::totalCorrection(table[0], 0xF0) == 0.0);
+
+  // channels not in the table have no correction
+  PMTTimeCorrectionsDB const& missing
+    = icarusDB::details::channelCorrOrDefault(table, 3U);
+  BOOST_TEST(&missing == &icarusDB::details::NoCorrections);
+  BOOST_TEST(icarusDB::details::totalCorrection(missing, AllCorr) == 0.0);
+  BOOST_TEST(&icarusDB::details::channelCorrOrDefault(table, 2U) == &table[2]);
+
+} // TotalCorrectionTest()
+
+
+void CorrectOpHitsTest() {
+
+  PMTTimeCorrectionsTable_t const table = makeTable();
+
+  std::vector<recob::OpHit> hits;
+  for (unsigned int channel: { 2U, 0U, 5U, 1U }) {
+    hits.emplace_back(
+      channel,             // channel
+      10.0 + channel,      // peaktime
+      1000.0 + channel,    // peaktimeabs
+      9.0 + channel,       // starttime
+      0.5,                 // risetime
+      1,                   // frame
+      0.25,                // width
+      100.0 + channel,     // area
+      50.0,                // peakheight
+      4.0,                 // pe
+      0.3                  // fasttototal
+      );
+  } // for
+
+  for (CorrectionMask_t mask = 0; mask <= AllCorr; ++mask) {
+
+    // the corrected hits are appended to the existing ones
+    std::vector<recob::OpHit> corrected{ hits.front() };
+    icarusDB::details::correctOpHits(table, hits, corrected, mask);
+
+    BOOST_TEST_CONTEXT("mask: " << mask) {
+      BOOST_TEST_REQUIRE(corrected.size() == hits.size() + 1);
+      BOOST_TEST(corrected.front().PeakTime() == hits.front().PeakTime());
+      for (std::size_t i = 0; i < hits.size(); ++i) {
+        recob::OpHit const& hit = hits[i];
+        recob::OpHit const& corr = corrected[i + 1];
+        double const shift = expectedCorrection(hit.OpChannel(), mask);
+        BOOST_TEST_CONTEXT("hit #" << i << " (channel " << hit.OpChannel() << ")")
+        {
+          BOOST_TEST(corr.OpChannel() == hit.OpChannel());
+          BOOST_TEST(corr.PeakTime() == hit.PeakTime() + shift);
+          BOOST_TEST(corr.PeakTimeAbs() == hit.PeakTimeAbs() + shift);
+          BOOST_TEST(corr.StartTime() == hit.StartTime() + shift);
+          BOOST_TEST(corr.RiseTime() == hit.RiseTime());
+          BOOST_TEST(corr.Frame() == hit.Frame());
+          BOOST_TEST(corr.Width() == hit.Width());
+          BOOST_TEST(corr.Area() == hit.Area());
+          BOOST_TEST(corr.Amplitude() == hit.Amplitude());
+          BOOST_TEST(corr.PE() == hit.PE());
+          BOOST_TEST(corr.FastToTotal() == hit.FastToTotal());
+        } // context
+      } // for hits
+    } // context
+
+  } // for masks
+
+} // CorrectOpHitsTest()
+
+
+void CorrectWaveformsTest() {
+
+  PMTTimeCorrectionsTable_t const table = makeTable();
+
+  std::vector<raw::OpDetWaveform> waveforms;
+  for (unsigned int channel: { 1U, 4U, 0U, 2U, 1U })
+    waveforms.emplace_back(-100.0 + channel, channel);
+
+  for (CorrectionMask_t mask = 0; mask <= AllCorr; ++mask) {
+
+    std::vector<raw::OpDetWaveform> corrected = waveforms;
+    icarusDB::details::correctWaveforms(table, corrected, mask);
+
+    BOOST_TEST_CONTEXT("mask: " << mask) {
+      BOOST_TEST_REQUIRE(corrected.size() == waveforms.size());
+      for (std::size_t i = 0; i < waveforms.size(); ++i) {
+        raw::OpDetWaveform const& waveform = waveforms[i];
+        BOOST_TEST_CONTEXT
+          ("waveform #" << i << " (channel " << waveform.ChannelNumber() << ")")
+        {
+          BOOST_TEST(corrected[i].ChannelNumber() == waveform.ChannelNumber());
+          BOOST_TEST(corrected[i].TimeStamp() == waveform.TimeStamp()
+            + expectedCorrection(waveform.ChannelNumber(), mask));
+        }
+      } // for waveforms
+    } // context
+
+  } // for masks
+
+  // with no table, nothing is changed
+  std::vector<raw::OpDetWaveform> uncorrected = waveforms;
+  icarusDB::details::correctWaveforms({}, uncorrected, AllCorr);
+  for (std::size_t i = 0; i < waveforms.size(); ++i)
+    BOOST_TEST(uncorrected[i].TimeStamp() == waveforms[i].TimeStamp());
+
+} // CorrectWaveformsTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(TotalCorrection_testCase) {
+  TotalCorrectionTest();
+} // BOOST_AUTO_TEST_CASE(TotalCorrection_testCase)
+
+BOOST_AUTO_TEST_CASE(CorrectOpHits_testCase) {
+  CorrectOpHitsTest();
+} // BOOST_AUTO_TEST_CASE(CorrectOpHits_testCase)
+
+BOOST_AUTO_TEST_CASE(CorrectWaveforms_testCase) {
+  CorrectWaveformsTest();
+} // BOOST_AUTO_TEST_CASE(CorrectWaveforms_testCase)
+
+
+// -----------------------------------------------------------------------------
@@ -0,0 +1,348 @@
+/**
+ * @file   test/Utilities/LeastSquaresFitter_test.cc
+ * @brief  Unit test for `util::LeastSquaresFitter`.
+ * @date   October 19, 2026
+ * @see    `icaruscode/Utilities/LeastSquaresFitter.h`
+ *
+ * The data points are generated from models with known parameters, and the
+ * fit is required to recover them: exactly when the points have no noise,
+ * within the uncertainties of the fit when they do. The test also checks
+ * the parameter limits, a parameter with no effect on the model, the errors
+ * when the points have no uncertainty, and the fits which must fail.
+ * The analytic gradients of the PMT calibration models fitted with this
+ * fitter are compared with finite differences.
+ */
+
+// ICARUS libraries
+#include "icaruscode/Utilities/LeastSquaresFitter.h"
+#include "icaruscode/PMT/Calibration/CaloTools/LaserPulse.h"
+#include "icaruscode/PMT/Calibration/CaloTools/IdealPmtResponse.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( LeastSquaresFitter_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard library
+#include <algorithm> // std::max()
+#include <random>
+#include <vector>
+#include <cmath> // std::exp(), std::abs(), std::sqrt()
+#include <cstddef> // std::size_t
+#include <limits>
+
+
+// -----------------------------------------------------------------------------
+using Fitter_t = util::LeastSquaresFitter;
+
+
+/// Gaussian function `par[0] exp(-(x - par[1])^2 / (2 par[2]^2))`.
+double Gauss(double x, double const* par, double* grad) {
+  double const t = (x - par[1]) / par[2];
+  double const e = std::exp(-0.5 * t * t);
+  double const f = par[0] * e;
+  if (grad) {
+    grad[0] = e;
+    grad[1] = f * t / par[2];
+    grad[2] = f * t * t / par[2];
+  }
+  return f;
+} // Gauss()
+
+
+/// Exponential decay `par[0] exp(-x / par[1]) + par[2]`; `par[3]` is unused.
+double Decay(double x, double const* par, double* grad) {
+  double const e = std::exp(-x / par[1]);
+  if (grad) {
+    grad[0] = e;
+    grad[1] = par[0] * e * x / (par[1] * par[1]);
+    grad[2] = 1.0;
+    grad[3] = 0.0;
+  }
+  return par[0] * e + par[2];
+} // Decay()
+
+
+/// Points of a model sampled in `[ low, high [`.
+struct Data_t {
+  std::vector<double> x, y, sigma;
+};
+
+/// Samples `model` with parameters `par` on `n` points in `[ low, high [`;
+/// if `noise` is positive, points are smeared by a Gaussian with that RMS.
+template <typename Model>
+Data_t makeData(
+  Model const& model, std::vector<double> par,
+  std::size_t n, double low, double high,
+  double noise = 0.0, unsigned int seed = 20261019U
+) {
+  std::mt19937 engine{ seed };
+  std::normal_distribution<double> noiseDist{ 0.0, 1.0 };
+
+  Data_t data;
+  for (std::size_t i = 0; i < n; ++i) {
+    double const x = low + (high - low) * i / n;
+    double y = model(x, par.data(), nullptr);
+    if (noise > 0.0) y += noise * noiseDist(engine);
+    data.x.push_back(x);
+    data.y.push_back(y);
+    data.sigma.push_back((noise > 0.0)? noise: 1.0);
+  } // for
+  return data;
+} // makeData()
+
+
+/**
+ * @brief Compares the gradient of `model` with finite differences.
+ * @param model the model (with the interface required by the fitter)
+ * @param x the point where to evaluate the model
+ * @param par the parameters where to evaluate the gradient
+ *
+ * The derivatives are compared with central differences, with a step
+ * relative to each parameter.
+ */
+template <typename Model>
+void checkGradient(Model const& model, double x, std::vector<double> par) {
+
+  std::size_t const nPar = par.size();
+  std::vector<double> grad(nPar), dummy(nPar);
+  double const value = model(x, par.data(), grad.data());
+
+  for (std::size_t i = 0; i < nPar; ++i) {
+    double const p = par[i];
+    double const h = 1e-6 * std::max(std::abs(p), 1e-2);
+    par[i] = p + h;
+    double const up = model(x, par.data(), dummy.data());
+    par[i] = p - h;
+    double const down = model(x, par.data(), dummy.data());
+    par[i] = p;
+
+    double const numeric = (up - down) / (2.0 * h);
+    BOOST_TEST_CONTEXT("x=" << x << " f=" << value << " parameter #" << i) {
+      // the tolerance on small derivatives is relative to the function value
+      BOOST_TEST(std::abs(grad[i] - numeric)
+        <= 1e-5 * std::max(std::abs(numeric), 1e-3 * std::abs(value)));
+    }
+  } // for
+
+} // checkGradient()
+
+
+// -----------------------------------------------------------------------------
+// --- Tests
+// -----------------------------------------------------------------------------
+void ExactGaussTest() {
+
+  std::vector<double> const truth{ 50.0, 3.0, 1.5 };
+  Data_t const data = makeData(Gauss, truth, 100U, -5.0, 10.0);
+
+  Fitter_t const fitter{ 3U };
+  Fitter_t::Result_t const result
+    = fitter.fit(Gauss, data.x, data.y, data.sigma, { 30.0, 2.0, 1.0 });
+
+  BOOST_TEST(result.status == 0);
+  BOOST_TEST(result.ndf == 97);
+  BOOST_TEST(result.chi2 == 0.0, boost::test_tools::tolerance(1e-12));
+  BOOST_TEST_REQUIRE(result.parameters.size() == truth.size());
+  for (std::size_t i = 0; i < truth.size(); ++i) {
+    BOOST_TEST_CONTEXT("parameter #" << i) {
+      BOOST_TEST(result.parameters[i] == truth[i],
+        boost::test_tools::tolerance(1e-6));
+      BOOST_TEST(result.errors[i] > 0.0);
+    }
+  } // for
+
+  // without uncertainties, all points have weight 1 as in this data
+  Fitter_t::Result_t const noSigma
+    = fitter.fit(Gauss, data.x, data.y, {}, { 30.0, 2.0, 1.0 });
+  BOOST_TEST(noSigma.status == 0);
+  for (std::size_t i = 0; i < truth.size(); ++i) {
+    BOOST_TEST(noSigma.parameters[i] == result.parameters[i],
+      boost::test_tools::tolerance(1e-9));
+  }
+
+} // ExactGaussTest()
+
+
+void NoisyGaussTest() {
+
+  std::vector<double> const truth{ 200.0, 40.0, 6.0 };
+  constexpr double noise = 2.0;
+
+  Fitter_t const fitter{ 3U };
+  for (unsigned int seed = 20261019U; seed < 20261019U + 10U; ++seed) {
+    BOOST_TEST_CONTEXT("seed: " << seed) {
+      Data_t const data
+        = makeData(Gauss, truth, 200U, 0.0, 80.0, noise, seed);
+      Fitter_t::Result_t const result
+        = fitter.fit(Gauss, data.x, data.y, data.sigma, { 150.0, 35.0, 8.0 });
+
+      BOOST_TEST(result.status == 0);
+      // generous: 5 standard deviations
+      for (std::size_t i = 0; i < truth.size(); ++i) {
+        BOOST_TEST_CONTEXT("parameter #" << i) {
+          BOOST_TEST(result.errors[i] > 0.0);
+          BOOST_TEST(std::abs(result.parameters[i] - truth[i])
+            < 5.0 * result.errors[i]);
+        }
+      } // for
+      // chi2 per degree of freedom close to 1
+      BOOST_TEST(result.chi2 / result.ndf > 0.6);
+      BOOST_TEST(result.chi2 / result.ndf < 1.5);
+    } // context
+  } // for
+
+} // NoisyGaussTest()
+
+
+void LimitsAndUnusedParameterTest() {
+
+  std::vector<double> const truth{ 80.0, 12.0, 5.0, 0.0 };
+  Data_t const data = makeData(Decay, truth, 60U, 0.0, 60.0);
+
+  // the unused parameter stays where it starts, with no error
+  Fitter_t fitter{ 4U };
+  Fitter_t::Result_t const result
+    = fitter.fit(Decay, data.x, data.y, data.sigma, { 50.0, 20.0, 0.0, 7.0 });
+  BOOST_TEST(result.status == 0);
+  BOOST_TEST(result.parameters[0] == truth[0], boost::test_tools::tolerance(1e-6));
+  BOOST_TEST(result.parameters[1] == truth[1], boost::test_tools::tolerance(1e-6));
+  BOOST_TEST(result.parameters[2] == truth[2], boost::test_tools::tolerance(1e-6));
+  BOOST_TEST(result.parameters[3] == 7.0);
+  BOOST_TEST(result.errors[3] == 0.0);
+
+  // the decay time is not allowed to reach its true value
+  fitter.setParLimits(1U, 15.0, 30.0);
+  Fitter_t::Result_t const limited
+    = fitter.fit(Decay, data.x, data.y, data.sigma, { 50.0, 40.0, 0.0, 7.0 });
+  BOOST_TEST(limited.parameters[1] == 15.0);
+  BOOST_TEST(limited.chi2 > 0.0);
+
+} // LimitsAndUnusedParameterTest()
+
+
+void UnknownUncertaintiesTest() {
+
+  std::vector<double> const truth{ 200.0, 40.0, 6.0 };
+  constexpr double noise = 2.0;
+  Data_t const data = makeData(Gauss, truth, 200U, 0.0, 80.0, noise);
+
+  Fitter_t fitter{ 3U };
+  fitter.setTolerance(1e-14);
+  Fitter_t::Result_t const result
+    = fitter.fit(Gauss, data.x, data.y, data.sigma, { 150.0, 35.0, 8.0 });
+  Fitter_t::Result_t const noSigma
+    = fitter.fit(Gauss, data.x, data.y, {}, { 150.0, 35.0, 8.0 });
+  BOOST_TEST(result.status == 0);
+  BOOST_TEST(noSigma.status == 0);
+
+  // the uncertainty of the points is estimated from their residuals,
+  // with the (noise) unit uncertainty scaled by `sqrt(chi2/ndf)`
+  BOOST_TEST(noSigma.chi2 == result.chi2 * noise * noise,
+    boost::test_tools::tolerance(1e-6));
+  double const scale = std::sqrt(result.chi2 / result.ndf);
+  for (std::size_t i = 0; i < truth.size(); ++i) {
+    BOOST_TEST_CONTEXT("parameter #" << i) {
+      BOOST_TEST(noSigma.parameters[i] == result.parameters[i],
+        boost::test_tools::tolerance(1e-6));
+      BOOST_TEST(noSigma.errors[i] == result.errors[i] * scale,
+        boost::test_tools::tolerance(1e-6));
+    }
+  } // for
+
+} // UnknownUncertaintiesTest()
+
+
+void FailedFitsTest() {
+
+  std::vector<double> const truth{ 50.0, 3.0, 1.5 };
+  Data_t const data = makeData(Gauss, truth, 100U, -5.0, 10.0);
+
+  // starting far from the minimum, two iterations are not enough to converge
+  Fitter_t fitter{ 3U };
+  fitter.setMaxIterations(2U);
+  Fitter_t::Result_t const result
+    = fitter.fit(Gauss, data.x, data.y, data.sigma, { 10.0, 6.0, 3.0 });
+  BOOST_TEST(result.status == 1);
+  BOOST_TEST(result.iterations == 2U);
+
+  Fitter_t const defaultFitter{ 3U };
+
+  // not enough points for the parameters
+  Data_t const fewData = makeData(Gauss, truth, 3U, 2.0, 4.0);
+  Fitter_t::Result_t const fewResult = defaultFitter.fit
+    (Gauss, fewData.x, fewData.y, fewData.sigma, { 30.0, 2.0, 1.0 });
+  BOOST_TEST(fewResult.status == 2);
+  BOOST_TEST(fewResult.ndf == 0);
+
+  // a model which can't be evaluated at the starting point
+  Fitter_t::Result_t const nanResult = defaultFitter.fit(
+    Gauss, data.x, data.y, data.sigma,
+    { std::numeric_limits<double>::quiet_NaN(), 2.0, 1.0 }
+    );
+  BOOST_TEST(nanResult.status == 2);
+
+} // FailedFitsTest()
+
+
+void PulseShapeGradientTest() {
+
+  pmtcalo::PulseShapeFunction_ExpGaus const pulseShape;
+
+  // parameters: start time, Gaussian width, exponential decay, amplitude
+  for (std::vector<double> const& par: {
+    std::vector<double>{ 100.0, 2.0, 0.1, 500.0 },
+    std::vector<double>{ 20.0, 5.0, 0.4, 30.0 },
+    std::vector<double>{ 50.0, 0.8, 0.05, 2000.0 },
+  }) {
+    for (double const dt: { -8.0, -2.0, -0.5, 0.0, 0.7, 3.0, 10.0, 40.0 })
+      checkGradient(pulseShape, par[0] + dt, par);
+  } // for
+
+} // PulseShapeGradientTest()
+
+
+void PmtResponseGradientTest() {
+
+  // parameters: mu, q, sigma, amplitude [, pedestal a0, c0 ]
+  IdealPmtResponse const response{ 1, 4, false };
+  for (double const x: { 0.2, 0.5, 0.9, 1.4, 2.5, 3.7 })
+    checkGradient(response, x, { 0.6, 0.9, 0.35, 1000.0 });
+
+  IdealPmtResponse const withPedestal{ 1, 4, true };
+  for (double const x: { 0.1, 0.3, 0.8, 1.6, 3.0 })
+    checkGradient(withPedestal, x, { 1.2, 0.8, 0.3, 800.0, 400.0, -3.0 });
+
+} // PmtResponseGradientTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ExactGauss_testCase) {
+  ExactGaussTest();
+} // BOOST_AUTO_TEST_CASE(ExactGauss_testCase)
+
+BOOST_AUTO_TEST_CASE(NoisyGauss_testCase) {
+  NoisyGaussTest();
+} // BOOST_AUTO_TEST_CASE(NoisyGauss_testCase)
+
+BOOST_AUTO_TEST_CASE(LimitsAndUnusedParameter_testCase) {
+  LimitsAndUnusedParameterTest();
+} // BOOST_AUTO_TEST_CASE(LimitsAndUnusedParameter_testCase)
+
+BOOST_AUTO_TEST_CASE(UnknownUncertainties_testCase) {
+  UnknownUncertaintiesTest();
+} // BOOST_AUTO_TEST_CASE(UnknownUncertainties_testCase)
+
+BOOST_AUTO_TEST_CASE(FailedFits_testCase) {
+  FailedFitsTest();
+} // BOOST_AUTO_TEST_CASE(FailedFits_testCase)
+
+BOOST_AUTO_TEST_CASE(PulseShapeGradient_testCase) {
+  PulseShapeGradientTest();
+} // BOOST_AUTO_TEST_CASE(PulseShapeGradient_testCase)
+
+BOOST_AUTO_TEST_CASE(PmtResponseGradient_testCase) {
+  PmtResponseGradientTest();
+} // BOOST_AUTO_TEST_CASE(PmtResponseGradient_testCase)
+
+
+// -----------------------------------------------------------------------------
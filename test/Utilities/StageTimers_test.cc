@@ -0,0 +1,156 @@
+/**
+ * @file   test/Utilities/StageTimers_test.cc
+ * @brief  Unit test for `util::StageTimers`.
+ * @date   October 19, 2026
+ * @see    `icaruscode/Utilities/StageTimers.h`
+ */
+
+// ICARUS libraries
+#include "icaruscode/Utilities/StageTimers.h"
+
+// TBB libraries
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
+
+// Boost libraries
+#define BOOST_TEST_MODULE ( StageTimers_test )
+#include <boost/test/unit_test.hpp>
+
+// C/C++ standard library
+#include <chrono>
+#include <cstdint> // std::uint64_t
+#include <sstream>
+#include <vector>
+
+
+// -----------------------------------------------------------------------------
+using Timers_t = util::StageTimers;
+
+
+// -----------------------------------------------------------------------------
+// --- StageTimers tests
+// -----------------------------------------------------------------------------
+void BinningTest() {
+
+  // bins are contiguous, and each time falls within its bin edges
+  for (std::size_t bin = 0U; bin < Timers_t::NBins - 1U; ++bin)
+    BOOST_TEST(Timers_t::binLowEdge(bin) < Timers_t::binLowEdge(bin + 1U));
+
+  for (std::uint64_t const ns: { 1UL, 2UL, 3UL, 5UL, 7UL, 100UL, 1023UL,
+    1024UL, 1500UL, 999'999UL, 1'000'000'000UL, 3'600'000'000'000UL })
+  {
+    BOOST_TEST_CONTEXT("time: " << ns << " ns") {
+      std::size_t const bin = Timers_t::timeBin(ns);
+      BOOST_TEST(Timers_t::binLowEdge(bin) <= double(ns));
+      BOOST_TEST(Timers_t::binLowEdge(bin + 1U) > double(ns));
+    }
+  } // for
+
+  BOOST_TEST(Timers_t::timeBin(0U) == 0U);
+  BOOST_TEST(Timers_t::timeBin(~std::uint64_t{ 0U }) == Timers_t::NBins - 1U);
+
+} // BinningTest()
+
+
+void RecordTest() {
+
+  using namespace std::chrono_literals;
+
+  Timers_t timers{ "test" };
+  Timers_t::StageID_t const decode = timers.addStage("decode");
+  Timers_t::StageID_t const filter = timers.addStage("filter");
+  BOOST_TEST(timers.addStage("decode") == decode);
+  BOOST_TEST(timers.nStages() == 2U);
+  BOOST_TEST(timers.stageName(filter) == "filter");
+
+  timers.record(decode, 3us);
+  timers.record(decode, 1us);
+  timers.record(decode, 2us);
+  {
+    auto timer = timers.time(filter);
+    timer.stop();
+    timer.stop(); // no effect
+  }
+
+  std::vector<Timers_t::Stats_t> const stats = timers.stats();
+  BOOST_TEST_REQUIRE(stats.size() == 2U);
+
+  BOOST_TEST(stats[decode].count == 3U);
+  BOOST_TEST(stats[decode].totalNs == 6000U);
+  BOOST_TEST(stats[decode].minNs == 1000U);
+  BOOST_TEST(stats[decode].maxNs == 3000U);
+  BOOST_TEST(stats[decode].meanTime() == 2e-6);
+  BOOST_TEST(stats[decode].histogram[Timers_t::timeBin(2000U)] == 1U);
+
+  BOOST_TEST(stats[filter].count == 1U);
+
+  std::ostringstream out;
+  timers.dump(out);
+  BOOST_TEST_MESSAGE(out.str());
+  BOOST_TEST(out.str().find("decode: 3 calls") != std::string::npos);
+
+} // RecordTest()
+
+
+void ThreadTest() {
+
+  using namespace std::chrono_literals;
+
+  Timers_t timers{ "test" };
+  Timers_t::StageID_t const stage = timers.addStage("stage");
+
+  // times are recorded from many threads
+  constexpr unsigned int N = 100'000U;
+  tbb::parallel_for(tbb::blocked_range<unsigned int>(0U, N),
+    [&timers,stage](tbb::blocked_range<unsigned int> const& range)
+    {
+      for (unsigned int i = range.begin(); i < range.end(); ++i)
+        timers.record(stage, std::chrono::nanoseconds(i % 1000U + 1U));
+    });
+
+  Timers_t::Stats_t const stats = timers.stats().at(stage);
+  BOOST_TEST(stats.count == N);
+  BOOST_TEST(stats.totalNs == 100U * (1000U * 1001U / 2U));
+  BOOST_TEST(stats.minNs == 1U);
+  BOOST_TEST(stats.maxNs == 1000U);
+
+  std::uint64_t histogramCount = 0U;
+  for (std::uint64_t const count: stats.histogram) histogramCount += count;
+  BOOST_TEST(histogramCount == N);
+
+} // ThreadTest()
+
+
+void SharedTest() {
+
+  auto const timers = Timers_t::forModule("shared");
+  BOOST_TEST(timers->moduleLabel() == "shared");
+  BOOST_TEST(Timers_t::forModule("shared") == timers);
+  BOOST_TEST(Timers_t::forModule("other") != timers);
+
+  // only the first claim succeeds
+  BOOST_TEST(Timers_t::forModule("shared")->claimReport());
+  BOOST_TEST(!timers->claimReport());
+
+} // SharedTest()
+
+
+// -----------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(StageTimersBinning_testCase) {
+  BinningTest();
+} // BOOST_AUTO_TEST_CASE(StageTimersBinning_testCase)
+
+BOOST_AUTO_TEST_CASE(StageTimersRecord_testCase) {
+  RecordTest();
+} // BOOST_AUTO_TEST_CASE(StageTimersRecord_testCase)
+
+BOOST_AUTO_TEST_CASE(StageTimersThread_testCase) {
+  ThreadTest();
+} // BOOST_AUTO_TEST_CASE(StageTimersThread_testCase)
+
+BOOST_AUTO_TEST_CASE(StageTimersShared_testCase) {
+  SharedTest();
+} // BOOST_AUTO_TEST_CASE(StageTimersShared_testCase)
+
+
+// -----------------------------------------------------------------------------